@@ -11,6 +11,8 @@
 #include <light_mat/matexpr/mat_arith.h>
 #include <light_mat/matexpr/mat_emath.h>
 #include <light_mat/matexpr/mat_special.h>
+#include <light_mat/matexpr/mat_approx.h>
+#include <cmath>
 
 using namespace lmat;
 using namespace ltest;
@@ -105,10 +107,62 @@ struct bench_math2_base
 		};
 
 
+// approximate versions, against the exact SIMD evaluation of the same thing
+
+#define DEF_BENCH_APPROX(Fun, ExactExpr) \
+		template<typename T> \
+		struct bench_##Fun##_exact : public bench_math1_base<T> { \
+			bench_##Fun##_exact(const bench_math1_base<T>& base) \
+			: bench_math1_base<T>(base) { } \
+			const char *name() const { return #Fun "-exact"; } \
+			LMAT_ENSURE_INLINE \
+			void operator() () const { \
+				const cref_matrix<T>& a = this->a; \
+				ref_matrix<T>& dst = this->dst; \
+				dst = ExactExpr; } \
+		}; \
+		template<typename T> \
+		struct bench_approx_##Fun##_simd : public bench_math1_base<T> { \
+			bench_approx_##Fun##_simd(const bench_math1_base<T>& base) \
+			: bench_math1_base<T>(base) { } \
+			const char *name() const { return #Fun "-approx"; } \
+			LMAT_ENSURE_INLINE \
+			void operator() () const { \
+				const cref_matrix<T>& a = this->a; \
+				ref_matrix<T>& dst = this->dst; \
+				dst = approx_##Fun(a); } \
+		};
+
+template<typename T, class Exact, class Approx>
+double max_rel_error(const Exact& ex, const Approx& ap, ref_matrix<T>& dst)
+{
+	const index_t len = dst.nelems();
+	dense_matrix<T> r0(dst.nrows(), dst.ncolumns());
+
+	ex();
+	for (index_t i = 0; i < len; ++i) r0[i] = dst[i];
+	ap();
+
+	double e = 0;
+	for (index_t i = 0; i < len; ++i)
+	{
+		double ei = std::fabs(double(dst[i]) - double(r0[i])) / std::fabs(double(r0[i]));
+		if (ei > e) e = ei;
+	}
+	return e;
+}
+
 #define ADD_MBENCH1(Fun) \
 		run_benchmark(bench_##Fun##_scalar<T>(base1), mon, opt); \
 		run_benchmark(bench_##Fun##_simd<T>(base1), mon, opt);
 
+#define ADD_ABENCH(Fun, Base) \
+		run_benchmark(bench_##Fun##_exact<T>(Base), mon, opt); \
+		run_benchmark(bench_approx_##Fun##_simd<T>(Base), mon, opt); \
+		std::printf("  %-16s max rel. error = %.2e\n", #Fun, \
+				max_rel_error(bench_##Fun##_exact<T>(Base), \
+						bench_approx_##Fun##_simd<T>(Base), Base.dst));
+
 #define ADD_MBENCH2(Fun) \
 		run_benchmark(bench_##Fun##_scalar<T>(base2), mon, opt); \
 		run_benchmark(bench_##Fun##_simd<T>(base2), mon, opt);
@@ -141,6 +195,13 @@ DEF_BENCH_MATH1( erf )
 DEF_BENCH_MATH1( erfc )
 DEF_BENCH_MATH1( norminv )
 
+DEF_BENCH_APPROX( exp, exp(a) )
+DEF_BENCH_APPROX( log, log(a) )
+DEF_BENCH_APPROX( tanh, tanh(a) )
+DEF_BENCH_APPROX( sigmoid, rcp(T(1) + exp(-a)) )
+DEF_BENCH_APPROX( rcp, rcp(a) )
+DEF_BENCH_APPROX( rsqrt, rsqrt(a) )
+
 
 const index_t m = 128;
 const index_t n = 128;
@@ -153,18 +214,23 @@ void run_bench()
 {
 	dense_matrix<T> a(n, n);
 	dense_matrix<T> b(n, n);
+	dense_matrix<T> c(n, n);
 	dense_matrix<T> dst(n, n, zero());
 	const T *pa = a.ptr_data();
 	const T *pb = b.ptr_data();
+	const T *pc = c.ptr_data();
 	T *pd = dst.ptr_data();
 	fill_rand(a);
 	fill_rand(b);
+	fill_rand(c);
+	c = (c - T(0.5)) * T(16);  // in [-8, 8]
 
 	std_bench_monitor mon(MATH_BENCH_TEMPL);
 	benchmark_option opt(pbsiz);
 
 	bench_math1_base<T> base1(m, n, pa, pd);
 	bench_math2_base<T> base2(m, n, pa, pb, pd);
+	bench_math1_base<T> basec(m, n, pc, pd);
 
 	std::cout << "power functions" << std::endl;
 	std::cout << "---------------------" << std::endl;
@@ -205,6 +271,16 @@ void run_bench()
 	ADD_MBENCH1( erfc )
 	ADD_MBENCH1( norminv )
 
+	std::cout << "\napproximate functions" << std::endl;
+	std::cout << "---------------------" << std::endl;
+
+	ADD_ABENCH( exp, basec )
+	ADD_ABENCH( log, base1 )
+	ADD_ABENCH( tanh, basec )
+	ADD_ABENCH( sigmoid, basec )
+	ADD_ABENCH( rcp, basec )
+	ADD_ABENCH( rsqrt, base1 )
+
 	std::cout << std::endl;
 }
 
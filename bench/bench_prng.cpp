@@ -135,6 +135,90 @@ void bench_discrete_distrs()
 	ADD_DISTR_BENCH_P1( geometric, 0.4 );
 }
 
+
+template<class Distr>
+struct bench_prng_fill
+: public bench_prng_base<typename Distr::result_type>
+{
+	typedef bench_prng_base<typename Distr::result_type> base_t;
+	Distr distr;
+
+	bench_prng_fill(const Distr& d, const char *name, const base_t& base)
+	: base_t(base), distr(d) { this->_name = name; }
+
+	LMAT_ENSURE_INLINE
+	void operator() () const
+	{
+		distr.fill(rstream, this->_n, this->dst);
+	}
+};
+
+#define ADD_DD_BENCH( Method, K ) \
+	run_benchmark(bench_prng_scalar<discrete_distr<T, Method##_> >( \
+			discrete_distr<T, Method##_>(w.ptr_data(), w.ptr_data() + K), #Method "-scalar", base), mon, opt)
+
+#define ADD_DD_FILL_BENCH( Method, K ) \
+	run_benchmark(bench_prng_fill<discrete_distr<T, Method##_> >( \
+			discrete_distr<T, Method##_>(w.ptr_data(), w.ptr_data() + K), #Method "-fill", base), mon, opt)
+
+void bench_discrete_methods()
+{
+	typedef uint32_t T;
+	dense_col<T> dst(Length);
+
+	std_bench_monitor mon;
+	size_t pbsiz = 1024000 / Length;
+	benchmark_option opt(pbsiz);
+
+	bench_prng_base<T> base(dst.nelems(), dst.ptr_data());
+
+	// Zipf-like weights
+
+	const index_t Kmax = 100000;
+	dense_col<double> w(Kmax);
+	for (index_t k = 0; k < Kmax; ++k) w[k] = 1.0 / double(k + 1);
+
+	std::cout << "K = 10:\n";
+	std::cout << "---------------------\n";
+
+	ADD_DD_BENCH( naive, 10 );
+	ADD_DD_BENCH( guide_table, 10 );
+	ADD_DD_BENCH( alias, 10 );
+	ADD_DD_FILL_BENCH( alias, 10 );
+
+	std::cout << "\n";
+	std::cout << "K = 1000:\n";
+	std::cout << "---------------------\n";
+
+	ADD_DD_BENCH( naive, 1000 );
+	ADD_DD_BENCH( guide_table, 1000 );
+	ADD_DD_BENCH( alias, 1000 );
+	ADD_DD_FILL_BENCH( alias, 1000 );
+
+	// the naive method takes O(K) per draw, so it is
+	// benchmarked with fewer repetitions for large K
+
+	std::cout << "\n";
+	std::cout << "K = 100000:\n";
+	std::cout << "---------------------\n";
+
+	benchmark_option opt_s(pbsiz / 100);
+	run_benchmark(bench_prng_scalar<discrete_distr<T, naive_> >(
+			discrete_distr<T, naive_>(w.ptr_data(), w.ptr_data() + Kmax), "naive-scalar", base), mon, opt_s);
+
+	ADD_DD_BENCH( guide_table, Kmax );
+	ADD_DD_BENCH( alias, Kmax );
+	ADD_DD_FILL_BENCH( alias, Kmax );
+}
+
+#define ADD_ZIG_BENCH( Name, ... ) \
+	run_benchmark(bench_prng_scalar<Name##_distr<T, ziggurat_> >( \
+			Name##_distr<T, ziggurat_>( __VA_ARGS__ ), #Name "-zig-scalar", base), mon, opt); \
+	run_benchmark(bench_prng_simd<Name##_distr<T, ziggurat_> >( \
+			Name##_distr<T, ziggurat_>( __VA_ARGS__ ), #Name "-zig-simd", base), mon, opt); \
+	run_benchmark(bench_prng_fill<Name##_distr<T, ziggurat_> >( \
+			Name##_distr<T, ziggurat_>( __VA_ARGS__ ), #Name "-zig-fill", base), mon, opt)
+
 template<typename T>
 void bench_real_distrs()
 {
@@ -165,6 +249,9 @@ void bench_real_distrs()
 	ADD_DISTR_BENCH_P1( exponential, T(2.5) );
 	ADD_DISTR_SIMD_BENCH_P1( exponential, T(2.5) );
 
+	ADD_ZIG_BENCH( std_exponential, );
+	ADD_ZIG_BENCH( exponential, T(2.5) );
+
 	std::cout << "\n";
 	std::cout << "normal:\n";
 	std::cout << "---------------------\n";
@@ -175,6 +262,9 @@ void bench_real_distrs()
 	ADD_DISTR_BENCH_P2( normal, T(1.6), T(2.5) );
 	ADD_DISTR_SIMD_BENCH_P2( normal, T(1.6), T(2.5) );
 
+	ADD_ZIG_BENCH( std_normal, );
+	ADD_ZIG_BENCH( normal, T(1.6), T(2.5) );
+
 	std::cout << "\n";
 	std::cout << "gamma:\n";
 	std::cout << "---------------------\n";
@@ -191,6 +281,11 @@ int main(int argc, char *argv[])
 	bench_discrete_distrs();
 	std::cout << "\n";
 
+	std::cout << "Discrete distributions by methods [uint32_t]\n";
+	std::cout << "**************************************\n";
+	bench_discrete_methods();
+	std::cout << "\n";
+
 	std::cout << "Continuous distributions [float]\n";
 	std::cout << "**************************************\n";
 	bench_real_distrs<float>();
@@ -67,17 +67,48 @@ if (${TARGET_ISA} STREQUAL "avx")
     set(ALLOW_AVX    "yes")
 endif (${TARGET_ISA} STREQUAL "avx")
 
+if (${TARGET_ISA} STREQUAL "avx2")
+    set(ALLOW_SSE2   "yes")
+    set(ALLOW_SSE3   "yes")
+    set(ALLOW_SSSE3  "yes")
+    set(ALLOW_SSE4_1 "yes")
+    set(ALLOW_SSE4_2 "yes")
+    set(ALLOW_AVX    "yes")
+    set(ALLOW_AVX2   "yes")
+endif (${TARGET_ISA} STREQUAL "avx2")
+
+if (${TARGET_ISA} STREQUAL "avx512")
+    set(ALLOW_SSE2   "yes")
+    set(ALLOW_SSE3   "yes")
+    set(ALLOW_SSSE3  "yes")
+    set(ALLOW_SSE4_1 "yes")
+    set(ALLOW_SSE4_2 "yes")
+    set(ALLOW_AVX    "yes")
+    set(ALLOW_AVX2   "yes")
+    set(ALLOW_AVX512 "yes")
+endif (${TARGET_ISA} STREQUAL "avx512")
+
 
 # set compiler arch flags
 
 if (MSVC)
-    if (ALLOW_AVX)
+    if (ALLOW_AVX512)
+        set(ARCH_FLAG "/arch:AVX512")
+    elseif (ALLOW_AVX2)
+        set(ARCH_FLAG "/arch:AVX2")
+    elseif (ALLOW_AVX)
         set(ARCH_FLAG "/arch:AVX")
-    else(ALLOW_AVX)
+    else (ALLOW_AVX512)
         set(ARCH_FLAG "/arch:SSE2")
-    endif (ALLOW_AVX)
+    endif (ALLOW_AVX512)
 else (MSVC)
-    set(ARCH_FLAG "-m${TARGET_ISA}")
+    if (ALLOW_AVX512)
+        set(ARCH_FLAG "-mavx512f -mfma")
+    elseif (ALLOW_AVX2)
+        set(ARCH_FLAG "-mavx2 -mfma")
+    else (ALLOW_AVX512)
+        set(ARCH_FLAG "-m${TARGET_ISA}")
+    endif (ALLOW_AVX512)
 endif (MSVC)
 
 message(STATUS "[LMAT] ARCH_FLAG = ${ARCH_FLAG}")
@@ -29,8 +29,7 @@
 #endif
 
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	class invalid_operation : public std::exception
 	{
@@ -136,7 +135,7 @@ namespace lmat
 		}
 	};
 
-}
+LMAT_END_NAMESPACE
 
 
 
@@ -15,8 +15,7 @@
 
 #include <light_mat/common/prim_types.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	/********************************************
 	 *
 	 *  pass
@@ -196,6 +195,6 @@ namespace lmat
 		return args_all((a0 == args)...);
 	}
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* ARGS_ALG_H_ */
@@ -17,8 +17,7 @@
 #include <light_mat/common/memalloc.h>
 #include <algorithm>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
     /********************************************
      *
@@ -346,6 +345,6 @@ namespace lmat
 		a.swap(b);
 	}
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* BLOCK_H_ */
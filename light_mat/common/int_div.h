@@ -28,8 +28,7 @@
 	};
 
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	template<unsigned int D> struct int_div;
 
@@ -69,6 +68,6 @@ namespace lmat
 		struct oct { };
 		struct hex { };
 	}
-}
+LMAT_END_NAMESPACE
 
 #endif /* INT_DIV_H_ */
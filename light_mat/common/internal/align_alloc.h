@@ -22,7 +22,7 @@
 #include <malloc.h>
 #endif
 
-namespace lmat { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace internal {
 
 #if LIGHTMAT_PLATFORM == LIGHTMAT_POSIX
 
@@ -65,6 +65,6 @@ namespace lmat { namespace internal {
 #endif
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif /* ALIGN_ALLOC_H_ */
@@ -15,8 +15,7 @@
 
 #include <light_mat/common/prim_types.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	// mask type
 
 	template<typename T>
@@ -129,6 +128,6 @@ namespace lmat
 	};
 
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* MASK_TYPE_H_ */
@@ -18,8 +18,7 @@
 
 #include <limits>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	/********************************************
 	 *
@@ -39,10 +38,12 @@ namespace lmat
     	typedef size_t size_type;
     	typedef ptrdiff_t difference_type;
 
+    	static const unsigned int ct_alignment = Align;
+
     	template<typename TOther>
     	struct rebind
     	{
-    		typedef aligned_allocator<TOther> other;
+    		typedef aligned_allocator<TOther, Align> other;
     	};
 
     public:
@@ -51,7 +52,7 @@ namespace lmat
 
     	template<typename U>
     	LMAT_ENSURE_INLINE
-    	aligned_allocator(const aligned_allocator<U>& r) { }
+    	aligned_allocator(const aligned_allocator<U, Align>& r) { }
 
     	LMAT_ENSURE_INLINE
     	unsigned int alignment() const
@@ -103,7 +104,7 @@ namespace lmat
 
     }; // end class aligned_allocator
 
-}
+LMAT_END_NAMESPACE
 
 
 #endif /* MEMALLOC_H_ */
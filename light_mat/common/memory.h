@@ -17,8 +17,7 @@
 #include <cstring>
 #include <iterator>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	/********************************************
 	 *
 	 *  Iterator to access interval memory
@@ -298,6 +297,6 @@ namespace lmat
 	}
 
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* MEM_OP_H_ */
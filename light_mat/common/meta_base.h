@@ -15,7 +15,7 @@
 
 #include <light_mat/common/prim_types.h>
 
-namespace lmat {  namespace meta {
+LMAT_BEGIN_NAMESPACE  namespace meta {
 
 
 	/********************************************
@@ -212,11 +212,10 @@ namespace lmat {  namespace meta {
 
 	template<typename... W> struct minimum_ : public fold_<min_, W...> { };
 
-} } // lmat::meta
+} LMAT_END_NAMESPACE // lmat::meta
 
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	// import of some common meta types to lmat namespace
 
 	using meta::type_;
@@ -227,7 +226,7 @@ namespace lmat
 	using meta::true_;
 	using meta::false_;
 
-}
+LMAT_END_NAMESPACE
 
 
 #endif
@@ -0,0 +1,154 @@
+/**
+ * @file parallel.h
+ *
+ * @brief Basic facilities for multi-threaded evaluation
+ *
+ * Multi-threading is based on OpenMP, and is only enabled when
+ * the code is compiled with OpenMP support (e.g. -fopenmp).
+ * Otherwise, all parallel constructs degenerate to serial loops.
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_PARALLEL_H_
+#define LIGHTMAT_PARALLEL_H_
+
+#include <light_mat/common/basic_defs.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#define LMAT_HAS_OPENMP
+#endif
+
+LMAT_BEGIN_NAMESPACE
+	/********************************************
+	 *
+	 *  thread control
+	 *
+	 ********************************************/
+
+	inline int par_max_threads()
+	{
+#ifdef LMAT_HAS_OPENMP
+		return omp_get_max_threads();
+#else
+		return 1;
+#endif
+	}
+
+	inline void set_par_max_threads(int n)
+	{
+#ifdef LMAT_HAS_OPENMP
+		omp_set_num_threads(n > 0 ? n : 1);
+#endif
+	}
+
+	inline int par_thread_id()
+	{
+#ifdef LMAT_HAS_OPENMP
+		return omp_get_thread_num();
+#else
+		return 0;
+#endif
+	}
+
+	inline bool in_par_region()
+	{
+#ifdef LMAT_HAS_OPENMP
+		return omp_in_parallel() != 0;
+#else
+		return false;
+#endif
+	}
+
+
+	/********************************************
+	 *
+	 *  range partition
+	 *
+	 ********************************************/
+
+	/**
+	 * Partitions [0, len) into contiguous chunks.
+	 *
+	 * Each chunk (except the last one) has the same length,
+	 * which is a multiple of align. Hence, when align is the
+	 * pack width, every chunk but the last one consists of whole packs.
+	 */
+	class par_partition
+	{
+	public:
+		LMAT_ENSURE_INLINE
+		par_partition(index_t len, index_t chunk_len, index_t align)
+		: m_len(len)
+		{
+			index_t c = chunk_len > align ? chunk_len : align;
+			c = ((c + align - 1) / align) * align;
+			m_chunk_len = c;
+			m_nchunks = len > 0 ? (len + c - 1) / c : 0;
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t length() const
+		{
+			return m_len;
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t nchunks() const
+		{
+			return m_nchunks;
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t chunk_begin(index_t k) const
+		{
+			return k * m_chunk_len;
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t chunk_length(index_t k) const
+		{
+			index_t b = k * m_chunk_len;
+			index_t r = m_len - b;
+			return r < m_chunk_len ? r : m_chunk_len;
+		}
+
+	private:
+		index_t m_len;
+		index_t m_chunk_len;
+		index_t m_nchunks;
+	};
+
+
+	/**
+	 * Partitions [0, len) into a given number of contiguous chunks,
+	 * whose boundaries are multiples of align.
+	 *
+	 * The partition is fully determined by (len, nchunks, align),
+	 * which makes it suitable for reproducible parallel reduction.
+	 */
+	LMAT_ENSURE_INLINE
+	inline par_partition par_even_partition(index_t len, index_t nchunks, index_t align)
+	{
+		index_t nc = nchunks > 0 ? nchunks : 1;
+		return par_partition(len, (len + nc - 1) / nc, align);
+	}
+
+
+	/**
+	 * Determines whether a job of the given size should be run in parallel.
+	 */
+	LMAT_ENSURE_INLINE
+	inline bool par_worthy(index_t size, index_t min_size)
+	{
+		return size >= min_size && !in_par_region() && par_max_threads() > 1;
+	}
+
+LMAT_END_NAMESPACE
+
+#endif
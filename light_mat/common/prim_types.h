@@ -38,8 +38,7 @@
 		LMAT_ENSURE_INLINE const Derived& derived() const { return *(static_cast<const Derived*>(this)); } \
 		LMAT_ENSURE_INLINE Derived& derived() { return *(static_cast<Derived*>(this)); }
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	struct nil_t { };
 
 	// primitive types
@@ -109,6 +108,6 @@ namespace lmat
 		noncopyable& operator= (const noncopyable& );
 	};
 
-}
+LMAT_END_NAMESPACE
 
 #endif
@@ -15,8 +15,7 @@
 
 #include <light_mat/common/prim_types.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	template<class Derived>
 	class IRange
 	{
@@ -164,6 +163,6 @@ namespace lmat
 
 		return step_range(a, n, s);
 	}
-}
+LMAT_END_NAMESPACE
 
 #endif
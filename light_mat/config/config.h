@@ -24,6 +24,43 @@
 #define LMAT_ENABLE_DIM_CHECKING
 #endif
 
+// SIMD dispatch variants (see simd/simd_dispatch.h)
+//
+// A translation unit that defines LMAT_SIMD_DISPATCH_VARIANT is compiled
+// for one particular instruction set. Everything in the library is then
+// declared in an inline namespace specific to that instruction set
+// (e.g. lmat::simd_avx2), so that inline functions compiled with
+// different instruction sets are distinct entities and never get merged
+// by the linker. The instruction set is taken from the compiler flags,
+// in the same order as LMAT_SIMD_LEVEL (see simd/simd_arch.h).
+
+#ifdef LMAT_SIMD_DISPATCH_VARIANT
+
+#if defined ( __AVX512F__ )
+#define LMAT_SIMD_VARIANT_SUFFIX avx512
+#elif defined ( __AVX2__ )
+#define LMAT_SIMD_VARIANT_SUFFIX avx2
+#elif defined ( __AVX__ )
+#define LMAT_SIMD_VARIANT_SUFFIX avx
+#else
+#define LMAT_SIMD_VARIANT_SUFFIX sse2
+#endif
+
+#define LMAT_SIMD_VARIANT_NS_(sfx) simd_##sfx
+#define LMAT_SIMD_VARIANT_NS_X(sfx) LMAT_SIMD_VARIANT_NS_(sfx)
+#define LMAT_SIMD_VARIANT_NS LMAT_SIMD_VARIANT_NS_X(LMAT_SIMD_VARIANT_SUFFIX)
+
+#define LMAT_BEGIN_NAMESPACE namespace lmat { inline namespace LMAT_SIMD_VARIANT_NS {
+#define LMAT_END_NAMESPACE } }
+
+#else
+
+#define LMAT_BEGIN_NAMESPACE namespace lmat {
+#define LMAT_END_NAMESPACE }
+
+#endif
+
+
 
 #endif
 
@@ -17,8 +17,41 @@
 #define LMAT_DIAGNOSIS_LEVEL 3
 #endif
 
+// size of index_t in bytes (use 8 for matrices with 2^31 or more elements)
+
+#ifndef LMAT_INDEX_SIZE
 #define LMAT_INDEX_SIZE 4
+#endif
+
+// alignment of allocated memory (in bytes)
+//
+// This must be the same in all translation units of a program, so it
+// does not depend on the instruction set in use. The default of 64 bytes
+// covers the packs of all SIMD kinds (up to AVX-512), and also the
+// cache lines of x86 processors.
+
+#ifndef LMAT_DEFAULT_ALIGNMENT
+#define LMAT_DEFAULT_ALIGNMENT 64
+#endif
+
+// parallel evaluation (only effective when compiled with OpenMP)
 
-#define LMAT_DEFAULT_ALIGNMENT 16
+#ifndef LMAT_PAR_MIN_ELEMS
+#define LMAT_PAR_MIN_ELEMS 65536
+#endif
+
+#ifndef LMAT_PAR_CHUNK_BYTES
+#define LMAT_PAR_CHUNK_BYTES 65536
+#endif
+
+// random matrices larger than this many elements are filled in chunks
+// of this size, each from its own substream (see random/rand_expr.h)
+//
+// The chunks do not depend on the number of threads. As every chunk
+// costs a long jump of the stream, they should not be too small.
+
+#ifndef LMAT_RAND_CHUNK_ELEMS
+#define LMAT_RAND_CHUNK_ELEMS 1048576
+#endif
 
 #endif 
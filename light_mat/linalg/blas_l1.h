@@ -37,7 +37,7 @@ extern "C"
 }
 
 
-namespace lmat { namespace blas {
+LMAT_BEGIN_NAMESPACE namespace blas {
 
 	// asum
 
@@ -192,6 +192,6 @@ namespace lmat { namespace blas {
 	}
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif 
@@ -14,6 +14,9 @@
 #define LIGHTMAT_BLAS_L2_H_
 
 #include "internal/linalg_aux.h"
+#include "internal/small_linalg.h"
+#include "internal/batched_blas.h"
+#include "internal/batched_lapack.h"
 
 extern "C"
 {
@@ -47,7 +50,7 @@ extern "C"
 }
 
 
-namespace lmat { namespace blas {
+LMAT_BEGIN_NAMESPACE namespace blas {
 
 	// gemv
 
@@ -66,6 +69,45 @@ namespace lmat { namespace blas {
 				return a.nrows() == x.nelems() && a.ncolumns() == y.nelems();
 			}
 		}
+
+		template<class A, class X, class Y>
+		inline void gemv_(float alpha, const A& a, const X& x, float beta, Y& y,
+				char trans, std::false_type)
+		{
+			blas_int lda = (blas_int)a.col_stride();
+			blas_int incx = (blas_int)lmat::internal::get_vector_intv(x);
+			blas_int incy = (blas_int)lmat::internal::get_vector_intv(y);
+
+			blas_int m = (blas_int)a.nrows();
+			blas_int n = (blas_int)a.ncolumns();
+
+			LMAT_BLAS_NAME(sgemv)(&trans, &m, &n, &alpha, a.ptr_data(), &lda, x.ptr_data(), &incx, &beta, y.ptr_data(), &incy);
+		}
+
+		template<class A, class X, class Y>
+		inline void gemv_(double alpha, const A& a, const X& x, double beta, Y& y,
+				char trans, std::false_type)
+		{
+			blas_int lda = (blas_int)a.col_stride();
+			blas_int incx = (blas_int)lmat::internal::get_vector_intv(x);
+			blas_int incy = (blas_int)lmat::internal::get_vector_intv(y);
+
+			blas_int m = (blas_int)a.nrows();
+			blas_int n = (blas_int)a.ncolumns();
+
+			LMAT_BLAS_NAME(dgemv)(&trans, &m, &n, &alpha, a.ptr_data(), &lda, x.ptr_data(), &incx, &beta, y.ptr_data(), &incy);
+		}
+
+		// a has small compile-time dimensions
+		template<typename T, class A, class X, class Y>
+		LMAT_ENSURE_INLINE
+		inline void gemv_(T alpha, const A& a, const X& x, T beta, Y& y,
+				char trans, std::true_type)
+		{
+			lmat::internal::small_gemv(alpha, a,
+					x.ptr_data(), lmat::internal::get_vector_intv(x), beta,
+					y.ptr_data(), lmat::internal::get_vector_intv(y), trans != 'N' && trans != 'n');
+		}
 	}
 
 
@@ -77,14 +119,8 @@ namespace lmat { namespace blas {
 	{
 		LMAT_CHECK_DIMS( internal::gemv_check_dims(a, x, y, trans) )
 
-		blas_int lda = (blas_int)a.col_stride();
-		blas_int incx = (blas_int)lmat::internal::get_vector_intv(x);
-		blas_int incy = (blas_int)lmat::internal::get_vector_intv(y);
-
-		blas_int m = (blas_int)a.nrows();
-		blas_int n = (blas_int)a.ncolumns();
-
-		LMAT_BLAS_NAME(sgemv)(&trans, &m, &n, &alpha, a.ptr_data(), &lda, x.ptr_data(), &incx, &beta, y.ptr_data(), &incy);
+		internal::gemv_(alpha, a.derived(), x.derived(), beta, y.derived(), trans,
+				lmat::internal::is_small_mat<A>());
 	}
 
 	template<class A, class X, class Y>
@@ -95,14 +131,8 @@ namespace lmat { namespace blas {
 	{
 		LMAT_CHECK_DIMS( internal::gemv_check_dims(a, x, y, trans) )
 
-		blas_int lda = (blas_int)a.col_stride();
-		blas_int incx = (blas_int)lmat::internal::get_vector_intv(x);
-		blas_int incy = (blas_int)lmat::internal::get_vector_intv(y);
-
-		blas_int m = (blas_int)a.nrows();
-		blas_int n = (blas_int)a.ncolumns();
-
-		LMAT_BLAS_NAME(dgemv)(&trans, &m, &n, &alpha, a.ptr_data(), &lda, x.ptr_data(), &incx, &beta, y.ptr_data(), &incy);
+		internal::gemv_(alpha, a.derived(), x.derived(), beta, y.derived(), trans,
+				lmat::internal::is_small_mat<A>());
 	}
 
 
@@ -123,6 +153,106 @@ namespace lmat { namespace blas {
 	}
 
 
+	// batched gemv
+
+	namespace internal
+	{
+		template<typename T, class SA, class SX, class SY>
+		inline void gemv_batched_(index_t nb, char trans, index_t m, index_t n,
+				T alpha, const SA& a, index_t lda, const SX& x, index_t incx,
+				T beta, const SY& y, index_t incy)
+		{
+			if (nb == 0) return;
+
+			lmat::internal::batched_gemv_engine<T>::run(nb, !(trans == 'N' || trans == 'n'), m, n,
+					alpha, a, lda, x, incx, beta, y, incy);
+		}
+
+		template<typename T, class A, class X, class Y>
+		inline void gemv_strided_batched_(T alpha, const A& a, const X& x, T beta, Y& y, char trans)
+		{
+			const index_t nb = x.ncolumns();
+			LMAT_CHECK_DIMS( y.ncolumns() == nb && nb > 0 && a.ncolumns() % nb == 0 );
+
+			const index_t m = a.nrows();
+			const index_t n = a.ncolumns() / nb;
+
+			if (trans == 'N' || trans == 'n')
+			{
+				LMAT_CHECK_DIMS( x.nrows() == n && y.nrows() == m );
+			}
+			else
+			{
+				LMAT_CHECK_DIMS( x.nrows() == m && y.nrows() == n );
+			}
+
+			gemv_batched_(nb, trans, m, n, alpha,
+					lmat::internal::strided_batch<const T>(a.ptr_data(), n * a.col_stride()), a.col_stride(),
+					lmat::internal::strided_batch<const T>(x.ptr_data(), x.col_stride()), index_t(1),
+					beta,
+					lmat::internal::strided_batch<T>(y.ptr_data(), y.col_stride()), index_t(1));
+		}
+	}
+
+
+	// strided batch: x_l and y_l are the l-th columns of x and y, a_l is
+	// the l-th of x.ncolumns() equal blocks of consecutive columns of a
+
+	template<class A, class X, class Y>
+	inline void gemv_batched(
+			float alpha, const IRegularMatrix<A, float>& a, const IRegularMatrix<X, float>& x,
+			float beta, IRegularMatrix<Y, float>& y, char trans='N')
+	{
+		internal::gemv_strided_batched_(alpha, a.derived(), x.derived(), beta, y.derived(), trans);
+	}
+
+	template<class A, class X, class Y>
+	inline void gemv_batched(
+			double alpha, const IRegularMatrix<A, double>& a, const IRegularMatrix<X, double>& x,
+			double beta, IRegularMatrix<Y, double>& y, char trans='N')
+	{
+		internal::gemv_strided_batched_(alpha, a.derived(), x.derived(), beta, y.derived(), trans);
+	}
+
+	template<class A, class X, class Y>
+	LMAT_ENSURE_INLINE
+	inline void gemv_batched(
+			const IRegularMatrix<A, float>& a, const IRegularMatrix<X, float>& x, IRegularMatrix<Y, float>& y, char trans='N')
+	{
+		gemv_batched(1.0f, a, x, 0.0f, y, trans);
+	}
+
+	template<class A, class X, class Y>
+	LMAT_ENSURE_INLINE
+	inline void gemv_batched(
+			const IRegularMatrix<A, double>& a, const IRegularMatrix<X, double>& x, IRegularMatrix<Y, double>& y, char trans='N')
+	{
+		gemv_batched(1.0, a, x, 0.0, y, trans);
+	}
+
+	// pointer arrays: the l-th operands are at a[l], x[l], y[l], a_l is m x n
+
+	inline void gemv_batched(index_t nbatch, index_t m, index_t n,
+			float alpha, const float* const* a, index_t lda, const float* const* x, index_t incx,
+			float beta, float* const* y, index_t incy, char trans='N')
+	{
+		internal::gemv_batched_(nbatch, trans, m, n, alpha,
+				lmat::internal::pointer_batch<const float>(a), lda,
+				lmat::internal::pointer_batch<const float>(x), incx,
+				beta, lmat::internal::pointer_batch<float>(y), incy);
+	}
+
+	inline void gemv_batched(index_t nbatch, index_t m, index_t n,
+			double alpha, const double* const* a, index_t lda, const double* const* x, index_t incx,
+			double beta, double* const* y, index_t incy, char trans='N')
+	{
+		internal::gemv_batched_(nbatch, trans, m, n, alpha,
+				lmat::internal::pointer_batch<const double>(a), lda,
+				lmat::internal::pointer_batch<const double>(x), incx,
+				beta, lmat::internal::pointer_batch<double>(y), incy);
+	}
+
+
 	// symv
 
 	namespace internal
@@ -254,6 +384,70 @@ namespace lmat { namespace blas {
 	}
 
 
+	// batched trsv
+
+	namespace internal
+	{
+		template<typename T, class SA, class SX>
+		inline void trsv_batched_(index_t nb, index_t n,
+				const SA& a, index_t lda, const SX& x, index_t incx, const trs& ts)
+		{
+			if (nb == 0) return;
+
+			lmat::internal::batched_lapack_engine<T>::trsv(nb, n,
+					ts.uplo == 'L' || ts.uplo == 'l',
+					!(ts.trans == 'N' || ts.trans == 'n'),
+					ts.diag == 'U' || ts.diag == 'u',
+					a, lda, x, incx);
+		}
+
+		template<typename T, class A, class X>
+		inline void trsv_strided_batched_(const A& a, X& x, const trs& ts)
+		{
+			const index_t n = a.nrows();
+			const index_t nb = x.ncolumns();
+			LMAT_CHECK_DIMS( x.nrows() == n && a.ncolumns() == n * nb );
+
+			trsv_batched_<T>(nb, n,
+					lmat::internal::strided_batch<const T>(a.ptr_data(), n * a.col_stride()), a.col_stride(),
+					lmat::internal::strided_batch<T>(x.ptr_data(), x.col_stride()), index_t(1), ts);
+		}
+	}
+
+	// strided batch: x_l is the l-th column of x, a_l is the l-th
+	// n x n block of columns of a
+
+	template<class A, class X>
+	inline void trsv_batched(const IRegularMatrix<A, float>& a, IRegularMatrix<X, float>& x, const trs& ts)
+	{
+		internal::trsv_strided_batched_<float>(a.derived(), x.derived(), ts);
+	}
+
+	template<class A, class X>
+	inline void trsv_batched(const IRegularMatrix<A, double>& a, IRegularMatrix<X, double>& x, const trs& ts)
+	{
+		internal::trsv_strided_batched_<double>(a.derived(), x.derived(), ts);
+	}
+
+	// pointer arrays: the l-th operands are at a[l] and x[l]
+
+	inline void trsv_batched(index_t nbatch, index_t n, const float* const* a, index_t lda,
+			float* const* x, index_t incx, const trs& ts)
+	{
+		internal::trsv_batched_<float>(nbatch, n,
+				lmat::internal::pointer_batch<const float>(a), lda,
+				lmat::internal::pointer_batch<float>(x), incx, ts);
+	}
+
+	inline void trsv_batched(index_t nbatch, index_t n, const double* const* a, index_t lda,
+			double* const* x, index_t incx, const trs& ts)
+	{
+		internal::trsv_batched_<double>(nbatch, n,
+				lmat::internal::pointer_batch<const double>(a), lda,
+				lmat::internal::pointer_batch<double>(x), incx, ts);
+	}
+
+
 	// ger
 
 	namespace internal
@@ -303,7 +497,7 @@ namespace lmat { namespace blas {
 	}
 
 
-} }
+} LMAT_END_NAMESPACE
 
 
 #endif /* BLAS_L2_H_ */
@@ -14,6 +14,20 @@
 #define LIGHTMAT_BLAS_L3_H_
 
 #include "internal/linalg_aux.h"
+#include "internal/small_linalg.h"
+#include "internal/batched_blas.h"
+
+// Define LMAT_USE_NATIVE_BLAS to use the header-only implementation
+// in internal/native_blas_l3.h instead of an external BLAS library
+
+#ifdef LMAT_USE_NATIVE_BLAS
+
+#include "internal/native_blas_l3.h"
+#define LMAT_BLAS_L3(name) ::lmat::blas::native::name
+
+#else
+
+#define LMAT_BLAS_L3(name) LMAT_BLAS_NAME(name)
 
 extern "C"
 {
@@ -50,8 +64,10 @@ extern "C"
 	           double *b, const blas_int *ldb);
 }
 
+#endif
+
 
-namespace lmat { namespace blas {
+LMAT_BEGIN_NAMESPACE namespace blas {
 
 	// gemm
 
@@ -90,6 +106,49 @@ namespace lmat { namespace blas {
 			n = (blas_int)nb;
 			k = (blas_int)na;
 		}
+
+		template<class A, class B, class C>
+		inline void gemm_(float alpha, const A& a, const B& b, float beta, C& c,
+				char transa, char transb, std::false_type)
+		{
+			blas_int m, n, k;
+			gemm_get_dims(a, b, c, transa, transb, m, n, k);
+
+			blas_int lda = (blas_int)a.col_stride();
+			blas_int ldb = (blas_int)b.col_stride();
+			blas_int ldc = (blas_int)c.col_stride();
+
+			LMAT_BLAS_L3(sgemm)(&transa, &transb, &m, &n, &k, &alpha,
+					a.ptr_data(), &lda, b.ptr_data(), &ldb, &beta, c.ptr_data(), &ldc);
+		}
+
+		template<class A, class B, class C>
+		inline void gemm_(double alpha, const A& a, const B& b, double beta, C& c,
+				char transa, char transb, std::false_type)
+		{
+			blas_int m, n, k;
+			gemm_get_dims(a, b, c, transa, transb, m, n, k);
+
+			blas_int lda = (blas_int)a.col_stride();
+			blas_int ldb = (blas_int)b.col_stride();
+			blas_int ldc = (blas_int)c.col_stride();
+
+			LMAT_BLAS_L3(dgemm)(&transa, &transb, &m, &n, &k, &alpha,
+					a.ptr_data(), &lda, b.ptr_data(), &ldb, &beta, c.ptr_data(), &ldc);
+		}
+
+		// all dimensions are small compile-time constants
+		template<typename T, class A, class B, class C>
+		LMAT_ENSURE_INLINE
+		inline void gemm_(T alpha, const A& a, const B& b, T beta, C& c,
+				char transa, char transb, std::true_type)
+		{
+			blas_int m, n, k;
+			gemm_get_dims(a, b, c, transa, transb, m, n, k);
+
+			lmat::internal::small_gemm(alpha, a, b, beta, c,
+					transa != 'N' && transa != 'n', transb != 'N' && transb != 'n');
+		}
 	}
 
 
@@ -98,15 +157,8 @@ namespace lmat { namespace blas {
 	inline void gemm(float alpha, const IRegularMatrix<A, float>& a, const IRegularMatrix<B, float>& b,
 	          float beta, IRegularMatrix<C, float>& c, char transa='N', char transb='N')
 	{
-		blas_int m, n, k;
-		internal::gemm_get_dims(a, b, c, transa, transb, m, n, k);
-
-		blas_int lda = (blas_int)a.col_stride();
-		blas_int ldb = (blas_int)b.col_stride();
-		blas_int ldc = (blas_int)c.col_stride();
-
-		LMAT_BLAS_NAME(sgemm)(&transa, &transb, &m, &n, &k, &alpha,
-				a.ptr_data(), &lda, b.ptr_data(), &ldb, &beta, c.ptr_data(), &ldc);
+		internal::gemm_(alpha, a.derived(), b.derived(), beta, c.derived(), transa, transb,
+				lmat::internal::is_small_gemm<A, B, C>());
 	}
 
 	template<class A, class B, class C>
@@ -114,15 +166,8 @@ namespace lmat { namespace blas {
 	inline void gemm(double alpha, const IRegularMatrix<A, double>& a, const IRegularMatrix<B, double>& b,
 	          double beta, IRegularMatrix<C, double>& c, char transa='N', char transb='N')
 	{
-		blas_int m, n, k;
-		internal::gemm_get_dims(a, b, c, transa, transb, m, n, k);
-
-		blas_int lda = (blas_int)a.col_stride();
-		blas_int ldb = (blas_int)b.col_stride();
-		blas_int ldc = (blas_int)c.col_stride();
-
-		LMAT_BLAS_NAME(dgemm)(&transa, &transb, &m, &n, &k, &alpha,
-				a.ptr_data(), &lda, b.ptr_data(), &ldb, &beta, c.ptr_data(), &ldc);
+		internal::gemm_(alpha, a.derived(), b.derived(), beta, c.derived(), transa, transb,
+				lmat::internal::is_small_gemm<A, B, C>());
 	}
 
 
@@ -143,6 +188,146 @@ namespace lmat { namespace blas {
 	}
 
 
+	// batched gemm
+
+	namespace internal
+	{
+		LMAT_ENSURE_INLINE
+		inline void gemm_p(char transa, char transb, index_t m, index_t n, index_t k,
+				float alpha, const float *a, index_t lda, const float *b, index_t ldb,
+				float beta, float *c, index_t ldc)
+		{
+			blas_int m_ = (blas_int)m, n_ = (blas_int)n, k_ = (blas_int)k;
+			blas_int lda_ = (blas_int)lda, ldb_ = (blas_int)ldb, ldc_ = (blas_int)ldc;
+
+			LMAT_BLAS_L3(sgemm)(&transa, &transb, &m_, &n_, &k_, &alpha,
+					a, &lda_, b, &ldb_, &beta, c, &ldc_);
+		}
+
+		LMAT_ENSURE_INLINE
+		inline void gemm_p(char transa, char transb, index_t m, index_t n, index_t k,
+				double alpha, const double *a, index_t lda, const double *b, index_t ldb,
+				double beta, double *c, index_t ldc)
+		{
+			blas_int m_ = (blas_int)m, n_ = (blas_int)n, k_ = (blas_int)k;
+			blas_int lda_ = (blas_int)lda, ldb_ = (blas_int)ldb, ldc_ = (blas_int)ldc;
+
+			LMAT_BLAS_L3(dgemm)(&transa, &transb, &m_, &n_, &k_, &alpha,
+					a, &lda_, b, &ldb_, &beta, c, &ldc_);
+		}
+
+		template<typename T, class SA, class SB, class SC>
+		inline void gemm_batched_(index_t nb, char transa, char transb, index_t m, index_t n, index_t k,
+				T alpha, const SA& a, index_t lda, const SB& b, index_t ldb,
+				T beta, const SC& c, index_t ldc)
+		{
+			if (nb == 0 || m == 0 || n == 0) return;
+
+			bool ta = !(transa == 'N' || transa == 'n');
+			bool tb = !(transb == 'N' || transb == 'n');
+
+			typedef lmat::internal::batched_gemm_engine<T> engine_t;
+
+			if (engine_t::applicable(m, n, k))
+			{
+				engine_t::run(nb, ta, tb, m, n, k,
+						alpha, a, lda, b, ldb, beta, c, ldc);
+			}
+			else
+			{
+				lmat::internal::batched_for(nb, nb * (m * k + k * n + m * n), [&](index_t l0, index_t l1)
+				{
+					for (index_t l = l0; l < l1; ++l)
+						gemm_p(transa, transb, m, n, k, alpha, a[l], lda, b[l], ldb, beta, c[l], ldc);
+				});
+			}
+		}
+
+		template<typename T, class A, class B, class C>
+		inline void gemm_strided_batched_(T alpha, const A& a, const B& b, T beta, C& c,
+				index_t nb, char transa, char transb)
+		{
+			LMAT_CHECK_DIMS( nb > 0 && a.ncolumns() % nb == 0 && b.ncolumns() % nb == 0 && c.ncolumns() % nb == 0 );
+
+			const index_t an = a.ncolumns() / nb;
+			const index_t bn = b.ncolumns() / nb;
+			const index_t cn = c.ncolumns() / nb;
+
+			bool ta = !(transa == 'N' || transa == 'n');
+			bool tb = !(transb == 'N' || transb == 'n');
+
+			const index_t m = ta ? an : a.nrows();
+			const index_t k = ta ? a.nrows() : an;
+			const index_t n = tb ? b.nrows() : bn;
+
+			LMAT_CHECK_DIMS( (tb ? bn : b.nrows()) == k && c.nrows() == m && cn == n );
+
+			gemm_batched_(nb, transa, transb, m, n, k, alpha,
+					lmat::internal::strided_batch<const T>(a.ptr_data(), an * a.col_stride()), a.col_stride(),
+					lmat::internal::strided_batch<const T>(b.ptr_data(), bn * b.col_stride()), b.col_stride(),
+					beta,
+					lmat::internal::strided_batch<T>(c.ptr_data(), cn * c.col_stride()), c.col_stride());
+		}
+	}
+
+
+	// strided batch: the l-th matrix of a, b, c is the l-th of nbatch
+	// equal blocks of consecutive columns, c_l = alpha * op(a_l) * op(b_l) + beta * c_l
+
+	template<class A, class B, class C>
+	inline void gemm_batched(float alpha, const IRegularMatrix<A, float>& a, const IRegularMatrix<B, float>& b,
+			float beta, IRegularMatrix<C, float>& c, index_t nbatch, char transa='N', char transb='N')
+	{
+		internal::gemm_strided_batched_(alpha, a.derived(), b.derived(), beta, c.derived(), nbatch, transa, transb);
+	}
+
+	template<class A, class B, class C>
+	inline void gemm_batched(double alpha, const IRegularMatrix<A, double>& a, const IRegularMatrix<B, double>& b,
+			double beta, IRegularMatrix<C, double>& c, index_t nbatch, char transa='N', char transb='N')
+	{
+		internal::gemm_strided_batched_(alpha, a.derived(), b.derived(), beta, c.derived(), nbatch, transa, transb);
+	}
+
+	template<class A, class B, class C>
+	LMAT_ENSURE_INLINE
+	inline void gemm_batched(const IRegularMatrix<A, float>& a, const IRegularMatrix<B, float>& b,
+			IRegularMatrix<C, float>& c, index_t nbatch, char transa='N', char transb='N')
+	{
+		gemm_batched(1.0f, a, b, 0.0f, c, nbatch, transa, transb);
+	}
+
+	template<class A, class B, class C>
+	LMAT_ENSURE_INLINE
+	inline void gemm_batched(const IRegularMatrix<A, double>& a, const IRegularMatrix<B, double>& b,
+			IRegularMatrix<C, double>& c, index_t nbatch, char transa='N', char transb='N')
+	{
+		gemm_batched(1.0, a, b, 0.0, c, nbatch, transa, transb);
+	}
+
+	// pointer arrays: the l-th matrices are at a[l], b[l], c[l],
+	// op(a_l) is m x k and op(b_l) is k x n
+
+	inline void gemm_batched(index_t nbatch, index_t m, index_t n, index_t k,
+			float alpha, const float* const* a, index_t lda, const float* const* b, index_t ldb,
+			float beta, float* const* c, index_t ldc, char transa='N', char transb='N')
+	{
+		internal::gemm_batched_(nbatch, transa, transb, m, n, k, alpha,
+				lmat::internal::pointer_batch<const float>(a), lda,
+				lmat::internal::pointer_batch<const float>(b), ldb,
+				beta, lmat::internal::pointer_batch<float>(c), ldc);
+	}
+
+	inline void gemm_batched(index_t nbatch, index_t m, index_t n, index_t k,
+			double alpha, const double* const* a, index_t lda, const double* const* b, index_t ldb,
+			double beta, double* const* c, index_t ldc, char transa='N', char transb='N')
+	{
+		internal::gemm_batched_(nbatch, transa, transb, m, n, k, alpha,
+				lmat::internal::pointer_batch<const double>(a), lda,
+				lmat::internal::pointer_batch<const double>(b), ldb,
+				beta, lmat::internal::pointer_batch<double>(c), ldc);
+	}
+
+
 	// symm
 
 	namespace internal
@@ -214,7 +399,7 @@ namespace lmat { namespace blas {
 		blas_int ldb = (blas_int)b.col_stride();
 		blas_int ldc = (blas_int)c.col_stride();
 
-		LMAT_BLAS_NAME(ssymm)(&side, &uplo, &m, &n,
+		LMAT_BLAS_L3(ssymm)(&side, &uplo, &m, &n,
 				&alpha, a.ptr_data(), &lda, b.ptr_data(), &ldb, &beta, c.ptr_data(), &ldc);
 	}
 
@@ -230,7 +415,7 @@ namespace lmat { namespace blas {
 		blas_int ldb = (blas_int)b.col_stride();
 		blas_int ldc = (blas_int)c.col_stride();
 
-		LMAT_BLAS_NAME(dsymm)(&side, &uplo, &m, &n,
+		LMAT_BLAS_L3(dsymm)(&side, &uplo, &m, &n,
 				&alpha, a.ptr_data(), &lda, b.ptr_data(), &ldb, &beta, c.ptr_data(), &ldc);
 	}
 
@@ -247,7 +432,7 @@ namespace lmat { namespace blas {
 	inline void symm(const IRegularMatrix<A, double>& a, const IRegularMatrix<B, double>& b,
 			         IRegularMatrix<C, double>& c, char side='L', char uplo='L')
 	{
-		symm(1.0f, a, b, 0.0f, c, side, uplo);
+		symm(1.0, a, b, 0.0, c, side, uplo);
 	}
 
 
@@ -264,7 +449,7 @@ namespace lmat { namespace blas {
 		blas_int lda = (blas_int)a.col_stride();
 		blas_int ldb = (blas_int)b.col_stride();
 
-		LMAT_BLAS_NAME(strmm)(&side, &(ts.uplo), &(ts.trans), &(ts.diag),
+		LMAT_BLAS_L3(strmm)(&side, &(ts.uplo), &(ts.trans), &(ts.diag),
 				&m, &n, &alpha, a.ptr_data(), &lda, b.ptr_data(), &ldb);
 	}
 
@@ -279,7 +464,7 @@ namespace lmat { namespace blas {
 		blas_int lda = (blas_int)a.col_stride();
 		blas_int ldb = (blas_int)b.col_stride();
 
-		LMAT_BLAS_NAME(dtrmm)(&side, &(ts.uplo), &(ts.trans), &(ts.diag),
+		LMAT_BLAS_L3(dtrmm)(&side, &(ts.uplo), &(ts.trans), &(ts.diag),
 				&m, &n, &alpha, a.ptr_data(), &lda, b.ptr_data(), &ldb);
 	}
 
@@ -313,7 +498,7 @@ namespace lmat { namespace blas {
 		blas_int lda = (blas_int)a.col_stride();
 		blas_int ldb = (blas_int)b.col_stride();
 
-		LMAT_BLAS_NAME(strsm)(&side, &(ts.uplo), &(ts.trans), &(ts.diag),
+		LMAT_BLAS_L3(strsm)(&side, &(ts.uplo), &(ts.trans), &(ts.diag),
 				&m, &n, &alpha, a.ptr_data(), &lda, b.ptr_data(), &ldb);
 	}
 
@@ -328,7 +513,7 @@ namespace lmat { namespace blas {
 		blas_int lda = (blas_int)a.col_stride();
 		blas_int ldb = (blas_int)b.col_stride();
 
-		LMAT_BLAS_NAME(dtrsm)(&side, &(ts.uplo), &(ts.trans), &(ts.diag),
+		LMAT_BLAS_L3(dtrsm)(&side, &(ts.uplo), &(ts.trans), &(ts.diag),
 				&m, &n, &alpha, a.ptr_data(), &lda, b.ptr_data(), &ldb);
 	}
 
@@ -349,6 +534,6 @@ namespace lmat { namespace blas {
 	}
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif /* BLAS_L3_H_ */
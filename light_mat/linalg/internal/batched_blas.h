@@ -0,0 +1,630 @@
+/**
+ * @file batched_blas.h
+ *
+ * @brief Engine for batched GEMM and GEMV over many small matrices
+ *
+ * A batch is accessed through a batch layout (strided_batch or
+ * pointer_batch), which maps an index to the base address of a
+ * matrix or vector.
+ *
+ * For GEMM, W matrices (W being the SIMD pack width) are interleaved
+ * such that the l-th lane of every pack belongs to the l-th matrix.
+ * The product of a whole group is then a plain vertical SIMD loop,
+ * with neither shuffles nor horizontal reductions, whatever the
+ * shapes and transpositions are.
+ *
+ * Groups of matrices are distributed over threads when compiled
+ * with OpenMP (see common/parallel.h).
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_BATCHED_BLAS_H_
+#define LIGHTMAT_BATCHED_BLAS_H_
+
+#include <light_mat/linalg/linalg_fwd.h>
+#include <light_mat/common/block.h>
+#include <light_mat/common/parallel.h>
+#include <light_mat/simd/simd.h>
+
+LMAT_BEGIN_NAMESPACE namespace internal {
+
+	/********************************************
+	 *
+	 *  batch layouts
+	 *
+	 ********************************************/
+
+	// the l-th item is at base + l * stride
+
+	template<typename T>
+	class strided_batch
+	{
+	public:
+		LMAT_ENSURE_INLINE
+		strided_batch(T *base, index_t stride)
+		: m_base(base), m_stride(stride) { }
+
+		LMAT_ENSURE_INLINE
+		T* operator[] (index_t l) const
+		{
+			return m_base + l * m_stride;
+		}
+
+		LMAT_ENSURE_INLINE
+		strided_batch offset(index_t l) const
+		{
+			return strided_batch(m_base + l * m_stride, m_stride);
+		}
+
+	private:
+		T *m_base;
+		index_t m_stride;
+	};
+
+	// the l-th item is at ptrs[l]
+
+	template<typename T>
+	class pointer_batch
+	{
+	public:
+		LMAT_ENSURE_INLINE
+		explicit pointer_batch(T* const *ptrs)
+		: m_ptrs(ptrs) { }
+
+		LMAT_ENSURE_INLINE
+		T* operator[] (index_t l) const
+		{
+			return m_ptrs[l];
+		}
+
+		LMAT_ENSURE_INLINE
+		pointer_batch offset(index_t l) const
+		{
+			return pointer_batch(m_ptrs + l);
+		}
+
+	private:
+		T* const *m_ptrs;
+	};
+
+
+	/********************************************
+	 *
+	 *  parallel driver
+	 *
+	 ********************************************/
+
+	// calls fun(g0, g1) on sub-ranges that cover [0, ngroups),
+	// work is the total number of elements touched by the batch
+
+	template<class Fun>
+	inline void batched_for(index_t ngroups, index_t work, const Fun& fun)
+	{
+		if (!par_worthy(work, LMAT_PAR_MIN_ELEMS) || ngroups < 2)
+		{
+			fun(index_t(0), ngroups);
+			return;
+		}
+
+		par_partition part = par_even_partition(ngroups, par_max_threads(), 1);
+		const index_t nc = part.nchunks();
+
+#ifdef LMAT_HAS_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+		for (index_t k = 0; k < nc; ++k)
+		{
+			const index_t g0 = part.chunk_begin(k);
+			fun(g0, g0 + part.chunk_length(k));
+		}
+	}
+
+
+	/********************************************
+	 *
+	 *  interleaving
+	 *
+	 ********************************************/
+
+	// transposition of w x w blocks between w columns of distinct
+	// matrices and w lanes of the interleaved layout
+
+	template<typename T> struct interleave_kernel;
+
+#ifdef LMAT_HAS_AVX
+
+	template<>
+	struct interleave_kernel<float>
+	{
+		typedef avx_f32pk pack_t;
+		static const index_t width = 8;
+
+		LMAT_ENSURE_INLINE
+		static void transpose_(pack_t *a)
+		{
+			transpose(a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7]);
+		}
+	};
+
+	template<>
+	struct interleave_kernel<double>
+	{
+		typedef avx_f64pk pack_t;
+		static const index_t width = 4;
+
+		LMAT_ENSURE_INLINE
+		static void transpose_(pack_t *a)
+		{
+			transpose(a[0], a[1], a[2], a[3]);
+		}
+	};
+
+#else
+
+	template<>
+	struct interleave_kernel<float>
+	{
+		typedef sse_f32pk pack_t;
+		static const index_t width = 4;
+
+		LMAT_ENSURE_INLINE
+		static void transpose_(pack_t *a)
+		{
+			transpose(a[0], a[1], a[2], a[3]);
+		}
+	};
+
+	template<>
+	struct interleave_kernel<double>
+	{
+		typedef sse_f64pk pack_t;
+		static const index_t width = 2;
+
+		LMAT_ENSURE_INLINE
+		static void transpose_(pack_t *a)
+		{
+			transpose(a[0], a[1]);
+		}
+	};
+
+#endif
+
+	// moves W matrices between their own storage and the interleaved layout,
+	// where element (i, j) of the l-th matrix of an m x n group is at (i + j * m) * W + l
+
+	template<typename T>
+	struct batch_interleaver
+	{
+		typedef simd_pack<T, default_simd_kind> pack_t;
+		static const index_t W = (index_t)pack_t::pack_width;
+
+		typedef interleave_kernel<T> ikernel_t;
+		typedef typename ikernel_t::pack_t ipack_t;
+		static const index_t IW = ikernel_t::width;
+
+		// one matrix per lane, the lanes beyond the batch refer to
+		// a column of zeros (with a leading dimension of zero)
+
+		struct lanes
+		{
+			T *ptrs[W];
+			index_t lds[W];
+		};
+
+		template<class S>
+		static void set_lanes(lanes& ls, index_t cnt, const S& src, index_t ld, T *pad)
+		{
+			for (index_t l = 0; l < W; ++l)
+			{
+				ls.ptrs[l] = l < cnt ? const_cast<T*>(src[l]) : pad;
+				ls.lds[l] = l < cnt ? ld : 0;
+			}
+		}
+
+		// when every lane is a contiguous m x n block, the group can
+		// be moved as a single column of length m * n
+
+		LMAT_ENSURE_INLINE
+		static bool is_contiguous(const lanes& ls, index_t m)
+		{
+			for (index_t l = 0; l < W; ++l)
+			{
+				if (ls.lds[l] != m) return false;
+			}
+			return true;
+		}
+
+		// dst[(i + j * m) * W + l] = a_l(i, j)
+
+		static void interleave(const lanes& ls, index_t m, index_t n, T *dst)
+		{
+			if (n > 1 && is_contiguous(ls, m))
+			{
+				interleave(ls, m * n, 1, dst);
+				return;
+			}
+
+			const index_t mv = m - m % IW;
+			const T *q[W];
+
+			for (index_t j = 0; j < n; ++j)
+			{
+				for (index_t l = 0; l < W; ++l) q[l] = ls.ptrs[l] + j * ls.lds[l];
+				T *d = dst + j * m * W;
+
+				for (index_t i = 0; i < mv; i += IW)
+				{
+					for (index_t l0 = 0; l0 < W; l0 += IW)
+					{
+						ipack_t a[IW];
+						for (index_t l = 0; l < IW; ++l) a[l].load_u(q[l0 + l] + i);
+						ikernel_t::transpose_(a);
+						for (index_t t = 0; t < IW; ++t) a[t].store_u(d + (i + t) * W + l0);
+					}
+				}
+
+				for (index_t i = mv; i < m; ++i)
+					for (index_t l = 0; l < W; ++l) d[i * W + l] = q[l][i];
+			}
+		}
+
+		// c_l(i, j) = alpha * src[(i + j * m) * W + l] + beta * c_l(i, j)
+
+		static void deinterleave(const T *src, index_t m, index_t n, T alpha, T beta, const lanes& ls)
+		{
+			if (n > 1 && is_contiguous(ls, m))
+			{
+				deinterleave(src, m * n, 1, alpha, beta, ls);
+				return;
+			}
+
+			const index_t mv = m - m % IW;
+			const ipack_t av(alpha);
+			const ipack_t bv(beta);
+			T *q[W];
+
+			for (index_t j = 0; j < n; ++j)
+			{
+				for (index_t l = 0; l < W; ++l) q[l] = ls.ptrs[l] + j * ls.lds[l];
+				const T *s = src + j * m * W;
+
+				for (index_t i = 0; i < mv; i += IW)
+				{
+					for (index_t l0 = 0; l0 < W; l0 += IW)
+					{
+						ipack_t a[IW];
+						for (index_t t = 0; t < IW; ++t) a[t].load_u(s + (i + t) * W + l0);
+						ikernel_t::transpose_(a);
+
+						for (index_t l = 0; l < IW; ++l)
+						{
+							T *c = q[l0 + l] + i;
+							if (beta == T(0))
+								(av * a[l]).store_u(c);
+							else
+								math::fma(av, a[l], bv * ipack_t(c)).store_u(c);
+						}
+					}
+				}
+
+				for (index_t i = mv; i < m; ++i)
+				{
+					for (index_t l = 0; l < W; ++l)
+					{
+						T& c = q[l][i];
+						c = beta == T(0) ? alpha * s[i * W + l] : alpha * s[i * W + l] + beta * c;
+					}
+				}
+			}
+		}
+	};
+
+
+	/********************************************
+	 *
+	 *  interleaved GEMM
+	 *
+	 *  c_l = alpha * op(a_l) * op(b_l) + beta * c_l
+	 *
+	 *  op(a_l) is m x k, op(b_l) is k x n
+	 *
+	 ********************************************/
+
+	// the limits of the interleaved engine follow from the reuse in
+	// multiply() below:
+	//
+	//  - the k x NR panel of op(b) is re-read for every tile of MR rows,
+	//    and should stay in L1 cache: k * NR * W * sizeof(T) bytes;
+	//
+	//  - op(a) is re-read for every tile of NR columns, and should stay
+	//    in L2 cache: m * k * sizeof(T) bytes per lane, W lanes.
+	//
+	// With 16 KiB for the panel and 32 KiB of op(a) per lane (64 x 64
+	// doubles), every product with m, n, k <= 64 is interleaved, for
+	// each pack kind. op(a) of a group then takes at most 128 KiB with
+	// AVX, and 256 KiB with AVX-512. Larger products are faster done
+	// one matrix at a time.
+
+	const index_t batched_gemm_panel_bytes = 16384;
+	const index_t batched_gemm_lane_bytes = 32768;
+
+	template<typename Kind> struct batched_gemm_tile_cols;
+
+	template<> struct batched_gemm_tile_cols<sse_t> { static const index_t value = 2; };
+	template<> struct batched_gemm_tile_cols<avx_t> { static const index_t value = 3; };
+	template<> struct batched_gemm_tile_cols<avx512_t> { static const index_t value = 4; };
+
+	template<typename T>
+	struct batched_gemm_engine
+	{
+		typedef simd_pack<T, default_simd_kind> pack_t;
+		static const index_t W = (index_t)pack_t::pack_width;
+
+		typedef batch_interleaver<T> interleaver_t;
+		typedef typename interleaver_t::lanes lanes;
+
+		// an MR x NR tile of accumulators, MR packs of a and a pack of b
+		// should fit in the register file
+
+		static const index_t MR = 4;
+		static const index_t NR = batched_gemm_tile_cols<default_simd_kind>::value;
+
+		LMAT_ENSURE_INLINE
+		static bool applicable(index_t m, index_t n, index_t k)
+		{
+			return k * NR * W * (index_t)sizeof(T) <= batched_gemm_panel_bytes &&
+					m * k * (index_t)sizeof(T) <= batched_gemm_lane_bytes;
+		}
+
+		// the interleaved operands keep the storage order of the inputs,
+		// op(a)(i, p) is at (i * ars + p * acs) * W, op(b)(p, j) is at (p * brs + j * bcs) * W
+
+		struct operands
+		{
+			const T *pa;
+			const T *pb;
+			index_t ars, acs;
+			index_t brs, bcs;
+		};
+
+		// pc(i0:i0+R, j0:j0+C) = op(a)(i0:i0+R, :) * op(b)(:, j0:j0+C)
+
+		template<index_t R, index_t C>
+		LMAT_ENSURE_INLINE
+		static void tile(const operands& u, index_t m, index_t k, T *pc, index_t i0, index_t j0)
+		{
+			pack_t s[R][C];
+			for (index_t r = 0; r < R; ++r)
+				for (index_t c = 0; c < C; ++c) s[r][c].reset();
+
+			const T *a = u.pa + i0 * u.ars * W;
+			const T *b = u.pb + j0 * u.bcs * W;
+
+			for (index_t p = 0; p < k; ++p, a += u.acs * W, b += u.brs * W)
+			{
+				pack_t x[R];
+				for (index_t r = 0; r < R; ++r) x[r].load_u(a + r * u.ars * W);
+
+				for (index_t c = 0; c < C; ++c)
+				{
+					pack_t y(b + c * u.bcs * W);
+					for (index_t r = 0; r < R; ++r)
+						s[r][c] = math::fma(x[r], y, s[r][c]);
+				}
+			}
+
+			for (index_t c = 0; c < C; ++c)
+				for (index_t r = 0; r < R; ++r)
+					s[r][c].store_u(pc + ((i0 + r) + (j0 + c) * m) * W);
+		}
+
+		template<index_t C>
+		LMAT_ENSURE_INLINE
+		static void tile_cols(const operands& u, index_t m, index_t k, T *pc, index_t j0)
+		{
+			index_t i = 0;
+			for (; i + MR <= m; i += MR) tile<MR, C>(u, m, k, pc, i, j0);
+			for (; i < m; ++i) tile<1, C>(u, m, k, pc, i, j0);
+		}
+
+		static void multiply(const operands& u, index_t m, index_t n, index_t k, T *pc)
+		{
+			index_t j = 0;
+			for (; j + NR <= n; j += NR) tile_cols<NR>(u, m, k, pc, j);
+			for (; j < n; ++j) tile_cols<1>(u, m, k, pc, j);
+		}
+
+		template<class SA, class SB, class SC>
+		static void run(index_t nb, bool ta, bool tb, index_t m, index_t n, index_t k,
+				T alpha, const SA& a, index_t lda, const SB& b, index_t ldb,
+				T beta, const SC& c, index_t ldc)
+		{
+			const index_t ng = (nb + W - 1) / W;
+
+			// sizes of op(a) and op(b) as stored
+			const index_t am = ta ? k : m;
+			const index_t an = ta ? m : k;
+			const index_t bm = tb ? n : k;
+			const index_t bn = tb ? k : n;
+
+			batched_for(ng, nb * (m * k + k * n + m * n), [&](index_t g0, index_t g1)
+			{
+				dblock<T> abuf(am * an * W);
+				dblock<T> bbuf(bm * bn * W);
+				dblock<T> cbuf(m * n * W);
+
+				index_t pad_len = am > bm ? am : bm;
+				if (m > pad_len) pad_len = m;
+				dblock<T> pad(pad_len, lmat::zero());
+
+				operands u;
+				u.pa = abuf.ptr_data();
+				u.pb = bbuf.ptr_data();
+				u.ars = ta ? am : 1;
+				u.acs = ta ? 1 : am;
+				u.brs = tb ? bm : 1;
+				u.bcs = tb ? 1 : bm;
+
+				lanes ls;
+
+				for (index_t g = g0; g < g1; ++g)
+				{
+					const index_t l0 = g * W;
+					const index_t cnt = nb - l0 < W ? nb - l0 : W;
+
+					interleaver_t::set_lanes(ls, cnt, a.offset(l0), lda, pad.ptr_data());
+					interleaver_t::interleave(ls, am, an, abuf.ptr_data());
+
+					interleaver_t::set_lanes(ls, cnt, b.offset(l0), ldb, pad.ptr_data());
+					interleaver_t::interleave(ls, bm, bn, bbuf.ptr_data());
+
+					multiply(u, m, n, k, cbuf.ptr_data());
+
+					// the padded lanes write to pad, which is reset for the next group
+					interleaver_t::set_lanes(ls, cnt, c.offset(l0), ldc, pad.ptr_data());
+					interleaver_t::deinterleave(cbuf.ptr_data(), m, n, alpha, beta, ls);
+					if (cnt < W) zero_vec(pad_len, pad.ptr_data());
+				}
+			});
+		}
+	};
+
+
+	/********************************************
+	 *
+	 *  batched GEMV
+	 *
+	 *  y_l = alpha * op(a_l) * x_l + beta * y_l
+	 *
+	 *  a_l is m x n
+	 *
+	 ********************************************/
+
+	// every element of a_l is used only once, so interleaving would
+	// cost as much as the product, the matrices are done one by one
+
+	template<typename T>
+	struct batched_gemv_engine
+	{
+		typedef simd_pack<T, default_simd_kind> pack_t;
+		static const index_t W = (index_t)pack_t::pack_width;
+
+		static void scale(index_t len, T beta, T *y, index_t incy)
+		{
+			if (beta == T(0))
+			{
+				for (index_t i = 0; i < len; ++i) y[i * incy] = T(0);
+			}
+			else if (beta != T(1))
+			{
+				for (index_t i = 0; i < len; ++i) y[i * incy] *= beta;
+			}
+		}
+
+		static void gemv_n(index_t m, index_t n, T alpha, const T *a, index_t lda,
+				const T *x, index_t incx, T beta, T *y, index_t incy)
+		{
+			scale(m, beta, y, incy);
+
+			if (incy != 1)
+			{
+				for (index_t j = 0; j < n; ++j, a += lda)
+				{
+					T u = alpha * x[j * incx];
+					for (index_t i = 0; i < m; ++i) y[i * incy] += a[i] * u;
+				}
+				return;
+			}
+
+			const index_t mv = m - m % W;
+
+			// four columns at a time, to save loads and stores of y
+
+			index_t j = 0;
+			for (; j + 4 <= n; j += 4)
+			{
+				const T *a0 = a + j * lda;
+				const T *a1 = a0 + lda;
+				const T *a2 = a1 + lda;
+				const T *a3 = a2 + lda;
+
+				T u0 = alpha * x[j * incx];
+				T u1 = alpha * x[(j + 1) * incx];
+				T u2 = alpha * x[(j + 2) * incx];
+				T u3 = alpha * x[(j + 3) * incx];
+
+				pack_t v0(u0), v1(u1), v2(u2), v3(u3);
+
+				for (index_t i = 0; i < mv; i += W)
+				{
+					pack_t s(y + i);
+					s = math::fma(pack_t(a0 + i), v0, s);
+					s = math::fma(pack_t(a1 + i), v1, s);
+					s = math::fma(pack_t(a2 + i), v2, s);
+					s = math::fma(pack_t(a3 + i), v3, s);
+					s.store_u(y + i);
+				}
+
+				for (index_t i = mv; i < m; ++i)
+					y[i] += a0[i] * u0 + a1[i] * u1 + a2[i] * u2 + a3[i] * u3;
+			}
+
+			for (; j < n; ++j)
+			{
+				const T *aj = a + j * lda;
+				T u = alpha * x[j * incx];
+				pack_t v(u);
+
+				for (index_t i = 0; i < mv; i += W)
+					math::fma(pack_t(aj + i), v, pack_t(y + i)).store_u(y + i);
+
+				for (index_t i = mv; i < m; ++i) y[i] += aj[i] * u;
+			}
+		}
+
+		static void gemv_t(index_t m, index_t n, T alpha, const T *a, index_t lda,
+				const T *x, index_t incx, T beta, T *y, index_t incy)
+		{
+			const index_t mv = incx == 1 ? m - m % W : 0;
+
+			for (index_t j = 0; j < n; ++j, a += lda)
+			{
+				pack_t s;
+				s.reset();
+				for (index_t i = 0; i < mv; i += W)
+					s = math::fma(pack_t(a + i), pack_t(x + i), s);
+
+				T r = sum(s);
+				for (index_t i = mv; i < m; ++i) r += a[i] * x[i * incx];
+
+				T& yj = y[j * incy];
+				yj = beta == T(0) ? alpha * r : alpha * r + beta * yj;
+			}
+		}
+
+		template<class SA, class SX, class SY>
+		static void run(index_t nb, bool ta, index_t m, index_t n,
+				T alpha, const SA& a, index_t lda, const SX& x, index_t incx,
+				T beta, const SY& y, index_t incy)
+		{
+			batched_for(nb, nb * (m * n + m + n), [&](index_t l0, index_t l1)
+			{
+				for (index_t l = l0; l < l1; ++l)
+				{
+					if (!ta)
+						gemv_n(m, n, alpha, a[l], lda, x[l], incx, beta, y[l], incy);
+					else
+						gemv_t(m, n, alpha, a[l], lda, x[l], incx, beta, y[l], incy);
+				}
+			});
+		}
+	};
+
+} LMAT_END_NAMESPACE
+
+#endif
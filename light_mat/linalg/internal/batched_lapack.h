@@ -0,0 +1,523 @@
+/**
+ * @file batched_lapack.h
+ *
+ * @brief Engine for batched LU and Cholesky factorizations and
+ *        triangular solves over many small systems
+ *
+ * As for batched GEMM (see batched_blas.h), W systems of the same size
+ * are interleaved, such that every step of a factorization or of a
+ * substitution processes one system per lane of a SIMD pack.
+ *
+ * LU pivots are chosen per lane with SIMD comparisons, while the row
+ * interchanges, which differ across lanes, are done by scalar code.
+ *
+ * Instead of stopping at the first failure, every system gets its own
+ * info code, the results of the failed systems are unspecified.
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_BATCHED_LAPACK_H_
+#define LIGHTMAT_BATCHED_LAPACK_H_
+
+#include <light_mat/linalg/internal/batched_blas.h>
+#include <light_mat/math/math_base.h>
+#include <utility>
+
+LMAT_BEGIN_NAMESPACE namespace internal {
+
+	template<typename T>
+	struct batched_lapack_engine
+	{
+		typedef simd_pack<T, default_simd_kind> pack_t;
+		typedef simd_bpack<T, default_simd_kind> bpack_t;
+		static const index_t W = (index_t)pack_t::pack_width;
+
+		typedef batch_interleaver<T> interleaver_t;
+		typedef typename interleaver_t::lanes lanes;
+
+
+		/********************************************
+		 *
+		 *  kernels on a group of W systems
+		 *
+		 *  an n x n matrix is interleaved with its
+		 *  (i, j) element at (i + j * n) * W, a
+		 *  triangular view refers to its element
+		 *  (i, j) at (i * rs + j * cs) * W
+		 *
+		 ********************************************/
+
+		// swaps the i-th and p-th rows of the l-th matrix of an interleaved m x n group
+
+		LMAT_ENSURE_INLINE
+		static void swap_rows(index_t m, index_t n, T *a, index_t i, index_t p, index_t l)
+		{
+			for (index_t j = 0; j < n; ++j)
+				std::swap(a[(i + j * m) * W + l], a[(p + j * m) * W + l]);
+		}
+
+		// x <- inv(t) * x, t being a lower or upper triangular view
+
+		static void trsv(index_t n, const T *a, index_t rs, index_t cs, bool lower, bool unit, T *x)
+		{
+			if (lower)
+			{
+				for (index_t i = 0; i < n; ++i)
+				{
+					pack_t s(x + i * W);
+					for (index_t p = 0; p < i; ++p)
+						s -= pack_t(a + (i * rs + p * cs) * W) * pack_t(x + p * W);
+
+					if (!unit) s /= pack_t(a + i * (rs + cs) * W);
+					s.store_u(x + i * W);
+				}
+			}
+			else
+			{
+				for (index_t i = n - 1; i >= 0; --i)
+				{
+					pack_t s(x + i * W);
+					for (index_t p = i + 1; p < n; ++p)
+						s -= pack_t(a + (i * rs + p * cs) * W) * pack_t(x + p * W);
+
+					if (!unit) s /= pack_t(a + i * (rs + cs) * W);
+					s.store_u(x + i * W);
+				}
+			}
+		}
+
+		static void trsm(index_t n, index_t nrhs, const T *a, index_t rs, index_t cs,
+				bool lower, bool unit, T *b)
+		{
+			for (index_t j = 0; j < nrhs; ++j)
+				trsv(n, a, rs, cs, lower, unit, b + j * n * W);
+		}
+
+		// a <- l, with l * l' = a, l being a lower triangular view
+
+		static void potrf(index_t n, T *a, index_t rs, index_t cs, blas_int *info)
+		{
+			T dv[W];
+
+			for (index_t j = 0; j < n; ++j)
+			{
+				T *ajj = a + j * (rs + cs) * W;
+
+				pack_t d(ajj);
+				for (index_t p = 0; p < j; ++p)
+				{
+					pack_t u(a + (j * rs + p * cs) * W);
+					d -= u * u;
+				}
+
+				d.store_u(dv);
+				for (index_t l = 0; l < W; ++l)
+				{
+					if (!(dv[l] > T(0)) && info[l] == 0) info[l] = (blas_int)(j + 1);
+				}
+
+				d = math::sqrt(d);
+				d.store_u(ajj);
+				const pack_t r = pack_t(T(1)) / d;
+
+				for (index_t i = j + 1; i < n; ++i)
+				{
+					T *aij = a + (i * rs + j * cs) * W;
+
+					pack_t s(aij);
+					for (index_t p = 0; p < j; ++p)
+						s -= pack_t(a + (i * rs + p * cs) * W) * pack_t(a + (j * rs + p * cs) * W);
+
+					(s * r).store_u(aij);
+				}
+			}
+		}
+
+		// b <- inv(l * l') * b
+
+		static void potrs(index_t n, index_t nrhs, const T *a, index_t rs, index_t cs, T *b)
+		{
+			trsm(n, nrhs, a, rs, cs, true, false, b);
+			trsm(n, nrhs, a, cs, rs, false, false, b);
+		}
+
+		// p * a = l * u with partial pivoting, the pivots of the l-th matrix
+		// are at piv[l * n], one-based as in LAPACK
+
+		static void getrf(index_t n, T *a, blas_int *piv, blas_int *info)
+		{
+			T bv[W];
+			T iv[W];
+
+			for (index_t k = 0; k < n; ++k)
+			{
+				T *ak = a + k * n * W;
+
+				// pivot search, the row indices are carried as values of T
+
+				pack_t best = math::abs(pack_t(ak + k * W));
+				pack_t ip((T)k);
+
+				for (index_t i = k + 1; i < n; ++i)
+				{
+					pack_t v = math::abs(pack_t(ak + i * W));
+					bpack_t g = v > best;
+					best = math::cond(g, v, best);
+					ip = math::cond(g, pack_t(T(i)), ip);
+				}
+
+				best.store_u(bv);
+				ip.store_u(iv);
+
+				for (index_t l = 0; l < W; ++l)
+				{
+					index_t p = (index_t)iv[l];
+					piv[l * n + k] = (blas_int)(p + 1);
+					if (p != k) swap_rows(n, n, a, k, p, l);
+
+					if (bv[l] == T(0) && info[l] == 0) info[l] = (blas_int)(k + 1);
+				}
+
+				// elimination
+
+				const pack_t r = pack_t(T(1)) / pack_t(ak + k * W);
+				for (index_t i = k + 1; i < n; ++i)
+					(pack_t(ak + i * W) * r).store_u(ak + i * W);
+
+				for (index_t j = k + 1; j < n; ++j)
+				{
+					T *aj = a + j * n * W;
+					const pack_t u(aj + k * W);
+
+					for (index_t i = k + 1; i < n; ++i)
+						(pack_t(aj + i * W) - pack_t(ak + i * W) * u).store_u(aj + i * W);
+				}
+			}
+		}
+
+		// b <- inv(op(p' * l * u)) * b
+
+		static void getrs(index_t n, index_t nrhs, const T *a, const blas_int *piv, bool trans, T *b)
+		{
+			if (!trans)
+			{
+				for (index_t k = 0; k < n; ++k)
+				{
+					for (index_t l = 0; l < W; ++l)
+					{
+						index_t p = piv[l * n + k] - 1;
+						if (p != k) swap_rows(n, nrhs, b, k, p, l);
+					}
+				}
+
+				trsm(n, nrhs, a, 1, n, true, true, b);
+				trsm(n, nrhs, a, 1, n, false, false, b);
+			}
+			else
+			{
+				trsm(n, nrhs, a, n, 1, true, false, b);
+				trsm(n, nrhs, a, n, 1, false, true, b);
+
+				for (index_t k = n - 1; k >= 0; --k)
+				{
+					for (index_t l = 0; l < W; ++l)
+					{
+						index_t p = piv[l * n + k] - 1;
+						if (p != k) swap_rows(n, nrhs, b, k, p, l);
+					}
+				}
+			}
+		}
+
+
+		/********************************************
+		 *
+		 *  drivers
+		 *
+		 ********************************************/
+
+		// input lanes beyond the batch repeat the first system, so that
+		// they carry a well-posed problem, their results go to a pad
+
+		template<class S>
+		static void set_in_lanes(lanes& ls, index_t cnt, const S& src, index_t ld)
+		{
+			for (index_t l = 0; l < W; ++l)
+			{
+				ls.ptrs[l] = const_cast<T*>(src[l < cnt ? l : 0]);
+				ls.lds[l] = ld;
+			}
+		}
+
+		// output lanes beyond the batch write to a pad of ld * n elements,
+		// keeping the leading dimension of the others
+
+		template<class S>
+		static void set_out_lanes(lanes& ls, index_t cnt, const S& dst, index_t ld, T *pad)
+		{
+			for (index_t l = 0; l < W; ++l)
+			{
+				ls.ptrs[l] = l < cnt ? dst[l] : pad;
+				ls.lds[l] = ld;
+			}
+		}
+
+		LMAT_ENSURE_INLINE
+		static index_t group_size(index_t nb, index_t l0)
+		{
+			return nb - l0 < W ? nb - l0 : W;
+		}
+
+		LMAT_ENSURE_INLINE
+		static void put_info(index_t cnt, const blas_int *src, blas_int *info)
+		{
+			for (index_t l = 0; l < cnt; ++l) info[l] = src[l];
+		}
+
+		template<class SA>
+		static void potrf(index_t nb, index_t n, bool lower, const SA& a, index_t lda, blas_int *info)
+		{
+			const index_t rs = lower ? 1 : n;
+			const index_t cs = lower ? n : 1;
+
+			batched_for((nb + W - 1) / W, nb * n * n * n, [&](index_t g0, index_t g1)
+			{
+				dblock<T> abuf(n * n * W);
+				dblock<T> pad(lda * n);
+				lanes ls;
+				blas_int inf[W];
+
+				for (index_t g = g0; g < g1; ++g)
+				{
+					const index_t l0 = g * W;
+					const index_t cnt = group_size(nb, l0);
+
+					set_in_lanes(ls, cnt, a.offset(l0), lda);
+					interleaver_t::interleave(ls, n, n, abuf.ptr_data());
+
+					for (index_t l = 0; l < W; ++l) inf[l] = 0;
+					potrf(n, abuf.ptr_data(), rs, cs, inf);
+
+					set_out_lanes(ls, cnt, a.offset(l0), lda, pad.ptr_data());
+					interleaver_t::deinterleave(abuf.ptr_data(), n, n, T(1), T(0), ls);
+					put_info(cnt, inf, info + l0);
+				}
+			});
+		}
+
+		template<class SA, class SB>
+		static void potrs(index_t nb, index_t n, index_t nrhs, bool lower,
+				const SA& a, index_t lda, const SB& b, index_t ldb)
+		{
+			const index_t rs = lower ? 1 : n;
+			const index_t cs = lower ? n : 1;
+
+			batched_for((nb + W - 1) / W, nb * n * n * nrhs, [&](index_t g0, index_t g1)
+			{
+				dblock<T> abuf(n * n * W);
+				dblock<T> bbuf(n * nrhs * W);
+				dblock<T> pad(ldb * nrhs);
+				lanes ls;
+
+				for (index_t g = g0; g < g1; ++g)
+				{
+					const index_t l0 = g * W;
+					const index_t cnt = group_size(nb, l0);
+
+					set_in_lanes(ls, cnt, a.offset(l0), lda);
+					interleaver_t::interleave(ls, n, n, abuf.ptr_data());
+					set_in_lanes(ls, cnt, b.offset(l0), ldb);
+					interleaver_t::interleave(ls, n, nrhs, bbuf.ptr_data());
+
+					potrs(n, nrhs, abuf.ptr_data(), rs, cs, bbuf.ptr_data());
+
+					set_out_lanes(ls, cnt, b.offset(l0), ldb, pad.ptr_data());
+					interleaver_t::deinterleave(bbuf.ptr_data(), n, nrhs, T(1), T(0), ls);
+				}
+			});
+		}
+
+		template<class SA, class SB>
+		static void posv(index_t nb, index_t n, index_t nrhs, bool lower,
+				const SA& a, index_t lda, const SB& b, index_t ldb, blas_int *info)
+		{
+			const index_t rs = lower ? 1 : n;
+			const index_t cs = lower ? n : 1;
+
+			batched_for((nb + W - 1) / W, nb * n * n * (n + nrhs), [&](index_t g0, index_t g1)
+			{
+				dblock<T> abuf(n * n * W);
+				dblock<T> bbuf(n * nrhs * W);
+				dblock<T> pad(lda * n > ldb * nrhs ? lda * n : ldb * nrhs);
+				lanes ls;
+				blas_int inf[W];
+
+				for (index_t g = g0; g < g1; ++g)
+				{
+					const index_t l0 = g * W;
+					const index_t cnt = group_size(nb, l0);
+
+					set_in_lanes(ls, cnt, a.offset(l0), lda);
+					interleaver_t::interleave(ls, n, n, abuf.ptr_data());
+					set_in_lanes(ls, cnt, b.offset(l0), ldb);
+					interleaver_t::interleave(ls, n, nrhs, bbuf.ptr_data());
+
+					for (index_t l = 0; l < W; ++l) inf[l] = 0;
+					potrf(n, abuf.ptr_data(), rs, cs, inf);
+					potrs(n, nrhs, abuf.ptr_data(), rs, cs, bbuf.ptr_data());
+
+					set_out_lanes(ls, cnt, a.offset(l0), lda, pad.ptr_data());
+					interleaver_t::deinterleave(abuf.ptr_data(), n, n, T(1), T(0), ls);
+					set_out_lanes(ls, cnt, b.offset(l0), ldb, pad.ptr_data());
+					interleaver_t::deinterleave(bbuf.ptr_data(), n, nrhs, T(1), T(0), ls);
+					put_info(cnt, inf, info + l0);
+				}
+			});
+		}
+
+		// the pivots of the l-th system are at ipiv + l * n
+
+		template<class SA>
+		static void getrf(index_t nb, index_t n, const SA& a, index_t lda, blas_int *ipiv, blas_int *info)
+		{
+			batched_for((nb + W - 1) / W, nb * n * n * n, [&](index_t g0, index_t g1)
+			{
+				dblock<T> abuf(n * n * W);
+				dblock<blas_int> piv(n * W);
+				dblock<T> pad(lda * n);
+				lanes ls;
+				blas_int inf[W];
+
+				for (index_t g = g0; g < g1; ++g)
+				{
+					const index_t l0 = g * W;
+					const index_t cnt = group_size(nb, l0);
+
+					set_in_lanes(ls, cnt, a.offset(l0), lda);
+					interleaver_t::interleave(ls, n, n, abuf.ptr_data());
+
+					for (index_t l = 0; l < W; ++l) inf[l] = 0;
+					getrf(n, abuf.ptr_data(), piv.ptr_data(), inf);
+
+					set_out_lanes(ls, cnt, a.offset(l0), lda, pad.ptr_data());
+					interleaver_t::deinterleave(abuf.ptr_data(), n, n, T(1), T(0), ls);
+					copy_vec(n * cnt, piv.ptr_data(), ipiv + l0 * n);
+					put_info(cnt, inf, info + l0);
+				}
+			});
+		}
+
+		template<class SA, class SB>
+		static void getrs(index_t nb, index_t n, index_t nrhs, bool trans,
+				const SA& a, index_t lda, const blas_int *ipiv, const SB& b, index_t ldb)
+		{
+			batched_for((nb + W - 1) / W, nb * n * n * nrhs, [&](index_t g0, index_t g1)
+			{
+				dblock<T> abuf(n * n * W);
+				dblock<T> bbuf(n * nrhs * W);
+				dblock<blas_int> piv(n * W);
+				dblock<T> pad(ldb * nrhs);
+				lanes ls;
+
+				for (index_t g = g0; g < g1; ++g)
+				{
+					const index_t l0 = g * W;
+					const index_t cnt = group_size(nb, l0);
+
+					set_in_lanes(ls, cnt, a.offset(l0), lda);
+					interleaver_t::interleave(ls, n, n, abuf.ptr_data());
+					set_in_lanes(ls, cnt, b.offset(l0), ldb);
+					interleaver_t::interleave(ls, n, nrhs, bbuf.ptr_data());
+
+					for (index_t l = 0; l < W; ++l)
+						copy_vec(n, ipiv + (l0 + (l < cnt ? l : 0)) * n, piv.ptr_data() + l * n);
+
+					getrs(n, nrhs, abuf.ptr_data(), piv.ptr_data(), trans, bbuf.ptr_data());
+
+					set_out_lanes(ls, cnt, b.offset(l0), ldb, pad.ptr_data());
+					interleaver_t::deinterleave(bbuf.ptr_data(), n, nrhs, T(1), T(0), ls);
+				}
+			});
+		}
+
+		template<class SA, class SB>
+		static void gesv(index_t nb, index_t n, index_t nrhs,
+				const SA& a, index_t lda, const SB& b, index_t ldb, blas_int *info)
+		{
+			batched_for((nb + W - 1) / W, nb * n * n * (n + nrhs), [&](index_t g0, index_t g1)
+			{
+				dblock<T> abuf(n * n * W);
+				dblock<T> bbuf(n * nrhs * W);
+				dblock<blas_int> piv(n * W);
+				dblock<T> pad(lda * n > ldb * nrhs ? lda * n : ldb * nrhs);
+				lanes ls;
+				blas_int inf[W];
+
+				for (index_t g = g0; g < g1; ++g)
+				{
+					const index_t l0 = g * W;
+					const index_t cnt = group_size(nb, l0);
+
+					set_in_lanes(ls, cnt, a.offset(l0), lda);
+					interleaver_t::interleave(ls, n, n, abuf.ptr_data());
+					set_in_lanes(ls, cnt, b.offset(l0), ldb);
+					interleaver_t::interleave(ls, n, nrhs, bbuf.ptr_data());
+
+					for (index_t l = 0; l < W; ++l) inf[l] = 0;
+					getrf(n, abuf.ptr_data(), piv.ptr_data(), inf);
+					getrs(n, nrhs, abuf.ptr_data(), piv.ptr_data(), false, bbuf.ptr_data());
+
+					set_out_lanes(ls, cnt, a.offset(l0), lda, pad.ptr_data());
+					interleaver_t::deinterleave(abuf.ptr_data(), n, n, T(1), T(0), ls);
+					set_out_lanes(ls, cnt, b.offset(l0), ldb, pad.ptr_data());
+					interleaver_t::deinterleave(bbuf.ptr_data(), n, nrhs, T(1), T(0), ls);
+					put_info(cnt, inf, info + l0);
+				}
+			});
+		}
+
+		// x_l <- inv(op(a_l)) * x_l, a vector with increment incx is
+		// interleaved as a 1 x n matrix with a leading dimension of incx
+
+		template<class SA, class SX>
+		static void trsv(index_t nb, index_t n, bool lower, bool trans, bool unit,
+				const SA& a, index_t lda, const SX& x, index_t incx)
+		{
+			// the view of op(a)
+			const index_t rs = trans ? n : 1;
+			const index_t cs = trans ? 1 : n;
+
+			batched_for((nb + W - 1) / W, nb * n * n, [&](index_t g0, index_t g1)
+			{
+				dblock<T> abuf(n * n * W);
+				dblock<T> xbuf(n * W);
+				dblock<T> pad(incx * n);
+				lanes ls;
+
+				for (index_t g = g0; g < g1; ++g)
+				{
+					const index_t l0 = g * W;
+					const index_t cnt = group_size(nb, l0);
+
+					set_in_lanes(ls, cnt, a.offset(l0), lda);
+					interleaver_t::interleave(ls, n, n, abuf.ptr_data());
+					set_in_lanes(ls, cnt, x.offset(l0), incx);
+					interleaver_t::interleave(ls, 1, n, xbuf.ptr_data());
+
+					trsv(n, abuf.ptr_data(), rs, cs, lower != trans, unit, xbuf.ptr_data());
+
+					set_out_lanes(ls, cnt, x.offset(l0), incx, pad.ptr_data());
+					interleaver_t::deinterleave(xbuf.ptr_data(), 1, n, T(1), T(0), ls);
+				}
+			});
+		}
+	};
+
+} LMAT_END_NAMESPACE
+
+#endif
@@ -15,7 +15,7 @@
 
 #include <light_mat/linalg/linalg_fwd.h>
 
-namespace lmat { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace internal {
 
 	template<typename T, class Mat>
 	LMAT_ENSURE_INLINE
@@ -78,6 +78,6 @@ namespace lmat { namespace internal {
 		}
 	}
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif 
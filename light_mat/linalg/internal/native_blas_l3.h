@@ -0,0 +1,745 @@
+/**
+ * @file native_blas_l3.h
+ *
+ * @brief Header-only implementation of BLAS Level 3 routines
+ *
+ * This is the backend of blas_l3.h when LMAT_USE_NATIVE_BLAS is
+ * defined. The entry points mirror the Fortran interface, so the
+ * wrappers call either backend in exactly the same way.
+ *
+ * All routines are built upon a cache-blocked GEMM: op(A) and op(B)
+ * are packed into panels of MR rows and NR columns, which are fed to
+ * a register micro-kernel that keeps an MR x NR tile of C in SIMD
+ * registers (see gemm_blocking for the block sizes).
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_NATIVE_BLAS_L3_H_
+#define LIGHTMAT_NATIVE_BLAS_L3_H_
+
+#include <light_mat/linalg/linalg_fwd.h>
+#include <light_mat/common/block.h>
+#include <light_mat/simd/simd.h>
+#include <algorithm>
+
+LMAT_BEGIN_NAMESPACE namespace blas { namespace native {
+
+	namespace internal
+	{
+
+		/********************************************
+		 *
+		 *  blocking parameters
+		 *
+		 ********************************************/
+
+		// number of columns of a register tile, chosen such that
+		// the 2 x NR accumulators, 2 packs of A and a broadcast
+		// of B fit in the register file
+
+		template<typename Kind> struct gemm_kernel_cols;
+
+		template<> struct gemm_kernel_cols<sse_t> { static const index_t value = 4; };
+		template<> struct gemm_kernel_cols<avx_t> { static const index_t value = 6; };
+		template<> struct gemm_kernel_cols<avx512_t> { static const index_t value = 8; };
+
+		template<typename T>
+		struct gemm_blocking
+		{
+			typedef simd_pack<T, default_simd_kind> pack_t;
+
+			static const index_t W = (index_t)pack_t::pack_width;
+			static const index_t MR = 2 * W;    // rows of a register tile
+			static const index_t NR = gemm_kernel_cols<default_simd_kind>::value;
+
+			static const index_t KC = 256;   // depth of a packed panel (B panel stays in L1)
+			static const index_t MC = 128;   // rows of a packed block of A (stays in L2)
+			static const index_t NC = 3072;  // columns of a packed block of B
+		};
+
+		// size of diagonal blocks in triangular routines
+		const index_t tri_block = 64;
+
+
+		/********************************************
+		 *
+		 *  operand accessors
+		 *
+		 ********************************************/
+
+		template<typename T>
+		struct strided_src
+		{
+			const T *p;
+			index_t rs;
+			index_t cs;
+
+			LMAT_ENSURE_INLINE
+			strided_src(const T *p_, index_t rs_, index_t cs_)
+			: p(p_), rs(rs_), cs(cs_) { }
+
+			LMAT_ENSURE_INLINE
+			T operator() (index_t i, index_t j) const
+			{
+				return p[i * rs + j * cs];
+			}
+
+			LMAT_ENSURE_INLINE
+			strided_src sub(index_t i, index_t j) const
+			{
+				return strided_src(p + i * rs + j * cs, rs, cs);
+			}
+		};
+
+		// op(A) for a column-major A with leading dimension ld
+		template<typename T>
+		LMAT_ENSURE_INLINE
+		inline strided_src<T> op_src(const T *a, index_t ld, bool trans)
+		{
+			return trans ? strided_src<T>(a, ld, 1) : strided_src<T>(a, 1, ld);
+		}
+
+		// a symmetric matrix of which only one triangle is referenced
+		template<typename T>
+		struct symmetric_src
+		{
+			const T *p;
+			index_t ld;
+			bool lower;
+
+			LMAT_ENSURE_INLINE
+			symmetric_src(const T *p_, index_t ld_, bool lower_)
+			: p(p_), ld(ld_), lower(lower_) { }
+
+			LMAT_ENSURE_INLINE
+			T operator() (index_t i, index_t j) const
+			{
+				return (lower ? i >= j : i <= j) ? p[i + j * ld] : p[j + i * ld];
+			}
+		};
+
+
+		/********************************************
+		 *
+		 *  packing
+		 *
+		 ********************************************/
+
+		// packs a(i0:i0+mc, p0:p0+kc) into panels of MR rows,
+		// each panel stored as kc consecutive columns of length MR
+
+		template<typename T, class SA>
+		inline void gemm_pack_a(const SA& a, index_t i0, index_t p0, index_t mc, index_t kc, T *buf)
+		{
+			const index_t MR = gemm_blocking<T>::MR;
+
+			for (index_t ir = 0; ir < mc; ir += MR)
+			{
+				index_t mr = (std::min)(MR, mc - ir);
+				index_t i1 = i0 + ir;
+
+				for (index_t p = 0; p < kc; ++p)
+				{
+					index_t i = 0;
+					for (; i < mr; ++i) *buf++ = a(i1 + i, p0 + p);
+					for (; i < MR; ++i) *buf++ = T(0);
+				}
+			}
+		}
+
+		// packs b(p0:p0+kc, j0:j0+nc) into panels of NR columns,
+		// each panel stored as kc consecutive rows of length NR
+
+		template<typename T, class SB>
+		inline void gemm_pack_b(const SB& b, index_t p0, index_t j0, index_t kc, index_t nc, T *buf)
+		{
+			const index_t NR = gemm_blocking<T>::NR;
+
+			for (index_t jr = 0; jr < nc; jr += NR)
+			{
+				index_t nr = (std::min)(NR, nc - jr);
+				index_t j1 = j0 + jr;
+
+				for (index_t p = 0; p < kc; ++p)
+				{
+					index_t j = 0;
+					for (; j < nr; ++j) *buf++ = b(p0 + p, j1 + j);
+					for (; j < NR; ++j) *buf++ = T(0);
+				}
+			}
+		}
+
+
+		/********************************************
+		 *
+		 *  kernels
+		 *
+		 ********************************************/
+
+		// c(0:MR, 0:NR) += alpha * pa * pb, with pa and pb packed panels
+
+		template<typename T>
+		inline void gemm_micro_kernel(index_t kc, T alpha, const T *pa, const T *pb, T *c, index_t ldc)
+		{
+			typedef gemm_blocking<T> blk;
+			typedef typename blk::pack_t pack_t;
+
+			const index_t W = blk::W;
+			const index_t MR = blk::MR;
+			const index_t NR = blk::NR;
+
+			pack_t c0[NR];
+			pack_t c1[NR];
+
+			for (index_t j = 0; j < NR; ++j)
+			{
+				c0[j].reset();
+				c1[j].reset();
+			}
+
+			for (index_t p = 0; p < kc; ++p, pa += MR, pb += NR)
+			{
+				pack_t a0(pa);
+				pack_t a1(pa + W);
+
+				for (index_t j = 0; j < NR; ++j)
+				{
+					pack_t b(pb[j]);
+					c0[j] = math::fma(a0, b, c0[j]);
+					c1[j] = math::fma(a1, b, c1[j]);
+				}
+			}
+
+			pack_t av(alpha);
+			for (index_t j = 0; j < NR; ++j, c += ldc)
+			{
+				math::fma(av, c0[j], pack_t(c)).store_u(c);
+				math::fma(av, c1[j], pack_t(c + W)).store_u(c + W);
+			}
+		}
+
+		// c(0:mc, 0:nc) += alpha * pa * pb over whole packed blocks
+
+		template<typename T>
+		inline void gemm_macro_kernel(index_t mc, index_t nc, index_t kc, T alpha,
+				const T *pa, const T *pb, T *c, index_t ldc)
+		{
+			typedef gemm_blocking<T> blk;
+
+			const index_t MR = blk::MR;
+			const index_t NR = blk::NR;
+
+			T tile[MR * NR];
+
+			for (index_t jr = 0; jr < nc; jr += NR)
+			{
+				index_t nr = (std::min)(NR, nc - jr);
+				const T *pb_j = pb + jr * kc;
+
+				for (index_t ir = 0; ir < mc; ir += MR)
+				{
+					index_t mr = (std::min)(MR, mc - ir);
+					const T *pa_i = pa + ir * kc;
+					T *cij = c + ir + jr * ldc;
+
+					if (mr == MR && nr == NR)
+					{
+						gemm_micro_kernel(kc, alpha, pa_i, pb_j, cij, ldc);
+					}
+					else
+					{
+						for (index_t i = 0; i < MR * NR; ++i) tile[i] = T(0);
+						gemm_micro_kernel(kc, alpha, pa_i, pb_j, tile, MR);
+
+						for (index_t j = 0; j < nr; ++j)
+						{
+							for (index_t i = 0; i < mr; ++i) cij[i + j * ldc] += tile[i + j * MR];
+						}
+					}
+				}
+			}
+		}
+
+		template<typename T>
+		inline void scale_block(index_t m, index_t n, T beta, T *c, index_t ldc)
+		{
+			if (beta == T(1)) return;
+
+			for (index_t j = 0; j < n; ++j, c += ldc)
+			{
+				if (beta == T(0))
+				{
+					for (index_t i = 0; i < m; ++i) c[i] = T(0);
+				}
+				else
+				{
+					for (index_t i = 0; i < m; ++i) c[i] *= beta;
+				}
+			}
+		}
+
+		// c := alpha * a * b + beta * c, where a is m x k, b is k x n,
+		// and c is column-major with leading dimension ldc
+
+		template<typename T, class SA, class SB>
+		void gemm_run(index_t m, index_t n, index_t k, T alpha, const SA& a, const SB& b,
+				T beta, T *c, index_t ldc)
+		{
+			typedef gemm_blocking<T> blk;
+
+			const index_t MR = blk::MR;
+			const index_t NR = blk::NR;
+
+			scale_block(m, n, beta, c, ldc);
+			if (m == 0 || n == 0 || k == 0 || alpha == T(0)) return;
+
+			index_t kc_max = (std::min)(blk::KC, k);
+			index_t mc_max = (std::min)(blk::MC, (m + MR - 1) / MR * MR);
+			index_t nc_max = (std::min)(blk::NC, (n + NR - 1) / NR * NR);
+
+			dblock<T> abuf(mc_max * kc_max);
+			dblock<T> bbuf(kc_max * nc_max);
+
+			for (index_t jc = 0; jc < n; jc += blk::NC)
+			{
+				index_t nc = (std::min)(blk::NC, n - jc);
+
+				for (index_t pc = 0; pc < k; pc += blk::KC)
+				{
+					index_t kc = (std::min)(blk::KC, k - pc);
+					gemm_pack_b(b, pc, jc, kc, nc, bbuf.ptr_data());
+
+					for (index_t ic = 0; ic < m; ic += blk::MC)
+					{
+						index_t mc = (std::min)(blk::MC, m - ic);
+						gemm_pack_a(a, ic, pc, mc, kc, abuf.ptr_data());
+
+						gemm_macro_kernel(mc, nc, kc, alpha,
+								abuf.ptr_data(), bbuf.ptr_data(), c + ic + jc * ldc, ldc);
+					}
+				}
+			}
+		}
+
+
+		/********************************************
+		 *
+		 *  triangular diagonal blocks
+		 *
+		 ********************************************/
+
+		// the left-side kernels work on a dense copy t (nb x nb) of
+		// the diagonal block, so that the inner loops are unit-stride
+
+		template<typename T>
+		inline void trmm_left_diag(index_t nb, index_t n, const T *t, bool lower, bool unit, T *b, index_t ldb)
+		{
+			for (index_t j = 0; j < n; ++j, b += ldb)
+			{
+				if (lower)
+				{
+					for (index_t p = nb - 1; p >= 0; --p)
+					{
+						const T *tp = t + p * nb;
+						T xp = b[p];
+						if (!unit) b[p] = tp[p] * xp;
+						for (index_t i = p + 1; i < nb; ++i) b[i] += tp[i] * xp;
+					}
+				}
+				else
+				{
+					for (index_t p = 0; p < nb; ++p)
+					{
+						const T *tp = t + p * nb;
+						T xp = b[p];
+						for (index_t i = 0; i < p; ++i) b[i] += tp[i] * xp;
+						if (!unit) b[p] = tp[p] * xp;
+					}
+				}
+			}
+		}
+
+		template<typename T>
+		inline void trsm_left_diag(index_t nb, index_t n, const T *t, bool lower, bool unit, T *b, index_t ldb)
+		{
+			for (index_t j = 0; j < n; ++j, b += ldb)
+			{
+				if (lower)
+				{
+					for (index_t p = 0; p < nb; ++p)
+					{
+						const T *tp = t + p * nb;
+						if (!unit) b[p] /= tp[p];
+						T xp = b[p];
+						for (index_t i = p + 1; i < nb; ++i) b[i] -= tp[i] * xp;
+					}
+				}
+				else
+				{
+					for (index_t p = nb - 1; p >= 0; --p)
+					{
+						const T *tp = t + p * nb;
+						if (!unit) b[p] /= tp[p];
+						T xp = b[p];
+						for (index_t i = 0; i < p; ++i) b[i] -= tp[i] * xp;
+					}
+				}
+			}
+		}
+
+		// the right-side kernels combine whole columns of b
+
+		template<typename T>
+		inline void trs_axpy(index_t m, T a, const T *x, T *y)
+		{
+			for (index_t i = 0; i < m; ++i) y[i] += a * x[i];
+		}
+
+		template<typename T>
+		inline void trmm_right_diag(index_t m, index_t nb, const strided_src<T>& t, bool lower, bool unit, T *b, index_t ldb)
+		{
+			if (lower)
+			{
+				for (index_t j = 0; j < nb; ++j)
+				{
+					T *bj = b + j * ldb;
+					if (!unit) scale_block(m, 1, t(j, j), bj, ldb);
+					for (index_t p = j + 1; p < nb; ++p) trs_axpy(m, t(p, j), b + p * ldb, bj);
+				}
+			}
+			else
+			{
+				for (index_t j = nb - 1; j >= 0; --j)
+				{
+					T *bj = b + j * ldb;
+					if (!unit) scale_block(m, 1, t(j, j), bj, ldb);
+					for (index_t p = 0; p < j; ++p) trs_axpy(m, t(p, j), b + p * ldb, bj);
+				}
+			}
+		}
+
+		template<typename T>
+		inline void trsm_right_diag(index_t m, index_t nb, const strided_src<T>& t, bool lower, bool unit, T *b, index_t ldb)
+		{
+			if (lower)
+			{
+				for (index_t j = nb - 1; j >= 0; --j)
+				{
+					T *bj = b + j * ldb;
+					for (index_t p = j + 1; p < nb; ++p) trs_axpy(m, -t(p, j), b + p * ldb, bj);
+					if (!unit)
+					{
+						T d = t(j, j);
+						for (index_t i = 0; i < m; ++i) bj[i] /= d;
+					}
+				}
+			}
+			else
+			{
+				for (index_t j = 0; j < nb; ++j)
+				{
+					T *bj = b + j * ldb;
+					for (index_t p = 0; p < j; ++p) trs_axpy(m, -t(p, j), b + p * ldb, bj);
+					if (!unit)
+					{
+						T d = t(j, j);
+						for (index_t i = 0; i < m; ++i) bj[i] /= d;
+					}
+				}
+			}
+		}
+
+		template<typename T>
+		inline void copy_block(index_t nb, const strided_src<T>& t, T *dst)
+		{
+			for (index_t j = 0; j < nb; ++j)
+			{
+				for (index_t i = 0; i < nb; ++i) *dst++ = t(i, j);
+			}
+		}
+
+
+		/********************************************
+		 *
+		 *  routines
+		 *
+		 ********************************************/
+
+		LMAT_ENSURE_INLINE inline bool is_trans(char c) { return c != 'N' && c != 'n'; }
+		LMAT_ENSURE_INLINE inline bool is_lower(char c) { return c == 'L' || c == 'l'; }
+		LMAT_ENSURE_INLINE inline bool is_unit(char c) { return c == 'U' || c == 'u'; }
+
+		template<typename T>
+		inline void gemm(char transa, char transb, index_t m, index_t n, index_t k,
+				T alpha, const T *a, index_t lda, const T *b, index_t ldb, T beta, T *c, index_t ldc)
+		{
+			gemm_run(m, n, k, alpha,
+					op_src(a, lda, is_trans(transa)),
+					op_src(b, ldb, is_trans(transb)), beta, c, ldc);
+		}
+
+		template<typename T>
+		inline void symm(char side, char uplo, index_t m, index_t n,
+				T alpha, const T *a, index_t lda, const T *b, index_t ldb, T beta, T *c, index_t ldc)
+		{
+			symmetric_src<T> sa(a, lda, is_lower(uplo));
+			strided_src<T> sb(b, 1, ldb);
+
+			if (is_lower(side))
+				gemm_run(m, n, m, alpha, sa, sb, beta, c, ldc);
+			else
+				gemm_run(m, n, n, alpha, sb, sa, beta, c, ldc);
+		}
+
+		template<typename T>
+		inline void syrk(char uplo, char trans, index_t n, index_t k,
+				T alpha, const T *a, index_t lda, T beta, T *c, index_t ldc)
+		{
+			bool lower = is_lower(uplo);
+			bool tr = is_trans(trans);
+
+			// scale the referenced triangle only
+			for (index_t j = 0; j < n; ++j)
+			{
+				if (lower)
+					scale_block(n - j, 1, beta, c + j + j * ldc, ldc);
+				else
+					scale_block(j + 1, 1, beta, c + j * ldc, ldc);
+			}
+			if (n == 0 || k == 0 || alpha == T(0)) return;
+
+			strided_src<T> sa = op_src(a, lda, tr);    // n x k
+			strided_src<T> st = op_src(a, lda, !tr);   // k x n
+
+			const index_t NB = gemm_blocking<T>::MC;
+			index_t nb_max = (std::min)(NB, n);
+			dblock<T> tmp(nb_max * nb_max);
+
+			for (index_t j0 = 0; j0 < n; j0 += NB)
+			{
+				index_t nb = (std::min)(NB, n - j0);
+				T *cj = c + j0 * ldc;
+
+				// diagonal block goes through a temporary
+
+				T *t = tmp.ptr_data();
+				gemm_run(nb, nb, k, alpha, sa.sub(j0, 0), st.sub(0, j0), T(0), t, nb);
+
+				for (index_t j = 0; j < nb; ++j)
+				{
+					T *cd = cj + j0 + j * ldc;
+					const T *td = t + j * nb;
+					if (lower)
+						for (index_t i = j; i < nb; ++i) cd[i] += td[i];
+					else
+						for (index_t i = 0; i <= j; ++i) cd[i] += td[i];
+				}
+
+				// off-diagonal blocks
+
+				if (lower)
+				{
+					index_t r0 = j0 + nb;
+					if (r0 < n)
+						gemm_run(n - r0, nb, k, alpha, sa.sub(r0, 0), st.sub(0, j0), T(1), cj + r0, ldc);
+				}
+				else
+				{
+					if (j0 > 0)
+						gemm_run(j0, nb, k, alpha, sa, st.sub(0, j0), T(1), cj, ldc);
+				}
+			}
+		}
+
+		// the effective triangle of op(A) is lower when uplo = 'L'
+		// and transa = 'N', or when uplo = 'U' and transa != 'N'
+
+		template<typename T>
+		inline void trmm(char side, char uplo, char transa, char diag, index_t m, index_t n,
+				T alpha, const T *a, index_t lda, T *b, index_t ldb)
+		{
+			scale_block(m, n, alpha, b, ldb);
+			if (m == 0 || n == 0 || alpha == T(0)) return;
+
+			const index_t NB = tri_block;
+			bool lower = is_lower(uplo) != is_trans(transa);
+			bool unit = is_unit(diag);
+			strided_src<T> t = op_src(a, lda, is_trans(transa));
+
+			if (is_lower(side))  // B := op(A) * B
+			{
+				dblock<T> tmp((std::min)(NB, m) * (std::min)(NB, m));
+
+				if (lower)
+				{
+					for (index_t i0 = (m - 1) / NB * NB; i0 >= 0; i0 -= NB)
+					{
+						index_t nb = (std::min)(NB, m - i0);
+						copy_block(nb, t.sub(i0, i0), tmp.ptr_data());
+						trmm_left_diag(nb, n, tmp.ptr_data(), true, unit, b + i0, ldb);
+						if (i0 > 0)
+							gemm_run(nb, n, i0, T(1), t.sub(i0, 0),
+									strided_src<T>(b, 1, ldb), T(1), b + i0, ldb);
+					}
+				}
+				else
+				{
+					for (index_t i0 = 0; i0 < m; i0 += NB)
+					{
+						index_t nb = (std::min)(NB, m - i0);
+						index_t r0 = i0 + nb;
+						copy_block(nb, t.sub(i0, i0), tmp.ptr_data());
+						trmm_left_diag(nb, n, tmp.ptr_data(), false, unit, b + i0, ldb);
+						if (r0 < m)
+							gemm_run(nb, n, m - r0, T(1), t.sub(i0, r0),
+									strided_src<T>(b + r0, 1, ldb), T(1), b + i0, ldb);
+					}
+				}
+			}
+			else  // B := B * op(A)
+			{
+				if (lower)
+				{
+					for (index_t j0 = 0; j0 < n; j0 += NB)
+					{
+						index_t nb = (std::min)(NB, n - j0);
+						index_t r0 = j0 + nb;
+						trmm_right_diag(m, nb, t.sub(j0, j0), true, unit, b + j0 * ldb, ldb);
+						if (r0 < n)
+							gemm_run(m, nb, n - r0, T(1), strided_src<T>(b + r0 * ldb, 1, ldb),
+									t.sub(r0, j0), T(1), b + j0 * ldb, ldb);
+					}
+				}
+				else
+				{
+					for (index_t j0 = (n - 1) / NB * NB; j0 >= 0; j0 -= NB)
+					{
+						index_t nb = (std::min)(NB, n - j0);
+						trmm_right_diag(m, nb, t.sub(j0, j0), false, unit, b + j0 * ldb, ldb);
+						if (j0 > 0)
+							gemm_run(m, nb, j0, T(1), strided_src<T>(b, 1, ldb),
+									t.sub(0, j0), T(1), b + j0 * ldb, ldb);
+					}
+				}
+			}
+		}
+
+		template<typename T>
+		inline void trsm(char side, char uplo, char transa, char diag, index_t m, index_t n,
+				T alpha, const T *a, index_t lda, T *b, index_t ldb)
+		{
+			scale_block(m, n, alpha, b, ldb);
+			if (m == 0 || n == 0 || alpha == T(0)) return;
+
+			const index_t NB = tri_block;
+			bool lower = is_lower(uplo) != is_trans(transa);
+			bool unit = is_unit(diag);
+			strided_src<T> t = op_src(a, lda, is_trans(transa));
+
+			if (is_lower(side))  // solve op(A) * X = B
+			{
+				dblock<T> tmp((std::min)(NB, m) * (std::min)(NB, m));
+
+				if (lower)
+				{
+					for (index_t i0 = 0; i0 < m; i0 += NB)
+					{
+						index_t nb = (std::min)(NB, m - i0);
+						if (i0 > 0)
+							gemm_run(nb, n, i0, T(-1), t.sub(i0, 0),
+									strided_src<T>(b, 1, ldb), T(1), b + i0, ldb);
+						copy_block(nb, t.sub(i0, i0), tmp.ptr_data());
+						trsm_left_diag(nb, n, tmp.ptr_data(), true, unit, b + i0, ldb);
+					}
+				}
+				else
+				{
+					for (index_t i0 = (m - 1) / NB * NB; i0 >= 0; i0 -= NB)
+					{
+						index_t nb = (std::min)(NB, m - i0);
+						index_t r0 = i0 + nb;
+						if (r0 < m)
+							gemm_run(nb, n, m - r0, T(-1), t.sub(i0, r0),
+									strided_src<T>(b + r0, 1, ldb), T(1), b + i0, ldb);
+						copy_block(nb, t.sub(i0, i0), tmp.ptr_data());
+						trsm_left_diag(nb, n, tmp.ptr_data(), false, unit, b + i0, ldb);
+					}
+				}
+			}
+			else  // solve X * op(A) = B
+			{
+				if (lower)
+				{
+					for (index_t j0 = (n - 1) / NB * NB; j0 >= 0; j0 -= NB)
+					{
+						index_t nb = (std::min)(NB, n - j0);
+						index_t r0 = j0 + nb;
+						if (r0 < n)
+							gemm_run(m, nb, n - r0, T(-1), strided_src<T>(b + r0 * ldb, 1, ldb),
+									t.sub(r0, j0), T(1), b + j0 * ldb, ldb);
+						trsm_right_diag(m, nb, t.sub(j0, j0), true, unit, b + j0 * ldb, ldb);
+					}
+				}
+				else
+				{
+					for (index_t j0 = 0; j0 < n; j0 += NB)
+					{
+						index_t nb = (std::min)(NB, n - j0);
+						if (j0 > 0)
+							gemm_run(m, nb, j0, T(-1), strided_src<T>(b, 1, ldb),
+									t.sub(0, j0), T(1), b + j0 * ldb, ldb);
+						trsm_right_diag(m, nb, t.sub(j0, j0), false, unit, b + j0 * ldb, ldb);
+					}
+				}
+			}
+		}
+
+	}
+
+
+	/********************************************
+	 *
+	 *  Fortran-style entries
+	 *
+	 ********************************************/
+
+#define LMAT_DEFINE_NATIVE_L3( S, T ) \
+	inline void S##gemm(const char *transa, const char *transb, const blas_int *m, const blas_int *n, const blas_int *k, \
+			const T *alpha, const T *a, const blas_int *lda, const T *b, const blas_int *ldb, \
+			const T *beta, T *c, const blas_int *ldc) { \
+		internal::gemm(*transa, *transb, (index_t)(*m), (index_t)(*n), (index_t)(*k), \
+				*alpha, a, (index_t)(*lda), b, (index_t)(*ldb), *beta, c, (index_t)(*ldc)); } \
+	inline void S##symm(const char *side, const char *uplo, const blas_int *m, const blas_int *n, \
+			const T *alpha, const T *a, const blas_int *lda, const T *b, const blas_int *ldb, \
+			const T *beta, T *c, const blas_int *ldc) { \
+		internal::symm(*side, *uplo, (index_t)(*m), (index_t)(*n), \
+				*alpha, a, (index_t)(*lda), b, (index_t)(*ldb), *beta, c, (index_t)(*ldc)); } \
+	inline void S##syrk(const char *uplo, const char *trans, const blas_int *n, const blas_int *k, \
+			const T *alpha, const T *a, const blas_int *lda, const T *beta, \
+			T *c, const blas_int *ldc) { \
+		internal::syrk(*uplo, *trans, (index_t)(*n), (index_t)(*k), \
+				*alpha, a, (index_t)(*lda), *beta, c, (index_t)(*ldc)); } \
+	inline void S##trmm(const char *side, const char *uplo, const char *transa, const char *diag, \
+			const blas_int *m, const blas_int *n, const T *alpha, const T *a, const blas_int *lda, \
+			T *b, const blas_int *ldb) { \
+		internal::trmm(*side, *uplo, *transa, *diag, (index_t)(*m), (index_t)(*n), \
+				*alpha, a, (index_t)(*lda), b, (index_t)(*ldb)); } \
+	inline void S##trsm(const char *side, const char *uplo, const char *transa, const char *diag, \
+			const blas_int *m, const blas_int *n, const T *alpha, const T *a, const blas_int *lda, \
+			T *b, const blas_int *ldb) { \
+		internal::trsm(*side, *uplo, *transa, *diag, (index_t)(*m), (index_t)(*n), \
+				*alpha, a, (index_t)(*lda), b, (index_t)(*ldb)); }
+
+	LMAT_DEFINE_NATIVE_L3( s, float )
+	LMAT_DEFINE_NATIVE_L3( d, double )
+
+#undef LMAT_DEFINE_NATIVE_L3
+
+} } LMAT_END_NAMESPACE
+
+#endif
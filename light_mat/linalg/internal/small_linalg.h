@@ -0,0 +1,581 @@
+/**
+ * @file small_linalg.h
+ *
+ * @brief Kernels for matrices of small compile-time size
+ *
+ * When all dimensions are fixed at compile time and do not exceed
+ * small_linalg_max_dim, gemm, gemv, LU and Cholesky are done by the
+ * kernels here instead of calling BLAS/LAPACK. All loops have
+ * compile-time trip counts, so the compiler fully unrolls them.
+ * Columns whose length is a multiple of a SIMD pack width stay in
+ * SIMD registers.
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_SMALL_LINALG_H_
+#define LIGHTMAT_SMALL_LINALG_H_
+
+#include <light_mat/linalg/linalg_fwd.h>
+#include <light_mat/math/math_base.h>
+#include <light_mat/simd/simd.h>
+#include <type_traits>
+
+LMAT_BEGIN_NAMESPACE namespace internal {
+
+	/********************************************
+	 *
+	 *  compile-time selection
+	 *
+	 ********************************************/
+
+	const int small_linalg_max_dim = 8;
+
+	template<int N>
+	struct is_small_dim : public meta::bool_<(N > 0 && N <= small_linalg_max_dim)> { };
+
+	template<class Mat>
+	struct is_small_mat : public meta::bool_<
+		is_small_dim<meta::nrows<Mat>::value>::value &&
+		is_small_dim<meta::ncols<Mat>::value>::value> { };
+
+	template<class A, class B, class C>
+	struct is_small_gemm : public meta::bool_<
+		is_small_mat<A>::value && is_small_mat<B>::value && is_small_mat<C>::value> { };
+
+	// the dimension of a small square matrix, or 0 otherwise
+	template<class Mat>
+	struct small_sq_dim : public meta::int_<
+		(is_small_mat<Mat>::value && meta::nrows<Mat>::value == meta::ncols<Mat>::value) ?
+		meta::nrows<Mat>::value : 0> { };
+
+	// the number of rows of a matrix with small compile-time rows, or 0 otherwise
+	template<class Mat>
+	struct small_nrows : public meta::int_<
+		is_small_dim<meta::nrows<Mat>::value>::value ? meta::nrows<Mat>::value : 0> { };
+
+	// the widest SIMD kind whose pack width divides M (void if none)
+	template<typename T, int M>
+	struct small_col_kind
+	{
+		static const int w_sse = 16 / (int)sizeof(T);
+		static const int w_avx = 32 / (int)sizeof(T);
+		static const int w_avx512 = 64 / (int)sizeof(T);
+
+		typedef typename meta::select_<
+#ifdef LMAT_HAS_AVX512
+			meta::bool_<M % w_avx512 == 0>, avx512_t,
+#endif
+#ifdef LMAT_HAS_AVX
+			meta::bool_<M % w_avx == 0>, avx_t,
+#endif
+			meta::bool_<M % w_sse == 0>, sse_t,
+			meta::otherwise_, void>::type type;
+	};
+
+	template<bool Tr, typename T>
+	LMAT_ENSURE_INLINE
+	inline T small_at(const T *a, index_t ld, int i, int j)
+	{
+		return Tr ? a[j + i * ld] : a[i + j * ld];
+	}
+
+
+	/********************************************
+	 *
+	 *  GEMM: c = alpha * op(a) * op(b) + beta * c
+	 *
+	 *  op(a) is M x K, op(b) is K x N
+	 *
+	 ********************************************/
+
+	template<typename T, int M, int N, int K, bool TA, typename Kind>
+	struct small_gemm_impl
+	{
+		template<bool TB>
+		LMAT_ENSURE_INLINE
+		static void run(T alpha, const T *a, index_t lda, const T *b, index_t ldb,
+				T beta, T *c, index_t ldc)
+		{
+			for (int j = 0; j < N; ++j)
+			{
+				for (int i = 0; i < M; ++i)
+				{
+					T s(0);
+					for (int p = 0; p < K; ++p)
+						s += small_at<TA>(a, lda, i, p) * small_at<TB>(b, ldb, p, j);
+
+					T& r = c[i + j * ldc];
+					r = beta == T(0) ? alpha * s : alpha * s + beta * r;
+				}
+			}
+		}
+	};
+
+	// op(a) = a with columns made of whole packs: each column
+	// of c is a linear combination of the packed columns of a
+
+	template<typename T, int M, int N, int K, typename Kind>
+	struct small_gemm_impl<T, M, N, K, false, Kind>
+	{
+		template<bool TB>
+		LMAT_ENSURE_INLINE
+		static void run(T alpha, const T *a, index_t lda, const T *b, index_t ldb,
+				T beta, T *c, index_t ldc)
+		{
+			typedef simd_pack<T, Kind> pack_t;
+			const int W = (int)pack_t::pack_width;
+			const int P = M / W;
+
+			pack_t ca[K][P];
+			for (int p = 0; p < K; ++p)
+				for (int q = 0; q < P; ++q) ca[p][q].load_u(a + p * lda + q * W);
+
+			pack_t av(alpha);
+			pack_t bv(beta);
+
+			for (int j = 0; j < N; ++j)
+			{
+				pack_t s[P];
+				for (int q = 0; q < P; ++q) s[q].reset();
+
+				for (int p = 0; p < K; ++p)
+				{
+					pack_t u(small_at<TB>(b, ldb, p, j));
+					for (int q = 0; q < P; ++q) s[q] = math::fma(ca[p][q], u, s[q]);
+				}
+
+				T *cj = c + j * ldc;
+				for (int q = 0; q < P; ++q)
+				{
+					if (beta == T(0))
+						(av * s[q]).store_u(cj + q * W);
+					else
+						math::fma(av, s[q], bv * pack_t(cj + q * W)).store_u(cj + q * W);
+				}
+			}
+		}
+	};
+
+	template<typename T, int M, int N, int K>
+	struct small_gemm_impl<T, M, N, K, false, void>
+	{
+		template<bool TB>
+		LMAT_ENSURE_INLINE
+		static void run(T alpha, const T *a, index_t lda, const T *b, index_t ldb,
+				T beta, T *c, index_t ldc)
+		{
+			for (int j = 0; j < N; ++j)
+			{
+				for (int i = 0; i < M; ++i)
+				{
+					T s(0);
+					for (int p = 0; p < K; ++p)
+						s += a[i + p * lda] * small_at<TB>(b, ldb, p, j);
+
+					T& r = c[i + j * ldc];
+					r = beta == T(0) ? alpha * s : alpha * s + beta * r;
+				}
+			}
+		}
+	};
+
+	template<typename T, int M, int N, int K, bool TA, bool TB>
+	LMAT_ENSURE_INLINE
+	inline void small_gemm(T alpha, const T *a, index_t lda, const T *b, index_t ldb,
+			T beta, T *c, index_t ldc)
+	{
+		typedef typename small_col_kind<T, M>::type kind;
+		small_gemm_impl<T, M, N, K, TA, kind>::template run<TB>(alpha, a, lda, b, ldb, beta, c, ldc);
+	}
+
+	// the transposition flags are only known at run-time, the branches
+	// whose shapes are inconsistent at compile-time are never taken
+	// (the dimensions have been checked), and are not instantiated
+
+	template<typename T, int M, int N, int K, bool TA, bool TB>
+	LMAT_ENSURE_INLINE
+	inline void small_gemm_(T alpha, const T *a, index_t lda, const T *b, index_t ldb,
+			T beta, T *c, index_t ldc, meta::true_)
+	{
+		small_gemm<T, M, N, K, TA, TB>(alpha, a, lda, b, ldb, beta, c, ldc);
+	}
+
+	template<typename T, int M, int N, int K, bool TA, bool TB>
+	LMAT_ENSURE_INLINE
+	inline void small_gemm_(T, const T *, index_t, const T *, index_t,
+			T, T *, index_t, meta::false_)
+	{ }
+
+	template<typename T, class A, class B, class C>
+	inline void small_gemm(T alpha, const A& a, const B& b, T beta, C& c, bool ta, bool tb)
+	{
+		const int M = meta::nrows<C>::value;
+		const int N = meta::ncols<C>::value;
+		const int AM = meta::nrows<A>::value;
+		const int AN = meta::ncols<A>::value;
+		const int BM = meta::nrows<B>::value;
+		const int BN = meta::ncols<B>::value;
+
+		typedef meta::bool_<AM == M && BM == AN && BN == N> nn_t;
+		typedef meta::bool_<AM == M && BN == AN && BM == N> nt_t;
+		typedef meta::bool_<AN == M && BM == AM && BN == N> tn_t;
+		typedef meta::bool_<AN == M && BN == AM && BM == N> tt_t;
+
+		const T *pa = a.ptr_data();
+		const T *pb = b.ptr_data();
+		T *pc = c.ptr_data();
+
+		index_t lda = a.col_stride();
+		index_t ldb = b.col_stride();
+		index_t ldc = c.col_stride();
+
+		if (!ta)
+		{
+			if (!tb)
+				small_gemm_<T, M, N, AN, false, false>(alpha, pa, lda, pb, ldb, beta, pc, ldc, nn_t());
+			else
+				small_gemm_<T, M, N, AN, false, true>(alpha, pa, lda, pb, ldb, beta, pc, ldc, nt_t());
+		}
+		else
+		{
+			if (!tb)
+				small_gemm_<T, M, N, AM, true, false>(alpha, pa, lda, pb, ldb, beta, pc, ldc, tn_t());
+			else
+				small_gemm_<T, M, N, AM, true, true>(alpha, pa, lda, pb, ldb, beta, pc, ldc, tt_t());
+		}
+	}
+
+
+	/********************************************
+	 *
+	 *  GEMV: y = alpha * op(a) * x + beta * y
+	 *
+	 *  a is M x N
+	 *
+	 ********************************************/
+
+	template<typename T, int M, int N, typename Kind>
+	struct small_gemv_n
+	{
+		LMAT_ENSURE_INLINE
+		static void run(T alpha, const T *a, index_t lda, const T *x, index_t incx,
+				T beta, T *y, index_t incy)
+		{
+			if (incy != 1)
+			{
+				small_gemv_n<T, M, N, void>::run(alpha, a, lda, x, incx, beta, y, incy);
+				return;
+			}
+
+			typedef simd_pack<T, Kind> pack_t;
+			const int W = (int)pack_t::pack_width;
+			const int P = M / W;
+
+			pack_t s[P];
+			for (int q = 0; q < P; ++q) s[q].reset();
+
+			for (int j = 0; j < N; ++j)
+			{
+				pack_t u(x[j * incx]);
+				for (int q = 0; q < P; ++q)
+					s[q] = math::fma(pack_t(a + j * lda + q * W), u, s[q]);
+			}
+
+			pack_t av(alpha);
+			pack_t bv(beta);
+
+			for (int q = 0; q < P; ++q)
+			{
+				if (beta == T(0))
+					(av * s[q]).store_u(y + q * W);
+				else
+					math::fma(av, s[q], bv * pack_t(y + q * W)).store_u(y + q * W);
+			}
+		}
+	};
+
+	template<typename T, int M, int N>
+	struct small_gemv_n<T, M, N, void>
+	{
+		LMAT_ENSURE_INLINE
+		static void run(T alpha, const T *a, index_t lda, const T *x, index_t incx,
+				T beta, T *y, index_t incy)
+		{
+			T s[M];
+			for (int i = 0; i < M; ++i) s[i] = T(0);
+
+			for (int j = 0; j < N; ++j)
+			{
+				T u = x[j * incx];
+				for (int i = 0; i < M; ++i) s[i] += a[i + j * lda] * u;
+			}
+
+			for (int i = 0; i < M; ++i)
+			{
+				T& r = y[i * incy];
+				r = beta == T(0) ? alpha * s[i] : alpha * s[i] + beta * r;
+			}
+		}
+	};
+
+	template<typename T, int M, int N>
+	LMAT_ENSURE_INLINE
+	inline void small_gemv_t(T alpha, const T *a, index_t lda, const T *x, index_t incx,
+			T beta, T *y, index_t incy)
+	{
+		for (int j = 0; j < N; ++j)
+		{
+			T s(0);
+			for (int i = 0; i < M; ++i) s += a[i + j * lda] * x[i * incx];
+
+			T& r = y[j * incy];
+			r = beta == T(0) ? alpha * s : alpha * s + beta * r;
+		}
+	}
+
+	template<typename T, class A>
+	inline void small_gemv(T alpha, const A& a, const T *x, index_t incx,
+			T beta, T *y, index_t incy, bool ta)
+	{
+		const int M = meta::nrows<A>::value;
+		const int N = meta::ncols<A>::value;
+
+		if (!ta)
+			small_gemv_n<T, M, N, typename small_col_kind<T, M>::type>::run(
+					alpha, a.ptr_data(), a.col_stride(), x, incx, beta, y, incy);
+		else
+			small_gemv_t<T, M, N>(alpha, a.ptr_data(), a.col_stride(), x, incx, beta, y, incy);
+	}
+
+
+	/********************************************
+	 *
+	 *  LU factorization with partial pivoting
+	 *
+	 *  The results (including the 1-based pivot
+	 *  indices) follow the convention of getrf
+	 *
+	 ********************************************/
+
+	template<typename T, int N>
+	struct small_lu
+	{
+		// returns 0, or k + 1 if u(k, k) is exactly zero
+		static int trf(T *a, index_t lda, blas_int *ipiv)
+		{
+			int info = 0;
+
+			for (int k = 0; k < N; ++k)
+			{
+				int p = k;
+				T vmax = math::abs(a[k + k * lda]);
+				for (int i = k + 1; i < N; ++i)
+				{
+					T v = math::abs(a[i + k * lda]);
+					if (v > vmax)
+					{
+						vmax = v;
+						p = i;
+					}
+				}
+				ipiv[k] = (blas_int)(p + 1);
+
+				if (a[p + k * lda] != T(0))
+				{
+					if (p != k)
+					{
+						for (int j = 0; j < N; ++j)
+						{
+							T t = a[k + j * lda];
+							a[k + j * lda] = a[p + j * lda];
+							a[p + j * lda] = t;
+						}
+					}
+
+					T r = T(1) / a[k + k * lda];
+					for (int i = k + 1; i < N; ++i) a[i + k * lda] *= r;
+				}
+				else if (info == 0)
+				{
+					info = k + 1;
+				}
+
+				for (int j = k + 1; j < N; ++j)
+				{
+					T u = a[k + j * lda];
+					for (int i = k + 1; i < N; ++i) a[i + j * lda] -= a[i + k * lda] * u;
+				}
+			}
+
+			return info;
+		}
+
+		// solves op(a) * x = b in place, given the factors of a
+		static void trs(bool trans, const T *a, index_t lda, const blas_int *ipiv,
+				index_t nrhs, T *b, index_t ldb)
+		{
+			for (index_t c = 0; c < nrhs; ++c, b += ldb)
+			{
+				if (!trans)
+				{
+					for (int k = 0; k < N; ++k)
+					{
+						int p = (int)ipiv[k] - 1;
+						if (p != k)
+						{
+							T t = b[k]; b[k] = b[p]; b[p] = t;
+						}
+					}
+
+					for (int j = 0; j < N; ++j)
+						for (int i = j + 1; i < N; ++i) b[i] -= a[i + j * lda] * b[j];
+
+					for (int j = N - 1; j >= 0; --j)
+					{
+						b[j] /= a[j + j * lda];
+						for (int i = 0; i < j; ++i) b[i] -= a[i + j * lda] * b[j];
+					}
+				}
+				else
+				{
+					for (int i = 0; i < N; ++i)
+					{
+						T s = b[i];
+						for (int j = 0; j < i; ++j) s -= a[j + i * lda] * b[j];
+						b[i] = s / a[i + i * lda];
+					}
+
+					for (int i = N - 1; i >= 0; --i)
+					{
+						T s = b[i];
+						for (int j = i + 1; j < N; ++j) s -= a[j + i * lda] * b[j];
+						b[i] = s;
+					}
+
+					for (int k = N - 1; k >= 0; --k)
+					{
+						int p = (int)ipiv[k] - 1;
+						if (p != k)
+						{
+							T t = b[k]; b[k] = b[p]; b[p] = t;
+						}
+					}
+				}
+			}
+		}
+
+		// overwrites the factors in a with the inverse of a
+		static void tri(T *a, index_t lda, const blas_int *ipiv)
+		{
+			T f[N * N];
+			for (int j = 0; j < N; ++j)
+			{
+				for (int i = 0; i < N; ++i)
+				{
+					f[i + j * N] = a[i + j * lda];
+					a[i + j * lda] = T(i == j ? 1 : 0);
+				}
+			}
+
+			trs(false, f, N, ipiv, N, a, lda);
+		}
+	};
+
+
+	/********************************************
+	 *
+	 *  Cholesky factorization
+	 *
+	 *  Only the triangle indicated by uplo is
+	 *  referenced, as in potrf
+	 *
+	 ********************************************/
+
+	template<typename T, int N>
+	struct small_chol
+	{
+		// access to the lower factor l, stored either as l (uplo = 'L')
+		// or as its transpose (uplo = 'U')
+		LMAT_ENSURE_INLINE
+		static T& fac(T *a, index_t lda, bool lower, int i, int j)
+		{
+			return lower ? a[i + j * lda] : a[j + i * lda];
+		}
+
+		LMAT_ENSURE_INLINE
+		static T fac(const T *a, index_t lda, bool lower, int i, int j)
+		{
+			return lower ? a[i + j * lda] : a[j + i * lda];
+		}
+
+		// returns 0, or k + 1 if the leading minor of order k + 1 is not positive
+		static int trf(bool lower, T *a, index_t lda)
+		{
+			for (int j = 0; j < N; ++j)
+			{
+				T s = fac(a, lda, lower, j, j);
+				for (int p = 0; p < j; ++p) s -= math::sqr(fac(a, lda, lower, j, p));
+				if (!(s > T(0))) return j + 1;
+
+				T d = math::sqrt(s);
+				fac(a, lda, lower, j, j) = d;
+
+				for (int i = j + 1; i < N; ++i)
+				{
+					T t = fac(a, lda, lower, i, j);
+					for (int p = 0; p < j; ++p)
+						t -= fac(a, lda, lower, i, p) * fac(a, lda, lower, j, p);
+					fac(a, lda, lower, i, j) = t / d;
+				}
+			}
+			return 0;
+		}
+
+		// solves a * x = b in place, given the factor of a
+		static void trs(bool lower, const T *a, index_t lda, index_t nrhs, T *b, index_t ldb)
+		{
+			for (index_t c = 0; c < nrhs; ++c, b += ldb)
+			{
+				for (int i = 0; i < N; ++i)
+				{
+					T s = b[i];
+					for (int p = 0; p < i; ++p) s -= fac(a, lda, lower, i, p) * b[p];
+					b[i] = s / fac(a, lda, lower, i, i);
+				}
+
+				for (int i = N - 1; i >= 0; --i)
+				{
+					T s = b[i];
+					for (int p = i + 1; p < N; ++p) s -= fac(a, lda, lower, p, i) * b[p];
+					b[i] = s / fac(a, lda, lower, i, i);
+				}
+			}
+		}
+
+		// overwrites the triangle of the factor in a with that of
+		// the inverse of a (as potri)
+		static void tri(bool lower, T *a, index_t lda)
+		{
+			T f[N * N];
+			T x[N * N];
+			for (int j = 0; j < N; ++j)
+			{
+				for (int i = j; i < N; ++i) f[i + j * N] = fac(a, lda, lower, i, j);
+				for (int i = 0; i < N; ++i) x[i + j * N] = T(i == j ? 1 : 0);
+			}
+
+			trs(true, f, N, N, x, N);
+
+			for (int j = 0; j < N; ++j)
+				for (int i = j; i < N; ++i) fac(a, lda, lower, i, j) = x[i + j * N];
+		}
+	};
+
+} LMAT_END_NAMESPACE
+
+#endif
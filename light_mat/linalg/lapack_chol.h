@@ -15,6 +15,8 @@
 #define LIGHTMAT_LAPACK_CHOL_H_
 
 #include <light_mat/linalg/lapack_fwd.h>
+#include <light_mat/linalg/internal/small_linalg.h>
+#include <light_mat/linalg/internal/batched_lapack.h>
 #include <light_mat/math/math.h>
 
 /************************************************
@@ -94,7 +96,7 @@ extern "C"
 }
 
 
-namespace lmat { namespace lapack {
+LMAT_BEGIN_NAMESPACE namespace lapack {
 
 	// forward declarations
 
@@ -120,6 +122,27 @@ namespace lmat { namespace lapack {
 
 			return r;
 		}
+
+		// small fixed-size matrices
+
+		template<typename T, int N>
+		inline void small_potrf(char uplo, T *a, index_t lda)
+		{
+			int info = lmat::internal::small_chol<T, N>::trf(uplo == 'L', a, lda);
+			if (info != 0) throw lapack_failure("potrf", info);
+		}
+
+		template<typename T, int N>
+		inline void small_potrs(char uplo, const T *a, index_t lda, index_t nrhs, T *b, index_t ldb)
+		{
+			lmat::internal::small_chol<T, N>::trs(uplo == 'L', a, lda, nrhs, b, ldb);
+		}
+
+		template<typename T, int N>
+		inline void small_potri(char uplo, T *a, index_t lda)
+		{
+			lmat::internal::small_chol<T, N>::tri(uplo == 'L', a, lda);
+		}
 	}
 
 
@@ -206,7 +229,7 @@ namespace lmat { namespace lapack {
 		void set(const IMatrixXpr<Mat, float>& mat)
 		{
 			this->set_mat(mat);
-			trf(this->m_a, this->m_uplo);
+			trf(this->m_a, this->m_uplo, lmat::internal::small_sq_dim<Mat>());
 		}
 
 		template<class B>
@@ -214,14 +237,7 @@ namespace lmat { namespace lapack {
 		{
 			LMAT_CHECK_PERCOL_CONT(B)
 
-			lapack_int n = (lapack_int)(this->m_dim);
-			lapack_int nrhs = (lapack_int)(b.ncolumns());
-			lapack_int lda = (lapack_int)(this->m_a.col_stride());
-			lapack_int ldb = (lapack_int)(b.col_stride());
-			lapack_int info = 0;
-
-			LMAT_CALL_LAPACK(spotrs, (&(this->m_uplo), &n, &nrhs,
-					this->m_a.ptr_data(), &lda, b.ptr_data(), &ldb, &info));
+			trs(b, lmat::internal::small_nrows<B>());
 		}
 
 		template<class B, class X>
@@ -259,13 +275,8 @@ namespace lmat { namespace lapack {
 			LMAT_CHECK_DIMS( a.nrows() == a.ncolumns() );
 
 			uplo = internal::check_chol_uplo(uplo);
-			trf(a, uplo);
-
-			lapack_int n = (lapack_int)a.nrows();
-			lapack_int lda = (lapack_int)a.col_stride();
-			lapack_int info = 0;
-
-			LMAT_CALL_LAPACK(spotri, (&uplo, &n, a.ptr_data(), &lda, &info));
+			trf(a, uplo, lmat::internal::small_sq_dim<A>());
+			tri(a, uplo, lmat::internal::small_sq_dim<A>());
 
 			lmat::internal::complete_sym(a.nrows(), a, uplo);
 		}
@@ -282,7 +293,7 @@ namespace lmat { namespace lapack {
 	private:
 
 		template<class A>
-		static void trf(IRegularMatrix<A, float>& a, char uplo)
+		static void trf(IRegularMatrix<A, float>& a, char uplo, meta::int_<0>)
 		{
 			lapack_int n = (lapack_int)(a.nrows());
 			lapack_int lda = (lapack_int)(a.col_stride());
@@ -290,6 +301,50 @@ namespace lmat { namespace lapack {
 
 			LMAT_CALL_LAPACK(spotrf, (&uplo, &n, a.ptr_data(), &lda, &info));
 		}
+
+		template<class A, int N>
+		static void trf(IRegularMatrix<A, float>& a, char uplo, meta::int_<N>)
+		{
+			internal::small_potrf<float, N>(uplo, a.ptr_data(), a.col_stride());
+		}
+
+		template<class A>
+		static void tri(IRegularMatrix<A, float>& a, char uplo, meta::int_<0>)
+		{
+			lapack_int n = (lapack_int)a.nrows();
+			lapack_int lda = (lapack_int)a.col_stride();
+			lapack_int info = 0;
+
+			LMAT_CALL_LAPACK(spotri, (&uplo, &n, a.ptr_data(), &lda, &info));
+		}
+
+		template<class A, int N>
+		static void tri(IRegularMatrix<A, float>& a, char uplo, meta::int_<N>)
+		{
+			internal::small_potri<float, N>(uplo, a.ptr_data(), a.col_stride());
+		}
+
+		template<class B>
+		void trs(IRegularMatrix<B, float>& b, meta::int_<0>) const
+		{
+			lapack_int n = (lapack_int)(this->m_dim);
+			lapack_int nrhs = (lapack_int)(b.ncolumns());
+			lapack_int lda = (lapack_int)(this->m_a.col_stride());
+			lapack_int ldb = (lapack_int)(b.col_stride());
+			lapack_int info = 0;
+
+			LMAT_CALL_LAPACK(spotrs, (&(this->m_uplo), &n, &nrhs,
+					this->m_a.ptr_data(), &lda, b.ptr_data(), &ldb, &info));
+		}
+
+		template<class B, int N>
+		void trs(IRegularMatrix<B, float>& b, meta::int_<N>) const
+		{
+			LMAT_CHECK_DIMS( this->m_dim == N )
+
+			internal::small_potrs<float, N>(this->m_uplo, this->m_a.ptr_data(), this->m_a.col_stride(),
+					b.ncolumns(), b.ptr_data(), b.col_stride());
+		}
 	};
 
 
@@ -311,7 +366,7 @@ namespace lmat { namespace lapack {
 		void set(const IMatrixXpr<Mat, double>& mat)
 		{
 			this->set_mat(mat);
-			trf(this->m_a, this->m_uplo);
+			trf(this->m_a, this->m_uplo, lmat::internal::small_sq_dim<Mat>());
 		}
 
 		template<class B>
@@ -319,14 +374,7 @@ namespace lmat { namespace lapack {
 		{
 			LMAT_CHECK_PERCOL_CONT(B)
 
-			lapack_int n = (lapack_int)(this->m_dim);
-			lapack_int nrhs = (lapack_int)(b.ncolumns());
-			lapack_int lda = (lapack_int)(this->m_a.col_stride());
-			lapack_int ldb = (lapack_int)(b.col_stride());
-			lapack_int info = 0;
-
-			LMAT_CALL_LAPACK(dpotrs, (&(this->m_uplo), &n, &nrhs,
-					this->m_a.ptr_data(), &lda, b.ptr_data(), &ldb, &info));
+			trs(b, lmat::internal::small_nrows<B>());
 		}
 
 		template<class B, class X>
@@ -365,13 +413,8 @@ namespace lmat { namespace lapack {
 			LMAT_CHECK_DIMS( a.nrows() == a.ncolumns() );
 
 			uplo = internal::check_chol_uplo(uplo);
-			trf(a, uplo);
-
-			lapack_int n = (lapack_int)a.nrows();
-			lapack_int lda = (lapack_int)a.col_stride();
-			lapack_int info = 0;
-
-			LMAT_CALL_LAPACK(dpotri, (&uplo, &n, a.ptr_data(), &lda, &info));
+			trf(a, uplo, lmat::internal::small_sq_dim<A>());
+			tri(a, uplo, lmat::internal::small_sq_dim<A>());
 
 			lmat::internal::complete_sym(a.nrows(), a, uplo);
 		}
@@ -388,7 +431,7 @@ namespace lmat { namespace lapack {
 	private:
 
 		template<class A>
-		static void trf(IRegularMatrix<A, double>& a, char uplo)
+		static void trf(IRegularMatrix<A, double>& a, char uplo, meta::int_<0>)
 		{
 			lapack_int n = (lapack_int)(a.nrows());
 			lapack_int lda = (lapack_int)(a.col_stride());
@@ -396,6 +439,50 @@ namespace lmat { namespace lapack {
 
 			LMAT_CALL_LAPACK(dpotrf, (&uplo, &n, a.ptr_data(), &lda, &info));
 		}
+
+		template<class A, int N>
+		static void trf(IRegularMatrix<A, double>& a, char uplo, meta::int_<N>)
+		{
+			internal::small_potrf<double, N>(uplo, a.ptr_data(), a.col_stride());
+		}
+
+		template<class A>
+		static void tri(IRegularMatrix<A, double>& a, char uplo, meta::int_<0>)
+		{
+			lapack_int n = (lapack_int)a.nrows();
+			lapack_int lda = (lapack_int)a.col_stride();
+			lapack_int info = 0;
+
+			LMAT_CALL_LAPACK(dpotri, (&uplo, &n, a.ptr_data(), &lda, &info));
+		}
+
+		template<class A, int N>
+		static void tri(IRegularMatrix<A, double>& a, char uplo, meta::int_<N>)
+		{
+			internal::small_potri<double, N>(uplo, a.ptr_data(), a.col_stride());
+		}
+
+		template<class B>
+		void trs(IRegularMatrix<B, double>& b, meta::int_<0>) const
+		{
+			lapack_int n = (lapack_int)(this->m_dim);
+			lapack_int nrhs = (lapack_int)(b.ncolumns());
+			lapack_int lda = (lapack_int)(this->m_a.col_stride());
+			lapack_int ldb = (lapack_int)(b.col_stride());
+			lapack_int info = 0;
+
+			LMAT_CALL_LAPACK(dpotrs, (&(this->m_uplo), &n, &nrhs,
+					this->m_a.ptr_data(), &lda, b.ptr_data(), &ldb, &info));
+		}
+
+		template<class B, int N>
+		void trs(IRegularMatrix<B, double>& b, meta::int_<N>) const
+		{
+			LMAT_CHECK_DIMS( this->m_dim == N )
+
+			internal::small_potrs<double, N>(this->m_uplo, this->m_a.ptr_data(), this->m_a.col_stride(),
+					b.ncolumns(), b.ptr_data(), b.col_stride());
+		}
 	};
 
 
@@ -405,6 +492,40 @@ namespace lmat { namespace lapack {
 	 *
 	 ************************************************/
 
+	namespace internal
+	{
+		template<class A, class B>
+		inline void posv_(IRegularMatrix<A, float>& a, IRegularMatrix<B, float>& b, char uplo, meta::int_<0>)
+		{
+			lapack_int n = (lapack_int)a.nrows();
+			lapack_int nrhs = (lapack_int)b.ncolumns();
+			lapack_int lda = (lapack_int)a.col_stride();
+			lapack_int ldb = (lapack_int)b.col_stride();
+
+			lapack_int info = 0;
+			LMAT_CALL_LAPACK(sposv, (&uplo, &n, &nrhs, a.ptr_data(), &lda, b.ptr_data(), &ldb, &info));
+		}
+
+		template<class A, class B>
+		inline void posv_(IRegularMatrix<A, double>& a, IRegularMatrix<B, double>& b, char uplo, meta::int_<0>)
+		{
+			lapack_int n = (lapack_int)a.nrows();
+			lapack_int nrhs = (lapack_int)b.ncolumns();
+			lapack_int lda = (lapack_int)a.col_stride();
+			lapack_int ldb = (lapack_int)b.col_stride();
+
+			lapack_int info = 0;
+			LMAT_CALL_LAPACK(dposv, (&uplo, &n, &nrhs, a.ptr_data(), &lda, b.ptr_data(), &ldb, &info));
+		}
+
+		template<typename T, class A, class B, int N>
+		inline void posv_(IRegularMatrix<A, T>& a, IRegularMatrix<B, T>& b, char uplo, meta::int_<N>)
+		{
+			small_potrf<T, N>(uplo, a.ptr_data(), a.col_stride());
+			small_potrs<T, N>(uplo, a.ptr_data(), a.col_stride(), b.ncolumns(), b.ptr_data(), b.col_stride());
+		}
+	}
+
 	template<class A, class B>
 	inline void posv(IRegularMatrix<A, float>& a, IRegularMatrix<B, float>& b, char uplo='L')
 	{
@@ -414,13 +535,7 @@ namespace lmat { namespace lapack {
 		uplo = internal::check_chol_uplo(uplo);
 		LMAT_CHECK_DIMS( a.nrows() == a.ncolumns() && a.nrows() == b.nrows() );
 
-		lapack_int n = (lapack_int)a.nrows();
-		lapack_int nrhs = (lapack_int)b.ncolumns();
-		lapack_int lda = (lapack_int)a.col_stride();
-		lapack_int ldb = (lapack_int)b.col_stride();
-
-		lapack_int info = 0;
-		LMAT_CALL_LAPACK(sposv, (&uplo, &n, &nrhs, a.ptr_data(), &lda, b.ptr_data(), &ldb, &info));
+		internal::posv_(a, b, uplo, lmat::internal::small_sq_dim<A>());
 	}
 
 	template<class A, class B>
@@ -432,21 +547,207 @@ namespace lmat { namespace lapack {
 		uplo = internal::check_chol_uplo(uplo);
 		LMAT_CHECK_DIMS( a.nrows() == a.ncolumns() && a.nrows() == b.nrows() );
 
-		lapack_int n = (lapack_int)a.nrows();
-		lapack_int nrhs = (lapack_int)b.ncolumns();
-		lapack_int lda = (lapack_int)a.col_stride();
-		lapack_int ldb = (lapack_int)b.col_stride();
+		internal::posv_(a, b, uplo, lmat::internal::small_sq_dim<A>());
+	}
+
+
+	/************************************************
+	 *
+	 *  batched Cholesky
+	 *
+	 *  For the strided batch, a is n x (n * nb),
+	 *  and the l-th system is its l-th n x n block
+	 *  of columns, b is n x (nrhs * nb) likewise.
+	 *
+	 *  info receives one code per system, when it
+	 *  is null, a failure throws lapack_failure.
+	 *
+	 ************************************************/
+
+	namespace internal
+	{
+		template<typename T, class SA>
+		inline void potrf_batched_(index_t nb, index_t n, char uplo,
+				const SA& a, index_t lda, lapack_int *info)
+		{
+			if (nb == 0) return;
+
+			bool lower = check_chol_uplo(uplo) == 'L';
+			run_batched("potrf", nb, info, [&](lapack_int *inf)
+			{
+				lmat::internal::batched_lapack_engine<T>::potrf(nb, n, lower, a, lda, inf);
+			});
+		}
+
+		template<typename T, class SA, class SB>
+		inline void potrs_batched_(index_t nb, index_t n, index_t nrhs, char uplo,
+				const SA& a, index_t lda, const SB& b, index_t ldb)
+		{
+			if (nb == 0) return;
+
+			bool lower = check_chol_uplo(uplo) == 'L';
+			lmat::internal::batched_lapack_engine<T>::potrs(nb, n, nrhs, lower, a, lda, b, ldb);
+		}
+
+		template<typename T, class SA, class SB>
+		inline void posv_batched_(index_t nb, index_t n, index_t nrhs, char uplo,
+				const SA& a, index_t lda, const SB& b, index_t ldb, lapack_int *info)
+		{
+			if (nb == 0) return;
 
-		lapack_int info = 0;
-		LMAT_CALL_LAPACK(dposv, (&uplo, &n, &nrhs, a.ptr_data(), &lda, b.ptr_data(), &ldb, &info));
+			bool lower = check_chol_uplo(uplo) == 'L';
+			run_batched("posv", nb, info, [&](lapack_int *inf)
+			{
+				lmat::internal::batched_lapack_engine<T>::posv(nb, n, nrhs, lower, a, lda, b, ldb, inf);
+			});
+		}
+
+		template<typename T, class A>
+		inline void potrf_strided_batched_(A& a, char uplo, lapack_int *info)
+		{
+			const index_t n = a.nrows();
+			LMAT_CHECK_DIMS( n > 0 && a.ncolumns() % n == 0 );
+
+			potrf_batched_<T>(a.ncolumns() / n, n, uplo,
+					lmat::internal::strided_batch<T>(a.ptr_data(), n * a.col_stride()), a.col_stride(), info);
+		}
+
+		template<typename T, class A, class B>
+		inline void potrs_strided_batched_(const A& a, B& b, char uplo)
+		{
+			const index_t n = a.nrows();
+			LMAT_CHECK_DIMS( n > 0 && a.ncolumns() % n == 0 && b.nrows() == n );
+
+			const index_t nb = a.ncolumns() / n;
+			LMAT_CHECK_DIMS( nb > 0 && b.ncolumns() % nb == 0 );
+
+			const index_t nrhs = b.ncolumns() / nb;
+			potrs_batched_<T>(nb, n, nrhs, uplo,
+					lmat::internal::strided_batch<const T>(a.ptr_data(), n * a.col_stride()), a.col_stride(),
+					lmat::internal::strided_batch<T>(b.ptr_data(), nrhs * b.col_stride()), b.col_stride());
+		}
+
+		template<typename T, class A, class B>
+		inline void posv_strided_batched_(A& a, B& b, char uplo, lapack_int *info)
+		{
+			const index_t n = a.nrows();
+			LMAT_CHECK_DIMS( n > 0 && a.ncolumns() % n == 0 && b.nrows() == n );
+
+			const index_t nb = a.ncolumns() / n;
+			LMAT_CHECK_DIMS( nb > 0 && b.ncolumns() % nb == 0 );
+
+			const index_t nrhs = b.ncolumns() / nb;
+			posv_batched_<T>(nb, n, nrhs, uplo,
+					lmat::internal::strided_batch<T>(a.ptr_data(), n * a.col_stride()), a.col_stride(),
+					lmat::internal::strided_batch<T>(b.ptr_data(), nrhs * b.col_stride()), b.col_stride(), info);
+		}
 	}
 
+	// strided batches
 
-} }
+	template<class A>
+	inline void potrf_batched(IRegularMatrix<A, float>& a, char uplo='L', lapack_int *info=0)
+	{
+		LMAT_CHECK_PERCOL_CONT(A)
+		internal::potrf_strided_batched_<float>(a.derived(), uplo, info);
+	}
 
+	template<class A>
+	inline void potrf_batched(IRegularMatrix<A, double>& a, char uplo='L', lapack_int *info=0)
+	{
+		LMAT_CHECK_PERCOL_CONT(A)
+		internal::potrf_strided_batched_<double>(a.derived(), uplo, info);
+	}
 
-namespace lmat
-{
+	template<class A, class B>
+	inline void potrs_batched(const IRegularMatrix<A, float>& a, IRegularMatrix<B, float>& b, char uplo='L')
+	{
+		LMAT_CHECK_PERCOL_CONT(A)
+		LMAT_CHECK_PERCOL_CONT(B)
+		internal::potrs_strided_batched_<float>(a.derived(), b.derived(), uplo);
+	}
+
+	template<class A, class B>
+	inline void potrs_batched(const IRegularMatrix<A, double>& a, IRegularMatrix<B, double>& b, char uplo='L')
+	{
+		LMAT_CHECK_PERCOL_CONT(A)
+		LMAT_CHECK_PERCOL_CONT(B)
+		internal::potrs_strided_batched_<double>(a.derived(), b.derived(), uplo);
+	}
+
+	template<class A, class B>
+	inline void posv_batched(IRegularMatrix<A, float>& a, IRegularMatrix<B, float>& b,
+			char uplo='L', lapack_int *info=0)
+	{
+		LMAT_CHECK_PERCOL_CONT(A)
+		LMAT_CHECK_PERCOL_CONT(B)
+		internal::posv_strided_batched_<float>(a.derived(), b.derived(), uplo, info);
+	}
+
+	template<class A, class B>
+	inline void posv_batched(IRegularMatrix<A, double>& a, IRegularMatrix<B, double>& b,
+			char uplo='L', lapack_int *info=0)
+	{
+		LMAT_CHECK_PERCOL_CONT(A)
+		LMAT_CHECK_PERCOL_CONT(B)
+		internal::posv_strided_batched_<double>(a.derived(), b.derived(), uplo, info);
+	}
+
+	// pointer arrays: the l-th system is at a[l] and b[l]
+
+	inline void potrf_batched(index_t nbatch, index_t n, float* const* a, index_t lda,
+			char uplo='L', lapack_int *info=0)
+	{
+		internal::potrf_batched_<float>(nbatch, n, uplo,
+				lmat::internal::pointer_batch<float>(a), lda, info);
+	}
+
+	inline void potrf_batched(index_t nbatch, index_t n, double* const* a, index_t lda,
+			char uplo='L', lapack_int *info=0)
+	{
+		internal::potrf_batched_<double>(nbatch, n, uplo,
+				lmat::internal::pointer_batch<double>(a), lda, info);
+	}
+
+	inline void potrs_batched(index_t nbatch, index_t n, index_t nrhs,
+			const float* const* a, index_t lda, float* const* b, index_t ldb, char uplo='L')
+	{
+		internal::potrs_batched_<float>(nbatch, n, nrhs, uplo,
+				lmat::internal::pointer_batch<const float>(a), lda,
+				lmat::internal::pointer_batch<float>(b), ldb);
+	}
+
+	inline void potrs_batched(index_t nbatch, index_t n, index_t nrhs,
+			const double* const* a, index_t lda, double* const* b, index_t ldb, char uplo='L')
+	{
+		internal::potrs_batched_<double>(nbatch, n, nrhs, uplo,
+				lmat::internal::pointer_batch<const double>(a), lda,
+				lmat::internal::pointer_batch<double>(b), ldb);
+	}
+
+	inline void posv_batched(index_t nbatch, index_t n, index_t nrhs,
+			float* const* a, index_t lda, float* const* b, index_t ldb,
+			char uplo='L', lapack_int *info=0)
+	{
+		internal::posv_batched_<float>(nbatch, n, nrhs, uplo,
+				lmat::internal::pointer_batch<float>(a), lda,
+				lmat::internal::pointer_batch<float>(b), ldb, info);
+	}
+
+	inline void posv_batched(index_t nbatch, index_t n, index_t nrhs,
+			double* const* a, index_t lda, double* const* b, index_t ldb,
+			char uplo='L', lapack_int *info=0)
+	{
+		internal::posv_batched_<double>(nbatch, n, nrhs, uplo,
+				lmat::internal::pointer_batch<double>(a), lda,
+				lmat::internal::pointer_batch<double>(b), ldb, info);
+	}
+
+
+} LMAT_END_NAMESPACE
+
+
+LMAT_BEGIN_NAMESPACE
 
 	template<class Arg> class pdinv_expr;
 
@@ -603,7 +904,7 @@ namespace lmat
 	}
 
 
-}
+LMAT_END_NAMESPACE
 
 
 
@@ -15,6 +15,8 @@
 
 #include <light_mat/linalg/linalg_fwd.h>
 #include <string>
+#include <vector>
+#include <cstring>
 #include "internal/linalg_aux.h"
 
 #define LMAT_CALL_LAPACK(fun, params) \
@@ -23,7 +25,7 @@
 
 typedef blas_int lapack_int;
 
-namespace lmat { namespace lapack {
+LMAT_BEGIN_NAMESPACE namespace lapack {
 
 	class lapack_failure : public std::exception
 	{
@@ -49,6 +51,144 @@ namespace lmat { namespace lapack {
 		int m_errcode;
 	};
 
-} }
+	/********************************************
+	 *
+	 *  workspace
+	 *
+	 ********************************************/
+
+	// Caches the optimal workspace sizes returned by LAPACK queries
+	// (keyed by routine and the arguments that affect them), together
+	// with buffers that only grow. Reusing one workspace across calls
+	// on same-sized problems skips both the query and the allocation.
+	//
+	// A workspace must not be shared between concurrent calls.
+
+	class workspace : private noncopyable
+	{
+	public:
+		struct key
+		{
+			const char *routine;   // must be a string literal
+			index_t args[5];
+
+			key(const char *r, index_t a0, index_t a1=0, index_t a2=0, index_t a3=0, index_t a4=0)
+			: routine(r)
+			{
+				args[0] = a0;
+				args[1] = a1;
+				args[2] = a2;
+				args[3] = a3;
+				args[4] = a4;
+			}
+
+			bool operator == (const key& rhs) const
+			{
+				return std::strcmp(routine, rhs.routine) == 0 &&
+						args[0] == rhs.args[0] && args[1] == rhs.args[1] &&
+						args[2] == rhs.args[2] && args[3] == rhs.args[3] &&
+						args[4] == rhs.args[4];
+			}
+		};
+
+		workspace() { }
+
+		// looks up the cached sizes, returns false if never recorded
+
+		bool find(const key& k, lapack_int& lwork, lapack_int& liwork) const
+		{
+			for (size_t i = 0; i < m_entries.size(); ++i)
+			{
+				if (m_entries[i].k == k)
+				{
+					lwork = m_entries[i].lwork;
+					liwork = m_entries[i].liwork;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void put(const key& k, lapack_int lwork, lapack_int liwork)
+		{
+			entry e = { k, lwork, liwork };
+			m_entries.push_back(e);
+		}
+
+		index_t num_cached() const
+		{
+			return (index_t)m_entries.size();
+		}
+
+		// buffers (contents are not preserved across calls)
+
+		template<typename T>
+		T* work(index_t n);
+
+		lapack_int* iwork(index_t n)
+		{
+			return grow(m_ibuf, n);
+		}
+
+	private:
+		struct entry
+		{
+			key k;
+			lapack_int lwork;
+			lapack_int liwork;
+		};
+
+		template<typename T>
+		static T* grow(dense_col<T>& buf, index_t n)
+		{
+			if (buf.nelems() < n) buf.require_size(n);
+			return buf.ptr_data();
+		}
+
+		std::vector<entry> m_entries;
+		dense_col<float> m_fbuf;
+		dense_col<double> m_dbuf;
+		dense_col<lapack_int> m_ibuf;
+	};
+
+	template<>
+	inline float* workspace::work<float>(index_t n)
+	{
+		return grow(m_fbuf, n);
+	}
+
+	template<>
+	inline double* workspace::work<double>(index_t n)
+	{
+		return grow(m_dbuf, n);
+	}
+
+
+	namespace internal
+	{
+		// runs a batched routine as fun(info), with one info code per system,
+		// when the caller provides no info array, a failure throws
+
+		template<class Fun>
+		inline void run_batched(const char *routine, index_t nb, lapack_int *info, const Fun& fun)
+		{
+			if (info)
+			{
+				fun(info);
+			}
+			else
+			{
+				dense_col<lapack_int> codes(nb);
+				fun(codes.ptr_data());
+
+				for (index_t l = 0; l < nb; ++l)
+				{
+					if (codes[l] != 0) throw lapack_failure(routine, (int)codes[l]);
+				}
+			}
+		}
+	}
+
+} LMAT_END_NAMESPACE
 
 #endif /* LAPACK_FWD_H_ */
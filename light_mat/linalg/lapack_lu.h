@@ -14,6 +14,8 @@
 #define LIGHTMAT_LAPACK_LU_H_
 
 #include <light_mat/linalg/lapack_fwd.h>
+#include <light_mat/linalg/internal/small_linalg.h>
+#include <light_mat/linalg/internal/batched_lapack.h>
 
 
 /************************************************
@@ -98,12 +100,44 @@ extern "C"
 }
 
 
-namespace lmat { namespace lapack {
+LMAT_BEGIN_NAMESPACE namespace lapack {
 
 	// forward declarations
 
 	template<typename T> class lu_fac;
 
+
+	/************************************************
+	 *
+	 *  small fixed-size matrices
+	 *
+	 ************************************************/
+
+	namespace internal
+	{
+		template<typename T, int N>
+		inline void small_getrf(T *a, index_t lda, lapack_int *ipiv)
+		{
+			int info = lmat::internal::small_lu<T, N>::trf(a, lda, ipiv);
+			if (info != 0) throw lapack_failure("getrf", info);
+		}
+
+		template<typename T, int N>
+		inline void small_getri(T *a, index_t lda)
+		{
+			lapack_int ipiv[N];
+			small_getrf<T, N>(a, lda, ipiv);
+			lmat::internal::small_lu<T, N>::tri(a, lda, ipiv);
+		}
+
+		template<typename T, int N>
+		inline void small_getrs(char trans, const T *a, index_t lda, const lapack_int *ipiv,
+				index_t nrhs, T *b, index_t ldb)
+		{
+			lmat::internal::small_lu<T, N>::trs(trans != 'N' && trans != 'n', a, lda, ipiv, nrhs, b, ldb);
+		}
+	}
+
 	/************************************************
 	 *
 	 *  LU classes
@@ -194,7 +228,7 @@ namespace lmat { namespace lapack {
 		void set(const IMatrixXpr<Mat, float>& mat)
 		{
 			this->set_mat(mat);
-			trf(this->m_a, this->m_ipiv.ptr_data());
+			trf(this->m_a, this->m_ipiv.ptr_data(), lmat::internal::small_sq_dim<Mat>());
 		}
 
 		template<class B>
@@ -202,14 +236,7 @@ namespace lmat { namespace lapack {
 		{
 			LMAT_CHECK_PERCOL_CONT(B)
 
-			lapack_int n = (lapack_int)(this->m_dim);
-			lapack_int nrhs = (lapack_int)(b.ncolumns());
-			lapack_int lda = (lapack_int)(this->m_a.col_stride());
-			lapack_int ldb = (lapack_int)(b.col_stride());
-			lapack_int info = 0;
-
-			LMAT_CALL_LAPACK(sgetrs, (&trans, &n, &nrhs, this->m_a.ptr_data(), &lda,
-					this->m_ipiv.ptr_data(), b.ptr_data(), &ldb, &info));
+			trs(b, trans, lmat::internal::small_nrows<B>());
 		}
 
 		template<class B, class X>
@@ -224,42 +251,41 @@ namespace lmat { namespace lapack {
 	public:
 		template<class A>
 		static void inv_inplace(IRegularMatrix<A, float>& a)
+		{
+			workspace ws;
+			inv_inplace(a, ws);
+		}
+
+		template<class A>
+		static void inv_inplace(IRegularMatrix<A, float>& a, workspace& ws)
 		{
 			LMAT_CHECK_PERCOL_CONT(A)
 
 			LMAT_CHECK_DIMS( a.nrows() == a.ncolumns() );
 
-			dense_col<lapack_int> ipiv(a.nrows());
-
-			trf(a, ipiv.ptr_data());
-
-			lapack_int n = (lapack_int)a.nrows();
-			lapack_int lda = (lapack_int)a.col_stride();
-			lapack_int info = 0;
-
-			lapack_int lwork = -1;
-			float lwork_opt = 0;
-			LMAT_CALL_LAPACK(sgetri, (&n, a.ptr_data(), &lda, ipiv.ptr_data(), &lwork_opt, &lwork, &info));
-
-			lwork = (lapack_int)lwork_opt;
-			dense_col<float> ws((index_t)lwork);
-
-			LMAT_CALL_LAPACK(sgetri, (&n, a.ptr_data(), &lda, ipiv.ptr_data(), ws.ptr_data(), &lwork, &info));
+			inv_(a, ws, lmat::internal::small_sq_dim<A>());
 		}
 
 		template<class A, class B>
 		static void inv(const IMatrixXpr<A, float>& a, IRegularMatrix<B, float>& b)
+		{
+			workspace ws;
+			inv(a, b, ws);
+		}
+
+		template<class A, class B>
+		static void inv(const IMatrixXpr<A, float>& a, IRegularMatrix<B, float>& b, workspace& ws)
 		{
 			LMAT_CHECK_PERCOL_CONT(B)
 
 			b.derived() = a.derived();
-			inv_inplace(b);
+			inv_inplace(b, ws);
 		}
 
 	private:
 
 		template<class A>
-		static void trf(IRegularMatrix<A, float>& a, lapack_int* ipiv)
+		static void trf(IRegularMatrix<A, float>& a, lapack_int* ipiv, meta::int_<0>)
 		{
 			lapack_int n = (lapack_int)(a.nrows());
 			lapack_int lda = (lapack_int)(a.col_stride());
@@ -267,6 +293,67 @@ namespace lmat { namespace lapack {
 
 			LMAT_CALL_LAPACK(sgetrf, (&n, &n, a.ptr_data(), &lda, ipiv, &info));
 		}
+
+		template<class A, int N>
+		static void trf(IRegularMatrix<A, float>& a, lapack_int* ipiv, meta::int_<N>)
+		{
+			internal::small_getrf<float, N>(a.ptr_data(), a.col_stride(), ipiv);
+		}
+
+		template<class B>
+		void trs(IRegularMatrix<B, float>& b, char trans, meta::int_<0>) const
+		{
+			lapack_int n = (lapack_int)(this->m_dim);
+			lapack_int nrhs = (lapack_int)(b.ncolumns());
+			lapack_int lda = (lapack_int)(this->m_a.col_stride());
+			lapack_int ldb = (lapack_int)(b.col_stride());
+			lapack_int info = 0;
+
+			LMAT_CALL_LAPACK(sgetrs, (&trans, &n, &nrhs, this->m_a.ptr_data(), &lda,
+					this->m_ipiv.ptr_data(), b.ptr_data(), &ldb, &info));
+		}
+
+		template<class B, int N>
+		void trs(IRegularMatrix<B, float>& b, char trans, meta::int_<N>) const
+		{
+			LMAT_CHECK_DIMS( this->m_dim == N )
+
+			internal::small_getrs<float, N>(trans, this->m_a.ptr_data(), this->m_a.col_stride(),
+					this->m_ipiv.ptr_data(), b.ncolumns(), b.ptr_data(), b.col_stride());
+		}
+
+		template<class A>
+		static void inv_(IRegularMatrix<A, float>& a, workspace& ws, meta::int_<0>)
+		{
+			lapack_int *ipiv = ws.iwork(a.nrows());
+
+			trf(a, ipiv, meta::int_<0>());
+
+			lapack_int n = (lapack_int)a.nrows();
+			lapack_int lda = (lapack_int)a.col_stride();
+			lapack_int info = 0;
+
+			lapack_int lwork = -1;
+			lapack_int liwork = 0;
+
+			workspace::key qk("sgetri", n);
+			if (!ws.find(qk, lwork, liwork))
+			{
+				float lwork_opt = 0;
+				LMAT_CALL_LAPACK(sgetri, (&n, a.ptr_data(), &lda, ipiv, &lwork_opt, &lwork, &info));
+
+				lwork = (lapack_int)lwork_opt;
+				ws.put(qk, lwork, liwork);
+			}
+
+			LMAT_CALL_LAPACK(sgetri, (&n, a.ptr_data(), &lda, ipiv, ws.work<float>(lwork), &lwork, &info));
+		}
+
+		template<class A, int N>
+		static void inv_(IRegularMatrix<A, float>& a, workspace&, meta::int_<N>)
+		{
+			internal::small_getri<float, N>(a.ptr_data(), a.col_stride());
+		}
 	};
 
 
@@ -288,7 +375,7 @@ namespace lmat { namespace lapack {
 		void set(const IMatrixXpr<Mat, double>& mat)
 		{
 			this->set_mat(mat);
-			trf(this->m_a, this->m_ipiv.ptr_data());
+			trf(this->m_a, this->m_ipiv.ptr_data(), lmat::internal::small_sq_dim<Mat>());
 		}
 
 		template<class B>
@@ -296,14 +383,7 @@ namespace lmat { namespace lapack {
 		{
 			LMAT_CHECK_PERCOL_CONT(B)
 
-			lapack_int n = (lapack_int)(this->m_dim);
-			lapack_int nrhs = (lapack_int)(b.ncolumns());
-			lapack_int lda = (lapack_int)(this->m_a.col_stride());
-			lapack_int ldb = (lapack_int)(b.col_stride());
-			lapack_int info = 0;
-
-			LMAT_CALL_LAPACK(dgetrs, (&trans, &n, &nrhs, this->m_a.ptr_data(), &lda,
-					this->m_ipiv.ptr_data(), b.ptr_data(), &ldb, &info));
+			trs(b, trans, lmat::internal::small_nrows<B>());
 		}
 
 		template<class B, class X>
@@ -318,42 +398,41 @@ namespace lmat { namespace lapack {
 	public:
 		template<class A>
 		static void inv_inplace(IRegularMatrix<A, double>& a)
+		{
+			workspace ws;
+			inv_inplace(a, ws);
+		}
+
+		template<class A>
+		static void inv_inplace(IRegularMatrix<A, double>& a, workspace& ws)
 		{
 			LMAT_CHECK_PERCOL_CONT(A)
 
 			LMAT_CHECK_DIMS( a.nrows() == a.ncolumns() );
 
-			dense_col<lapack_int> ipiv(a.nrows());
-
-			trf(a, ipiv.ptr_data());
-
-			lapack_int n = (lapack_int)a.nrows();
-			lapack_int lda = (lapack_int)a.col_stride();
-			lapack_int info = 0;
-
-			lapack_int lwork = -1;
-			double lwork_opt = 0;
-			LMAT_CALL_LAPACK(dgetri, (&n, a.ptr_data(), &lda, ipiv.ptr_data(), &lwork_opt, &lwork, &info));
-
-			lwork = (lapack_int)lwork_opt;
-			dense_col<double> ws((index_t)lwork);
-
-			LMAT_CALL_LAPACK(dgetri, (&n, a.ptr_data(), &lda, ipiv.ptr_data(), ws.ptr_data(), &lwork, &info));
+			inv_(a, ws, lmat::internal::small_sq_dim<A>());
 		}
 
 		template<class A, class B>
 		static void inv(const IMatrixXpr<A, double>& a, IRegularMatrix<B, double>& b)
+		{
+			workspace ws;
+			inv(a, b, ws);
+		}
+
+		template<class A, class B>
+		static void inv(const IMatrixXpr<A, double>& a, IRegularMatrix<B, double>& b, workspace& ws)
 		{
 			LMAT_CHECK_PERCOL_CONT(B)
 
 			b.derived() = a.derived();
-			inv_inplace(b);
+			inv_inplace(b, ws);
 		}
 
 	private:
 
 		template<class A>
-		static void trf(IRegularMatrix<A, double>& a, lapack_int* ipiv)
+		static void trf(IRegularMatrix<A, double>& a, lapack_int* ipiv, meta::int_<0>)
 		{
 			lapack_int n = (lapack_int)(a.nrows());
 			lapack_int lda = (lapack_int)(a.col_stride());
@@ -361,6 +440,67 @@ namespace lmat { namespace lapack {
 
 			LMAT_CALL_LAPACK(dgetrf, (&n, &n, a.ptr_data(), &lda, ipiv, &info));
 		}
+
+		template<class A, int N>
+		static void trf(IRegularMatrix<A, double>& a, lapack_int* ipiv, meta::int_<N>)
+		{
+			internal::small_getrf<double, N>(a.ptr_data(), a.col_stride(), ipiv);
+		}
+
+		template<class B>
+		void trs(IRegularMatrix<B, double>& b, char trans, meta::int_<0>) const
+		{
+			lapack_int n = (lapack_int)(this->m_dim);
+			lapack_int nrhs = (lapack_int)(b.ncolumns());
+			lapack_int lda = (lapack_int)(this->m_a.col_stride());
+			lapack_int ldb = (lapack_int)(b.col_stride());
+			lapack_int info = 0;
+
+			LMAT_CALL_LAPACK(dgetrs, (&trans, &n, &nrhs, this->m_a.ptr_data(), &lda,
+					this->m_ipiv.ptr_data(), b.ptr_data(), &ldb, &info));
+		}
+
+		template<class B, int N>
+		void trs(IRegularMatrix<B, double>& b, char trans, meta::int_<N>) const
+		{
+			LMAT_CHECK_DIMS( this->m_dim == N )
+
+			internal::small_getrs<double, N>(trans, this->m_a.ptr_data(), this->m_a.col_stride(),
+					this->m_ipiv.ptr_data(), b.ncolumns(), b.ptr_data(), b.col_stride());
+		}
+
+		template<class A>
+		static void inv_(IRegularMatrix<A, double>& a, workspace& ws, meta::int_<0>)
+		{
+			lapack_int *ipiv = ws.iwork(a.nrows());
+
+			trf(a, ipiv, meta::int_<0>());
+
+			lapack_int n = (lapack_int)a.nrows();
+			lapack_int lda = (lapack_int)a.col_stride();
+			lapack_int info = 0;
+
+			lapack_int lwork = -1;
+			lapack_int liwork = 0;
+
+			workspace::key qk("dgetri", n);
+			if (!ws.find(qk, lwork, liwork))
+			{
+				double lwork_opt = 0;
+				LMAT_CALL_LAPACK(dgetri, (&n, a.ptr_data(), &lda, ipiv, &lwork_opt, &lwork, &info));
+
+				lwork = (lapack_int)lwork_opt;
+				ws.put(qk, lwork, liwork);
+			}
+
+			LMAT_CALL_LAPACK(dgetri, (&n, a.ptr_data(), &lda, ipiv, ws.work<double>(lwork), &lwork, &info));
+		}
+
+		template<class A, int N>
+		static void inv_(IRegularMatrix<A, double>& a, workspace&, meta::int_<N>)
+		{
+			internal::small_getri<double, N>(a.ptr_data(), a.col_stride());
+		}
 	};
 
 
@@ -370,6 +510,43 @@ namespace lmat { namespace lapack {
 	 *
 	 ************************************************/
 
+	namespace internal
+	{
+		template<class A, class B>
+		inline void gesv_(IRegularMatrix<A, float>& a, IRegularMatrix<B, float>& b, meta::int_<0>)
+		{
+			lapack_int n = (lapack_int)a.nrows();
+			lapack_int nrhs = (lapack_int)b.ncolumns();
+			lapack_int lda = (lapack_int)a.col_stride();
+			lapack_int ldb = (lapack_int)b.col_stride();
+			dense_col<lapack_int> ipiv(n);
+
+			lapack_int info = 0;
+			LMAT_CALL_LAPACK(sgesv, (&n, &nrhs, a.ptr_data(), &lda, ipiv.ptr_data(), b.ptr_data(), &ldb, &info));
+		}
+
+		template<class A, class B>
+		inline void gesv_(IRegularMatrix<A, double>& a, IRegularMatrix<B, double>& b, meta::int_<0>)
+		{
+			lapack_int n = (lapack_int)a.nrows();
+			lapack_int nrhs = (lapack_int)b.ncolumns();
+			lapack_int lda = (lapack_int)a.col_stride();
+			lapack_int ldb = (lapack_int)b.col_stride();
+			dense_col<lapack_int> ipiv(n);
+
+			lapack_int info = 0;
+			LMAT_CALL_LAPACK(dgesv, (&n, &nrhs, a.ptr_data(), &lda, ipiv.ptr_data(), b.ptr_data(), &ldb, &info));
+		}
+
+		template<typename T, class A, class B, int N>
+		inline void gesv_(IRegularMatrix<A, T>& a, IRegularMatrix<B, T>& b, meta::int_<N>)
+		{
+			lapack_int ipiv[N];
+			small_getrf<T, N>(a.ptr_data(), a.col_stride(), ipiv);
+			small_getrs<T, N>('N', a.ptr_data(), a.col_stride(), ipiv, b.ncolumns(), b.ptr_data(), b.col_stride());
+		}
+	}
+
 	template<class A, class B>
 	inline void gesv(IRegularMatrix<A, float>& a, IRegularMatrix<B, float>& b)
 	{
@@ -378,14 +555,7 @@ namespace lmat { namespace lapack {
 
 		LMAT_CHECK_DIMS( a.nrows() == a.ncolumns() && a.nrows() == b.nrows() );
 
-		lapack_int n = (lapack_int)a.nrows();
-		lapack_int nrhs = (lapack_int)b.ncolumns();
-		lapack_int lda = (lapack_int)a.col_stride();
-		lapack_int ldb = (lapack_int)b.col_stride();
-		dense_col<lapack_int> ipiv(n);
-
-		lapack_int info = 0;
-		LMAT_CALL_LAPACK(sgesv, (&n, &nrhs, a.ptr_data(), &lda, ipiv.ptr_data(), b.ptr_data(), &ldb, &info));
+		internal::gesv_(a, b, lmat::internal::small_sq_dim<A>());
 	}
 
 	template<class A, class B>
@@ -396,21 +566,207 @@ namespace lmat { namespace lapack {
 
 		LMAT_CHECK_DIMS( a.nrows() == a.ncolumns() && a.nrows() == b.nrows() );
 
-		lapack_int n = (lapack_int)a.nrows();
-		lapack_int nrhs = (lapack_int)b.ncolumns();
-		lapack_int lda = (lapack_int)a.col_stride();
-		lapack_int ldb = (lapack_int)b.col_stride();
-		dense_col<lapack_int> ipiv(n);
+		internal::gesv_(a, b, lmat::internal::small_sq_dim<A>());
+	}
+
+
+	/************************************************
+	 *
+	 *  batched LU
+	 *
+	 *  For the strided batch, a is n x (n * nb),
+	 *  and the l-th system is its l-th n x n block
+	 *  of columns, b is n x (nrhs * nb) likewise.
+	 *
+	 *  The pivots of the l-th system are at
+	 *  ipiv + l * n. info receives one code per
+	 *  system, when it is null, a failure throws
+	 *  lapack_failure.
+	 *
+	 ************************************************/
+
+	namespace internal
+	{
+		template<typename T, class SA>
+		inline void getrf_batched_(index_t nb, index_t n,
+				const SA& a, index_t lda, lapack_int *ipiv, lapack_int *info)
+		{
+			if (nb == 0) return;
 
-		lapack_int info = 0;
-		LMAT_CALL_LAPACK(dgesv, (&n, &nrhs, a.ptr_data(), &lda, ipiv.ptr_data(), b.ptr_data(), &ldb, &info));
+			run_batched("getrf", nb, info, [&](lapack_int *inf)
+			{
+				lmat::internal::batched_lapack_engine<T>::getrf(nb, n, a, lda, ipiv, inf);
+			});
+		}
+
+		template<typename T, class SA, class SB>
+		inline void getrs_batched_(index_t nb, index_t n, index_t nrhs, char trans,
+				const SA& a, index_t lda, const lapack_int *ipiv, const SB& b, index_t ldb)
+		{
+			if (nb == 0) return;
+
+			lmat::internal::batched_lapack_engine<T>::getrs(nb, n, nrhs, trans != 'N' && trans != 'n',
+					a, lda, ipiv, b, ldb);
+		}
+
+		template<typename T, class SA, class SB>
+		inline void gesv_batched_(index_t nb, index_t n, index_t nrhs,
+				const SA& a, index_t lda, const SB& b, index_t ldb, lapack_int *info)
+		{
+			if (nb == 0) return;
+
+			run_batched("gesv", nb, info, [&](lapack_int *inf)
+			{
+				lmat::internal::batched_lapack_engine<T>::gesv(nb, n, nrhs, a, lda, b, ldb, inf);
+			});
+		}
+
+		template<typename T, class A>
+		inline void getrf_strided_batched_(A& a, lapack_int *ipiv, lapack_int *info)
+		{
+			const index_t n = a.nrows();
+			LMAT_CHECK_DIMS( n > 0 && a.ncolumns() % n == 0 );
+
+			getrf_batched_<T>(a.ncolumns() / n, n,
+					lmat::internal::strided_batch<T>(a.ptr_data(), n * a.col_stride()), a.col_stride(),
+					ipiv, info);
+		}
+
+		template<typename T, class A, class B>
+		inline void getrs_strided_batched_(const A& a, const lapack_int *ipiv, B& b, char trans)
+		{
+			const index_t n = a.nrows();
+			LMAT_CHECK_DIMS( n > 0 && a.ncolumns() % n == 0 && b.nrows() == n );
+
+			const index_t nb = a.ncolumns() / n;
+			LMAT_CHECK_DIMS( nb > 0 && b.ncolumns() % nb == 0 );
+
+			const index_t nrhs = b.ncolumns() / nb;
+			getrs_batched_<T>(nb, n, nrhs, trans,
+					lmat::internal::strided_batch<const T>(a.ptr_data(), n * a.col_stride()), a.col_stride(), ipiv,
+					lmat::internal::strided_batch<T>(b.ptr_data(), nrhs * b.col_stride()), b.col_stride());
+		}
+
+		template<typename T, class A, class B>
+		inline void gesv_strided_batched_(A& a, B& b, lapack_int *info)
+		{
+			const index_t n = a.nrows();
+			LMAT_CHECK_DIMS( n > 0 && a.ncolumns() % n == 0 && b.nrows() == n );
+
+			const index_t nb = a.ncolumns() / n;
+			LMAT_CHECK_DIMS( nb > 0 && b.ncolumns() % nb == 0 );
+
+			const index_t nrhs = b.ncolumns() / nb;
+			gesv_batched_<T>(nb, n, nrhs,
+					lmat::internal::strided_batch<T>(a.ptr_data(), n * a.col_stride()), a.col_stride(),
+					lmat::internal::strided_batch<T>(b.ptr_data(), nrhs * b.col_stride()), b.col_stride(), info);
+		}
 	}
 
-} }
+	// strided batches
 
+	template<class A>
+	inline void getrf_batched(IRegularMatrix<A, float>& a, lapack_int *ipiv, lapack_int *info=0)
+	{
+		LMAT_CHECK_PERCOL_CONT(A)
+		internal::getrf_strided_batched_<float>(a.derived(), ipiv, info);
+	}
 
-namespace lmat
-{
+	template<class A>
+	inline void getrf_batched(IRegularMatrix<A, double>& a, lapack_int *ipiv, lapack_int *info=0)
+	{
+		LMAT_CHECK_PERCOL_CONT(A)
+		internal::getrf_strided_batched_<double>(a.derived(), ipiv, info);
+	}
+
+	template<class A, class B>
+	inline void getrs_batched(const IRegularMatrix<A, float>& a, const lapack_int *ipiv,
+			IRegularMatrix<B, float>& b, char trans='N')
+	{
+		LMAT_CHECK_PERCOL_CONT(A)
+		LMAT_CHECK_PERCOL_CONT(B)
+		internal::getrs_strided_batched_<float>(a.derived(), ipiv, b.derived(), trans);
+	}
+
+	template<class A, class B>
+	inline void getrs_batched(const IRegularMatrix<A, double>& a, const lapack_int *ipiv,
+			IRegularMatrix<B, double>& b, char trans='N')
+	{
+		LMAT_CHECK_PERCOL_CONT(A)
+		LMAT_CHECK_PERCOL_CONT(B)
+		internal::getrs_strided_batched_<double>(a.derived(), ipiv, b.derived(), trans);
+	}
+
+	template<class A, class B>
+	inline void gesv_batched(IRegularMatrix<A, float>& a, IRegularMatrix<B, float>& b, lapack_int *info=0)
+	{
+		LMAT_CHECK_PERCOL_CONT(A)
+		LMAT_CHECK_PERCOL_CONT(B)
+		internal::gesv_strided_batched_<float>(a.derived(), b.derived(), info);
+	}
+
+	template<class A, class B>
+	inline void gesv_batched(IRegularMatrix<A, double>& a, IRegularMatrix<B, double>& b, lapack_int *info=0)
+	{
+		LMAT_CHECK_PERCOL_CONT(A)
+		LMAT_CHECK_PERCOL_CONT(B)
+		internal::gesv_strided_batched_<double>(a.derived(), b.derived(), info);
+	}
+
+	// pointer arrays: the l-th system is at a[l] and b[l]
+
+	inline void getrf_batched(index_t nbatch, index_t n, float* const* a, index_t lda,
+			lapack_int *ipiv, lapack_int *info=0)
+	{
+		internal::getrf_batched_<float>(nbatch, n,
+				lmat::internal::pointer_batch<float>(a), lda, ipiv, info);
+	}
+
+	inline void getrf_batched(index_t nbatch, index_t n, double* const* a, index_t lda,
+			lapack_int *ipiv, lapack_int *info=0)
+	{
+		internal::getrf_batched_<double>(nbatch, n,
+				lmat::internal::pointer_batch<double>(a), lda, ipiv, info);
+	}
+
+	inline void getrs_batched(index_t nbatch, index_t n, index_t nrhs,
+			const float* const* a, index_t lda, const lapack_int *ipiv,
+			float* const* b, index_t ldb, char trans='N')
+	{
+		internal::getrs_batched_<float>(nbatch, n, nrhs, trans,
+				lmat::internal::pointer_batch<const float>(a), lda, ipiv,
+				lmat::internal::pointer_batch<float>(b), ldb);
+	}
+
+	inline void getrs_batched(index_t nbatch, index_t n, index_t nrhs,
+			const double* const* a, index_t lda, const lapack_int *ipiv,
+			double* const* b, index_t ldb, char trans='N')
+	{
+		internal::getrs_batched_<double>(nbatch, n, nrhs, trans,
+				lmat::internal::pointer_batch<const double>(a), lda, ipiv,
+				lmat::internal::pointer_batch<double>(b), ldb);
+	}
+
+	inline void gesv_batched(index_t nbatch, index_t n, index_t nrhs,
+			float* const* a, index_t lda, float* const* b, index_t ldb, lapack_int *info=0)
+	{
+		internal::gesv_batched_<float>(nbatch, n, nrhs,
+				lmat::internal::pointer_batch<float>(a), lda,
+				lmat::internal::pointer_batch<float>(b), ldb, info);
+	}
+
+	inline void gesv_batched(index_t nbatch, index_t n, index_t nrhs,
+			double* const* a, index_t lda, double* const* b, index_t ldb, lapack_int *info=0)
+	{
+		internal::gesv_batched_<double>(nbatch, n, nrhs,
+				lmat::internal::pointer_batch<double>(a), lda,
+				lmat::internal::pointer_batch<double>(b), ldb, info);
+	}
+
+} LMAT_END_NAMESPACE
+
+
+LMAT_BEGIN_NAMESPACE
 
 	template<class Arg> class inv_expr;
 
@@ -478,7 +834,7 @@ namespace lmat
 		return inv_expr<Arg>(a.derived());
 	}
 
-}
+LMAT_END_NAMESPACE
 
 
 #endif /* LAPACK_LU_H_ */
@@ -61,7 +61,7 @@ extern "C"
 }
 
 
-namespace lmat { namespace lapack {
+LMAT_BEGIN_NAMESPACE namespace lapack {
 
 	// forward declaration
 
@@ -140,7 +140,7 @@ namespace lmat { namespace lapack {
 			m_nrows = m_a.nrows();
 			m_ncols = m_a.ncolumns();
 
-			index_t ltau = math::max(1, math::min(m_nrows, m_ncols));
+			index_t ltau = math::max(index_t(1), math::min(m_nrows, m_ncols));
 			m_tau.require_size(ltau);
 		}
 
@@ -178,8 +178,21 @@ namespace lmat { namespace lapack {
 			set(mat);
 		}
 
+		template<class Mat>
+		qr_fac(const IMatrixXpr<Mat, float>& mat, workspace& ws)
+		{
+			set(mat, ws);
+		}
+
 		template<class Mat>
 		void set(const IMatrixXpr<Mat, float>& mat)
+		{
+			workspace ws;
+			set(mat, ws);
+		}
+
+		template<class Mat>
+		void set(const IMatrixXpr<Mat, float>& mat, workspace& ws)
 		{
 			this->set_mat(mat);
 
@@ -189,20 +202,32 @@ namespace lmat { namespace lapack {
 
 			lapack_int info = 0;
 			lapack_int lwork = -1;
-			float lwork_opt = 0;
+			lapack_int liwork = 0;
 
-			LMAT_CALL_LAPACK(sgeqrf, (&m, &n, this->m_a.ptr_data(), &lda, this->m_tau.ptr_data(),
-					&lwork_opt, &lwork, &info));
+			workspace::key qk("sgeqrf", m, n);
+			if (!ws.find(qk, lwork, liwork))
+			{
+				float lwork_opt = 0;
+				LMAT_CALL_LAPACK(sgeqrf, (&m, &n, this->m_a.ptr_data(), &lda, this->m_tau.ptr_data(),
+						&lwork_opt, &lwork, &info));
 
-			lwork = (lapack_int)lwork_opt;
-			dense_col<float> ws((index_t)lwork);
+				lwork = (lapack_int)lwork_opt;
+				ws.put(qk, lwork, liwork);
+			}
 
 			LMAT_CALL_LAPACK(sgeqrf, (&m, &n, this->m_a.ptr_data(), &lda, this->m_tau.ptr_data(),
-					ws.ptr_data(), &lwork, &info));
+					ws.work<float>(lwork), &lwork, &info));
 		}
 
 		template<class Q>
 		void getq(IRegularMatrix<Q, float>& q, index_t nc=-1) const  // q : m x nc
+		{
+			workspace ws;
+			getq(q, ws, nc);
+		}
+
+		template<class Q>
+		void getq(IRegularMatrix<Q, float>& q, workspace& ws, index_t nc=-1) const
 		{
 			LMAT_CHECK_PERCOL_CONT(Q)
 
@@ -215,22 +240,34 @@ namespace lmat { namespace lapack {
 			lapack_int ldq = (lapack_int)q.col_stride();
 
 			lapack_int lwork = -1;
-			float lwork_opt = 0;
+			lapack_int liwork = 0;
 			lapack_int info = 0;
 
-			LMAT_CALL_LAPACK(sorgqr, (&m, &n, &k, q.ptr_data(), &ldq,
-					this->m_tau.ptr_data(), &lwork_opt, &lwork, &info));
+			workspace::key qk("sorgqr", m, n, k);
+			if (!ws.find(qk, lwork, liwork))
+			{
+				float lwork_opt = 0;
+				LMAT_CALL_LAPACK(sorgqr, (&m, &n, &k, q.ptr_data(), &ldq,
+						this->m_tau.ptr_data(), &lwork_opt, &lwork, &info));
 
-			lwork = (lapack_int)lwork_opt;
-			dense_col<float> ws((index_t)lwork);
+				lwork = (lapack_int)lwork_opt;
+				ws.put(qk, lwork, liwork);
+			}
 
 			LMAT_CALL_LAPACK(sorgqr, (&m, &n, &k, q.ptr_data(), &ldq,
-					this->m_tau.ptr_data(), ws.ptr_data(), &lwork, &info));
+					this->m_tau.ptr_data(), ws.work<float>(lwork), &lwork, &info));
 		}
 
 
 		template<class X>
 		void multq_inplace(IRegularMatrix<X, float>& x, char trans='N', char side='L') const
+		{
+			workspace ws;
+			multq_inplace(x, ws, trans, side);
+		}
+
+		template<class X>
+		void multq_inplace(IRegularMatrix<X, float>& x, workspace& ws, char trans='N', char side='L') const
 		{
 			LMAT_CHECK_PERCOL_CONT(X)
 			LMAT_CHECK_DIMS( this->check_multq_dims(side, x.nrows(), x.ncolumns()) )
@@ -242,36 +279,55 @@ namespace lmat { namespace lapack {
 			lapack_int ldx = (lapack_int)x.col_stride();
 
 			lapack_int lwork = -1;
-			float lwork_opt = 0;
+			lapack_int liwork = 0;
 			lapack_int info = 0;
 
-			LMAT_CALL_LAPACK(sormqr, (&side, &trans, &m, &n, &k, this->m_a.ptr_data(), &lda,
-					this->m_tau.ptr_data(), x.ptr_data(), &ldx, &lwork_opt, &lwork, &info));
+			workspace::key qk("sormqr", side, trans, m, n, k);
+			if (!ws.find(qk, lwork, liwork))
+			{
+				float lwork_opt = 0;
+				LMAT_CALL_LAPACK(sormqr, (&side, &trans, &m, &n, &k, this->m_a.ptr_data(), &lda,
+						this->m_tau.ptr_data(), x.ptr_data(), &ldx, &lwork_opt, &lwork, &info));
 
-			lwork = (lapack_int)lwork_opt;
-			dense_col<float> ws((index_t)lwork);
+				lwork = (lapack_int)lwork_opt;
+				ws.put(qk, lwork, liwork);
+			}
 
 			LMAT_CALL_LAPACK(sormqr, (&side, &trans, &m, &n, &k, this->m_a.ptr_data(), &lda,
-					this->m_tau.ptr_data(), x.ptr_data(), &ldx, ws.ptr_data(), &lwork, &info));
+					this->m_tau.ptr_data(), x.ptr_data(), &ldx, ws.work<float>(lwork), &lwork, &info));
 		}
 
 		template<class X, class Y>
 		void multq(const IMatrixXpr<X, float>& x, IRegularMatrix<Y, float>& y, char trans='N', char side='L') const
+		{
+			workspace ws;
+			multq(x, y, ws, trans, side);
+		}
+
+		template<class X, class Y>
+		void multq(const IMatrixXpr<X, float>& x, IRegularMatrix<Y, float>& y, workspace& ws, char trans='N', char side='L') const
 		{
 			LMAT_CHECK_PERCOL_CONT(Y)
 			y.derived() = x.derived();
-			multq_inplace(y, trans, side);
+			multq_inplace(y, ws, trans, side);
 		}
 
 		template<class X>
 		void solve_inplace(IRegularMatrix<X, float>& x) const // require: m >= n
+		{
+			workspace ws;
+			solve_inplace(x, ws);
+		}
+
+		template<class X>
+		void solve_inplace(IRegularMatrix<X, float>& x, workspace& ws) const
 		{
 			LMAT_CHECK_PERCOL_CONT(X)
 
 			check_arg(this->m_nrows >= this->m_ncols, "QR-solve only applies when m >= n");
 			LMAT_CHECK_DIMS( x.nrows() == this->m_nrows );
 
-			multq_inplace(x, 'T', 'L');
+			multq_inplace(x, ws, 'T', 'L');
 
 			char side = 'L';
 			char uplo = 'U';
@@ -290,12 +346,19 @@ namespace lmat { namespace lapack {
 
 		template<class X, class B>
 		void solve(const IMatrixXpr<X, float>& x, IRegularMatrix<B, float>& b) const
+		{
+			workspace ws;
+			solve(x, b, ws);
+		}
+
+		template<class X, class B>
+		void solve(const IMatrixXpr<X, float>& x, IRegularMatrix<B, float>& b, workspace& ws) const
 		{
 			LMAT_CHECK_PERCOL_CONT(B)
 			LMAT_CHECK_DIMS( x.nrows() == this->m_nrows );
 
 			dense_matrix<float> x_(x);
-			solve_inplace(x_);
+			solve_inplace(x_, ws);
 
 			b.derived() = x_(range(0, this->m_ncols), whole());
 		}
@@ -314,8 +377,21 @@ namespace lmat { namespace lapack {
 			set(mat);
 		}
 
+		template<class Mat>
+		qr_fac(const IMatrixXpr<Mat, double>& mat, workspace& ws)
+		{
+			set(mat, ws);
+		}
+
 		template<class Mat>
 		void set(const IMatrixXpr<Mat, double>& mat)
+		{
+			workspace ws;
+			set(mat, ws);
+		}
+
+		template<class Mat>
+		void set(const IMatrixXpr<Mat, double>& mat, workspace& ws)
 		{
 			this->set_mat(mat);
 
@@ -325,20 +401,32 @@ namespace lmat { namespace lapack {
 
 			lapack_int info = 0;
 			lapack_int lwork = -1;
-			double lwork_opt = 0;
+			lapack_int liwork = 0;
 
-			LMAT_CALL_LAPACK(dgeqrf, (&m, &n, this->m_a.ptr_data(), &lda, this->m_tau.ptr_data(),
-					&lwork_opt, &lwork, &info));
+			workspace::key qk("dgeqrf", m, n);
+			if (!ws.find(qk, lwork, liwork))
+			{
+				double lwork_opt = 0;
+				LMAT_CALL_LAPACK(dgeqrf, (&m, &n, this->m_a.ptr_data(), &lda, this->m_tau.ptr_data(),
+						&lwork_opt, &lwork, &info));
 
-			lwork = (lapack_int)lwork_opt;
-			dense_col<double> ws((index_t)lwork);
+				lwork = (lapack_int)lwork_opt;
+				ws.put(qk, lwork, liwork);
+			}
 
 			LMAT_CALL_LAPACK(dgeqrf, (&m, &n, this->m_a.ptr_data(), &lda, this->m_tau.ptr_data(),
-					ws.ptr_data(), &lwork, &info));
+					ws.work<double>(lwork), &lwork, &info));
 		}
 
 		template<class Q>
 		void getq(IRegularMatrix<Q, double>& q, index_t nc=-1) const  // q: m x nc
+		{
+			workspace ws;
+			getq(q, ws, nc);
+		}
+
+		template<class Q>
+		void getq(IRegularMatrix<Q, double>& q, workspace& ws, index_t nc=-1) const
 		{
 			LMAT_CHECK_PERCOL_CONT(Q)
 
@@ -351,21 +439,33 @@ namespace lmat { namespace lapack {
 			lapack_int ldq = (lapack_int)q.col_stride();
 
 			lapack_int lwork = -1;
-			double lwork_opt = 0;
+			lapack_int liwork = 0;
 			lapack_int info = 0;
 
-			LMAT_CALL_LAPACK(dorgqr, (&m, &n, &k, q.ptr_data(), &ldq,
-					this->m_tau.ptr_data(), &lwork_opt, &lwork, &info));
+			workspace::key qk("dorgqr", m, n, k);
+			if (!ws.find(qk, lwork, liwork))
+			{
+				double lwork_opt = 0;
+				LMAT_CALL_LAPACK(dorgqr, (&m, &n, &k, q.ptr_data(), &ldq,
+						this->m_tau.ptr_data(), &lwork_opt, &lwork, &info));
 
-			lwork = (lapack_int)lwork_opt;
-			dense_col<double> ws((index_t)lwork);
+				lwork = (lapack_int)lwork_opt;
+				ws.put(qk, lwork, liwork);
+			}
 
 			LMAT_CALL_LAPACK(dorgqr, (&m, &n, &k, q.ptr_data(), &ldq,
-					this->m_tau.ptr_data(), ws.ptr_data(), &lwork, &info));
+					this->m_tau.ptr_data(), ws.work<double>(lwork), &lwork, &info));
 		}
 
 		template<class X>
 		void multq_inplace(IRegularMatrix<X, double>& x, char trans='N', char side='L') const
+		{
+			workspace ws;
+			multq_inplace(x, ws, trans, side);
+		}
+
+		template<class X>
+		void multq_inplace(IRegularMatrix<X, double>& x, workspace& ws, char trans='N', char side='L') const
 		{
 			LMAT_CHECK_PERCOL_CONT(X)
 			LMAT_CHECK_DIMS( this->check_multq_dims(side, x.nrows(), x.ncolumns()) )
@@ -377,36 +477,55 @@ namespace lmat { namespace lapack {
 			lapack_int ldx = (lapack_int)x.col_stride();
 
 			lapack_int lwork = -1;
-			double lwork_opt = 0;
+			lapack_int liwork = 0;
 			lapack_int info = 0;
 
-			LMAT_CALL_LAPACK(dormqr, (&side, &trans, &m, &n, &k, this->m_a.ptr_data(), &lda,
-					this->m_tau.ptr_data(), x.ptr_data(), &ldx, &lwork_opt, &lwork, &info));
+			workspace::key qk("dormqr", side, trans, m, n, k);
+			if (!ws.find(qk, lwork, liwork))
+			{
+				double lwork_opt = 0;
+				LMAT_CALL_LAPACK(dormqr, (&side, &trans, &m, &n, &k, this->m_a.ptr_data(), &lda,
+						this->m_tau.ptr_data(), x.ptr_data(), &ldx, &lwork_opt, &lwork, &info));
 
-			lwork = (lapack_int)lwork_opt;
-			dense_col<double> ws((index_t)lwork);
+				lwork = (lapack_int)lwork_opt;
+				ws.put(qk, lwork, liwork);
+			}
 
 			LMAT_CALL_LAPACK(dormqr, (&side, &trans, &m, &n, &k, this->m_a.ptr_data(), &lda,
-					this->m_tau.ptr_data(), x.ptr_data(), &ldx, ws.ptr_data(), &lwork, &info));
+					this->m_tau.ptr_data(), x.ptr_data(), &ldx, ws.work<double>(lwork), &lwork, &info));
 		}
 
 		template<class X, class Y>
 		void multq(const IMatrixXpr<X, double>& x, IRegularMatrix<Y, double>& y, char trans='N', char side='L') const
+		{
+			workspace ws;
+			multq(x, y, ws, trans, side);
+		}
+
+		template<class X, class Y>
+		void multq(const IMatrixXpr<X, double>& x, IRegularMatrix<Y, double>& y, workspace& ws, char trans='N', char side='L') const
 		{
 			LMAT_CHECK_PERCOL_CONT(Y)
 			y.derived() = x.derived();
-			multq_inplace(y, trans, side);
+			multq_inplace(y, ws, trans, side);
 		}
 
 		template<class X>
 		void solve_inplace(IRegularMatrix<X, double>& x) const // require: m >= n
+		{
+			workspace ws;
+			solve_inplace(x, ws);
+		}
+
+		template<class X>
+		void solve_inplace(IRegularMatrix<X, double>& x, workspace& ws) const
 		{
 			LMAT_CHECK_PERCOL_CONT(X)
 
 			check_arg(this->m_nrows >= this->m_ncols, "QR-solve only applies when m >= n");
 			LMAT_CHECK_DIMS( x.nrows() == this->m_nrows );
 
-			multq_inplace(x, 'T', 'L');
+			multq_inplace(x, ws, 'T', 'L');
 
 			char side = 'L';
 			char uplo = 'U';
@@ -425,12 +544,19 @@ namespace lmat { namespace lapack {
 
 		template<class X, class B>
 		void solve(const IMatrixXpr<X, double>& x, IRegularMatrix<B, double>& b) const
+		{
+			workspace ws;
+			solve(x, b, ws);
+		}
+
+		template<class X, class B>
+		void solve(const IMatrixXpr<X, double>& x, IRegularMatrix<B, double>& b, workspace& ws) const
 		{
 			LMAT_CHECK_PERCOL_CONT(B)
 			LMAT_CHECK_DIMS( x.nrows() == this->m_nrows );
 
 			dense_matrix<double> x_(x);
-			solve_inplace(x_);
+			solve_inplace(x_, ws);
 
 			b.derived() = x_(range(0, this->m_ncols), whole());
 		}
@@ -438,6 +564,6 @@ namespace lmat { namespace lapack {
 	};
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif /* LAPACK_QR_H_ */
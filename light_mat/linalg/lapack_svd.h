@@ -39,7 +39,7 @@ extern "C"
 }
 
 
-namespace lmat { namespace lapack {
+LMAT_BEGIN_NAMESPACE namespace lapack {
 
 	namespace internal
 	{
@@ -66,7 +66,7 @@ namespace lmat { namespace lapack {
 		template<class A, class S, class U, class VT>
 		inline void _gesvd(IRegularMatrix<A, float>& a, IRegularMatrix<S, float>& s,
 				IRegularMatrix<U, float>& u, IRegularMatrix<VT, float>& vt,
-				char jobu, char jobvt)
+				char jobu, char jobvt, workspace& ws)
 		{
 			lapack_int m = (lapack_int)a.nrows();
 			lapack_int n = (lapack_int)a.ncolumns();
@@ -78,26 +78,31 @@ namespace lmat { namespace lapack {
 			if (ldu <= 0) ldu = 1;
 			if (ldvt <= 0) ldvt = 1;
 
-			float lwork_opt = 0;
 			lapack_int lwork = -1;
+			lapack_int liwork = 0;
 			lapack_int info = 0;
 
-			LMAT_CALL_LAPACK(sgesvd, (&jobu, &jobvt, &m, &n, a.ptr_data(), &lda,
-					s.ptr_data(), u.ptr_data(), &ldu, vt.ptr_data(), &ldvt,
-					&lwork_opt, &lwork, &info));
+			workspace::key qk("sgesvd", jobu, jobvt, m, n);
+			if (!ws.find(qk, lwork, liwork))
+			{
+				float lwork_opt = 0;
+				LMAT_CALL_LAPACK(sgesvd, (&jobu, &jobvt, &m, &n, a.ptr_data(), &lda,
+						s.ptr_data(), u.ptr_data(), &ldu, vt.ptr_data(), &ldvt,
+						&lwork_opt, &lwork, &info));
 
-			lwork = (lapack_int)lwork_opt;
-			dense_col<float> ws((index_t)lwork);
+				lwork = (lapack_int)lwork_opt;
+				ws.put(qk, lwork, liwork);
+			}
 
 			LMAT_CALL_LAPACK(sgesvd, (&jobu, &jobvt, &m, &n, a.ptr_data(), &lda,
 					s.ptr_data(), u.ptr_data(), &ldu, vt.ptr_data(), &ldvt,
-					ws.ptr_data(), &lwork, &info));
+					ws.work<float>(lwork), &lwork, &info));
 		}
 
 		template<class A, class S, class U, class VT>
 		inline void _gesvd(IRegularMatrix<A, double>& a, IRegularMatrix<S, double>& s,
 				IRegularMatrix<U, double>& u, IRegularMatrix<VT, double>& vt,
-				char jobu, char jobvt)
+				char jobu, char jobvt, workspace& ws)
 		{
 			lapack_int m = (lapack_int)a.nrows();
 			lapack_int n = (lapack_int)a.ncolumns();
@@ -109,25 +114,30 @@ namespace lmat { namespace lapack {
 			if (ldu <= 0) ldu = 1;
 			if (ldvt <= 0) ldvt = 1;
 
-			double lwork_opt = 0;
 			lapack_int lwork = -1;
+			lapack_int liwork = 0;
 			lapack_int info = 0;
 
-			LMAT_CALL_LAPACK(dgesvd, (&jobu, &jobvt, &m, &n, a.ptr_data(), &lda,
-					s.ptr_data(), u.ptr_data(), &ldu, vt.ptr_data(), &ldvt,
-					&lwork_opt, &lwork, &info));
+			workspace::key qk("dgesvd", jobu, jobvt, m, n);
+			if (!ws.find(qk, lwork, liwork))
+			{
+				double lwork_opt = 0;
+				LMAT_CALL_LAPACK(dgesvd, (&jobu, &jobvt, &m, &n, a.ptr_data(), &lda,
+						s.ptr_data(), u.ptr_data(), &ldu, vt.ptr_data(), &ldvt,
+						&lwork_opt, &lwork, &info));
 
-			lwork = (lapack_int)lwork_opt;
-			dense_col<double> ws((index_t)lwork);
+				lwork = (lapack_int)lwork_opt;
+				ws.put(qk, lwork, liwork);
+			}
 
 			LMAT_CALL_LAPACK(dgesvd, (&jobu, &jobvt, &m, &n, a.ptr_data(), &lda,
 					s.ptr_data(), u.ptr_data(), &ldu, vt.ptr_data(), &ldvt,
-					ws.ptr_data(), &lwork, &info));
+					ws.work<double>(lwork), &lwork, &info));
 		}
 
 
 		template<typename T, class A, class S>
-		inline void _gesvd_(const IMatrixXpr<A, T>& a, IRegularMatrix<S, T>& s)
+		inline void _gesvd_(const IMatrixXpr<A, T>& a, IRegularMatrix<S, T>& s, workspace& ws)
 		{
 			LMAT_CHECK_WHOLE_CONT(S)
 
@@ -141,13 +151,13 @@ namespace lmat { namespace lapack {
 
 			dense_matrix<T> u;
 			dense_matrix<T> vt;
-			_gesvd(a_, s, u, vt, 'N', 'N');
+			_gesvd(a_, s, u, vt, 'N', 'N', ws);
 		}
 
 		template<typename T, class A, class S, class U, class VT>
 		inline void _gesvd_(const IMatrixXpr<A, T>& a, IRegularMatrix<S, T>& s,
 				IRegularMatrix<U, T>& u, IRegularMatrix<VT, T>& vt,
-				char jobu, char jobvt)
+				char jobu, char jobvt, workspace& ws)
 		{
 			LMAT_CHECK_PERCOL_CONT(U)
 			LMAT_CHECK_PERCOL_CONT(VT)
@@ -174,7 +184,7 @@ namespace lmat { namespace lapack {
 			else if (jobvt == 'S')
 				vt.require_size(rk, n);
 
-			_gesvd(a_, s, u, vt, jobu, jobvt);
+			_gesvd(a_, s, u, vt, jobu, jobvt, ws);
 		}
 
 	}
@@ -183,27 +193,57 @@ namespace lmat { namespace lapack {
 	template<class A, class S>
 	inline void gesvd(const IMatrixXpr<A, float>& a, IRegularMatrix<S, float>& s)
 	{
-		internal::_gesvd_(a, s);
+		workspace ws;
+		gesvd(a, s, ws);
+	}
+
+	template<class A, class S>
+	inline void gesvd(const IMatrixXpr<A, float>& a, IRegularMatrix<S, float>& s, workspace& ws)
+	{
+		internal::_gesvd_(a, s, ws);
 	}
 
 	template<class A, class S>
 	inline void gesvd(const IMatrixXpr<A, double>& a, IRegularMatrix<S, double>& s)
 	{
-		internal::_gesvd_(a, s);
+		workspace ws;
+		gesvd(a, s, ws);
+	}
+
+	template<class A, class S>
+	inline void gesvd(const IMatrixXpr<A, double>& a, IRegularMatrix<S, double>& s, workspace& ws)
+	{
+		internal::_gesvd_(a, s, ws);
 	}
 
 	template<class A, class S, class U, class VT>
 	inline void gesvd(const IMatrixXpr<A, float>& a, IRegularMatrix<S, float>& s,
 			IRegularMatrix<U, float>& u, IRegularMatrix<VT, float>& vt, char jobu ='A', char jobvt='A')
 	{
-		internal::_gesvd_(a, s, u, vt, jobu, jobvt);
+		workspace ws;
+		gesvd(a, s, u, vt, ws, jobu, jobvt);
+	}
+
+	template<class A, class S, class U, class VT>
+	inline void gesvd(const IMatrixXpr<A, float>& a, IRegularMatrix<S, float>& s,
+			IRegularMatrix<U, float>& u, IRegularMatrix<VT, float>& vt, workspace& ws, char jobu ='A', char jobvt='A')
+	{
+		internal::_gesvd_(a, s, u, vt, jobu, jobvt, ws);
 	}
 
 	template<class A, class S, class U, class VT>
 	inline void gesvd(const IMatrixXpr<A, double>& a, IRegularMatrix<S, double>& s,
 			IRegularMatrix<U, double>& u, IRegularMatrix<VT, double>& vt, char jobu ='A', char jobvt='A')
 	{
-		internal::_gesvd_(a, s, u, vt, jobu, jobvt);
+		workspace ws;
+		gesvd(a, s, u, vt, ws, jobu, jobvt);
+	}
+
+	template<class A, class S, class U, class VT>
+	inline void gesvd(const IMatrixXpr<A, double>& a, IRegularMatrix<S, double>& s,
+			IRegularMatrix<U, double>& u, IRegularMatrix<VT, double>& vt, workspace& ws, char jobu ='A', char jobvt='A')
+	{
+		internal::_gesvd_(a, s, u, vt, jobu, jobvt, ws);
 	}
 
 
@@ -217,7 +257,7 @@ namespace lmat { namespace lapack {
 	{
 		template<class A, class S, class U, class VT>
 		inline void _gesdd(IRegularMatrix<A, float>& a, IRegularMatrix<S, float>& s,
-				IRegularMatrix<U, float>& u, IRegularMatrix<VT, float>& vt, char jobz)
+				IRegularMatrix<U, float>& u, IRegularMatrix<VT, float>& vt, char jobz, workspace& ws)
 		{
 			lapack_int m = (lapack_int)a.nrows();
 			lapack_int n = (lapack_int)a.ncolumns();
@@ -229,27 +269,31 @@ namespace lmat { namespace lapack {
 			if (ldu <= 0) ldu = 1;
 			if (ldvt <= 0) ldvt = 1;
 
-			float lwork_opt = 0;
 			lapack_int lwork = -1;
+			lapack_int liwork = 8 * math::max(lapack_int(1), math::min(m, n));
 			lapack_int info = 0;
 
-			index_t iws_len = 8 * math::max(1, math::min(m, n));
-			dense_col<lapack_int> iws(iws_len);
+			lapack_int *iws = ws.iwork(liwork);
 
-			LMAT_CALL_LAPACK(sgesdd, (&jobz, &m, &n, a.ptr_data(), &lda, s.ptr_data(), u.ptr_data(), &ldu,
-					vt.ptr_data(), &ldvt, &lwork_opt, &lwork, iws.ptr_data(), &info));
+			workspace::key qk("sgesdd", jobz, m, n);
+			if (!ws.find(qk, lwork, liwork))
+			{
+				float lwork_opt = 0;
+				LMAT_CALL_LAPACK(sgesdd, (&jobz, &m, &n, a.ptr_data(), &lda, s.ptr_data(), u.ptr_data(), &ldu,
+						vt.ptr_data(), &ldvt, &lwork_opt, &lwork, iws, &info));
 
-			lwork = (lapack_int)lwork_opt;
-			dense_col<float> ws((index_t)lwork);
+				lwork = (lapack_int)lwork_opt;
+				ws.put(qk, lwork, liwork);
+			}
 
 			LMAT_CALL_LAPACK(sgesdd, (&jobz, &m, &n, a.ptr_data(), &lda, s.ptr_data(), u.ptr_data(), &ldu,
-					vt.ptr_data(), &ldvt, ws.ptr_data(), &lwork, iws.ptr_data(), &info));
+					vt.ptr_data(), &ldvt, ws.work<float>(lwork), &lwork, iws, &info));
 		}
 
 
 		template<class A, class S, class U, class VT>
 		inline void _gesdd(IRegularMatrix<A, double>& a, IRegularMatrix<S, double>& s,
-				IRegularMatrix<U, double>& u, IRegularMatrix<VT, double>& vt, char jobz)
+				IRegularMatrix<U, double>& u, IRegularMatrix<VT, double>& vt, char jobz, workspace& ws)
 		{
 			lapack_int m = (lapack_int)a.nrows();
 			lapack_int n = (lapack_int)a.ncolumns();
@@ -261,26 +305,30 @@ namespace lmat { namespace lapack {
 			if (ldu <= 0) ldu = 1;
 			if (ldvt <= 0) ldvt = 1;
 
-			double lwork_opt = 0;
 			lapack_int lwork = -1;
+			lapack_int liwork = 8 * math::max(lapack_int(1), math::min(m, n));
 			lapack_int info = 0;
 
-			index_t iws_len = 8 * math::max(1, math::min(m, n));
-			dense_col<lapack_int> iws(iws_len);
+			lapack_int *iws = ws.iwork(liwork);
 
-			LMAT_CALL_LAPACK(dgesdd, (&jobz, &m, &n, a.ptr_data(), &lda, s.ptr_data(), u.ptr_data(), &ldu,
-					vt.ptr_data(), &ldvt, &lwork_opt, &lwork, iws.ptr_data(), &info));
+			workspace::key qk("dgesdd", jobz, m, n);
+			if (!ws.find(qk, lwork, liwork))
+			{
+				double lwork_opt = 0;
+				LMAT_CALL_LAPACK(dgesdd, (&jobz, &m, &n, a.ptr_data(), &lda, s.ptr_data(), u.ptr_data(), &ldu,
+						vt.ptr_data(), &ldvt, &lwork_opt, &lwork, iws, &info));
 
-			lwork = (lapack_int)lwork_opt;
-			dense_col<double> ws((index_t)lwork);
+				lwork = (lapack_int)lwork_opt;
+				ws.put(qk, lwork, liwork);
+			}
 
 			LMAT_CALL_LAPACK(dgesdd, (&jobz, &m, &n, a.ptr_data(), &lda, s.ptr_data(), u.ptr_data(), &ldu,
-					vt.ptr_data(), &ldvt, ws.ptr_data(), &lwork, iws.ptr_data(), &info));
+					vt.ptr_data(), &ldvt, ws.work<double>(lwork), &lwork, iws, &info));
 		}
 
 
 		template<typename T, class A, class S>
-		inline void _gesdd_(const IMatrixXpr<A, T>& a, IRegularMatrix<S, T>& s)
+		inline void _gesdd_(const IMatrixXpr<A, T>& a, IRegularMatrix<S, T>& s, workspace& ws)
 		{
 			LMAT_CHECK_WHOLE_CONT(S)
 
@@ -294,12 +342,12 @@ namespace lmat { namespace lapack {
 
 			dense_matrix<T> u;
 			dense_matrix<T> vt;
-			_gesdd(a_, s, u, vt, 'N');
+			_gesdd(a_, s, u, vt, 'N', ws);
 		}
 
 		template<typename T, class A, class S, class U, class VT>
 		inline void _gesdd_(const IMatrixXpr<A, T>& a, IRegularMatrix<S, T>& s,
-				IRegularMatrix<U, T>& u, IRegularMatrix<VT, T>& vt, char jobz)
+				IRegularMatrix<U, T>& u, IRegularMatrix<VT, T>& vt, char jobz, workspace& ws)
 		{
 			LMAT_CHECK_PERCOL_CONT(U)
 			LMAT_CHECK_PERCOL_CONT(VT)
@@ -326,7 +374,7 @@ namespace lmat { namespace lapack {
 				vt.require_size(rk, n);
 			}
 
-			_gesdd(a_, s, u, vt, jobz);
+			_gesdd(a_, s, u, vt, jobz, ws);
 		}
 
 	}
@@ -335,31 +383,61 @@ namespace lmat { namespace lapack {
 	template<class A, class S>
 	inline void gesdd(const IMatrixXpr<A, float>& a, IRegularMatrix<S, float>& s)
 	{
-		internal::_gesdd_(a, s);
+		workspace ws;
+		gesdd(a, s, ws);
+	}
+
+	template<class A, class S>
+	inline void gesdd(const IMatrixXpr<A, float>& a, IRegularMatrix<S, float>& s, workspace& ws)
+	{
+		internal::_gesdd_(a, s, ws);
 	}
 
 	template<class A, class S>
 	inline void gesdd(const IMatrixXpr<A, double>& a, IRegularMatrix<S, double>& s)
 	{
-		internal::_gesdd_(a, s);
+		workspace ws;
+		gesdd(a, s, ws);
+	}
+
+	template<class A, class S>
+	inline void gesdd(const IMatrixXpr<A, double>& a, IRegularMatrix<S, double>& s, workspace& ws)
+	{
+		internal::_gesdd_(a, s, ws);
 	}
 
 	template<class A, class S, class U, class VT>
 	inline void gesdd(const IMatrixXpr<A, float>& a, IRegularMatrix<S, float>& s,
 			IRegularMatrix<U, float>& u, IRegularMatrix<VT, float>& vt, char jobz ='A')
 	{
-		internal::_gesdd_(a, s, u, vt, jobz);
+		workspace ws;
+		gesdd(a, s, u, vt, ws, jobz);
+	}
+
+	template<class A, class S, class U, class VT>
+	inline void gesdd(const IMatrixXpr<A, float>& a, IRegularMatrix<S, float>& s,
+			IRegularMatrix<U, float>& u, IRegularMatrix<VT, float>& vt, workspace& ws, char jobz ='A')
+	{
+		internal::_gesdd_(a, s, u, vt, jobz, ws);
 	}
 
 	template<class A, class S, class U, class VT>
 	inline void gesdd(const IMatrixXpr<A, double>& a, IRegularMatrix<S, double>& s,
 			IRegularMatrix<U, double>& u, IRegularMatrix<VT, double>& vt, char jobz='A')
 	{
-		internal::_gesdd_(a, s, u, vt, jobz);
+		workspace ws;
+		gesdd(a, s, u, vt, ws, jobz);
+	}
+
+	template<class A, class S, class U, class VT>
+	inline void gesdd(const IMatrixXpr<A, double>& a, IRegularMatrix<S, double>& s,
+			IRegularMatrix<U, double>& u, IRegularMatrix<VT, double>& vt, workspace& ws, char jobz='A')
+	{
+		internal::_gesdd_(a, s, u, vt, jobz, ws);
 	}
 
 
-} }
+} LMAT_END_NAMESPACE
 
 
 #endif /* LAPACK_SVD_H_ */
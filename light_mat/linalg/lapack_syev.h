@@ -65,7 +65,7 @@ extern "C"
 }
 
 
-namespace lmat { namespace lapack {
+LMAT_BEGIN_NAMESPACE namespace lapack {
 
 
 	/********************************************
@@ -133,55 +133,70 @@ namespace lmat { namespace lapack {
 	namespace internal
 	{
 		template<class A, class W>
-		inline void _syev(IRegularMatrix<A, float>& a, IRegularMatrix<W, float>& w, char jobz, char uplo)
+		inline void _syev(IRegularMatrix<A, float>& a, IRegularMatrix<W, float>& w, char jobz, char uplo, workspace& ws)
 		{
 			LMAT_CHECK_WHOLE_CONT(W)
 			LMAT_CHECK_PERCOL_CONT(A)
 
 			lapack_int n = (lapack_int)a.nrows();
 			lapack_int lda = (lapack_int)a.col_stride();
-			float lwork_opt = 0;
 			lapack_int lwork = -1;
+			lapack_int liwork = 0;
 			lapack_int info = 0;
 
-			LMAT_CALL_LAPACK(ssyev, (&jobz, &uplo, &n, a.ptr_data(), &lda,
-					w.ptr_data(), &lwork_opt, &lwork, &info));
-
-			lwork = (lapack_int)lwork_opt;
+			workspace::key qk("ssyev", jobz, uplo, n);
+			if (!ws.find(qk, lwork, liwork))
+			{
+				float lwork_opt = 0;
+				LMAT_CALL_LAPACK(ssyev, (&jobz, &uplo, &n, a.ptr_data(), &lda,
+						w.ptr_data(), &lwork_opt, &lwork, &info));
 
-			dense_col<float> ws((index_t)lwork);
+				lwork = (lapack_int)lwork_opt;
+				ws.put(qk, lwork, liwork);
+			}
 
 			LMAT_CALL_LAPACK(ssyev, (&jobz, &uplo, &n, a.ptr_data(), &lda,
-					w.ptr_data(), ws.ptr_data(), &lwork, &info));
+					w.ptr_data(), ws.work<float>(lwork), &lwork, &info));
 		}
 
 		template<class A, class W>
-		inline void _syev(IRegularMatrix<A, double>& a, IRegularMatrix<W, double>& w, char jobz, char uplo)
+		inline void _syev(IRegularMatrix<A, double>& a, IRegularMatrix<W, double>& w, char jobz, char uplo, workspace& ws)
 		{
 			LMAT_CHECK_WHOLE_CONT(W)
 			LMAT_CHECK_PERCOL_CONT(A)
 
 			lapack_int n = (lapack_int)a.nrows();
 			lapack_int lda = (lapack_int)a.col_stride();
-			double lwork_opt = 0;
 			lapack_int lwork = -1;
+			lapack_int liwork = 0;
 			lapack_int info = 0;
 
-			LMAT_CALL_LAPACK(dsyev, (&jobz, &uplo, &n, a.ptr_data(), &lda,
-					w.ptr_data(), &lwork_opt, &lwork, &info));
-
-			lwork = (lapack_int)lwork_opt;
+			workspace::key qk("dsyev", jobz, uplo, n);
+			if (!ws.find(qk, lwork, liwork))
+			{
+				double lwork_opt = 0;
+				LMAT_CALL_LAPACK(dsyev, (&jobz, &uplo, &n, a.ptr_data(), &lda,
+						w.ptr_data(), &lwork_opt, &lwork, &info));
 
-			dense_col<double> ws((index_t)lwork);
+				lwork = (lapack_int)lwork_opt;
+				ws.put(qk, lwork, liwork);
+			}
 
 			LMAT_CALL_LAPACK(dsyev, (&jobz, &uplo, &n, a.ptr_data(), &lda,
-					w.ptr_data(), ws.ptr_data(), &lwork, &info));
+					w.ptr_data(), ws.work<double>(lwork), &lwork, &info));
 		}
 	}
 
 
 	template<class A, class W>
 	inline void syev(const IMatrixXpr<A, float>& a, IRegularMatrix<W, float>& w, char uplo='L')
+	{
+		workspace ws;
+		syev(a, w, ws, uplo);
+	}
+
+	template<class A, class W>
+	inline void syev(const IMatrixXpr<A, float>& a, IRegularMatrix<W, float>& w, workspace& ws, char uplo='L')
 	{
 		LMAT_CHECK_WHOLE_CONT(W)
 
@@ -190,11 +205,18 @@ namespace lmat { namespace lapack {
 		w.require_size(n, 1);
 
 		dense_matrix<float> a_(a);
-		internal::_syev(a_, w, 'N', uplo);
+		internal::_syev(a_, w, 'N', uplo, ws);
 	}
 
 	template<class A, class W, class V>
 	inline void syev(const IMatrixXpr<A, float>& a, IRegularMatrix<W, float>& w, IRegularMatrix<V, float>& v, char uplo='L')
+	{
+		workspace ws;
+		syev(a, w, v, ws, uplo);
+	}
+
+	template<class A, class W, class V>
+	inline void syev(const IMatrixXpr<A, float>& a, IRegularMatrix<W, float>& w, IRegularMatrix<V, float>& v, workspace& ws, char uplo='L')
 	{
 		LMAT_CHECK_WHOLE_CONT(W)
 		LMAT_CHECK_PERCOL_CONT(V)
@@ -205,13 +227,20 @@ namespace lmat { namespace lapack {
 		v.require_size(n, n);
 
 		dense_matrix<float> a_(a);
-		internal::_syev(a_, w, 'V', uplo);
+		internal::_syev(a_, w, 'V', uplo, ws);
 
 		copy(a_.derived(), v.derived());
 	}
 
 	template<class A, class W>
 	inline void syev(const IMatrixXpr<A, double>& a, IRegularMatrix<W, double>& w, char uplo='L')
+	{
+		workspace ws;
+		syev(a, w, ws, uplo);
+	}
+
+	template<class A, class W>
+	inline void syev(const IMatrixXpr<A, double>& a, IRegularMatrix<W, double>& w, workspace& ws, char uplo='L')
 	{
 		LMAT_CHECK_WHOLE_CONT(W)
 
@@ -220,11 +249,18 @@ namespace lmat { namespace lapack {
 		w.require_size(n, 1);
 
 		dense_matrix<double> a_(a);
-		internal::_syev(a_, w, 'N', uplo);
+		internal::_syev(a_, w, 'N', uplo, ws);
 	}
 
 	template<class A, class W, class V>
 	inline void syev(const IMatrixXpr<A, double>& a, IRegularMatrix<W, double>& w, IRegularMatrix<V, double>& v, char uplo='L')
+	{
+		workspace ws;
+		syev(a, w, v, ws, uplo);
+	}
+
+	template<class A, class W, class V>
+	inline void syev(const IMatrixXpr<A, double>& a, IRegularMatrix<W, double>& w, IRegularMatrix<V, double>& v, workspace& ws, char uplo='L')
 	{
 		LMAT_CHECK_WHOLE_CONT(W)
 		LMAT_CHECK_PERCOL_CONT(V)
@@ -235,7 +271,7 @@ namespace lmat { namespace lapack {
 		v.require_size(n, n);
 
 		dense_matrix<double> a_(a);
-		internal::_syev(a_, w, 'V', uplo);
+		internal::_syev(a_, w, 'V', uplo, ws);
 
 		copy(a_.derived(), v.derived());
 	}
@@ -250,63 +286,74 @@ namespace lmat { namespace lapack {
 	namespace internal
 	{
 		template<class A, class W>
-		inline void _syevd(IRegularMatrix<A, float>& a, IRegularMatrix<W, float>& w, char jobz, char uplo)
+		inline void _syevd(IRegularMatrix<A, float>& a, IRegularMatrix<W, float>& w, char jobz, char uplo, workspace& ws)
 		{
 			LMAT_CHECK_WHOLE_CONT(W)
 			LMAT_CHECK_PERCOL_CONT(A)
 
 			lapack_int n = (lapack_int)a.nrows();
 			lapack_int lda = (lapack_int)a.col_stride();
-			float lwork_opt = 0;
 			lapack_int lwork = -1;
-			lapack_int liwork_opt = 0;
 			lapack_int liwork = -1;
 			lapack_int info = 0;
 
-			LMAT_CALL_LAPACK(ssyevd, (&jobz, &uplo, &n, a.ptr_data(), &lda, w.ptr_data(),
-					&lwork_opt, &lwork, &liwork_opt, &liwork, &info));
-
-			lwork = (lapack_int)lwork_opt;
-			liwork = liwork_opt;
-
-			dense_col<float> ws((index_t)lwork);
-			dense_col<lapack_int> iws((index_t)liwork);
+			workspace::key qk("ssyevd", jobz, uplo, n);
+			if (!ws.find(qk, lwork, liwork))
+			{
+				float lwork_opt = 0;
+				lapack_int liwork_opt = 0;
+				LMAT_CALL_LAPACK(ssyevd, (&jobz, &uplo, &n, a.ptr_data(), &lda, w.ptr_data(),
+						&lwork_opt, &lwork, &liwork_opt, &liwork, &info));
+
+				lwork = (lapack_int)lwork_opt;
+				liwork = liwork_opt;
+				ws.put(qk, lwork, liwork);
+			}
 
 			LMAT_CALL_LAPACK(ssyevd, (&jobz, &uplo, &n, a.ptr_data(), &lda, w.ptr_data(),
-					ws.ptr_data(), &lwork, iws.ptr_data(), &liwork, &info));
+					ws.work<float>(lwork), &lwork, ws.iwork(liwork), &liwork, &info));
 		}
 
 		template<class A, class W>
-		inline void _syevd(IRegularMatrix<A, double>& a, IRegularMatrix<W, double>& w, char jobz, char uplo)
+		inline void _syevd(IRegularMatrix<A, double>& a, IRegularMatrix<W, double>& w, char jobz, char uplo, workspace& ws)
 		{
 			LMAT_CHECK_WHOLE_CONT(W)
 			LMAT_CHECK_PERCOL_CONT(A)
 
 			lapack_int n = (lapack_int)a.nrows();
 			lapack_int lda = (lapack_int)a.col_stride();
-			double lwork_opt = 0;
 			lapack_int lwork = -1;
-			lapack_int liwork_opt = 0;
 			lapack_int liwork = -1;
 			lapack_int info = 0;
 
-			LMAT_CALL_LAPACK(dsyevd, (&jobz, &uplo, &n, a.ptr_data(), &lda, w.ptr_data(),
-					&lwork_opt, &lwork, &liwork_opt, &liwork, &info));
-
-			lwork = (lapack_int)lwork_opt;
-			liwork = liwork_opt;
-
-			dense_col<double> ws((index_t)lwork);
-			dense_col<lapack_int> iws((index_t)liwork);
+			workspace::key qk("dsyevd", jobz, uplo, n);
+			if (!ws.find(qk, lwork, liwork))
+			{
+				double lwork_opt = 0;
+				lapack_int liwork_opt = 0;
+				LMAT_CALL_LAPACK(dsyevd, (&jobz, &uplo, &n, a.ptr_data(), &lda, w.ptr_data(),
+						&lwork_opt, &lwork, &liwork_opt, &liwork, &info));
+
+				lwork = (lapack_int)lwork_opt;
+				liwork = liwork_opt;
+				ws.put(qk, lwork, liwork);
+			}
 
 			LMAT_CALL_LAPACK(dsyevd, (&jobz, &uplo, &n, a.ptr_data(), &lda, w.ptr_data(),
-					ws.ptr_data(), &lwork, iws.ptr_data(), &liwork, &info));
+					ws.work<double>(lwork), &lwork, ws.iwork(liwork), &liwork, &info));
 		}
 	}
 
 
 	template<class A, class W>
 	inline void syevd(const IMatrixXpr<A, float>& a, IRegularMatrix<W, float>& w, char uplo='L')
+	{
+		workspace ws;
+		syevd(a, w, ws, uplo);
+	}
+
+	template<class A, class W>
+	inline void syevd(const IMatrixXpr<A, float>& a, IRegularMatrix<W, float>& w, workspace& ws, char uplo='L')
 	{
 		LMAT_CHECK_WHOLE_CONT(W)
 
@@ -315,11 +362,18 @@ namespace lmat { namespace lapack {
 		w.require_size(n, 1);
 
 		dense_matrix<float> a_(a);
-		internal::_syevd(a_, w, 'N', uplo);
+		internal::_syevd(a_, w, 'N', uplo, ws);
 	}
 
 	template<class A, class W, class V>
 	inline void syevd(const IMatrixXpr<A, float>& a, IRegularMatrix<W, float>& w, IRegularMatrix<V, float>& v, char uplo='L')
+	{
+		workspace ws;
+		syevd(a, w, v, ws, uplo);
+	}
+
+	template<class A, class W, class V>
+	inline void syevd(const IMatrixXpr<A, float>& a, IRegularMatrix<W, float>& w, IRegularMatrix<V, float>& v, workspace& ws, char uplo='L')
 	{
 		LMAT_CHECK_WHOLE_CONT(W)
 		LMAT_CHECK_PERCOL_CONT(V)
@@ -330,13 +384,20 @@ namespace lmat { namespace lapack {
 		v.require_size(n, n);
 
 		dense_matrix<float> a_(a);
-		internal::_syevd(a_, w, 'V', uplo);
+		internal::_syevd(a_, w, 'V', uplo, ws);
 
 		copy(a_.derived(), v.derived());
 	}
 
 	template<class A, class W>
 	inline void syevd(const IMatrixXpr<A, double>& a, IRegularMatrix<W, double>& w, char uplo='L')
+	{
+		workspace ws;
+		syevd(a, w, ws, uplo);
+	}
+
+	template<class A, class W>
+	inline void syevd(const IMatrixXpr<A, double>& a, IRegularMatrix<W, double>& w, workspace& ws, char uplo='L')
 	{
 		LMAT_CHECK_WHOLE_CONT(W)
 
@@ -345,11 +406,18 @@ namespace lmat { namespace lapack {
 		w.require_size(n, 1);
 
 		dense_matrix<double> a_(a);
-		internal::_syevd(a_, w, 'N', uplo);
+		internal::_syevd(a_, w, 'N', uplo, ws);
 	}
 
 	template<class A, class W, class V>
 	inline void syevd(const IMatrixXpr<A, double>& a, IRegularMatrix<W, double>& w, IRegularMatrix<V, double>& v, char uplo='L')
+	{
+		workspace ws;
+		syevd(a, w, v, ws, uplo);
+	}
+
+	template<class A, class W, class V>
+	inline void syevd(const IMatrixXpr<A, double>& a, IRegularMatrix<W, double>& w, IRegularMatrix<V, double>& v, workspace& ws, char uplo='L')
 	{
 		LMAT_CHECK_WHOLE_CONT(W)
 		LMAT_CHECK_PERCOL_CONT(V)
@@ -360,7 +428,7 @@ namespace lmat { namespace lapack {
 		v.require_size(n, n);
 
 		dense_matrix<double> a_(a);
-		internal::_syevd(a_, w, 'V', uplo);
+		internal::_syevd(a_, w, 'V', uplo, ws);
 
 		copy(a_.derived(), v.derived());
 	}
@@ -415,7 +483,7 @@ namespace lmat { namespace lapack {
 
 		template<class A, class W, class V, typename Range>
 		inline index_t _syevr(IRegularMatrix<A, float>& a, IRegularMatrix<W, float>& w, IRegularMatrix<V, float>& z,
-				char jobz, char uplo, float abstol, const Range& ergn)
+				char jobz, char uplo, float abstol, const Range& ergn, workspace& ws)
 		{
 			LMAT_CHECK_WHOLE_CONT(W)
 			LMAT_CHECK_PERCOL_CONT(A)
@@ -427,34 +495,36 @@ namespace lmat { namespace lapack {
 			lapack_int ldz = (lapack_int)z.col_stride();
 			if (ldz == 0) ldz = 1;
 
-			float lwork_opt = 0;
 			lapack_int lwork = -1;
-			lapack_int liwork_opt = 0;
 			lapack_int liwork = -1;
 			lapack_int info = 0;
 
-			dense_col<lapack_int> isuppz;
-			if (jobz == 'V' || jobz == 'v')
-				isuppz.require_size(2 * n);
-
 			char range;
 			float vl, vu;
 			lapack_int il, iu;
 			_set_eigval_range(n, ergn, range, vl, vu, il, iu);
 
-			LMAT_CALL_LAPACK(ssyevr, (&jobz, &range, &uplo, &n, a.ptr_data(), &lda, &vl, &vu, &il, &iu, &abstol,
-					&m, w.ptr_data(), z.ptr_data(), &ldz, isuppz.ptr_data(),
-					&lwork_opt, &lwork, &liwork_opt, &liwork, &info));
-
-			lwork = (lapack_int)lwork_opt;
-			liwork = liwork_opt;
+			workspace::key qk("ssyevr", jobz, range, uplo, n);
+			if (!ws.find(qk, lwork, liwork))
+			{
+				float lwork_opt = 0;
+				lapack_int liwork_opt = 0;
+				LMAT_CALL_LAPACK(ssyevr, (&jobz, &range, &uplo, &n, a.ptr_data(), &lda, &vl, &vu, &il, &iu, &abstol,
+						&m, w.ptr_data(), z.ptr_data(), &ldz, 0,
+						&lwork_opt, &lwork, &liwork_opt, &liwork, &info));
+
+				lwork = (lapack_int)lwork_opt;
+				liwork = liwork_opt;
+				ws.put(qk, lwork, liwork);
+			}
 
-			dense_col<float> ws((index_t)lwork);
-			dense_col<lapack_int> iws((index_t)liwork);
+			// isuppz (2n) is placed after the integer workspace
+			lapack_int *iws = ws.iwork(liwork + 2 * n);
+			m = 0;
 
 			LMAT_CALL_LAPACK(ssyevr, (&jobz, &range, &uplo, &n, a.ptr_data(), &lda, &vl, &vu, &il, &iu, &abstol,
-					&m, w.ptr_data(), z.ptr_data(), &ldz, isuppz.ptr_data(),
-					ws.ptr_data(), &lwork, iws.ptr_data(), &liwork, &info));
+					&m, w.ptr_data(), z.ptr_data(), &ldz, iws + liwork,
+					ws.work<float>(lwork), &lwork, iws, &liwork, &info));
 
 			return (index_t)m;
 		}
@@ -462,7 +532,7 @@ namespace lmat { namespace lapack {
 
 		template<class A, class W, class V, typename Range>
 		inline index_t _syevr(IRegularMatrix<A, double>& a, IRegularMatrix<W, double>& w, IRegularMatrix<V, double>& z,
-				char jobz, char uplo, double abstol, const Range& ergn)
+				char jobz, char uplo, double abstol, const Range& ergn, workspace& ws)
 		{
 			LMAT_CHECK_WHOLE_CONT(W)
 			LMAT_CHECK_PERCOL_CONT(A)
@@ -474,41 +544,42 @@ namespace lmat { namespace lapack {
 			lapack_int ldz = (lapack_int)z.col_stride();
 			if (ldz == 0) ldz = 1;
 
-			double lwork_opt = 0;
 			lapack_int lwork = -1;
-			lapack_int liwork_opt = 0;
 			lapack_int liwork = -1;
 			lapack_int info = 0;
 
-			dense_col<lapack_int> isuppz;
-			if (jobz == 'V' || jobz == 'v')
-				isuppz.require_size(2 * n);
-
 			char range;
 			double vl, vu;
 			lapack_int il, iu;
 			_set_eigval_range(n, ergn, range, vl, vu, il, iu);
 
-			LMAT_CALL_LAPACK(dsyevr, (&jobz, &range, &uplo, &n, a.ptr_data(), &lda, &vl, &vu, &il, &iu, &abstol,
-					&m, w.ptr_data(), z.ptr_data(), &ldz, isuppz.ptr_data(),
-					&lwork_opt, &lwork, &liwork_opt, &liwork, &info));
-
-			lwork = (lapack_int)lwork_opt;
-			liwork = liwork_opt;
+			workspace::key qk("dsyevr", jobz, range, uplo, n);
+			if (!ws.find(qk, lwork, liwork))
+			{
+				double lwork_opt = 0;
+				lapack_int liwork_opt = 0;
+				LMAT_CALL_LAPACK(dsyevr, (&jobz, &range, &uplo, &n, a.ptr_data(), &lda, &vl, &vu, &il, &iu, &abstol,
+						&m, w.ptr_data(), z.ptr_data(), &ldz, 0,
+						&lwork_opt, &lwork, &liwork_opt, &liwork, &info));
+
+				lwork = (lapack_int)lwork_opt;
+				liwork = liwork_opt;
+				ws.put(qk, lwork, liwork);
+			}
 
-			dense_col<double> ws((index_t)lwork);
-			dense_col<lapack_int> iws((index_t)liwork);
+			// isuppz (2n) is placed after the integer workspace
+			lapack_int *iws = ws.iwork(liwork + 2 * n);
 			m = 0;
 
 			LMAT_CALL_LAPACK(dsyevr, (&jobz, &range, &uplo, &n, a.ptr_data(), &lda, &vl, &vu, &il, &iu, &abstol,
-					&m, w.ptr_data(), z.ptr_data(), &ldz, isuppz.ptr_data(),
-					ws.ptr_data(), &lwork, iws.ptr_data(), &liwork, &info));
+					&m, w.ptr_data(), z.ptr_data(), &ldz, iws + liwork,
+					ws.work<double>(lwork), &lwork, iws, &liwork, &info));
 
 			return (index_t)m;
 		}
 
 		template<typename T, class A, class W, typename Range>
-		inline index_t _syevr_n(const IMatrixXpr<A, T>& a, IRegularMatrix<W, T>& w, index_t ns, const Range& ergn, T abstol, char uplo)
+		inline index_t _syevr_n(const IMatrixXpr<A, T>& a, IRegularMatrix<W, T>& w, index_t ns, const Range& ergn, T abstol, char uplo, workspace& ws)
 		{
 			LMAT_CHECK_WHOLE_CONT(W)
 
@@ -523,12 +594,12 @@ namespace lmat { namespace lapack {
 
 			if (ns == n)
 			{
-				ret = internal::_syevr(a_, w, v_, 'N', uplo, abstol, ergn);
+				ret = internal::_syevr(a_, w, v_, 'N', uplo, abstol, ergn, ws);
 			}
 			else
 			{
 				dense_col<T> w_(n);
-				ret = internal::_syevr(a_, w_, v_, 'N', uplo, abstol, ergn);
+				ret = internal::_syevr(a_, w_, v_, 'N', uplo, abstol, ergn, ws);
 				copy_vec(ns, w_.ptr_data(), w.ptr_data());
 			}
 
@@ -537,7 +608,7 @@ namespace lmat { namespace lapack {
 
 		template<typename T, class A, class W, class V, typename Range>
 		inline index_t _syevr_v(const IMatrixXpr<A, T>& a, IRegularMatrix<W, T>& w, IRegularMatrix<V, T>& v,
-				index_t ns, const Range& ergn, T abstol, char uplo)
+				index_t ns, const Range& ergn, T abstol, char uplo, workspace& ws)
 		{
 			LMAT_CHECK_WHOLE_CONT(W)
 			LMAT_CHECK_PERCOL_CONT(V)
@@ -553,12 +624,12 @@ namespace lmat { namespace lapack {
 
 			if (ns == n)
 			{
-				ret = internal::_syevr(a_, w, v, 'V', uplo, abstol, ergn);
+				ret = internal::_syevr(a_, w, v, 'V', uplo, abstol, ergn, ws);
 			}
 			else
 			{
 				dense_col<T> w_(n);
-				ret = internal::_syevr(a_, w_, v, 'V', uplo, abstol, ergn);
+				ret = internal::_syevr(a_, w_, v, 'V', uplo, abstol, ergn, ws);
 				copy_vec(ns, w_.ptr_data(), w.ptr_data());
 			}
 
@@ -572,42 +643,90 @@ namespace lmat { namespace lapack {
 	inline index_t syevr(const IMatrixXpr<A, float>& a, IRegularMatrix<W, float>& w,
 			float abstol=0.0f, char uplo='L')
 	{
-		return internal::_syevr_n(a, w, a.nrows(), whole(), abstol, uplo);
+		workspace ws;
+		return syevr(a, w, ws, abstol, uplo);
+	}
+
+	template<class A, class W>
+	inline index_t syevr(const IMatrixXpr<A, float>& a, IRegularMatrix<W, float>& w,
+			workspace& ws, float abstol=0.0f, char uplo='L')
+	{
+		return internal::_syevr_n(a, w, a.nrows(), whole(), abstol, uplo, ws);
 	}
 
 	template<class A, class W>
 	inline index_t syevr(const IMatrixXpr<A, float>& a, IRegularMatrix<W, float>& w,
 			const eigval_irange& ergn, float abstol=0.0f, char uplo='L')
 	{
-		return internal::_syevr_n(a, w, ergn.num(), ergn, abstol, uplo);
+		workspace ws;
+		return syevr(a, w, ws, ergn, abstol, uplo);
+	}
+
+	template<class A, class W>
+	inline index_t syevr(const IMatrixXpr<A, float>& a, IRegularMatrix<W, float>& w,
+			workspace& ws, const eigval_irange& ergn, float abstol=0.0f, char uplo='L')
+	{
+		return internal::_syevr_n(a, w, ergn.num(), ergn, abstol, uplo, ws);
 	}
 
 	template<class A, class W>
 	inline index_t syevr(const IMatrixXpr<A, float>& a, IRegularMatrix<W, float>& w,
 			const eigval_vrange<float>& ergn, float abstol=0.0f, char uplo='L')
 	{
-		return internal::_syevr_n(a, w, a.nrows(), ergn, abstol, uplo);
+		workspace ws;
+		return syevr(a, w, ws, ergn, abstol, uplo);
+	}
+
+	template<class A, class W>
+	inline index_t syevr(const IMatrixXpr<A, float>& a, IRegularMatrix<W, float>& w,
+			workspace& ws, const eigval_vrange<float>& ergn, float abstol=0.0f, char uplo='L')
+	{
+		return internal::_syevr_n(a, w, a.nrows(), ergn, abstol, uplo, ws);
 	}
 
 	template<class A, class W, class V>
 	inline index_t syevr(const IMatrixXpr<A, float>& a, IRegularMatrix<W, float>& w, IRegularMatrix<V, float>& v,
 			float abstol=0.0f, char uplo='L')
 	{
-		return internal::_syevr_v(a, w, v, a.nrows(), whole(), abstol, uplo);
+		workspace ws;
+		return syevr(a, w, v, ws, abstol, uplo);
+	}
+
+	template<class A, class W, class V>
+	inline index_t syevr(const IMatrixXpr<A, float>& a, IRegularMatrix<W, float>& w, IRegularMatrix<V, float>& v,
+			workspace& ws, float abstol=0.0f, char uplo='L')
+	{
+		return internal::_syevr_v(a, w, v, a.nrows(), whole(), abstol, uplo, ws);
 	}
 
 	template<class A, class W, class V>
 	inline index_t syevr(const IMatrixXpr<A, float>& a, IRegularMatrix<W, float>& w, IRegularMatrix<V, float>& v,
 			const eigval_irange& ergn, float abstol=0.0f, char uplo='L')
 	{
-		return internal::_syevr_v(a, w, v, ergn.num(), ergn, abstol, uplo);
+		workspace ws;
+		return syevr(a, w, v, ws, ergn, abstol, uplo);
+	}
+
+	template<class A, class W, class V>
+	inline index_t syevr(const IMatrixXpr<A, float>& a, IRegularMatrix<W, float>& w, IRegularMatrix<V, float>& v,
+			workspace& ws, const eigval_irange& ergn, float abstol=0.0f, char uplo='L')
+	{
+		return internal::_syevr_v(a, w, v, ergn.num(), ergn, abstol, uplo, ws);
 	}
 
 	template<class A, class W, class V>
 	inline index_t syevr(const IMatrixXpr<A, float>& a, IRegularMatrix<W, float>& w, IRegularMatrix<V, float>& v,
 			const eigval_vrange<float>& ergn, float abstol=0.0f, char uplo='L')
 	{
-		return internal::_syevr_v(a, w, v, a.nrows(), ergn, abstol, uplo);
+		workspace ws;
+		return syevr(a, w, v, ws, ergn, abstol, uplo);
+	}
+
+	template<class A, class W, class V>
+	inline index_t syevr(const IMatrixXpr<A, float>& a, IRegularMatrix<W, float>& w, IRegularMatrix<V, float>& v,
+			workspace& ws, const eigval_vrange<float>& ergn, float abstol=0.0f, char uplo='L')
+	{
+		return internal::_syevr_v(a, w, v, a.nrows(), ergn, abstol, uplo, ws);
 	}
 
 
@@ -615,45 +734,93 @@ namespace lmat { namespace lapack {
 	inline index_t syevr(const IMatrixXpr<A, double>& a, IRegularMatrix<W, double>& w,
 			double abstol=0.0, char uplo='L')
 	{
-		return internal::_syevr_n(a, w, a.nrows(), whole(), abstol, uplo);
+		workspace ws;
+		return syevr(a, w, ws, abstol, uplo);
+	}
+
+	template<class A, class W>
+	inline index_t syevr(const IMatrixXpr<A, double>& a, IRegularMatrix<W, double>& w,
+			workspace& ws, double abstol=0.0, char uplo='L')
+	{
+		return internal::_syevr_n(a, w, a.nrows(), whole(), abstol, uplo, ws);
 	}
 
 	template<class A, class W>
 	inline index_t syevr(const IMatrixXpr<A, double>& a, IRegularMatrix<W, double>& w,
 			const eigval_irange& ergn, double abstol=0.0, char uplo='L')
 	{
-		return internal::_syevr_n(a, w, ergn.num(), ergn, abstol, uplo);
+		workspace ws;
+		return syevr(a, w, ws, ergn, abstol, uplo);
+	}
+
+	template<class A, class W>
+	inline index_t syevr(const IMatrixXpr<A, double>& a, IRegularMatrix<W, double>& w,
+			workspace& ws, const eigval_irange& ergn, double abstol=0.0, char uplo='L')
+	{
+		return internal::_syevr_n(a, w, ergn.num(), ergn, abstol, uplo, ws);
 	}
 
 	template<class A, class W>
 	inline index_t syevr(const IMatrixXpr<A, double>& a, IRegularMatrix<W, double>& w,
 			const eigval_vrange<double>& ergn, double abstol=0.0, char uplo='L')
 	{
-		return internal::_syevr_n(a, w, a.nrows(), ergn, abstol, uplo);
+		workspace ws;
+		return syevr(a, w, ws, ergn, abstol, uplo);
+	}
+
+	template<class A, class W>
+	inline index_t syevr(const IMatrixXpr<A, double>& a, IRegularMatrix<W, double>& w,
+			workspace& ws, const eigval_vrange<double>& ergn, double abstol=0.0, char uplo='L')
+	{
+		return internal::_syevr_n(a, w, a.nrows(), ergn, abstol, uplo, ws);
 	}
 
 	template<class A, class W, class V>
 	inline index_t syevr(const IMatrixXpr<A, double>& a, IRegularMatrix<W, double>& w, IRegularMatrix<V, double>& v,
 			double abstol=0.0, char uplo='L')
 	{
-		return internal::_syevr_v(a, w, v, a.nrows(), whole(), abstol, uplo);
+		workspace ws;
+		return syevr(a, w, v, ws, abstol, uplo);
+	}
+
+	template<class A, class W, class V>
+	inline index_t syevr(const IMatrixXpr<A, double>& a, IRegularMatrix<W, double>& w, IRegularMatrix<V, double>& v,
+			workspace& ws, double abstol=0.0, char uplo='L')
+	{
+		return internal::_syevr_v(a, w, v, a.nrows(), whole(), abstol, uplo, ws);
 	}
 
 	template<class A, class W, class V>
 	inline index_t syevr(const IMatrixXpr<A, double>& a, IRegularMatrix<W, double>& w, IRegularMatrix<V, double>& v,
 			const eigval_irange& ergn, double abstol=0.0, char uplo='L')
 	{
-		return internal::_syevr_v(a, w, v, ergn.num(), ergn, abstol, uplo);
+		workspace ws;
+		return syevr(a, w, v, ws, ergn, abstol, uplo);
+	}
+
+	template<class A, class W, class V>
+	inline index_t syevr(const IMatrixXpr<A, double>& a, IRegularMatrix<W, double>& w, IRegularMatrix<V, double>& v,
+			workspace& ws, const eigval_irange& ergn, double abstol=0.0, char uplo='L')
+	{
+		return internal::_syevr_v(a, w, v, ergn.num(), ergn, abstol, uplo, ws);
 	}
 
 	template<class A, class W, class V>
 	inline index_t syevr(const IMatrixXpr<A, double>& a, IRegularMatrix<W, double>& w, IRegularMatrix<V, double>& v,
 			const eigval_vrange<double>& ergn, double abstol=0.0, char uplo='L')
 	{
-		return internal::_syevr_v(a, w, v, a.nrows(), ergn, abstol, uplo);
+		workspace ws;
+		return syevr(a, w, v, ws, ergn, abstol, uplo);
+	}
+
+	template<class A, class W, class V>
+	inline index_t syevr(const IMatrixXpr<A, double>& a, IRegularMatrix<W, double>& w, IRegularMatrix<V, double>& v,
+			workspace& ws, const eigval_vrange<double>& ergn, double abstol=0.0, char uplo='L')
+	{
+		return internal::_syevr_v(a, w, v, a.nrows(), ergn, abstol, uplo, ws);
 	}
 
-} }
+} LMAT_END_NAMESPACE
 
 
 #endif /* LAPACK_SYEV_H_ */
@@ -42,8 +42,12 @@ typedef int blas_int;
 #define LMAT_CHECK_WHOLE_CONT(Ty) static_assert( meta::is_contiguous<Ty>::value, #Ty " must be contiguous.");
 #define LMAT_CHECK_PERCOL_CONT(Ty) static_assert( meta::is_percol_contiguous<Ty>::value, #Ty " must be percol contiguous.");
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
+	// the dimensions of a matrix must fit in a BLAS integer,
+	// hence a 64-bit index_t requires an ILP64 BLAS
+
+	static_assert(sizeof(blas_int) >= sizeof(index_t),
+			"blas_int is narrower than index_t: define LMAT_BLAS_ILP64 and link to an ILP64 BLAS.");
 
 	namespace blas
 	{
@@ -67,7 +71,7 @@ namespace lmat
 		};
 	}
 
-}
+LMAT_END_NAMESPACE
 
 
 #endif /* LINALG_FWD_H_ */
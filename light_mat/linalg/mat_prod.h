@@ -0,0 +1,615 @@
+/**
+ * @file mat_prod.h
+ *
+ * @brief Matrix product expressions evaluated by GEMM/GEMV
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_MAT_PROD_H_
+#define LIGHTMAT_MAT_PROD_H_
+
+#include <light_mat/linalg/blas_l2.h>
+#include <light_mat/linalg/blas_l3.h>
+#include <light_mat/matrix/matrix_transpose.h>
+#include <light_mat/matexpr/mat_arith.h>
+#include <type_traits>
+
+LMAT_BEGIN_NAMESPACE
+	// forward declarations
+
+	template<class A, class B> class mm_expr;
+	template<class A, class X> class mv_expr;
+	template<class P, class C> class prod_add_expr;
+
+
+	/********************************************
+	 *
+	 *  operands
+	 *
+	 ********************************************/
+
+	namespace internal
+	{
+		// an operand of a product: a regular matrix, or the transpose
+		// of one, which is passed to BLAS with the trans flag set
+
+		template<class A>
+		struct prod_operand
+		{
+			static const bool value = meta::is_regular_mat<A>::value;
+
+			typedef A mat_type;
+			static const index_t ct_rows = meta::nrows<A>::value;
+			static const index_t ct_cols = meta::ncols<A>::value;
+
+			LMAT_ENSURE_INLINE
+			static const A& mat(const A& a) { return a; }
+
+			LMAT_ENSURE_INLINE
+			static char trans() { return 'N'; }
+		};
+
+		template<class A>
+		struct prod_operand<transpose_expr<A> >
+		{
+			static const bool value = meta::is_regular_mat<A>::value;
+
+			typedef A mat_type;
+			static const index_t ct_rows = meta::ncols<A>::value;
+			static const index_t ct_cols = meta::nrows<A>::value;
+
+			LMAT_ENSURE_INLINE
+			static const A& mat(const transpose_expr<A>& a) { return a.arg(); }
+
+			LMAT_ENSURE_INLINE
+			static char trans() { return 'T'; }
+		};
+
+
+		// the addend of a fused product: c, s * c, or c * s
+
+		template<class E>
+		struct prod_addend
+		{
+			static const bool value = meta::is_regular_mat<E>::value;
+
+			typedef E mat_type;
+
+			LMAT_ENSURE_INLINE
+			static const E& mat(const E& e) { return e; }
+
+			template<typename T>
+			LMAT_ENSURE_INLINE
+			static T scale(const E& e) { return T(1); }
+		};
+
+		template<class L, class R>
+		struct prod_addend<map_expr<ftags::mul_, L, R> >
+		{
+			typedef map_expr<ftags::mul_, L, R> expr_t;
+			static const bool lscalar = std::is_arithmetic<L>::value;
+
+			typedef typename std::conditional<lscalar, R, L>::type mat_type;
+
+			static const bool value =
+					(lscalar || std::is_arithmetic<R>::value) &&
+					meta::is_regular_mat<mat_type>::value;
+
+			LMAT_ENSURE_INLINE
+			static const mat_type& mat(const expr_t& e)
+			{
+				return get_mat(e, meta::bool_<lscalar>());
+			}
+
+			template<typename T>
+			LMAT_ENSURE_INLINE
+			static T scale(const expr_t& e)
+			{
+				return get_scale<T>(e, meta::bool_<lscalar>());
+			}
+
+		private:
+			LMAT_ENSURE_INLINE
+			static const mat_type& get_mat(const expr_t& e, meta::true_) { return e.arg2(); }
+
+			LMAT_ENSURE_INLINE
+			static const mat_type& get_mat(const expr_t& e, meta::false_) { return e.arg1(); }
+
+			template<typename T>
+			LMAT_ENSURE_INLINE
+			static T get_scale(const expr_t& e, meta::true_) { return T(e.arg1()); }
+
+			template<typename T>
+			LMAT_ENSURE_INLINE
+			static T get_scale(const expr_t& e, meta::false_) { return T(e.arg2()); }
+		};
+
+
+		// whether two regular matrices share any memory
+
+		template<class A, class B>
+		inline bool mat_overlap(const A& a, const B& b)
+		{
+			if (a.nelems() == 0 || b.nelems() == 0) return false;
+
+			const char *a0 = (const char*)a.ptr_data();
+			const char *a1 = (const char*)(a.ptr_data() +
+					((a.nrows() - 1) * a.row_stride() + (a.ncolumns() - 1) * a.col_stride() + 1));
+
+			const char *b0 = (const char*)b.ptr_data();
+			const char *b1 = (const char*)(b.ptr_data() +
+					((b.nrows() - 1) * b.row_stride() + (b.ncolumns() - 1) * b.col_stride() + 1));
+
+			return a0 < b1 && b0 < a1;
+		}
+
+		template<class A, class B>
+		LMAT_ENSURE_INLINE
+		inline bool same_mat(const A& a, const B& b)
+		{
+			return a.ptr_data() == b.ptr_data() &&
+					a.nrows() == b.nrows() && a.ncolumns() == b.ncolumns() &&
+					a.row_stride() == b.row_stride() && a.col_stride() == b.col_stride();
+		}
+	}
+
+
+	/********************************************
+	 *
+	 *  mm: alpha * op(a) * op(b)
+	 *
+	 ********************************************/
+
+	template<class A, class B>
+	struct matrix_traits<mm_expr<A, B> >
+	: public matrix_xpr_traits_base<
+	  typename meta::value_type_of<A>::type,
+	  internal::prod_operand<A>::ct_rows,
+	  internal::prod_operand<B>::ct_cols,
+	  typename meta::domain_of<A>::type> { };
+
+
+	template<class A, class B>
+	class mm_expr
+	: public matrix_xpr_base<mm_expr<A, B> >
+	{
+		typedef matrix_xpr_base<mm_expr<A, B> > base_t;
+		typedef internal::prod_operand<A> opa_t;
+		typedef internal::prod_operand<B> opb_t;
+
+		static_assert(opa_t::value && opb_t::value,
+				"Operands of mm must be regular matrices or their transposes.");
+
+	public:
+		typedef typename meta::value_type_of<A>::type value_type;
+		typedef typename opa_t::mat_type amat_type;
+		typedef typename opb_t::mat_type bmat_type;
+
+		LMAT_ENSURE_INLINE
+		mm_expr(const A& a, const B& b, value_type alpha)
+		: base_t(a.nrows(), b.ncolumns())
+		, m_a(opa_t::mat(a)), m_b(opb_t::mat(b)), m_alpha(alpha)
+		{
+			LMAT_CHECK_DIMS( a.ncolumns() == b.nrows() )
+		}
+
+		LMAT_ENSURE_INLINE
+		mm_expr(const mm_expr& p, value_type s)
+		: base_t(p.nrows(), p.ncolumns())
+		, m_a(p.m_a), m_b(p.m_b), m_alpha(p.m_alpha * s) { }
+
+		LMAT_ENSURE_INLINE const amat_type& a() const { return m_a; }
+		LMAT_ENSURE_INLINE const bmat_type& b() const { return m_b; }
+
+		LMAT_ENSURE_INLINE char transa() const { return opa_t::trans(); }
+		LMAT_ENSURE_INLINE char transb() const { return opb_t::trans(); }
+
+		LMAT_ENSURE_INLINE value_type alpha() const { return m_alpha; }
+
+		// c := alpha * op(a) * op(b) + beta * c
+
+		template<class C>
+		LMAT_ENSURE_INLINE
+		void run(value_type beta, IRegularMatrix<C, value_type>& c) const
+		{
+			blas::gemm(m_alpha, m_a, m_b, beta, c, transa(), transb());
+		}
+
+		template<class C>
+		LMAT_ENSURE_INLINE
+		bool aliased_by(const C& c) const
+		{
+			return internal::mat_overlap(m_a, c) || internal::mat_overlap(m_b, c);
+		}
+
+	private:
+		const amat_type& m_a;
+		const bmat_type& m_b;
+		value_type m_alpha;
+	};
+
+
+	/********************************************
+	 *
+	 *  mv: alpha * op(a) * x
+	 *
+	 ********************************************/
+
+	template<class A, class X>
+	struct matrix_traits<mv_expr<A, X> >
+	: public matrix_xpr_traits_base<
+	  typename meta::value_type_of<A>::type,
+	  internal::prod_operand<A>::ct_rows, 1,
+	  typename meta::domain_of<A>::type> { };
+
+
+	template<class A, class X>
+	class mv_expr
+	: public matrix_xpr_base<mv_expr<A, X> >
+	{
+		typedef matrix_xpr_base<mv_expr<A, X> > base_t;
+		typedef internal::prod_operand<A> opa_t;
+
+		static_assert(opa_t::value,
+				"The matrix operand of mv must be a regular matrix or its transpose.");
+		static_assert(meta::is_regular_mat<X>::value,
+				"The vector operand of mv must be a regular matrix.");
+
+	public:
+		typedef typename meta::value_type_of<A>::type value_type;
+		typedef typename opa_t::mat_type amat_type;
+
+		LMAT_ENSURE_INLINE
+		mv_expr(const A& a, const X& x, value_type alpha)
+		: base_t(a.nrows(), 1)
+		, m_a(opa_t::mat(a)), m_x(x), m_alpha(alpha)
+		{
+			LMAT_CHECK_DIMS( a.ncolumns() == x.nelems() && is_vector(x) )
+		}
+
+		LMAT_ENSURE_INLINE
+		mv_expr(const mv_expr& p, value_type s)
+		: base_t(p.nrows(), 1)
+		, m_a(p.m_a), m_x(p.m_x), m_alpha(p.m_alpha * s) { }
+
+		LMAT_ENSURE_INLINE const amat_type& a() const { return m_a; }
+		LMAT_ENSURE_INLINE const X& x() const { return m_x; }
+
+		LMAT_ENSURE_INLINE char trans() const { return opa_t::trans(); }
+
+		LMAT_ENSURE_INLINE value_type alpha() const { return m_alpha; }
+
+		// y := alpha * op(a) * x + beta * y
+
+		template<class Y>
+		LMAT_ENSURE_INLINE
+		void run(value_type beta, IRegularMatrix<Y, value_type>& y) const
+		{
+			blas::gemv(m_alpha, m_a, m_x, beta, y, trans());
+		}
+
+		template<class Y>
+		LMAT_ENSURE_INLINE
+		bool aliased_by(const Y& y) const
+		{
+			return internal::mat_overlap(m_a, y) || internal::mat_overlap(m_x, y);
+		}
+
+	private:
+		const amat_type& m_a;
+		const X& m_x;
+		value_type m_alpha;
+	};
+
+
+	/********************************************
+	 *
+	 *  fused: alpha * op(a) * op(b) + beta * c
+	 *
+	 ********************************************/
+
+	template<class P, class C>
+	struct matrix_traits<prod_add_expr<P, C> >
+	: public matrix_xpr_traits_base<
+	  typename meta::value_type_of<P>::type,
+	  meta::common_nrows<P, C>::value,
+	  meta::common_ncols<P, C>::value,
+	  typename meta::domain_of<P>::type> { };
+
+
+	template<class P, class C>
+	class prod_add_expr
+	: public matrix_xpr_base<prod_add_expr<P, C> >
+	{
+		typedef matrix_xpr_base<prod_add_expr<P, C> > base_t;
+
+	public:
+		typedef typename meta::value_type_of<P>::type value_type;
+
+		LMAT_ENSURE_INLINE
+		prod_add_expr(const P& p, const C& c, value_type beta)
+		: base_t(p.nrows(), p.ncolumns())
+		, m_prod(p), m_c(c), m_beta(beta)
+		{
+			LMAT_CHECK_DIMS( have_same_shape(p, c) )
+		}
+
+		LMAT_ENSURE_INLINE const P& prod() const { return m_prod; }
+		LMAT_ENSURE_INLINE const C& c() const { return m_c; }
+		LMAT_ENSURE_INLINE value_type beta() const { return m_beta; }
+
+	private:
+		P m_prod;
+		const C& m_c;
+		value_type m_beta;
+	};
+
+
+	/********************************************
+	 *
+	 *  construction
+	 *
+	 ********************************************/
+
+	template<typename T, class A, class B>
+	LMAT_ENSURE_INLINE
+	inline mm_expr<A, B> mm(const IMatrixXpr<A, T>& a, const IMatrixXpr<B, T>& b)
+	{
+		return mm_expr<A, B>(a.derived(), b.derived(), T(1));
+	}
+
+	template<typename T, class A, class X>
+	LMAT_ENSURE_INLINE
+	inline mv_expr<A, X> mv(const IMatrixXpr<A, T>& a, const IMatrixXpr<X, T>& x)
+	{
+		return mv_expr<A, X>(a.derived(), x.derived(), T(1));
+	}
+
+	// scaling
+
+	template<class A, class B>
+	LMAT_ENSURE_INLINE
+	inline mm_expr<A, B> operator * (const typename mm_expr<A, B>::value_type& s, const mm_expr<A, B>& p)
+	{
+		return mm_expr<A, B>(p, s);
+	}
+
+	template<class A, class B>
+	LMAT_ENSURE_INLINE
+	inline mm_expr<A, B> operator * (const mm_expr<A, B>& p, const typename mm_expr<A, B>::value_type& s)
+	{
+		return mm_expr<A, B>(p, s);
+	}
+
+	template<class A, class B>
+	LMAT_ENSURE_INLINE
+	inline mm_expr<A, B> operator - (const mm_expr<A, B>& p)
+	{
+		return mm_expr<A, B>(p, -1);
+	}
+
+	template<class A, class X>
+	LMAT_ENSURE_INLINE
+	inline mv_expr<A, X> operator * (const typename mv_expr<A, X>::value_type& s, const mv_expr<A, X>& p)
+	{
+		return mv_expr<A, X>(p, s);
+	}
+
+	template<class A, class X>
+	LMAT_ENSURE_INLINE
+	inline mv_expr<A, X> operator * (const mv_expr<A, X>& p, const typename mv_expr<A, X>::value_type& s)
+	{
+		return mv_expr<A, X>(p, s);
+	}
+
+	template<class A, class X>
+	LMAT_ENSURE_INLINE
+	inline mv_expr<A, X> operator - (const mv_expr<A, X>& p)
+	{
+		return mv_expr<A, X>(p, -1);
+	}
+
+	// fusion with an addend (c, s * c, or c * s)
+
+	namespace internal
+	{
+		template<class P, class E>
+		struct prod_add_result
+		{
+			typedef prod_add_expr<P, typename prod_addend<E>::mat_type> type;
+
+			LMAT_ENSURE_INLINE
+			static type get(const P& p, const E& e, typename P::value_type sign)
+			{
+				typedef typename P::value_type T;
+				return type(p, prod_addend<E>::mat(e), sign * prod_addend<E>::template scale<T>(e));
+			}
+		};
+	}
+
+	template<class A, class B, class E>
+	LMAT_ENSURE_INLINE
+	inline typename std::enable_if<internal::prod_addend<E>::value,
+	typename internal::prod_add_result<mm_expr<A, B>, E>::type>::type
+	operator + (const mm_expr<A, B>& p, const IMatrixXpr<E, typename mm_expr<A, B>::value_type>& e)
+	{
+		return internal::prod_add_result<mm_expr<A, B>, E>::get(p, e.derived(), 1);
+	}
+
+	template<class A, class B, class E>
+	LMAT_ENSURE_INLINE
+	inline typename std::enable_if<internal::prod_addend<E>::value,
+	typename internal::prod_add_result<mm_expr<A, B>, E>::type>::type
+	operator + (const IMatrixXpr<E, typename mm_expr<A, B>::value_type>& e, const mm_expr<A, B>& p)
+	{
+		return internal::prod_add_result<mm_expr<A, B>, E>::get(p, e.derived(), 1);
+	}
+
+	template<class A, class B, class E>
+	LMAT_ENSURE_INLINE
+	inline typename std::enable_if<internal::prod_addend<E>::value,
+	typename internal::prod_add_result<mm_expr<A, B>, E>::type>::type
+	operator - (const mm_expr<A, B>& p, const IMatrixXpr<E, typename mm_expr<A, B>::value_type>& e)
+	{
+		return internal::prod_add_result<mm_expr<A, B>, E>::get(p, e.derived(), -1);
+	}
+
+	template<class A, class B, class E>
+	LMAT_ENSURE_INLINE
+	inline typename std::enable_if<internal::prod_addend<E>::value,
+	typename internal::prod_add_result<mm_expr<A, B>, E>::type>::type
+	operator - (const IMatrixXpr<E, typename mm_expr<A, B>::value_type>& e, const mm_expr<A, B>& p)
+	{
+		return internal::prod_add_result<mm_expr<A, B>, E>::get(-p, e.derived(), 1);
+	}
+
+	template<class A, class X, class E>
+	LMAT_ENSURE_INLINE
+	inline typename std::enable_if<internal::prod_addend<E>::value,
+	typename internal::prod_add_result<mv_expr<A, X>, E>::type>::type
+	operator + (const mv_expr<A, X>& p, const IMatrixXpr<E, typename mv_expr<A, X>::value_type>& e)
+	{
+		return internal::prod_add_result<mv_expr<A, X>, E>::get(p, e.derived(), 1);
+	}
+
+	template<class A, class X, class E>
+	LMAT_ENSURE_INLINE
+	inline typename std::enable_if<internal::prod_addend<E>::value,
+	typename internal::prod_add_result<mv_expr<A, X>, E>::type>::type
+	operator + (const IMatrixXpr<E, typename mv_expr<A, X>::value_type>& e, const mv_expr<A, X>& p)
+	{
+		return internal::prod_add_result<mv_expr<A, X>, E>::get(p, e.derived(), 1);
+	}
+
+	template<class A, class X, class E>
+	LMAT_ENSURE_INLINE
+	inline typename std::enable_if<internal::prod_addend<E>::value,
+	typename internal::prod_add_result<mv_expr<A, X>, E>::type>::type
+	operator - (const mv_expr<A, X>& p, const IMatrixXpr<E, typename mv_expr<A, X>::value_type>& e)
+	{
+		return internal::prod_add_result<mv_expr<A, X>, E>::get(p, e.derived(), -1);
+	}
+
+	template<class A, class X, class E>
+	LMAT_ENSURE_INLINE
+	inline typename std::enable_if<internal::prod_addend<E>::value,
+	typename internal::prod_add_result<mv_expr<A, X>, E>::type>::type
+	operator - (const IMatrixXpr<E, typename mv_expr<A, X>::value_type>& e, const mv_expr<A, X>& p)
+	{
+		return internal::prod_add_result<mv_expr<A, X>, E>::get(-p, e.derived(), 1);
+	}
+
+
+	/********************************************
+	 *
+	 *  evaluation
+	 *
+	 ********************************************/
+
+	namespace internal
+	{
+		// falls back to a temporary only when the destination
+		// overlaps with an operand of the product
+
+		template<class P, class D>
+		inline void eval_prod(const P& p, typename P::value_type beta, D& d)
+		{
+			typedef typename P::value_type T;
+
+			if (!p.aliased_by(d))
+			{
+				p.run(beta, d);
+			}
+			else
+			{
+				dense_matrix<T, meta::nrows<D>::value, meta::ncols<D>::value> t(d.nrows(), d.ncolumns());
+				if (beta != T(0)) lmat::copy(d, t);
+
+				p.run(beta, t);
+				lmat::copy(t, d);
+			}
+		}
+	}
+
+	template<class A, class B, class D>
+	LMAT_ENSURE_INLINE
+	inline void evaluate(const mm_expr<A, B>& expr,
+			IRegularMatrix<D, typename mm_expr<A, B>::value_type>& dmat)
+	{
+		internal::eval_prod(expr, 0, dmat.derived());
+	}
+
+	template<class A, class X, class D>
+	LMAT_ENSURE_INLINE
+	inline void evaluate(const mv_expr<A, X>& expr,
+			IRegularMatrix<D, typename mv_expr<A, X>::value_type>& dmat)
+	{
+		internal::eval_prod(expr, 0, dmat.derived());
+	}
+
+	// the addend is copied to the destination first, unless the
+	// destination is the addend itself (as in c = mm(a, b) + beta * c)
+
+	template<class P, class C, class D>
+	inline void evaluate(const prod_add_expr<P, C>& expr,
+			IRegularMatrix<D, typename prod_add_expr<P, C>::value_type>& dmat)
+	{
+		if (!internal::same_mat(expr.c(), dmat.derived()))
+		{
+			if (expr.prod().aliased_by(dmat.derived()) || internal::mat_overlap(expr.c(), dmat.derived()))
+			{
+				typedef typename prod_add_expr<P, C>::value_type T;
+				dense_matrix<T, meta::nrows<D>::value, meta::ncols<D>::value> t(expr.c());
+				expr.prod().run(expr.beta(), t);
+				copy(t, dmat.derived());
+				return;
+			}
+
+			copy(expr.c(), dmat.derived());
+		}
+
+		internal::eval_prod(expr.prod(), expr.beta(), dmat.derived());
+	}
+
+	// accumulation
+
+	template<class A, class B, class D>
+	LMAT_ENSURE_INLINE
+	inline D& operator += (IRegularMatrix<D, typename mm_expr<A, B>::value_type>& dmat, const mm_expr<A, B>& expr)
+	{
+		internal::eval_prod(expr, 1, dmat.derived());
+		return dmat.derived();
+	}
+
+	template<class A, class B, class D>
+	LMAT_ENSURE_INLINE
+	inline D& operator -= (IRegularMatrix<D, typename mm_expr<A, B>::value_type>& dmat, const mm_expr<A, B>& expr)
+	{
+		internal::eval_prod(mm_expr<A, B>(expr, -1), 1, dmat.derived());
+		return dmat.derived();
+	}
+
+	template<class A, class X, class D>
+	LMAT_ENSURE_INLINE
+	inline D& operator += (IRegularMatrix<D, typename mv_expr<A, X>::value_type>& dmat, const mv_expr<A, X>& expr)
+	{
+		internal::eval_prod(expr, 1, dmat.derived());
+		return dmat.derived();
+	}
+
+	template<class A, class X, class D>
+	LMAT_ENSURE_INLINE
+	inline D& operator -= (IRegularMatrix<D, typename mv_expr<A, X>::value_type>& dmat, const mv_expr<A, X>& expr)
+	{
+		internal::eval_prod(mv_expr<A, X>(expr, -1), 1, dmat.derived());
+		return dmat.derived();
+	}
+
+LMAT_END_NAMESPACE
+
+#endif
@@ -21,8 +21,7 @@
  *
  ************************************************/
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	/************************************************
 	 *
@@ -109,7 +108,7 @@ namespace lmat
 
 	LMAT_DEF_SIMD_SUPPORT( accumx_kernel )
 
-}
+LMAT_END_NAMESPACE
 
 
 #endif /* COMMON_KERNELS_H_ */
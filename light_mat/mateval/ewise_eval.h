@@ -17,8 +17,7 @@
 #include <light_mat/mateval/macc_policy.h>
 #include "internal/ewise_eval_internal.h"
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	/********************************************
 	 *
@@ -73,6 +72,91 @@ namespace lmat
 			internal::_percol_ewise_eval(shape, U(), m_kernel, make_multicol_accessor(U(), wraps)...);
 		}
 
+		// rows of row-major arguments are visited as the columns of the transpose
+
+		template<typename U, typename... Wraps>
+		LMAT_ENSURE_INLINE
+		void eval(macc_<perrow_, U>, index_t m, index_t n, const Wraps&... wraps) const
+		{
+			matrix_shape<0, 0> tshape(n, m);
+			internal::_percol_ewise_eval(tshape, U(), m_kernel, make_multirow_accessor(U(), wraps)...);
+		}
+
+		template<typename U, index_t CM, index_t CN, typename... Wraps>
+		LMAT_ENSURE_INLINE
+		void eval(macc_<perrow_, U>, const matrix_shape<CM, CN>& shape, const Wraps&... wraps) const
+		{
+			matrix_shape<CN, CM> tshape(shape.ncolumns(), shape.nrows());
+			internal::_percol_ewise_eval(tshape, U(), m_kernel, make_multirow_accessor(U(), wraps)...);
+		}
+
+		// parallel evaluation
+
+		template<typename U, typename... Wraps>
+		LMAT_ENSURE_INLINE
+		void eval(macc_<linear_, U, par_>, index_t m, index_t n, const Wraps&... wraps) const
+		{
+			static_assert(meta::all_<supports_parallel_access<Wraps>...>::value,
+					"All arguments must support parallel access.");
+
+			dimension<0> dim(m * n);
+			internal::_par_linear_ewise_eval(dim, U(), m_kernel, make_vec_accessor(U(), wraps)...);
+		}
+
+		template<typename U, index_t CM, index_t CN, typename... Wraps>
+		LMAT_ENSURE_INLINE
+		void eval(macc_<linear_, U, par_>, const matrix_shape<CM, CN>& shape, const Wraps&... wraps) const
+		{
+			static_assert(meta::all_<supports_parallel_access<Wraps>...>::value,
+					"All arguments must support parallel access.");
+
+			dimension<CM * CN> dim(shape.nelems());
+			internal::_par_linear_ewise_eval(dim, U(), m_kernel, make_vec_accessor(U(), wraps)...);
+		}
+
+		template<typename U, typename... Wraps>
+		LMAT_ENSURE_INLINE
+		void eval(macc_<percol_, U, par_>, index_t m, index_t n, const Wraps&... wraps) const
+		{
+			static_assert(meta::all_<supports_parallel_access<Wraps>...>::value,
+					"All arguments must support parallel access.");
+
+			matrix_shape<0, 0> shape(m, n);
+			internal::_par_percol_ewise_eval(shape, U(), m_kernel, make_multicol_accessor(U(), wraps)...);
+		}
+
+		template<typename U, index_t CM, index_t CN, typename... Wraps>
+		LMAT_ENSURE_INLINE
+		void eval(macc_<percol_, U, par_>, const matrix_shape<CM, CN>& shape, const Wraps&... wraps) const
+		{
+			static_assert(meta::all_<supports_parallel_access<Wraps>...>::value,
+					"All arguments must support parallel access.");
+
+			internal::_par_percol_ewise_eval(shape, U(), m_kernel, make_multicol_accessor(U(), wraps)...);
+		}
+
+		template<typename U, typename... Wraps>
+		LMAT_ENSURE_INLINE
+		void eval(macc_<perrow_, U, par_>, index_t m, index_t n, const Wraps&... wraps) const
+		{
+			static_assert(meta::all_<supports_parallel_access<Wraps>...>::value,
+					"All arguments must support parallel access.");
+
+			matrix_shape<0, 0> tshape(n, m);
+			internal::_par_percol_ewise_eval(tshape, U(), m_kernel, make_multirow_accessor(U(), wraps)...);
+		}
+
+		template<typename U, index_t CM, index_t CN, typename... Wraps>
+		LMAT_ENSURE_INLINE
+		void eval(macc_<perrow_, U, par_>, const matrix_shape<CM, CN>& shape, const Wraps&... wraps) const
+		{
+			static_assert(meta::all_<supports_parallel_access<Wraps>...>::value,
+					"All arguments must support parallel access.");
+
+			matrix_shape<CN, CM> tshape(shape.ncolumns(), shape.nrows());
+			internal::_par_percol_ewise_eval(tshape, U(), m_kernel, make_multirow_accessor(U(), wraps)...);
+		}
+
 		template<typename... Wraps>
 		LMAT_ENSURE_INLINE
 		void operator() (index_t m, index_t n, const Wraps&... wraps) const
@@ -87,6 +171,24 @@ namespace lmat
 			eval(get_preferred_macc_policy(shape, m_kernel, wraps...), shape, wraps...);
 		}
 
+		/**
+		 * Evaluates in parallel when all arguments support parallel access,
+		 * and falls back to sequential evaluation otherwise.
+		 */
+		template<typename... Wraps>
+		LMAT_ENSURE_INLINE
+		void operator() (par_, index_t m, index_t n, const Wraps&... wraps) const
+		{
+			eval(get_preferred_macc_policy(par_(), m, n, m_kernel, wraps...), m, n, wraps...);
+		}
+
+		template<index_t CM, index_t CN, typename... Wraps>
+		LMAT_ENSURE_INLINE
+		void operator() (par_, const matrix_shape<CM, CN>& shape, const Wraps&... wraps) const
+		{
+			eval(get_preferred_macc_policy(par_(), shape, m_kernel, wraps...), shape, wraps...);
+		}
+
 	private:
 		const Kernel& m_kernel;
 	};
@@ -155,9 +257,9 @@ namespace lmat
 	 *
 	 ********************************************/
 
-	template<typename T, typename Acc, typename U, class Expr, class DMat>
+	template<typename T, typename Acc, typename U, typename Exec, class Expr, class DMat>
 	LMAT_ENSURE_INLINE
-	inline void macc_evaluate(const IEWiseMatrix<Expr, T>& s, IRegularMatrix<DMat, T>& d, macc_<Acc, U> policy)
+	inline void macc_evaluate(const IEWiseMatrix<Expr, T>& s, IRegularMatrix<DMat, T>& d, macc_<Acc, U, Exec> policy)
 	{
 		ewise(copy_kernel<T>()).eval(policy, common_shape(s.derived(), d.derived()), in_(s), out_(d));
 	}
@@ -169,6 +271,13 @@ namespace lmat
 		ewise(copy_kernel<T>())(common_shape(s.derived(), d.derived()), in_(s), out_(d));
 	}
 
-}
+	template<typename T, class Expr, class DMat>
+	LMAT_ENSURE_INLINE
+	inline void macc_evaluate(const IEWiseMatrix<Expr, T>& s, IRegularMatrix<DMat, T>& d, par_)
+	{
+		ewise(copy_kernel<T>())(par_(), common_shape(s.derived(), d.derived()), in_(s), out_(d));
+	}
+
+LMAT_END_NAMESPACE
 
 #endif /* EWISE_EVAL_H_ */
@@ -16,10 +16,11 @@
 #include <light_mat/matrix/matrix_properties.h>
 #include <light_mat/mateval/vec_accessors.h>
 #include <light_mat/mateval/multicol_accessors.h>
+#include <light_mat/common/parallel.h>
 
 #include <light_mat/math/functor_base.h>
 
-namespace lmat { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace internal {
 
 	/********************************************
 	 *
@@ -42,6 +43,110 @@ namespace lmat { namespace internal {
 		pass(accessors.finalize()...);
 	}
 
+	// the remaining part [i0, len) that does not fill a pack
+
+	template<typename SKind, class Kernel, typename... Accessors>
+	LMAT_ENSURE_INLINE
+	inline void _linear_ewise_rem(index_t i0, index_t len, meta::false_,
+			const Kernel& kernel, const Accessors&... accessors)
+	{
+		for (index_t i = i0; i < len; ++i)
+		{
+			kernel(accessors.scalar(i)...);
+			pass(accessors.done_scalar(i)...);
+		}
+	}
+
+	template<typename SKind, class Kernel, typename... Accessors>
+	LMAT_ENSURE_INLINE
+	inline void _linear_ewise_rem(index_t i0, index_t len, meta::true_,
+			const Kernel& kernel, const Accessors&... accessors)
+	{
+		// one partial pack with masked load/store
+
+		if (i0 < len)
+		{
+			const index_t n = len - i0;
+			auto pk_kernel = lmat::simdize_map<Kernel, SKind>::get(kernel);
+
+			pass(accessors.begin_packs()...);
+			pk_kernel(accessors.pack_part(i0, n)...);
+			pass(accessors.done_pack_part(i0, n)...);
+			pass(accessors.end_packs()...);
+		}
+	}
+
+	// the packs over [i0, len), which returns the end of the last pack
+
+	template<typename SKind, class Kernel, typename... Accessors>
+	LMAT_ENSURE_INLINE
+	inline index_t _linear_ewise_packs(index_t i0, index_t len,
+			const Kernel& kernel, const Accessors&... accessors)
+	{
+		typedef typename Kernel::value_type T;
+		const unsigned int W = simd_traits<T, SKind>::pack_width;
+		const index_t W_ = static_cast<index_t>(W);
+
+		const unsigned int W2 = W * 2;
+		const index_t W2_ = static_cast<index_t>(W2);
+
+		const size_t rlen = static_cast<size_t>(len - i0);
+		const size_t npacks = int_div<W>::quo(rlen);
+		auto pk_kernel = lmat::simdize_map<Kernel, SKind>::get(kernel);
+
+		index_t maj_end;
+
+		if (npacks > 1)
+		{
+			maj_end = i0 + static_cast<index_t>(int_div<W2>::maj(rlen));
+			pass(accessors.begin_packs()...);
+
+			for (index_t i = i0; i < maj_end; i += W2_)
+			{
+				pk_kernel(accessors.pack(i)...);
+				pass(accessors.done_pack(i)...);
+				pk_kernel(accessors.pack(i + W_)...);
+				pass(accessors.done_pack(i + W_)...);
+			}
+
+			if (npacks & 1)
+			{
+				pk_kernel(accessors.pack(maj_end)...);
+				pass(accessors.done_pack(maj_end)...);
+				maj_end += W_;
+			}
+
+			pass(accessors.end_packs()...);
+		}
+		else // npacks == 1
+		{
+			maj_end = i0 + W_;
+			pass(accessors.begin_packs()...);
+			pk_kernel(accessors.pack(i0)...);
+			pass(accessors.done_pack(i0)...);
+			pass(accessors.end_packs()...);
+		}
+
+		return maj_end;
+	}
+
+	// the number of leading scalars to peel off, such that the
+	// packs of the first accessor with a preference are aligned
+
+	LMAT_ENSURE_INLINE
+	inline index_t _linear_peel_len()
+	{
+		return 0;
+	}
+
+	template<class Acc, typename... Rest>
+	LMAT_ENSURE_INLINE
+	inline index_t _linear_peel_len(const Acc& acc, const Rest&... rest)
+	{
+		const index_t h = pack_peel_hint(acc, 0);
+		return h >= 0 ? h : _linear_peel_len(rest...);
+	}
+
 	template<index_t Len, typename SKind, class Kernel, typename... Accessors>
 	inline void _linear_ewise_eval(
 			const dimension<Len>& dim, simd_<SKind>,
@@ -50,66 +155,35 @@ namespace lmat { namespace internal {
 		static_assert(is_simdizable<Kernel, SKind>::value, "kernel must be simdizable.");
 
 		typedef typename Kernel::value_type T;
-		const unsigned int W = simd_traits<T, SKind>::pack_width;
-		const index_t W_ = static_cast<index_t>(W);
+		const index_t W_ = static_cast<index_t>(simd_traits<T, SKind>::pack_width);
 
 		const index_t len = dim.value();
 
+		typedef meta::bool_<meta::all_<supports_pack_part<Accessors>...>::value> use_part;
+		const bool use_peel = meta::all_<supports_pack_peel<Accessors>...>::value;
+
 		if (len >= W_)
 		{
-			const unsigned int W2 = W * 2;
-			const index_t W2_ = static_cast<index_t>(W2);
+			index_t i0 = 0;
 
-			const size_t npacks = int_div<W>::quo(static_cast<size_t>(len));
-			auto pk_kernel = lmat::simdize_map<Kernel, SKind>::get(kernel);
-
-			index_t maj_len;
-
-			if (npacks > 1)
+			if (use_peel && len >= 2 * W_)
 			{
-				maj_len = static_cast<index_t>(int_div<W2>::maj(static_cast<size_t>(len)));
-				pass(accessors.begin_packs()...);
-
-				for (index_t i = 0; i < maj_len; i += W2_)
-				{
-					pk_kernel(accessors.pack(i)...);
-					pass(accessors.done_pack(i)...);
-					pk_kernel(accessors.pack(i + W_)...);
-					pass(accessors.done_pack(i + W_)...);
-				}
+				// scalars before the first aligned pack of the output
 
-				if (npacks & 1)
+				i0 = _linear_peel_len(accessors...);
+				for (index_t i = 0; i < i0; ++i)
 				{
-					pk_kernel(accessors.pack(maj_len)...);
-					pass(accessors.done_pack(maj_len)...);
-					maj_len += W_;
+					kernel(accessors.scalar(i)...);
+					pass(accessors.done_scalar(i)...);
 				}
-
-				pass(accessors.end_packs()...);
-
-			}
-			else // npacks == 1
-			{
-				maj_len = W_;
-				pass(accessors.begin_packs()...);
-				pk_kernel(accessors.pack(0)...);
-				pass(accessors.done_pack(0)...);
-				pass(accessors.end_packs()...);
 			}
 
-			for (index_t i = maj_len; i < len; ++i)
-			{
-				kernel(accessors.scalar(i)...);
-				pass(accessors.done_scalar(i)...);
-			}
+			const index_t maj_len = _linear_ewise_packs<SKind>(i0, len, kernel, accessors...);
+			_linear_ewise_rem<SKind>(maj_len, len, use_part(), kernel, accessors...);
 		}
 		else
 		{
-			for (index_t i = 0; i < len; ++i)
-			{
-				kernel(accessors.scalar(i)...);
-				pass(accessors.done_scalar(i)...);
-			}
+			_linear_ewise_rem<SKind>(0, len, use_part(), kernel, accessors...);
 		}
 
 		pass(accessors.finalize()...);
@@ -137,7 +211,98 @@ namespace lmat { namespace internal {
 	}
 
 
+	/********************************************
+	 *
+	 *  parallel evaluation
+	 *
+	 ********************************************/
+
+	template<class Kernel, typename U>
+	struct _par_chunk_align
+	{
+		static const index_t value = 1;
+	};
+
+	template<class Kernel, typename Kind>
+	struct _par_chunk_align<Kernel, simd_<Kind> >
+	{
+		typedef typename Kernel::value_type T;
+		static const index_t value = (index_t)simd_traits<T, Kind>::pack_width;
+	};
+
+	template<class Kernel>
+	LMAT_ENSURE_INLINE
+	inline index_t _par_chunk_len()
+	{
+		typedef typename Kernel::value_type T;
+		const index_t c = (index_t)(LMAT_PAR_CHUNK_BYTES / sizeof(T));
+		return c > 0 ? c : 1;
+	}
+
+
+	template<index_t Len, typename U, class Kernel, typename... Accessors>
+	inline void _par_linear_ewise_eval(
+			const dimension<Len>& dim, U,
+			const Kernel& kernel, const Accessors&... accessors)
+	{
+		const index_t len = dim.value();
+
+		if (!par_worthy(len, LMAT_PAR_MIN_ELEMS))
+		{
+			_linear_ewise_eval(dim, U(), kernel, accessors...);
+			return;
+		}
+
+		par_partition part(len, _par_chunk_len<Kernel>(), _par_chunk_align<Kernel, U>::value);
+		const index_t nc = part.nchunks();
+
+#ifdef LMAT_HAS_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+		for (index_t k = 0; k < nc; ++k)
+		{
+			const index_t i0 = part.chunk_begin(k);
+			_linear_ewise_eval(dimension<0>(part.chunk_length(k)), U(), kernel,
+					make_offset_vec_accessor(U(), accessors, i0)...);
+		}
+	}
+
+
+	template<index_t CM, index_t CN, typename U, class Kernel, typename... MultiColAccessors>
+	inline void _par_percol_ewise_eval(
+			const matrix_shape<CM, CN>& shape, U,
+			const Kernel& kernel, const MultiColAccessors&... accessors)
+	{
+		const index_t m = shape.nrows();
+		const index_t n = shape.ncolumns();
+
+		if (!par_worthy(m * n, LMAT_PAR_MIN_ELEMS))
+		{
+			_percol_ewise_eval(shape, U(), kernel, accessors...);
+			return;
+		}
+
+		// each work unit is a (column, row-chunk) pair
+
+		par_partition part(m, _par_chunk_len<Kernel>(), _par_chunk_align<Kernel, U>::value);
+		const index_t nc = part.nchunks();
+		const index_t nunits = nc * n;
+
+#ifdef LMAT_HAS_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+		for (index_t u = 0; u < nunits; ++u)
+		{
+			const index_t j = u / nc;
+			const index_t k = u - j * nc;
+			const index_t i0 = part.chunk_begin(k);
+
+			_linear_ewise_eval(dimension<0>(part.chunk_length(k)), U(), kernel,
+					make_offset_vec_accessor(U(), accessors.col(j), i0)...);
+		}
+	}
+
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif
@@ -17,7 +17,7 @@
 #include <light_mat/mateval/macc_policy.h>
 #include <light_mat/simd/simd.h>
 
-namespace lmat { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace internal {
 
 
 	template<index_t N, typename T, class Reader>
@@ -199,6 +199,6 @@ namespace lmat { namespace internal {
 	}
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif /* MAT_ALLANY_INTERNAL_H_ */
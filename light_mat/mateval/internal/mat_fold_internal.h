@@ -15,9 +15,13 @@
 #define LIGHTMAT_MAT_FOLD_INTERNAL_H_
 
 #include <light_mat/mateval/macc_policy.h>
+#include <light_mat/mateval/internal/ewise_eval_internal.h>
+#include <light_mat/common/parallel.h>
 
+#include <vector>
 
-namespace lmat { namespace internal {
+
+LMAT_BEGIN_NAMESPACE namespace internal {
 
 	template<class FoldKernel, class Shape, typename... Args>
 	struct fold_policy
@@ -27,21 +31,30 @@ namespace lmat { namespace internal {
 
 		typedef default_simd_kind skind;
 
-		static const bool supp_simd =
-				is_simdizable<FoldKernel, skind>::value &&
+		static const bool args_supp_simd =
 				meta::all_<supports_simd<Args, skind>...>::value;
 
 		static const bool use_linear = supp_linear;
 
+		static const bool use_perrow = !use_linear && !args_supp_simd &&
+				meta::all_<supports_perrow_access<Args>...>::value;
+
+		static const bool supp_simd =
+				is_simdizable<FoldKernel, skind>::value &&
+				(use_perrow ?
+					meta::all_<supports_perrow_simd<Args, skind>...>::value :
+					args_supp_simd);
+
 		static const index_t _len =
-				use_linear ? (Shape::ct_nrows * Shape::ct_ncols) : Shape::ct_nrows;
+				use_linear ? (Shape::ct_nrows * Shape::ct_ncols) :
+				(use_perrow ? Shape::ct_ncols : Shape::ct_nrows);
 
 		static const unsigned int pack_width =
 				internal::_kernel_packwidth<FoldKernel, skind,
 				is_simdizable<FoldKernel, skind>::value>::value;
 
-		typedef typename std::conditional<use_linear,
-				linear_, percol_>::type access;
+		typedef typename std::conditional<use_linear, linear_,
+				typename std::conditional<use_perrow, perrow_, percol_>::type>::type access;
 
 		static const bool use_simd = supp_simd && ((unsigned int)_len % pack_width == 0);
 
@@ -50,6 +63,49 @@ namespace lmat { namespace internal {
 		typedef macc_<access, unit> type;
 	};
 
+	template<class FoldKernel, class Shape, typename... Args>
+	struct par_fold_policy
+	{
+		typedef fold_policy<FoldKernel, Shape, Args...> _seq_map;
+
+		static const bool use_parallel =
+				meta::all_<supports_parallel_access<Args>...>::value;
+
+		typedef macc_<typename _seq_map::access, typename _seq_map::unit,
+				typename std::conditional<use_parallel, par_, seq_>::type> type;
+	};
+
+	/********************************************
+	 *
+	 *  combination of partial results
+	 *
+	 *  By default, a kernel combines two partial
+	 *  results with operator()(a, b). A kernel that
+	 *  folds one input per step cannot do so, as
+	 *  the signature would be the same as that of
+	 *  a folding step, so it specializes this.
+	 *
+	 ********************************************/
+
+	template<class FoldKernel>
+	struct fold_combiner
+	{
+		template<typename RT>
+		LMAT_ENSURE_INLINE
+		static void combine(const FoldKernel& fker, RT& a, const RT& b)
+		{
+			fker(a, b);
+		}
+	};
+
+	template<class FoldKernel, typename RT>
+	LMAT_ENSURE_INLINE
+	inline void fold_combine(const FoldKernel& fker, RT& a, const RT& b)
+	{
+		fold_combiner<FoldKernel>::combine(fker, a, b);
+	}
+
+
 	/********************************************
 	 *
 	 *  core implementation
@@ -110,8 +166,8 @@ namespace lmat { namespace internal {
 					pk_fker(a3, rd.pack(i + pw * 3)...);
 				}
 
-				pk_fker(a0, a2);
-				pk_fker(a1, a3);
+				fold_combine(pk_fker, a0, a2);
+				fold_combine(pk_fker, a1, a3);
 
 				if (npacks & 2)
 				{
@@ -120,7 +176,7 @@ namespace lmat { namespace internal {
 					i += pw * 2;
 				}
 
-				pk_fker(a0, a1);
+				fold_combine(pk_fker, a0, a1);
 
 				if (npacks & 1)
 				{
@@ -175,12 +231,125 @@ namespace lmat { namespace internal {
 		for (index_t j = 1; j < n; ++j)
 		{
 			RT rj = linear_fold_impl(col_dim, U(), fker, rd.col(j)...);
-			fker(r, rj);
+			fold_combine(fker, r, rj);
 		}
 
 		return r;
 	}
 
-} }
+
+	/********************************************
+	 *
+	 *  parallel implementation
+	 *
+	 *  The data are partitioned into as many
+	 *  chunks as there are threads. The partial
+	 *  results are combined in a fixed pairwise
+	 *  tree order, such that the result is
+	 *  reproducible for a given number of threads.
+	 *
+	 ********************************************/
+
+	template<class FoldKernel, typename RT>
+	inline void _par_tree_combine(const FoldKernel& fker, RT *partials, index_t n)
+	{
+		for (index_t s = 1; s < n; s <<= 1)
+		{
+			for (index_t k = 0; k + s < n; k += (s << 1))
+			{
+				fold_combine(fker, partials[k], partials[k + s]);
+			}
+		}
+	}
+
+	template<index_t Len, typename U, class FoldKernel, typename... Reader>
+	inline typename FoldKernel::accumulated_type
+	par_linear_fold_impl(const dimension<Len>& dim, U, const FoldKernel& fker, const Reader&... rd)
+	{
+		typedef typename FoldKernel::accumulated_type RT;
+
+		const index_t len = dim.value();
+		if (!par_worthy(len, LMAT_PAR_MIN_ELEMS))
+		{
+			return linear_fold_impl(dim, U(), fker, rd...);
+		}
+
+		par_partition part = par_even_partition(len, par_max_threads(),
+				_par_chunk_align<FoldKernel, U>::value);
+		const index_t nc = part.nchunks();
+
+		std::vector<RT> partials((size_t)nc, fker.init(rd.scalar(0)...));
+
+#ifdef LMAT_HAS_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+		for (index_t k = 0; k < nc; ++k)
+		{
+			const index_t i0 = part.chunk_begin(k);
+			partials[(size_t)k] = linear_fold_impl(dimension<0>(part.chunk_length(k)), U(), fker,
+					make_offset_vec_accessor(U(), rd, i0)...);
+		}
+
+		_par_tree_combine(fker, partials.data(), nc);
+		return partials[0];
+	}
+
+	template<index_t CM, index_t CN, typename U, class FoldKernel, typename... Reader>
+	inline typename FoldKernel::accumulated_type
+	par_percol_fold_impl(const matrix_shape<CM, CN>& shape, U, const FoldKernel& fker, const Reader&... rd)
+	{
+		typedef typename FoldKernel::accumulated_type RT;
+
+		dimension<CM> col_dim(shape.nrows());
+		const index_t n = shape.ncolumns();
+		const index_t nt = par_max_threads();
+
+		if (!par_worthy(shape.nelems(), LMAT_PAR_MIN_ELEMS))
+		{
+			return percol_fold_impl(shape, U(), fker, rd...);
+		}
+
+		if (n < nt)
+		{
+			// few long columns: parallelize within each column
+
+			RT r = par_linear_fold_impl(col_dim, U(), fker, rd.col(0)...);
+			for (index_t j = 1; j < n; ++j)
+			{
+				RT rj = par_linear_fold_impl(col_dim, U(), fker, rd.col(j)...);
+				fold_combine(fker, r, rj);
+			}
+			return r;
+		}
+
+		// many columns: each thread takes a contiguous range of columns
+
+		par_partition part = par_even_partition(n, nt, 1);
+		const index_t nc = part.nchunks();
+
+		std::vector<RT> partials((size_t)nc, fker.init(rd.col(0).scalar(0)...));
+
+#ifdef LMAT_HAS_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+		for (index_t k = 0; k < nc; ++k)
+		{
+			const index_t j0 = part.chunk_begin(k);
+			const index_t j1 = j0 + part.chunk_length(k);
+
+			RT r = linear_fold_impl(col_dim, U(), fker, rd.col(j0)...);
+			for (index_t j = j0 + 1; j < j1; ++j)
+			{
+				RT rj = linear_fold_impl(col_dim, U(), fker, rd.col(j)...);
+				fold_combine(fker, r, rj);
+			}
+			partials[(size_t)k] = r;
+		}
+
+		_par_tree_combine(fker, partials.data(), nc);
+		return partials[0];
+	}
+
+} LMAT_END_NAMESPACE
 
 #endif 
@@ -18,7 +18,7 @@
 #include <light_mat/math/math_functors.h>
 #include <light_mat/matexpr/mat_arith.h>
 
-namespace lmat { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace internal {
 
 
 	/********************************************
@@ -228,6 +228,23 @@ namespace lmat { namespace internal {
 		}
 	}
 
+	template<index_t CM, index_t CN, class FoldKernel, typename T, class DMat, class AExpr, class BExpr>
+	inline void colwise_fold_impl(const matrix_shape<CM, CN>& shape,
+			const FoldKernel& kernel, IRegularMatrix<DMat, T>& dmat,
+			const IEWiseMatrix<AExpr, T>& a, const IEWiseMatrix<BExpr, T>& b)
+	{
+		const index_t n = shape.ncolumns();
+		LMAT_CHECK_DIMS( n == dmat.nelems() )
+
+		auto g = make_colwise_fold_getter(kernel, shape, a, b);
+
+		DMat& d_ = dmat.derived();
+		for (index_t j = 0; j < n; ++j)
+		{
+			d_[j] = g[j];
+		}
+	}
+
 	// row wise reduction
 
 	template<index_t CM, index_t CN, class FoldKernel, typename T, class DMat, class TExpr>
@@ -256,6 +273,283 @@ namespace lmat { namespace internal {
 	}
 
 
-} }
+	// row wise reduction through a fused multiply-add kernel
+	// (sqsum_kernel, dot_kernel, diff_sqsum_kernel), which folds
+	// one or two inputs into accumulators that start from zero
+
+	template<index_t CM, typename U, class FoldKernel, class DAcc, typename... Reader>
+	LMAT_ENSURE_INLINE
+	inline void _rowwise_fma_fold(const dimension<CM>& col_dim, index_t n, U,
+			const FoldKernel& kernel, const DAcc& a, const Reader&... rd)
+	{
+		for (index_t j = 0; j < n; ++j)
+		{
+			internal::_linear_ewise_eval(col_dim, U(), kernel, a, rd.col(j)...);
+		}
+	}
+
+	template<index_t CM, index_t CN, class FoldKernel, typename T, class DMat, class TExpr>
+	inline void rowwise_fma_fold_impl(const matrix_shape<CM, CN>& shape,
+			const FoldKernel& kernel, IRegularMatrix<DMat, T>& dmat, const IEWiseMatrix<TExpr, T>& texpr)
+	{
+		dimension<CM> col_dim(shape.nrows());
+		LMAT_CHECK_DIMS( col_dim.value() == dmat.nelems() )
+
+		typedef preferred_macc_policy<matrix_shape<CM, 1>, FoldKernel, DMat, TExpr> pmap;
+		typedef typename pmap::unit U;
+
+		lmat::fill(dmat.derived(), T(0));
+
+		_rowwise_fma_fold(col_dim, shape.ncolumns(), U(), kernel,
+				make_vec_accessor(U(), in_out_(dmat)),
+				make_multicol_accessor(U(), in_(texpr)));
+	}
+
+	template<index_t CM, index_t CN, class FoldKernel, typename T, class DMat, class AExpr, class BExpr>
+	inline void rowwise_fma_fold_impl(const matrix_shape<CM, CN>& shape,
+			const FoldKernel& kernel, IRegularMatrix<DMat, T>& dmat,
+			const IEWiseMatrix<AExpr, T>& a, const IEWiseMatrix<BExpr, T>& b)
+	{
+		dimension<CM> col_dim(shape.nrows());
+		LMAT_CHECK_DIMS( col_dim.value() == dmat.nelems() )
+
+		typedef preferred_macc_policy<matrix_shape<CM, 1>, FoldKernel, DMat, AExpr, BExpr> pmap;
+		typedef typename pmap::unit U;
+
+		lmat::fill(dmat.derived(), T(0));
+
+		_rowwise_fma_fold(col_dim, shape.ncolumns(), U(), kernel,
+				make_vec_accessor(U(), in_out_(dmat)),
+				make_multicol_accessor(U(), in_(a)),
+				make_multicol_accessor(U(), in_(b)));
+	}
+
+
+	/********************************************
+	 *
+	 *  parallel vector-wise reduction
+	 *
+	 *  Each output element is computed by exactly
+	 *  one thread, following the same order as
+	 *  the sequential version. Hence, the results
+	 *  do not depend on the number of threads.
+	 *
+	 ********************************************/
+
+	template<index_t CM, index_t CN, class FoldKernel, typename T, class DMat, class TExpr>
+	inline void colwise_fold_impl(const matrix_shape<CM, CN>& shape,
+			const FoldKernel& kernel, IRegularMatrix<DMat, T>& dmat, const IEWiseMatrix<TExpr, T>& texpr, par_)
+	{
+		const index_t n = shape.ncolumns();
+		LMAT_CHECK_DIMS( n == dmat.nelems() )
+
+		if (!supports_parallel_access<TExpr>::value || !par_worthy(shape.nelems(), LMAT_PAR_MIN_ELEMS))
+		{
+			colwise_fold_impl(shape, kernel, dmat, texpr);
+			return;
+		}
+
+		typedef fold_policy<FoldKernel, matrix_shape<CM, 1>, TExpr> pmap;
+		typedef typename pmap::unit U;
+
+		dimension<CM> col_dim(shape.nrows());
+		auto rd = make_multicol_accessor(U(), in_(texpr.derived()));
+		DMat& d_ = dmat.derived();
+
+		if (n < par_max_threads())
+		{
+			// few long columns: parallelize within each column
+
+			for (index_t j = 0; j < n; ++j)
+			{
+				d_[j] = par_linear_fold_impl(col_dim, U(), kernel, rd.col(j));
+			}
+		}
+		else
+		{
+#ifdef LMAT_HAS_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+			for (index_t j = 0; j < n; ++j)
+			{
+				d_[j] = linear_fold_impl(col_dim, U(), kernel, rd.col(j));
+			}
+		}
+	}
+
+
+	template<index_t CM, index_t CN, class FoldKernel, typename T, class DMat, class TExpr>
+	inline void rowwise_fold_impl(const matrix_shape<CM, CN>& shape,
+			const FoldKernel& kernel, IRegularMatrix<DMat, T>& dmat, const IEWiseMatrix<TExpr, T>& texpr, par_)
+	{
+		const index_t m = shape.nrows();
+		const index_t n = shape.ncolumns();
+
+		LMAT_CHECK_DIMS( m == dmat.nelems() )
+
+		if (!supports_parallel_access<TExpr>::value ||
+			!supports_parallel_access<DMat>::value ||
+			!par_worthy(shape.nelems(), LMAT_PAR_MIN_ELEMS))
+		{
+			rowwise_fold_impl(shape, kernel, dmat, texpr);
+			return;
+		}
+
+		typedef preferred_macc_policy<matrix_shape<CM, 1>, FoldKernel, DMat, TExpr> pmap;
+		typedef typename pmap::unit U;
+
+		auto a = make_vec_accessor(U(), in_out_(dmat));
+		auto rd = make_multicol_accessor(U(), in_(texpr));
+
+		// each thread takes a contiguous range of rows across all columns
+
+		par_partition part = par_even_partition(m, par_max_threads(),
+				_par_chunk_align<FoldKernel, U>::value);
+		const index_t nc = part.nchunks();
+
+#ifdef LMAT_HAS_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+		for (index_t k = 0; k < nc; ++k)
+		{
+			const index_t i0 = part.chunk_begin(k);
+			dimension<0> dim(part.chunk_length(k));
+
+			auto ak = make_offset_vec_accessor(U(), a, i0);
+
+			_linear_ewise_eval(dim, U(), copy_kernel<T>(), make_offset_vec_accessor(U(), rd.col(0), i0), ak);
+
+			for (index_t j = 1; j < n; ++j)
+			{
+				_linear_ewise_eval(dim, U(), kernel, ak, make_offset_vec_accessor(U(), rd.col(j), i0));
+			}
+		}
+	}
+
+
+	template<index_t CM, index_t CN, class FoldKernel, typename T, class DMat, class AExpr, class BExpr>
+	inline void colwise_fold_impl(const matrix_shape<CM, CN>& shape,
+			const FoldKernel& kernel, IRegularMatrix<DMat, T>& dmat,
+			const IEWiseMatrix<AExpr, T>& a, const IEWiseMatrix<BExpr, T>& b, par_)
+	{
+		const index_t n = shape.ncolumns();
+		LMAT_CHECK_DIMS( n == dmat.nelems() )
+
+		if (!supports_parallel_access<AExpr>::value ||
+			!supports_parallel_access<BExpr>::value ||
+			!par_worthy(shape.nelems(), LMAT_PAR_MIN_ELEMS))
+		{
+			colwise_fold_impl(shape, kernel, dmat, a, b);
+			return;
+		}
+
+		typedef fold_policy<FoldKernel, matrix_shape<CM, 1>, AExpr, BExpr> pmap;
+		typedef typename pmap::unit U;
+
+		dimension<CM> col_dim(shape.nrows());
+		auto rd1 = make_multicol_accessor(U(), in_(a.derived()));
+		auto rd2 = make_multicol_accessor(U(), in_(b.derived()));
+		DMat& d_ = dmat.derived();
+
+		if (n < par_max_threads())
+		{
+			for (index_t j = 0; j < n; ++j)
+			{
+				d_[j] = par_linear_fold_impl(col_dim, U(), kernel, rd1.col(j), rd2.col(j));
+			}
+		}
+		else
+		{
+#ifdef LMAT_HAS_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+			for (index_t j = 0; j < n; ++j)
+			{
+				d_[j] = linear_fold_impl(col_dim, U(), kernel, rd1.col(j), rd2.col(j));
+			}
+		}
+	}
+
+
+	// each thread takes a contiguous range of rows across all columns
+
+	template<typename U, class FoldKernel, class DAcc, typename... Reader>
+	inline void _par_rowwise_fma_fold(index_t m, index_t n, U,
+			const FoldKernel& kernel, const DAcc& a, const Reader&... rd)
+	{
+		par_partition part = par_even_partition(m, par_max_threads(),
+				_par_chunk_align<FoldKernel, U>::value);
+		const index_t nc = part.nchunks();
+
+#ifdef LMAT_HAS_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+		for (index_t k = 0; k < nc; ++k)
+		{
+			const index_t i0 = part.chunk_begin(k);
+			dimension<0> dim(part.chunk_length(k));
+
+			auto ak = make_offset_vec_accessor(U(), a, i0);
+
+			for (index_t j = 0; j < n; ++j)
+			{
+				_linear_ewise_eval(dim, U(), kernel, ak, make_offset_vec_accessor(U(), rd.col(j), i0)...);
+			}
+		}
+	}
+
+	template<index_t CM, index_t CN, class FoldKernel, typename T, class DMat, class TExpr>
+	inline void rowwise_fma_fold_impl(const matrix_shape<CM, CN>& shape,
+			const FoldKernel& kernel, IRegularMatrix<DMat, T>& dmat, const IEWiseMatrix<TExpr, T>& texpr, par_)
+	{
+		LMAT_CHECK_DIMS( shape.nrows() == dmat.nelems() )
+
+		if (!supports_parallel_access<TExpr>::value ||
+			!supports_parallel_access<DMat>::value ||
+			!par_worthy(shape.nelems(), LMAT_PAR_MIN_ELEMS))
+		{
+			rowwise_fma_fold_impl(shape, kernel, dmat, texpr);
+			return;
+		}
+
+		typedef preferred_macc_policy<matrix_shape<CM, 1>, FoldKernel, DMat, TExpr> pmap;
+		typedef typename pmap::unit U;
+
+		lmat::fill(dmat.derived(), T(0));
+
+		_par_rowwise_fma_fold(shape.nrows(), shape.ncolumns(), U(), kernel,
+				make_vec_accessor(U(), in_out_(dmat)),
+				make_multicol_accessor(U(), in_(texpr)));
+	}
+
+	template<index_t CM, index_t CN, class FoldKernel, typename T, class DMat, class AExpr, class BExpr>
+	inline void rowwise_fma_fold_impl(const matrix_shape<CM, CN>& shape,
+			const FoldKernel& kernel, IRegularMatrix<DMat, T>& dmat,
+			const IEWiseMatrix<AExpr, T>& a, const IEWiseMatrix<BExpr, T>& b, par_)
+	{
+		LMAT_CHECK_DIMS( shape.nrows() == dmat.nelems() )
+
+		if (!supports_parallel_access<AExpr>::value ||
+			!supports_parallel_access<BExpr>::value ||
+			!supports_parallel_access<DMat>::value ||
+			!par_worthy(shape.nelems(), LMAT_PAR_MIN_ELEMS))
+		{
+			rowwise_fma_fold_impl(shape, kernel, dmat, a, b);
+			return;
+		}
+
+		typedef preferred_macc_policy<matrix_shape<CM, 1>, FoldKernel, DMat, AExpr, BExpr> pmap;
+		typedef typename pmap::unit U;
+
+		lmat::fill(dmat.derived(), T(0));
+
+		_par_rowwise_fma_fold(shape.nrows(), shape.ncolumns(), U(), kernel,
+				make_vec_accessor(U(), in_out_(dmat)),
+				make_multicol_accessor(U(), in_(a)),
+				make_multicol_accessor(U(), in_(b)));
+	}
+
+
+} LMAT_END_NAMESPACE
 
 #endif 
@@ -15,7 +15,7 @@
 
 #include <light_mat/mateval/ewise_eval.h>
 
-namespace lmat { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace internal {
 
 	// count
 
@@ -64,6 +64,6 @@ namespace lmat { namespace internal {
 		}
 	};
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif /* MATRIX_ALGS_INTERNAL_H_ */
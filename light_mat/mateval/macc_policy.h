@@ -16,39 +16,65 @@
 #include <light_mat/mateval/mateval_fwd.h>
 #include <light_mat/matrix/matrix_concepts.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	// Policies
 
 	struct linear_ { };
 	struct percol_ { };
+	struct perrow_ { };
 
-	template<typename Acc, typename U> struct macc_ { };
+	// execution
 
-	template<typename U>
+	struct seq_ { };
+	struct par_ { };
+
+	template<typename Acc, typename U, typename Exec=seq_> struct macc_ { };
+
+	template<typename U, typename Exec>
 	LMAT_ENSURE_INLINE
-	inline bool use_linear_acc(macc_<linear_, U>)
+	inline bool use_linear_acc(macc_<linear_, U, Exec>)
 	{
 		return true;
 	}
 
-	template<typename U>
+	template<typename U, typename Exec>
+	LMAT_ENSURE_INLINE
+	inline bool use_linear_acc(macc_<percol_, U, Exec>)
+	{
+		return false;
+	}
+
+	template<typename U, typename Exec>
 	LMAT_ENSURE_INLINE
-	inline bool use_linear_acc(macc_<percol_, U>)
+	inline bool use_linear_acc(macc_<perrow_, U, Exec>)
 	{
 		return false;
 	}
 
+	template<typename Acc, typename U, typename Exec>
+	LMAT_ENSURE_INLINE
+	inline bool use_simd(macc_<Acc, U, Exec>)
+	{
+		return false;
+	}
+
+	template<typename Acc, typename Kind, typename Exec>
+	LMAT_ENSURE_INLINE
+	inline bool use_simd(macc_<Acc, simd_<Kind>, Exec>)
+	{
+		return true;
+	}
+
 	template<typename Acc, typename U>
 	LMAT_ENSURE_INLINE
-	inline bool use_simd(macc_<Acc, U>)
+	inline bool use_parallel(macc_<Acc, U, seq_>)
 	{
 		return false;
 	}
 
-	template<typename Acc, typename Kind>
+	template<typename Acc, typename U>
 	LMAT_ENSURE_INLINE
-	inline bool use_simd(macc_<Acc, simd_<Kind> >)
+	inline bool use_parallel(macc_<Acc, U, par_>)
 	{
 		return true;
 	}
@@ -148,11 +174,143 @@ namespace lmat
 	template<>
 	struct supports_simd<double, avx_t> : public meta::true_ { };
 
+	template<>
+	struct supports_simd<float, avx512_t> : public meta::true_ { };
+
+	template<>
+	struct supports_simd<double, avx512_t> : public meta::true_ { };
+
 	template<typename A, typename ATag, typename Kind>
 	struct supports_simd<arg_wrap<A, ATag>, Kind>
 	: public supports_simd<A, Kind> { };
 
 
+	/********************************************
+	 *
+	 *  Per-row access support
+	 *
+	 *  An argument supports per-row access if
+	 *  it can be traversed row by row, with the
+	 *  elements of each row being contiguous.
+	 *
+	 ********************************************/
+
+	namespace internal
+	{
+		template<typename Mat, bool IsRegular>
+		struct _matrix_supports_perrow_macc : public meta::false_ { };
+
+		template<typename Mat>
+		struct _matrix_supports_perrow_macc<Mat, true>
+		: public meta::is_perrow_contiguous<Mat> { };
+	}
+
+	template<typename A>
+	struct supports_perrow_access
+	: public internal::_matrix_supports_perrow_macc<A, meta::is_regular_mat<A>::value> { };
+
+	template<typename T, typename ATag>
+	struct supports_perrow_access<arg_wrap<T, ATag> > : public meta::false_ { };
+
+	template<typename T>
+	struct supports_perrow_access<arg_wrap<T, atags::single> >
+	: public meta::true_ { };
+
+	template<typename A>
+	struct supports_perrow_access<arg_wrap<A, atags::in> >
+	: public supports_perrow_access<A> { };
+
+	template<typename A>
+	struct supports_perrow_access<arg_wrap<A, atags::out> >
+	: public supports_perrow_access<A> { };
+
+	template<typename A>
+	struct supports_perrow_access<arg_wrap<A, atags::in_out> >
+	: public supports_perrow_access<A> { };
+
+	template<typename T>
+	struct supports_perrow_access<arg_wrap<T, atags::sum> >
+	: public meta::true_ { };
+
+	template<typename T>
+	struct supports_perrow_access<arg_wrap<T, atags::max> >
+	: public meta::true_ { };
+
+	template<typename T>
+	struct supports_perrow_access<arg_wrap<T, atags::min> >
+	: public meta::true_ { };
+
+
+	template<typename A, typename Kind> struct supports_perrow_simd;
+
+	namespace internal
+	{
+		// non-matrix arguments (e.g. scalars) follow supports_simd
+
+		template<typename Mat, bool IsRegular, typename Kind>
+		struct _matrix_supports_perrow_simd : public supports_simd<Mat, Kind> { };
+
+		template<typename Mat, typename Kind>
+		struct _matrix_supports_perrow_simd<Mat, true, Kind>
+		{
+			typedef typename meta::value_type_of<Mat>::type VT;
+
+			static const bool value = supports_simd<VT, Kind>::value &&
+					meta::is_perrow_contiguous<Mat>::value;
+		};
+	}
+
+	template<typename A, typename Kind>
+	struct supports_perrow_simd
+	: public internal::_matrix_supports_perrow_simd<A, meta::is_regular_mat<A>::value, Kind> { };
+
+	template<typename A, typename ATag, typename Kind>
+	struct supports_perrow_simd<arg_wrap<A, ATag>, Kind>
+	: public supports_perrow_simd<A, Kind> { };
+
+
+	/********************************************
+	 *
+	 *  Parallel access support
+	 *
+	 *  An argument supports parallel access if
+	 *  disjoint parts of it can be accessed
+	 *  by different threads at the same time.
+	 *
+	 ********************************************/
+
+	template<typename A>
+	struct supports_parallel_access
+	: public meta::is_regular_mat<A> { };
+
+	template<typename T, typename ATag>
+	struct supports_parallel_access<arg_wrap<T, ATag> > : public meta::false_ { };
+
+	template<typename T>
+	struct supports_parallel_access<arg_wrap<T, atags::single> >
+	: public meta::true_ { };
+
+	template<typename A>
+	struct supports_parallel_access<arg_wrap<A, atags::in> >
+	: public supports_parallel_access<A> { };
+
+	template<typename A>
+	struct supports_parallel_access<arg_wrap<A, atags::out> >
+	: public supports_parallel_access<A> { };
+
+	template<typename A>
+	struct supports_parallel_access<arg_wrap<A, atags::in_out> >
+	: public supports_parallel_access<A> { };
+
+	template<typename A>
+	struct supports_parallel_access<arg_wrap<A, atags::repcol> >
+	: public supports_parallel_access<A> { };
+
+	template<typename A>
+	struct supports_parallel_access<arg_wrap<A, atags::reprow> >
+	: public supports_parallel_access<A> { };
+
+
 	/********************************************
 	 *
 	 *  preferred policy
@@ -189,15 +347,24 @@ namespace lmat
 
 			static const bool use_linear = supp_linear;
 
+			// traverse row by row when the columns are not contiguous,
+			// but the rows of all arguments are
+
+			static const bool use_perrow = !use_linear && !args_supp_simd &&
+					meta::all_<supports_perrow_access<Args>...>::value;
+
 			static const index_t len = use_linear ?
-					(Shape::ct_nrows * Shape::ct_ncols) : Shape::ct_nrows;
+					(Shape::ct_nrows * Shape::ct_ncols) :
+					(use_perrow ? Shape::ct_ncols : Shape::ct_nrows);
 
 			static const unsigned int pack_width =
 					internal::_kernel_packwidth<Kernel, skind, ker_simdizable>::value;
 
 			static const bool use_simd =
 					ker_simdizable &&
-					args_supp_simd &&
+					(use_perrow ?
+						meta::all_<supports_perrow_simd<Args, skind>...>::value :
+						args_supp_simd) &&
 					((unsigned int)len % pack_width == 0);
 		};
 	}
@@ -213,17 +380,35 @@ namespace lmat
 
 		typedef typename _deriv::skind skind;
 		static const bool use_linear = _deriv::use_linear;
+		static const bool use_perrow = _deriv::use_perrow;
 		static const bool use_simd = _deriv::use_simd;
 
 		// result:
 
-		typedef typename std::conditional<use_linear, linear_, percol_>::type access;
+		typedef typename std::conditional<use_linear, linear_,
+				typename std::conditional<use_perrow, perrow_, percol_>::type>::type access;
 		typedef typename std::conditional<use_simd, simd_<skind>, scalar_>::type unit;
 
 		typedef macc_<access, unit> type;
 	};
 
 
+	template<class Shape, class Kernel, typename... Args>
+	struct preferred_par_macc_policy
+	{
+		typedef preferred_macc_policy<Shape, Kernel, Args...> _seq_map;
+
+		static const bool use_parallel =
+				meta::all_<supports_parallel_access<Args>...>::value;
+
+		typedef typename _seq_map::access access;
+		typedef typename _seq_map::unit unit;
+
+		typedef macc_<access, unit,
+				typename std::conditional<use_parallel, par_, seq_>::type> type;
+	};
+
+
 	template<index_t CM, index_t CN, class Kernel, typename... Args>
 	typename preferred_macc_policy<matrix_shape<CM, CN>, Kernel, Args...>::type
 	get_preferred_macc_policy(const matrix_shape<CM, CN>&, const Kernel&, const Args&...)
@@ -241,6 +426,23 @@ namespace lmat
 	}
 
 
+	template<index_t CM, index_t CN, class Kernel, typename... Args>
+	typename preferred_par_macc_policy<matrix_shape<CM, CN>, Kernel, Args...>::type
+	get_preferred_macc_policy(par_, const matrix_shape<CM, CN>&, const Kernel&, const Args&...)
+	{
+		typedef typename preferred_par_macc_policy<matrix_shape<CM, CN>, Kernel, Args...>::type policy_t;
+		return policy_t();
+	}
+
+	template<class Kernel, typename... Args>
+	typename preferred_par_macc_policy<matrix_shape<0, 0>, Kernel, Args...>::type
+	get_preferred_macc_policy(par_, index_t, index_t, const Kernel&, const Args&...)
+	{
+		typedef typename preferred_par_macc_policy<matrix_shape<0, 0>, Kernel, Args...>::type policy_t;
+		return policy_t();
+	}
+
+
 	template<typename T, class Expr, typename Dst>
 	typename preferred_macc_policy<
 		typename meta::common_shape<Expr, Dst>::type, copy_kernel<T>, Expr, Dst>::type
@@ -253,6 +455,6 @@ namespace lmat
 	}
 
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* MACC_POLICY_H_ */
@@ -16,8 +16,7 @@
 #include "internal/mat_allany_internal.h"
 #include <light_mat/matexpr/mat_pred.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	/********************************************
 	 *
@@ -129,6 +128,6 @@ namespace lmat
 		LMAT_CHECK_DIMS( dmat.nelems() == mat.ncolumns() )
 		internal::colwise_any_(mat.shape(), type_<bool>(), mat.derived(), dmat.derived(), val, scalar_());
 	}
-}
+LMAT_END_NAMESPACE
 
 #endif
@@ -16,8 +16,7 @@
 #include <light_mat/mateval/mat_allany.h>
 #include <light_mat/matexpr/mat_arith.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	template<typename T, class A, class B>
 	inline bool is_equal(const IEWiseMatrix<A, T>& a, const IEWiseMatrix<B, T>& b)
@@ -31,7 +30,7 @@ namespace lmat
 		return have_same_shape(a, b) && all(abs(a - b) < tol);
 	}
 
-}
+LMAT_END_NAMESPACE
 
 
 #endif /* MAT_COMPARE_H_ */
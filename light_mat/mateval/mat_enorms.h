@@ -16,8 +16,7 @@
 #include <light_mat/mateval/mat_reduce.h>
 #include <light_mat/matexpr/mat_arith.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	namespace norms
 	{
@@ -35,6 +34,13 @@ namespace lmat
 		return asum(mat.derived());
 	}
 
+	template<typename T, class Mat>
+	LMAT_ENSURE_INLINE
+	inline T norm(const IEWiseMatrix<Mat, T>& mat, norms::L1_, par_)
+	{
+		return asum(mat.derived(), par_());
+	}
+
 	template<typename T, class Mat>
 	LMAT_ENSURE_INLINE
 	inline T norm(const IEWiseMatrix<Mat, T>& mat, norms::L2_)
@@ -42,6 +48,13 @@ namespace lmat
 		return math::sqrt(sqsum(mat));
 	}
 
+	template<typename T, class Mat>
+	LMAT_ENSURE_INLINE
+	inline T norm(const IEWiseMatrix<Mat, T>& mat, norms::L2_, par_)
+	{
+		return math::sqrt(sqsum(mat, par_()));
+	}
+
 	template<typename T, class Mat>
 	LMAT_ENSURE_INLINE
 	inline T norm(const IEWiseMatrix<Mat, T>& mat, norms::Linf_)
@@ -49,6 +62,13 @@ namespace lmat
 		return amax(mat);
 	}
 
+	template<typename T, class Mat>
+	LMAT_ENSURE_INLINE
+	inline T norm(const IEWiseMatrix<Mat, T>& mat, norms::Linf_, par_)
+	{
+		return amax(mat, par_());
+	}
+
 
 	// colwise reduction
 
@@ -59,6 +79,13 @@ namespace lmat
 		colwise_asum(mat, dmat);
 	}
 
+	template<typename T, class Mat, class DMat>
+	LMAT_ENSURE_INLINE
+	inline void colwise_norm(const IEWiseMatrix<Mat, T>& mat, IRegularMatrix<DMat, T>& dmat, norms::L1_, par_)
+	{
+		colwise_asum(mat, dmat, par_());
+	}
+
 	template<typename T, class Mat, class DMat>
 	LMAT_ENSURE_INLINE
 	inline void colwise_norm(const IEWiseMatrix<Mat, T>& mat, IRegularMatrix<DMat, T>& dmat, norms::L2_)
@@ -67,6 +94,14 @@ namespace lmat
 		dmat.derived() = sqrt(dmat);
 	}
 
+	template<typename T, class Mat, class DMat>
+	LMAT_ENSURE_INLINE
+	inline void colwise_norm(const IEWiseMatrix<Mat, T>& mat, IRegularMatrix<DMat, T>& dmat, norms::L2_, par_)
+	{
+		colwise_sqsum(mat, dmat, par_());
+		dmat.derived() = sqrt(dmat);
+	}
+
 	template<typename T, class Mat, class DMat>
 	LMAT_ENSURE_INLINE
 	inline void colwise_norm(const IEWiseMatrix<Mat, T>& mat, IRegularMatrix<DMat, T>& dmat, norms::Linf_)
@@ -74,6 +109,13 @@ namespace lmat
 		colwise_amax(mat, dmat);
 	}
 
+	template<typename T, class Mat, class DMat>
+	LMAT_ENSURE_INLINE
+	inline void colwise_norm(const IEWiseMatrix<Mat, T>& mat, IRegularMatrix<DMat, T>& dmat, norms::Linf_, par_)
+	{
+		colwise_amax(mat, dmat, par_());
+	}
+
 
 	// rowwise reduction
 
@@ -84,6 +126,13 @@ namespace lmat
 		rowwise_asum(mat, dmat);
 	}
 
+	template<typename T, class Mat, class DMat>
+	LMAT_ENSURE_INLINE
+	inline void rowwise_norm(const IEWiseMatrix<Mat, T>& mat, IRegularMatrix<DMat, T>& dmat, norms::L1_, par_)
+	{
+		rowwise_asum(mat, dmat, par_());
+	}
+
 	template<typename T, class Mat, class DMat>
 	LMAT_ENSURE_INLINE
 	inline void rowwise_norm(const IEWiseMatrix<Mat, T>& mat, IRegularMatrix<DMat, T>& dmat, norms::L2_)
@@ -92,6 +141,14 @@ namespace lmat
 		dmat.derived() = sqrt(dmat);
 	}
 
+	template<typename T, class Mat, class DMat>
+	LMAT_ENSURE_INLINE
+	inline void rowwise_norm(const IEWiseMatrix<Mat, T>& mat, IRegularMatrix<DMat, T>& dmat, norms::L2_, par_)
+	{
+		rowwise_sqsum(mat, dmat, par_());
+		dmat.derived() = sqrt(dmat);
+	}
+
 	template<typename T, class Mat, class DMat>
 	LMAT_ENSURE_INLINE
 	inline void rowwise_norm(const IEWiseMatrix<Mat, T>& mat, IRegularMatrix<DMat, T>& dmat, norms::Linf_)
@@ -99,7 +156,14 @@ namespace lmat
 		rowwise_amax(mat, dmat);
 	}
 
+	template<typename T, class Mat, class DMat>
+	LMAT_ENSURE_INLINE
+	inline void rowwise_norm(const IEWiseMatrix<Mat, T>& mat, IRegularMatrix<DMat, T>& dmat, norms::Linf_, par_)
+	{
+		rowwise_amax(mat, dmat, par_());
+	}
+
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* MAT_ENORMS_H_ */
@@ -107,8 +107,7 @@
 		}; \
 
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	/********************************************
 	 *
@@ -123,6 +122,146 @@ namespace lmat
 	LMAT_DEFINE_SIMPLE_FOLD_KERNEL( minimum, x, a = math::min(a, x), minimum(a) )
 
 
+	/********************************************
+	 *
+	 *  fused multiply-add folders
+	 *
+	 *  The product (or square) at each step is
+	 *  accumulated with a single FMA instruction
+	 *  when the target supports it.
+	 *
+	 ********************************************/
+
+	template<typename T>
+	struct sqsum_kernel
+	{
+		typedef T value_type;
+		typedef T accumulated_type;
+
+		LMAT_ENSURE_INLINE
+		T init(const T& x) const { return x * x; }
+
+		LMAT_ENSURE_INLINE
+		void operator()(T& a, const T& x) const { a = math::fmadd(x, x, a); }
+	};
+
+	template<typename T, typename Kind>
+	struct sqsum_kernel<simd_pack<T, Kind> >
+	{
+		typedef simd_pack<T, Kind> value_type;
+		typedef simd_pack<T, Kind> accumulated_type;
+
+		LMAT_ENSURE_INLINE
+		value_type init(const value_type& x) const { return x * x; }
+
+		LMAT_ENSURE_INLINE
+		void operator()(value_type& a, const value_type& x) const { a = math::fma(x, x, a); }
+
+		LMAT_ENSURE_INLINE
+		T reduce(const value_type& a) const { return sum(a); }
+	};
+
+	LMAT_DECL_SIMDIZABLE_ON_REAL( sqsum_kernel )
+	LMAT_DEF_TRIVIAL_SIMDIZE_MAP( sqsum_kernel )
+
+	namespace internal
+	{
+		// partial sums of squares are added, not squared again
+
+		template<typename T>
+		struct fold_combiner<sqsum_kernel<T> >
+		{
+			LMAT_ENSURE_INLINE
+			static void combine(const sqsum_kernel<T>&, T& a, const T& b)
+			{
+				a += b;
+			}
+		};
+	}
+
+
+	template<typename T>
+	struct dot_kernel
+	{
+		typedef T value_type;
+		typedef T accumulated_type;
+
+		LMAT_ENSURE_INLINE
+		T init(const T& x, const T& y) const { return x * y; }
+
+		LMAT_ENSURE_INLINE
+		void operator()(T& a, const T& x, const T& y) const { a = math::fmadd(x, y, a); }
+
+		LMAT_ENSURE_INLINE
+		void operator()(T& a, const T& b) const { a += b; }
+	};
+
+	template<typename T, typename Kind>
+	struct dot_kernel<simd_pack<T, Kind> >
+	{
+		typedef simd_pack<T, Kind> value_type;
+		typedef simd_pack<T, Kind> accumulated_type;
+
+		LMAT_ENSURE_INLINE
+		value_type init(const value_type& x, const value_type& y) const { return x * y; }
+
+		LMAT_ENSURE_INLINE
+		void operator()(value_type& a, const value_type& x, const value_type& y) const { a = math::fma(x, y, a); }
+
+		LMAT_ENSURE_INLINE
+		void operator()(value_type& a, const value_type& b) const { a += b; }
+
+		LMAT_ENSURE_INLINE
+		T reduce(const value_type& a) const { return sum(a); }
+	};
+
+	LMAT_DECL_SIMDIZABLE_ON_REAL( dot_kernel )
+	LMAT_DEF_TRIVIAL_SIMDIZE_MAP( dot_kernel )
+
+
+	template<typename T>
+	struct diff_sqsum_kernel
+	{
+		typedef T value_type;
+		typedef T accumulated_type;
+
+		LMAT_ENSURE_INLINE
+		T init(const T& x, const T& y) const { T d = x - y; return d * d; }
+
+		LMAT_ENSURE_INLINE
+		void operator()(T& a, const T& x, const T& y) const { T d = x - y; a = math::fmadd(d, d, a); }
+
+		LMAT_ENSURE_INLINE
+		void operator()(T& a, const T& b) const { a += b; }
+	};
+
+	template<typename T, typename Kind>
+	struct diff_sqsum_kernel<simd_pack<T, Kind> >
+	{
+		typedef simd_pack<T, Kind> value_type;
+		typedef simd_pack<T, Kind> accumulated_type;
+
+		LMAT_ENSURE_INLINE
+		value_type init(const value_type& x, const value_type& y) const { value_type d = x - y; return d * d; }
+
+		LMAT_ENSURE_INLINE
+		void operator()(value_type& a, const value_type& x, const value_type& y) const
+		{
+			value_type d = x - y;
+			a = math::fma(d, d, a);
+		}
+
+		LMAT_ENSURE_INLINE
+		void operator()(value_type& a, const value_type& b) const { a += b; }
+
+		LMAT_ENSURE_INLINE
+		T reduce(const value_type& a) const { return sum(a); }
+	};
+
+	LMAT_DECL_SIMDIZABLE_ON_REAL( diff_sqsum_kernel )
+	LMAT_DEF_TRIVIAL_SIMDIZE_MAP( diff_sqsum_kernel )
+
+
 
 	/********************************************
 	 *
@@ -171,6 +310,91 @@ namespace lmat
 			return internal::percol_fold_impl(shape, U(), m_kernel, make_multicol_accessor(U(), wrap)...);
 		}
 
+		// rows of row-major arguments are folded as the columns of the transpose
+
+		template<typename U, index_t CM, index_t CN, typename... Wrap>
+		LMAT_ENSURE_INLINE
+		result_type eval(macc_<perrow_, U>, const matrix_shape<CM, CN>& shape, const Wrap&... wrap) const
+		{
+			matrix_shape<CN, CM> tshape(shape.ncolumns(), shape.nrows());
+			return internal::percol_fold_impl(tshape, U(), m_kernel, make_multirow_accessor(U(), wrap)...);
+		}
+
+		template<typename U, typename... Wrap>
+		LMAT_ENSURE_INLINE
+		result_type eval(macc_<perrow_, U>, index_t m, index_t n, const Wrap&... wrap) const
+		{
+			matrix_shape<0,0> tshape(n, m);
+			return internal::percol_fold_impl(tshape, U(), m_kernel, make_multirow_accessor(U(), wrap)...);
+		}
+
+		// parallel evaluation
+
+		template<typename U, index_t CM, index_t CN, typename... Wrap>
+		LMAT_ENSURE_INLINE
+		result_type eval(macc_<linear_, U, par_>, const matrix_shape<CM, CN>& shape, const Wrap&... wrap) const
+		{
+			static_assert(meta::all_<supports_parallel_access<Wrap>...>::value,
+					"All arguments must support parallel access.");
+
+			dimension<CM * CN> dim(shape.nelems());
+			return internal::par_linear_fold_impl(dim, U(), m_kernel, make_vec_accessor(U(), wrap)...);
+		}
+
+		template<typename U, typename... Wrap>
+		LMAT_ENSURE_INLINE
+		result_type eval(macc_<linear_, U, par_>, index_t m, index_t n, const Wrap&... wrap) const
+		{
+			static_assert(meta::all_<supports_parallel_access<Wrap>...>::value,
+					"All arguments must support parallel access.");
+
+			dimension<0> dim(m * n);
+			return internal::par_linear_fold_impl(dim, U(), m_kernel, make_vec_accessor(U(), wrap)...);
+		}
+
+		template<typename U, index_t CM, index_t CN, typename... Wrap>
+		LMAT_ENSURE_INLINE
+		result_type eval(macc_<percol_, U, par_>, const matrix_shape<CM, CN>& shape, const Wrap&... wrap) const
+		{
+			static_assert(meta::all_<supports_parallel_access<Wrap>...>::value,
+					"All arguments must support parallel access.");
+
+			return internal::par_percol_fold_impl(shape, U(), m_kernel, make_multicol_accessor(U(), wrap)...);
+		}
+
+		template<typename U, typename... Wrap>
+		LMAT_ENSURE_INLINE
+		result_type eval(macc_<percol_, U, par_>, index_t m, index_t n, const Wrap&... wrap) const
+		{
+			static_assert(meta::all_<supports_parallel_access<Wrap>...>::value,
+					"All arguments must support parallel access.");
+
+			matrix_shape<0,0> shape(m, n);
+			return internal::par_percol_fold_impl(shape, U(), m_kernel, make_multicol_accessor(U(), wrap)...);
+		}
+
+		template<typename U, index_t CM, index_t CN, typename... Wrap>
+		LMAT_ENSURE_INLINE
+		result_type eval(macc_<perrow_, U, par_>, const matrix_shape<CM, CN>& shape, const Wrap&... wrap) const
+		{
+			static_assert(meta::all_<supports_parallel_access<Wrap>...>::value,
+					"All arguments must support parallel access.");
+
+			matrix_shape<CN, CM> tshape(shape.ncolumns(), shape.nrows());
+			return internal::par_percol_fold_impl(tshape, U(), m_kernel, make_multirow_accessor(U(), wrap)...);
+		}
+
+		template<typename U, typename... Wrap>
+		LMAT_ENSURE_INLINE
+		result_type eval(macc_<perrow_, U, par_>, index_t m, index_t n, const Wrap&... wrap) const
+		{
+			static_assert(meta::all_<supports_parallel_access<Wrap>...>::value,
+					"All arguments must support parallel access.");
+
+			matrix_shape<0,0> tshape(n, m);
+			return internal::par_percol_fold_impl(tshape, U(), m_kernel, make_multirow_accessor(U(), wrap)...);
+		}
+
 		template<index_t CM, index_t CN, typename... Wrap>
 		LMAT_ENSURE_INLINE
 		result_type operator() (const matrix_shape<CM, CN>& shape, const Wrap&... wrap) const
@@ -187,6 +411,22 @@ namespace lmat
 			return eval(policy_t(), m, n, wrap...);
 		}
 
+		template<index_t CM, index_t CN, typename... Wrap>
+		LMAT_ENSURE_INLINE
+		result_type operator() (par_, const matrix_shape<CM, CN>& shape, const Wrap&... wrap) const
+		{
+			typedef typename internal::par_fold_policy<FoldKernel, matrix_shape<CM, CN>, Wrap...>::type policy_t;
+			return eval(policy_t(), shape, wrap...);
+		}
+
+		template<typename... Wrap>
+		LMAT_ENSURE_INLINE
+		result_type operator() (par_, index_t m, index_t n, const Wrap&... wrap) const
+		{
+			typedef typename internal::par_fold_policy<FoldKernel, matrix_shape<0, 0>, Wrap...>::type policy_t;
+			return eval(policy_t(), m, n, wrap...);
+		}
+
 	private:
 		FoldKernel m_kernel;
 	};
@@ -205,6 +445,6 @@ namespace lmat
 		return matrix_folder<Folder>(folder);
 	}
 
-}
+LMAT_END_NAMESPACE
 
 #endif 
@@ -15,8 +15,7 @@
 
 #include "internal/mat_reduce_internal.h"
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	/********************************************
 	 *
 	 *  minmax statistics
@@ -111,6 +110,6 @@ namespace lmat
 	}
 
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* MAT_MINMAX_H_ */
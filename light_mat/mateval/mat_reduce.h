@@ -30,6 +30,12 @@
 	inline T Name(const IEWiseMatrix<A, T>& a) { \
 		return a.nelems() > 0 ? \
 				fold(Name##_kernel<T>())(a.shape(), in_(a)) : \
+				internal::empty_values<T>::Name(); } \
+	template<typename T, class A> \
+	LMAT_ENSURE_INLINE \
+	inline T Name(const IEWiseMatrix<A, T>& a, par_) { \
+		return a.nelems() > 0 ? \
+				fold(Name##_kernel<T>())(par_(), a.shape(), in_(a)) : \
 				internal::empty_values<T>::Name(); }
 
 #define LMAT_DEFINE_BASIC_COLWISE_REDUCTION( Name ) \
@@ -38,6 +44,12 @@
 		auto shape = a.shape(); \
 		if (shape.nrows() > 0) { \
 			internal::colwise_fold_impl(shape, Name##_kernel<T>(), dmat, a ); } \
+		else { fill(dmat, internal::empty_values<T>::Name()); } } \
+	template<typename T, class A, class DMat> \
+	inline void colwise_##Name(const IEWiseMatrix<A, T>& a, IRegularMatrix<DMat, T>& dmat, par_) { \
+		auto shape = a.shape(); \
+		if (shape.nrows() > 0) { \
+			internal::colwise_fold_impl(shape, Name##_kernel<T>(), dmat, a, par_()); } \
 		else { fill(dmat, internal::empty_values<T>::Name()); } }
 
 #define LMAT_DEFINE_BASIC_ROWWISE_REDUCTION( Name ) \
@@ -46,6 +58,13 @@
 		auto shape = a.shape(); \
 		if (shape.ncolumns() > 0) { \
 			internal::rowwise_fold_impl(shape, Name##_kernel<T>(), dmat, a); } \
+		else { \
+			fill(dmat, internal::empty_values<T>::Name()); } } \
+	template<typename T, class A, class DMat> \
+	inline void rowwise_##Name(const IEWiseMatrix<A, T>& a, IRegularMatrix<DMat, T>& dmat, par_) { \
+		auto shape = a.shape(); \
+		if (shape.ncolumns() > 0) { \
+			internal::rowwise_fold_impl(shape, Name##_kernel<T>(), dmat, a, par_()); } \
 		else { \
 			fill(dmat, internal::empty_values<T>::Name()); } }
 
@@ -57,14 +76,53 @@
 	LMAT_ENSURE_INLINE \
 	inline T Name(const IEWiseMatrix<A, T>& a) { \
 		dimension<meta::nelems<A>::value> dim = internal::reduc_get_length(a); \
-		return dim.value() > 0 ? Reduc(TExpr) : EmptyVal; }
+		return dim.value() > 0 ? Reduc(TExpr) : EmptyVal; } \
+	template<typename T, class A> \
+	LMAT_ENSURE_INLINE \
+	inline T Name(const IEWiseMatrix<A, T>& a, par_) { \
+		dimension<meta::nelems<A>::value> dim = internal::reduc_get_length(a); \
+		return dim.value() > 0 ? Reduc(TExpr, par_()) : EmptyVal; }
 
 #define LMAT_DEFINE_FULL_REDUCTION_2( Name, Reduc, TExpr, EmptyVal ) \
 	template<typename T, class A, class B> \
 	LMAT_ENSURE_INLINE \
 	inline T Name(const IEWiseMatrix<A, T>& a, const IEWiseMatrix<B, T>& b) { \
 		dimension<meta::common_nelems<A, B>::value> dim = internal::reduc_get_length(a, b); \
-		return dim.value() > 0 ? Reduc(TExpr) : EmptyVal; }
+		return dim.value() > 0 ? Reduc(TExpr) : EmptyVal; } \
+	template<typename T, class A, class B> \
+	LMAT_ENSURE_INLINE \
+	inline T Name(const IEWiseMatrix<A, T>& a, const IEWiseMatrix<B, T>& b, par_) { \
+		dimension<meta::common_nelems<A, B>::value> dim = internal::reduc_get_length(a, b); \
+		return dim.value() > 0 ? Reduc(TExpr, par_()) : EmptyVal; }
+
+// reduction through a fused multiply-add fold kernel
+// (that takes one or two inputs per step)
+
+#define LMAT_DEFINE_FMA_FULL_REDUCTION_1( Name, Kernel ) \
+	template<typename T, class A> \
+	LMAT_ENSURE_INLINE \
+	inline T Name(const IEWiseMatrix<A, T>& a) { \
+		return a.nelems() > 0 ? \
+				fold(Kernel<T>())(a.shape(), in_(a)) : T(0); } \
+	template<typename T, class A> \
+	LMAT_ENSURE_INLINE \
+	inline T Name(const IEWiseMatrix<A, T>& a, par_) { \
+		return a.nelems() > 0 ? \
+				fold(Kernel<T>())(par_(), a.shape(), in_(a)) : T(0); }
+
+#define LMAT_DEFINE_FMA_FULL_REDUCTION_2( Name, Kernel ) \
+	template<typename T, class A, class B> \
+	LMAT_ENSURE_INLINE \
+	inline T Name(const IEWiseMatrix<A, T>& a, const IEWiseMatrix<B, T>& b) { \
+		typename meta::common_shape<A, B>::type shape = internal::reduc_get_shape(a, b); \
+		return shape.nelems() > 0 ? \
+				fold(Kernel<T>())(shape, in_(a), in_(b)) : T(0); } \
+	template<typename T, class A, class B> \
+	LMAT_ENSURE_INLINE \
+	inline T Name(const IEWiseMatrix<A, T>& a, const IEWiseMatrix<B, T>& b, par_) { \
+		typename meta::common_shape<A, B>::type shape = internal::reduc_get_shape(a, b); \
+		return shape.nelems() > 0 ? \
+				fold(Kernel<T>())(par_(), shape, in_(a), in_(b)) : T(0); }
 
 #define LMAT_DEFINE_COLWISE_REDUCTION_1( Name, Reduc, TExpr, EmptyVal ) \
 	template<typename T, class A, class DMat> \
@@ -75,6 +133,15 @@
 		if (shape.nrows() > 0) { \
 			colwise_##Reduc(TExpr, dmat); \
 		} \
+		else { fill(dmat.derived(), EmptyVal); } } \
+	template<typename T, class A, class DMat> \
+	LMAT_ENSURE_INLINE \
+	inline void colwise_##Name(const IEWiseMatrix<A, T>& a, IRegularMatrix<DMat, T>& dmat, par_) { \
+		typename meta::shape<A>::type shape = internal::reduc_get_shape(a); \
+		LMAT_CHECK_DIMS( dmat.nelems() == shape.ncolumns() ); \
+		if (shape.nrows() > 0) { \
+			colwise_##Reduc(TExpr, dmat, par_()); \
+		} \
 		else { fill(dmat.derived(), EmptyVal); } }
 
 #define LMAT_DEFINE_COLWISE_REDUCTION_2( Name, Reduc, TExpr, EmptyVal ) \
@@ -87,9 +154,82 @@
 		if (shape.nrows() > 0) { \
 			colwise_##Reduc(TExpr, dmat); \
 		} \
+		else { fill(dmat.derived(), EmptyVal); } } \
+	template<typename T, class A, class B, class DMat> \
+	LMAT_ENSURE_INLINE \
+	inline void colwise_##Name(const IEWiseMatrix<A, T>& a, const IEWiseMatrix<B, T>& b, \
+			IRegularMatrix<DMat, T>& dmat, par_) { \
+		typename meta::common_shape<A, B>::type shape = internal::reduc_get_shape(a, b); \
+		LMAT_CHECK_DIMS( dmat.nelems() == shape.ncolumns() ); \
+		if (shape.nrows() > 0) { \
+			colwise_##Reduc(TExpr, dmat, par_()); \
+		} \
 		else { fill(dmat.derived(), EmptyVal); } }
 
 
+// vector-wise reduction through a fused multiply-add fold kernel
+
+#define LMAT_DEFINE_FMA_COLWISE_REDUCTION_1( Name, Kernel ) \
+	template<typename T, class A, class DMat> \
+	inline void colwise_##Name(const IEWiseMatrix<A, T>& a, IRegularMatrix<DMat, T>& dmat) { \
+		typename meta::shape<A>::type shape = internal::reduc_get_shape(a); \
+		LMAT_CHECK_DIMS( dmat.nelems() == shape.ncolumns() ); \
+		if (shape.nrows() > 0) { \
+			internal::colwise_fold_impl(shape, Kernel<T>(), dmat, a); } \
+		else { fill(dmat.derived(), T(0)); } } \
+	template<typename T, class A, class DMat> \
+	inline void colwise_##Name(const IEWiseMatrix<A, T>& a, IRegularMatrix<DMat, T>& dmat, par_) { \
+		typename meta::shape<A>::type shape = internal::reduc_get_shape(a); \
+		LMAT_CHECK_DIMS( dmat.nelems() == shape.ncolumns() ); \
+		if (shape.nrows() > 0) { \
+			internal::colwise_fold_impl(shape, Kernel<T>(), dmat, a, par_()); } \
+		else { fill(dmat.derived(), T(0)); } }
+
+#define LMAT_DEFINE_FMA_COLWISE_REDUCTION_2( Name, Kernel ) \
+	template<typename T, class A, class B, class DMat> \
+	inline void colwise_##Name(const IEWiseMatrix<A, T>& a, const IEWiseMatrix<B, T>& b, \
+			IRegularMatrix<DMat, T>& dmat) { \
+		typename meta::common_shape<A, B>::type shape = internal::reduc_get_shape(a, b); \
+		LMAT_CHECK_DIMS( dmat.nelems() == shape.ncolumns() ); \
+		if (shape.nrows() > 0) { \
+			internal::colwise_fold_impl(shape, Kernel<T>(), dmat, a, b); } \
+		else { fill(dmat.derived(), T(0)); } } \
+	template<typename T, class A, class B, class DMat> \
+	inline void colwise_##Name(const IEWiseMatrix<A, T>& a, const IEWiseMatrix<B, T>& b, \
+			IRegularMatrix<DMat, T>& dmat, par_) { \
+		typename meta::common_shape<A, B>::type shape = internal::reduc_get_shape(a, b); \
+		LMAT_CHECK_DIMS( dmat.nelems() == shape.ncolumns() ); \
+		if (shape.nrows() > 0) { \
+			internal::colwise_fold_impl(shape, Kernel<T>(), dmat, a, b, par_()); } \
+		else { fill(dmat.derived(), T(0)); } }
+
+#define LMAT_DEFINE_FMA_ROWWISE_REDUCTION_1( Name, Kernel ) \
+	template<typename T, class A, class DMat> \
+	inline void rowwise_##Name(const IEWiseMatrix<A, T>& a, IRegularMatrix<DMat, T>& dmat) { \
+		typename meta::shape<A>::type shape = internal::reduc_get_shape(a); \
+		LMAT_CHECK_DIMS( dmat.nelems() == shape.nrows() ); \
+		internal::rowwise_fma_fold_impl(shape, Kernel<T>(), dmat, a); } \
+	template<typename T, class A, class DMat> \
+	inline void rowwise_##Name(const IEWiseMatrix<A, T>& a, IRegularMatrix<DMat, T>& dmat, par_) { \
+		typename meta::shape<A>::type shape = internal::reduc_get_shape(a); \
+		LMAT_CHECK_DIMS( dmat.nelems() == shape.nrows() ); \
+		internal::rowwise_fma_fold_impl(shape, Kernel<T>(), dmat, a, par_()); }
+
+#define LMAT_DEFINE_FMA_ROWWISE_REDUCTION_2( Name, Kernel ) \
+	template<typename T, class A, class B, class DMat> \
+	inline void rowwise_##Name(const IEWiseMatrix<A, T>& a, const IEWiseMatrix<B, T>& b, \
+			IRegularMatrix<DMat, T>& dmat) { \
+		typename meta::common_shape<A, B>::type shape = internal::reduc_get_shape(a, b); \
+		LMAT_CHECK_DIMS( dmat.nelems() == shape.nrows() ); \
+		internal::rowwise_fma_fold_impl(shape, Kernel<T>(), dmat, a, b); } \
+	template<typename T, class A, class B, class DMat> \
+	inline void rowwise_##Name(const IEWiseMatrix<A, T>& a, const IEWiseMatrix<B, T>& b, \
+			IRegularMatrix<DMat, T>& dmat, par_) { \
+		typename meta::common_shape<A, B>::type shape = internal::reduc_get_shape(a, b); \
+		LMAT_CHECK_DIMS( dmat.nelems() == shape.nrows() ); \
+		internal::rowwise_fma_fold_impl(shape, Kernel<T>(), dmat, a, b, par_()); }
+
+
 #define LMAT_DEFINE_ROWWISE_REDUCTION_1( Name, Reduc, TExpr, EmptyVal ) \
 	template<typename T, class A, class DMat> \
 	LMAT_ENSURE_INLINE \
@@ -99,6 +239,15 @@
 		if (shape.ncolumns() > 0) { \
 			rowwise_##Reduc(TExpr, dmat); \
 		} \
+		else { fill(dmat.derived(), EmptyVal); } } \
+	template<typename T, class A, class DMat> \
+	LMAT_ENSURE_INLINE \
+	inline void rowwise_##Name(const IEWiseMatrix<A, T>& a, IRegularMatrix<DMat, T>& dmat, par_) { \
+		typename meta::shape<A>::type shape = internal::reduc_get_shape(a); \
+		LMAT_CHECK_DIMS( dmat.nelems() == shape.nrows() ); \
+		if (shape.ncolumns() > 0) { \
+			rowwise_##Reduc(TExpr, dmat, par_()); \
+		} \
 		else { fill(dmat.derived(), EmptyVal); } }
 
 #define LMAT_DEFINE_ROWWISE_REDUCTION_2( Name, Reduc, TExpr, EmptyVal ) \
@@ -111,12 +260,21 @@
 		if (shape.ncolumns() > 0) { \
 			rowwise_##Reduc(TExpr, dmat); \
 		} \
+		else { fill(dmat.derived(), EmptyVal); } } \
+	template<typename T, class A, class B, class DMat> \
+	LMAT_ENSURE_INLINE \
+	inline void rowwise_##Name(const IEWiseMatrix<A, T>& a, const IEWiseMatrix<B, T>& b, \
+			IRegularMatrix<DMat, T>& dmat, par_) { \
+		typename meta::common_shape<A, B>::type shape = internal::reduc_get_shape(a, b); \
+		LMAT_CHECK_DIMS( dmat.nelems() == shape.nrows() ); \
+		if (shape.ncolumns() > 0) { \
+			rowwise_##Reduc(TExpr, dmat, par_()); \
+		} \
 		else { fill(dmat.derived(), EmptyVal); } }
 
 
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	/********************************************
 	 *
 	 *  basic reduction function
@@ -139,6 +297,16 @@ namespace lmat
 				internal::empty_values<T>::mean();
 	}
 
+	template<typename T, class A>
+	LMAT_ENSURE_INLINE
+	inline T mean(const IEWiseMatrix<A, T>& a, par_)
+	{
+		dimension<meta::nelems<A>::value> dim = internal::reduc_get_length(a);
+		return dim.value() > 0 ?
+				sum(a, par_()) / T(dim.value()) :
+				internal::empty_values<T>::mean();
+	}
+
 
 	// colwise reduction
 
@@ -164,6 +332,21 @@ namespace lmat
 		}
 	}
 
+	template<typename T, class A, class DMat>
+	inline void colwise_mean(const IEWiseMatrix<A, T>& a, IRegularMatrix<DMat, T>& dmat, par_)
+	{
+		auto shape = internal::reduc_get_shape(a);
+		if (shape.nrows() > 0)
+		{
+			colwise_sum(a, dmat, par_());
+			dmat *= math::rcp((T)shape.nrows());
+		}
+		else
+		{
+			fill(dmat, internal::empty_values<T>::mean());
+		}
+	}
+
 	// rowwise reduction
 
 	LMAT_DEFINE_BASIC_ROWWISE_REDUCTION( sum )
@@ -185,6 +368,21 @@ namespace lmat
 		}
 	}
 
+	template<typename T, class A, class DMat>
+	inline void rowwise_mean(const IEWiseMatrix<A, T>& a, IRegularMatrix<DMat, T>& dmat, par_)
+	{
+		auto shape = internal::reduc_get_shape(a);
+		if (shape.ncolumns() > 0)
+		{
+			rowwise_sum(a, dmat, par_());
+			dmat *= math::rcp((T)shape.ncolumns());
+		}
+		else
+		{
+			fill(dmat, internal::empty_values<T>::mean());
+		}
+	}
+
 
 	/********************************************
 	 *
@@ -197,44 +395,44 @@ namespace lmat
 	LMAT_DEFINE_FULL_REDUCTION_1( asum,  sum,     abs(a), T(0) )
 	LMAT_DEFINE_FULL_REDUCTION_1( amean, mean,    abs(a), T(0) )
 	LMAT_DEFINE_FULL_REDUCTION_1( amax,  maximum, abs(a), T(0) )
-	LMAT_DEFINE_FULL_REDUCTION_1( sqsum, sum,     sqr(a), T(0) )
+	LMAT_DEFINE_FMA_FULL_REDUCTION_1( sqsum, sqsum_kernel )
 
 	LMAT_DEFINE_FULL_REDUCTION_2( diff_asum,  sum,     abs(a - b), T(0) )
 	LMAT_DEFINE_FULL_REDUCTION_2( diff_amean, mean,    abs(a - b), T(0) )
 	LMAT_DEFINE_FULL_REDUCTION_2( diff_amax,  maximum, abs(a - b), T(0) )
-	LMAT_DEFINE_FULL_REDUCTION_2( diff_sqsum, sum,     sqr(a - b), T(0) )
+	LMAT_DEFINE_FMA_FULL_REDUCTION_2( diff_sqsum, diff_sqsum_kernel )
 
-	LMAT_DEFINE_FULL_REDUCTION_2( dot, sum, a * b, T(0) )
+	LMAT_DEFINE_FMA_FULL_REDUCTION_2( dot, dot_kernel )
 
 	// colwise reduction
 
 	LMAT_DEFINE_COLWISE_REDUCTION_1( asum,  sum,     abs(a), T(0) )
 	LMAT_DEFINE_COLWISE_REDUCTION_1( amean, mean,    abs(a), T(0) )
 	LMAT_DEFINE_COLWISE_REDUCTION_1( amax,  maximum, abs(a), T(0) )
-	LMAT_DEFINE_COLWISE_REDUCTION_1( sqsum, sum,     sqr(a), T(0) )
+	LMAT_DEFINE_FMA_COLWISE_REDUCTION_1( sqsum, sqsum_kernel )
 
 	LMAT_DEFINE_COLWISE_REDUCTION_2( diff_asum,  sum,     abs(a - b), T(0) )
 	LMAT_DEFINE_COLWISE_REDUCTION_2( diff_amean, mean,    abs(a - b), T(0) )
 	LMAT_DEFINE_COLWISE_REDUCTION_2( diff_amax,  maximum, abs(a - b), T(0) )
-	LMAT_DEFINE_COLWISE_REDUCTION_2( diff_sqsum, sum,     sqr(a - b), T(0) )
+	LMAT_DEFINE_FMA_COLWISE_REDUCTION_2( diff_sqsum, diff_sqsum_kernel )
 
-	LMAT_DEFINE_COLWISE_REDUCTION_2( dot, sum, a * b, T(0) )
+	LMAT_DEFINE_FMA_COLWISE_REDUCTION_2( dot, dot_kernel )
 
 	// rowwise reduction
 
 	LMAT_DEFINE_ROWWISE_REDUCTION_1( asum,  sum,     abs(a), T(0) )
 	LMAT_DEFINE_ROWWISE_REDUCTION_1( amean, mean,    abs(a), T(0) )
 	LMAT_DEFINE_ROWWISE_REDUCTION_1( amax,  maximum, abs(a), T(0) )
-	LMAT_DEFINE_ROWWISE_REDUCTION_1( sqsum, sum,     sqr(a), T(0) )
+	LMAT_DEFINE_FMA_ROWWISE_REDUCTION_1( sqsum, sqsum_kernel )
 
 	LMAT_DEFINE_ROWWISE_REDUCTION_2( diff_asum,  sum,     abs(a - b), T(0) )
 	LMAT_DEFINE_ROWWISE_REDUCTION_2( diff_amean, mean,    abs(a - b), T(0) )
 	LMAT_DEFINE_ROWWISE_REDUCTION_2( diff_amax,  maximum, abs(a - b), T(0) )
-	LMAT_DEFINE_ROWWISE_REDUCTION_2( diff_sqsum, sum,     sqr(a - b), T(0) )
+	LMAT_DEFINE_FMA_ROWWISE_REDUCTION_2( diff_sqsum, diff_sqsum_kernel )
 
-	LMAT_DEFINE_ROWWISE_REDUCTION_2( dot, sum, a * b, T(0) )
+	LMAT_DEFINE_FMA_ROWWISE_REDUCTION_2( dot, dot_kernel )
 
 
-}
+LMAT_END_NAMESPACE
 
 #endif 
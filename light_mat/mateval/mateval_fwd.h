@@ -65,8 +65,7 @@
 	}
 
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	// access units
 
 	struct scalar_ { };
@@ -171,6 +170,6 @@ namespace lmat
 	_LMAT_DEFINE_WRITABLE_ARGWRAP_FUN(rowwise_max, rowwise_max_to_)
 	_LMAT_DEFINE_WRITABLE_ARGWRAP_FUN(rowwise_min, rowwise_min_to_)
 
-}
+LMAT_END_NAMESPACE
 
 #endif 
@@ -16,8 +16,7 @@
 #include <light_mat/matrix/matrix_classes.h>
 #include "internal/matrix_find_internal.h"
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	/********************************************
 	 *
 	 *  counting
@@ -119,6 +118,6 @@ namespace lmat
 
 
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* MATRIX_FIND_H_ */
@@ -18,8 +18,7 @@
 #include <utility>
 #include <algorithm>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	/********************************************
 	 *
 	 *  finding max/min
@@ -348,6 +347,6 @@ namespace lmat
 		}
 	}
 
-}
+LMAT_END_NAMESPACE
 
 #endif 
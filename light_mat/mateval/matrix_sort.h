@@ -20,8 +20,7 @@
 #include <functional>
 #include <algorithm>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	/********************************************
 	 *
@@ -836,6 +835,6 @@ namespace lmat
 		return colwise_gsorted_ex(a, default_sort_alg(), asc_());
 	}
 
-}
+LMAT_END_NAMESPACE
 
 #endif 
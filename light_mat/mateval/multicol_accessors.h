@@ -1,7 +1,7 @@
 /**
  * @file multicol_accessors.h
  *
- * @brief Multi-column accessor classes
+ * @brief Multi-column (and multi-row) accessor classes
  *
  * @author Dahua Lin
  */
@@ -15,8 +15,7 @@
 
 #include <light_mat/mateval/vec_accessors.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	// forward declarations
 
@@ -821,7 +820,172 @@ namespace lmat
 		return rowwise_accumulator<Mat, U>(wrap.arg());
 	}
 
-}
+
+	/********************************************
+	 *
+	 *  multi-row accessors
+	 *
+	 *  The rows of a per-row contiguous matrix
+	 *  are exposed as the columns of its transpose,
+	 *  so that row-major matrices can be evaluated
+	 *  along their contiguous dimension.
+	 *
+	 ********************************************/
+
+	template<typename T, typename U>
+	class multi_controw_reader : public multicol_accessor_base
+	{
+	public:
+		typedef contvec_reader<T, U> col_accessor_type;
+
+		template<class Mat>
+		LMAT_ENSURE_INLINE
+		explicit multi_controw_reader(const Mat& mat)
+		: m_pbase(mat.ptr_data()), m_rowstride(mat.row_stride())
+		{ }
+
+		LMAT_ENSURE_INLINE
+		col_accessor_type col(index_t i) const
+		{
+			return col_accessor_type(m_pbase + m_rowstride * i);
+		}
+
+	private:
+		const T *m_pbase;
+		index_t m_rowstride;
+	};
+
+
+	template<typename T, typename U>
+	class multi_controw_writer : public multicol_accessor_base
+	{
+	public:
+		typedef contvec_writer<T, U> col_accessor_type;
+
+		template<class Mat>
+		LMAT_ENSURE_INLINE
+		explicit multi_controw_writer(Mat& mat)
+		: m_pbase(mat.ptr_data()), m_rowstride(mat.row_stride())
+		{ }
+
+		LMAT_ENSURE_INLINE
+		col_accessor_type col(index_t i) const
+		{
+			return col_accessor_type(m_pbase + m_rowstride * i);
+		}
+
+	private:
+		T *m_pbase;
+		index_t m_rowstride;
+	};
+
+
+	template<typename T, typename U>
+	class multi_controw_updater : public multicol_accessor_base
+	{
+	public:
+		typedef contvec_updater<T, U> col_accessor_type;
+
+		template<class Mat>
+		LMAT_ENSURE_INLINE
+		explicit multi_controw_updater(Mat& mat)
+		: m_pbase(mat.ptr_data()), m_rowstride(mat.row_stride())
+		{ }
+
+		LMAT_ENSURE_INLINE
+		col_accessor_type col(index_t i) const
+		{
+			return col_accessor_type(m_pbase + m_rowstride * i);
+		}
+
+	private:
+		T *m_pbase;
+		index_t m_rowstride;
+	};
+
+
+	namespace internal
+	{
+		template<class Mat, typename U>
+		struct multirow_reader_map
+		{
+			typedef typename matrix_traits<Mat>::value_type T;
+
+			typedef typename meta::if_<
+					meta::is_regular_mat<Mat>,
+					multi_controw_reader<T, U>,
+					invalid_multicol_reader
+			>::type type;
+
+			LMAT_ENSURE_INLINE
+			static type get(const Mat& mat)
+			{
+				return type(mat);
+			}
+		};
+	}
+
+	template<class Mat, typename U>
+	LMAT_ENSURE_INLINE
+	inline typename internal::multirow_reader_map<Mat, U>::type
+	make_multirow_accessor(U, const arg_wrap<Mat, atags::in>& wrap)
+	{
+		return internal::multirow_reader_map<Mat, U>::get(wrap.arg());
+	}
+
+	template<class Mat, typename U>
+	LMAT_ENSURE_INLINE
+	inline multi_controw_writer<typename matrix_traits<Mat>::value_type, U>
+	make_multirow_accessor(U, const arg_wrap<Mat, atags::out>& wrap)
+	{
+		typedef multi_controw_writer<typename matrix_traits<Mat>::value_type, U> type;
+		return type(wrap.arg());
+	}
+
+	template<class Mat, typename U>
+	LMAT_ENSURE_INLINE
+	inline multi_controw_updater<typename matrix_traits<Mat>::value_type, U>
+	make_multirow_accessor(U, const arg_wrap<Mat, atags::in_out>& wrap)
+	{
+		typedef multi_controw_updater<typename matrix_traits<Mat>::value_type, U> type;
+		return type(wrap.arg());
+	}
+
+	// scalars and full accumulators do not depend on the traversal order
+
+	template<typename T, typename U>
+	LMAT_ENSURE_INLINE
+	inline multicol_single_reader<T, U>
+	make_multirow_accessor(U u, const arg_wrap<T, atags::single>& wrap)
+	{
+		return make_multicol_accessor(u, wrap);
+	}
+
+	template<typename T, typename U>
+	LMAT_ENSURE_INLINE
+	inline multicol_sum_accumulator<T, U>
+	make_multirow_accessor(U u, const arg_wrap<T, atags::sum>& wrap)
+	{
+		return make_multicol_accessor(u, wrap);
+	}
+
+	template<typename T, typename U>
+	LMAT_ENSURE_INLINE
+	inline multicol_max_accumulator<T, U>
+	make_multirow_accessor(U u, const arg_wrap<T, atags::max>& wrap)
+	{
+		return make_multicol_accessor(u, wrap);
+	}
+
+	template<typename T, typename U>
+	LMAT_ENSURE_INLINE
+	inline multicol_min_accumulator<T, U>
+	make_multirow_accessor(U u, const arg_wrap<T, atags::min>& wrap)
+	{
+		return make_multicol_accessor(u, wrap);
+	}
+
+LMAT_END_NAMESPACE
 
 
 #endif /* MULTICOL_ACCESSORS_H_ */
@@ -18,19 +18,18 @@
 
 #include <light_mat/math/math_base.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	// forward declarations
 
-	template<typename T, typename U> class contvec_reader;
+	template<typename T, typename U, bool Aligned=false> class contvec_reader;
 	template<typename T, typename U> class stepvec_reader;
 	template<typename T, typename U> class single_reader;
 
-	template<typename T, typename U> class contvec_writer;
+	template<typename T, typename U, bool Aligned=false> class contvec_writer;
 	template<typename T, typename U> class stepvec_writer;
 
-	template<typename T, typename U> class contvec_updater;
+	template<typename T, typename U, bool Aligned=false> class contvec_updater;
 	template<typename T, typename U> class stepvec_updater;
 
 	template<typename T, typename U> class sum_accumulator;
@@ -38,6 +37,117 @@ namespace lmat
 	template<typename T, typename U> class min_accumulator;
 
 
+	/**
+	 * Whether an accessor can take part in a partial pack, i.e. one
+	 * that covers only the first n (< pack width) entries, through
+	 * pack_part(i, n) and done_pack_part(i, n). This allows the tail
+	 * of a vector to be processed in one go with masked load/store.
+	 */
+	template<class Acc>
+	struct supports_pack_part : public meta::false_ { };
+
+	template<typename T, typename Kind, bool Aligned>
+	struct supports_pack_part<contvec_reader<T, simd_<Kind>, Aligned> >
+	: public meta::has_masked_part<Kind> { };
+
+	template<typename T, typename Kind>
+	struct supports_pack_part<single_reader<T, simd_<Kind> > >
+	: public meta::has_masked_part<Kind> { };
+
+	template<typename T, typename Kind, bool Aligned>
+	struct supports_pack_part<contvec_writer<T, simd_<Kind>, Aligned> >
+	: public meta::has_masked_part<Kind> { };
+
+	template<typename T, typename Kind, bool Aligned>
+	struct supports_pack_part<contvec_updater<T, simd_<Kind>, Aligned> >
+	: public meta::has_masked_part<Kind> { };
+
+
+	/**
+	 * Whether the packs of an accessor may start at any position, such
+	 * that a few leading scalars can be peeled off to align the packs
+	 * of the output. This does not hold for the accessors with aligned
+	 * packs, whose pack positions must be multiples of the pack width.
+	 */
+	template<class Acc>
+	struct supports_pack_peel : public meta::false_ { };
+
+	template<typename T, typename Kind>
+	struct supports_pack_peel<contvec_reader<T, simd_<Kind>, false> > : public meta::true_ { };
+
+	template<typename T, typename Kind>
+	struct supports_pack_peel<single_reader<T, simd_<Kind> > > : public meta::true_ { };
+
+	template<typename T, typename Kind>
+	struct supports_pack_peel<contvec_writer<T, simd_<Kind>, false> > : public meta::true_ { };
+
+	template<typename T, typename Kind>
+	struct supports_pack_peel<contvec_updater<T, simd_<Kind>, false> > : public meta::true_ { };
+
+	/**
+	 * The number of scalars from position i to be peeled off, such that
+	 * the packs written by an accessor are aligned, or -1 if the accessor
+	 * has no preference (e.g. a reader).
+	 */
+	template<class Acc>
+	LMAT_ENSURE_INLINE
+	inline index_t pack_peel_hint(const Acc& , index_t )
+	{
+		return -1;
+	}
+
+	namespace internal
+	{
+		template<bool Aligned> struct contvec_pack_io;
+
+		template<>
+		struct contvec_pack_io<false>
+		{
+			template<class Pack, typename T>
+			LMAT_ENSURE_INLINE
+			static void load(Pack& pk, const T *p) { pk.load_u(p); }
+
+			template<class Pack, typename T>
+			LMAT_ENSURE_INLINE
+			static void store(const Pack& pk, T *p) { pk.store_u(p); }
+		};
+
+		template<>
+		struct contvec_pack_io<true>
+		{
+			template<class Pack, typename T>
+			LMAT_ENSURE_INLINE
+			static void load(Pack& pk, const T *p) { pk.load_a(p); }
+
+			template<class Pack, typename T>
+			LMAT_ENSURE_INLINE
+			static void store(const Pack& pk, T *p) { pk.store_a(p); }
+		};
+
+		// the number of elements before the next aligned pack
+
+		template<typename T, typename Kind>
+		LMAT_ENSURE_INLINE
+		inline index_t contvec_peel_len(const T *p)
+		{
+			const size_t pb = simd_traits<T, Kind>::pack_bytes;
+			const size_t r = reinterpret_cast<size_t>(p) & (pb - 1);
+			return r == 0 || r % sizeof(T) != 0 ? 0 : static_cast<index_t>((pb - r) / sizeof(T));
+		}
+
+		// whether the packs of a contiguous matrix are known to be aligned,
+		// i.e. its base address is aligned to (a multiple of) the pack size
+
+		template<class Mat, typename U>
+		struct contvec_aligned : public meta::false_ { };
+
+		template<class Mat, typename Kind>
+		struct contvec_aligned<Mat, simd_<Kind> >
+		: public meta::bool_<meta::is_aligned<Mat>::value &&
+			meta::alignment<Mat>::value % simd_traits<typename matrix_traits<Mat>::value_type, Kind>::pack_bytes == 0> { };
+	}
+
+
 	class scalar_vec_accessor_base
 	{
 	public:
@@ -63,6 +173,9 @@ namespace lmat
 		LMAT_ENSURE_INLINE
 		nil_t done_pack(index_t ) const { return nil_t(); }
 
+		LMAT_ENSURE_INLINE
+		nil_t done_pack_part(index_t, index_t ) const { return nil_t(); }
+
 		LMAT_ENSURE_INLINE
 		nil_t finalize() const { return nil_t(); }
 	};
@@ -96,8 +209,8 @@ namespace lmat
 	};
 
 
-	template<typename T, typename Kind>
-	class contvec_reader<T, simd_<Kind> > : public simd_vec_accessor_base
+	template<typename T, typename Kind, bool Aligned>
+	class contvec_reader<T, simd_<Kind>, Aligned> : public simd_vec_accessor_base
 	{
 	public:
 		typedef T scalar_type;
@@ -116,7 +229,17 @@ namespace lmat
 		LMAT_ENSURE_INLINE
 		pack_type pack(index_t i) const
 		{
-			return pack_type(m_pdata + i);
+			pack_type pk;
+			internal::contvec_pack_io<Aligned>::load(pk, m_pdata + i);
+			return pk;
+		}
+
+		LMAT_ENSURE_INLINE
+		pack_type pack_part(index_t i, index_t n) const
+		{
+			pack_type pk;
+			pk.load_part(static_cast<unsigned int>(n), m_pdata + i);
+			return pk;
 		}
 
 	private:
@@ -195,6 +318,12 @@ namespace lmat
 			return m_pack;
 		}
 
+		LMAT_ENSURE_INLINE
+		pack_type pack_part(index_t, index_t) const
+		{
+			return m_pack;
+		}
+
 	private:
 		pack_type m_pack;
 		T m_val;
@@ -212,7 +341,7 @@ namespace lmat
 		struct contvec_reader_map
 		{
 			typedef typename matrix_traits<Mat>::value_type T;
-			typedef contvec_reader<T, U> type;
+			typedef contvec_reader<T, U, contvec_aligned<Mat, U>::value> type;
 
 			LMAT_ENSURE_INLINE
 			static type get(const Mat& mat)
@@ -325,8 +454,8 @@ namespace lmat
 	};
 
 
-	template<typename T, typename Kind>
-	class contvec_writer<T, simd_<Kind> > : public simd_vec_accessor_base
+	template<typename T, typename Kind, bool Aligned>
+	class contvec_writer<T, simd_<Kind>, Aligned> : public simd_vec_accessor_base
 	{
 	public:
 		typedef T scalar_type;
@@ -358,7 +487,26 @@ namespace lmat
 		LMAT_ENSURE_INLINE
 		nil_t done_pack(index_t i) const
 		{
-			m_ptemp.store_u(m_pdata + i);
+			internal::contvec_pack_io<Aligned>::store(m_ptemp, m_pdata + i);
+			return nil_t();
+		}
+
+		LMAT_ENSURE_INLINE
+		pack_type& pack_part(index_t, index_t) const
+		{
+			return m_ptemp;
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t peel_hint(index_t i) const
+		{
+			return Aligned ? -1 : internal::contvec_peel_len<T, Kind>(m_pdata + i);
+		}
+
+		LMAT_ENSURE_INLINE
+		nil_t done_pack_part(index_t i, index_t n) const
+		{
+			m_ptemp.store_part(static_cast<unsigned int>(n), m_pdata + i);
 			return nil_t();
 		}
 
@@ -368,6 +516,13 @@ namespace lmat
 		T* m_pdata;
 	};
 
+	template<typename T, typename Kind, bool Aligned>
+	LMAT_ENSURE_INLINE
+	inline index_t pack_peel_hint(const contvec_writer<T, simd_<Kind>, Aligned>& acc, index_t i)
+	{
+		return acc.peel_hint(i);
+	}
+
 	// stepvec_writer
 
 	template<typename T>
@@ -413,7 +568,7 @@ namespace lmat
 		struct contvec_writer_map
 		{
 			typedef typename matrix_traits<Mat>::value_type T;
-			typedef contvec_writer<T, U> type;
+			typedef contvec_writer<T, U, contvec_aligned<Mat, U>::value> type;
 
 			LMAT_ENSURE_INLINE
 			static type get(Mat& mat)
@@ -515,8 +670,8 @@ namespace lmat
 	};
 
 
-	template<typename T, typename Kind>
-	class contvec_updater<T, simd_<Kind> > : public simd_vec_accessor_base
+	template<typename T, typename Kind, bool Aligned>
+	class contvec_updater<T, simd_<Kind>, Aligned> : public simd_vec_accessor_base
 	{
 	public:
 		typedef T scalar_type;
@@ -535,7 +690,7 @@ namespace lmat
 		LMAT_ENSURE_INLINE
 		pack_type& pack(index_t i) const
 		{
-			m_ptemp.load_u(m_pdata + i);
+			internal::contvec_pack_io<Aligned>::load(m_ptemp, m_pdata + i);
 			return m_ptemp;
 		}
 
@@ -549,7 +704,27 @@ namespace lmat
 		LMAT_ENSURE_INLINE
 		nil_t done_pack(index_t i) const
 		{
-			m_ptemp.store_u(m_pdata + i);
+			internal::contvec_pack_io<Aligned>::store(m_ptemp, m_pdata + i);
+			return nil_t();
+		}
+
+		LMAT_ENSURE_INLINE
+		pack_type& pack_part(index_t i, index_t n) const
+		{
+			m_ptemp.load_part(static_cast<unsigned int>(n), m_pdata + i);
+			return m_ptemp;
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t peel_hint(index_t i) const
+		{
+			return Aligned ? -1 : internal::contvec_peel_len<T, Kind>(m_pdata + i);
+		}
+
+		LMAT_ENSURE_INLINE
+		nil_t done_pack_part(index_t i, index_t n) const
+		{
+			m_ptemp.store_part(static_cast<unsigned int>(n), m_pdata + i);
 			return nil_t();
 		}
 
@@ -559,6 +734,13 @@ namespace lmat
 		T* m_pdata;
 	};
 
+	template<typename T, typename Kind, bool Aligned>
+	LMAT_ENSURE_INLINE
+	inline index_t pack_peel_hint(const contvec_updater<T, simd_<Kind>, Aligned>& acc, index_t i)
+	{
+		return acc.peel_hint(i);
+	}
+
 	// stepvec_updater
 
 	template<typename T>
@@ -603,7 +785,7 @@ namespace lmat
 		struct contvec_updater_map
 		{
 			typedef typename matrix_traits<Mat>::value_type T;
-			typedef contvec_updater<T, U> type;
+			typedef contvec_updater<T, U, contvec_aligned<Mat, U>::value> type;
 
 			LMAT_ENSURE_INLINE
 			static type get(Mat& mat)
@@ -932,6 +1114,156 @@ namespace lmat
 	}
 
 
-}
+	/********************************************
+	 *
+	 *  offset accessors
+	 *
+	 *  Accesses a sub-range [offset, offset + len)
+	 *  of an underlying vector accessor, in terms
+	 *  of local indices. Each instance carries its
+	 *  own copy of the underlying accessor, and
+	 *  thus its own temporaries.
+	 *
+	 ********************************************/
+
+	template<class Acc, typename U> class offset_vec_accessor;
+
+	template<class Acc>
+	class offset_vec_accessor<Acc, scalar_>
+	{
+	public:
+		LMAT_ENSURE_INLINE
+		offset_vec_accessor(const Acc& acc, index_t offset)
+		: m_acc(acc), m_offset(offset) { }
+
+		LMAT_ENSURE_INLINE
+		auto scalar(index_t i) const -> decltype(std::declval<const Acc&>().scalar(i))
+		{
+			return m_acc.scalar(m_offset + i);
+		}
+
+		LMAT_ENSURE_INLINE
+		nil_t done_scalar(index_t i) const
+		{
+			m_acc.done_scalar(m_offset + i);
+			return nil_t();
+		}
+
+		LMAT_ENSURE_INLINE
+		nil_t finalize() const
+		{
+			m_acc.finalize();
+			return nil_t();
+		}
+
+	private:
+		Acc m_acc;
+		index_t m_offset;
+	};
+
+	template<class Acc, typename Kind>
+	class offset_vec_accessor<Acc, simd_<Kind> >
+	{
+	public:
+		LMAT_ENSURE_INLINE
+		offset_vec_accessor(const Acc& acc, index_t offset)
+		: m_acc(acc), m_offset(offset) { }
+
+		LMAT_ENSURE_INLINE
+		auto scalar(index_t i) const -> decltype(std::declval<const Acc&>().scalar(i))
+		{
+			return m_acc.scalar(m_offset + i);
+		}
+
+		LMAT_ENSURE_INLINE
+		auto pack(index_t i) const -> decltype(std::declval<const Acc&>().pack(i))
+		{
+			return m_acc.pack(m_offset + i);
+		}
+
+		LMAT_ENSURE_INLINE
+		nil_t begin_packs() const
+		{
+			m_acc.begin_packs();
+			return nil_t();
+		}
+
+		LMAT_ENSURE_INLINE
+		nil_t end_packs() const
+		{
+			m_acc.end_packs();
+			return nil_t();
+		}
+
+		LMAT_ENSURE_INLINE
+		nil_t done_scalar(index_t i) const
+		{
+			m_acc.done_scalar(m_offset + i);
+			return nil_t();
+		}
+
+		LMAT_ENSURE_INLINE
+		nil_t done_pack(index_t i) const
+		{
+			m_acc.done_pack(m_offset + i);
+			return nil_t();
+		}
+
+		LMAT_ENSURE_INLINE
+		auto pack_part(index_t i, index_t n) const -> decltype(std::declval<const Acc&>().pack_part(i, n))
+		{
+			return m_acc.pack_part(m_offset + i, n);
+		}
+
+		LMAT_ENSURE_INLINE
+		nil_t done_pack_part(index_t i, index_t n) const
+		{
+			m_acc.done_pack_part(m_offset + i, n);
+			return nil_t();
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t peel_hint(index_t i) const
+		{
+			return pack_peel_hint(m_acc, m_offset + i);
+		}
+
+		LMAT_ENSURE_INLINE
+		nil_t finalize() const
+		{
+			m_acc.finalize();
+			return nil_t();
+		}
+
+	private:
+		Acc m_acc;
+		index_t m_offset;
+	};
+
+	template<class Acc, typename U>
+	struct supports_pack_part<offset_vec_accessor<Acc, U> >
+	: public supports_pack_part<Acc> { };
+
+	template<class Acc, typename U>
+	struct supports_pack_peel<offset_vec_accessor<Acc, U> >
+	: public supports_pack_peel<Acc> { };
+
+	template<class Acc, typename Kind>
+	LMAT_ENSURE_INLINE
+	inline index_t pack_peel_hint(const offset_vec_accessor<Acc, simd_<Kind> >& acc, index_t i)
+	{
+		return acc.peel_hint(i);
+	}
+
+	template<typename U, class Acc>
+	LMAT_ENSURE_INLINE
+	inline offset_vec_accessor<Acc, U>
+	make_offset_vec_accessor(U, const Acc& acc, index_t offset)
+	{
+		return offset_vec_accessor<Acc, U>(acc, offset);
+	}
+
+
+LMAT_END_NAMESPACE
 
 #endif /* VEC_ACCESSORS_H_ */
@@ -17,7 +17,7 @@
 #include <light_mat/matexpr/map_accessors.h>
 #include <light_mat/mateval/ewise_eval.h>
 
-namespace lmat { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace internal {
 
 	/********************************************
 	 *
@@ -337,6 +337,32 @@ namespace lmat { namespace internal {
 		}
 	};
 
+	template<typename Arg, bool IsXpr, typename U> struct _arg_multirow_reader_map;
+
+	template<typename Arg, typename U>
+	struct _arg_multirow_reader_map<Arg, true, U>
+	{
+		typedef typename multirow_reader_map<Arg, U>::type type;
+
+		LMAT_ENSURE_INLINE
+		static type get(const Arg& a)
+		{
+			return multirow_reader_map<Arg, U>::get(a);
+		}
+	};
+
+	template<typename Arg, typename U>
+	struct _arg_multirow_reader_map<Arg, false, U>
+	{
+		typedef multicol_single_reader<Arg, U> type;
+
+		LMAT_ENSURE_INLINE
+		static type get(const Arg& a)
+		{
+			return type(a);
+		}
+	};
+
 	template<typename Arg, typename U>
 	struct arg_vec_reader_map
 	{
@@ -364,6 +390,20 @@ namespace lmat { namespace internal {
 	};
 
 
+	template<typename Arg, typename U>
+	struct arg_multirow_reader_map
+	{
+		typedef _arg_multirow_reader_map<Arg, meta::is_mat_xpr<Arg>::value, U> intern_map_t;
+		typedef typename intern_map_t::type type;
+
+		LMAT_ENSURE_INLINE
+		static type get(const Arg& arg)
+		{
+			return intern_map_t::get(arg);
+		}
+	};
+
+
 	/********************************************
 	 *
 	 *  Evaluation policy
@@ -389,6 +429,44 @@ namespace lmat { namespace internal {
 	};
 
 
-} }
+	template<typename Arg, bool IsMat>
+	struct _arg_supp_parallel
+	{
+		static const bool value = true;
+	};
+
+	template<typename Arg>
+	struct _arg_supp_parallel<Arg, true>
+	{
+		static const bool value = supports_parallel_access<Arg>::value;
+	};
+
+	template<typename Arg>
+	struct arg_supp_parallel
+	{
+		static const bool value = _arg_supp_parallel<Arg, meta::is_mat_xpr<Arg>::value>::value;
+	};
+
+
+	template<typename Arg, bool IsMat>
+	struct _arg_supp_perrow
+	{
+		static const bool value = true;
+	};
+
+	template<typename Arg>
+	struct _arg_supp_perrow<Arg, true>
+	{
+		static const bool value = supports_perrow_access<Arg>::value;
+	};
+
+	template<typename Arg>
+	struct arg_supp_perrow
+	{
+		static const bool value = _arg_supp_perrow<Arg, meta::is_mat_xpr<Arg>::value>::value;
+	};
+
+
+} LMAT_END_NAMESPACE
 
 #endif /* MAP_EXPR_INTERNAL_H_ */
@@ -0,0 +1,249 @@
+/**
+ * @file mat_approx_internal.h
+ *
+ * @brief Internal implementation of the approximate evaluation policy
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_MAT_APPROX_INTERNAL_H_
+#define LIGHTMAT_MAT_APPROX_INTERNAL_H_
+
+#include <light_mat/matexpr/map_expr.h>
+#include <light_mat/math/approx_functors.h>
+
+LMAT_BEGIN_NAMESPACE namespace internal {
+
+	/********************************************
+	 *
+	 *  tag substitution
+	 *
+	 ********************************************/
+
+	template<typename FTag>
+	struct approx_ftag
+	{
+		typedef FTag type;
+	};
+
+	template<> struct approx_ftag<ftags::exp_> { typedef ftags::approx_exp_ type; };
+	template<> struct approx_ftag<ftags::log_> { typedef ftags::approx_log_ type; };
+	template<> struct approx_ftag<ftags::tanh_> { typedef ftags::approx_tanh_ type; };
+
+
+	/********************************************
+	 *
+	 *  reader kinds
+	 *
+	 ********************************************/
+
+	template<template<typename, typename> class RdMap> struct approx_rd_kind;
+
+	template<>
+	struct approx_rd_kind<vec_reader_map>
+	{
+		template<typename Fun, typename U, typename... Rds>
+		struct map_reader { typedef map_vec_reader<Fun, U, Rds...> type; };
+
+		template<typename Arg, typename U>
+		struct single { typedef single_reader<Arg, U> type; };
+	};
+
+	template<>
+	struct approx_rd_kind<multicol_reader_map>
+	{
+		template<typename Fun, typename U, typename... Rds>
+		struct map_reader { typedef map_multicol_reader<Fun, U, Rds...> type; };
+
+		template<typename Arg, typename U>
+		struct single { typedef multicol_single_reader<Arg, U> type; };
+	};
+
+	template<>
+	struct approx_rd_kind<multirow_reader_map>
+	{
+		template<typename Fun, typename U, typename... Rds>
+		struct map_reader { typedef map_multicol_reader<Fun, U, Rds...> type; };
+
+		template<typename Arg, typename U>
+		struct single { typedef multicol_single_reader<Arg, U> type; };
+	};
+
+
+	/********************************************
+	 *
+	 *  reader mapping
+	 *
+	 *  Map expressions are rebuilt with their
+	 *  tags substituted, all the way down; any
+	 *  other expression uses its own readers.
+	 *
+	 ********************************************/
+
+	template<class Expr, typename U, template<typename, typename> class RdMap>
+	struct approx_reader_map
+	{
+		typedef typename RdMap<Expr, U>::type type;
+
+		LMAT_ENSURE_INLINE
+		static type get(const Expr& expr)
+		{
+			return RdMap<Expr, U>::get(expr);
+		}
+	};
+
+	template<typename Arg, typename U, template<typename, typename> class RdMap, bool IsXpr>
+	struct _approx_arg_reader_map;
+
+	template<typename Arg, typename U, template<typename, typename> class RdMap>
+	struct _approx_arg_reader_map<Arg, U, RdMap, true>
+	{
+		typedef typename approx_reader_map<Arg, U, RdMap>::type type;
+
+		LMAT_ENSURE_INLINE
+		static type get(const Arg& a)
+		{
+			return approx_reader_map<Arg, U, RdMap>::get(a);
+		}
+	};
+
+	template<typename Arg, typename U, template<typename, typename> class RdMap>
+	struct _approx_arg_reader_map<Arg, U, RdMap, false>
+	{
+		typedef typename approx_rd_kind<RdMap>::template single<Arg, U>::type type;
+
+		LMAT_ENSURE_INLINE
+		static type get(const Arg& a)
+		{
+			return type(a);
+		}
+	};
+
+	template<typename Arg, typename U, template<typename, typename> class RdMap>
+	struct approx_arg_reader_map
+	{
+		typedef _approx_arg_reader_map<Arg, U, RdMap, meta::is_mat_xpr<Arg>::value> intern_map_t;
+		typedef typename intern_map_t::type type;
+
+		LMAT_ENSURE_INLINE
+		static type get(const Arg& arg)
+		{
+			return intern_map_t::get(arg);
+		}
+	};
+
+	template<typename FTag, typename Arg1, typename U, template<typename, typename> class RdMap>
+	struct approx_reader_map<map_expr<FTag, Arg1>, U, RdMap>
+	{
+		typedef map_expr<FTag, Arg1> expr_type;
+		typedef typename map_expr_fun<typename approx_ftag<FTag>::type, U, Arg1>::type fun_type;
+
+		typedef approx_arg_reader_map<Arg1, U, RdMap> arg1_map_t;
+		typedef typename approx_rd_kind<RdMap>::template map_reader<fun_type, U,
+				typename arg1_map_t::type>::type type;
+
+		LMAT_ENSURE_INLINE
+		static type get(const expr_type& expr)
+		{
+			return type(fun_type(), U(),
+					arg1_map_t::get(expr.arg1()) );
+		}
+	};
+
+	template<typename FTag, typename Arg1, typename Arg2, typename U, template<typename, typename> class RdMap>
+	struct approx_reader_map<map_expr<FTag, Arg1, Arg2>, U, RdMap>
+	{
+		typedef map_expr<FTag, Arg1, Arg2> expr_type;
+		typedef typename map_expr_fun<typename approx_ftag<FTag>::type, U, Arg1, Arg2>::type fun_type;
+
+		typedef approx_arg_reader_map<Arg1, U, RdMap> arg1_map_t;
+		typedef approx_arg_reader_map<Arg2, U, RdMap> arg2_map_t;
+		typedef typename approx_rd_kind<RdMap>::template map_reader<fun_type, U,
+				typename arg1_map_t::type,
+				typename arg2_map_t::type>::type type;
+
+		LMAT_ENSURE_INLINE
+		static type get(const expr_type& expr)
+		{
+			return type(fun_type(), U(),
+					arg1_map_t::get(expr.arg1()),
+					arg2_map_t::get(expr.arg2()) );
+		}
+	};
+
+	template<typename FTag, typename Arg1, typename Arg2, typename Arg3, typename U, template<typename, typename> class RdMap>
+	struct approx_reader_map<map_expr<FTag, Arg1, Arg2, Arg3>, U, RdMap>
+	{
+		typedef map_expr<FTag, Arg1, Arg2, Arg3> expr_type;
+		typedef typename map_expr_fun<typename approx_ftag<FTag>::type, U, Arg1, Arg2, Arg3>::type fun_type;
+
+		typedef approx_arg_reader_map<Arg1, U, RdMap> arg1_map_t;
+		typedef approx_arg_reader_map<Arg2, U, RdMap> arg2_map_t;
+		typedef approx_arg_reader_map<Arg3, U, RdMap> arg3_map_t;
+		typedef typename approx_rd_kind<RdMap>::template map_reader<fun_type, U,
+				typename arg1_map_t::type,
+				typename arg2_map_t::type,
+				typename arg3_map_t::type>::type type;
+
+		LMAT_ENSURE_INLINE
+		static type get(const expr_type& expr)
+		{
+			return type(fun_type(), U(),
+					arg1_map_t::get(expr.arg1()),
+					arg2_map_t::get(expr.arg2()),
+					arg3_map_t::get(expr.arg3()) );
+		}
+	};
+
+
+	/********************************************
+	 *
+	 *  SIMD support
+	 *
+	 *  The substituted functors decide, as exp
+	 *  may lack a SIMD version where approx_exp
+	 *  has one.
+	 *
+	 ********************************************/
+
+	template<class Expr, typename Kind>
+	struct approx_supp_simd
+	{
+		static const bool value = supports_simd<Expr, Kind>::value;
+	};
+
+	template<typename FTag, typename Kind, typename... Args>
+	struct approx_supp_simd<map_expr<FTag, Args...>, Kind>
+	{
+		typedef typename fun_map<typename approx_ftag<FTag>::type,
+				typename arg_value_type<Args>::type...>::type fun_t;
+
+		static const bool value =
+				is_simdizable<fun_t, Kind>::value &&
+				meta::all_<approx_supp_simd<Args, Kind>...>::value;
+	};
+
+	template<class Expr, typename Kind>
+	struct approx_supp_perrow_simd
+	{
+		static const bool value = supports_perrow_simd<Expr, Kind>::value;
+	};
+
+	template<typename FTag, typename Kind, typename... Args>
+	struct approx_supp_perrow_simd<map_expr<FTag, Args...>, Kind>
+	{
+		typedef typename fun_map<typename approx_ftag<FTag>::type,
+				typename arg_value_type<Args>::type...>::type fun_t;
+
+		static const bool value =
+				is_simdizable<fun_t, Kind>::value &&
+				meta::all_<approx_supp_perrow_simd<Args, Kind>...>::value;
+	};
+
+} LMAT_END_NAMESPACE
+
+#endif
@@ -16,8 +16,7 @@
 #include <light_mat/mateval/multicol_accessors.h>
 #include <light_mat/math/functor_base.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	// forward declarations
 
 	template<typename Fun, typename U, typename... ArgReaders> class map_vec_reader;
@@ -82,6 +81,12 @@ namespace lmat
 			return m_pkfun(m_rd1.pack(i));
 		}
 
+		LMAT_ENSURE_INLINE
+		pack_t pack_part(index_t i, index_t n) const
+		{
+			return m_pkfun(m_rd1.pack_part(i, n));
+		}
+
 	private:
 		Fun m_fun;
 		simd_fun_t m_pkfun;
@@ -142,6 +147,12 @@ namespace lmat
 			return m_pkfun(m_rd1.pack(i), m_rd2.pack(i));
 		}
 
+		LMAT_ENSURE_INLINE
+		pack_t pack_part(index_t i, index_t n) const
+		{
+			return m_pkfun(m_rd1.pack_part(i, n), m_rd2.pack_part(i, n));
+		}
+
 	private:
 		Fun m_fun;
 		simd_fun_t m_pkfun;
@@ -206,6 +217,12 @@ namespace lmat
 			return m_pkfun(m_rd1.pack(i), m_rd2.pack(i), m_rd3.pack(i));
 		}
 
+		LMAT_ENSURE_INLINE
+		pack_t pack_part(index_t i, index_t n) const
+		{
+			return m_pkfun(m_rd1.pack_part(i, n), m_rd2.pack_part(i, n), m_rd3.pack_part(i, n));
+		}
+
 	private:
 		Fun m_fun;
 		simd_fun_t m_pkfun;
@@ -215,6 +232,15 @@ namespace lmat
 	};
 
 
+	template<typename Fun, typename Kind, typename... ArgReaders>
+	struct supports_pack_part<map_vec_reader<Fun, simd_<Kind>, ArgReaders...> >
+	: public meta::all_<supports_pack_part<ArgReaders>...> { };
+
+	template<typename Fun, typename Kind, typename... ArgReaders>
+	struct supports_pack_peel<map_vec_reader<Fun, simd_<Kind>, ArgReaders...> >
+	: public meta::all_<supports_pack_peel<ArgReaders>...> { };
+
+
 	/********************************************
 	 *
 	 *  Multi-column readers
@@ -300,6 +326,6 @@ namespace lmat
 
 
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* MAP_ACCESSORS_H_ */
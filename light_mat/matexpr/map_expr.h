@@ -18,8 +18,7 @@
 
 #include "internal/map_expr_internal.h"
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	// forward declarations
 
@@ -435,6 +434,63 @@ namespace lmat
 						internal::arg_multicol_reader_map<Arg3, U>::get(expr.arg3()) );
 			}
 		};
+
+		template<typename FTag, typename Arg1, typename U>
+		struct multirow_reader_map<map_expr<FTag, Arg1>, U>
+		{
+			typedef map_expr<FTag, Arg1> expr_type;
+			typedef typename internal::map_expr_fun<FTag, U, Arg1>::type fun_type;
+
+			typedef typename internal::arg_multirow_reader_map<Arg1, U>::type arg1_rd_t;
+			typedef map_multicol_reader<fun_type, U, arg1_rd_t> type;
+
+			LMAT_ENSURE_INLINE
+			static type get(const expr_type& expr)
+			{
+				return type(fun_type(), U(),
+						internal::arg_multirow_reader_map<Arg1, U>::get(expr.arg1()) );
+			}
+		};
+
+		template<typename FTag, typename Arg1, typename Arg2, typename U>
+		struct multirow_reader_map<map_expr<FTag, Arg1, Arg2>, U>
+		{
+			typedef map_expr<FTag, Arg1, Arg2> expr_type;
+			typedef typename internal::map_expr_fun<FTag, U, Arg1, Arg2>::type fun_type;
+
+			typedef typename internal::arg_multirow_reader_map<Arg1, U>::type arg1_rd_t;
+			typedef typename internal::arg_multirow_reader_map<Arg2, U>::type arg2_rd_t;
+			typedef map_multicol_reader<fun_type, U, arg1_rd_t, arg2_rd_t> type;
+
+			LMAT_ENSURE_INLINE
+			static type get(const expr_type& expr)
+			{
+				return type(fun_type(), U(),
+						internal::arg_multirow_reader_map<Arg1, U>::get(expr.arg1()),
+						internal::arg_multirow_reader_map<Arg2, U>::get(expr.arg2()) );
+			}
+		};
+
+		template<typename FTag, typename Arg1, typename Arg2, typename Arg3, typename U>
+		struct multirow_reader_map<map_expr<FTag, Arg1, Arg2, Arg3>, U>
+		{
+			typedef map_expr<FTag, Arg1, Arg2, Arg3> expr_type;
+			typedef typename internal::map_expr_fun<FTag, U, Arg1, Arg2, Arg3>::type fun_type;
+
+			typedef typename internal::arg_multirow_reader_map<Arg1, U>::type arg1_rd_t;
+			typedef typename internal::arg_multirow_reader_map<Arg2, U>::type arg2_rd_t;
+			typedef typename internal::arg_multirow_reader_map<Arg3, U>::type arg3_rd_t;
+			typedef map_multicol_reader<fun_type, U, arg1_rd_t, arg2_rd_t, arg3_rd_t> type;
+
+			LMAT_ENSURE_INLINE
+			static type get(const expr_type& expr)
+			{
+				return type(fun_type(), U(),
+						internal::arg_multirow_reader_map<Arg1, U>::get(expr.arg1()),
+						internal::arg_multirow_reader_map<Arg2, U>::get(expr.arg2()),
+						internal::arg_multirow_reader_map<Arg3, U>::get(expr.arg3()) );
+			}
+		};
 	}
 
 
@@ -462,6 +518,31 @@ namespace lmat
 				meta::all_<supports_simd<Args, Kind>...>::value;
 	};
 
+	template<typename FTag, typename... Args>
+	struct supports_perrow_access<map_expr<FTag, Args...> >
+	{
+		static const bool value =
+				meta::all_<internal::arg_supp_perrow<Args>...>::value;
+	};
+
+	template<typename FTag, typename Kind, typename... Args>
+	struct supports_perrow_simd<map_expr<FTag, Args...>, Kind>
+	{
+		typedef typename fun_map<FTag,
+				typename internal::arg_value_type<Args>::type...>::type fun_t;
+
+		static const bool value =
+				is_simdizable<fun_t, Kind>::value &&
+				meta::all_<supports_perrow_simd<Args, Kind>...>::value;
+	};
+
+	template<typename FTag, typename... Args>
+	struct supports_parallel_access<map_expr<FTag, Args...> >
+	{
+		static const bool value =
+				meta::all_<internal::arg_supp_parallel<Args>...>::value;
+	};
+
 	template<typename FTag, typename... Args, class DMat>
 	LMAT_ENSURE_INLINE
 	inline void evaluate(const map_expr<FTag, Args...>& sexpr,
@@ -471,7 +552,7 @@ namespace lmat
 	}
 
 
-}
+LMAT_END_NAMESPACE
 
 #endif
 
@@ -22,8 +22,7 @@
 	template<> struct type_name<ftags::T> { \
 		static std::string get() { return #T; } };
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	/********************************************
 	 *
@@ -117,6 +116,15 @@ namespace lmat
 	_LMAT_DEFINE_FTAG_NAME( lgamma_ )
 	_LMAT_DEFINE_FTAG_NAME( tgamma_ )
 
+	// approximate math
+
+	_LMAT_DEFINE_FTAG_NAME( approx_exp_ )
+	_LMAT_DEFINE_FTAG_NAME( approx_log_ )
+	_LMAT_DEFINE_FTAG_NAME( approx_tanh_ )
+	_LMAT_DEFINE_FTAG_NAME( approx_sigmoid_ )
+	_LMAT_DEFINE_FTAG_NAME( approx_rcp_ )
+	_LMAT_DEFINE_FTAG_NAME( approx_rsqrt_ )
+
 	// numeric predicates
 
 	_LMAT_DEFINE_FTAG_NAME( signbit_ )
@@ -181,6 +189,6 @@ namespace lmat
 		dump_expr(out, expr.arg3(), indent+1);
 	}
 
-}
+LMAT_END_NAMESPACE
 
 #endif
@@ -0,0 +1,183 @@
+/**
+ * @file mat_approx.h
+ *
+ * @brief Fast approximate math functions on matrices
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_MAT_APPROX_H_
+#define LIGHTMAT_MAT_APPROX_H_
+
+#include <light_mat/matexpr/matfun_base.h>
+#include <light_mat/math/approx_functors.h>
+#include "internal/mat_approx_internal.h"
+
+LMAT_BEGIN_NAMESPACE
+	// exp & log
+
+	_LMAT_DEFINE_RMATFUN( approx_exp, 1 )
+	_LMAT_DEFINE_RMATFUN( approx_log, 1 )
+
+	// activations
+
+	_LMAT_DEFINE_RMATFUN( approx_tanh, 1 )
+	_LMAT_DEFINE_RMATFUN( approx_sigmoid, 1 )
+
+	// simple power functions
+
+	_LMAT_DEFINE_RMATFUN( approx_rcp, 1 )
+	_LMAT_DEFINE_RMATFUN( approx_rsqrt, 1 )
+
+
+	/********************************************
+	 *
+	 *  Approximate evaluation policy
+	 *
+	 *  approx_(e) evaluates e with exp, log and
+	 *  tanh replaced by approx_exp, approx_log and
+	 *  approx_tanh, in every nested map expression
+	 *  of e. Thus approx_(rcp(1.0 + exp(-x))) is a
+	 *  sigmoid with an approximate exp. Other
+	 *  expressions in e are evaluated as they are.
+	 *
+	 ********************************************/
+
+	template<class Arg> class approx_expr;
+
+	template<class Arg>
+	struct matrix_traits<approx_expr<Arg> >
+	: public matrix_xpr_traits_base<
+	  typename matrix_traits<Arg>::value_type,
+	  meta::nrows<Arg>::value,
+	  meta::ncols<Arg>::value,
+	  typename matrix_traits<Arg>::domain> { };
+
+	template<class Arg>
+	class approx_expr
+	: public IEWiseMatrix<approx_expr<Arg>, typename matrix_traits<Arg>::value_type>
+	{
+		typedef matrix_shape<meta::nrows<Arg>::value, meta::ncols<Arg>::value> shape_type;
+
+	public:
+		LMAT_ENSURE_INLINE
+		explicit approx_expr(const Arg& a)
+		: m_arg(a) { }
+
+		LMAT_ENSURE_INLINE const Arg& arg() const
+		{
+			return m_arg;
+		}
+
+		LMAT_ENSURE_INLINE index_t nrows() const
+		{
+			return m_arg.nrows();
+		}
+
+		LMAT_ENSURE_INLINE index_t ncolumns() const
+		{
+			return m_arg.ncolumns();
+		}
+
+		LMAT_ENSURE_INLINE index_t nelems() const
+		{
+			return m_arg.nelems();
+		}
+
+		LMAT_ENSURE_INLINE shape_type shape() const
+		{
+			return m_arg.shape();
+		}
+
+	private:
+		const Arg& m_arg;
+	};
+
+	template<typename T, class Arg>
+	LMAT_ENSURE_INLINE
+	inline approx_expr<Arg> approx_(const IEWiseMatrix<Arg, T>& a)
+	{
+		return approx_expr<Arg>(a.derived());
+	}
+
+
+	namespace internal
+	{
+		template<class Arg, typename U>
+		struct vec_reader_map<approx_expr<Arg>, U>
+		{
+			typedef approx_reader_map<Arg, U, vec_reader_map> map_t;
+			typedef typename map_t::type type;
+
+			LMAT_ENSURE_INLINE
+			static type get(const approx_expr<Arg>& expr)
+			{
+				return map_t::get(expr.arg());
+			}
+		};
+
+		template<class Arg, typename U>
+		struct multicol_reader_map<approx_expr<Arg>, U>
+		{
+			typedef approx_reader_map<Arg, U, multicol_reader_map> map_t;
+			typedef typename map_t::type type;
+
+			LMAT_ENSURE_INLINE
+			static type get(const approx_expr<Arg>& expr)
+			{
+				return map_t::get(expr.arg());
+			}
+		};
+
+		template<class Arg, typename U>
+		struct multirow_reader_map<approx_expr<Arg>, U>
+		{
+			typedef approx_reader_map<Arg, U, multirow_reader_map> map_t;
+			typedef typename map_t::type type;
+
+			LMAT_ENSURE_INLINE
+			static type get(const approx_expr<Arg>& expr)
+			{
+				return map_t::get(expr.arg());
+			}
+		};
+	}
+
+	template<class Arg>
+	struct supports_linear_access<approx_expr<Arg> >
+	: public supports_linear_access<Arg> { };
+
+	template<class Arg, typename Kind>
+	struct supports_simd<approx_expr<Arg>, Kind>
+	{
+		static const bool value = internal::approx_supp_simd<Arg, Kind>::value;
+	};
+
+	template<class Arg>
+	struct supports_perrow_access<approx_expr<Arg> >
+	: public supports_perrow_access<Arg> { };
+
+	template<class Arg, typename Kind>
+	struct supports_perrow_simd<approx_expr<Arg>, Kind>
+	{
+		static const bool value = internal::approx_supp_perrow_simd<Arg, Kind>::value;
+	};
+
+	template<class Arg>
+	struct supports_parallel_access<approx_expr<Arg> >
+	: public supports_parallel_access<Arg> { };
+
+	template<typename T, class Arg, class DMat>
+	LMAT_ENSURE_INLINE
+	inline void evaluate(const approx_expr<Arg>& sexpr, IRegularMatrix<DMat, T>& dmat)
+	{
+		macc_evaluate(sexpr, dmat);
+	}
+
+LMAT_END_NAMESPACE
+
+#endif
@@ -16,8 +16,7 @@
 #include <light_mat/matexpr/matfun_base.h>
 #include <light_mat/math/basic_functors.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	// arithmetics
 
@@ -102,6 +101,6 @@ namespace lmat
 		return make_map_expr_fix2(ftags::cond_(), c, x, y);
 	}
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* MAT_ARITH_H_ */
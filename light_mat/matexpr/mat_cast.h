@@ -22,8 +22,7 @@
 	Fun(const IEWiseMatrix<SMat, S>& smat) { \
 		return make_map_expr(cast_<T>(), smat); }
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	/********************************************
 	 *
 	 *  definitions of functors and maps
@@ -83,6 +82,6 @@ namespace lmat
 	LMAT_DEFINE_MAT_CAST_FUN( mask_t<double>, to_f64m )
 	LMAT_DEFINE_MAT_CAST_FUN( mask_t<float>,  to_f32m )
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* MAT_CAST_H_ */
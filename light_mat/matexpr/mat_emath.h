@@ -16,8 +16,7 @@
 #include <light_mat/matexpr/matfun_base.h>
 #include <light_mat/math/math_functors.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	// power functions
 
@@ -60,6 +59,6 @@ namespace lmat
 	_LMAT_DEFINE_RMATFUN( acosh, 1 )
 	_LMAT_DEFINE_RMATFUN( atanh, 1 )
 
-}
+LMAT_END_NAMESPACE
 
 #endif
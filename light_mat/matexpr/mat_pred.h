@@ -51,8 +51,7 @@
 	{ return make_map_expr(ftags::FTag(), x, y); } \
 
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	// comparison
 
 	_LMAT_DEFINE_GMATOP( eq, ==, 2 )
@@ -76,6 +75,6 @@ namespace lmat
 	_LMAT_DEFINE_MAT_LOGICAL_FUN_2( operator ==, logical_eq_ )
 	_LMAT_DEFINE_MAT_LOGICAL_FUN_2( operator !=, logical_ne_ )
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* MAT_PRED_H_ */
@@ -16,8 +16,7 @@
 #include <light_mat/matexpr/matfun_base.h>
 #include <light_mat/math/special_functors.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	// gauss related
 
 	_LMAT_DEFINE_RMATFUN( erf, 1 )
@@ -29,6 +28,6 @@ namespace lmat
 	_LMAT_DEFINE_RMATFUN( lgamma, 1 )
 	_LMAT_DEFINE_RMATFUN( tgamma, 1 )
 
-}
+LMAT_END_NAMESPACE
 
 #endif
@@ -16,8 +16,7 @@
 #include <light_mat/matexpr/map_expr.h>
 #include <tuple>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	/********************************************
 	 *
 	 *  Zip
@@ -160,6 +159,6 @@ namespace lmat
 	}
 
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* ZIP_EXPR_H_ */
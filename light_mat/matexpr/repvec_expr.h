@@ -15,8 +15,7 @@
 
 #include <light_mat/mateval/ewise_eval.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	// forward declarations
 
 	template<class Arg, index_t CN=0> class repcol_expr;
@@ -201,6 +200,14 @@ namespace lmat
 	struct supports_simd<reprow_expr<Arg, CM>, Kind>
 	: public supports_simd<typename matrix_traits<Arg>::value_type, Kind> { };
 
+	template<typename Arg, index_t CN>
+	struct supports_parallel_access<repcol_expr<Arg, CN> >
+	: public supports_parallel_access<Arg> { };
+
+	template<typename Arg, index_t CM>
+	struct supports_parallel_access<reprow_expr<Arg, CM> >
+	: public supports_parallel_access<Arg> { };
+
 
 	template<typename Arg, index_t CN, class DMat>
 	inline void evaluate(const repcol_expr<Arg, CN>& sexpr,
@@ -260,6 +267,6 @@ namespace lmat
 	}
 
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* REPVEC_EXPR_H_ */
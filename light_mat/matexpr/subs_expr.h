@@ -16,8 +16,7 @@
 #include <light_mat/matrix/matrix_base.h>
 #include <light_mat/mateval/ewise_eval.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	// forward declaration
 
 	template<typename T, index_t CM, index_t CN> class inds_expr;
@@ -355,6 +354,15 @@ namespace lmat
 	template<typename VT, index_t CM, index_t CN, typename Kind>
 	struct supports_simd<subs_j_expr<VT, CM, CN>, Kind> : public meta::false_ { };
 
+	template<typename T, index_t CM, index_t CN>
+	struct supports_parallel_access<inds_expr<T, CM, CN> > : public meta::true_ { };
+
+	template<typename T, index_t CM, index_t CN>
+	struct supports_parallel_access<subs_i_expr<T, CM, CN> > : public meta::true_ { };
+
+	template<typename T, index_t CM, index_t CN>
+	struct supports_parallel_access<subs_j_expr<T, CM, CN> > : public meta::true_ { };
+
 
 	template<typename T, index_t CM, index_t CN, class DMat>
 	LMAT_ENSURE_INLINE
@@ -378,6 +386,6 @@ namespace lmat
 	}
 
 
-}
+LMAT_END_NAMESPACE
 
 #endif 
@@ -0,0 +1,37 @@
+/**
+ * @file approx_functors.h
+ *
+ * @brief Functors for fast approximate math functions
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_APPROX_FUNCTORS_H_
+#define LIGHTMAT_APPROX_FUNCTORS_H_
+
+#include <light_mat/math/basic_functors.h>
+#include <light_mat/math/approx_math.h>
+
+LMAT_BEGIN_NAMESPACE
+	// exp & log
+
+	_LMAT_DEFINE_REAL_MATH_FUN( approx_exp, 1 )
+	_LMAT_DEFINE_REAL_MATH_FUN( approx_log, 1 )
+
+	// activations
+
+	_LMAT_DEFINE_REAL_MATH_FUN( approx_tanh, 1 )
+	_LMAT_DEFINE_REAL_MATH_FUN( approx_sigmoid, 1 )
+
+	// simple power functions
+
+	_LMAT_DEFINE_REAL_MATH_FUN( approx_rcp, 1 )
+	_LMAT_DEFINE_REAL_MATH_FUN( approx_rsqrt, 1 )
+LMAT_END_NAMESPACE
+
+
+#endif
@@ -0,0 +1,312 @@
+/**
+ * @file approx_math.h
+ *
+ * @brief Fast approximate math functions
+ *
+ * These functions trade accuracy for speed, and are meant for
+ * element-wise kernels whose results only need a few significant
+ * digits (e.g. activations, soft assignments, or weights).
+ *
+ * The SIMD versions use short polynomials, and are available on all
+ * pack kinds regardless of which SIMD math library is in use. The
+ * scalar versions simply forward to the exact functions.
+ *
+ * Maximum relative errors (f32 / f64), measured with random inputs:
+ *
+ *  approx_exp		4e-6 / 4e-6
+ *  approx_log		8e-6 / 8e-6
+ *  approx_tanh		4e-6 / 4e-6
+ *  approx_sigmoid	4e-6 / 4e-6
+ *  approx_rcp		4e-4 / 4e-4		(AVX-512: 7e-5 / 7e-5)
+ *  approx_rsqrt	4e-4 / 4e-4		(AVX-512: 7e-5 / 7e-5)
+ *
+ * The f64 versions of approx_rcp and approx_rsqrt go through single
+ * precision (except on AVX-512), and are therefore only valid for
+ * inputs within the range of float. approx_log is not accurate for
+ * subnormal inputs. Infinities, zeros and NaNs are handled as in the
+ * exact functions.
+ *
+ * sigmoid(x) = 1 / (1 + exp(-x))
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_APPROX_MATH_H_
+#define LIGHTMAT_APPROX_MATH_H_
+
+#include <light_mat/math/math.h>
+#include <light_mat/simd/simd.h>
+#include "internal/native_simd_bits.h"
+
+LMAT_BEGIN_NAMESPACE namespace math {
+
+	/********************************************
+	 *
+	 *  scalar versions
+	 *
+	 ********************************************/
+
+	LMAT_ENSURE_INLINE inline float  approx_exp(float  x) { return exp(x); }
+	LMAT_ENSURE_INLINE inline double approx_exp(double x) { return exp(x); }
+
+	LMAT_ENSURE_INLINE inline float  approx_log(float  x) { return log(x); }
+	LMAT_ENSURE_INLINE inline double approx_log(double x) { return log(x); }
+
+	LMAT_ENSURE_INLINE inline float  approx_tanh(float  x) { return tanh(x); }
+	LMAT_ENSURE_INLINE inline double approx_tanh(double x) { return tanh(x); }
+
+	LMAT_ENSURE_INLINE inline float  approx_rcp(float  x) { return rcp(x); }
+	LMAT_ENSURE_INLINE inline double approx_rcp(double x) { return rcp(x); }
+
+	LMAT_ENSURE_INLINE inline float  approx_rsqrt(float  x) { return rsqrt(x); }
+	LMAT_ENSURE_INLINE inline double approx_rsqrt(double x) { return rsqrt(x); }
+
+	LMAT_ENSURE_INLINE
+	inline float approx_sigmoid(float x)
+	{
+		float e = exp(-abs(x));
+		float s = 1.0f / (1.0f + e);
+		return x >= 0.0f ? s : e * s;
+	}
+
+	LMAT_ENSURE_INLINE
+	inline double approx_sigmoid(double x)
+	{
+		double e = exp(-abs(x));
+		double s = 1.0 / (1.0 + e);
+		return x >= 0.0 ? s : e * s;
+	}
+
+} LMAT_END_NAMESPACE
+
+
+LMAT_BEGIN_NAMESPACE namespace math { namespace internal {
+
+	/********************************************
+	 *
+	 *  constants
+	 *
+	 ********************************************/
+
+	template<typename T> struct approx_consts;
+
+	template<> struct approx_consts<float>
+	{
+		LMAT_ENSURE_INLINE static float log2e()   { return 1.44269504088896341f; }
+		LMAT_ENSURE_INLINE static float ln2_hi()  { return 0.693359375f; }
+		LMAT_ENSURE_INLINE static float ln2_lo()  { return -2.12194440e-4f; }
+		LMAT_ENSURE_INLINE static float ln2()     { return 0.693147180559945f; }
+		LMAT_ENSURE_INLINE static float sqrt2()   { return 1.41421356237f; }
+
+		// beyond these, exp overflows (resp. underflows to zero)
+		LMAT_ENSURE_INLINE static float exp_ub()  { return 89.0f; }
+		LMAT_ENSURE_INLINE static float exp_lb()  { return -104.0f; }
+	};
+
+	template<> struct approx_consts<double>
+	{
+		LMAT_ENSURE_INLINE static double log2e()   { return 1.4426950408889634074; }
+		LMAT_ENSURE_INLINE static double ln2_hi()  { return 6.93147180369123816490e-01; }
+		LMAT_ENSURE_INLINE static double ln2_lo()  { return 1.90821492927058770002e-10; }
+		LMAT_ENSURE_INLINE static double ln2()     { return 0.69314718055994530942; }
+		LMAT_ENSURE_INLINE static double sqrt2()   { return 1.41421356237309504880; }
+
+		LMAT_ENSURE_INLINE static double exp_ub()  { return 710.0; }
+		LMAT_ENSURE_INLINE static double exp_lb()  { return -746.0; }
+	};
+
+
+	/********************************************
+	 *
+	 *  generic implementation
+	 *
+	 ********************************************/
+
+	// exp(x) = 2^n * exp(r), |r| <= ln2 / 2, with a degree-4 polynomial for exp(r)
+
+	template<typename T, typename Kind>
+	LMAT_ENSURE_INLINE
+	inline simd_pack<T, Kind> approx_exp_impl(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+		typedef approx_consts<T> C;
+
+		// clamping first sends infinities to the right place (and keeps NaNs)
+		pack_t xc = (min)(pack_t(C::exp_ub()), (max)(pack_t(C::exp_lb()), x));
+
+		pack_t n = round(xc * pack_t(C::log2e()));
+		pack_t r = (xc - n * pack_t(C::ln2_hi())) - n * pack_t(C::ln2_lo());
+
+		pack_t p = horner(r,
+				pack_t(T(4.1917529687789216e-2)),
+				pack_t(T(1.6792160974654638e-1)),
+				pack_t(T(4.9998869108813615e-1)),
+				pack_t(T(9.9996227847543310e-1)),
+				pack_t(T(1.0000000754953486)));
+
+		return ldexp_i(p, n);
+	}
+
+	// log(x) = e * ln2 + log(1 + f), sqrt(2)/2 < 1 + f <= sqrt(2),
+	// with log(1 + f) = f * P(f), P of degree 5
+
+	template<typename T, typename Kind>
+	LMAT_ENSURE_INLINE
+	inline simd_pack<T, Kind> approx_log_impl(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+		typedef approx_consts<T> C;
+
+		pack_t z = pack_t::zeros();
+
+		pack_t e;
+		pack_t m = frexp_i(x, e);
+
+		simd_bpack<T, Kind> big = m > pack_t(C::sqrt2());
+		m = cond(big, m * pack_t(T(0.5)), m);
+		e = e + cond(big, pack_t(T(1)), z);
+
+		pack_t f = m - pack_t(T(1));
+		pack_t p = horner(f,
+				pack_t(T(-1.4338312557585225e-1)),
+				pack_t(T( 2.2070299637255517e-1)),
+				pack_t(T(-2.5397831766230160e-1)),
+				pack_t(T( 3.3256777805220356e-1)),
+				pack_t(T(-4.9990361588200470e-1)),
+				pack_t(T( 1.0000046848976194)));
+
+		pack_t y = fma(e, pack_t(C::ln2()), f * p);
+
+		y = cond(x > z, y, cond(x == z, -pack_t::inf(), pack_t::nan()));
+		return cond(x == pack_t::inf(), x, y);
+	}
+
+	// tanh(x) = x * P(x^2) for |x| < 0.625, and (1 - e) / (1 + e) with
+	// e = exp(-2|x|) otherwise
+
+	template<typename T, typename Kind>
+	LMAT_ENSURE_INLINE
+	inline simd_pack<T, Kind> approx_tanh_impl(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+
+		pack_t one(T(1));
+		pack_t ax = abs(x);
+
+		pack_t e = approx_exp_impl(ax * pack_t(T(-2)));
+		pack_t t = (one - e) / (one + e);
+		t = cond(x < pack_t::zeros(), -t, t);
+
+		pack_t x2 = x * x;
+		pack_t ts = x * horner(x2,
+				pack_t(T(-4.006336221930445e-2)),
+				pack_t(T( 1.301745473882081e-1)),
+				pack_t(T(-3.330952699939334e-1)),
+				pack_t(T( 9.999971554708728e-1)));
+
+		return cond(ax < pack_t(T(0.625)), ts, t);
+	}
+
+	// sigmoid(x) = 1 / (1 + e) for x >= 0, and e / (1 + e) for x < 0,
+	// with e = exp(-|x|), so that nothing overflows
+
+	template<typename T, typename Kind>
+	LMAT_ENSURE_INLINE
+	inline simd_pack<T, Kind> approx_sigmoid_impl(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+
+		pack_t e = approx_exp_impl(-abs(x));
+		pack_t s = pack_t(T(1)) / (pack_t(T(1)) + e);
+		return cond(x >= pack_t::zeros(), s, e * s);
+	}
+
+} } LMAT_END_NAMESPACE
+
+
+/************************************************
+ *
+ *  SIMD versions
+ *
+ ************************************************/
+
+#define _LMAT_APPROX_SIMD1( Name, PK ) \
+	LMAT_ENSURE_INLINE \
+	inline PK Name( const PK& a ) { \
+		return internal::Name##_impl(a); }
+
+#ifdef LMAT_HAS_AVX
+#define _LMAT_APPROX_SIMD1_AVX( Name ) \
+	_LMAT_APPROX_SIMD1( Name, avx_f32pk ) \
+	_LMAT_APPROX_SIMD1( Name, avx_f64pk )
+#else
+#define _LMAT_APPROX_SIMD1_AVX( Name )
+#endif
+
+#ifdef LMAT_HAS_AVX512
+#define _LMAT_APPROX_SIMD1_AVX512( Name ) \
+	_LMAT_APPROX_SIMD1( Name, avx512_f32pk ) \
+	_LMAT_APPROX_SIMD1( Name, avx512_f64pk )
+#else
+#define _LMAT_APPROX_SIMD1_AVX512( Name )
+#endif
+
+#define LMAT_DEFINE_APPROX_SIMD1( Name ) \
+	_LMAT_APPROX_SIMD1( Name, sse_f32pk ) \
+	_LMAT_APPROX_SIMD1( Name, sse_f64pk ) \
+	_LMAT_APPROX_SIMD1_AVX( Name ) \
+	_LMAT_APPROX_SIMD1_AVX512( Name )
+
+LMAT_BEGIN_NAMESPACE namespace math {
+
+	LMAT_DEFINE_APPROX_SIMD1( approx_exp )
+	LMAT_DEFINE_APPROX_SIMD1( approx_log )
+	LMAT_DEFINE_APPROX_SIMD1( approx_tanh )
+	LMAT_DEFINE_APPROX_SIMD1( approx_sigmoid )
+
+	// approx_rcp and approx_rsqrt on packs are provided by the arithmetic
+	// modules, as they map to single instructions
+
+} LMAT_END_NAMESPACE
+
+
+/************************************************
+ *
+ *  Declaration of SIMD support
+ *
+ ************************************************/
+
+#ifdef LMAT_HAS_AVX
+#define _LMAT_APPROX_SIMD_SUPPORT_AVX( name ) LMAT_DEFINE_HAS_AVX_SUPPORT( name )
+#else
+#define _LMAT_APPROX_SIMD_SUPPORT_AVX( name )
+#endif
+
+#ifdef LMAT_HAS_AVX512
+#define _LMAT_APPROX_SIMD_SUPPORT_AVX512( name ) LMAT_DEFINE_HAS_AVX512_SUPPORT( name )
+#else
+#define _LMAT_APPROX_SIMD_SUPPORT_AVX512( name )
+#endif
+
+#define _LMAT_DECLARE_APPROX_SIMD_SUPPORT( name ) \
+	LMAT_DEFINE_HAS_SSE_SUPPORT( name ) \
+	_LMAT_APPROX_SIMD_SUPPORT_AVX( name ) \
+	_LMAT_APPROX_SIMD_SUPPORT_AVX512( name )
+
+LMAT_BEGIN_NAMESPACE namespace meta {
+
+	_LMAT_DECLARE_APPROX_SIMD_SUPPORT( approx_exp_ )
+	_LMAT_DECLARE_APPROX_SIMD_SUPPORT( approx_log_ )
+	_LMAT_DECLARE_APPROX_SIMD_SUPPORT( approx_tanh_ )
+	_LMAT_DECLARE_APPROX_SIMD_SUPPORT( approx_sigmoid_ )
+
+	_LMAT_DECLARE_APPROX_SIMD_SUPPORT( approx_rcp_ )
+	_LMAT_DECLARE_APPROX_SIMD_SUPPORT( approx_rsqrt_ )
+
+} LMAT_END_NAMESPACE
+
+#endif
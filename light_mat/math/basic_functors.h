@@ -80,7 +80,7 @@
  *
  ************************************************/
 
-namespace lmat {
+LMAT_BEGIN_NAMESPACE
 
 	// arithmetics
 
@@ -186,7 +186,7 @@ namespace lmat {
 		typedef cond_fun<T> type;
 	};
 
-}
+LMAT_END_NAMESPACE
 
 
 #endif 
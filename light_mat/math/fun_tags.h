@@ -16,7 +16,7 @@
 #include <light_mat/common/prim_types.h>
 #include <light_mat/common/mask_type.h>
 
-namespace lmat { namespace ftags {
+LMAT_BEGIN_NAMESPACE namespace ftags {
 
 	// arithmetic
 
@@ -131,6 +131,18 @@ namespace lmat { namespace ftags {
 	struct tgamma_ { };
 	struct psi_ { };
 
-} }
+	// ******************************
+
+	// approximate math
+
+	struct approx_exp_ { };
+	struct approx_log_ { };
+	struct approx_tanh_ { };
+	struct approx_sigmoid_ { };
+
+	struct approx_rcp_ { };
+	struct approx_rsqrt_ { };
+
+} LMAT_END_NAMESPACE
 
 #endif 
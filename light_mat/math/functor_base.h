@@ -16,7 +16,7 @@
 #include <light_mat/common/basic_defs.h>
 #include <light_mat/simd/simd_base.h>
 
-namespace lmat {
+LMAT_BEGIN_NAMESPACE
 
 	template<typename Fun, typename Kind>
 	struct is_simdizable : public meta::false_ { };
@@ -66,7 +66,7 @@ namespace lmat {
 	{
 		typedef typename std::result_of<typename fun_map<FTag, T...>::type(T...)>::type type;
 	};
-}
+LMAT_END_NAMESPACE
 
 
 /************************************************
@@ -82,7 +82,7 @@ extern "C"
 	inline sse_f64pk Name( const sse_f64pk& a, const sse_f64pk& b ) { \
 		return LMAT_LIBM_SSE_D(Name)(a, b); }
 
-namespace lmat { namespace math {
+LMAT_BEGIN_NAMESPACE namespace math {
 
 	// power functions
 
@@ -137,7 +137,7 @@ namespace lmat { namespace math {
 		return xlogy(a, a);
 	}
 
-} }
+} LMAT_END_NAMESPACE
 
 
 /************************************************
@@ -148,7 +148,7 @@ namespace lmat { namespace math {
 
 #define _LMAT_DECLARE_LIBM_SIMD_SUPPORT( name ) LMAT_DEFINE_HAS_SSE_SUPPORT( name )
 
-namespace lmat { namespace meta {
+LMAT_BEGIN_NAMESPACE namespace meta {
 
 	// power functions
 
@@ -175,7 +175,7 @@ namespace lmat { namespace meta {
 	_LMAT_DECLARE_LIBM_SIMD_SUPPORT( cos_ )
 	_LMAT_DECLARE_LIBM_SIMD_SUPPORT( tan_ )
 
-} }
+} LMAT_END_NAMESPACE
 
 
 
@@ -0,0 +1,278 @@
+/**
+ * @file native_simd_bits.h
+ *
+ * @brief Bit-level helpers for the native SIMD math functions
+ *
+ * All functions here work on the IEEE-754 representation:
+ *
+ *  - pow2i(n):		2^n, for integer-valued n within the normal exponent range
+ *  - ldexp_i(x, n):	x * 2^n, for integer-valued n, |n| < 2 * (exponent bias)
+ *  - frexp_i(x, e):	returns m in [1, 2) and sets e, such that x = m * 2^e,
+ *  					for positive normal x
+ *  - widen / narrow:	conversion between a f32 pack and two f64 packs
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_NATIVE_SIMD_BITS_H_
+#define LIGHTMAT_NATIVE_SIMD_BITS_H_
+
+#include <light_mat/simd/simd.h>
+
+LMAT_BEGIN_NAMESPACE namespace math { namespace internal {
+
+	/********************************************
+	 *
+	 *  SSE
+	 *
+	 ********************************************/
+
+	// The integer part of (n + 2^23 + bias) (resp. 2^52 + bias) sits
+	// right at the bottom of the mantissa bits, which are then shifted
+	// into the exponent field. The reverse trick is used by frexp_i.
+
+	LMAT_ENSURE_INLINE
+	inline sse_f32pk pow2i(const sse_f32pk& n)
+	{
+		__m128 t = _mm_add_ps(n, _mm_set1_ps(8388608.0f + 127.0f));
+		return _mm_castsi128_ps(_mm_slli_epi32(_mm_castps_si128(t), 23));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline sse_f64pk pow2i(const sse_f64pk& n)
+	{
+		__m128d t = _mm_add_pd(n, _mm_set1_pd(4503599627370496.0 + 1023.0));
+		return _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(t), 52));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline sse_f32pk frexp_i(const sse_f32pk& x, sse_f32pk& e)
+	{
+		__m128i u = _mm_srli_epi32(_mm_castps_si128(x), 23);
+		e = _mm_sub_ps(
+				_mm_castsi128_ps(_mm_or_si128(u, _mm_set1_epi32(0x4b000000))),
+				_mm_set1_ps(8388608.0f + 127.0f));
+
+		return _mm_or_ps(
+				_mm_and_ps(x, _mm_castsi128_ps(_mm_set1_epi32(0x007fffff))),
+				_mm_set1_ps(1.0f));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline sse_f64pk frexp_i(const sse_f64pk& x, sse_f64pk& e)
+	{
+		__m128i u = _mm_srli_epi64(_mm_castpd_si128(x), 52);
+		e = _mm_sub_pd(
+				_mm_castsi128_pd(_mm_or_si128(u, _mm_set1_epi64x(0x4330000000000000LL))),
+				_mm_set1_pd(4503599627370496.0 + 1023.0));
+
+		return _mm_or_pd(
+				_mm_and_pd(x, _mm_castsi128_pd(_mm_set1_epi64x(0x000fffffffffffffLL))),
+				_mm_set1_pd(1.0));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline void widen(const sse_f32pk& x, sse_f64pk& lo, sse_f64pk& hi)
+	{
+		lo = _mm_cvtps_pd(x);
+		hi = _mm_cvtps_pd(_mm_movehl_ps(x, x));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline sse_f32pk narrow(const sse_f64pk& lo, const sse_f64pk& hi)
+	{
+		return _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi));
+	}
+
+
+	/********************************************
+	 *
+	 *  AVX
+	 *
+	 ********************************************/
+
+#ifdef LMAT_HAS_AVX
+
+#ifdef LMAT_HAS_AVX2
+
+	LMAT_ENSURE_INLINE
+	inline __m256i avx_slli_32(const __m256i& a, int c) { return _mm256_slli_epi32(a, c); }
+
+	LMAT_ENSURE_INLINE
+	inline __m256i avx_slli_64(const __m256i& a, int c) { return _mm256_slli_epi64(a, c); }
+
+	LMAT_ENSURE_INLINE
+	inline __m256i avx_srli_32(const __m256i& a, int c) { return _mm256_srli_epi32(a, c); }
+
+	LMAT_ENSURE_INLINE
+	inline __m256i avx_srli_64(const __m256i& a, int c) { return _mm256_srli_epi64(a, c); }
+
+#else
+
+	// AVX has no 256-bit integer shifts: work on the halves
+
+#define LMAT_NATIVE_AVX_SHIFT_BY_HALVES( name, op ) \
+	LMAT_ENSURE_INLINE \
+	inline __m256i name(const __m256i& a, int c) { \
+		__m128i lo = op(_mm256_castsi256_si128(a), c); \
+		__m128i hi = op(_mm256_extractf128_si256(a, 1), c); \
+		return _mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1); }
+
+	LMAT_NATIVE_AVX_SHIFT_BY_HALVES( avx_slli_32, _mm_slli_epi32 )
+	LMAT_NATIVE_AVX_SHIFT_BY_HALVES( avx_slli_64, _mm_slli_epi64 )
+	LMAT_NATIVE_AVX_SHIFT_BY_HALVES( avx_srli_32, _mm_srli_epi32 )
+	LMAT_NATIVE_AVX_SHIFT_BY_HALVES( avx_srli_64, _mm_srli_epi64 )
+
+#undef LMAT_NATIVE_AVX_SHIFT_BY_HALVES
+
+#endif
+
+	LMAT_ENSURE_INLINE
+	inline avx_f32pk pow2i(const avx_f32pk& n)
+	{
+		__m256 t = _mm256_add_ps(n, _mm256_set1_ps(8388608.0f + 127.0f));
+		return _mm256_castsi256_ps(avx_slli_32(_mm256_castps_si256(t), 23));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx_f64pk pow2i(const avx_f64pk& n)
+	{
+		__m256d t = _mm256_add_pd(n, _mm256_set1_pd(4503599627370496.0 + 1023.0));
+		return _mm256_castsi256_pd(avx_slli_64(_mm256_castpd_si256(t), 52));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx_f32pk frexp_i(const avx_f32pk& x, avx_f32pk& e)
+	{
+		__m256 u = _mm256_castsi256_ps(avx_srli_32(_mm256_castps_si256(x), 23));
+		e = _mm256_sub_ps(
+				_mm256_or_ps(u, _mm256_castsi256_ps(_mm256_set1_epi32(0x4b000000))),
+				_mm256_set1_ps(8388608.0f + 127.0f));
+
+		return _mm256_or_ps(
+				_mm256_and_ps(x, _mm256_castsi256_ps(_mm256_set1_epi32(0x007fffff))),
+				_mm256_set1_ps(1.0f));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx_f64pk frexp_i(const avx_f64pk& x, avx_f64pk& e)
+	{
+		__m256d u = _mm256_castsi256_pd(avx_srli_64(_mm256_castpd_si256(x), 52));
+		e = _mm256_sub_pd(
+				_mm256_or_pd(u, _mm256_castsi256_pd(_mm256_set1_epi64x(0x4330000000000000LL))),
+				_mm256_set1_pd(4503599627370496.0 + 1023.0));
+
+		return _mm256_or_pd(
+				_mm256_and_pd(x, _mm256_castsi256_pd(_mm256_set1_epi64x(0x000fffffffffffffLL))),
+				_mm256_set1_pd(1.0));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline void widen(const avx_f32pk& x, avx_f64pk& lo, avx_f64pk& hi)
+	{
+		lo = _mm256_cvtps_pd(_mm256_castps256_ps128(x));
+		hi = _mm256_cvtps_pd(_mm256_extractf128_ps(x, 1));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx_f32pk narrow(const avx_f64pk& lo, const avx_f64pk& hi)
+	{
+		return lmat::internal::combine_m128(_mm256_cvtpd_ps(lo), _mm256_cvtpd_ps(hi));
+	}
+
+#endif
+
+
+	/********************************************
+	 *
+	 *  AVX-512
+	 *
+	 ********************************************/
+
+#ifdef LMAT_HAS_AVX512
+
+	// AVX512F has native instructions for both directions,
+	// which also take care of overflow, underflow and denormals
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk pow2i(const avx512_f32pk& n)
+	{
+		return _mm512_scalef_ps(_mm512_set1_ps(1.0f), n);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk pow2i(const avx512_f64pk& n)
+	{
+		return _mm512_scalef_pd(_mm512_set1_pd(1.0), n);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk ldexp_i(const avx512_f32pk& x, const avx512_f32pk& n)
+	{
+		return _mm512_scalef_ps(x, n);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk ldexp_i(const avx512_f64pk& x, const avx512_f64pk& n)
+	{
+		return _mm512_scalef_pd(x, n);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk frexp_i(const avx512_f32pk& x, avx512_f32pk& e)
+	{
+		e = _mm512_getexp_ps(x);
+		return _mm512_getmant_ps(x, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_src);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk frexp_i(const avx512_f64pk& x, avx512_f64pk& e)
+	{
+		e = _mm512_getexp_pd(x);
+		return _mm512_getmant_pd(x, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_src);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline void widen(const avx512_f32pk& x, avx512_f64pk& lo, avx512_f64pk& hi)
+	{
+		lo = _mm512_cvtps_pd(lmat::internal::avx512_low_ps(x));
+		hi = _mm512_cvtps_pd(lmat::internal::avx512_high_ps(x));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk narrow(const avx512_f64pk& lo, const avx512_f64pk& hi)
+	{
+		__m512d l = _mm512_castps_pd(_mm512_castps256_ps512(_mm512_cvtpd_ps(lo)));
+		return _mm512_castpd_ps(
+				_mm512_insertf64x4(l, _mm256_castps_pd(_mm512_cvtpd_ps(hi)), 1));
+	}
+
+#endif
+
+
+	/********************************************
+	 *
+	 *  generic ldexp
+	 *
+	 ********************************************/
+
+	// split the exponent into two halves, such that
+	// each power of two is a normal number
+
+	template<typename T, typename Kind>
+	LMAT_ENSURE_INLINE
+	inline simd_pack<T, Kind> ldexp_i(const simd_pack<T, Kind>& x, const simd_pack<T, Kind>& n)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+
+		pack_t n1 = floor(n * pack_t(T(0.5)));
+		return (x * pow2i(n1)) * pow2i(n - n1);
+	}
+
+} } LMAT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,951 @@
+/**
+ * @file native_simd_math.h
+ *
+ * @brief Built-in SIMD implementation of elementary functions
+ *
+ * This is used when neither Intel SVML nor AMD LibM is available.
+ * All functions are written once over generic packs, using range
+ * reduction followed by a polynomial (or rational) approximation.
+ *
+ * Maximum errors measured against the C library with random inputs over
+ * the tested domains, in ulps (f32 / f64):
+ *
+ *  exp, exp2		1 / 1		log, log1p		1 / 1
+ *  expm1			1 / 2		log2, log10		2 / 2
+ *  sin, cos		2 / 2		tan				3 / 3
+ *  atan			3 / 1		tanh			2 / 3
+ *  sinh, cosh		3 / 3		pow				1 / 4
+ *
+ * For f64 pow, the error is within 1 ulp for |y| <= 10, and grows
+ * slowly with |y| (4 ulps at |y| ~ 200). The f32 pow is evaluated in
+ * double precision, and is almost always correctly rounded.
+ *
+ * Results in the subnormal range may lose precision.
+ *
+ * The trigonometric functions perform their own (Cody-Waite) range
+ * reduction for |x| <= 8192 (f32) and |x| <= 10^5 (f64). Packs with
+ * larger entries are handed to the scalar functions.
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_NATIVE_SIMD_MATH_H_
+#define LIGHTMAT_NATIVE_SIMD_MATH_H_
+
+#include "native_simd_bits.h"
+
+LMAT_BEGIN_NAMESPACE namespace math { namespace internal {
+
+	/********************************************
+	 *
+	 *  constants
+	 *
+	 ********************************************/
+
+	template<typename T> struct native_math_consts;
+
+	template<> struct native_math_consts<float>
+	{
+		// exp
+
+		LMAT_ENSURE_INLINE static float log2e()  { return 1.44269504088896341f; }
+		LMAT_ENSURE_INLINE static float ln2_hi() { return 0.693359375f; }
+		LMAT_ENSURE_INLINE static float ln2_lo() { return -2.12194440e-4f; }
+
+		LMAT_ENSURE_INLINE static float exp_max()   { return 88.7228394f; }
+		LMAT_ENSURE_INLINE static float exp_min()   { return -103.972084f; }
+		LMAT_ENSURE_INLINE static float exp2_max()  { return 128.0f; }
+		LMAT_ENSURE_INLINE static float exp2_min()  { return -150.0f; }
+		LMAT_ENSURE_INLINE static float expm1_min() { return -18.0f; }
+		LMAT_ENSURE_INLINE static float expm1_big() { return 25.0f; }	// 2^n - 1 is no longer exact beyond
+		LMAT_ENSURE_INLINE static float hyp_big()   { return 80.0f; }	// exp(x) overflows soon beyond
+
+		// log
+
+		LMAT_ENSURE_INLINE static float log_ln2_hi()  { return 6.9313812256e-01f; }
+		LMAT_ENSURE_INLINE static float log_ln2_lo()  { return 9.0580006145e-06f; }
+		LMAT_ENSURE_INLINE static float sqrt2()       { return 1.41421356237f; }
+		LMAT_ENSURE_INLINE static float log10e()      { return 0.434294481903f; }
+		LMAT_ENSURE_INLINE static float min_normal()  { return 1.17549435e-38f; }
+		LMAT_ENSURE_INLINE static float denorm_scale(){ return 33554432.0f; }	// 2^25
+		LMAT_ENSURE_INLINE static float denorm_exp()  { return 25.0f; }
+
+		// trigonometry
+
+		LMAT_ENSURE_INLINE static float two_rcp_pi() { return 0.636619772368f; }
+		LMAT_ENSURE_INLINE static float pio2_1()     { return 1.5703125f; }
+		LMAT_ENSURE_INLINE static float pio2_2()     { return 4.837512969970703125e-4f; }
+		LMAT_ENSURE_INLINE static float pio2_3()     { return 7.549533620476723e-08f; }
+		LMAT_ENSURE_INLINE static float pio2_4()     { return 2.5633440682570896e-12f; }
+		LMAT_ENSURE_INLINE static float trig_max()   { return 8192.0f; }
+
+		LMAT_ENSURE_INLINE static float atan_hi()    { return 2.414213562373095f; }	// tan(3 pi / 8)
+		LMAT_ENSURE_INLINE static float atan_mid()   { return 0.4142135623730950f; }	// tan(pi / 8)
+		LMAT_ENSURE_INLINE static float half_pi()    { return 1.57079632679f; }
+		LMAT_ENSURE_INLINE static float quar_pi()    { return 0.785398163397f; }
+		LMAT_ENSURE_INLINE static float morebits()   { return 0.0f; }
+	};
+
+	template<> struct native_math_consts<double>
+	{
+		// exp
+
+		LMAT_ENSURE_INLINE static double log2e()  { return 1.4426950408889634074; }
+		LMAT_ENSURE_INLINE static double ln2_hi() { return 6.93147180369123816490e-01; }
+		LMAT_ENSURE_INLINE static double ln2_lo() { return 1.90821492927058770002e-10; }
+
+		LMAT_ENSURE_INLINE static double exp_max()   { return 709.782712893383973; }
+		LMAT_ENSURE_INLINE static double exp_min()   { return -745.133219101941217; }
+		LMAT_ENSURE_INLINE static double exp2_max()  { return 1024.0; }
+		LMAT_ENSURE_INLINE static double exp2_min()  { return -1075.0; }
+		LMAT_ENSURE_INLINE static double expm1_min() { return -40.0; }
+		LMAT_ENSURE_INLINE static double expm1_big() { return 54.0; }
+		LMAT_ENSURE_INLINE static double hyp_big()   { return 700.0; }
+
+		// log
+
+		LMAT_ENSURE_INLINE static double log_ln2_hi()  { return 6.93147180369123816490e-01; }
+		LMAT_ENSURE_INLINE static double log_ln2_lo()  { return 1.90821492927058770002e-10; }
+		LMAT_ENSURE_INLINE static double sqrt2()       { return 1.41421356237309504880; }
+		LMAT_ENSURE_INLINE static double log10e()      { return 0.43429448190325182765; }
+		LMAT_ENSURE_INLINE static double min_normal()  { return 2.2250738585072014e-308; }
+		LMAT_ENSURE_INLINE static double denorm_scale(){ return 18014398509481984.0; }	// 2^54
+		LMAT_ENSURE_INLINE static double denorm_exp()  { return 54.0; }
+
+		// trigonometry
+
+		LMAT_ENSURE_INLINE static double two_rcp_pi() { return 6.36619772367581382433e-01; }
+		LMAT_ENSURE_INLINE static double pio2_1()     { return 1.57079632673412561417e+00; }
+		LMAT_ENSURE_INLINE static double pio2_2()     { return 6.07710050630396597660e-11; }
+		LMAT_ENSURE_INLINE static double pio2_3()     { return 2.02226624879595063154e-21; }
+		LMAT_ENSURE_INLINE static double pio2_4()     { return 8.47842766036889956997e-32; }
+		LMAT_ENSURE_INLINE static double trig_max()   { return 1.0e5; }
+
+		LMAT_ENSURE_INLINE static double atan_hi()    { return 2.41421356237309504880; }
+		LMAT_ENSURE_INLINE static double atan_mid()   { return 0.66; }
+		LMAT_ENSURE_INLINE static double half_pi()    { return 1.57079632679489661923; }
+		LMAT_ENSURE_INLINE static double quar_pi()    { return 7.85398163397448309616e-1; }
+		LMAT_ENSURE_INLINE static double morebits()   { return 6.123233995736765886130e-17; }
+	};
+
+
+	/********************************************
+	 *
+	 *  polynomial kernels
+	 *
+	 ********************************************/
+
+	template<typename T> struct native_math_poly;
+
+	template<> struct native_math_poly<float>
+	{
+		// expm1(r) for |r| <= ln(2) / 2 (Taylor series)
+
+		template<class P>
+		LMAT_ENSURE_INLINE static P expm1_r(const P& r)
+		{
+			P p = horner<P>(r,
+					2.48015873015873e-5f, 1.98412698412698e-4f, 1.38888888888889e-3f,
+					8.33333333333333e-3f, 4.16666666666667e-2f, 1.66666666666667e-1f,
+					0.5f);
+			return fma(r * r, p, r);
+		}
+
+		// log(1 + f) = 2s + s * R(s^2), with s = f / (2 + f)
+
+		template<class P>
+		LMAT_ENSURE_INLINE static P log_R(const P& z)
+		{
+			return z * horner<P>(z,
+					0.24279078841f, 0.28498786688f, 0.40000972152f, 0.66666662693f);
+		}
+
+		// sin(r) and cos(r) for |r| <= pi / 4, with z = r^2
+
+		template<class P>
+		LMAT_ENSURE_INLINE static P sin_r(const P& r, const P& z)
+		{
+			return fma(r * z, horner<P>(z,
+					-1.9515295891e-4f, 8.3321608736e-3f, -1.6666654611e-1f), r);
+		}
+
+		template<class P>
+		LMAT_ENSURE_INLINE static P cos_c(const P& z)
+		{
+			return horner<P>(z,
+					2.443315711809948e-5f, -1.388731625493765e-3f, 4.166664568298827e-2f);
+		}
+
+		// atan(x) for |x| <= tan(pi / 8), with z = x^2
+
+		template<class P>
+		LMAT_ENSURE_INLINE static P atan_r(const P& x, const P& z)
+		{
+			return fma(x * z, horner<P>(z,
+					8.05374449538e-2f, -1.38776856032e-1f, 1.99777106478e-1f, -3.33329491539e-1f), x);
+		}
+	};
+
+	template<> struct native_math_poly<double>
+	{
+		template<class P>
+		LMAT_ENSURE_INLINE static P expm1_r(const P& r)
+		{
+			P p = horner<P>(r,
+					1.1470745597729725e-11, 1.6059043836821613e-10, 2.08767569878681e-9,
+					2.505210838544172e-8,   2.755731922398589e-7,   2.755731922398589e-6,
+					2.48015873015873e-5,    1.984126984126984e-4,   1.388888888888889e-3,
+					8.333333333333333e-3,   4.1666666666666664e-2,  1.6666666666666666e-1,
+					0.5);
+			return fma(r * r, p, r);
+		}
+
+		template<class P>
+		LMAT_ENSURE_INLINE static P log_R(const P& z)
+		{
+			return z * horner<P>(z,
+					1.479819860511658591e-01, 1.531383769920937332e-01, 1.818357216161805012e-01,
+					2.222219843214978396e-01, 2.857142874366239149e-01, 3.999999999940941908e-01,
+					6.666666666666735130e-01);
+		}
+
+		template<class P>
+		LMAT_ENSURE_INLINE static P sin_r(const P& r, const P& z)
+		{
+			return fma(r * z, horner<P>(z,
+					1.58969099521155010221e-10, -2.50507602534068634195e-08,
+					2.75573137070700676789e-06, -1.98412698298579493134e-04,
+					8.33333333332248946124e-03, -1.66666666666666324348e-01), r);
+		}
+
+		template<class P>
+		LMAT_ENSURE_INLINE static P cos_c(const P& z)
+		{
+			return horner<P>(z,
+					-1.13596475577881948265e-11, 2.08757232129817482790e-09,
+					-2.75573143513906633035e-07, 2.48015872894767294178e-05,
+					-1.38888888888741095749e-03, 4.16666666666666019037e-02);
+		}
+
+		template<class P>
+		LMAT_ENSURE_INLINE static P atan_r(const P& x, const P& z)
+		{
+			P p = horner<P>(z,
+					-8.750608600031904122785e-1, -1.615753718733365076637e1,
+					-7.500855792314704667340e1,  -1.228866684490136173410e2,
+					-6.485021904942025371773e1);
+			P q = horner<P>(z, 1.0,
+					2.485846490142306297962e1, 1.650270098316988542046e2,
+					4.328810604912902668951e2, 4.853903996359136964868e2,
+					1.945506571482613964425e2);
+			return fma(x * z, p / q, x);
+		}
+	};
+
+
+	/********************************************
+	 *
+	 *  exp family
+	 *
+	 ********************************************/
+
+	template<typename T, typename Kind>
+	inline simd_pack<T, Kind> exp_impl(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+		typedef native_math_consts<T> C;
+
+		pack_t n = round(x * pack_t(C::log2e()));
+		pack_t r = (x - n * pack_t(C::ln2_hi())) - n * pack_t(C::ln2_lo());
+		pack_t y = ldexp_i(pack_t(T(1)) + native_math_poly<T>::expm1_r(r), n);
+
+		y = cond(x > pack_t(C::exp_max()), pack_t::inf(), y);
+		return cond(x < pack_t(C::exp_min()), pack_t::zeros(), y);
+	}
+
+	template<typename T, typename Kind>
+	inline simd_pack<T, Kind> exp2_impl(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+		typedef native_math_consts<T> C;
+
+		pack_t n = round(x);
+		pack_t r = (x - n) * pack_t(C::ln2_hi() + C::ln2_lo());
+		pack_t y = ldexp_i(pack_t(T(1)) + native_math_poly<T>::expm1_r(r), n);
+
+		y = cond(x >= pack_t(C::exp2_max()), pack_t::inf(), y);
+		return cond(x < pack_t(C::exp2_min()), pack_t::zeros(), y);
+	}
+
+	template<typename T, typename Kind>
+	inline simd_pack<T, Kind> expm1_impl(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+		typedef native_math_consts<T> C;
+
+		pack_t one(T(1));
+		pack_t n = round(x * pack_t(C::log2e()));
+		pack_t r = (x - n * pack_t(C::ln2_hi())) - n * pack_t(C::ln2_lo());
+		pack_t p = native_math_poly<T>::expm1_r(r);
+
+		// expm1(x) = 2^n * p + (2^n - 1), where 2^n - 1 is exact for small n
+
+		pack_t s = pow2i(cond(n > pack_t(C::expm1_big()), pack_t::zeros(), n));
+		pack_t y = fma(s, p, s - one);
+		y = cond(n > pack_t(C::expm1_big()), ldexp_i(one + p, n), y);
+
+		y = cond(x > pack_t(C::exp_max()), pack_t::inf(), y);
+		y = cond(x < pack_t(C::expm1_min()), -one, y);
+		return cond(x == pack_t::zeros(), x, y);  // preserves the sign of zero
+	}
+
+
+	/********************************************
+	 *
+	 *  log family
+	 *
+	 ********************************************/
+
+	// x = (1 + f) * 2^e, with sqrt(2)/2 < 1 + f <= sqrt(2), for positive finite x
+
+	template<typename T, typename Kind>
+	LMAT_ENSURE_INLINE
+	inline void log_reduce(const simd_pack<T, Kind>& x, simd_pack<T, Kind>& f, simd_pack<T, Kind>& e)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+		typedef native_math_consts<T> C;
+
+		pack_t z = pack_t::zeros();
+
+		simd_bpack<T, Kind> tiny = x < pack_t(C::min_normal());
+		pack_t m = frexp_i(cond(tiny, x * pack_t(C::denorm_scale()), x), e);
+		e = e - cond(tiny, pack_t(C::denorm_exp()), z);
+
+		simd_bpack<T, Kind> big = m > pack_t(C::sqrt2());
+		m = cond(big, m * pack_t(T(0.5)), m);
+		e = e + cond(big, pack_t(T(1)), z);
+
+		f = m - pack_t(T(1));
+	}
+
+	// log(1 + f) - f, for f given by log_reduce
+
+	template<typename T, typename Kind>
+	LMAT_ENSURE_INLINE
+	inline simd_pack<T, Kind> log1p_f_minus_f(const simd_pack<T, Kind>& f)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+
+		pack_t s = f / (pack_t(T(2)) + f);
+		pack_t hfsq = pack_t(T(0.5)) * f * f;
+		pack_t R = native_math_poly<T>::log_R(s * s);
+
+		return s * (hfsq + R) - hfsq;
+	}
+
+	template<typename T, typename Kind>
+	LMAT_ENSURE_INLINE
+	inline simd_pack<T, Kind> log_special(const simd_pack<T, Kind>& x, const simd_pack<T, Kind>& y)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+
+		pack_t r = cond(x == pack_t::inf(), x, y);
+		r = cond(x == pack_t::zeros(), pack_t::neg_inf(), r);
+		return cond(x >= pack_t::zeros(), r, pack_t::nan());  // negative or NaN
+	}
+
+	template<typename T, typename Kind>
+	inline simd_pack<T, Kind> log_impl(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+		typedef native_math_consts<T> C;
+
+		pack_t f, e;
+		log_reduce(x, f, e);
+
+		pack_t y = fma(e, pack_t(C::log_ln2_hi()),
+				f + fma(e, pack_t(C::log_ln2_lo()), log1p_f_minus_f(f)));
+
+		return log_special(x, y);
+	}
+
+	template<typename T, typename Kind>
+	inline simd_pack<T, Kind> log2_impl(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+		typedef native_math_consts<T> C;
+
+		pack_t f, e;
+		log_reduce(x, f, e);
+
+		pack_t y = fma(f + log1p_f_minus_f(f), pack_t(C::log2e()), e);
+		return log_special(x, y);
+	}
+
+	template<typename T, typename Kind>
+	inline simd_pack<T, Kind> log10_impl(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+		return log_impl(x) * pack_t(native_math_consts<T>::log10e());
+	}
+
+	template<typename T, typename Kind>
+	inline simd_pack<T, Kind> log1p_impl(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+
+		// log(1 + x) = log(u) - c / u, where c = (u - 1) - x is the rounding error of u
+
+		pack_t one(T(1));
+		pack_t u = one + x;
+		pack_t c = (u - one) - x;
+		pack_t y = log_impl(u) - c / u;
+
+		y = cond(x == pack_t::inf(), x, y);
+		y = cond(u == pack_t::zeros(), pack_t::neg_inf(), y);
+		return cond(x == pack_t::zeros(), x, y);
+	}
+
+
+	/********************************************
+	 *
+	 *  pow
+	 *
+	 ********************************************/
+
+	// error-free transforms (double-double arithmetic),
+	// the outputs may alias the inputs
+
+	template<typename T, typename Kind>
+	LMAT_ENSURE_INLINE
+	inline void fast_two_sum(const simd_pack<T, Kind>& a, const simd_pack<T, Kind>& b,
+			simd_pack<T, Kind>& s, simd_pack<T, Kind>& e)  // requires |a| >= |b|
+	{
+		simd_pack<T, Kind> s_ = a + b;
+		e = b - (s_ - a);
+		s = s_;
+	}
+
+	template<typename T, typename Kind>
+	LMAT_ENSURE_INLINE
+	inline void two_sum(const simd_pack<T, Kind>& a, const simd_pack<T, Kind>& b,
+			simd_pack<T, Kind>& s, simd_pack<T, Kind>& e)
+	{
+		simd_pack<T, Kind> s_ = a + b;
+		simd_pack<T, Kind> bb = s_ - a;
+		e = (a - (s_ - bb)) + (b - bb);
+		s = s_;
+	}
+
+	template<typename T, typename Kind>
+	LMAT_ENSURE_INLINE
+	inline void two_prod(const simd_pack<T, Kind>& a, const simd_pack<T, Kind>& b,
+			simd_pack<T, Kind>& p, simd_pack<T, Kind>& e)
+	{
+		p = a * b;
+#ifdef LMAT_HAS_FMA
+		e = fma(a, b, -p);
+#else
+		typedef simd_pack<T, Kind> pack_t;
+		const pack_t sp(T(134217729.0));  // Veltkamp splitting, 2^27 + 1
+
+		pack_t ca = sp * a;
+		pack_t ah = ca - (ca - a);
+		pack_t al = a - ah;
+		pack_t cb = sp * b;
+		pack_t bh = cb - (cb - b);
+		pack_t bl = b - bh;
+
+		e = ((ah * bh - p) + ah * bl + al * bh) + al * bl;
+#endif
+	}
+
+	// |x|^y for float: evaluated in double precision
+
+	template<typename Kind>
+	inline simd_pack<float, Kind> pow_abs(const simd_pack<float, Kind>& ax, const simd_pack<float, Kind>& y)
+	{
+		simd_pack<double, Kind> ax_lo, ax_hi, y_lo, y_hi;
+		widen(ax, ax_lo, ax_hi);
+		widen(y, y_lo, y_hi);
+
+		return narrow(
+				exp_impl(y_lo * log_impl(ax_lo)),
+				exp_impl(y_hi * log_impl(ax_hi)));
+	}
+
+	// log(ax) = lx_hi + lx_lo, for positive finite ax
+
+	template<typename Kind>
+	LMAT_ENSURE_INLINE
+	inline void log_dd(const simd_pack<double, Kind>& ax,
+			simd_pack<double, Kind>& lx_hi, simd_pack<double, Kind>& lx_lo)
+	{
+		typedef simd_pack<double, Kind> pack_t;
+		typedef native_math_consts<double> C;
+
+		pack_t f, e;
+		log_reduce(ax, f, e);
+
+		pack_t two(2.0);
+		pack_t d = two + f;
+		pack_t d_lo = f - (d - two);
+		pack_t s = f / d;
+
+		pack_t p, pe;
+		two_prod(s, d, p, pe);
+		pack_t s_lo = (((f - p) - pe) - s * d_lo) / d;
+
+		pack_t lm_hi, lm_lo;
+		fast_two_sum(two * s, two * s_lo + s * native_math_poly<double>::log_R(s * s), lm_hi, lm_lo);
+
+		pack_t t;
+		two_sum(e * pack_t(C::ln2_hi()), lm_hi, lx_hi, t);
+		fast_two_sum(lx_hi, t + fma(e, pack_t(C::ln2_lo()), lm_lo), lx_hi, lx_lo);
+	}
+
+	// exp(t_hi + t_lo), with |t_lo| <= ulp(t_hi)
+
+	template<typename Kind>
+	LMAT_ENSURE_INLINE
+	inline simd_pack<double, Kind> exp_dd(const simd_pack<double, Kind>& t_hi, const simd_pack<double, Kind>& t_lo)
+	{
+		typedef simd_pack<double, Kind> pack_t;
+		typedef native_math_consts<double> C;
+
+		pack_t n = round(t_hi * pack_t(C::log2e()));
+		pack_t r = ((t_hi - n * pack_t(C::ln2_hi())) - n * pack_t(C::ln2_lo())) + t_lo;
+		pack_t v = ldexp_i(pack_t(1.0) + native_math_poly<double>::expm1_r(r), n);
+
+		v = cond(t_hi > pack_t(C::exp_max()), pack_t::inf(), v);
+		return cond(t_hi < pack_t(C::exp_min()), pack_t::zeros(), v);
+	}
+
+	// |x|^y for double: exp(y * log(x)), with the product carried in double-double
+
+	template<typename Kind>
+	inline simd_pack<double, Kind> pow_abs(const simd_pack<double, Kind>& ax, const simd_pack<double, Kind>& y_)
+	{
+		typedef simd_pack<double, Kind> pack_t;
+
+		pack_t lx_hi, lx_lo;
+		log_dd(ax, lx_hi, lx_lo);
+
+		// y * log(ax) = t_hi + t_lo  (|y| is capped, beyond which the result saturates anyway)
+
+		const pack_t ycap(8.45271249817953e270);  // 2^900
+		pack_t y = (min)((max)(y_, -ycap), ycap);
+
+		pack_t t_hi, t_lo, t;
+		two_prod(y, lx_hi, t_hi, t);
+		fast_two_sum(t_hi, fma(y, lx_lo, t), t_hi, t_lo);
+
+		pack_t v = exp_dd(t_hi, t_lo);
+
+		// zeros, infinities and NaNs (which the log reduction does not handle)
+
+		v = cond(ax == pack_t::zeros(), cond(y < pack_t::zeros(), pack_t::inf(), pack_t::zeros()), v);
+		v = cond(ax == pack_t::inf(), cond(y < pack_t::zeros(), pack_t::zeros(), pack_t::inf()), v);
+		return cond((ax == ax) & (y_ == y_), v, pack_t::nan());
+	}
+
+	template<typename T, typename Kind>
+	inline simd_pack<T, Kind> pow_impl(const simd_pack<T, Kind>& x, const simd_pack<T, Kind>& y)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+		typedef simd_bpack<T, Kind> bpack_t;
+
+		pack_t ax = abs(x);
+		pack_t r = pow_abs(ax, y);
+
+		// negative base: defined for integer exponents only
+
+		pack_t hy = y * pack_t(T(0.5));
+		bpack_t y_int = floor(y) == y;
+		bpack_t y_odd = y_int & (floor(hy) != hy);
+
+		r = cond(signbit(x) & y_odd, -r, r);
+		r = cond((x < pack_t::zeros()) & (ax != pack_t::inf()) & ~y_int, pack_t::nan(), r);
+
+		pack_t one(T(1));
+		bpack_t r_one = (y == pack_t::zeros()) | (x == one) | ((ax == one) & (abs(y) == pack_t::inf()));
+		return cond(r_one, one, r);
+	}
+
+
+	/********************************************
+	 *
+	 *  trigonometry
+	 *
+	 ********************************************/
+
+	// x = q * (pi/2) + r, with |r| <= pi/4, and returns q mod 4
+	//
+	// pi/2 is split into four parts, the leading three of which have
+	// few enough bits for q * pio2_k to be exact within the valid range
+
+	template<typename T, typename Kind>
+	LMAT_ENSURE_INLINE
+	inline simd_pack<T, Kind> trig_reduce(const simd_pack<T, Kind>& x, simd_pack<T, Kind>& r)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+		typedef native_math_consts<T> C;
+
+		pack_t q = round(x * pack_t(C::two_rcp_pi()));
+		r = x - q * pack_t(C::pio2_1());
+		r = r - q * pack_t(C::pio2_2());
+		r = r - q * pack_t(C::pio2_3());
+		r = r - q * pack_t(C::pio2_4());
+
+		return q - pack_t(T(4)) * floor(q * pack_t(T(0.25)));
+	}
+
+	// hands the entries that are too large for trig_reduce to the scalar function
+
+	template<typename T, typename Kind>
+	inline simd_pack<T, Kind> trig_fallback(const simd_pack<T, Kind>& x, const simd_pack<T, Kind>& y, T (*sfun)(T))
+	{
+		typedef simd_pack<T, Kind> pack_t;
+		const unsigned int W = pack_t::pack_width;
+
+		if (any_true(abs(x) > pack_t(native_math_consts<T>::trig_max())))
+		{
+			T xs[W];
+			T ys[W];
+			x.store_u(xs);
+			y.store_u(ys);
+
+			for (unsigned int i = 0; i < W; ++i)
+			{
+				if (!(std::abs(xs[i]) <= native_math_consts<T>::trig_max()) && xs[i] == xs[i])
+					ys[i] = sfun(xs[i]);
+			}
+			return pack_t(ys);
+		}
+		else return y;
+	}
+
+	template<typename T, typename Kind>
+	LMAT_ENSURE_INLINE
+	inline simd_pack<T, Kind> cos_r(const simd_pack<T, Kind>& z)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+
+		pack_t one(T(1));
+		pack_t hz = pack_t(T(0.5)) * z;
+		pack_t w = one - hz;
+		return w + (((one - w) - hz) + z * z * native_math_poly<T>::cos_c(z));
+	}
+
+	template<typename T, typename Kind>
+	inline simd_pack<T, Kind> sin_impl(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+		typedef simd_bpack<T, Kind> bpack_t;
+
+		pack_t r;
+		pack_t q = trig_reduce(x, r);
+		pack_t z = r * r;
+
+		bpack_t odd = (q == pack_t(T(1))) | (q == pack_t(T(3)));
+		pack_t y = cond(odd, cos_r(z), native_math_poly<T>::sin_r(r, z));
+		y = cond(q >= pack_t(T(2)), -y, y);
+		y = cond(x == pack_t::zeros(), x, y);
+
+		return trig_fallback(x, y, static_cast<T(*)(T)>(std::sin));
+	}
+
+	template<typename T, typename Kind>
+	inline simd_pack<T, Kind> cos_impl(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+		typedef simd_bpack<T, Kind> bpack_t;
+
+		pack_t r;
+		pack_t q = trig_reduce(x, r);
+		pack_t z = r * r;
+
+		bpack_t odd = (q == pack_t(T(1))) | (q == pack_t(T(3)));
+		pack_t y = cond(odd, native_math_poly<T>::sin_r(r, z), cos_r(z));
+		y = cond((q == pack_t(T(1))) | (q == pack_t(T(2))), -y, y);
+
+		return trig_fallback(x, y, static_cast<T(*)(T)>(std::cos));
+	}
+
+	template<typename T, typename Kind>
+	inline simd_pack<T, Kind> tan_impl(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+		typedef simd_bpack<T, Kind> bpack_t;
+
+		pack_t r;
+		pack_t q = trig_reduce(x, r);
+		pack_t z = r * r;
+		pack_t s = native_math_poly<T>::sin_r(r, z);
+		pack_t c = cos_r(z);
+
+		// tan(x) = s / c for even q, -c / s for odd q
+
+		bpack_t odd = (q == pack_t(T(1))) | (q == pack_t(T(3)));
+		pack_t y = cond(odd, -c, s) / cond(odd, s, c);
+		y = cond(x == pack_t::zeros(), x, y);
+
+		return trig_fallback(x, y, static_cast<T(*)(T)>(std::tan));
+	}
+
+	template<typename T, typename Kind>
+	inline simd_pack<T, Kind> atan_impl(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+		typedef simd_bpack<T, Kind> bpack_t;
+		typedef native_math_consts<T> C;
+
+		pack_t one(T(1));
+		pack_t z = pack_t::zeros();
+		pack_t ax = abs(x);
+
+		// atan(x) = pi/2 + atan(-1/x)         for x > tan(3pi/8)
+		//         = pi/4 + atan((x-1)/(x+1))  for x > tan(pi/8) (f32) or 0.66 (f64)
+
+		bpack_t hi = ax > pack_t(C::atan_hi());
+		bpack_t mid = (ax > pack_t(C::atan_mid())) & ~hi;
+
+		pack_t u = cond(hi, -one, cond(mid, ax - one, ax)) / cond(hi, ax, cond(mid, ax + one, one));
+		pack_t y0 = cond(hi, pack_t(C::half_pi()), cond(mid, pack_t(C::quar_pi()), z));
+		pack_t mb = cond(hi, pack_t(C::morebits()), cond(mid, pack_t(T(0.5) * C::morebits()), z));
+
+		pack_t y = y0 + (native_math_poly<T>::atan_r(u, u * u) + mb);
+		return cond(signbit(x), -y, y);
+	}
+
+
+	/********************************************
+	 *
+	 *  hyperbolic
+	 *
+	 ********************************************/
+
+	// both exp(x) and 0.5 * exp(x) for large x, without overflow in between
+
+	template<typename T, typename Kind>
+	LMAT_ENSURE_INLINE
+	inline simd_pack<T, Kind> hyp_big(const simd_pack<T, Kind>& ax, const simd_pack<T, Kind>& y)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+		pack_t thres(native_math_consts<T>::hyp_big());
+
+		if (any_true(ax > thres))
+		{
+			pack_t h = exp_impl(pack_t(T(0.5)) * ax);
+			return cond(ax > thres, (pack_t(T(0.5)) * h) * h, y);
+		}
+		else return y;
+	}
+
+	template<typename T, typename Kind>
+	inline simd_pack<T, Kind> sinh_impl(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+
+		// sinh(x) = (t + t / (t + 1)) / 2, with t = expm1(|x|)
+
+		pack_t ax = abs(x);
+		pack_t t = expm1_impl(ax);
+		pack_t y = hyp_big(ax, pack_t(T(0.5)) * (t + t / (t + pack_t(T(1)))));
+
+		return cond(signbit(x), -y, y);
+	}
+
+	template<typename T, typename Kind>
+	inline simd_pack<T, Kind> cosh_impl(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+
+		pack_t ax = abs(x);
+		pack_t h(T(0.5));
+		pack_t e = exp_impl(ax);
+
+		return hyp_big(ax, h * e + h / e);
+	}
+
+	template<typename T, typename Kind>
+	inline simd_pack<T, Kind> tanh_impl(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+
+		// tanh(|x|) = -t / (t + 2), with t = expm1(-2|x|) in (-1, 0]
+
+		pack_t t = expm1_impl(pack_t(T(-2)) * abs(x));
+		pack_t y = -t / (t + pack_t(T(2)));
+
+		return cond(signbit(x), -y, y);
+	}
+
+} } LMAT_END_NAMESPACE
+
+
+/************************************************
+ *
+ *  Export to LMAT functions
+ *
+ ************************************************/
+
+#define _LMAT_NATIVE_SIMD1( Name, PK ) \
+	LMAT_ENSURE_INLINE \
+	inline PK Name( const PK& a ) { \
+		return internal::Name##_impl(a); }
+
+#define _LMAT_NATIVE_SIMD2( Name, PK ) \
+	LMAT_ENSURE_INLINE \
+	inline PK Name( const PK& a, const PK& b ) { \
+		return internal::Name##_impl(a, b); }
+
+#ifdef LMAT_HAS_AVX
+#define _LMAT_NATIVE_SIMD1_AVX( Name ) \
+	_LMAT_NATIVE_SIMD1( Name, avx_f32pk ) \
+	_LMAT_NATIVE_SIMD1( Name, avx_f64pk )
+#define _LMAT_NATIVE_SIMD2_AVX( Name ) \
+	_LMAT_NATIVE_SIMD2( Name, avx_f32pk ) \
+	_LMAT_NATIVE_SIMD2( Name, avx_f64pk )
+#else
+#define _LMAT_NATIVE_SIMD1_AVX( Name )
+#define _LMAT_NATIVE_SIMD2_AVX( Name )
+#endif
+
+#ifdef LMAT_HAS_AVX512
+#define _LMAT_NATIVE_SIMD1_AVX512( Name ) \
+	_LMAT_NATIVE_SIMD1( Name, avx512_f32pk ) \
+	_LMAT_NATIVE_SIMD1( Name, avx512_f64pk )
+#define _LMAT_NATIVE_SIMD2_AVX512( Name ) \
+	_LMAT_NATIVE_SIMD2( Name, avx512_f32pk ) \
+	_LMAT_NATIVE_SIMD2( Name, avx512_f64pk )
+#else
+#define _LMAT_NATIVE_SIMD1_AVX512( Name )
+#define _LMAT_NATIVE_SIMD2_AVX512( Name )
+#endif
+
+#define LMAT_DEFINE_NATIVE_SIMD1( Name ) \
+	_LMAT_NATIVE_SIMD1( Name, sse_f32pk ) \
+	_LMAT_NATIVE_SIMD1( Name, sse_f64pk ) \
+	_LMAT_NATIVE_SIMD1_AVX( Name ) \
+	_LMAT_NATIVE_SIMD1_AVX512( Name )
+
+#define LMAT_DEFINE_NATIVE_SIMD2( Name ) \
+	_LMAT_NATIVE_SIMD2( Name, sse_f32pk ) \
+	_LMAT_NATIVE_SIMD2( Name, sse_f64pk ) \
+	_LMAT_NATIVE_SIMD2_AVX( Name ) \
+	_LMAT_NATIVE_SIMD2_AVX512( Name )
+
+
+LMAT_BEGIN_NAMESPACE namespace math {
+
+	// power functions
+
+	LMAT_DEFINE_NATIVE_SIMD2( pow )
+
+	// exp & log
+
+	LMAT_DEFINE_NATIVE_SIMD1( exp )
+	LMAT_DEFINE_NATIVE_SIMD1( log )
+	LMAT_DEFINE_NATIVE_SIMD1( log10 )
+
+	LMAT_DEFINE_NATIVE_SIMD1( exp2 )
+	LMAT_DEFINE_NATIVE_SIMD1( log2 )
+	LMAT_DEFINE_NATIVE_SIMD1( expm1 )
+	LMAT_DEFINE_NATIVE_SIMD1( log1p )
+
+	// trigonometry
+
+	LMAT_DEFINE_NATIVE_SIMD1( sin )
+	LMAT_DEFINE_NATIVE_SIMD1( cos )
+	LMAT_DEFINE_NATIVE_SIMD1( tan )
+	LMAT_DEFINE_NATIVE_SIMD1( atan )
+
+	// hyperbolic
+
+	LMAT_DEFINE_NATIVE_SIMD1( sinh )
+	LMAT_DEFINE_NATIVE_SIMD1( cosh )
+	LMAT_DEFINE_NATIVE_SIMD1( tanh )
+
+	// xlogy & xlogx
+
+	template<typename T, typename Kind>
+	LMAT_ENSURE_INLINE
+	inline simd_pack<T, Kind> xlogy(const simd_pack<T, Kind>& a, const simd_pack<T, Kind>& b)
+	{
+		simd_pack<T, Kind> z = simd_pack<T, Kind>::zeros();
+		return cond(a > z, log(b), z) * a;
+	}
+
+	template<typename T, typename Kind>
+	LMAT_ENSURE_INLINE
+	inline simd_pack<T, Kind> xlogx(const simd_pack<T, Kind>& a)
+	{
+		return xlogy(a, a);
+	}
+
+} LMAT_END_NAMESPACE
+
+
+/************************************************
+ *
+ *  Declaration of SIMD support
+ *
+ ************************************************/
+
+#ifdef LMAT_HAS_AVX
+#define _LMAT_NATIVE_SIMD_SUPPORT_AVX( name ) LMAT_DEFINE_HAS_AVX_SUPPORT( name )
+#else
+#define _LMAT_NATIVE_SIMD_SUPPORT_AVX( name )
+#endif
+
+#ifdef LMAT_HAS_AVX512
+#define _LMAT_NATIVE_SIMD_SUPPORT_AVX512( name ) LMAT_DEFINE_HAS_AVX512_SUPPORT( name )
+#else
+#define _LMAT_NATIVE_SIMD_SUPPORT_AVX512( name )
+#endif
+
+#define _LMAT_DECLARE_NATIVE_SIMD_SUPPORT( name ) \
+	LMAT_DEFINE_HAS_SSE_SUPPORT( name ) \
+	_LMAT_NATIVE_SIMD_SUPPORT_AVX( name ) \
+	_LMAT_NATIVE_SIMD_SUPPORT_AVX512( name )
+
+LMAT_BEGIN_NAMESPACE namespace meta {
+
+	// power functions
+
+	_LMAT_DECLARE_NATIVE_SIMD_SUPPORT( pow_ )
+
+	// exp & log
+
+	_LMAT_DECLARE_NATIVE_SIMD_SUPPORT( exp_ )
+	_LMAT_DECLARE_NATIVE_SIMD_SUPPORT( log_ )
+	_LMAT_DECLARE_NATIVE_SIMD_SUPPORT( log10_ )
+	_LMAT_DECLARE_NATIVE_SIMD_SUPPORT( xlogy_ )
+	_LMAT_DECLARE_NATIVE_SIMD_SUPPORT( xlogx_ )
+
+	_LMAT_DECLARE_NATIVE_SIMD_SUPPORT( exp2_ )
+	_LMAT_DECLARE_NATIVE_SIMD_SUPPORT( log2_ )
+	_LMAT_DECLARE_NATIVE_SIMD_SUPPORT( expm1_ )
+	_LMAT_DECLARE_NATIVE_SIMD_SUPPORT( log1p_ )
+
+	// trigonometry
+
+	_LMAT_DECLARE_NATIVE_SIMD_SUPPORT( sin_ )
+	_LMAT_DECLARE_NATIVE_SIMD_SUPPORT( cos_ )
+	_LMAT_DECLARE_NATIVE_SIMD_SUPPORT( tan_ )
+	_LMAT_DECLARE_NATIVE_SIMD_SUPPORT( atan_ )
+
+	// hyperbolic
+
+	_LMAT_DECLARE_NATIVE_SIMD_SUPPORT( sinh_ )
+	_LMAT_DECLARE_NATIVE_SIMD_SUPPORT( cosh_ )
+	_LMAT_DECLARE_NATIVE_SIMD_SUPPORT( tanh_ )
+
+} LMAT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,621 @@
+/**
+ * @file native_simd_special.h
+ *
+ * @brief Built-in SIMD implementation of special functions
+ *
+ * This is used together with native_simd_math.h, when neither
+ * Intel SVML nor AMD LibM is available.
+ *
+ *  - erf, erfc:		rational approximations after fdlibm (s_erf.c)
+ *  - norminv:			Wichura's AS241, as the scalar version
+ *  - tgamma, lgamma:	rational approximations on [2, 3) after Cephes,
+ *  					a polynomial for lgamma on [1, 2) with its zeros
+ *  					factored out, the recurrence for x < 12, Stirling's
+ *  					series for x >= 12, and the reflection formula for
+ *  					negative x. The f32 versions are evaluated in double
+ *  					precision.
+ *
+ * Maximum errors measured against quadruple precision with random inputs
+ * over the tested domains, in ulps (f32 / f64):
+ *
+ *  erf				1 / 1		erfc			3 / 3
+ *  norminv			5 / 5
+ *  tgamma			1 / 6		lgamma			1 / 3  (x > 0)
+ *
+ * For negative x, lgamma is only accurate in the absolute sense near
+ * its zeros. Results in the subnormal range may lose precision.
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_NATIVE_SIMD_SPECIAL_H_
+#define LIGHTMAT_NATIVE_SIMD_SPECIAL_H_
+
+#include "native_simd_math.h"
+
+LMAT_BEGIN_NAMESPACE namespace math { namespace internal {
+
+	/********************************************
+	 *
+	 *  constants
+	 *
+	 ********************************************/
+
+	template<typename T> struct native_special_consts;
+
+	template<> struct native_special_consts<float>
+	{
+		// erfc_tail rounds x to a multiple of 1 / erf_scale,
+		// which leaves at most 12 significant bits below erfc_big
+		LMAT_ENSURE_INLINE static float erf_scale() { return 256.0f; }
+
+		LMAT_ENSURE_INLINE static float erf_big()   { return 4.0f; }	// erf(x) rounds to 1 beyond
+		LMAT_ENSURE_INLINE static float erfc_big()  { return 11.0f; }	// erfc(x) underflows beyond
+	};
+
+	template<> struct native_special_consts<double>
+	{
+		// leaving at most 21 significant bits
+		LMAT_ENSURE_INLINE static double erf_scale() { return 65536.0; }
+
+		LMAT_ENSURE_INLINE static double erf_big()   { return 6.0; }
+		LMAT_ENSURE_INLINE static double erfc_big()  { return 28.0; }
+	};
+
+
+	/********************************************
+	 *
+	 *  erf & erfc
+	 *
+	 ********************************************/
+
+	// erf(x) = x + x * erf_r1(x) for |x| < 0.84375
+
+	template<typename T, typename Kind>
+	LMAT_ENSURE_INLINE
+	inline simd_pack<T, Kind> erf_r1(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+
+		pack_t z = x * x;
+		pack_t r = horner<pack_t>(z,
+				T(-2.37630166566501626084e-05), T(-5.77027029648944159157e-03),
+				T(-2.84817495755985104766e-02), T(-3.25042107247001499370e-01),
+				T( 1.28379167095512558561e-01));
+		pack_t s = horner<pack_t>(z,
+				T(-3.96022827877536812320e-06), T( 1.32494738004321644526e-04),
+				T( 5.08130628187576562776e-03), T( 6.50222499887672944485e-02),
+				T( 3.97917223959155352819e-01), T(1));
+		return r / s;
+	}
+
+	// erf(x) = erx + erf_r2(x - 1) for 0.84375 <= x < 1.25
+
+	template<typename T>
+	LMAT_ENSURE_INLINE
+	inline T erf_erx() { return T(8.45062911510467529297e-01); }
+
+	template<typename T, typename Kind>
+	LMAT_ENSURE_INLINE
+	inline simd_pack<T, Kind> erf_r2(const simd_pack<T, Kind>& s)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+
+		pack_t p = horner<pack_t>(s,
+				T(-2.16637559486879084300e-03), T( 3.54783043256182359371e-02),
+				T(-1.10894694282396677476e-01), T( 3.18346619901161753674e-01),
+				T(-3.72207876035701323847e-01), T( 4.14856118683748331666e-01),
+				T(-2.36211856075265944077e-03));
+		pack_t q = horner<pack_t>(s,
+				T( 1.19844998467991074170e-02), T( 1.36370839120290507362e-02),
+				T( 1.26171219808761642112e-01), T( 7.18286544141962662868e-02),
+				T( 5.40397917702171048937e-01), T( 1.06420880400844228286e-01),
+				T(1));
+		return p / q;
+	}
+
+	// erfc(x) for x >= 1.25
+
+	template<typename T, typename Kind>
+	inline simd_pack<T, Kind> erfc_tail(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+
+		pack_t one(T(1));
+		pack_t s = one / (x * x);
+
+		pack_t ra = horner<pack_t>(s,
+				T(-9.81432934416914548592e+00), T(-8.12874355063065934246e+01),
+				T(-1.84605092906711035994e+02), T(-1.62396669462573470355e+02),
+				T(-6.23753324503260060396e+01), T(-1.05586262253232909814e+01),
+				T(-6.93858572707181764372e-01), T(-9.86494403484714822705e-03));
+		pack_t sa = horner<pack_t>(s,
+				T(-6.04244152148580987438e-02), T( 6.57024977031928170135e+00),
+				T( 1.08635005541779435134e+02), T( 4.29008140027567833386e+02),
+				T( 6.45387271733267880336e+02), T( 4.34565877475229228821e+02),
+				T( 1.37657754143519042600e+02), T( 1.96512716674392571292e+01),
+				T(1));
+
+		pack_t rb = horner<pack_t>(s,
+				T(-4.83519191608651397019e+02), T(-1.02509513161107724954e+03),
+				T(-6.37566443368389627722e+02), T(-1.60636384855821916062e+02),
+				T(-1.77579549177547519889e+01), T(-7.99283237680523006574e-01),
+				T(-9.86494292470009928597e-03));
+		pack_t sb = horner<pack_t>(s,
+				T(-2.24409524465858183362e+01), T( 4.74528541206955367215e+02),
+				T( 2.55305040643316442583e+03), T( 3.19985821950859553908e+03),
+				T( 1.53672958608443695994e+03), T( 3.25792512996573918826e+02),
+				T( 3.03380607434824582924e+01), T(1));
+
+		simd_bpack<T, Kind> near = x < pack_t(T(2.857142857142857));  // 1 / 0.35
+		pack_t rs = cond(near, ra, rb) / cond(near, sa, sb);
+
+		// exp(-x^2) = exp(-z^2) * exp((z - x) * (z + x)), where z has
+		// few enough bits for z^2 + 0.5625 to be exact. Rounding to a grid,
+		// rather than a Veltkamp split, is immune to FMA contraction.
+
+		pack_t sc(native_special_consts<T>::erf_scale());
+		pack_t z = round(x * sc) / sc;
+
+		pack_t r = exp_impl(-z * z - pack_t(T(0.5625))) * exp_impl((z - x) * (z + x) + rs);
+		return r / x;
+	}
+
+	template<typename T, typename Kind>
+	inline simd_pack<T, Kind> erf_impl(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+
+		pack_t one(T(1));
+		pack_t ax = abs(x);
+		pack_t y = x + x * erf_r1(x);
+
+		simd_bpack<T, Kind> small = ax < pack_t(T(0.84375));
+		if (!all_true(small))
+		{
+			pack_t v = pack_t(erf_erx<T>()) + erf_r2(ax - one);
+
+			simd_bpack<T, Kind> mid = ax < pack_t(T(1.25));
+			if (!all_true(small | mid))
+			{
+				// NaNs go through here
+				pack_t xb = (min)(pack_t(native_special_consts<T>::erf_big()), ax);
+				v = cond(mid, v, one - erfc_tail(xb));
+			}
+
+			y = cond(small, y, cond(signbit(x), -v, v));
+		}
+
+		return y;
+	}
+
+	template<typename T, typename Kind>
+	inline simd_pack<T, Kind> erfc_impl(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+		typedef simd_bpack<T, Kind> bpack_t;
+
+		pack_t one(T(1));
+		pack_t half(T(0.5));
+		pack_t ax = abs(x);
+
+		pack_t r = x * erf_r1(x);
+		pack_t y = cond(x < pack_t(T(0.25)), one - (x + r), half - (r + (x - half)));
+
+		bpack_t small = ax < pack_t(T(0.84375));
+		if (!all_true(small))
+		{
+			bpack_t neg = x < pack_t::zeros();
+
+			pack_t p = erf_r2(ax - one);
+			pack_t v = cond(neg, one + (pack_t(erf_erx<T>()) + p), (one - pack_t(erf_erx<T>())) - p);
+
+			bpack_t mid = ax < pack_t(T(1.25));
+			if (!all_true(small | mid))
+			{
+				pack_t xb = (min)(pack_t(native_special_consts<T>::erfc_big()), ax);
+				pack_t t = erfc_tail(xb);
+				v = cond(mid, v, cond(neg, pack_t(T(2)) - t, t));
+			}
+
+			y = cond(small, y, v);
+		}
+
+		return y;
+	}
+
+
+	/********************************************
+	 *
+	 *  norminv
+	 *
+	 ********************************************/
+
+	template<typename T, typename Kind>
+	inline simd_pack<T, Kind> norminv_simd(const simd_pack<T, Kind>& x)
+	{
+		typedef simd_pack<T, Kind> pack_t;
+		typedef simd_bpack<T, Kind> bpack_t;
+		typedef norminv_impl<T> R;
+
+		pack_t one(T(1));
+		pack_t half(T(0.5));
+
+		pack_t q = x - half;
+		pack_t y = q * R::central(pack_t(T(0.180625)) - q * q);
+
+		bpack_t central = abs(q) <= pack_t(T(0.425));
+		if (!all_true(central))
+		{
+			bpack_t neg = q < pack_t::zeros();
+			pack_t r = sqrt(-log_impl(cond(neg, x, one - x)));
+
+			bpack_t t1 = r <= pack_t(T(5));
+			pack_t v = cond(t1, R::tail1(r - pack_t(T(1.6))), R::tail2(r - pack_t(T(5))));
+			y = cond(central, y, cond(neg, -v, v));
+
+			y = cond(x == pack_t::zeros(), pack_t::neg_inf(), y);
+			y = cond(x == one, pack_t::inf(), y);
+			y = cond((x >= pack_t::zeros()) & (x <= one), y, pack_t::nan());
+		}
+
+		return y;
+	}
+
+
+	/********************************************
+	 *
+	 *  gamma functions (f64)
+	 *
+	 ********************************************/
+
+	// x = u + k (k >= 0), with u in [2, 3), for 0 <= x < 12,
+	// and accumulates (u + k - 1) ... (u + 1) u / (x (x + 1) ...)
+	// as num / den. Other entries are mapped to u = 2.5.
+
+	template<typename Kind>
+	inline simd_pack<double, Kind> gamma_shift(const simd_pack<double, Kind>& x,
+			simd_pack<double, Kind>& num, simd_pack<double, Kind>& den)
+	{
+		typedef simd_pack<double, Kind> pack_t;
+		typedef simd_bpack<double, Kind> bpack_t;
+
+		pack_t one(1.0);
+		pack_t z = pack_t::zeros();
+		pack_t u = cond(x < pack_t(12.0), x, pack_t(2.5));
+
+		num = one;
+		den = one;
+
+		bpack_t m = u >= pack_t(3.0);
+		while (any_true(m))
+		{
+			u = u - cond(m, one, z);
+			num = num * cond(m, u, one);
+			m = u >= pack_t(3.0);
+		}
+
+		m = u < pack_t(2.0);
+		while (any_true(m))
+		{
+			den = den * cond(m, u, one);
+			u = u + cond(m, one, z);
+			m = u < pack_t(2.0);
+		}
+
+		return u;
+	}
+
+	// gamma(2 + t) for t in [0, 1)
+
+	template<typename Kind>
+	LMAT_ENSURE_INLINE
+	inline simd_pack<double, Kind> gamma_r(const simd_pack<double, Kind>& t)
+	{
+		typedef simd_pack<double, Kind> pack_t;
+
+		pack_t p = horner<pack_t>(t,
+				1.60119522476751861407e-4, 1.19135147006586384913e-3,
+				1.04213797561761569935e-2, 4.76367800457137231464e-2,
+				2.07448227648435975150e-1, 4.94214826801497100753e-1,
+				9.99999999999999996796e-1);
+		pack_t q = horner<pack_t>(t,
+				-2.31581873324120129819e-5, 5.39605580493303397842e-4,
+				-4.45641913851797240494e-3, 1.18139785222060435552e-2,
+				3.58236398605498653373e-2, -2.34591795718243348568e-1,
+				7.14304917030273074085e-2, 1.00000000000000000320e0);
+		return p / q;
+	}
+
+	// lgamma(2 + t) / t for t in [0, 1)
+
+	template<typename Kind>
+	LMAT_ENSURE_INLINE
+	inline simd_pack<double, Kind> lgamma_r(const simd_pack<double, Kind>& t)
+	{
+		typedef simd_pack<double, Kind> pack_t;
+
+		pack_t p = horner<pack_t>(t,
+				-1.37825152569120859100e3, -3.88016315134637840924e4,
+				-3.31612992738871184744e5, -1.16237097492762307383e6,
+				-1.72173700820839662146e6, -8.53555664245765465627e5);
+		pack_t q = horner<pack_t>(t, 1.0,
+				-3.51815701436523470549e2, -1.70642106651881159223e4,
+				-2.20528590553854454839e5, -1.13933444367982507207e6,
+				-2.53252307177582951285e6, -2.01889141433532773231e6);
+		return p / q;
+	}
+
+	// Stirling's series: lgamma(x) = (x - 1/2) log(x) - x + log(2 pi) / 2 + S(x),
+	// where the terms up to x^-13 give full precision for x >= 12
+
+	template<typename Kind>
+	LMAT_ENSURE_INLINE
+	inline simd_pack<double, Kind> stirling_s(const simd_pack<double, Kind>& x)
+	{
+		typedef simd_pack<double, Kind> pack_t;
+
+		pack_t w = pack_t(1.0) / x;
+		return w * horner<pack_t>(w * w,
+				1.0 / 156, -691.0 / 360360, 1.0 / 1188, -1.0 / 1680,
+				1.0 / 1260, -1.0 / 360, 1.0 / 12);
+	}
+
+	// gamma(x) for positive x
+
+	template<typename Kind>
+	inline simd_pack<double, Kind> gamma_pos(const simd_pack<double, Kind>& x)
+	{
+		typedef simd_pack<double, Kind> pack_t;
+
+		pack_t num, den;
+		pack_t u = gamma_shift(x, num, den);
+		pack_t g = (num * gamma_r(u - pack_t(2.0))) / den;
+
+		// NaNs also go through here
+
+		simd_bpack<double, Kind> big = ~(x < pack_t(12.0));
+		if (any_true(big))
+		{
+			// exp((x - 1/2) log(x) - x + S(x)), carried in double-double,
+			// where gamma(x) overflows well before 180
+
+			pack_t xb = cond(big, (min)(pack_t(180.0), x), pack_t(12.0));
+
+			pack_t lx_hi, lx_lo;
+			log_dd(xb, lx_hi, lx_lo);
+
+			pack_t h = xb - pack_t(0.5);
+			pack_t t_hi, t_lo, e;
+			two_prod(h, lx_hi, t_hi, e);
+			t_lo = fma(h, lx_lo, e);
+
+			fast_two_sum(t_hi, -xb, t_hi, e);
+			fast_two_sum(t_hi, e + t_lo + stirling_s(xb), t_hi, t_lo);
+
+			pack_t gb = exp_dd(t_hi, t_lo) * pack_t(2.50662827463100050242);  // sqrt(2 pi)
+			g = cond(big, gb, g);
+		}
+
+		return g;
+	}
+
+	// lgamma(1 + t) / (t (t - 1)) for t in [0, 1], as a polynomial in t - 1/2.
+	// Factoring out the zeros keeps the relative accuracy near x = 1 and 2.
+
+	template<typename Kind>
+	LMAT_ENSURE_INLINE
+	inline simd_pack<double, Kind> lgamma_f(const simd_pack<double, Kind>& t)
+	{
+		typedef simd_pack<double, Kind> pack_t;
+
+		return horner<pack_t>(t - pack_t(0.5),
+				1.214892243173481577021e-05, -1.854131057783639647938e-05,
+				1.317489137303144227508e-05, -2.147168647203838504490e-05,
+				4.303358406992271594191e-05, -6.794532539113437061705e-05,
+				1.053533917616040485132e-04, -1.685696123246344797260e-04,
+				2.713140460447867150995e-04, -4.380355151925843312624e-04,
+				7.115190337726783376793e-04, -1.164411342547995857218e-03,
+				1.922916315044322031674e-03, -3.212074222602008947707e-03,
+				5.446457839039636037246e-03, -9.425622444767518303912e-03,
+				1.679709863127584247885e-02, -3.130848750105415090357e-02,
+				6.291140107456437933907e-02, -1.459598959143059342752e-01,
+				4.831289505409808899628e-01);
+	}
+
+	// lgamma(x) for positive x
+
+	template<typename Kind>
+	inline simd_pack<double, Kind> lgamma_pos(const simd_pack<double, Kind>& x)
+	{
+		typedef simd_pack<double, Kind> pack_t;
+		typedef simd_bpack<double, Kind> bpack_t;
+
+		pack_t one(1.0);
+
+		// x >= 2: shifted down to u in [2, 3), where t = u - 2 is exact
+
+		pack_t num, den;
+		pack_t u = gamma_shift(x, num, den);
+		pack_t t = u - pack_t(2.0);
+		pack_t y = log_impl(num) + t * lgamma_r(t);
+
+		bpack_t lo = x < pack_t(2.0);
+		if (any_true(lo))
+		{
+			// lgamma(x) = t (t - 1) F(t) with t = x - 1 for 1 <= x < 2, and
+			// lgamma(x) = lgamma(1 + x) - log(x) for 0 < x < 1
+
+			bpack_t sub = x < one;
+			pack_t s = cond(sub, x, x - one);
+			pack_t yl = s * (s - one) * lgamma_f(s) - log_impl(cond(sub, x, one));
+			yl = yl + pack_t::zeros();  // +0 rather than -0 at x = 1
+			y = cond(lo, yl, y);
+		}
+
+		bpack_t big = ~(x < pack_t(12.0));  // including NaNs
+		if (any_true(big))
+		{
+			pack_t xb = cond(big, x, pack_t(12.0));
+			pack_t yb = (xb - pack_t(0.5)) * (log_impl(xb) - one) +
+					(pack_t(0.41893853320467274178) + stirling_s(xb));  // log(2 pi) / 2 - 1/2
+			y = cond(big, yb, y);
+		}
+
+		return y;
+	}
+
+	// sin(pi * x), for non-integer x
+
+	template<typename Kind>
+	LMAT_ENSURE_INLINE
+	inline simd_pack<double, Kind> sinpi(const simd_pack<double, Kind>& x)
+	{
+		typedef simd_pack<double, Kind> pack_t;
+
+		pack_t n = round(x);
+		pack_t s = sin_impl((x - n) * pack_t(3.14159265358979323846));
+
+		pack_t hn = n * pack_t(0.5);
+		return cond(floor(hn) != hn, -s, s);
+	}
+
+	template<typename Kind>
+	inline simd_pack<double, Kind> tgamma_impl(const simd_pack<double, Kind>& x)
+	{
+		typedef simd_pack<double, Kind> pack_t;
+		typedef simd_bpack<double, Kind> bpack_t;
+
+		pack_t ax = abs(x);
+		pack_t g = gamma_pos(ax);
+
+		// gamma(x) = pi / (|x| sin(pi x) gamma(|x|)) for x < 0
+
+		bpack_t neg = x < pack_t::zeros();
+		if (any_true(neg))
+		{
+			pack_t v = (pack_t(3.14159265358979323846) / (ax * sinpi(x))) / g;
+			g = cond(neg, v, g);
+			g = cond(neg & (floor(x) == x), pack_t::nan(), g);  // poles and -inf
+		}
+
+		// gamma(x) = 1 / x - euler + ... near zero, where the
+		// reflection underflows (this also gives +-inf at +-0)
+
+		g = cond(ax < pack_t(2.220446049250313e-16), pack_t(1.0) / x, g);
+		return cond(x == pack_t::inf(), x, g);
+	}
+
+	template<typename Kind>
+	inline simd_pack<double, Kind> lgamma_impl(const simd_pack<double, Kind>& x)
+	{
+		typedef simd_pack<double, Kind> pack_t;
+		typedef simd_bpack<double, Kind> bpack_t;
+
+		pack_t ax = abs(x);
+		pack_t y = lgamma_pos(ax);
+
+		// lgamma(x) = log(pi / |x sin(pi x)|) - lgamma(|x|) for x < 0
+
+		bpack_t neg = x < pack_t::zeros();
+		if (any_true(neg))
+		{
+			pack_t v = pack_t(1.14472988584940017414) - log_impl(abs(ax * sinpi(x))) - y;  // log(pi)
+			y = cond(neg, v, y);
+			y = cond(neg & (floor(x) == x), pack_t::inf(), y);
+		}
+
+		// lgamma(x) = -log|x| - euler * x + ... near zero, where the reflection underflows
+		y = cond(ax < pack_t(2.220446049250313e-16), -log_impl(ax), y);
+		return cond(ax == pack_t::inf(), ax, y);
+	}
+
+
+	/********************************************
+	 *
+	 *  gamma functions (f32)
+	 *
+	 ********************************************/
+
+	template<typename Kind>
+	inline simd_pack<float, Kind> tgamma_impl(const simd_pack<float, Kind>& x)
+	{
+		simd_pack<double, Kind> lo, hi;
+		widen(x, lo, hi);
+		return narrow(tgamma_impl(lo), tgamma_impl(hi));
+	}
+
+	template<typename Kind>
+	inline simd_pack<float, Kind> lgamma_impl(const simd_pack<float, Kind>& x)
+	{
+		simd_pack<double, Kind> lo, hi;
+		widen(x, lo, hi);
+		return narrow(lgamma_impl(lo), lgamma_impl(hi));
+	}
+
+} } LMAT_END_NAMESPACE
+
+
+/************************************************
+ *
+ *  Export to LMAT functions
+ *
+ ************************************************/
+
+LMAT_BEGIN_NAMESPACE namespace math {
+
+	// gauss related functions
+
+	LMAT_DEFINE_NATIVE_SIMD1( erf )
+	LMAT_DEFINE_NATIVE_SIMD1( erfc )
+
+	// gamma related functions
+
+	LMAT_DEFINE_NATIVE_SIMD1( lgamma )
+	LMAT_DEFINE_NATIVE_SIMD1( tgamma )
+
+	// norminv (norminv_impl is taken by the scalar version)
+
+#define _LMAT_NATIVE_NORMINV( PK ) \
+	LMAT_ENSURE_INLINE \
+	inline PK norminv( const PK& a ) { \
+		return internal::norminv_simd(a); }
+
+	_LMAT_NATIVE_NORMINV( sse_f32pk )
+	_LMAT_NATIVE_NORMINV( sse_f64pk )
+
+#ifdef LMAT_HAS_AVX
+	_LMAT_NATIVE_NORMINV( avx_f32pk )
+	_LMAT_NATIVE_NORMINV( avx_f64pk )
+#endif
+
+#ifdef LMAT_HAS_AVX512
+	_LMAT_NATIVE_NORMINV( avx512_f32pk )
+	_LMAT_NATIVE_NORMINV( avx512_f64pk )
+#endif
+
+#undef _LMAT_NATIVE_NORMINV
+
+} LMAT_END_NAMESPACE
+
+
+LMAT_BEGIN_NAMESPACE namespace meta {
+
+	// gauss related functions
+
+	_LMAT_DECLARE_NATIVE_SIMD_SUPPORT( erf_ )
+	_LMAT_DECLARE_NATIVE_SIMD_SUPPORT( erfc_ )
+	_LMAT_DECLARE_NATIVE_SIMD_SUPPORT( norminv_ )
+
+	// gamma related functions
+
+	_LMAT_DECLARE_NATIVE_SIMD_SUPPORT( lgamma_ )
+	_LMAT_DECLARE_NATIVE_SIMD_SUPPORT( tgamma_ )
+
+} LMAT_END_NAMESPACE
+
+#endif
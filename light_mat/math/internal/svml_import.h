@@ -169,7 +169,7 @@ extern "C"
 
 #endif
 
-namespace lmat { namespace math {
+LMAT_BEGIN_NAMESPACE namespace math {
 
 	// power functions
 
@@ -306,7 +306,7 @@ namespace lmat { namespace math {
 	}
 #endif
 
-} }
+} LMAT_END_NAMESPACE
 
 
 /************************************************
@@ -328,7 +328,7 @@ namespace lmat { namespace math {
 #endif
 
 
-namespace lmat { namespace meta {
+LMAT_BEGIN_NAMESPACE namespace meta {
 
 	// power functions
 
@@ -380,7 +380,7 @@ namespace lmat { namespace meta {
 
 	_LMAT_DECLARE_SVML_SIMD_SUPPORT( norminv_ )
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif // LMAT_USE_INTEL_SVML
 
@@ -15,7 +15,7 @@
 #ifndef LIGHTMAT_MATH_H_
 #define LIGHTMAT_MATH_H_
 
-namespace lmat { namespace math {
+LMAT_BEGIN_NAMESPACE namespace math {
 
 	// power functions
 
@@ -79,6 +79,6 @@ namespace lmat { namespace math {
 	using std::acosh;
 	using std::atanh;
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif 
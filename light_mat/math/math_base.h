@@ -14,6 +14,7 @@
 #define LIGHTMAT_MATH_BASE_H_
 
 #include <light_mat/math/fun_tags.h>
+#include <light_mat/simd/simd_arch.h>
 
 #if ((LIGHTMAT_PLATFORM == LIGHTMAT_POSIX) || defined(__INTEL_COMPILER))
 #define LMAT_PLATFORM_HAS_CXX11_MATH
@@ -23,12 +24,37 @@
 #include <cstdlib>
 #include <cmath>
 
-namespace lmat { namespace math {
+LMAT_BEGIN_NAMESPACE namespace math {
 
 	// arithmetics
 
 	using std::fma;
 
+	// fmadd: x * y + z, fused only where the hardware does it fast
+	// (std::fma falls back to a slow software routine otherwise)
+
+	template<typename T>
+	LMAT_ENSURE_INLINE inline T fmadd(const T& x, const T& y, const T& z) { return x * y + z; }
+
+#ifdef LMAT_HAS_FMA
+	template<>
+	LMAT_ENSURE_INLINE inline float fmadd(const float& x, const float& y, const float& z) { return std::fma(x, y, z); }
+
+	template<>
+	LMAT_ENSURE_INLINE inline double fmadd(const double& x, const double& y, const double& z) { return std::fma(x, y, z); }
+#endif
+
+	// horner(x, c_n, ..., c_1, c_0) = c_n * x^n + ... + c_1 * x + c_0
+
+	template<typename T>
+	LMAT_ENSURE_INLINE inline T horner(const T& x, const T& c0) { return c0; }
+
+	template<typename T, typename... C>
+	LMAT_ENSURE_INLINE inline T horner(const T& x, const T& cn, const T& cm, const C&... c)
+	{
+		return horner(x, fmadd(cn, x, cm), T(c)...);
+	}
+
 	template<typename T>
 	LMAT_ENSURE_INLINE inline T (max)(const T& x, const T& y) { return x > y ? x : y; }
 
@@ -100,6 +126,6 @@ namespace lmat { namespace math {
 	using std::isnan;
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif 
@@ -15,7 +15,7 @@
 
 #include <light_mat/common/prim_types.h>
 
-namespace lmat { namespace math {
+LMAT_BEGIN_NAMESPACE namespace math {
 
 	template<typename T> struct consts;
 
@@ -74,6 +74,6 @@ namespace lmat { namespace math {
 		static float e() { return 2.718281828459f; }	// E
 	};
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif /* MATH_CONSTANTS_H_ */
@@ -17,8 +17,7 @@
 #include <light_mat/math/math.h>
 #include <light_mat/math/simd_math.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	// power functions
 
 	_LMAT_DEFINE_REAL_MATH_FUN( pow, 2 )
@@ -59,6 +58,6 @@ namespace lmat
 	_LMAT_DEFINE_REAL_MATH_FUN( acosh, 1 )
 	_LMAT_DEFINE_REAL_MATH_FUN( atanh, 1 )
 
-}
+LMAT_END_NAMESPACE
 
 #endif
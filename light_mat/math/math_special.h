@@ -18,7 +18,7 @@
 
 #include "internal/norminv_impl.h"
 
-namespace lmat { namespace math {
+LMAT_BEGIN_NAMESPACE namespace math {
 
 #ifdef LMAT_HAS_CXX11_MATH
 
@@ -43,6 +43,6 @@ namespace lmat { namespace math {
 	}
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif
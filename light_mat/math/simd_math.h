@@ -25,6 +25,9 @@
 #include "internal/svml_import.h"
 #elif LMAT_USE_AMD_LIBM
 #include "internal/libm_simd_import.h"
+#else
+#include "internal/native_simd_math.h"
+#include "internal/native_simd_special.h"
 #endif
 
 #endif 
@@ -17,8 +17,7 @@
 #include <light_mat/math/math_special.h>
 #include <light_mat/math/simd_math.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	// gauss related functions
 
 	_LMAT_DEFINE_REAL_MATH_FUN( erf, 1 )
@@ -29,7 +28,7 @@ namespace lmat
 
 	_LMAT_DEFINE_REAL_MATH_FUN( lgamma, 1 )
 	_LMAT_DEFINE_REAL_MATH_FUN( tgamma, 1 )
-}
+LMAT_END_NAMESPACE
 
 
 #endif
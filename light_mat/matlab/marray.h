@@ -17,7 +17,7 @@
 
 #include <light_mat/common/basic_defs.h>
 
-namespace lmat { namespace matlab {
+LMAT_BEGIN_NAMESPACE namespace matlab {
 
 
 	/********************************************
@@ -519,6 +519,6 @@ namespace lmat { namespace matlab {
 
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif /* MARRAY_H_ */
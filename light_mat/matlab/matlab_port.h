@@ -52,7 +52,7 @@
 void _lmat_mex_main_entry(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]);
 template<typename T> void _lmat_mex_generic_main_entry(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]);
 
-namespace lmat { namespace matlab {
+LMAT_BEGIN_NAMESPACE namespace matlab {
 
 	/********************************************
 	 *
@@ -250,7 +250,7 @@ namespace lmat { namespace matlab {
 	_LMAT_DEFINE_MEX_MAIN_DISPATCH(11)
 	_LMAT_DEFINE_MEX_MAIN_DISPATCH(12)
 
-} }
+} LMAT_END_NAMESPACE
 
 /********************************************
  *
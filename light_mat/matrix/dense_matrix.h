@@ -18,8 +18,7 @@
 
 #include <algorithm> // for std::swap
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	/********************************************
 	 *
@@ -32,6 +31,10 @@ namespace lmat
 	: public regular_matrix_traits_base<T, CM, CN, cpu_domain>
 	{
 		typedef cont_layout_cm<CM, CN> layout_type;
+
+		// dynamic storage comes from aligned_allocator
+		static const unsigned int ct_alignment =
+				(CM == 0 || CN == 0) ? aligned_allocator<T>::ct_alignment : 0;
 	};
 
 
@@ -442,7 +445,7 @@ namespace lmat
 	LMAT_MATRIX_TYPEDEFS1(dense_row, row2, 2)
 	LMAT_MATRIX_TYPEDEFS1(dense_row, row3, 3)
 
-}
+LMAT_END_NAMESPACE
 
 
 #endif 
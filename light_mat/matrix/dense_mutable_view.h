@@ -15,8 +15,7 @@
 
 #include <light_mat/matrix/matrix_concepts.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	template<class Mat>
 	class dense_mutable_view : public Mat
@@ -48,6 +47,6 @@ namespace lmat
 
 
 	}; // end dense_wref_mat
-}
+LMAT_END_NAMESPACE
 
 #endif /* DENSE_WREF_MAT_H_ */
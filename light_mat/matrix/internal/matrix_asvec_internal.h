@@ -15,7 +15,7 @@
 
 #include <light_mat/matrix/matrix_meta.h>
 
-namespace lmat { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace internal {
 
 	template<class Mat>
 	struct as_vec_indicator
@@ -269,6 +269,6 @@ namespace lmat { namespace internal {
 		}
 	};
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif /* MATRIX_ASVEC_INTERNAL_H_ */
@@ -15,7 +15,7 @@
 
 #include <light_mat/matrix/matrix_meta.h>
 
-namespace lmat {  namespace internal {
+LMAT_BEGIN_NAMESPACE  namespace internal {
 
 	template<class Mat, class Range, bool IsPerColCont, bool IsReadOnly> struct colview_helper;
 
@@ -204,6 +204,6 @@ namespace lmat {  namespace internal {
 	};
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif /* MATRIX_SUBVIEWS_INTERNAL_H_ */
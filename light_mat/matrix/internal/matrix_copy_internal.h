@@ -15,7 +15,7 @@
 
 #include <light_mat/matrix/matrix_properties.h>
 
-namespace lmat { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace internal {
 
 	template<index_t M, index_t N, typename ContLevel>
 	struct matrix_copy_scheme
@@ -437,6 +437,8 @@ namespace lmat { namespace internal {
 		{
 			if (m == 1)
 				_copy_singlevec(n, ps, smat.col_stride(), pd, dmat.col_stride());
+			else if (smat.col_stride() == 1 && dmat.col_stride() == 1)  // rows are contiguous
+				_copy_multicol(n, m, ps, smat.row_stride(), pd, dmat.row_stride());
 			else
 				_copy_multicol(m, n,
 						ps, smat.row_stride(), smat.col_stride(),
@@ -445,6 +447,6 @@ namespace lmat { namespace internal {
 	}
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif 
@@ -15,7 +15,7 @@
 
 #include <light_mat/matrix/matrix_properties.h>
 
-namespace lmat { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace internal {
 
 	template<index_t M, index_t N, typename ContLevel>
 	struct matrix_fill_scheme
@@ -222,7 +222,10 @@ namespace lmat { namespace internal {
 			else
 			{
 				const index_t rs = dmat.row_stride();
-				_fill_multicol(m, n, v, pd, rs, cs);
+				if (cs == 1)  // rows are contiguous
+					_fill_multicol(n, m, v, pd, rs);
+				else
+					_fill_multicol(m, n, v, pd, rs, cs);
 			}
 		}
 	}
@@ -314,13 +317,16 @@ namespace lmat { namespace internal {
 			else
 			{
 				const index_t rs = dmat.row_stride();
-				_zero_multicol(m, n, pd, rs, cs);
+				if (cs == 1)  // rows are contiguous
+					_zero_multicol(n, m, pd, rs);
+				else
+					_zero_multicol(m, n, pd, rs, cs);
 			}
 		}
 	}
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif /* MATRIX_FILL_INTERNAL_H_ */
 
@@ -15,7 +15,7 @@
 
 #include <light_mat/matrix/matrix_meta.h>
 
-namespace lmat { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace internal {
 
 	// tags
 
@@ -481,6 +481,6 @@ namespace lmat { namespace internal {
 	};
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif /* MATRIX_ITER_INTERNAL_H_ */
@@ -15,7 +15,7 @@
 
 #include <light_mat/matrix/matrix_shape.h>
 
-namespace lmat { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace internal {
 
 	inline index_t raise_no_linear_offset()
 	{
@@ -165,6 +165,120 @@ namespace lmat { namespace internal {
 		return 0;
 	}
 
-} }
+
+	// row-major contiguous layout
+
+	template<index_t M, index_t N>
+	LMAT_ENSURE_INLINE
+	inline index_t cont_rm_sub2offset(const matrix_shape<M, N>& shape, index_t i, index_t j)
+	{
+		return i * shape.ncolumns() + j;
+	}
+
+	template<index_t M>
+	LMAT_ENSURE_INLINE
+	inline index_t cont_rm_sub2offset(const matrix_shape<M, 1>& shape, index_t i, index_t j)
+	{
+		return i;
+	}
+
+	template<index_t N>
+	LMAT_ENSURE_INLINE
+	inline index_t cont_rm_sub2offset(const matrix_shape<1, N>& shape, index_t i, index_t j)
+	{
+		return j;
+	}
+
+	LMAT_ENSURE_INLINE
+	inline index_t cont_rm_sub2offset(const matrix_shape<1, 1>& shape, index_t i, index_t j)
+	{
+		return 0;
+	}
+
+	template<index_t M, index_t N>
+	LMAT_ENSURE_INLINE
+	inline index_t cont_rm_linoffset(const matrix_shape<M, N>& shape, index_t i)
+	{
+		return raise_no_linear_offset();
+	}
+
+	template<index_t M>
+	LMAT_ENSURE_INLINE
+	inline index_t cont_rm_linoffset(const matrix_shape<M, 1>& shape, index_t i)
+	{
+		return i;
+	}
+
+	template<index_t N>
+	LMAT_ENSURE_INLINE
+	inline index_t cont_rm_linoffset(const matrix_shape<1, N>& shape, index_t i)
+	{
+		return i;
+	}
+
+	LMAT_ENSURE_INLINE
+	inline index_t cont_rm_linoffset(const matrix_shape<1, 1>& shape, index_t i)
+	{
+		return 0;
+	}
+
+
+	// row-major block layout
+
+	template<index_t M, index_t N>
+	LMAT_ENSURE_INLINE
+	inline index_t block_rm_sub2offset(const matrix_shape<M, N>& shape, index_t i, index_t j, index_t ldim)
+	{
+		return i * ldim + j;
+	}
+
+	template<index_t M>
+	LMAT_ENSURE_INLINE
+	inline index_t block_rm_sub2offset(const matrix_shape<M, 1>& shape, index_t i, index_t j, index_t ldim)
+	{
+		return i * ldim;
+	}
+
+	template<index_t N>
+	LMAT_ENSURE_INLINE
+	inline index_t block_rm_sub2offset(const matrix_shape<1, N>& shape, index_t i, index_t j, index_t ldim)
+	{
+		return j;
+	}
+
+	LMAT_ENSURE_INLINE
+	inline index_t block_rm_sub2offset(const matrix_shape<1, 1>& shape, index_t i, index_t j, index_t ldim)
+	{
+		return 0;
+	}
+
+	template<index_t M, index_t N>
+	LMAT_ENSURE_INLINE
+	inline index_t block_rm_linoffset(const matrix_shape<M, N>& shape, index_t i, index_t ldim)
+	{
+		return raise_no_linear_offset();
+	}
+
+	template<index_t M>
+	LMAT_ENSURE_INLINE
+	inline index_t block_rm_linoffset(const matrix_shape<M, 1>& shape, index_t i, index_t ldim)
+	{
+		return i * ldim;
+	}
+
+	template<index_t N>
+	LMAT_ENSURE_INLINE
+	inline index_t block_rm_linoffset(const matrix_shape<1, N>& shape, index_t i, index_t ldim)
+	{
+		return i;
+	}
+
+	LMAT_ENSURE_INLINE
+	inline index_t block_rm_linoffset(const matrix_shape<1, 1>& shape, index_t i, index_t ldim)
+	{
+		return 0;
+	}
+
+} LMAT_END_NAMESPACE
 
 #endif 
@@ -15,7 +15,7 @@
 
 #include <light_mat/matrix/matrix_meta.h>
 
-namespace lmat {  namespace internal {
+LMAT_BEGIN_NAMESPACE  namespace internal {
 
 	// ContLevel
 	// 0 : non contiguous at each column
@@ -142,7 +142,7 @@ namespace lmat {  namespace internal {
 
 	// range x whole
 
-	template<class Mat, index_t L>
+	template<class Mat, int L>
 	struct matview_helper<Mat, range, whole, L, true>
 	{
 		typedef typename matrix_traits<Mat>::value_type value_type;
@@ -158,7 +158,7 @@ namespace lmat {  namespace internal {
 		}
 	};
 
-	template<class Mat, index_t L>
+	template<class Mat, int L>
 	struct matview_helper<Mat, range, whole, L, false>
 	{
 		typedef typename matrix_traits<Mat>::value_type value_type;
@@ -177,7 +177,7 @@ namespace lmat {  namespace internal {
 
 	// range x range
 
-	template<class Mat, index_t L>
+	template<class Mat, int L>
 	struct matview_helper<Mat, range, range, L, true>
 	{
 		typedef typename matrix_traits<Mat>::value_type value_type;
@@ -194,7 +194,7 @@ namespace lmat {  namespace internal {
 		}
 	};
 
-	template<class Mat, index_t L>
+	template<class Mat, int L>
 	struct matview_helper<Mat, range, range, L, false>
 	{
 		typedef typename matrix_traits<Mat>::value_type value_type;
@@ -214,7 +214,7 @@ namespace lmat {  namespace internal {
 
 	// range x step
 
-	template<class Mat, index_t L>
+	template<class Mat, int L>
 	struct matview_helper<Mat, range, step_range, L, true>
 	{
 		typedef typename matrix_traits<Mat>::value_type value_type;
@@ -231,7 +231,7 @@ namespace lmat {  namespace internal {
 		}
 	};
 
-	template<class Mat, index_t L>
+	template<class Mat, int L>
 	struct matview_helper<Mat, range, step_range, L, false>
 	{
 		typedef typename matrix_traits<Mat>::value_type value_type;
@@ -251,7 +251,7 @@ namespace lmat {  namespace internal {
 
 	// step x whole
 
-	template<class Mat, index_t L>
+	template<class Mat, int L>
 	struct matview_helper<Mat, step_range, whole, L, true>
 	{
 		typedef typename matrix_traits<Mat>::value_type value_type;
@@ -267,7 +267,7 @@ namespace lmat {  namespace internal {
 		}
 	};
 
-	template<class Mat, index_t L>
+	template<class Mat, int L>
 	struct matview_helper<Mat, step_range, whole, L, false>
 	{
 		typedef typename matrix_traits<Mat>::value_type value_type;
@@ -286,7 +286,7 @@ namespace lmat {  namespace internal {
 
 	// step x range
 
-	template<class Mat, index_t L>
+	template<class Mat, int L>
 	struct matview_helper<Mat, step_range, range, L, true>
 	{
 		typedef typename matrix_traits<Mat>::value_type value_type;
@@ -304,7 +304,7 @@ namespace lmat {  namespace internal {
 		}
 	};
 
-	template<class Mat, index_t L>
+	template<class Mat, int L>
 	struct matview_helper<Mat, step_range, range, L, false>
 	{
 		typedef typename matrix_traits<Mat>::value_type value_type;
@@ -325,7 +325,7 @@ namespace lmat {  namespace internal {
 
 	// step x step
 
-	template<class Mat, index_t L>
+	template<class Mat, int L>
 	struct matview_helper<Mat, step_range, step_range, L, true>
 	{
 		typedef typename matrix_traits<Mat>::value_type value_type;
@@ -343,7 +343,7 @@ namespace lmat {  namespace internal {
 		}
 	};
 
-	template<class Mat, index_t L>
+	template<class Mat, int L>
 	struct matview_helper<Mat, step_range, step_range, L, false>
 	{
 		typedef typename matrix_traits<Mat>::value_type value_type;
@@ -702,6 +702,6 @@ namespace lmat {  namespace internal {
 		}
 	};
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif /* MATRIX_MATVIEWS_INTERNAL_H_ */
@@ -15,7 +15,7 @@
 
 #include <light_mat/matrix/matrix_meta.h>
 
-namespace lmat {  namespace internal {
+LMAT_BEGIN_NAMESPACE  namespace internal {
 
 	template<class Mat, class Range, bool IsPerRowCont, bool IsReadOnly> struct rowview_helper;
 
@@ -213,7 +213,7 @@ namespace lmat {  namespace internal {
 
 
 
-} }
+} LMAT_END_NAMESPACE
 
 
 #endif /* MATRIX_ROWVIEWS_INTERNAL_H_ */
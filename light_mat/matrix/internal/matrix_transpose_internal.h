@@ -15,8 +15,431 @@
 
 #include <light_mat/common/memory.h>
 #include <light_mat/matrix/matrix_classes.h>
+#include <light_mat/simd/simd.h>
+#include <vector>
 
-namespace lmat { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace internal {
+
+	/********************************************
+	 *
+	 *  blocked transposition
+	 *
+	 *  The matrix is processed in tiles of 16
+	 *  source rows by 256 source columns, i.e.
+	 *  whole cache lines of each source column
+	 *  and each destination row, which together
+	 *  stay within L1 (f32) or L2 (f64) cache.
+	 *  Within a tile, w x w blocks are transposed
+	 *  in registers.
+	 *
+	 ********************************************/
+
+	const index_t transpose_tile_rows = 16;
+	const index_t transpose_tile_cols = 256;
+
+	// run: transposes a w x w block, from columns of src to columns of dst
+	//      (src may be the same as dst)
+	// swap: transposes two w x w blocks and exchanges them
+
+	template<typename T>
+	struct transpose_kernel
+	{
+		static const index_t width = 1;
+
+		LMAT_ENSURE_INLINE
+		static void run(const T *src, index_t ls, T *dst, index_t ld)
+		{
+			*dst = *src;
+		}
+
+		LMAT_ENSURE_INLINE
+		static void swap(T *p, T *q, index_t ld)
+		{
+			T t = *p;
+			*p = *q;
+			*q = t;
+		}
+	};
+
+#ifdef LMAT_HAS_AVX
+
+	template<>
+	struct transpose_kernel<float>
+	{
+		static const index_t width = 8;
+
+		LMAT_ENSURE_INLINE
+		static void run(const float *src, index_t ls, float *dst, index_t ld)
+		{
+			avx_f32pk a0(src);
+			avx_f32pk a1(src + ls);
+			avx_f32pk a2(src + 2 * ls);
+			avx_f32pk a3(src + 3 * ls);
+			avx_f32pk a4(src + 4 * ls);
+			avx_f32pk a5(src + 5 * ls);
+			avx_f32pk a6(src + 6 * ls);
+			avx_f32pk a7(src + 7 * ls);
+
+			transpose(a0, a1, a2, a3, a4, a5, a6, a7);
+
+			a0.store_u(dst);
+			a1.store_u(dst + ld);
+			a2.store_u(dst + 2 * ld);
+			a3.store_u(dst + 3 * ld);
+			a4.store_u(dst + 4 * ld);
+			a5.store_u(dst + 5 * ld);
+			a6.store_u(dst + 6 * ld);
+			a7.store_u(dst + 7 * ld);
+		}
+
+		LMAT_ENSURE_INLINE
+		static void swap(float *p, float *q, index_t ld)
+		{
+			avx_f32pk a0(p);
+			avx_f32pk a1(p + ld);
+			avx_f32pk a2(p + 2 * ld);
+			avx_f32pk a3(p + 3 * ld);
+			avx_f32pk a4(p + 4 * ld);
+			avx_f32pk a5(p + 5 * ld);
+			avx_f32pk a6(p + 6 * ld);
+			avx_f32pk a7(p + 7 * ld);
+
+			avx_f32pk b0(q);
+			avx_f32pk b1(q + ld);
+			avx_f32pk b2(q + 2 * ld);
+			avx_f32pk b3(q + 3 * ld);
+			avx_f32pk b4(q + 4 * ld);
+			avx_f32pk b5(q + 5 * ld);
+			avx_f32pk b6(q + 6 * ld);
+			avx_f32pk b7(q + 7 * ld);
+
+			transpose(a0, a1, a2, a3, a4, a5, a6, a7);
+			transpose(b0, b1, b2, b3, b4, b5, b6, b7);
+
+			a0.store_u(q);
+			a1.store_u(q + ld);
+			a2.store_u(q + 2 * ld);
+			a3.store_u(q + 3 * ld);
+			a4.store_u(q + 4 * ld);
+			a5.store_u(q + 5 * ld);
+			a6.store_u(q + 6 * ld);
+			a7.store_u(q + 7 * ld);
+
+			b0.store_u(p);
+			b1.store_u(p + ld);
+			b2.store_u(p + 2 * ld);
+			b3.store_u(p + 3 * ld);
+			b4.store_u(p + 4 * ld);
+			b5.store_u(p + 5 * ld);
+			b6.store_u(p + 6 * ld);
+			b7.store_u(p + 7 * ld);
+		}
+	};
+
+	template<>
+	struct transpose_kernel<double>
+	{
+		static const index_t width = 4;
+
+		LMAT_ENSURE_INLINE
+		static void run(const double *src, index_t ls, double *dst, index_t ld)
+		{
+			avx_f64pk a0(src);
+			avx_f64pk a1(src + ls);
+			avx_f64pk a2(src + 2 * ls);
+			avx_f64pk a3(src + 3 * ls);
+
+			transpose(a0, a1, a2, a3);
+
+			a0.store_u(dst);
+			a1.store_u(dst + ld);
+			a2.store_u(dst + 2 * ld);
+			a3.store_u(dst + 3 * ld);
+		}
+
+		LMAT_ENSURE_INLINE
+		static void swap(double *p, double *q, index_t ld)
+		{
+			avx_f64pk a0(p);
+			avx_f64pk a1(p + ld);
+			avx_f64pk a2(p + 2 * ld);
+			avx_f64pk a3(p + 3 * ld);
+
+			avx_f64pk b0(q);
+			avx_f64pk b1(q + ld);
+			avx_f64pk b2(q + 2 * ld);
+			avx_f64pk b3(q + 3 * ld);
+
+			transpose(a0, a1, a2, a3);
+			transpose(b0, b1, b2, b3);
+
+			a0.store_u(q);
+			a1.store_u(q + ld);
+			a2.store_u(q + 2 * ld);
+			a3.store_u(q + 3 * ld);
+
+			b0.store_u(p);
+			b1.store_u(p + ld);
+			b2.store_u(p + 2 * ld);
+			b3.store_u(p + 3 * ld);
+		}
+	};
+
+#else
+
+	template<>
+	struct transpose_kernel<float>
+	{
+		static const index_t width = 4;
+
+		LMAT_ENSURE_INLINE
+		static void run(const float *src, index_t ls, float *dst, index_t ld)
+		{
+			sse_f32pk a0(src);
+			sse_f32pk a1(src + ls);
+			sse_f32pk a2(src + 2 * ls);
+			sse_f32pk a3(src + 3 * ls);
+
+			transpose(a0, a1, a2, a3);
+
+			a0.store_u(dst);
+			a1.store_u(dst + ld);
+			a2.store_u(dst + 2 * ld);
+			a3.store_u(dst + 3 * ld);
+		}
+
+		LMAT_ENSURE_INLINE
+		static void swap(float *p, float *q, index_t ld)
+		{
+			sse_f32pk a0(p);
+			sse_f32pk a1(p + ld);
+			sse_f32pk a2(p + 2 * ld);
+			sse_f32pk a3(p + 3 * ld);
+
+			sse_f32pk b0(q);
+			sse_f32pk b1(q + ld);
+			sse_f32pk b2(q + 2 * ld);
+			sse_f32pk b3(q + 3 * ld);
+
+			transpose(a0, a1, a2, a3);
+			transpose(b0, b1, b2, b3);
+
+			a0.store_u(q);
+			a1.store_u(q + ld);
+			a2.store_u(q + 2 * ld);
+			a3.store_u(q + 3 * ld);
+
+			b0.store_u(p);
+			b1.store_u(p + ld);
+			b2.store_u(p + 2 * ld);
+			b3.store_u(p + 3 * ld);
+		}
+	};
+
+	template<>
+	struct transpose_kernel<double>
+	{
+		static const index_t width = 2;
+
+		LMAT_ENSURE_INLINE
+		static void run(const double *src, index_t ls, double *dst, index_t ld)
+		{
+			sse_f64pk a0(src);
+			sse_f64pk a1(src + ls);
+
+			transpose(a0, a1);
+
+			a0.store_u(dst);
+			a1.store_u(dst + ld);
+		}
+
+		LMAT_ENSURE_INLINE
+		static void swap(double *p, double *q, index_t ld)
+		{
+			sse_f64pk a0(p);
+			sse_f64pk a1(p + ld);
+
+			sse_f64pk b0(q);
+			sse_f64pk b1(q + ld);
+
+			transpose(a0, a1);
+			transpose(b0, b1);
+
+			a0.store_u(q);
+			a1.store_u(q + ld);
+
+			b0.store_u(p);
+			b1.store_u(p + ld);
+		}
+	};
+
+#endif
+
+	// m x n (column-major, with column stride ls) --> n x m (column stride ld)
+
+	template<typename T>
+	inline void transpose_tile(index_t m, index_t n, const T *src, index_t ls, T *dst, index_t ld)
+	{
+		typedef transpose_kernel<T> kernel_t;
+		const index_t w = kernel_t::width;
+
+		const index_t mw = m - m % w;
+		const index_t nw = n - n % w;
+
+		for (index_t j = 0; j < nw; j += w)
+		{
+			const T *s = src + j * ls;
+			T *d = dst + j;
+
+			for (index_t i = 0; i < mw; i += w)
+				kernel_t::run(s + i, ls, d + i * ld, ld);
+
+			for (index_t i = mw; i < m; ++i)
+			{
+				for (index_t k = 0; k < w; ++k)
+					d[i * ld + k] = s[i + k * ls];
+			}
+		}
+
+		for (index_t j = nw; j < n; ++j)
+		{
+			const T *s = src + j * ls;
+			for (index_t i = 0; i < m; ++i)
+				dst[i * ld + j] = s[i];
+		}
+	}
+
+	template<typename T>
+	inline void blocked_transpose(index_t m, index_t n, const T *src, index_t ls, T *dst, index_t ld)
+	{
+		const index_t bm = transpose_tile_rows;
+		const index_t bn = transpose_tile_cols;
+
+		for (index_t j = 0; j < n; j += bn)
+		{
+			const index_t nb = j + bn < n ? bn : n - j;
+
+			for (index_t i = 0; i < m; i += bm)
+			{
+				const index_t mb = i + bm < m ? bm : m - i;
+				transpose_tile(mb, nb, src + i + j * ls, ls, dst + j + i * ld, ld);
+			}
+		}
+	}
+
+
+	/********************************************
+	 *
+	 *  in-place transposition
+	 *
+	 ********************************************/
+
+	// n x n, with column stride ld. The tiles below the diagonal are
+	// swapped with their mirror images, w x w blocks at a time.
+
+	template<typename T>
+	inline void inplace_transpose_square(index_t n, T *a, index_t ld)
+	{
+		typedef transpose_kernel<T> kernel_t;
+		const index_t w = kernel_t::width;
+		const index_t b = transpose_tile_rows - transpose_tile_rows % w;
+
+		const index_t nw = n - n % w;
+
+		for (index_t j0 = 0; j0 < nw; j0 += b)
+		{
+			const index_t j1 = j0 + b < nw ? j0 + b : nw;
+
+			for (index_t i0 = j0; i0 < nw; i0 += b)
+			{
+				const index_t i1 = i0 + b < nw ? i0 + b : nw;
+
+				for (index_t j = j0; j < j1; j += w)
+				{
+					index_t i = i0;
+					if (i0 == j0)
+					{
+						kernel_t::run(a + j + j * ld, ld, a + j + j * ld, ld);
+						i = j + w;
+					}
+
+					for (; i < i1; i += w)
+						kernel_t::swap(a + i + j * ld, a + j + i * ld, ld);
+				}
+			}
+
+			// the rows beyond nw
+
+			for (index_t j = j0; j < j1; ++j)
+			{
+				for (index_t i = nw; i < n; ++i)
+				{
+					T t = a[i + j * ld];
+					a[i + j * ld] = a[j + i * ld];
+					a[j + i * ld] = t;
+				}
+			}
+		}
+
+		for (index_t j = nw; j < n; ++j)
+		{
+			for (index_t i = j + 1; i < n; ++i)
+			{
+				T t = a[i + j * ld];
+				a[i + j * ld] = a[j + i * ld];
+				a[j + i * ld] = t;
+			}
+		}
+	}
+
+	// m x n --> n x m, both contiguous. The element at i + j * m moves
+	// to j + i * n, and each cycle of this permutation is followed once,
+	// with one bit per element to mark the visited ones.
+
+	template<typename T>
+	inline void inplace_transpose_cycles(index_t m, index_t n, T *a)
+	{
+		const uint64_t um = (uint64_t)m;
+		const uint64_t un = (uint64_t)n;
+		const uint64_t len = um * un;
+
+		// the first and the last elements stay in place
+		std::vector<bool> visited((size_t)len);
+
+		for (uint64_t s = 1; s + 1 < len; ++s)
+		{
+			if (visited[(size_t)s]) continue;
+
+			T v = a[s];
+			uint64_t k = s;
+			do
+			{
+				k = (k % um) * un + k / um;
+
+				T t = a[k];
+				a[k] = v;
+				v = t;
+				visited[(size_t)k] = true;
+			}
+			while (k != s);
+		}
+	}
+
+	template<typename T>
+	inline void inplace_transpose(index_t m, index_t n, T *a)
+	{
+		if (m == n)
+			inplace_transpose_square(n, a, n);
+		else if (m > 1 && n > 1)
+			inplace_transpose_cycles(m, n, a);
+	}
+
+
+	/********************************************
+	 *
+	 *  naive transposition
+	 *
+	 ********************************************/
 
 	template<typename T>
 	inline void naive_transpose(index_t m, index_t n, const T *src, T *dst)
@@ -111,11 +534,17 @@ namespace lmat { namespace internal {
 	{
 		if (meta::is_contiguous<SMat>::value && meta::is_contiguous<DMat>::value)
 		{
-			naive_transpose(m, n, smat.ptr_data(), dmat.ptr_data());
+			if (m == 1 || n == 1)
+				naive_transpose(m, n, smat.ptr_data(), dmat.ptr_data());
+			else
+				blocked_transpose(m, n, smat.ptr_data(), m, dmat.ptr_data(), n);
 		}
 		else if (meta::is_percol_contiguous<SMat>::value && meta::is_percol_contiguous<DMat>::value)
 		{
-			naive_transpose(m, n, smat.ptr_data(), smat.col_stride(), dmat.ptr_data(), dmat.col_stride());
+			if (m == 1 || n == 1)
+				naive_transpose(m, n, smat.ptr_data(), smat.col_stride(), dmat.ptr_data(), dmat.col_stride());
+			else
+				blocked_transpose(m, n, smat.ptr_data(), smat.col_stride(), dmat.ptr_data(), dmat.col_stride());
 		}
 		else
 		{
@@ -126,6 +555,6 @@ namespace lmat { namespace internal {
 	}
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif /* MATRIX_TRANSPOSE_INTERNAL_H_ */
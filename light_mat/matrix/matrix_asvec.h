@@ -18,8 +18,7 @@
 
 #include "internal/matrix_asvec_internal.h"
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	template<typename T, class Mat>
 	LMAT_ENSURE_INLINE
 	inline typename internal::as_col_map<Mat>::const_type
@@ -85,6 +84,6 @@ namespace lmat
 		return ref_row<T>(p, static_cast<index_t>(vec.size()));
 	}
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* MATRIX_ASVEC_H_ */
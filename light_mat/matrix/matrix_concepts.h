@@ -25,8 +25,7 @@
 #endif
 
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	/********************************************
 	 *
@@ -541,7 +540,7 @@ namespace lmat
 	}
 
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* MATRIX_CONCEPTS_H_ */
 
@@ -15,8 +15,7 @@
 
 #include "internal/matrix_copy_internal.h"
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	template<typename T, class RMat>
 	LMAT_ENSURE_INLINE
 	inline void copy(const T *ps, IRegularMatrix<RMat, T>& dst)
@@ -129,11 +128,11 @@ namespace lmat
 		index_t ss = smat.col_stride();
 		index_t ds = dmat.col_stride();
 
-		for (index_t j = 0; j <= k; ++j, ps += ss, pd += ds)
+		for (index_t j = 0; j <= k && j < n; ++j, ps += ss, pd += ds)
 			copy_vec(m, ps, pd);
 
 		index_t j0 = k >= -1 ? k + 1 : 0;
-		for (index_t j = j0; j <= m+k; ++j, ps += ss, pd += ds)
+		for (index_t j = j0; j <= m+k && j < n; ++j, ps += ss, pd += ds)
 		{
 			index_t di = j-k;
 			copy_vec(m-di, ps+di, pd+di);
@@ -141,6 +140,6 @@ namespace lmat
 	}
 
 
-}
+LMAT_END_NAMESPACE
 
 #endif 
@@ -16,8 +16,7 @@
 #include <light_mat/matrix/matrix_properties.h>
 #include "internal/matrix_fill_internal.h"
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	template<typename T, class Mat>
 	LMAT_ENSURE_INLINE
 	inline void zero(IRegularMatrix<Mat, T>& dst)
@@ -40,6 +39,6 @@ namespace lmat
 		return dmat.derived();
 	}
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* MATRIX_FILL_H_ */
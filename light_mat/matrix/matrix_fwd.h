@@ -19,8 +19,7 @@
 
 #include <light_mat/matrix/matrix_shape.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	// forward declaration of concepts
 
 
@@ -77,6 +76,9 @@ namespace lmat
 		typedef typename std::remove_cv<QT>::type value_type;
 
 		typedef Domain domain;
+
+		// the alignment of the base address (in bytes), 0 if unknown
+		static const unsigned int ct_alignment = 0;
 	};
 
 
@@ -102,6 +104,11 @@ namespace lmat
 	template<typename T, index_t CM=0, index_t CN=0> class cref_grid;
 	template<typename T, index_t CM=0, index_t CN=0> class ref_grid;
 
+	template<typename T, index_t CM=0, index_t CN=0> class cref_matrix_rm;
+	template<typename T, index_t CM=0, index_t CN=0> class ref_matrix_rm;
+	template<typename T, index_t CM=0, index_t CN=0> class cref_block_rm;
+	template<typename T, index_t CM=0, index_t CN=0> class ref_block_rm;
+
 	template<typename T, index_t CM=0> class cstep_col;
 	template<typename T, index_t CM=0> class step_col;
 	template<typename T, index_t CN=0> class cstep_row;
@@ -134,7 +141,7 @@ namespace lmat
 	template<class Mat> struct diagview_map;
 	template<class Mat, typename RowRange, typename ColRange> struct matview_map;
 
-}
+LMAT_END_NAMESPACE
 
 // Useful macros
 
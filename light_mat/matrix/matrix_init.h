@@ -16,8 +16,7 @@
 #include <light_mat/matrix/matrix_properties.h>
 #include <initializer_list>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	// initialization routines
 
@@ -124,6 +123,6 @@ namespace lmat
 	}
 
 
-}
+LMAT_END_NAMESPACE
 
 #endif
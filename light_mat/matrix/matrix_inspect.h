@@ -29,8 +29,7 @@
 	struct expr_name< TC<T, M, N> > { \
 		static std::string get() { return #TC; } };
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	// type names
 
 	template<typename T>
@@ -124,6 +123,6 @@ namespace lmat
 	}
 
 
-}
+LMAT_END_NAMESPACE
 
 #endif
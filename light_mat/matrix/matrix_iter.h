@@ -15,8 +15,7 @@
 
 #include "internal/matrix_iter_internal.h"
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	namespace meta
 	{
 		template<class Mat>
@@ -94,6 +93,6 @@ namespace lmat
 
 	};
 
-}
+LMAT_END_NAMESPACE
 
 #endif
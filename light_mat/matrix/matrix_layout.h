@@ -15,14 +15,15 @@
 
 #include "internal/matrix_layout_internal.h"
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	// forward declaration
 
 	template<index_t M, index_t N> class cont_layout_cm;
 	template<index_t M, index_t N> class block_layout_cm;
 	template<index_t M, index_t N> class grid_layout;
+	template<index_t M, index_t N> class cont_layout_rm;
+	template<index_t M, index_t N> class block_layout_rm;
 
 	/********************************************
 	 *
@@ -40,6 +41,7 @@ namespace lmat
 
 		static const bool ct_is_contiguous = true;
 		static const bool ct_is_percol_contiguous = true;
+		static const bool ct_is_perrow_contiguous = (M == 1 || N == 1);
 
 		typedef matrix_shape<M, N> shape_type;
 	};
@@ -52,6 +54,7 @@ namespace lmat
 
 		static const bool ct_is_contiguous = (N == 1);
 		static const bool ct_is_percol_contiguous = true;
+		static const bool ct_is_perrow_contiguous = (N == 1);
 
 		typedef matrix_shape<M, N> shape_type;
 	};
@@ -64,6 +67,33 @@ namespace lmat
 
 		static const bool ct_is_contiguous = (M == 1 && N == 1);
 		static const bool ct_is_percol_contiguous = M == 1;
+		static const bool ct_is_perrow_contiguous = N == 1;
+
+		typedef matrix_shape<M, N> shape_type;
+	};
+
+	template<index_t M, index_t N>
+	struct layout_traits<cont_layout_rm<M, N> >
+	{
+		static const index_t ct_num_rows = M;
+		static const index_t ct_num_cols = N;
+
+		static const bool ct_is_contiguous = (M == 1 || N == 1);
+		static const bool ct_is_percol_contiguous = (M == 1 || N == 1);
+		static const bool ct_is_perrow_contiguous = true;
+
+		typedef matrix_shape<M, N> shape_type;
+	};
+
+	template<index_t M, index_t N>
+	struct layout_traits<block_layout_rm<M, N> >
+	{
+		static const index_t ct_num_rows = M;
+		static const index_t ct_num_cols = N;
+
+		static const bool ct_is_contiguous = (M == 1);
+		static const bool ct_is_percol_contiguous = (M == 1);
+		static const bool ct_is_perrow_contiguous = true;
 
 		typedef matrix_shape<M, N> shape_type;
 	};
@@ -390,7 +420,7 @@ namespace lmat
 		LMAT_ENSURE_INLINE
 		bool is_percol_contiguous() const
 		{
-			return m_rowstride() == 1;
+			return m_rowstride == 1;
 		}
 
 		LMAT_ENSURE_INLINE
@@ -424,7 +454,190 @@ namespace lmat
 	};
 
 
-}
+	/********************************************
+	 *
+	 *  row-major layout classes
+	 *
+	 *  Elements within each row are contiguous,
+	 *  for interoperation with row-major (C) data.
+	 *
+	 ********************************************/
+
+	template<index_t M, index_t N>
+	class cont_layout_rm : public IMatrixLayout<cont_layout_rm<M, N> >
+	{
+	public:
+		LMAT_ENSURE_INLINE
+		cont_layout_rm() : m_shape() { }
+
+		LMAT_ENSURE_INLINE
+		cont_layout_rm(index_t m, index_t n) : m_shape(m, n) { };
+
+	public:
+		LMAT_ENSURE_INLINE
+		index_t nrows() const
+		{
+			return m_shape.nrows();
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t ncolumns() const
+		{
+			return m_shape.ncolumns();
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t nelems() const
+		{
+			return m_shape.nelems();
+		}
+
+		LMAT_ENSURE_INLINE
+		matrix_shape<M, N> shape() const
+		{
+			return m_shape;
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t row_stride() const
+		{
+			return m_shape.ncolumns();
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t col_stride() const
+		{
+			return 1;
+		}
+
+		LMAT_ENSURE_INLINE
+		bool is_contiguous() const
+		{
+			return nrows() == 1 || ncolumns() == 1;
+		}
+
+		LMAT_ENSURE_INLINE
+		bool is_percol_contiguous() const
+		{
+			return nrows() == 1 || ncolumns() == 1;
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t offset(index_t i, index_t j) const
+		{
+			return internal::cont_rm_sub2offset(m_shape, i, j);
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t col_offset(index_t j) const
+		{
+			return j;
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t row_offset(index_t i) const
+		{
+			return m_shape.ncolumns() * i;
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t lin_offset(index_t i) const
+		{
+			return internal::cont_rm_linoffset(m_shape, i);
+		}
+
+	private:
+		matrix_shape<M, N> m_shape;
+	};
+
+
+	template<index_t M, index_t N>
+	class block_layout_rm : public IMatrixLayout<block_layout_rm<M, N> >
+	{
+	public:
+		LMAT_ENSURE_INLINE
+		block_layout_rm(index_t m, index_t n, index_t ldim) : m_shape(m, n), m_leaddim(ldim) { };
+
+	public:
+		LMAT_ENSURE_INLINE
+		index_t nrows() const
+		{
+			return m_shape.nrows();
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t ncolumns() const
+		{
+			return m_shape.ncolumns();
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t nelems() const
+		{
+			return m_shape.nelems();
+		}
+
+		LMAT_ENSURE_INLINE
+		matrix_shape<M, N> shape() const
+		{
+			return m_shape;
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t row_stride() const
+		{
+			return m_leaddim;
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t col_stride() const
+		{
+			return 1;
+		}
+
+		LMAT_ENSURE_INLINE
+		bool is_contiguous() const
+		{
+			return nrows() == 1 || (ncolumns() == 1 && m_leaddim == 1);
+		}
+
+		LMAT_ENSURE_INLINE
+		bool is_percol_contiguous() const
+		{
+			return nrows() == 1 || m_leaddim == 1;
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t offset(index_t i, index_t j) const
+		{
+			return internal::block_rm_sub2offset(m_shape, i, j, m_leaddim);
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t col_offset(index_t j) const
+		{
+			return j;
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t row_offset(index_t i) const
+		{
+			return m_leaddim * i;
+		}
+
+		LMAT_ENSURE_INLINE
+		index_t lin_offset(index_t i) const
+		{
+			return internal::block_rm_linoffset(m_shape, i, m_leaddim);
+		}
+
+	private:
+		matrix_shape<M, N> m_shape;
+		index_t m_leaddim;
+	};
+
+
+LMAT_END_NAMESPACE
 
 #endif /* MATRIX_LAYOUT_H_ */
 
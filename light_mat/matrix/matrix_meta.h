@@ -16,7 +16,7 @@
 #include <light_mat/matrix/matrix_fwd.h>
 #include <type_traits>
 
-namespace lmat { namespace meta {
+LMAT_BEGIN_NAMESPACE namespace meta {
 
 	/********************************************
 	 *
@@ -297,6 +297,25 @@ namespace lmat { namespace meta {
 		static const bool value = layout_traits<layout_type>::ct_is_percol_contiguous;
 	};
 
+	template<class Mat>
+	struct is_perrow_contiguous
+	{
+		typedef typename matrix_traits<Mat>::layout_type layout_type;
+		static const bool value = layout_traits<layout_type>::ct_is_perrow_contiguous;
+	};
+
+	template<class Mat>
+	struct alignment
+	{
+		static const unsigned int value = matrix_traits<Mat>::ct_alignment;
+	};
+
+	template<class Mat>
+	struct is_aligned
+	{
+		static const bool value = matrix_traits<Mat>::ct_alignment > 0;
+	};
+
 
 	template<typename... Mat> struct contiguousness;
 
@@ -321,6 +340,6 @@ namespace lmat { namespace meta {
 	: public or_<is_contiguous<Mat>, is_vector<Mat> > { };
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif /* MATRIX_META_H_ */
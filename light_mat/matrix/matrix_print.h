@@ -24,8 +24,7 @@
 		static const char *get() { return fmt; } };
 
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	template<typename T, class Mat>
 	inline void printf_mat(const char *fmt, const IRegularMatrix<Mat, T>& X,
 			const char *pre_line=nullptr, const char *delim="\n")
@@ -75,6 +74,6 @@ namespace lmat
 		printf_mat(get_default_matprint_fmt(X), X, "    ");
 		std::printf("\n");
 	}
-}
+LMAT_END_NAMESPACE
 
 #endif /* MATRIX_PRINT_H_ */
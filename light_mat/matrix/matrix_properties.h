@@ -21,8 +21,7 @@
 #define LMAT_CHECK_DIMS( cond )
 #endif
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	template<class Mat, typename T>
 	LMAT_ENSURE_INLINE
 	inline bool is_empty(const IMatrixXpr<Mat, T>& X)
@@ -121,6 +120,6 @@ namespace lmat
 		return shape_t(common_nrows(mat0, mats...), common_ncols(mat0, mats...));
 	}
 
-}
+LMAT_END_NAMESPACE
 
 #endif 
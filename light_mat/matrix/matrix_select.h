@@ -16,8 +16,7 @@
 #include <light_mat/matrix/matrix_properties.h>
 #include <light_mat/matrix/matrix_copy.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	// forward
 
 	template<class Mat, class L> class selectl_expr;
@@ -556,6 +555,6 @@ namespace lmat
 		}
 	}
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* MATRIX_SELECT_H_ */
@@ -21,8 +21,7 @@
 #define LMAT_CHECK_DIM_VALIDITY(ct_dim, d)
 #endif
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	/********************************************
 	 *
 	 *  dim checker
@@ -229,6 +228,6 @@ namespace lmat
 		index_t m_ncols;
 	};
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* MATRIX_SHAPE_H_ */
@@ -17,8 +17,7 @@
 #include "internal/matrix_rowviews_internal.h"
 #include "internal/matrix_matviews_internal.h"
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	// column views
 
 	template<class Mat, class Rgn>
@@ -58,7 +57,7 @@ namespace lmat
 	template<class Mat, class Rgn>
 	struct rowview_map
 	{
-		static const bool is_perrow_cont = meta::is_contiguous<Mat>::value && meta::is_row<Mat>::value;
+		static const bool is_perrow_cont = meta::is_perrow_contiguous<Mat>::value;
 		static const bool is_readonly = meta::is_readonly<Mat>::value;
 
 		typedef internal::rowview_helper<Mat, Rgn, is_perrow_cont, true> chelper_t;
@@ -206,6 +205,6 @@ namespace lmat
 	};
 
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* MATRIX_SUBVIEWS_H_ */
@@ -15,8 +15,7 @@
 
 #include "internal/matrix_transpose_internal.h"
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	// forward declaration
 
 	template<class Arg> class transpose_expr;
@@ -36,6 +35,37 @@ namespace lmat
 	}
 
 
+	// in-place transpose
+	//
+	// The matrix is reshaped to n x m. Square matrices are transposed by
+	// swapping blocks; the others by following the cycles of the
+	// permutation, which takes one extra bit per element.
+
+	template<typename T, index_t CM, index_t CN>
+	inline void transpose_inplace(dense_matrix<T, CM, CN>& a)
+	{
+		static_assert(CM == CN, "In-place transposition requires CM == CN.");
+
+		index_t m = a.nrows();
+		index_t n = a.ncolumns();
+
+		internal::inplace_transpose(m, n, a.ptr_data());
+		a.require_size(n, m);  // keeps the storage, as the size is unchanged
+	}
+
+	template<typename T, index_t CM, index_t CN>
+	inline void transpose_inplace(ref_matrix<T, CM, CN>& a)
+	{
+		static_assert(CM == CN, "In-place transposition requires CM == CN.");
+
+		index_t m = a.nrows();
+		index_t n = a.ncolumns();
+
+		internal::inplace_transpose(m, n, a.ptr_data());
+		a.reshape(n, m);
+	}
+
+
 	/******************************************************
 	 *
 	 *  transpose expression class
@@ -116,6 +146,6 @@ namespace lmat
 	}
 
 
-}
+LMAT_END_NAMESPACE
 
 #endif
@@ -15,8 +15,7 @@
 
 #include <light_mat/matrix/regular_mat_base.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	/********************************************
 	 *
 	 *  matrix traits
@@ -148,6 +147,6 @@ namespace lmat
 
 	}; // end ref_block
 
-}
+LMAT_END_NAMESPACE
 
 #endif
@@ -0,0 +1,154 @@
+/**
+ * @file ref_block_rm.h
+ *
+ * Classes : cref_block_rm and ref_block_rm
+ *
+ * Views of row-major blocks (with leading dimension ldim between rows)
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_REF_BLOCK_RM_H_
+#define LIGHTMAT_REF_BLOCK_RM_H_
+
+#include <light_mat/matrix/regular_mat_base.h>
+
+LMAT_BEGIN_NAMESPACE
+	/********************************************
+	 *
+	 *  matrix traits
+	 *
+	 ********************************************/
+
+	template<typename T, index_t CM, index_t CN>
+	struct matrix_traits<cref_block_rm<T, CM, CN> >
+	: public regular_matrix_traits_base<const T, CM, CN, cpu_domain>
+	{
+		typedef block_layout_rm<CM, CN> layout_type;
+	};
+
+
+	template<typename T, index_t CM, index_t CN>
+	struct matrix_traits<ref_block_rm<T, CM, CN> >
+	: public regular_matrix_traits_base<T, CM, CN, cpu_domain>
+	{
+		typedef block_layout_rm<CM, CN> layout_type;
+	};
+
+
+	/********************************************
+	 *
+	 *  matrix classes
+	 *
+	 ********************************************/
+
+	template<typename T, index_t CM, index_t CN>
+	class cref_block_rm : public regular_mat_base<cref_block_rm<T, CM, CN> >
+	{
+	public:
+		LMAT_DEFINE_REGMAT_TYPES(const T)
+		typedef block_layout_rm<CM, CN> layout_type;
+
+	public:
+
+		LMAT_ENSURE_INLINE
+		cref_block_rm(const T* pdata, index_t m, index_t n, index_t ldim)
+		: m_data(pdata), m_layout(m, n, ldim)
+		{
+		}
+
+	private:
+		cref_block_rm& operator = (const cref_block_rm& );  // no assignment
+
+	public:
+		LMAT_ENSURE_INLINE const layout_type& layout() const
+		{
+			return m_layout;
+		}
+
+		LMAT_ENSURE_INLINE const_pointer ptr_data() const
+		{
+			return m_data;
+		}
+
+		LMAT_DEFINE_NO_RESIZE( cref_block_rm )
+
+	private:
+		const T *m_data;
+		layout_type m_layout;
+
+	}; // end class cref_block_rm
+
+
+
+
+	template<typename T, index_t CM, index_t CN>
+	class ref_block_rm : public regular_mat_base<ref_block_rm<T, CM, CN> >
+	{
+	public:
+		LMAT_DEFINE_REGMAT_TYPES(T)
+		typedef block_layout_rm<CM, CN> layout_type;
+
+	public:
+		LMAT_ENSURE_INLINE
+		ref_block_rm(T* pdata, index_t m, index_t n, index_t ldim)
+		: m_data(pdata), m_layout(m, n, ldim)
+		{
+		}
+
+	public:
+		LMAT_ENSURE_INLINE ref_block_rm& operator = (const ref_block_rm& r)
+		{
+			if (this != &r)
+			{
+				copy(r, *this);
+			}
+			return *this;
+		}
+
+		template<class Expr>
+		LMAT_ENSURE_INLINE ref_block_rm& operator = (const IMatrixXpr<Expr, T>& r)
+		{
+			assign(r);
+			return *this;
+		}
+
+	public:
+		LMAT_ENSURE_INLINE const layout_type& layout() const
+		{
+			return m_layout;
+		}
+
+		LMAT_ENSURE_INLINE const_pointer ptr_data() const
+		{
+			return m_data;
+		}
+
+		LMAT_ENSURE_INLINE pointer ptr_data()
+		{
+			return m_data;
+		}
+
+		LMAT_DEFINE_NO_RESIZE( ref_block_rm )
+
+	private:
+		template<class Expr>
+		LMAT_ENSURE_INLINE
+		void assign(const IMatrixXpr<Expr, T>& r)
+		{
+			evaluate(r.derived(), *this);
+		}
+
+	private:
+		T *m_data;
+		layout_type m_layout;
+
+	}; // end ref_block_rm
+
+LMAT_END_NAMESPACE
+
+#endif
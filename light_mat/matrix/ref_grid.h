@@ -15,8 +15,7 @@
 
 #include <light_mat/matrix/regular_mat_base.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	/********************************************
 	 *
@@ -146,6 +145,6 @@ namespace lmat
 
 	}; // end ref_grid
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* REF_GRID_H_ */
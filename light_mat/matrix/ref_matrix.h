@@ -15,8 +15,7 @@
 
 #include <light_mat/matrix/regular_mat_base.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	/********************************************
 	 *
@@ -132,6 +131,14 @@ namespace lmat
 
 		LMAT_DEFINE_NO_RESIZE( ref_matrix )
 
+		// views the same memory with another shape of the same size
+
+		LMAT_ENSURE_INLINE void reshape(index_t m, index_t n)
+		{
+			check_arg(m * n == this->nelems(), "ref_matrix::reshape: the number of elements must not change.");
+			m_layout = layout_type(m, n);
+		}
+
 	private:
 
 		template<class Expr>
@@ -237,6 +244,6 @@ namespace lmat
 		}
 	};
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* REF_MATRIX_H_ */
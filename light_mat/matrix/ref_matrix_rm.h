@@ -0,0 +1,161 @@
+/**
+ * @file ref_matrix_rm.h
+ *
+ * Classes : cref_matrix_rm and ref_matrix_rm
+ *
+ * Views of contiguous row-major matrices
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_REF_MATRIX_RM_H_
+#define LIGHTMAT_REF_MATRIX_RM_H_
+
+#include <light_mat/matrix/regular_mat_base.h>
+
+LMAT_BEGIN_NAMESPACE
+
+	/********************************************
+	 *
+	 *  matrix traits
+	 *
+	 ********************************************/
+
+
+	template<typename T, index_t CM, index_t CN>
+	struct matrix_traits<cref_matrix_rm<T, CM, CN> >
+	: public regular_matrix_traits_base<const T, CM, CN, cpu_domain>
+	{
+		typedef cont_layout_rm<CM, CN> layout_type;
+	};
+
+	template<typename T, index_t CM, index_t CN>
+	struct matrix_traits<ref_matrix_rm<T, CM, CN> >
+	: public regular_matrix_traits_base<T, CM, CN, cpu_domain>
+	{
+		typedef cont_layout_rm<CM, CN> layout_type;
+	};
+
+
+	/********************************************
+	 *
+	 *  matrix classes
+	 *
+	 ********************************************/
+
+	template<typename T, index_t CM, index_t CN>
+	class cref_matrix_rm : public regular_mat_base<cref_matrix_rm<T, CM, CN> >
+	{
+	public:
+		LMAT_DEFINE_REGMAT_TYPES(const T)
+		typedef cont_layout_rm<CM, CN> layout_type;
+
+	public:
+		LMAT_ENSURE_INLINE
+		cref_matrix_rm(const T* pdata, index_t m, index_t n)
+		: m_data(pdata), m_layout(m, n)
+		{
+		}
+
+	private:
+		cref_matrix_rm& operator = (const cref_matrix_rm& );  // no assignment
+
+	public:
+		LMAT_ENSURE_INLINE const layout_type& layout() const
+		{
+			return m_layout;
+		}
+
+		LMAT_ENSURE_INLINE const_pointer ptr_data() const
+		{
+			return m_data;
+		}
+
+		LMAT_DEFINE_NO_RESIZE( cref_matrix_rm )
+
+	private:
+		const T *m_data;
+		layout_type m_layout;
+
+	}; // end class cref_matrix_rm
+
+
+	template<typename T, index_t CM, index_t CN>
+	class ref_matrix_rm : public regular_mat_base<ref_matrix_rm<T, CM, CN> >
+	{
+	public:
+		LMAT_DEFINE_REGMAT_TYPES(T)
+		typedef cont_layout_rm<CM, CN> layout_type;
+
+	public:
+		LMAT_ENSURE_INLINE
+		ref_matrix_rm(T* pdata, index_t m, index_t n)
+		: m_data(pdata), m_layout(m, n)
+		{
+		}
+
+	public:
+		LMAT_ENSURE_INLINE ref_matrix_rm& operator = (const ref_matrix_rm& r)
+		{
+			if (this != &r)
+			{
+				copy(r, *this);
+			}
+			return *this;
+		}
+
+		template<class Expr>
+		LMAT_ENSURE_INLINE ref_matrix_rm& operator = (const IMatrixXpr<Expr, T>& r)
+		{
+			assign(r);
+			return *this;
+		}
+
+	public:
+		LMAT_ENSURE_INLINE const layout_type& layout() const
+		{
+			return m_layout;
+		}
+
+		LMAT_ENSURE_INLINE const_pointer ptr_data() const
+		{
+			return m_data;
+		}
+
+		LMAT_ENSURE_INLINE pointer ptr_data()
+		{
+			return m_data;
+		}
+
+		LMAT_DEFINE_NO_RESIZE( ref_matrix_rm )
+
+		// views the same memory with another shape of the same size
+
+		LMAT_ENSURE_INLINE void reshape(index_t m, index_t n)
+		{
+			check_arg(m * n == this->nelems(), "ref_matrix_rm::reshape: the number of elements must not change.");
+			m_layout = layout_type(m, n);
+		}
+
+	private:
+
+		template<class Expr>
+		LMAT_ENSURE_INLINE
+		void assign(const IMatrixXpr<Expr, T>& r)
+		{
+			evaluate(r.derived(), *this);
+		}
+
+	private:
+		T *m_data;
+		layout_type m_layout;
+
+	}; // end ref_matrix_rm
+
+LMAT_END_NAMESPACE
+
+#endif
@@ -30,8 +30,7 @@
 			check_arg(this->nrows() == m && this->ncolumns() == n, \
 					"Cannot change the size of an instance of class " #classname); }
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	template<class Derived>
 	class regular_mat_base
 	: public IRegularMatrix<Derived, typename matrix_traits<Derived>::value_type>
@@ -159,7 +158,7 @@ namespace lmat
 
 	};
 
-}
+LMAT_END_NAMESPACE
 
 
 
@@ -16,8 +16,7 @@
 #include <light_mat/matrix/ref_block.h>
 #include <light_mat/matrix/ref_grid.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	/********************************************
 	 *
@@ -122,6 +121,6 @@ namespace lmat
 		}
 	};
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* STEP_VECS_H_ */
@@ -15,7 +15,7 @@
 
 #include <light_mat/random/distr_fwd.h>
 
-namespace lmat { namespace random {
+LMAT_BEGIN_NAMESPACE namespace random {
 
 	class std_bernoulli_distr
 	{
@@ -84,7 +84,7 @@ namespace lmat { namespace random {
 		uint32_t m_thres;
 	};
 
-} }
+} LMAT_END_NAMESPACE
 
 
 #endif
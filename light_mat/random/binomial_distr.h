@@ -16,7 +16,7 @@
 #include <light_mat/random/bernoulli_distr.h>
 
 
-namespace lmat { namespace random {
+LMAT_BEGIN_NAMESPACE namespace random {
 
 
 	/********************************************
@@ -161,6 +161,6 @@ namespace lmat { namespace random {
 		impl_t m_impl;
 	};
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif 
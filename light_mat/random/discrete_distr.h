@@ -16,9 +16,10 @@
 #include <light_mat/random/uniform_real_distr.h>
 #include <light_mat/matrix/dense_matrix.h>
 #include <algorithm>
+#include <vector>
 
 
-namespace lmat { namespace random {
+LMAT_BEGIN_NAMESPACE namespace random {
 
 	/********************************************
 	 *
@@ -89,6 +90,191 @@ namespace lmat { namespace random {
 				return dd_draw(m_n, m_weights.ptr_data(), m_total, rs);
 			}
 
+			template<class RStream>
+			inline void fill(RStream& rs, index_t len, TI *dst) const
+			{
+				for (index_t i = 0; i < len; ++i) dst[i] = dd_draw(m_n, m_weights.ptr_data(), m_total, rs);
+			}
+
+			LMAT_ENSURE_INLINE
+			TI n() const
+			{
+				return m_n;
+			}
+
+			LMAT_ENSURE_INLINE
+			double p(TI x) const
+			{
+				return m_weights[(index_t)x] * m_inv_total;
+			}
+
+		private:
+			dense_col<double> m_weights;
+			double m_total;
+			double m_inv_total;
+			TI m_n;
+		};
+
+
+		/********************************************
+		 *
+		 *  alias method (Walker, with the
+		 *  construction of Vose)
+		 *
+		 *  Each draw takes two 32-bit units:
+		 *  one selects a bucket j = floor(u * n / 2^32),
+		 *  and the other (c) selects between j and
+		 *  its alias: j if c < thres[j], alias[j]
+		 *  otherwise.
+		 *
+		 ********************************************/
+
+		LMAT_ENSURE_INLINE
+		inline uint32_t alias_pick(uint32_t u, uint32_t c, uint32_t n, const uint32_t *thres, const uint32_t *alias)
+		{
+			const uint32_t j = (uint32_t)(((uint64_t)u * n) >> 32);
+			return c < thres[j] ? j : alias[j];
+		}
+
+		// the bucket floor(u * n / 2^32) for each 32-bit lane of u
+
+		LMAT_ENSURE_INLINE
+		inline __m128i alias_buckets(const __m128i u, const __m128i n)
+		{
+			const __m128i lo = _mm_srli_epi64(_mm_mul_epu32(u, n), 32);
+			const __m128i hi = _mm_mul_epu32(_mm_srli_epi64(u, 32), n);
+			return _mm_or_si128(lo, _mm_and_si128(hi, _mm_set_epi32(-1, 0, -1, 0)));
+		}
+
+#ifdef LMAT_HAS_AVX2
+		LMAT_ENSURE_INLINE
+		inline __m256i alias_buckets(const __m256i u, const __m256i n)
+		{
+			const __m256i lo = _mm256_srli_epi64(_mm256_mul_epu32(u, n), 32);
+			const __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(u, 32), n);
+			return _mm256_blend_epi32(lo, hi, 0xAA);
+		}
+#endif
+
+#ifdef LMAT_HAS_AVX512
+		LMAT_ENSURE_INLINE
+		inline __m512i alias_buckets(const __m512i u, const __m512i n)
+		{
+			const __m512i lo = _mm512_srli_epi64(_mm512_mul_epu32(u, n), 32);
+			const __m512i hi = _mm512_mul_epu32(_mm512_srli_epi64(u, 32), n);
+			return _mm512_mask_blend_epi32((__mmask16)0xAAAA, lo, hi);
+		}
+#endif
+
+		template<typename TI, class RStream>
+		inline void alias_fill(RStream& rs, index_t len, uint32_t n,
+				const uint32_t *thres, const uint32_t *alias, TI *dst)
+		{
+			for (index_t i = 0; i < len; ++i)
+			{
+				const uint64_t u = rs.rand_u64();
+				dst[i] = (TI)alias_pick((uint32_t)u, (uint32_t)(u >> 32), n, thres, alias);
+			}
+		}
+
+		// for 32-bit indices, a pack of buckets and a pack of coins
+		// are drawn at a time, and the tables are looked up with gathers
+		// (or with scalar loads when gathers are not available)
+
+		template<class RStream>
+		inline void alias_fill(RStream& rs, index_t len, uint32_t n,
+				const uint32_t *thres, const uint32_t *alias, uint32_t *dst)
+		{
+			index_t i = 0;
+
+#if defined(LMAT_HAS_AVX512)
+			const __m512i nv = _mm512_set1_epi32((int)n);
+
+			for (; i + 16 <= len; i += 16)
+			{
+				const __m512i j = alias_buckets(rs.rand_pack(avx512_t()), nv);
+				const __m512i c = rs.rand_pack(avx512_t());
+
+				const __m512i t = _mm512_i32gather_epi32(j, thres, 4);
+				const __m512i a = _mm512_i32gather_epi32(j, alias, 4);
+
+				const __mmask16 m = _mm512_cmplt_epu32_mask(c, t);
+				_mm512_storeu_si512(reinterpret_cast<void*>(dst + i), _mm512_mask_blend_epi32(m, a, j));
+			}
+
+#elif defined(LMAT_HAS_AVX2)
+			const __m256i nv = _mm256_set1_epi32((int)n);
+			const __m256i sgn = _mm256_set1_epi32((int)0x80000000);
+
+			for (; i + 8 <= len; i += 8)
+			{
+				const __m256i j = alias_buckets(rs.rand_pack(avx_t()), nv);
+				const __m256i c = rs.rand_pack(avx_t());
+
+				const __m256i t = _mm256_i32gather_epi32(reinterpret_cast<const int*>(thres), j, 4);
+				const __m256i a = _mm256_i32gather_epi32(reinterpret_cast<const int*>(alias), j, 4);
+
+				// unsigned c < t, by flipping the sign bits
+				const __m256i m = _mm256_cmpgt_epi32(_mm256_xor_si256(t, sgn), _mm256_xor_si256(c, sgn));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_blendv_epi8(a, j, m));
+			}
+
+#else
+			const __m128i nv = _mm_set1_epi32((int)n);
+			LMAT_ALIGN_SSE uint32_t jb[4];
+			LMAT_ALIGN_SSE uint32_t cb[4];
+
+			for (; i + 4 <= len; i += 4)
+			{
+				_mm_store_si128(reinterpret_cast<__m128i*>(jb), alias_buckets(rs.rand_pack(sse_t()), nv));
+				_mm_store_si128(reinterpret_cast<__m128i*>(cb), rs.rand_pack(sse_t()));
+
+				for (index_t k = 0; k < 4; ++k)
+				{
+					const uint32_t j = jb[k];
+					dst[i + k] = cb[k] < thres[j] ? j : alias[j];
+				}
+			}
+#endif
+
+			alias_fill<uint32_t>(rs, len - i, n, thres, alias, dst + i);
+		}
+
+
+		template<typename TI>
+		struct discrete_distr_impl<TI, alias_>
+		{
+		public:
+			template<typename InputIter>
+			explicit discrete_distr_impl(InputIter first, InputIter last)
+			: m_weights(), m_total(0.0), m_n(0)
+			{
+				for (InputIter it = first; it != last; ++it, ++m_n)
+					m_total += double(*it);
+
+				m_inv_total = 1.0 / m_total;
+
+				m_weights.require_size((index_t)m_n);
+				std::copy_n(first, (size_t)m_n, m_weights.ptr_data());
+
+				build_tables();
+			}
+
+			template<class RStream>
+			LMAT_ENSURE_INLINE
+			TI operator() (RStream& rs) const
+			{
+				const uint64_t u = rs.rand_u64();
+				return (TI)alias_pick((uint32_t)u, (uint32_t)(u >> 32), (uint32_t)m_n,
+						m_thres.ptr_data(), m_alias.ptr_data());
+			}
+
+			template<class RStream>
+			inline void fill(RStream& rs, index_t len, TI *dst) const
+			{
+				alias_fill(rs, len, (uint32_t)m_n, m_thres.ptr_data(), m_alias.ptr_data(), dst);
+			}
+
 			LMAT_ENSURE_INLINE
 			TI n() const
 			{
@@ -101,8 +287,175 @@ namespace lmat { namespace random {
 				return m_weights[(index_t)x] * m_inv_total;
 			}
 
+		private:
+			void build_tables()
+			{
+				const index_t n = (index_t)m_n;
+				m_thres.require_size(n);
+				m_alias.require_size(n);
+
+				// scaled probabilities, such that the average is 1
+
+				dense_col<double> q(n);
+				const double a = double(n) * m_inv_total;
+
+				std::vector<uint32_t> small, large;
+				for (index_t i = 0; i < n; ++i)
+				{
+					q[i] = m_weights[i] * a;
+					if (q[i] < 1.0)
+						small.push_back((uint32_t)i);
+					else
+						large.push_back((uint32_t)i);
+				}
+
+				// each small bucket is topped up by a large one
+
+				while (!small.empty() && !large.empty())
+				{
+					const uint32_t s = small.back();
+					small.pop_back();
+					const uint32_t l = large.back();
+
+					m_thres[s] = to_threshold(q[s]);
+					m_alias[s] = l;
+
+					q[l] = (q[l] + q[s]) - 1.0;
+					if (q[l] < 1.0)
+					{
+						large.pop_back();
+						small.push_back(l);
+					}
+				}
+
+				// the remaining buckets are full (up to rounding errors)
+
+				for (size_t k = 0; k < large.size(); ++k) set_full(large[k]);
+				for (size_t k = 0; k < small.size(); ++k) set_full(small[k]);
+			}
+
+			LMAT_ENSURE_INLINE
+			static uint32_t to_threshold(double q)  // q in [0, 1]
+			{
+				return q < 1.0 ? (uint32_t)(q * 4294967296.0) : 0xFFFFFFFFU;
+			}
+
+			LMAT_ENSURE_INLINE
+			void set_full(uint32_t i)
+			{
+				m_thres[(index_t)i] = 0xFFFFFFFFU;
+				m_alias[(index_t)i] = i;
+			}
+
 		private:
 			dense_col<double> m_weights;
+			dense_col<uint32_t> m_thres;
+			dense_col<uint32_t> m_alias;
+			double m_total;
+			double m_inv_total;
+			TI m_n;
+		};
+
+
+		/********************************************
+		 *
+		 *  guide table method (Chen & Asau)
+		 *
+		 *  The k-th guide entry is the smallest i
+		 *  with cdf[i] >= k * total / n, from which
+		 *  a draw starts its search. The expected
+		 *  number of comparisons is below two, and
+		 *  the results are the same as those of the
+		 *  naive method for the same stream.
+		 *
+		 ********************************************/
+
+		template<typename TI>
+		struct discrete_distr_impl<TI, guide_table_>
+		{
+		public:
+			template<typename InputIter>
+			explicit discrete_distr_impl(InputIter first, InputIter last)
+			: m_cdf(), m_total(0.0), m_n(0)
+			{
+				for (InputIter it = first; it != last; ++it, ++m_n)
+					m_total += double(*it);
+
+				m_inv_total = 1.0 / m_total;
+
+				// cumulative sums, in the same order as dd_draw
+
+				const index_t n = (index_t)m_n;
+				m_cdf.require_size(n);
+
+				double cw = 0.0;
+				index_t i = 0;
+				for (InputIter it = first; it != last; ++it, ++i)
+					m_cdf[i] = (cw += double(*it));
+
+				// guide entries
+
+				m_guide.require_size(n);
+
+				i = 0;
+				for (index_t k = 0; k < n; ++k)
+				{
+					const double t = m_total * (double(k) / double(n));
+					while (i < n - 1 && m_cdf[i] < t) ++i;
+					m_guide[k] = i;
+				}
+			}
+
+			template<class RStream>
+			LMAT_ENSURE_INLINE
+			TI operator() (RStream& rs) const
+			{
+				std_uniform_real_distr<double> ud;
+				return draw(ud(rs));
+			}
+
+			template<class RStream>
+			inline void fill(RStream& rs, index_t len, TI *dst) const
+			{
+				std_uniform_real_distr<double> ud;
+				for (index_t i = 0; i < len; ++i) dst[i] = draw(ud(rs));
+			}
+
+			LMAT_ENSURE_INLINE
+			TI n() const
+			{
+				return m_n;
+			}
+
+			LMAT_ENSURE_INLINE
+			double p(TI x) const
+			{
+				const index_t i = (index_t)x;
+				return (i > 0 ? m_cdf[i] - m_cdf[i-1] : m_cdf[0]) * m_inv_total;
+			}
+
+		private:
+			LMAT_ENSURE_INLINE
+			TI draw(double u) const  // u ~ [0, 1)
+			{
+				const index_t n = (index_t)m_n;
+				const double v = m_total * u;
+
+				index_t k = (index_t)(u * double(n));
+				if (k >= n) k = n - 1;
+
+				index_t i = m_guide[k];
+				while (v > m_cdf[i] && i < n - 1) ++i;
+
+				// guards against the rounding errors in the guide
+				while (i > 0 && v <= m_cdf[i-1]) --i;
+
+				return (TI)i;
+			}
+
+		private:
+			dense_col<double> m_cdf;
+			dense_col<index_t> m_guide;
 			double m_total;
 			double m_inv_total;
 			TI m_n;
@@ -145,11 +498,50 @@ namespace lmat { namespace random {
 			return m_impl(rs);
 		}
 
+		// draws len indices to dst (vectorized by the alias method)
+
+		template<class RStream>
+		LMAT_ENSURE_INLINE
+		void fill(RStream& rs, index_t len, TI *dst) const
+		{
+			m_impl.fill(rs, len, dst);
+		}
+
 	private:
 		impl_t m_impl;
 	};
 
 
-} }
+	/********************************************
+	 *
+	 *  batch sampling to a matrix
+	 *
+	 ********************************************/
+
+	template<typename TI, typename Method, class RStream, class DMat>
+	inline void rand_fill(const discrete_distr<TI, Method>& distr, RStream& rs, IRegularMatrix<DMat, TI>& dst)
+	{
+		const index_t m = dst.nrows();
+		const index_t n = dst.ncolumns();
+
+		if (dst.is_contiguous())
+		{
+			distr.fill(rs, m * n, dst.ptr_data());
+		}
+		else if (dst.is_percol_contiguous())
+		{
+			for (index_t j = 0; j < n; ++j)
+				distr.fill(rs, m, dst.ptr_col(j));
+		}
+		else
+		{
+			for (index_t j = 0; j < n; ++j)
+				for (index_t i = 0; i < m; ++i)
+					dst(i, j) = distr(rs);
+		}
+	}
+
+
+} LMAT_END_NAMESPACE
 
 #endif
@@ -17,7 +17,7 @@
 #include <light_mat/math/math_base.h>
 #include <light_mat/math/functor_base.h>
 
-namespace lmat { namespace random {
+LMAT_BEGIN_NAMESPACE namespace random {
 
 
 	// tags to indicate PRNG methods
@@ -29,6 +29,8 @@ namespace lmat { namespace random {
 	struct marsaglia_ { };
 	struct ziggurat_ { };
 	struct huffman_ { };
+	struct alias_ { };
+	struct guide_table_ { };
 
 	// discrete distributions
 
@@ -50,8 +52,8 @@ namespace lmat { namespace random {
 	template<typename T=double> class std_uniform_real_distr;
 	template<typename T=double> class uniform_real_distr;
 
-	template<typename T=double> class std_exponential_distr;
-	template<typename T=double> class exponential_distr;
+	template<typename T=double, typename Method=icdf_> class std_exponential_distr;
+	template<typename T=double, typename Method=icdf_> class exponential_distr;
 
 	template<typename T=double, typename Method=icdf_> class std_normal_distr;
 	template<typename T=double, typename Method=icdf_> class normal_distr;
@@ -60,6 +62,6 @@ namespace lmat { namespace random {
 	template<typename T=double, typename Method=basic_> class gamma_distr;
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif
@@ -15,12 +15,63 @@
 
 #include <light_mat/random/uniform_real_distr.h>
 #include <light_mat/math/simd_math.h>
+#include "internal/ziggurat_internal.h"
+
+LMAT_BEGIN_NAMESPACE namespace random {
+
+	// implementation
+
+	namespace internal
+	{
+		template<typename T, typename Method>
+		struct std_exponential_distr_impl;
+
+		template<typename T>
+		struct std_exponential_distr_impl<T, icdf_>
+		{
+			template<class RStream>
+			LMAT_ENSURE_INLINE
+			T operator() (RStream& rs) const
+			{
+				return - math::log(rand_real<T>::o0c1(rs));
+			}
+
+			template<class RStream>
+			inline void fill(RStream& rs, index_t len, T *dst) const
+			{
+				for (index_t i = 0; i < len; ++i) dst[i] = - math::log(rand_real<T>::o0c1(rs));
+			}
+		};
+
+		template<typename T>
+		struct std_exponential_distr_impl<T, ziggurat_>
+		{
+			const zig_table<T, zig_exponential> *m_tab;
+
+			LMAT_ENSURE_INLINE
+			std_exponential_distr_impl()
+			: m_tab(&zig_table<T, zig_exponential>::get())
+			{ }
+
+			template<class RStream>
+			LMAT_ENSURE_INLINE
+			T operator() (RStream& rs) const
+			{
+				return zig_draw(*m_tab, rs);
+			}
+
+			template<class RStream>
+			inline void fill(RStream& rs, index_t len, T *dst) const
+			{
+				zig_simd<T, default_simd_kind, zig_exponential>().fill(rs, len, dst);
+			}
+		};
+	}
 
-namespace lmat { namespace random {
 
 	// classes
 
-	template<typename T>
+	template<typename T, typename Method>
 	class std_exponential_distr
 	{
 	public:
@@ -54,12 +105,22 @@ namespace lmat { namespace random {
 		LMAT_ENSURE_INLINE
 		T operator() (RStream& rs) const
 		{
-			return - math::log(rand_real<T>::o0c1(rs));
+			return m_impl(rs);
 		}
+
+		template<class RStream>
+		LMAT_ENSURE_INLINE
+		void fill(RStream& rs, index_t len, T *dst) const
+		{
+			m_impl.fill(rs, len, dst);
+		}
+
+	private:
+		internal::std_exponential_distr_impl<T, Method> m_impl;
 	};
 
 
-	template<typename T>
+	template<typename T, typename Method>
 	class exponential_distr
 	{
 	public:
@@ -98,12 +159,20 @@ namespace lmat { namespace random {
 		LMAT_ENSURE_INLINE
 		T operator() (RStream& rs) const
 		{
-			return (-m_beta) * math::log(rand_real<T>::o0c1(rs));
+			return m_beta * m_impl(rs);
+		}
+
+		template<class RStream>
+		inline void fill(RStream& rs, index_t len, T *dst) const
+		{
+			m_impl.fill(rs, len, dst);
+			for (index_t i = 0; i < len; ++i) dst[i] *= m_beta;
 		}
 
 	private:
 		T m_lambda;
 		T m_beta;
+		internal::std_exponential_distr_impl<T, Method> m_impl;
 	};
 
 
@@ -146,45 +215,118 @@ namespace lmat { namespace random {
 		T m_neg_beta;
 	};
 
-} }
+
+	template<typename T, typename Kind>
+	class std_exponential_distr_zig_simd
+	{
+	public:
+		typedef simd_pack<T, Kind> result_type;
+
+		template<class RStream>
+		LMAT_ENSURE_INLINE
+		result_type operator() (RStream& rs) const
+		{
+			return m_gen(rs);
+		}
+
+	private:
+		internal::zig_simd<T, Kind, internal::zig_exponential> m_gen;
+	};
+
+
+	template<typename T, typename Kind>
+	class exponential_distr_zig_simd
+	{
+	public:
+		typedef simd_pack<T, Kind> result_type;
+
+		LMAT_ENSURE_INLINE
+		explicit exponential_distr_zig_simd(const T& beta)
+		: m_beta(beta)
+		{ }
+
+		template<class RStream>
+		LMAT_ENSURE_INLINE
+		result_type operator() (RStream& rs) const
+		{
+			return m_beta * m_gen(rs);
+		}
+
+	private:
+		internal::zig_simd<T, Kind, internal::zig_exponential> m_gen;
+		result_type m_beta;
+	};
+
+} LMAT_END_NAMESPACE
 
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	template<typename T, typename Kind>
-	struct is_simdizable<random::std_exponential_distr<T>, Kind>
+	struct is_simdizable<random::std_exponential_distr<T, random::icdf_>, Kind>
 	: public meta::has_simd_support<ftags::log_, T, Kind> { };
 
 	template<typename T, typename Kind>
-	struct is_simdizable<random::exponential_distr<T>, Kind>
+	struct is_simdizable<random::exponential_distr<T, random::icdf_>, Kind>
 	: public meta::has_simd_support<ftags::log_, T, Kind> { };
 
 	template<typename T, typename Kind>
-	struct simdize_map< random::std_exponential_distr<T>, Kind >
+	struct is_simdizable<random::std_exponential_distr<T, random::ziggurat_>, Kind>
+	: public meta::true_ { };
+
+	template<typename T, typename Kind>
+	struct is_simdizable<random::exponential_distr<T, random::ziggurat_>, Kind>
+	: public meta::true_ { };
+
+	template<typename T, typename Kind>
+	struct simdize_map< random::std_exponential_distr<T, random::icdf_>, Kind >
 	{
 		typedef random::std_exponential_distr_simd<T, Kind> type;
 
 		LMAT_ENSURE_INLINE
-		static type get(const random::std_exponential_distr<T>& s)
+		static type get(const random::std_exponential_distr<T, random::icdf_>& s)
 		{
 			return type();
 		}
 	};
 
 	template<typename T, typename Kind>
-	struct simdize_map< random::exponential_distr<T>, Kind >
+	struct simdize_map< random::exponential_distr<T, random::icdf_>, Kind >
 	{
 		typedef random::exponential_distr_simd<T, Kind> type;
 
 		LMAT_ENSURE_INLINE
-		static type get(const random::exponential_distr<T>& s)
+		static type get(const random::exponential_distr<T, random::icdf_>& s)
+		{
+			return type(s.beta());
+		}
+	};
+
+	template<typename T, typename Kind>
+	struct simdize_map< random::std_exponential_distr<T, random::ziggurat_>, Kind >
+	{
+		typedef random::std_exponential_distr_zig_simd<T, Kind> type;
+
+		LMAT_ENSURE_INLINE
+		static type get(const random::std_exponential_distr<T, random::ziggurat_>& s)
+		{
+			return type();
+		}
+	};
+
+	template<typename T, typename Kind>
+	struct simdize_map< random::exponential_distr<T, random::ziggurat_>, Kind >
+	{
+		typedef random::exponential_distr_zig_simd<T, Kind> type;
+
+		LMAT_ENSURE_INLINE
+		static type get(const random::exponential_distr<T, random::ziggurat_>& s)
 		{
 			return type(s.beta());
 		}
 	};
 
-}
+LMAT_END_NAMESPACE
 
 
 #endif
@@ -15,7 +15,7 @@
 
 #include "internal/gamma_distr_internal.h"
 
-namespace lmat { namespace random {
+LMAT_BEGIN_NAMESPACE namespace random {
 
 	// classes
 
@@ -111,7 +111,7 @@ namespace lmat { namespace random {
 		T m_beta;
 	};
 
-} }
+} LMAT_END_NAMESPACE
 
 
 #endif
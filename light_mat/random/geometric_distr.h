@@ -15,7 +15,7 @@
 
 #include <light_mat/random/bernoulli_distr.h>
 
-namespace lmat { namespace random {
+LMAT_BEGIN_NAMESPACE namespace random {
 
 	/********************************************
 	 *
@@ -118,6 +118,6 @@ namespace lmat { namespace random {
 	};
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif 
@@ -18,7 +18,7 @@
 #include <light_mat/math/math.h>
 
 
-namespace lmat { namespace random { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace random { namespace internal {
 
 	template<typename T, typename Method>
 	struct std_gamma_distr_impl;
@@ -136,6 +136,6 @@ namespace lmat { namespace random { namespace internal {
 	};
 
 
-} } }
+} } LMAT_END_NAMESPACE
 
 #endif
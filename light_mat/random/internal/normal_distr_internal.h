@@ -16,9 +16,10 @@
 #include <light_mat/random/uniform_real_distr.h>
 #include <light_mat/math/math_special.h>
 #include <light_mat/math/simd_math.h>
+#include "ziggurat_internal.h"
 
 
-namespace lmat { namespace random { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace random { namespace internal {
 
 	// forward declarations
 
@@ -52,6 +53,12 @@ namespace lmat { namespace random { namespace internal {
 		{
 			return math::norminv(rand_real<T>::o0c1(rs));
 		}
+
+		template<class RStream>
+		inline void fill(RStream& rs, index_t len, T *dst) const
+		{
+			for (index_t i = 0; i < len; ++i) dst[i] = math::norminv(rand_real<T>::o0c1(rs));
+		}
 	};
 
 	template<typename T>
@@ -85,9 +92,126 @@ namespace lmat { namespace random { namespace internal {
 		{
 			return m_mu + math::norminv(rand_real<T>::o0c1(rs)) * m_sigma;
 		}
+
+		template<class RStream>
+		inline void fill(RStream& rs, index_t len, T *dst) const
+		{
+			for (index_t i = 0; i < len; ++i) dst[i] = (*this)(rs);
+		}
+	};
+
+
+	/********************************************
+	 *
+	 *  Ziggurat implementation
+	 *
+	 ********************************************/
+
+	template<typename T>
+	struct std_normal_distr_impl<T, ziggurat_>
+	{
+		typedef T result_type;
+
+		const zig_table<T, zig_normal> *m_tab;
+
+		LMAT_ENSURE_INLINE
+		std_normal_distr_impl()
+		: m_tab(&zig_table<T, zig_normal>::get())
+		{ }
+
+		template<class RStream>
+		LMAT_ENSURE_INLINE
+		T operator() (RStream& rs) const
+		{
+			return zig_draw(*m_tab, rs);
+		}
+
+		template<class RStream>
+		inline void fill(RStream& rs, index_t len, T *dst) const
+		{
+			zig_simd<T, default_simd_kind, zig_normal>().fill(rs, len, dst);
+		}
+	};
+
+	template<typename T>
+	struct normal_distr_impl<T, ziggurat_>
+	{
+		typedef T result_type;
+
+		const zig_table<T, zig_normal> *m_tab;
+		T m_mu;
+		T m_sigma;
+
+		LMAT_ENSURE_INLINE
+		explicit normal_distr_impl(const T& mu, const T& sigma)
+		: m_tab(&zig_table<T, zig_normal>::get()), m_mu(mu), m_sigma(sigma)
+		{ }
+
+		LMAT_ENSURE_INLINE
+		T mean() const
+		{
+			return m_mu;
+		}
+
+		LMAT_ENSURE_INLINE
+		T stddev() const
+		{
+			return m_sigma;
+		}
+
+		template<class RStream>
+		LMAT_ENSURE_INLINE
+		T operator() (RStream& rs) const
+		{
+			return m_mu + zig_draw(*m_tab, rs) * m_sigma;
+		}
+
+		template<class RStream>
+		inline void fill(RStream& rs, index_t len, T *dst) const
+		{
+			zig_simd<T, default_simd_kind, zig_normal>().fill(rs, len, dst);
+			for (index_t i = 0; i < len; ++i) dst[i] = m_mu + dst[i] * m_sigma;
+		}
+	};
+
+	template<typename T, typename Kind>
+	struct std_normal_distr_simd_impl<T, Kind, ziggurat_>
+	{
+		typedef simd_pack<T, Kind> result_type;
+
+		zig_simd<T, Kind, zig_normal> m_gen;
+
+		template<class RStream>
+		LMAT_ENSURE_INLINE
+		result_type operator() (RStream& rs) const
+		{
+			return m_gen(rs);
+		}
+	};
+
+	template<typename T, typename Kind>
+	struct normal_distr_simd_impl<T, Kind, ziggurat_>
+	{
+		typedef simd_pack<T, Kind> result_type;
+
+		zig_simd<T, Kind, zig_normal> m_gen;
+		result_type m_mu;
+		result_type m_sigma;
+
+		LMAT_ENSURE_INLINE
+		explicit normal_distr_simd_impl(const T& mu, const T& sigma)
+		: m_mu(mu), m_sigma(sigma)
+		{ }
+
+		template<class RStream>
+		LMAT_ENSURE_INLINE
+		result_type operator() (RStream& rs) const
+		{
+			return m_mu + m_gen(rs) * m_sigma;
+		}
 	};
 
 
-} } }
+} } LMAT_END_NAMESPACE
 
 #endif
@@ -0,0 +1,270 @@
+/**
+ * @file philox_internal.h
+ *
+ * @brief Internal implementation of the Philox4x32-10 generator
+ *
+ * The generator follows
+ *
+ *   J. K. Salmon, M. A. Moraes, R. O. Dror, and D. E. Shaw.
+ *   Parallel random numbers: as easy as 1, 2, 3. SC 2011.
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_PHILOX_INTERNAL_H_
+#define LIGHTMAT_PHILOX_INTERNAL_H_
+
+#include <light_mat/common/basic_defs.h>
+#include <light_mat/simd/simd_base.h>
+
+LMAT_BEGIN_NAMESPACE namespace random { namespace internal {
+
+	struct philox_consts
+	{
+		static const uint32_t M0 = 0xD2511F53U;
+		static const uint32_t M1 = 0xCD9E8D57U;
+		static const uint32_t W0 = 0x9E3779B9U;	// golden ratio
+		static const uint32_t W1 = 0xBB67AE85U;	// sqrt(3) - 1
+		static const unsigned int nrounds = 10;
+	};
+
+
+	/********************************************
+	 *
+	 *  scalar version (one block)
+	 *
+	 ********************************************/
+
+	LMAT_ENSURE_INLINE
+	inline void philox4x32_round(uint32_t *x, uint32_t k0, uint32_t k1)
+	{
+		const uint64_t p0 = (uint64_t)philox_consts::M0 * x[0];
+		const uint64_t p1 = (uint64_t)philox_consts::M1 * x[2];
+
+		const uint32_t y0 = (uint32_t)(p1 >> 32) ^ x[1] ^ k0;
+		const uint32_t y2 = (uint32_t)(p0 >> 32) ^ x[3] ^ k1;
+
+		x[0] = y0;
+		x[1] = (uint32_t)p1;
+		x[2] = y2;
+		x[3] = (uint32_t)p0;
+	}
+
+	// transforms a counter x (of four words) in place with key (k0, k1)
+
+	inline void philox4x32_10(uint32_t *x, uint32_t k0, uint32_t k1)
+	{
+		philox4x32_round(x, k0, k1);
+		for (unsigned int r = 1; r < philox_consts::nrounds; ++r)
+		{
+			k0 += philox_consts::W0;
+			k1 += philox_consts::W1;
+			philox4x32_round(x, k0, k1);
+		}
+	}
+
+
+	/********************************************
+	 *
+	 *  SIMD versions (several blocks at once)
+	 *
+	 *  The words of the blocks are held in four
+	 *  vectors (one per word), and are written
+	 *  out block by block at the end.
+	 *
+	 ********************************************/
+
+	struct philox_sse2
+	{
+		typedef __m128i vec_t;
+		static const unsigned int nblocks = 4;
+
+		LMAT_ENSURE_INLINE static vec_t load(const uint32_t *p) { return _mm_load_si128(reinterpret_cast<const __m128i*>(p)); }
+		LMAT_ENSURE_INLINE static vec_t set1(uint32_t v) { return _mm_set1_epi32((int)v); }
+		LMAT_ENSURE_INLINE static vec_t mul_evens(vec_t a, vec_t b) { return _mm_mul_epu32(a, b); }
+		LMAT_ENSURE_INLINE static vec_t shr32(vec_t a) { return _mm_srli_epi64(a, 32); }
+		LMAT_ENSURE_INLINE static vec_t shl32(vec_t a) { return _mm_slli_epi64(a, 32); }
+		LMAT_ENSURE_INLINE static vec_t bit_and(vec_t a, vec_t b) { return _mm_and_si128(a, b); }
+		LMAT_ENSURE_INLINE static vec_t bit_andnot(vec_t a, vec_t b) { return _mm_andnot_si128(a, b); }
+		LMAT_ENSURE_INLINE static vec_t bit_or(vec_t a, vec_t b) { return _mm_or_si128(a, b); }
+		LMAT_ENSURE_INLINE static vec_t bit_xor(vec_t a, vec_t b) { return _mm_xor_si128(a, b); }
+		LMAT_ENSURE_INLINE static vec_t lo_mask() { return _mm_set1_epi64x(0xFFFFFFFFLL); }
+
+		LMAT_ENSURE_INLINE
+		static void store_blocks(uint32_t *dst, vec_t c0, vec_t c1, vec_t c2, vec_t c3)
+		{
+			__m128i t0 = _mm_unpacklo_epi32(c0, c1);
+			__m128i t1 = _mm_unpacklo_epi32(c2, c3);
+			__m128i t2 = _mm_unpackhi_epi32(c0, c1);
+			__m128i t3 = _mm_unpackhi_epi32(c2, c3);
+
+			__m128i* pd = reinterpret_cast<__m128i*>(dst);
+			_mm_store_si128(pd,     _mm_unpacklo_epi64(t0, t1));
+			_mm_store_si128(pd + 1, _mm_unpackhi_epi64(t0, t1));
+			_mm_store_si128(pd + 2, _mm_unpacklo_epi64(t2, t3));
+			_mm_store_si128(pd + 3, _mm_unpackhi_epi64(t2, t3));
+		}
+	};
+
+#ifdef LMAT_HAS_AVX2
+
+	struct philox_avx2
+	{
+		typedef __m256i vec_t;
+		static const unsigned int nblocks = 8;
+
+		LMAT_ENSURE_INLINE static vec_t load(const uint32_t *p) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+		LMAT_ENSURE_INLINE static vec_t set1(uint32_t v) { return _mm256_set1_epi32((int)v); }
+		LMAT_ENSURE_INLINE static vec_t mul_evens(vec_t a, vec_t b) { return _mm256_mul_epu32(a, b); }
+		LMAT_ENSURE_INLINE static vec_t shr32(vec_t a) { return _mm256_srli_epi64(a, 32); }
+		LMAT_ENSURE_INLINE static vec_t shl32(vec_t a) { return _mm256_slli_epi64(a, 32); }
+		LMAT_ENSURE_INLINE static vec_t bit_and(vec_t a, vec_t b) { return _mm256_and_si256(a, b); }
+		LMAT_ENSURE_INLINE static vec_t bit_andnot(vec_t a, vec_t b) { return _mm256_andnot_si256(a, b); }
+		LMAT_ENSURE_INLINE static vec_t bit_or(vec_t a, vec_t b) { return _mm256_or_si256(a, b); }
+		LMAT_ENSURE_INLINE static vec_t bit_xor(vec_t a, vec_t b) { return _mm256_xor_si256(a, b); }
+		LMAT_ENSURE_INLINE static vec_t lo_mask() { return _mm256_set1_epi64x(0xFFFFFFFFLL); }
+
+		LMAT_ENSURE_INLINE
+		static void store_blocks(uint32_t *dst, vec_t c0, vec_t c1, vec_t c2, vec_t c3)
+		{
+			// within each 128-bit lane, as in the SSE version
+
+			__m256i t0 = _mm256_unpacklo_epi32(c0, c1);
+			__m256i t1 = _mm256_unpacklo_epi32(c2, c3);
+			__m256i t2 = _mm256_unpackhi_epi32(c0, c1);
+			__m256i t3 = _mm256_unpackhi_epi32(c2, c3);
+
+			__m256i r0 = _mm256_unpacklo_epi64(t0, t1);  // blocks 0, 4
+			__m256i r1 = _mm256_unpackhi_epi64(t0, t1);  // blocks 1, 5
+			__m256i r2 = _mm256_unpacklo_epi64(t2, t3);  // blocks 2, 6
+			__m256i r3 = _mm256_unpackhi_epi64(t2, t3);  // blocks 3, 7
+
+			__m256i* pd = reinterpret_cast<__m256i*>(dst);
+			_mm256_store_si256(pd,     _mm256_permute2x128_si256(r0, r1, 0x20));
+			_mm256_store_si256(pd + 1, _mm256_permute2x128_si256(r2, r3, 0x20));
+			_mm256_store_si256(pd + 2, _mm256_permute2x128_si256(r0, r1, 0x31));
+			_mm256_store_si256(pd + 3, _mm256_permute2x128_si256(r2, r3, 0x31));
+		}
+	};
+
+#endif
+
+#ifdef LMAT_HAS_AVX512
+
+	struct philox_avx512
+	{
+		typedef __m512i vec_t;
+		static const unsigned int nblocks = 16;
+
+		LMAT_ENSURE_INLINE static vec_t load(const uint32_t *p) { return _mm512_load_si512(reinterpret_cast<const void*>(p)); }
+		LMAT_ENSURE_INLINE static vec_t set1(uint32_t v) { return _mm512_set1_epi32((int)v); }
+		LMAT_ENSURE_INLINE static vec_t mul_evens(vec_t a, vec_t b) { return _mm512_mul_epu32(a, b); }
+		LMAT_ENSURE_INLINE static vec_t shr32(vec_t a) { return _mm512_srli_epi64(a, 32); }
+		LMAT_ENSURE_INLINE static vec_t shl32(vec_t a) { return _mm512_slli_epi64(a, 32); }
+		LMAT_ENSURE_INLINE static vec_t bit_and(vec_t a, vec_t b) { return _mm512_and_si512(a, b); }
+		LMAT_ENSURE_INLINE static vec_t bit_andnot(vec_t a, vec_t b) { return _mm512_andnot_si512(a, b); }
+		LMAT_ENSURE_INLINE static vec_t bit_or(vec_t a, vec_t b) { return _mm512_or_si512(a, b); }
+		LMAT_ENSURE_INLINE static vec_t bit_xor(vec_t a, vec_t b) { return _mm512_xor_si512(a, b); }
+		LMAT_ENSURE_INLINE static vec_t lo_mask() { return _mm512_set1_epi64(0xFFFFFFFFLL); }
+
+		LMAT_ENSURE_INLINE
+		static void store_blocks(uint32_t *dst, vec_t c0, vec_t c1, vec_t c2, vec_t c3)
+		{
+			__m512i t0 = _mm512_unpacklo_epi32(c0, c1);
+			__m512i t1 = _mm512_unpacklo_epi32(c2, c3);
+			__m512i t2 = _mm512_unpackhi_epi32(c0, c1);
+			__m512i t3 = _mm512_unpackhi_epi32(c2, c3);
+
+			__m512i r0 = _mm512_unpacklo_epi64(t0, t1);  // blocks 0, 4, 8, 12
+			__m512i r1 = _mm512_unpackhi_epi64(t0, t1);  // blocks 1, 5, 9, 13
+			__m512i r2 = _mm512_unpacklo_epi64(t2, t3);  // blocks 2, 6, 10, 14
+			__m512i r3 = _mm512_unpackhi_epi64(t2, t3);  // blocks 3, 7, 11, 15
+
+			__m128i* pd = reinterpret_cast<__m128i*>(dst);
+
+#define LMAT_PHILOX_STORE_LANE(L) \
+			_mm_store_si128(pd + 4 * L,     _mm512_extracti32x4_epi32(r0, L)); \
+			_mm_store_si128(pd + 4 * L + 1, _mm512_extracti32x4_epi32(r1, L)); \
+			_mm_store_si128(pd + 4 * L + 2, _mm512_extracti32x4_epi32(r2, L)); \
+			_mm_store_si128(pd + 4 * L + 3, _mm512_extracti32x4_epi32(r3, L));
+
+			LMAT_PHILOX_STORE_LANE(0)
+			LMAT_PHILOX_STORE_LANE(1)
+			LMAT_PHILOX_STORE_LANE(2)
+			LMAT_PHILOX_STORE_LANE(3)
+
+#undef LMAT_PHILOX_STORE_LANE
+		}
+	};
+
+#endif
+
+#if defined(LMAT_HAS_AVX512)
+	typedef philox_avx512 philox_default_simd;
+#elif defined(LMAT_HAS_AVX2)
+	typedef philox_avx2 philox_default_simd;
+#else
+	typedef philox_sse2 philox_default_simd;
+#endif
+
+
+	template<class V>
+	LMAT_ENSURE_INLINE
+	inline void philox_mulhilo(typename V::vec_t a, typename V::vec_t m, typename V::vec_t lmsk,
+			typename V::vec_t& lo, typename V::vec_t& hi)
+	{
+		typedef typename V::vec_t vec_t;
+
+		// 64-bit products of the even and odd words respectively
+		vec_t pe = V::mul_evens(a, m);
+		vec_t po = V::mul_evens(V::shr32(a), m);
+
+		lo = V::bit_or(V::bit_and(pe, lmsk), V::shl32(po));
+		hi = V::bit_or(V::shr32(pe), V::bit_andnot(lmsk, po));
+	}
+
+	// generates V::nblocks blocks for the counters (clo[b], chi[b], s0, s1)
+
+	template<class V>
+	inline void philox4x32_10_blocks(uint32_t *dst, const uint32_t *clo, const uint32_t *chi,
+			uint32_t s0, uint32_t s1, uint32_t k0, uint32_t k1)
+	{
+		typedef typename V::vec_t vec_t;
+
+		const vec_t m0 = V::set1(philox_consts::M0);
+		const vec_t m1 = V::set1(philox_consts::M1);
+		const vec_t lmsk = V::lo_mask();
+
+		vec_t c0 = V::load(clo);
+		vec_t c1 = V::load(chi);
+		vec_t c2 = V::set1(s0);
+		vec_t c3 = V::set1(s1);
+
+		for (unsigned int r = 0; r < philox_consts::nrounds; ++r)
+		{
+			if (r > 0)
+			{
+				k0 += philox_consts::W0;
+				k1 += philox_consts::W1;
+			}
+
+			vec_t lo0, hi0, lo1, hi1;
+			philox_mulhilo<V>(c0, m0, lmsk, lo0, hi0);
+			philox_mulhilo<V>(c2, m1, lmsk, lo1, hi1);
+
+			c0 = V::bit_xor(V::bit_xor(hi1, c1), V::set1(k0));
+			c1 = lo1;
+			c2 = V::bit_xor(V::bit_xor(hi0, c3), V::set1(k1));
+			c3 = lo0;
+		}
+
+		V::store_blocks(dst, c0, c1, c2, c3);
+	}
+
+} } LMAT_END_NAMESPACE
+
+#endif /* PHILOX_INTERNAL_H_ */
@@ -16,7 +16,7 @@
 #include <light_mat/random/rand_stream.h>
 #include <cstring>
 
-namespace lmat { namespace random { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace random { namespace internal {
 
 	template<class State, typename T>
 	void gen_rand_seq(State& s, stream_tracker<T>& trk, void *buf, size_t nbytes)
@@ -71,6 +71,6 @@ namespace lmat { namespace random { namespace internal {
 		}
 	}
 
-} } }
+} } LMAT_END_NAMESPACE
 
 #endif /* RAND_STREAM_INTERNAL_H_ */
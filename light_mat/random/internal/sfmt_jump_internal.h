@@ -0,0 +1,220 @@
+/**
+ * @file sfmt_jump_internal.h
+ *
+ * @brief Polynomial arithmetics over GF(2) for SFMT jump-ahead
+ *
+ * The jump-ahead follows
+ *
+ *   H. Haramoto, M. Matsumoto, T. Nishimura, F. Panneton, and P. L'Ecuyer.
+ *   Efficient jump ahead for F2-linear random number generators.
+ *   INFORMS Journal on Computing, 2008.
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_SFMT_JUMP_INTERNAL_H_
+#define LIGHTMAT_SFMT_JUMP_INTERNAL_H_
+
+#include <light_mat/common/prim_types.h>
+#include <vector>
+
+LMAT_BEGIN_NAMESPACE namespace random { namespace internal {
+
+	// a polynomial over GF(2), where bit i is the coefficient of x^i
+
+	typedef std::vector<uint64_t> gf2_poly;
+
+	LMAT_ENSURE_INLINE
+	inline bool gf2_bit(const gf2_poly& a, size_t i)
+	{
+		return ((a[i >> 6] >> (i & 63)) & 1) != 0;
+	}
+
+	LMAT_ENSURE_INLINE
+	inline void gf2_flip(gf2_poly& a, size_t i)
+	{
+		a[i >> 6] ^= (uint64_t(1) << (i & 63));
+	}
+
+	// a += b * x^s (a must be long enough)
+
+	inline void gf2_add_shifted(uint64_t *a, const uint64_t *b, size_t nb, size_t s)
+	{
+		const size_t ws = s >> 6;
+		const unsigned int bs = (unsigned int)(s & 63);
+
+		if (bs == 0)
+		{
+			for (size_t i = 0; i < nb; ++i) a[ws + i] ^= b[i];
+		}
+		else
+		{
+			for (size_t i = 0; i < nb; ++i)
+			{
+				a[ws + i] ^= (b[i] << bs);
+				a[ws + i + 1] ^= (b[i] >> (64 - bs));
+			}
+		}
+	}
+
+	// the parity of sum_j a_j * b_{s+j}, for j = 0, ..., na_bits - 1
+
+	inline unsigned int gf2_dot_shifted(const uint64_t *a, size_t na_bits, const uint64_t *b, size_t s)
+	{
+		const size_t ws = s >> 6;
+		const unsigned int bs = (unsigned int)(s & 63);
+		const size_t nw = (na_bits + 63) >> 6;
+
+		uint64_t r = 0;
+		for (size_t i = 0; i < nw; ++i)
+		{
+			uint64_t bw = b[ws + i] >> bs;
+			if (bs) bw |= (b[ws + i + 1] << (64 - bs));
+			r ^= (a[i] & bw);
+		}
+
+		r ^= r >> 32;
+		r ^= r >> 16;
+		r ^= r >> 8;
+		r ^= r >> 4;
+		r ^= r >> 2;
+		r ^= r >> 1;
+		return (unsigned int)(r & 1);
+	}
+
+
+	/**
+	 * Computes the minimal polynomial of a binary sequence s of length n
+	 * (with the Berlekamp-Massey algorithm), where bit i of s is s_i.
+	 *
+	 * Returns phi, such that sum_j phi_j s_{t+j} = 0 for all t.
+	 */
+	inline gf2_poly gf2_minpoly(const gf2_poly& s, size_t n)
+	{
+		// reversed sequence, such that the discrepancy is a dot product
+
+		const size_t nw = (n >> 6) + 4;
+		gf2_poly r(nw, 0);
+		for (size_t i = 0; i < n; ++i)
+		{
+			if (gf2_bit(s, i)) gf2_flip(r, n - 1 - i);
+		}
+
+		// connection polynomials C and B: C(x) = 1 + c_1 x + ... + c_L x^L,
+		// with deg(B) <= Lb
+
+		gf2_poly c(nw, 0), b(nw, 0), t;
+		c[0] = b[0] = 1;
+		size_t L = 0;
+		size_t Lb = 0;
+		size_t m = 1;
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			const unsigned int d = gf2_dot_shifted(&c[0], L + 1, &r[0], n - 1 - i);
+
+			if (d == 0)
+			{
+				++m;
+			}
+			else if (2 * L <= i)
+			{
+				t = c;
+				gf2_add_shifted(&c[0], &b[0], (Lb >> 6) + 1, m);
+				Lb = L;
+				L = i + 1 - L;
+				b.swap(t);
+				m = 1;
+			}
+			else
+			{
+				gf2_add_shifted(&c[0], &b[0], (Lb >> 6) + 1, m);
+				++m;
+			}
+		}
+
+		// phi is the reciprocal of C
+
+		gf2_poly phi((L >> 6) + 1, 0);
+		for (size_t j = 0; j <= L; ++j)
+		{
+			if (gf2_bit(c, j)) gf2_flip(phi, L - j);
+		}
+		return phi;
+	}
+
+	inline size_t gf2_degree(const gf2_poly& a)
+	{
+		size_t i = a.size();
+		while (i > 0 && a[i - 1] == 0) --i;
+		if (i == 0) return 0;
+
+		uint64_t w = a[i - 1];
+		size_t d = (i - 1) << 6;
+		while (w >>= 1) ++d;
+		return d;
+	}
+
+	// spreads the 32 bits of x to the even bits of the result
+
+	LMAT_ENSURE_INLINE
+	inline uint64_t gf2_spread32(uint32_t x)
+	{
+		uint64_t v = x;
+		v = (v | (v << 16)) & 0x0000FFFF0000FFFFULL;
+		v = (v | (v << 8))  & 0x00FF00FF00FF00FFULL;
+		v = (v | (v << 4))  & 0x0F0F0F0F0F0F0F0FULL;
+		v = (v | (v << 2))  & 0x3333333333333333ULL;
+		v = (v | (v << 1))  & 0x5555555555555555ULL;
+		return v;
+	}
+
+	// a <- a^2 mod phi, where deg(a) < deg(phi) = d
+
+	inline void gf2_sqrmod(gf2_poly& a, const gf2_poly& phi, size_t d)
+	{
+		const size_t na = (d >> 6) + 1;
+		gf2_poly s(2 * na + 1, 0);
+
+		for (size_t i = 0; i < na; ++i)
+		{
+			s[2 * i] = gf2_spread32((uint32_t)a[i]);
+			s[2 * i + 1] = gf2_spread32((uint32_t)(a[i] >> 32));
+		}
+
+		// remove the terms of degree d or higher, from top to bottom
+
+		const size_t nphi = (d >> 6) + 1;
+		for (size_t i = 2 * d; i >= d; --i)
+		{
+			if (gf2_bit(s, i)) gf2_add_shifted(&s[0], &phi[0], nphi, i - d);
+		}
+
+		for (size_t i = 0; i < na; ++i) a[i] = s[i];
+	}
+
+	// x^(2^k) mod phi
+
+	inline gf2_poly gf2_pow2k_mod(size_t k, const gf2_poly& phi)
+	{
+		const size_t d = gf2_degree(phi);
+		gf2_poly a((d >> 6) + 1, 0);
+
+		// start from x^(2^j) for the largest j with 2^j < d
+
+		size_t j = 0;
+		while (j < k && (size_t(2) << j) < d) ++j;
+
+		gf2_flip(a, size_t(1) << j);
+		for (; j < k; ++j) gf2_sqrmod(a, phi, d);
+
+		return a;
+	}
+
+} } LMAT_END_NAMESPACE
+
+#endif /* SFMT_JUMP_INTERNAL_H_ */
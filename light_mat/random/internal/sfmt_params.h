@@ -15,7 +15,7 @@
 
 #include <light_mat/common/prim_types.h>
 
-namespace lmat { namespace random { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace random { namespace internal {
 
 	template<unsigned int MEXP>
 	struct sfmt_params_base
@@ -224,6 +224,6 @@ namespace lmat { namespace random { namespace internal {
 	};
 */
 
-} } }
+} } LMAT_END_NAMESPACE
 
 #endif /* SFMT_PARAMS_H_ */
@@ -15,7 +15,7 @@
 
 #include <light_mat/random/distr_fwd.h>
 
-namespace lmat { namespace random { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace random { namespace internal {
 
 	// core routines to convert from random bits to real value in [1, 2)
 
@@ -79,6 +79,26 @@ namespace lmat { namespace random { namespace internal {
 
 #endif
 
-} } }
+#ifdef LMAT_HAS_AVX512
+
+	LMAT_ENSURE_INLINE
+	inline __m512 randbits_to_c1o2_f32(const __m512i& u, avx512_t)
+	{
+		return _mm512_castsi512_ps(_mm512_or_si512(
+			_mm512_set1_epi32((int)0x3f800000),
+			_mm512_and_si512(_mm512_set1_epi32((int)0x007fffff), u)));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline __m512d randbits_to_c1o2_f64(const __m512i& u, avx512_t)
+	{
+		return _mm512_castsi512_pd(_mm512_or_si512(
+			_mm512_set1_epi64((int64_t)0x3ff0000000000000LL),
+			_mm512_and_si512(_mm512_set1_epi64((int64_t)0x000fffffffffffffLL), u)));
+	}
+
+#endif
+
+} } LMAT_END_NAMESPACE
 
 #endif
@@ -0,0 +1,461 @@
+/**
+ * @file ziggurat_internal.h
+ *
+ * @brief Internal implementation of the Ziggurat method
+ *
+ * The method follows
+ *
+ *   G. Marsaglia and W. W. Tsang.
+ *   The Ziggurat Method for Generating Random Variables.
+ *   Journal of Statistical Software, 2000.
+ *
+ * with 256 layers. Each candidate takes one 32-bit (float) or
+ * 64-bit (double) unit, whose low bits make a uniform u in [0, 1),
+ * and whose high bits select the layer (and the sign, for
+ * symmetric distributions).
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_ZIGGURAT_INTERNAL_H_
+#define LIGHTMAT_ZIGGURAT_INTERNAL_H_
+
+#include <light_mat/random/uniform_real_distr.h>
+#include <light_mat/math/simd_math.h>
+#include <cmath>
+
+LMAT_BEGIN_NAMESPACE namespace random { namespace internal {
+
+	/********************************************
+	 *
+	 *  shapes
+	 *
+	 *  f is the (unnormalized) density on
+	 *  [0, inf), r is the start of the tail,
+	 *  and v is the area of each layer.
+	 *
+	 ********************************************/
+
+	struct zig_normal
+	{
+		static const bool symmetric = true;
+
+		static double r() { return 3.6541528853610088; }
+		static double v() { return 4.92867323399e-3; }
+
+		static double f(double x) { return std::exp(-0.5 * x * x); }
+		static double finv(double y) { return std::sqrt(-2.0 * std::log(y)); }
+
+		template<typename T>
+		LMAT_ENSURE_INLINE
+		static T density(T x)
+		{
+			return math::exp(T(-0.5) * x * x);
+		}
+
+		// the tail beyond r (Marsaglia, 1964)
+
+		template<typename T, class RStream>
+		static T tail(RStream& rs)
+		{
+			const T r = T(3.6541528853610088);
+			T x, y;
+			do
+			{
+				x = -math::log(rand_real<T>::o0c1(rs)) / r;
+				y = -math::log(rand_real<T>::o0c1(rs));
+			}
+			while (y + y < x * x);
+
+			return r + x;
+		}
+	};
+
+	struct zig_exponential
+	{
+		static const bool symmetric = false;
+
+		static double r() { return 7.69711747013104972; }
+		static double v() { return 3.949659822581572e-3; }
+
+		static double f(double x) { return std::exp(-x); }
+		static double finv(double y) { return -std::log(y); }
+
+		template<typename T>
+		LMAT_ENSURE_INLINE
+		static T density(T x)
+		{
+			return math::exp(-x);
+		}
+
+		// the tail beyond r is a shifted exponential
+
+		template<typename T, class RStream>
+		LMAT_ENSURE_INLINE
+		static T tail(RStream& rs)
+		{
+			return T(7.69711747013104972) - math::log(rand_real<T>::o0c1(rs));
+		}
+	};
+
+
+	/********************************************
+	 *
+	 *  layer tables
+	 *
+	 *  Layer 0 is the base strip (including the
+	 *  tail), and layer i > 0 is the rectangle
+	 *  [0, x[i]] x [f[i], f[i+1]].
+	 *
+	 ********************************************/
+
+	template<typename T, class Shape>
+	struct zig_table
+	{
+		static const unsigned int N = 256;
+
+		T x[N + 1];  // x[0] = v / f(r), x[1] = r > x[2] > ... > x[N] = 0
+		T f[N + 1];  // f(x[i]), with f[0] = 0
+		T k[N];      // x[i+1] / x[i], below which a candidate is accepted right away
+
+		zig_table()
+		{
+			double xd[N + 1];
+			const double r = Shape::r();
+			const double v = Shape::v();
+
+			xd[0] = v / Shape::f(r);
+			xd[1] = r;
+			for (unsigned int i = 1; i < N - 1; ++i)
+				xd[i + 1] = Shape::finv(v / xd[i] + Shape::f(xd[i]));
+			xd[N] = 0.0;
+
+			for (unsigned int i = 0; i <= N; ++i)
+			{
+				x[i] = T(xd[i]);
+				f[i] = i > 0 ? T(Shape::f(xd[i])) : T(0);
+			}
+
+			for (unsigned int i = 0; i < N; ++i)
+				k[i] = T(xd[i + 1] / xd[i]);
+		}
+
+		static const zig_table& get()
+		{
+			static const zig_table tab;
+			return tab;
+		}
+	};
+
+
+	/********************************************
+	 *
+	 *  random bits
+	 *
+	 ********************************************/
+
+	template<typename T> struct zig_bits;
+
+	template<>
+	struct zig_bits<float>
+	{
+		typedef uint32_t type;
+		static const unsigned int ishift = 23;  // bits 23 - 30: layer, bit 31: sign
+
+		template<class RStream>
+		LMAT_ENSURE_INLINE
+		static uint32_t draw(RStream& rs)
+		{
+			return rs.rand_u32();
+		}
+
+		LMAT_ENSURE_INLINE
+		static float c0o1(uint32_t b)
+		{
+			return randbits_to_c1o2_f32(b) - 1.0f;
+		}
+
+		LMAT_ENSURE_INLINE
+		static float with_sign(float z, uint32_t b)  // without branching on the random sign
+		{
+			union {
+				uint32_t u32;
+				float f32;
+			} x;
+
+			x.f32 = z;
+			x.u32 ^= (b & 0x80000000U);
+			return x.f32;
+		}
+
+		template<typename Bits, typename Kind>
+		LMAT_ENSURE_INLINE
+		static simd_pack<float, Kind> c0o1(const Bits& b, Kind)
+		{
+			return simd_pack<float, Kind>(randbits_to_c1o2_f32(b, Kind())) - simd_pack<float, Kind>(1.0f);
+		}
+	};
+
+	template<>
+	struct zig_bits<double>
+	{
+		typedef uint64_t type;
+		static const unsigned int ishift = 52;  // bits 52 - 59: layer, bit 60: sign
+
+		template<class RStream>
+		LMAT_ENSURE_INLINE
+		static uint64_t draw(RStream& rs)
+		{
+			return rs.rand_u64();
+		}
+
+		LMAT_ENSURE_INLINE
+		static double c0o1(uint64_t b)
+		{
+			return randbits_to_c1o2_f64(b) - 1.0;
+		}
+
+		LMAT_ENSURE_INLINE
+		static double with_sign(double z, uint64_t b)
+		{
+			union {
+				uint64_t u64;
+				double f64;
+			} x;
+
+			x.f64 = z;
+			x.u64 ^= ((b << 3) & 0x8000000000000000ULL);
+			return x.f64;
+		}
+
+		template<typename Bits, typename Kind>
+		LMAT_ENSURE_INLINE
+		static simd_pack<double, Kind> c0o1(const Bits& b, Kind)
+		{
+			return simd_pack<double, Kind>(randbits_to_c1o2_f64(b, Kind())) - simd_pack<double, Kind>(1.0);
+		}
+	};
+
+	LMAT_ENSURE_INLINE
+	inline void zig_store_bits(void *p, const __m128i& b)
+	{
+		_mm_store_si128(reinterpret_cast<__m128i*>(p), b);
+	}
+
+#ifdef LMAT_HAS_AVX
+	LMAT_ENSURE_INLINE
+	inline void zig_store_bits(void *p, const __m256i& b)
+	{
+		_mm256_store_si256(reinterpret_cast<__m256i*>(p), b);
+	}
+#endif
+
+#ifdef LMAT_HAS_AVX512
+	LMAT_ENSURE_INLINE
+	inline void zig_store_bits(void *p, const __m512i& b)
+	{
+		_mm512_store_si512(p, b);
+	}
+#endif
+
+
+	/********************************************
+	 *
+	 *  scalar draws
+	 *
+	 ********************************************/
+
+	// the test of a candidate rejected by the fast test, which
+	// gives the (unsigned) value in z if the candidate is accepted
+
+	template<typename T, class Shape, class RStream>
+	inline bool zig_slow(const zig_table<T, Shape>& tab, unsigned int i, T u, RStream& rs, T& z)
+	{
+		if (i == 0)
+		{
+			z = Shape::template tail<T>(rs);
+			return true;
+		}
+
+		z = u * tab.x[i];
+		const T y = tab.f[i] + rand_real<T>::c0o1(rs) * (tab.f[i + 1] - tab.f[i]);
+		return y < Shape::density(z);
+	}
+
+	template<typename T, class Shape, class RStream>
+	inline T zig_draw(const zig_table<T, Shape>& tab, RStream& rs)
+	{
+		typedef zig_bits<T> B;
+
+		for(;;)
+		{
+			const typename B::type b = B::draw(rs);
+			const unsigned int i = (unsigned int)(b >> B::ishift) & 255;
+			const T u = B::c0o1(b);
+
+			T z;
+			if (u < tab.k[i])
+				z = u * tab.x[i];
+			else if (!zig_slow(tab, i, u, rs, z))
+				continue;
+
+			return Shape::symmetric ? B::with_sign(z, b) : z;
+		}
+	}
+
+
+	/********************************************
+	 *
+	 *  SIMD draws
+	 *
+	 *  The candidates of a pack are converted
+	 *  and tested against the layers at once.
+	 *  The rare lanes that fail the fast test
+	 *  (about 1.5% for normal and 2% for exponential) go through
+	 *  the scalar tests.
+	 *
+	 ********************************************/
+
+	template<typename T, typename Kind, class Shape>
+	class zig_simd
+	{
+	public:
+		typedef simd_pack<T, Kind> result_type;
+		typedef simd_bpack<T, Kind> bpack_t;
+		typedef typename zig_bits<T>::type bits_t;
+		typedef zig_bits<T> B;
+
+		static const unsigned int W = simd_traits<T, Kind>::pack_width;
+
+		LMAT_ENSURE_INLINE
+		zig_simd()
+		: m_tab(&zig_table<T, Shape>::get()) { }
+
+		// lanes rejected by the fast test are replaced by scalar draws
+
+		template<class RStream>
+		LMAT_ENSURE_INLINE
+		result_type operator() (RStream& rs) const
+		{
+			LMAT_ALIGN(64) bits_t b[W];
+			result_type u, z;
+			bpack_t acc;
+
+			candidates(rs, b, u, z, acc);
+			if (all_true(acc)) return z;
+
+			LMAT_ALIGN(64) T ub[W];
+			LMAT_ALIGN(64) T zb[W];
+			bool ab[W];
+
+			u.store_a(ub);
+			z.store_a(zb);
+			acc.store(ab);
+
+			for (unsigned int l = 0; l < W; ++l)
+			{
+				if (!ab[l])
+				{
+					T v;
+					zb[l] = slow(rs, b[l], ub[l], v) ? v : zig_draw(*m_tab, rs);
+				}
+			}
+
+			z.load_a(zb);
+			return z;
+		}
+
+		// draws len values to dst, where the values accepted from each
+		// pack are compacted to the front, and the rejected ones dropped
+
+		template<class RStream>
+		inline void fill(RStream& rs, index_t len, T *dst) const
+		{
+			LMAT_ALIGN(64) bits_t b[W];
+			LMAT_ALIGN(64) T ub[W];
+			LMAT_ALIGN(64) T zb[W];
+			bool ab[W];
+
+			index_t n = 0;
+			while (len - n >= (index_t)W)
+			{
+				result_type u, z;
+				bpack_t acc;
+				candidates(rs, b, u, z, acc);
+
+				if (all_true(acc))
+				{
+					z.store_u(dst + n);
+					n += W;
+				}
+				else
+				{
+					u.store_a(ub);
+					z.store_a(zb);
+					acc.store(ab);
+
+					for (unsigned int l = 0; l < W; ++l)
+					{
+						if (ab[l])
+							dst[n++] = zb[l];
+						else if (slow(rs, b[l], ub[l], zb[l]))
+							dst[n++] = zb[l];
+					}
+				}
+			}
+
+			for (; n < len; ++n) dst[n] = zig_draw(*m_tab, rs);
+		}
+
+	private:
+		template<class RStream>
+		LMAT_ENSURE_INLINE
+		void candidates(RStream& rs, bits_t *b, result_type& u, result_type& z, bpack_t& acc) const
+		{
+			candidates_from(rs.rand_pack(Kind()), b, u, z, acc);
+		}
+
+		template<typename Bits>
+		LMAT_ENSURE_INLINE
+		void candidates_from(const Bits& raw, bits_t *b, result_type& u, result_type& z, bpack_t& acc) const
+		{
+			const zig_table<T, Shape>& tab = *m_tab;
+
+			LMAT_ALIGN(64) T w[W];
+			LMAT_ALIGN(64) T k[W];
+
+			zig_store_bits(b, raw);
+
+			for (unsigned int l = 0; l < W; ++l)
+			{
+				const unsigned int i = (unsigned int)(b[l] >> B::ishift) & 255;
+				w[l] = Shape::symmetric ? B::with_sign(tab.x[i], b[l]) : tab.x[i];
+				k[l] = tab.k[i];
+			}
+
+			u = B::c0o1(raw, Kind());
+			z = u * result_type(w);
+			acc = u < result_type(k);
+		}
+
+		template<class RStream>
+		LMAT_ENSURE_INLINE
+		bool slow(RStream& rs, bits_t b, T u, T& z) const
+		{
+			const unsigned int i = (unsigned int)(b >> B::ishift) & 255;
+			if (!zig_slow(*m_tab, i, u, rs, z)) return false;
+			if (Shape::symmetric) z = B::with_sign(z, b);
+			return true;
+		}
+
+	private:
+		const zig_table<T, Shape> *m_tab;
+	};
+
+} } LMAT_END_NAMESPACE
+
+#endif /* ZIGGURAT_INTERNAL_H_ */
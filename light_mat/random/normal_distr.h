@@ -15,7 +15,7 @@
 
 #include "internal/normal_distr_internal.h"
 
-namespace lmat { namespace random {
+LMAT_BEGIN_NAMESPACE namespace random {
 
 	// classes
 
@@ -50,6 +50,13 @@ namespace lmat { namespace random {
 			return m_impl(rs);
 		}
 
+		template<class RStream>
+		LMAT_ENSURE_INLINE
+		void fill(RStream& rs, index_t len, T *dst) const
+		{
+			m_impl.fill(rs, len, dst);
+		}
+
 	private:
 		internal::std_normal_distr_impl<T, Method> m_impl;
 	};
@@ -91,15 +98,21 @@ namespace lmat { namespace random {
 			return m_impl(rs);
 		}
 
+		template<class RStream>
+		LMAT_ENSURE_INLINE
+		void fill(RStream& rs, index_t len, T *dst) const
+		{
+			m_impl.fill(rs, len, dst);
+		}
+
 	private:
 		internal::normal_distr_impl<T, Method> m_impl;
 	};
 
-} }
+} LMAT_END_NAMESPACE
 
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	template<typename T, typename Kind>
 	struct is_simdizable<random::std_normal_distr<T, random::icdf_>, Kind>
 	: public meta::has_simd_support<ftags::norminv_, T, Kind> { };
@@ -133,7 +146,42 @@ namespace lmat
 		}
 	};
 
-}
+
+	// the Ziggurat method is vectorized without relying on SVML
+
+	template<typename T, typename Kind>
+	struct is_simdizable<random::std_normal_distr<T, random::ziggurat_>, Kind>
+	: public meta::true_ { };
+
+	template<typename T, typename Kind>
+	struct is_simdizable<random::normal_distr<T, random::ziggurat_>, Kind>
+	: public meta::true_ { };
+
+	template<typename T, typename Kind>
+	struct simdize_map< random::std_normal_distr<T, random::ziggurat_>, Kind >
+	{
+		typedef random::internal::std_normal_distr_simd_impl<T, Kind, random::ziggurat_> type;
+
+		LMAT_ENSURE_INLINE
+		static type get(const random::std_normal_distr<T, random::ziggurat_>& s)
+		{
+			return type();
+		}
+	};
+
+	template<typename T, typename Kind>
+	struct simdize_map< random::normal_distr<T, random::ziggurat_>, Kind >
+	{
+		typedef random::internal::normal_distr_simd_impl<T, Kind, random::ziggurat_> type;
+
+		LMAT_ENSURE_INLINE
+		static type get(const random::normal_distr<T, random::ziggurat_>& s)
+		{
+			return type(s.mean(), s.stddev());
+		}
+	};
+
+LMAT_END_NAMESPACE
 
 
 
@@ -0,0 +1,352 @@
+/**
+ * @file philox.h
+ *
+ * @brief Philox random stream (counter-based)
+ *
+ * The i-th 32-bit unit of a Philox stream is a pure function of the
+ * key (seed), the substream id, and i. Hence, one can jump to any
+ * position in O(1) time, and different threads can work on disjoint
+ * parts of the same stream, or on different substreams, producing
+ * the same numbers regardless of how the work is divided.
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_PHILOX_H_
+#define LIGHTMAT_PHILOX_H_
+
+#include <light_mat/random/rand_stream.h>
+#include <light_mat/random/stream_tracker.h>
+
+#include "internal/philox_internal.h"
+#include "internal/rand_stream_internal.h"
+
+LMAT_BEGIN_NAMESPACE namespace random {
+
+	/********************************************
+	 *
+	 *  philox_state
+	 *
+	 *  The counter of the b-th block is
+	 *  (lo(b), hi(b), lo(s), hi(s)), where s
+	 *  is the substream id. Each refresh
+	 *  generates nblocks consecutive blocks.
+	 *
+	 ********************************************/
+
+	class philox_state
+	{
+	public:
+		static const unsigned int nblocks = 16;
+		static const unsigned int N32 = nblocks * 4;
+
+		LMAT_ENSURE_INLINE
+		explicit philox_state(uint64_t key=1234, uint64_t sid=0)
+		: m_key(key), m_sid(sid), m_ctr(0) { }
+
+		LMAT_ENSURE_INLINE
+		uint64_t key() const
+		{
+			return m_key;
+		}
+
+		LMAT_ENSURE_INLINE
+		uint64_t substream() const
+		{
+			return m_sid;
+		}
+
+		LMAT_ENSURE_INLINE
+		uint64_t counter() const  // the first block of the next refresh
+		{
+			return m_ctr;
+		}
+
+		LMAT_ENSURE_INLINE
+		void set_key(uint64_t key)
+		{
+			m_key = key;
+		}
+
+		LMAT_ENSURE_INLINE
+		void set_substream(uint64_t sid)
+		{
+			m_sid = sid;
+		}
+
+		LMAT_ENSURE_INLINE
+		void set_counter(uint64_t ctr)
+		{
+			m_ctr = ctr;
+		}
+
+		void next()
+		{
+			typedef internal::philox_default_simd V;
+
+			LMAT_ALIGN(64) uint32_t clo[nblocks];
+			LMAT_ALIGN(64) uint32_t chi[nblocks];
+
+			for (unsigned int b = 0; b < nblocks; ++b)
+			{
+				const uint64_t c = m_ctr + b;
+				clo[b] = (uint32_t)c;
+				chi[b] = (uint32_t)(c >> 32);
+			}
+
+			const uint32_t s0 = (uint32_t)m_sid;
+			const uint32_t s1 = (uint32_t)(m_sid >> 32);
+			const uint32_t k0 = (uint32_t)m_key;
+			const uint32_t k1 = (uint32_t)(m_key >> 32);
+
+			for (unsigned int b = 0; b < nblocks; b += V::nblocks)
+			{
+				internal::philox4x32_10_blocks<V>(m_buf + b * 4, clo + b, chi + b, s0, s1, k0, k1);
+			}
+
+			m_ctr += nblocks;
+		}
+
+		const uint32_t* ptr_base() const
+		{
+			return m_buf;
+		}
+
+		__m128i pack(size_t offset) const  // offset must be multiples of four
+		{
+			return _mm_load_si128(reinterpret_cast<const __m128i*>(m_buf + offset));
+		}
+
+#ifdef LMAT_HAS_AVX
+		__m256i avx_pack(size_t offset) const  // offset must be multiples of eight
+		{
+			return _mm256_load_si256(reinterpret_cast<const __m256i*>(m_buf + offset));
+		}
+#endif
+
+#ifdef LMAT_HAS_AVX512
+		__m512i avx512_pack(size_t offset) const  // offset must be multiples of eight & at least sixteen u32 remain
+		{
+			return _mm512_loadu_si512(reinterpret_cast<const void*>(m_buf + offset));
+		}
+#endif
+
+		uint64_t u64(size_t offset) const // offset must be multiples of two
+		{
+			return *(reinterpret_cast<const uint64_t*>(m_buf + offset));
+		}
+
+		uint32_t u32(size_t offset) const
+		{
+			return m_buf[offset];
+		}
+
+	private:
+		LMAT_ALIGN(64) uint32_t m_buf[N32];
+		uint64_t m_key;
+		uint64_t m_sid;
+		uint64_t m_ctr;
+	};
+
+
+	/********************************************
+	 *
+	 *  philox_rand_stream
+	 *
+	 ********************************************/
+
+	template<>
+	struct rand_stream_traits<philox_rand_stream>
+	{
+		typedef uint64_t seed_type;
+	};
+
+	class philox_rand_stream : public IRandStream<philox_rand_stream>
+	{
+		static const unsigned int N32 = philox_state::N32;
+		static const unsigned int NB = philox_state::nblocks;
+
+	public:
+		typedef uint64_t seed_type;
+
+		LMAT_ENSURE_INLINE
+		explicit philox_rand_stream(uint64_t seed=1234, uint64_t sid=0)
+		: m_intern(seed, sid), m_tracker(N32) { }
+
+		LMAT_ENSURE_INLINE
+		philox_rand_stream(const philox_rand_stream& r)
+		: m_intern(r.m_intern), m_tracker(N32)
+		{
+			m_tracker.set_offset(r.m_tracker.offset());
+		}
+
+		LMAT_ENSURE_INLINE
+		philox_rand_stream& operator = (const philox_rand_stream& r)
+		{
+			m_intern = r.m_intern;
+			m_tracker.set_offset(r.m_tracker.offset());
+			return *this;
+		}
+
+		LMAT_ENSURE_INLINE
+		uint64_t seed() const
+		{
+			return m_intern.key();
+		}
+
+		LMAT_ENSURE_INLINE
+		uint64_t substream() const
+		{
+			return m_intern.substream();
+		}
+
+	public:
+		LMAT_ENSURE_INLINE
+		void set_seed(const seed_type& seed)  // also rewinds to the beginning
+		{
+			m_intern.set_key(seed);
+			seek(0);
+		}
+
+		LMAT_ENSURE_INLINE
+		void set_substream(uint64_t sid)  // also rewinds to the beginning
+		{
+			m_intern.set_substream(sid);
+			seek(0);
+		}
+
+		LMAT_ENSURE_INLINE
+		size_t state_size() const  // in terms of bytes
+		{
+			return N32 * sizeof(uint32_t);
+		}
+
+		// the number of 32-bit units consumed so far
+
+		LMAT_ENSURE_INLINE
+		uint64_t position() const
+		{
+			const uint64_t c = m_intern.counter();
+			return m_tracker.is_end() ? c * 4 : (c - NB) * 4 + m_tracker.offset();
+		}
+
+		// moves to a given position (in terms of 32-bit units), in O(1) time
+
+		void seek(uint64_t pos)
+		{
+			const uint64_t q = pos / N32;
+			const size_t r = (size_t)(pos - q * N32);
+
+			m_intern.set_counter(q * NB);
+			if (r > 0)
+			{
+				m_intern.next();
+				m_tracker.set_offset(r);
+			}
+			else
+			{
+				m_tracker.set_end();
+			}
+		}
+
+		LMAT_ENSURE_INLINE
+		void skip(uint64_t n)  // skips n 32-bit units
+		{
+			seek(position() + n);
+		}
+
+		LMAT_ENSURE_INLINE
+		void long_jump()  // skips 2^52 32-bit units
+		{
+			skip(uint64_t(1) << 52);
+		}
+
+		LMAT_ENSURE_INLINE uint32_t rand_u32()
+		{
+			check_end();
+			uint32_t x = m_intern.u32(m_tracker.offset());
+			m_tracker.forward(1);
+			return x;
+		}
+
+		LMAT_ENSURE_INLINE uint64_t rand_u64()
+		{
+			m_tracker.to_boundary(bdtags::dbl());
+
+			check_end();
+			uint64_t x = m_intern.u64(m_tracker.offset());
+			m_tracker.forward(2);
+			return x;
+		}
+
+		LMAT_ENSURE_INLINE __m128i rand_pack(sse_t)
+		{
+			m_tracker.to_boundary(bdtags::quad());
+
+			check_end();
+			__m128i u = m_intern.pack(m_tracker.offset());
+			m_tracker.forward(4);
+			return u;
+		}
+
+#ifdef LMAT_HAS_AVX
+		LMAT_ENSURE_INLINE __m256i rand_pack(avx_t)
+		{
+			m_tracker.to_boundary(bdtags::oct());
+
+			check_end();
+			__m256i u = m_intern.avx_pack(m_tracker.offset());
+			m_tracker.forward(8);
+			return u;
+		}
+#endif
+
+#ifdef LMAT_HAS_AVX512
+		LMAT_ENSURE_INLINE __m512i rand_pack(avx512_t)
+		{
+			m_tracker.to_boundary(bdtags::oct());
+
+			check_end();
+			if (m_tracker.remain_atleast(16))
+			{
+				__m512i u = m_intern.avx512_pack(m_tracker.offset());
+				m_tracker.forward(16);
+				return u;
+			}
+			else  // the pack straddles the refreshing of the state
+			{
+				LMAT_ALIGN_AVX512 uint32_t x[16];
+				for (unsigned int i = 0; i < 16; ++i) x[i] = rand_u32();
+				return _mm512_load_si512(reinterpret_cast<const void*>(x));
+			}
+		}
+#endif
+
+		LMAT_ENSURE_INLINE void rand_seq(size_t nbytes, void *buf)
+		{
+			internal::gen_rand_seq(m_intern, m_tracker, buf, nbytes);
+		}
+
+	private:
+		LMAT_ENSURE_INLINE
+		void check_end()
+		{
+			if (m_tracker.is_end())
+			{
+				m_intern.next();
+				m_tracker.rewind();
+			}
+		}
+
+	private:
+		philox_state m_intern;
+		stream_tracker<uint32_t> m_tracker;
+	};
+
+} LMAT_END_NAMESPACE
+
+#endif /* PHILOX_H_ */
@@ -15,7 +15,7 @@
 
 #include <light_mat/random/exponential_distr.h>
 
-namespace lmat { namespace random {
+LMAT_BEGIN_NAMESPACE namespace random {
 
 
 	/********************************************
@@ -132,6 +132,6 @@ namespace lmat { namespace random {
 
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif
@@ -16,8 +16,7 @@
 #include <light_mat/mateval/multicol_accessors.h>
 #include <light_mat/random/distr_fwd.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	// forward declarations
 
 	template<typename RStream, typename Distr, typename U> class rand_vec_reader;
@@ -113,6 +112,6 @@ namespace lmat
 		RStream& m_rstream;
 		const Distr& m_distr;
 	};
-}
+LMAT_END_NAMESPACE
 
 #endif
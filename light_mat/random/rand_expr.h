@@ -24,8 +24,9 @@
 #include <light_mat/random/normal_distr.h>
 #include <light_mat/random/gamma_distr.h>
 
-namespace lmat
-{
+#include <vector>
+
+LMAT_BEGIN_NAMESPACE
 	// forward declaration
 
 	template<class Distr, class RStream, index_t CM=0, index_t CN=0> class rand_expr;
@@ -235,6 +236,19 @@ namespace lmat
 				return type(expr.stream(), expr.distr());
 			}
 		};
+
+		template<class Distr, class RStream, index_t CM, index_t CN, typename U>
+		struct multirow_reader_map<rand_expr<Distr, RStream, CM, CN>, U>
+		{
+			typedef rand_expr<Distr, RStream, CM, CN> expr_type;
+			typedef rand_multicol_reader<RStream, Distr, U> type;
+
+			LMAT_ENSURE_INLINE
+			static type get(const expr_type& expr)
+			{
+				return type(expr.stream(), expr.distr());
+			}
+		};
 	}
 
 
@@ -256,15 +270,208 @@ namespace lmat
 		static const bool value = is_simdizable<Distr, Kind>::value;
 	};
 
+	// the elements are independent, so they can be generated in any order
+
+	template<class Distr, class RStream, index_t CM, index_t CN>
+	struct supports_perrow_access<rand_expr<Distr, RStream, CM, CN> >
+	{
+		static const bool value = true;
+	};
+
+	template<class Distr, class RStream, index_t CM, index_t CN, typename Kind>
+	struct supports_perrow_simd<rand_expr<Distr, RStream, CM, CN>, Kind>
+	{
+		static const bool value = is_simdizable<Distr, Kind>::value;
+	};
+
+
+	/********************************************
+	 *
+	 *  Chunked evaluation
+	 *
+	 *  A destination of more than
+	 *  LMAT_RAND_CHUNK_ELEMS elements is divided
+	 *  into chunks of (about) that size, of
+	 *  elements, whole columns, or whole rows.
+	 *  The k-th chunk is filled from a copy of
+	 *  the stream advanced by k long jumps, with
+	 *  the same (SIMD) kernels as a single chunk.
+	 *  These streams are derived one from the
+	 *  previous, before the chunks are filled.
+	 *  Afterwards, the stream is advanced past
+	 *  all chunks.
+	 *
+	 *  A smaller destination is a single chunk,
+	 *  filled from the stream itself.
+	 *
+	 *  Sequential and parallel evaluation use
+	 *  the same chunks, the latter distributes
+	 *  them over threads. Given the seed, the
+	 *  result depends only on the shape of the
+	 *  destination, and not on the number of
+	 *  threads.
+	 *
+	 ********************************************/
+
+	namespace internal
+	{
+		template<class RStream>
+		struct _rand_substreams
+		{
+			static const unsigned int align = alignof(RStream) > LMAT_DEFAULT_ALIGNMENT ?
+					(unsigned int)alignof(RStream) : (unsigned int)LMAT_DEFAULT_ALIGNMENT;
+
+			typedef std::vector<RStream, aligned_allocator<RStream, align> > type;
+		};
+
+		// the k-th stream is rs advanced by k long jumps, and rs itself
+		// is then advanced by nc long jumps (nc jumps in all)
+
+		template<class RStream>
+		inline typename _rand_substreams<RStream>::type
+		_rand_split_stream(RStream& rs, index_t nc)
+		{
+			typename _rand_substreams<RStream>::type streams;
+			streams.reserve((size_t)nc);
+
+			streams.push_back(rs);
+			for (index_t k = 1; k < nc; ++k)
+			{
+				streams.push_back(streams.back());
+				streams.back().long_jump();
+			}
+
+			rs = streams.back();
+			rs.long_jump();
+			return streams;
+		}
+
+		// fill(s, k) fills the k-th chunk from the stream s,
+		// the chunks are distributed over threads if par is set
+
+		template<class RStream, class Fill>
+		inline void _rand_chunked_eval(RStream& rs, index_t nc, bool par, const Fill& fill)
+		{
+			typename _rand_substreams<RStream>::type streams = _rand_split_stream(rs, nc);
+
+#ifdef LMAT_HAS_OPENMP
+#pragma omp parallel for schedule(static) if (par)
+#endif
+			for (index_t k = 0; k < nc; ++k)
+			{
+				fill(streams[(size_t)k], k);
+			}
+		}
+
+		// the number of whole columns (or rows) of length len in a chunk
+
+		LMAT_ENSURE_INLINE
+		inline index_t _rand_chunk_vecs(index_t len)
+		{
+			const index_t c = (index_t)LMAT_RAND_CHUNK_ELEMS / len;
+			return c > 0 ? c : 1;
+		}
+
+		template<class Distr, class RStream, typename U, class DMat>
+		inline void _rand_eval(macc_<linear_, U>, const Distr& distr, RStream& rs, DMat& dmat, bool par)
+		{
+			typedef typename Distr::result_type T;
+			typedef rand_vec_reader<RStream, Distr, U> reader_t;
+
+			par_partition part(dmat.nelems(), (index_t)LMAT_RAND_CHUNK_ELEMS,
+					_par_chunk_align<copy_kernel<T>, U>::value);
+
+			auto dacc = make_vec_accessor(U(), out_(dmat));
+
+			_rand_chunked_eval(rs, part.nchunks(), par, [&](RStream& rs_k, index_t k)
+			{
+				_linear_ewise_eval(dimension<0>(part.chunk_length(k)), U(), copy_kernel<T>(),
+						reader_t(rs_k, distr), make_offset_vec_accessor(U(), dacc, part.chunk_begin(k)));
+			});
+		}
+
+		// each chunk consists of whole columns
+
+		template<class Distr, class RStream, typename U, class DMat>
+		inline void _rand_eval(macc_<percol_, U>, const Distr& distr, RStream& rs, DMat& dmat, bool par)
+		{
+			typedef typename Distr::result_type T;
+			typedef rand_vec_reader<RStream, Distr, U> reader_t;
+
+			par_partition part(dmat.ncolumns(), _rand_chunk_vecs(dmat.nrows()), 1);
+
+			dimension<meta::nrows<DMat>::value> coldim(dmat.nrows());
+			auto dacc = make_multicol_accessor(U(), out_(dmat));
+
+			_rand_chunked_eval(rs, part.nchunks(), par, [&](RStream& rs_k, index_t k)
+			{
+				const index_t j0 = part.chunk_begin(k);
+				const index_t j1 = j0 + part.chunk_length(k);
+				for (index_t j = j0; j < j1; ++j)
+				{
+					_linear_ewise_eval(coldim, U(), copy_kernel<T>(), reader_t(rs_k, distr), dacc.col(j));
+				}
+			});
+		}
+
+		// each chunk consists of whole rows
+
+		template<class Distr, class RStream, typename U, class DMat>
+		inline void _rand_eval(macc_<perrow_, U>, const Distr& distr, RStream& rs, DMat& dmat, bool par)
+		{
+			typedef typename Distr::result_type T;
+			typedef rand_vec_reader<RStream, Distr, U> reader_t;
+
+			par_partition part(dmat.nrows(), _rand_chunk_vecs(dmat.ncolumns()), 1);
+
+			dimension<meta::ncols<DMat>::value> rowdim(dmat.ncolumns());
+			auto dacc = make_multirow_accessor(U(), out_(dmat));
+
+			_rand_chunked_eval(rs, part.nchunks(), par, [&](RStream& rs_k, index_t k)
+			{
+				const index_t i0 = part.chunk_begin(k);
+				const index_t i1 = i0 + part.chunk_length(k);
+				for (index_t i = i0; i < i1; ++i)
+				{
+					_linear_ewise_eval(rowdim, U(), copy_kernel<T>(), reader_t(rs_k, distr), dacc.col(i));
+				}
+			});
+		}
+
+		template<class Distr, class RStream, index_t CM, index_t CN, class DMat>
+		inline void _rand_evaluate(const rand_expr<Distr, RStream, CM, CN>& sexpr, DMat& dmat, bool par)
+		{
+			if (dmat.nelems() <= (index_t)LMAT_RAND_CHUNK_ELEMS)
+			{
+				macc_evaluate(sexpr, dmat);
+			}
+			else
+			{
+				_rand_eval(get_preferred_expr_macc_policy(sexpr, dmat),
+						sexpr.distr(), sexpr.stream(), dmat, par);
+			}
+		}
+	}
+
 	template<class Distr, class RStream, index_t CM, index_t CN, class DMat>
 	LMAT_ENSURE_INLINE
 	inline void evaluate(const rand_expr<Distr, RStream, CM, CN>& sexpr,
 			IRegularMatrix<DMat, typename Distr::result_type>& dmat)
 	{
-		macc_evaluate(sexpr, dmat);
+		internal::_rand_evaluate(sexpr, dmat.derived(), false);
+	}
+
+	template<class Distr, class RStream, index_t CM, index_t CN, class DMat>
+	inline void macc_evaluate(const rand_expr<Distr, RStream, CM, CN>& sexpr,
+			IRegularMatrix<DMat, typename Distr::result_type>& dmat, par_)
+	{
+		LMAT_CHECK_DIMS( have_same_shape(sexpr, dmat) )
+
+		internal::_rand_evaluate(sexpr, dmat.derived(),
+				par_worthy(dmat.nelems(), LMAT_PAR_MIN_ELEMS));
 	}
 
 
-}
+LMAT_END_NAMESPACE
 
 #endif
@@ -16,7 +16,7 @@
 #include <light_mat/common/basic_defs.h>
 #include <light_mat/simd/simd_base.h>
 
-namespace lmat { namespace random {
+LMAT_BEGIN_NAMESPACE namespace random {
 
 	/********************************************
 	 *
@@ -63,6 +63,15 @@ namespace lmat { namespace random {
 		{
 			derived().rand_seq(nbytes, buf);
 		}
+
+		// jumps ahead by 2^52 32-bit units, such that the
+		// parts before and after a jump do not overlap in practice
+
+		LMAT_ENSURE_INLINE
+		void long_jump()
+		{
+			derived().long_jump();
+		}
 	};
 
 
@@ -73,10 +82,11 @@ namespace lmat { namespace random {
 	 ********************************************/
 
 	template<unsigned int MEXP> class sfmt_rand_stream;
+	class philox_rand_stream;
 
 	typedef sfmt_rand_stream<19937> default_rand_stream;
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif /* RAND_STREAM_H_ */
@@ -17,7 +17,7 @@
 #include <light_mat/random/uniform_int_distr.h>
 #include <unordered_set>
 
-namespace lmat { namespace random {
+LMAT_BEGIN_NAMESPACE namespace random {
 
 	template<typename TI=uint32_t, class RStream=default_rand_stream>
 	class rand_shuffle_enumerator
@@ -155,6 +155,6 @@ namespace lmat { namespace random {
 
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif
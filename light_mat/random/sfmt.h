@@ -17,11 +17,12 @@
 #include <light_mat/random/stream_tracker.h>
 
 #include "internal/sfmt_params.h"
+#include "internal/sfmt_jump_internal.h"
 #include "internal/rand_stream_internal.h"
 
 #define LMAT_SFMT_IDXOF(i) i
 
-namespace lmat { namespace random {
+LMAT_BEGIN_NAMESPACE namespace random {
 
 	/********************************************
 	 *
@@ -47,7 +48,6 @@ namespace lmat { namespace random {
 		{
 			init_states(seed);
 			param_mask = internal::sfmt_init_param_mask<MEXP>();
-			pbase = state[0].u;
 		}
 
 		void init_states(uint32_t seed);
@@ -76,31 +76,44 @@ namespace lmat { namespace random {
 		    }
 		}
 
+		// replaces the state by p(A) applied to it, where A is the transition
+		// of one step (one 128-bit word). With p = x^J mod phi, this jumps
+		// ahead by J steps.
+
+		void jump(const internal::gf2_poly& p);
+
 		const uint32_t* ptr_base() const
 		{
-			return pbase;
+			return reinterpret_cast<const uint32_t*>(state);
 		}
 
 		__m128i pack(size_t offset) const  // offset must be multiples of four
 		{
-			return _mm_load_si128(reinterpret_cast<const __m128i*>(pbase + offset));
+			return _mm_load_si128(reinterpret_cast<const __m128i*>(ptr_base() + offset));
 		}
 
 #ifdef LMAT_HAS_AVX
 		__m256i avx_pack(size_t offset) const  // offset must be multiples of eight & at least eight u32 remain
 		{
-			return _mm256_load_si256(reinterpret_cast<const __m256i*>(pbase + offset));
+			return _mm256_load_si256(reinterpret_cast<const __m256i*>(ptr_base() + offset));
+		}
+#endif
+
+#ifdef LMAT_HAS_AVX512
+		__m512i avx512_pack(size_t offset) const  // offset must be multiples of eight & at least sixteen u32 remain
+		{
+			return _mm512_loadu_si512(reinterpret_cast<const void*>(ptr_base() + offset));
 		}
 #endif
 
 		uint64_t u64(size_t offset) const // offset must be multiples of two
 		{
-			return *(reinterpret_cast<const uint64_t*>(pbase + offset));
+			return *(reinterpret_cast<const uint64_t*>(ptr_base() + offset));
 		}
 
 		uint32_t u32(size_t offset) const
 		{
-			return pbase[offset];
+			return ptr_base()[offset];
 		}
 
 	private:
@@ -125,7 +138,6 @@ namespace lmat { namespace random {
 	private:
 		LMAT_ALIGN(64) sfmt_pack_t state[param_t::N];
 		__m128i param_mask;
-		uint32_t *pbase;
 	};
 
 
@@ -136,7 +148,7 @@ namespace lmat { namespace random {
 			param_t::PARITY1, param_t::PARITY2,
 			param_t::PARITY3, param_t::PARITY4};
 
-	    uint32_t *psfmt32 = &state[0].u[0];
+	    uint32_t *psfmt32 = reinterpret_cast<uint32_t*>(state);
 
 	    psfmt32[LMAT_SFMT_IDXOF(0)] = seed;
 	    for (unsigned int i = 1; i < param_t::N32; i++)
@@ -182,6 +194,134 @@ namespace lmat { namespace random {
 	}
 
 
+	template<unsigned int MEXP>
+	void sfmt_state<MEXP>::jump(const internal::gf2_poly& p)
+	{
+		const unsigned int N = param_t::N;
+		const unsigned int P = param_t::POS1;
+
+		// the words w[t], ..., w[t+N-1] are kept in a circular window,
+		// where w[t] is at win[h]
+
+		LMAT_ALIGN(64) sfmt_pack_t win[N];
+		LMAT_ALIGN(64) sfmt_pack_t acc[N];
+
+		for (unsigned int j = 0; j < N; ++j)
+		{
+			win[j].si = state[j].si;
+			acc[j].si = _mm_setzero_si128();
+		}
+
+		const size_t d = internal::gf2_degree(p);
+		unsigned int h = 0;
+
+		for (size_t i = 0; i <= d; ++i)
+		{
+			if (internal::gf2_bit(p, i))
+			{
+				for (unsigned int j = 0; j < N - h; ++j)
+					acc[j].si = _mm_xor_si128(acc[j].si, win[h + j].si);
+
+				for (unsigned int j = N - h; j < N; ++j)
+					acc[j].si = _mm_xor_si128(acc[j].si, win[h + j - N].si);
+			}
+
+			if (i < d)
+			{
+				const unsigned int hp = h + P < N ? h + P : h + P - N;
+				const unsigned int h2 = h >= 2 ? h - 2 : h + N - 2;
+				const unsigned int h1 = h >= 1 ? h - 1 : h + N - 1;
+
+				win[h].si = mm_recursion(win[h].si, win[hp].si, win[h2].si, win[h1].si, param_mask);
+				if (++h == N) h = 0;
+			}
+		}
+
+		for (unsigned int j = 0; j < N; ++j)
+		{
+			state[j].si = acc[j].si;
+		}
+	}
+
+
+	/********************************************
+	 *
+	 *  sfmt_jump_poly
+	 *
+	 *  The polynomial x^(2^k) mod phi, where phi
+	 *  is the minimal polynomial of the output
+	 *  sequence, which is derived once per MEXP
+	 *  (with Berlekamp-Massey). deg(phi) is MEXP,
+	 *  or slightly above it when the state has
+	 *  more than MEXP bits in use.
+	 *
+	 *  Building a jump polynomial takes
+	 *  O(k * deg(phi)^2 / 128) time, while
+	 *  applying it takes O(deg(phi) * N).
+	 *
+	 ********************************************/
+
+	template<unsigned int MEXP>
+	class sfmt_jump_poly
+	{
+		typedef internal::sfmt_params<MEXP> param_t;
+
+	public:
+		explicit sfmt_jump_poly(unsigned int k)
+		: m_k(k), m_coefs(internal::gf2_pow2k_mod(k, minpoly())) { }
+
+		LMAT_ENSURE_INLINE
+		unsigned int log2_steps() const  // each step is one 128-bit word
+		{
+			return m_k;
+		}
+
+		LMAT_ENSURE_INLINE
+		const internal::gf2_poly& coefs() const
+		{
+			return m_coefs;
+		}
+
+		static const internal::gf2_poly& minpoly()
+		{
+			static const internal::gf2_poly phi = compute_minpoly();
+			return phi;
+		}
+
+		static const sfmt_jump_poly& long_jump_poly()  // 2^50 steps
+		{
+			static const sfmt_jump_poly jp(50);
+			return jp;
+		}
+
+	private:
+		static internal::gf2_poly compute_minpoly()
+		{
+			// the lowest bits of twice as many words as the state bits
+
+			const size_t n = 256 * param_t::N;
+			internal::gf2_poly s((n >> 6) + 1, 0);
+
+			sfmt_state<MEXP> st;
+			size_t i = 0;
+			while (i < n)
+			{
+				st.next();
+				for (unsigned int j = 0; j < param_t::N && i < n; ++j, ++i)
+				{
+					if (st.u32(4 * j) & 1) internal::gf2_flip(s, i);
+				}
+			}
+
+			return internal::gf2_minpoly(s, n);
+		}
+
+	private:
+		unsigned int m_k;
+		internal::gf2_poly m_coefs;
+	};
+
+
 	/********************************************
 	 *
 	 *  sfmt_rand_stream
@@ -207,6 +347,21 @@ namespace lmat { namespace random {
 		sfmt_rand_stream(uint32_t seed=1234)
 		: m_intern(seed), m_tracker(param_t::N32) { }
 
+		LMAT_ENSURE_INLINE
+		sfmt_rand_stream(const sfmt_rand_stream& r)
+		: m_intern(r.m_intern), m_tracker(param_t::N32)
+		{
+			m_tracker.set_offset(r.m_tracker.offset());
+		}
+
+		LMAT_ENSURE_INLINE
+		sfmt_rand_stream& operator = (const sfmt_rand_stream& r)
+		{
+			m_intern = r.m_intern;
+			m_tracker.set_offset(r.m_tracker.offset());
+			return *this;
+		}
+
 		LMAT_ENSURE_INLINE
 		unsigned int period_exponent() const
 		{
@@ -239,6 +394,22 @@ namespace lmat { namespace random {
 			return param_t::N * 16;
 		}
 
+		// skips 2^k 128-bit words (i.e. 2^(k+2) 32-bit units)
+
+		LMAT_ENSURE_INLINE
+		void jump(const sfmt_jump_poly<MEXP>& jp)
+		{
+			m_intern.jump(jp.coefs());
+		}
+
+		// skips 2^52 32-bit units (the jump polynomial is built upon the first use)
+
+		LMAT_ENSURE_INLINE
+		void long_jump()
+		{
+			jump(sfmt_jump_poly<MEXP>::long_jump_poly());
+		}
+
 		LMAT_ENSURE_INLINE uint32_t rand_u32()
 		{
 			check_end();
@@ -279,6 +450,27 @@ namespace lmat { namespace random {
 		}
 #endif
 
+#ifdef LMAT_HAS_AVX512
+		LMAT_ENSURE_INLINE __m512i rand_pack(avx512_t)
+		{
+			m_tracker.to_boundary(bdtags::oct());
+
+			check_end();
+			if (m_tracker.remain_atleast(16))
+			{
+				__m512i u = m_intern.avx512_pack(m_tracker.offset());
+				m_tracker.forward(16);
+				return u;
+			}
+			else  // the pack straddles the refreshing of the state
+			{
+				LMAT_ALIGN_AVX512 uint32_t x[16];
+				for (unsigned int i = 0; i < 16; ++i) x[i] = rand_u32();
+				return _mm512_load_si512(reinterpret_cast<const void*>(x));
+			}
+		}
+#endif
+
 		LMAT_ENSURE_INLINE void rand_seq(size_t nbytes, void *buf)
 		{
 			internal::gen_rand_seq(m_intern, m_tracker, buf, nbytes);
@@ -301,6 +493,35 @@ namespace lmat { namespace random {
 	};
 
 
+	/********************************************
+	 *
+	 *  substreams
+	 *
+	 *  streams[i] starts 2^k * i words after
+	 *  the beginning of the stream seeded by
+	 *  seed, such that the streams do not
+	 *  overlap unless one draws more than
+	 *  2^(k+2) 32-bit units from one of them.
+	 *
+	 ********************************************/
+
+	template<unsigned int MEXP>
+	void init_substreams(uint32_t seed, unsigned int k, size_t n, sfmt_rand_stream<MEXP>* streams)
+	{
+		if (n == 0) return;
+
+		streams[0].set_seed(seed);
+		if (n == 1) return;
+
+		const sfmt_jump_poly<MEXP> jp(k);
+		for (size_t i = 1; i < n; ++i)
+		{
+			streams[i] = streams[i - 1];
+			streams[i].jump(jp);
+		}
+	}
+
+
 	// Typdefs
 
 	typedef sfmt_rand_stream<607>    sfmt607_t;
@@ -314,6 +535,6 @@ namespace lmat { namespace random {
 	typedef sfmt_rand_stream<132049> sfmt132049_t;
 	typedef sfmt_rand_stream<216091> sfmt216091_t;
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif /* SFMT_H_ */
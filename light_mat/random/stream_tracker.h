@@ -15,7 +15,7 @@
 
 #include <light_mat/common/basic_defs.h>
 
-namespace lmat { namespace random {
+LMAT_BEGIN_NAMESPACE namespace random {
 
 	template<typename T> // T is the unit type
 	class stream_tracker
@@ -119,6 +119,6 @@ namespace lmat { namespace random {
 		size_t m_i;
 	};
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif
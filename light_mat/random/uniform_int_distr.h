@@ -15,7 +15,7 @@
 
 #include <light_mat/random/distr_fwd.h>
 
-namespace lmat { namespace random {
+LMAT_BEGIN_NAMESPACE namespace random {
 
 	namespace internal
 	{
@@ -222,6 +222,6 @@ namespace lmat { namespace random {
 	};
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif
@@ -16,7 +16,7 @@
 #include "internal/uniform_real_internal.h"
 #include <light_mat/simd/simd.h>
 
-namespace lmat { namespace random {
+LMAT_BEGIN_NAMESPACE namespace random {
 
 	/********************************************
 	 *
@@ -276,11 +276,10 @@ namespace lmat { namespace random {
 		result_type m_span;
 	};
 
-} }
+} LMAT_END_NAMESPACE
 
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	LMAT_DECL_SIMDIZABLE_ON_REAL( random::std_uniform_real_distr )
 	LMAT_DECL_SIMDIZABLE_ON_REAL( random::uniform_real_distr )
@@ -309,7 +308,7 @@ namespace lmat
 		}
 	};
 
-}
+LMAT_END_NAMESPACE
 
 
 #endif
@@ -18,5 +18,6 @@
 #include <light_mat/simd/avx_arith.h>
 #include <light_mat/simd/avx_pred.h>
 #include <light_mat/simd/avx_reduce.h>
+#include <light_mat/simd/avx_transpose.h>
 
 #endif /* AVX_H_ */
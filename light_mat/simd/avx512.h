@@ -0,0 +1,22 @@
+/**
+ * @file avx512.h
+ *
+ * @brief The overall header to include all AVX-512 related headers
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_AVX512_H_
+#define LIGHTMAT_AVX512_H_
+
+#include <light_mat/simd/avx512_packs.h>
+#include <light_mat/simd/avx512_bpacks.h>
+#include <light_mat/simd/avx512_arith.h>
+#include <light_mat/simd/avx512_pred.h>
+#include <light_mat/simd/avx512_reduce.h>
+
+#endif /* AVX512_H_ */
@@ -0,0 +1,437 @@
+/**
+ * @file avx512_arith.h
+ *
+ * @brief Arithmetics on AVX-512 packs
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_AVX512_ARITH_H_
+#define LIGHTMAT_AVX512_ARITH_H_
+
+#include <light_mat/simd/avx512_packs.h>
+#include <light_mat/simd/avx512_bpacks.h>
+#include <light_mat/math/math_base.h>
+
+LMAT_BEGIN_NAMESPACE namespace meta {
+
+	// arithmetics
+
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( add_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( sub_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( mul_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( div_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( neg_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( fma_ )
+
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( min_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( max_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( clamp_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( cond_ )
+
+	// simple power functions
+
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( abs_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( sqr_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( cube_ )
+
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( rcp_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( sqrt_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( rsqrt_ )
+
+	// rounding
+
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( floor_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( ceil_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( round_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( trunc_ )
+
+} LMAT_END_NAMESPACE
+
+
+LMAT_BEGIN_NAMESPACE
+
+	/********************************************
+	 *
+	 *  Floating-point arithmetics
+	 *
+	 ********************************************/
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk operator + (const avx512_f32pk& a, const avx512_f32pk& b)
+	{
+		return _mm512_add_ps(a, b);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk operator + (const avx512_f64pk& a, const avx512_f64pk& b)
+	{
+		return _mm512_add_pd(a, b);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk operator - (const avx512_f32pk& a, const avx512_f32pk& b)
+	{
+		return _mm512_sub_ps(a, b);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk operator - (const avx512_f64pk& a, const avx512_f64pk& b)
+	{
+		return _mm512_sub_pd(a, b);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk operator * (const avx512_f32pk& a, const avx512_f32pk& b)
+	{
+		return _mm512_mul_ps(a, b);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk operator * (const avx512_f64pk& a, const avx512_f64pk& b)
+	{
+		return _mm512_mul_pd(a, b);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk operator / (const avx512_f32pk& a, const avx512_f32pk& b)
+	{
+		return _mm512_div_ps(a, b);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk operator / (const avx512_f64pk& a, const avx512_f64pk& b)
+	{
+		return _mm512_div_pd(a, b);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk operator - (const avx512_f32pk& a)
+	{
+		typedef internal::num_fmt<float> fmt;
+		return internal::avx512_xor_ps(a, _mm512_set1_epi32(fmt::sign_bit));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk operator - (const avx512_f64pk& a)
+	{
+		typedef internal::num_fmt<double> fmt;
+		return internal::avx512_xor_pd(a, _mm512_set1_epi64(fmt::sign_bit));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk& operator += (avx512_f32pk& a, const avx512_f32pk& b)
+	{
+		a = _mm512_add_ps(a, b);
+		return a;
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk& operator += (avx512_f64pk& a, const avx512_f64pk& b)
+	{
+		a = _mm512_add_pd(a, b);
+		return a;
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk& operator -= (avx512_f32pk& a, const avx512_f32pk& b)
+	{
+		a = _mm512_sub_ps(a, b);
+		return a;
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk& operator -= (avx512_f64pk& a, const avx512_f64pk& b)
+	{
+		a = _mm512_sub_pd(a, b);
+		return a;
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk& operator *= (avx512_f32pk& a, const avx512_f32pk& b)
+	{
+		a = _mm512_mul_ps(a, b);
+		return a;
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk& operator *= (avx512_f64pk& a, const avx512_f64pk& b)
+	{
+		a = _mm512_mul_pd(a, b);
+		return a;
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk& operator /= (avx512_f32pk& a, const avx512_f32pk& b)
+	{
+		a = _mm512_div_ps(a, b);
+		return a;
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk& operator /= (avx512_f64pk& a, const avx512_f64pk& b)
+	{
+		a = _mm512_div_pd(a, b);
+		return a;
+	}
+
+LMAT_END_NAMESPACE
+
+
+LMAT_BEGIN_NAMESPACE  namespace math {
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk fma(const avx512_f32pk& x, const avx512_f32pk& y, const avx512_f32pk& z)
+	{
+		return _mm512_fmadd_ps(x, y, z);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk fma(const avx512_f64pk& x, const avx512_f64pk& y, const avx512_f64pk& z)
+	{
+		return _mm512_fmadd_pd(x, y, z);
+	}
+
+	template<>
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk fmadd(const avx512_f32pk& x, const avx512_f32pk& y, const avx512_f32pk& z)
+	{
+		return fma(x, y, z);
+	}
+
+	template<>
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk fmadd(const avx512_f64pk& x, const avx512_f64pk& y, const avx512_f64pk& z)
+	{
+		return fma(x, y, z);
+	}
+
+
+	/********************************************
+	 *
+	 *  Floating-point min and max
+	 *
+	 ********************************************/
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk (min)(const avx512_f32pk& a, const avx512_f32pk& b)
+	{
+		return _mm512_min_ps(a, b);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk (min)(const avx512_f64pk& a, const avx512_f64pk& b)
+	{
+		return _mm512_min_pd(a, b);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk (max)(const avx512_f32pk& a, const avx512_f32pk& b)
+	{
+		return _mm512_max_ps(a, b);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk (max)(const avx512_f64pk& a, const avx512_f64pk& b)
+	{
+		return _mm512_max_pd(a, b);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk clamp(const avx512_f32pk& x, const avx512_f32pk& lb, const avx512_f32pk& ub)
+	{
+		return (min)((max)(x, lb), ub);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk clamp(const avx512_f64pk& x, const avx512_f64pk& lb, const avx512_f64pk& ub)
+	{
+		return (min)((max)(x, lb), ub);
+	}
+
+	/********************************************
+	 *
+	 *  Simple power functions
+	 *
+	 ********************************************/
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk abs(const avx512_f32pk& a)
+	{
+		typedef lmat::internal::num_fmt<float> fmt;
+		return lmat::internal::avx512_andnot_ps(_mm512_set1_epi32(fmt::sign_bit), a);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk abs(const avx512_f64pk& a)
+	{
+		typedef lmat::internal::num_fmt<double> fmt;
+		return lmat::internal::avx512_andnot_pd(_mm512_set1_epi64(fmt::sign_bit), a);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk sqr(const avx512_f32pk& a)
+	{
+		return _mm512_mul_ps(a, a);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk sqr(const avx512_f64pk& a)
+	{
+		return _mm512_mul_pd(a, a);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk cube(const avx512_f32pk& a)
+	{
+		return _mm512_mul_ps(_mm512_mul_ps(a, a), a);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk cube(const avx512_f64pk& a)
+	{
+		return _mm512_mul_pd(_mm512_mul_pd(a, a), a);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk sqrt(const avx512_f32pk& a)
+	{
+		return _mm512_sqrt_ps(a);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk sqrt(const avx512_f64pk& a)
+	{
+		return _mm512_sqrt_pd(a);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk rcp(const avx512_f32pk& a)
+	{
+		return _mm512_div_ps(_mm512_set1_ps(1.0f), a);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk approx_rcp(const avx512_f32pk& a)
+	{
+		// relative error below 2^-14 (vs. 1.5 * 2^-12 of rcpps)
+		return _mm512_rcp14_ps(a);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk rcp(const avx512_f64pk& a)
+	{
+		return _mm512_div_pd(_mm512_set1_pd(1.0), a);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk approx_rcp(const avx512_f64pk& a)
+	{
+		return _mm512_rcp14_pd(a);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk rsqrt(const avx512_f32pk& a)
+	{
+		return _mm512_div_ps(_mm512_set1_ps(1.0f), _mm512_sqrt_ps(a));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk approx_rsqrt(const avx512_f32pk& a)
+	{
+		return _mm512_rsqrt14_ps(a);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk rsqrt(const avx512_f64pk& a)
+	{
+		return _mm512_div_pd(_mm512_set1_pd(1.0), _mm512_sqrt_pd(a));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk approx_rsqrt(const avx512_f64pk& a)
+	{
+		return _mm512_rsqrt14_pd(a);
+	}
+
+
+	/********************************************
+	 *
+	 *  conditional
+	 *
+	 ********************************************/
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk cond(const avx512_f32bpk& b, const avx512_f32pk& x, const avx512_f32pk& y)
+	{
+		return _mm512_mask_blend_ps(b, y, x);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk cond(const avx512_f64bpk& b, const avx512_f64pk& x, const avx512_f64pk& y)
+	{
+		return _mm512_mask_blend_pd(b, y, x);
+	}
+
+
+	/********************************************
+	 *
+	 *  rounding
+	 *
+	 ********************************************/
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk round(const avx512_f32pk& a)
+	{
+		return _mm512_roundscale_ps(a, 0);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk round(const avx512_f64pk& a)
+	{
+		return _mm512_roundscale_pd(a, 0);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk floor(const avx512_f32pk& a)
+	{
+		return _mm512_roundscale_ps(a, 1);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk floor(const avx512_f64pk& a)
+	{
+		return _mm512_roundscale_pd(a, 1);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk ceil(const avx512_f32pk& a)
+	{
+		return _mm512_roundscale_ps(a, 2);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk ceil(const avx512_f64pk& a)
+	{
+		return _mm512_roundscale_pd(a, 2);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32pk trunc(const avx512_f32pk& a)
+	{
+		return _mm512_roundscale_ps(a, 3);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64pk trunc(const avx512_f64pk& a)
+	{
+		return _mm512_roundscale_pd(a, 3);
+	}
+
+} LMAT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,261 @@
+/**
+ * @file avx512_bpacks.h
+ *
+ * AVX-512 boolean packs
+ *
+ * Unlike SSE and AVX, where a boolean pack is a vector of
+ * lane masks, an AVX-512 boolean pack is held in an opmask,
+ * with one bit per entry.
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_AVX512_BPACKS_H_
+#define LIGHTMAT_AVX512_BPACKS_H_
+
+#include <light_mat/simd/simd_base.h>
+#include "internal/avx512_helpers.h"
+
+LMAT_BEGIN_NAMESPACE
+
+	typedef simd_bpack<float, avx512_t> avx512_f32bpk;
+	typedef simd_bpack<double, avx512_t> avx512_f64bpk;
+
+
+	template<>
+	class simd_bpack<float, avx512_t>
+	{
+	private:
+		__mmask16 m;
+
+	public:
+		typedef int32_t bint_type;
+		static const unsigned int pack_width = 16;
+
+		LMAT_ENSURE_INLINE
+		unsigned int width() const
+		{
+			return pack_width;
+		}
+
+		// constructors
+
+		LMAT_ENSURE_INLINE simd_bpack() { }
+
+		LMAT_ENSURE_INLINE simd_bpack(const __mmask16& m_) : m(m_) { }
+
+		LMAT_ENSURE_INLINE simd_bpack( bool b )
+		{
+			set(b);
+		}
+
+		LMAT_ENSURE_INLINE simd_bpack(
+				bool b0, bool b1, bool b2, bool b3, bool b4, bool b5, bool b6, bool b7,
+				bool b8, bool b9, bool b10, bool b11, bool b12, bool b13, bool b14, bool b15)
+		{
+			set(b0, b1, b2, b3, b4, b5, b6, b7, b8, b9, b10, b11, b12, b13, b14, b15);
+		}
+
+
+		LMAT_ENSURE_INLINE explicit simd_bpack(const bool *p)
+		{
+			load(p);
+		}
+
+
+		LMAT_ENSURE_INLINE
+		static simd_bpack all_false()
+		{
+			return (__mmask16)0;
+		}
+
+		LMAT_ENSURE_INLINE
+		static simd_bpack all_true()
+		{
+			return (__mmask16)0xffff;
+		}
+
+		// converters
+
+	    LMAT_ENSURE_INLINE
+	    operator __mmask16() const
+	    {
+	    	return m;
+	    }
+
+	    // load and store
+
+	    LMAT_ENSURE_INLINE
+	    void load(const bool *p)
+	    {
+	    	__m512i b = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i*)p));
+	    	m = _mm512_test_epi32_mask(b, b);
+	    }
+
+	    LMAT_ENSURE_INLINE
+	    void store(bool *p) const
+	    {
+	    	__m512i b = _mm512_maskz_set1_epi32(m, 1);
+	    	_mm_storeu_si128((__m128i*)p, _mm512_cvtepi32_epi8(b));
+	    }
+
+	    // set values
+
+	    LMAT_ENSURE_INLINE
+	    void set(bool b)
+		{
+	    	m = b ? (__mmask16)0xffff : (__mmask16)0;
+		}
+
+		LMAT_ENSURE_INLINE void set(
+				bool b0, bool b1, bool b2, bool b3, bool b4, bool b5, bool b6, bool b7,
+				bool b8, bool b9, bool b10, bool b11, bool b12, bool b13, bool b14, bool b15)
+		{
+			m = (__mmask16)(
+					 (unsigned)b0        | ((unsigned)b1 << 1)  | ((unsigned)b2 << 2)  | ((unsigned)b3 << 3)  |
+					((unsigned)b4 << 4)  | ((unsigned)b5 << 5)  | ((unsigned)b6 << 6)  | ((unsigned)b7 << 7)  |
+					((unsigned)b8 << 8)  | ((unsigned)b9 << 9)  | ((unsigned)b10 << 10) | ((unsigned)b11 << 11) |
+					((unsigned)b12 << 12) | ((unsigned)b13 << 13) | ((unsigned)b14 << 14) | ((unsigned)b15 << 15));
+		}
+
+		// extract
+
+	    LMAT_ENSURE_INLINE bool to_scalar() const
+	    {
+	    	return (bool)(m & 1u);
+	    }
+
+	    template<unsigned int I>
+	    LMAT_ENSURE_INLINE bool extract(pos_<I> ) const
+	    {
+	    	return (bool)((m >> I) & 1u);
+	    }
+
+	    LMAT_ENSURE_INLINE bint_type operator[] (unsigned int i) const
+	    {
+	    	return -(bint_type)((m >> i) & 1u);
+	    }
+
+	};
+
+
+	template<>
+	class simd_bpack<double, avx512_t>
+	{
+	private:
+		__mmask8 m;
+
+	public:
+		typedef int64_t bint_type;
+		static const unsigned int pack_width = 8;
+
+		LMAT_ENSURE_INLINE
+		unsigned int width() const
+		{
+			return pack_width;
+		}
+
+		// constructors
+
+		LMAT_ENSURE_INLINE simd_bpack() { }
+
+		LMAT_ENSURE_INLINE simd_bpack(const __mmask8& m_) : m(m_) { }
+
+		LMAT_ENSURE_INLINE simd_bpack( bool b )
+		{
+			set(b);
+		}
+
+		LMAT_ENSURE_INLINE simd_bpack(
+				bool b0, bool b1, bool b2, bool b3, bool b4, bool b5, bool b6, bool b7)
+		{
+			set(b0, b1, b2, b3, b4, b5, b6, b7);
+		}
+
+
+		LMAT_ENSURE_INLINE explicit simd_bpack(const bool *p)
+		{
+			load(p);
+		}
+
+
+		LMAT_ENSURE_INLINE
+		static simd_bpack all_false()
+		{
+			return (__mmask8)0;
+		}
+
+		LMAT_ENSURE_INLINE
+		static simd_bpack all_true()
+		{
+			return (__mmask8)0xff;
+		}
+
+		// converters
+
+	    LMAT_ENSURE_INLINE
+	    operator __mmask8() const
+	    {
+	    	return m;
+	    }
+
+	    // load and store
+
+	    LMAT_ENSURE_INLINE
+	    void load(const bool *p)
+	    {
+	    	__m512i b = _mm512_cvtepu8_epi64(_mm_loadl_epi64((const __m128i*)p));
+	    	m = _mm512_test_epi64_mask(b, b);
+	    }
+
+	    LMAT_ENSURE_INLINE
+	    void store(bool *p) const
+	    {
+	    	__m512i b = _mm512_maskz_set1_epi64(m, 1);
+	    	_mm_storel_epi64((__m128i*)p, _mm512_cvtepi64_epi8(b));
+	    }
+
+	    // set values
+
+	    LMAT_ENSURE_INLINE
+	    void set(bool b)
+		{
+	    	m = b ? (__mmask8)0xff : (__mmask8)0;
+		}
+
+		LMAT_ENSURE_INLINE void set(
+				bool b0, bool b1, bool b2, bool b3, bool b4, bool b5, bool b6, bool b7)
+		{
+			m = (__mmask8)(
+					 (unsigned)b0       | ((unsigned)b1 << 1) | ((unsigned)b2 << 2) | ((unsigned)b3 << 3) |
+					((unsigned)b4 << 4) | ((unsigned)b5 << 5) | ((unsigned)b6 << 6) | ((unsigned)b7 << 7));
+		}
+
+		// extract
+
+	    LMAT_ENSURE_INLINE bool to_scalar() const
+	    {
+	    	return (bool)(m & 1u);
+	    }
+
+	    template<unsigned int I>
+	    LMAT_ENSURE_INLINE bool extract(pos_<I> ) const
+	    {
+	    	return (bool)((m >> I) & 1u);
+	    }
+
+	    LMAT_ENSURE_INLINE bint_type operator[] (unsigned int i) const
+	    {
+	    	return -(bint_type)((m >> i) & 1u);
+	    }
+
+	};
+
+LMAT_END_NAMESPACE
+
+
+#endif
@@ -0,0 +1,437 @@
+/**
+ * @file avx512_packs.h
+ *
+ * @brief The AVX-512 pack classes
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_AVX512_PACKS_H_
+#define LIGHTMAT_AVX512_PACKS_H_
+
+#include <light_mat/simd/simd_base.h>
+#include "internal/avx512_helpers.h"
+
+#ifndef LMAT_HAS_AVX512
+#error Only include avx512_packs.h when AVX-512 is enabled.
+#endif
+
+LMAT_BEGIN_NAMESPACE
+
+
+	/********************************************
+	 *
+	 *  trait classes
+	 *
+	 ********************************************/
+
+	LMAT_DEFINE_SIMD_TRAITS( avx512_t, float,  16, 64 )
+	LMAT_DEFINE_SIMD_TRAITS( avx512_t, double,  8, 64 )
+
+
+	/********************************************
+	 *
+	 *  pack classes
+	 *
+	 ********************************************/
+
+	typedef simd_pack<float,  avx512_t> avx512_f32pk;
+	typedef simd_pack<double, avx512_t> avx512_f64pk;
+
+
+	template<>
+	class simd_pack<float, avx512_t>
+	{
+	private:
+		union
+		{
+			__m512 v;
+			LMAT_ALIGN_AVX512 float e[16];
+		};
+
+	public:
+		LMAT_DEFINE_FOR_SIMD_PACK( avx512_t, float, 16 )
+
+		LMAT_ENSURE_INLINE
+		unsigned int width() const
+		{
+			return pack_width;
+		}
+
+		// constructors
+
+		LMAT_ENSURE_INLINE simd_pack() { }
+
+		LMAT_ENSURE_INLINE simd_pack(const __m512& v_) : v(v_) { }
+
+		LMAT_ENSURE_INLINE simd_pack(const float& ev)
+		{
+			v = _mm512_set1_ps(ev);
+		}
+
+		LMAT_ENSURE_INLINE simd_pack(
+				const float& e0, const float& e1, const float& e2, const float& e3,
+				const float& e4, const float& e5, const float& e6, const float& e7,
+				const float& e8, const float& e9, const float& e10, const float& e11,
+				const float& e12, const float& e13, const float& e14, const float& e15)
+		{
+			v = _mm512_setr_ps(e0, e1, e2, e3, e4, e5, e6, e7,
+					e8, e9, e10, e11, e12, e13, e14, e15);
+		}
+
+		LMAT_ENSURE_INLINE explicit simd_pack(const float *p)
+		{
+			load_u(p);
+		}
+
+	    LMAT_ENSURE_INLINE
+	    static simd_pack zeros()
+	    {
+	    	return _mm512_setzero_ps();
+	    }
+
+	    LMAT_ENSURE_INLINE
+	    static simd_pack ones()
+	    {
+	    	return _mm512_set1_ps(1.0f);
+	    }
+
+	    LMAT_ENSURE_INLINE
+	    static simd_pack inf()
+	    {
+	    	return _mm512_castsi512_ps(_mm512_set1_epi32((int)0x7f800000));
+	    }
+
+	    LMAT_ENSURE_INLINE
+	    static simd_pack neg_inf()
+	    {
+	    	return _mm512_castsi512_ps(_mm512_set1_epi32((int)0xff800000));
+	    }
+
+	    LMAT_ENSURE_INLINE
+	    static simd_pack nan()
+	    {
+	    	return _mm512_set1_ps(std::numeric_limits<float>::quiet_NaN());
+	    }
+
+
+	    // converter
+
+	    LMAT_ENSURE_INLINE
+	    operator __m512() const
+	    {
+	    	return v;
+	    }
+
+
+		// set
+
+		LMAT_ENSURE_INLINE void reset()
+		{
+			v = _mm512_setzero_ps();
+		}
+
+		LMAT_ENSURE_INLINE void set(const float& ev)
+		{
+			v = _mm512_set1_ps(ev);
+		}
+
+		LMAT_ENSURE_INLINE void set(
+				const float& e0, const float& e1, const float& e2, const float& e3,
+				const float& e4, const float& e5, const float& e6, const float& e7,
+				const float& e8, const float& e9, const float& e10, const float& e11,
+				const float& e12, const float& e13, const float& e14, const float& e15)
+		{
+			v = _mm512_setr_ps(e0, e1, e2, e3, e4, e5, e6, e7,
+					e8, e9, e10, e11, e12, e13, e14, e15);
+		}
+
+
+		// load
+
+		LMAT_ENSURE_INLINE void load_u(const float *p)
+		{
+			v = _mm512_loadu_ps(p);
+		}
+
+		LMAT_ENSURE_INLINE void load_a(const float *p)
+		{
+			v = _mm512_load_ps(p);
+		}
+
+		template<unsigned int N>
+	    LMAT_ENSURE_INLINE void load_part(siz_<N> n, const float *p)
+	    {
+	    	v = _mm512_maskz_loadu_ps(internal::avx512_part_mask_32(n), p);
+	    }
+
+		// run-time part size: only the first n entries are touched in memory,
+		// and the remaining entries of the pack are set to zeros
+
+	    LMAT_ENSURE_INLINE void load_part(unsigned int n, const float *p)
+	    {
+	    	v = _mm512_maskz_loadu_ps(internal::avx512_part_mask_32(n), p);
+	    }
+
+	    // store
+
+	    LMAT_ENSURE_INLINE void store_u(float *p) const
+	    {
+	    	_mm512_storeu_ps(p, v);
+	    }
+
+	    LMAT_ENSURE_INLINE void store_a(float *p) const
+	    {
+	    	_mm512_store_ps(p, v);
+	    }
+
+	    template<unsigned int N>
+	    LMAT_ENSURE_INLINE void store_part(siz_<N> n, float *p) const
+	    {
+	    	_mm512_mask_storeu_ps(p, internal::avx512_part_mask_32(n), v);
+	    }
+
+	    LMAT_ENSURE_INLINE void store_part(unsigned int n, float *p) const
+	    {
+	    	_mm512_mask_storeu_ps(p, internal::avx512_part_mask_32(n), v);
+	    }
+
+
+	    // extract
+
+	    LMAT_ENSURE_INLINE __m256 get_low() const
+	    {
+	    	return internal::avx512_low_ps(v);
+	    }
+
+	    LMAT_ENSURE_INLINE __m256 get_high() const
+	    {
+	    	return internal::avx512_high_ps(v);
+	    }
+
+	    LMAT_ENSURE_INLINE float to_scalar() const
+	    {
+	    	return _mm512_cvtss_f32(v);
+	    }
+
+	    template<unsigned int I>
+	    LMAT_ENSURE_INLINE float extract(pos_<I> p) const
+	    {
+	    	return internal::avx512_extract_f32(v, p);
+	    }
+
+	    LMAT_ENSURE_INLINE float operator[] (unsigned int i) const
+	    {
+	    	return e[i];
+	    }
+
+	    // broadcast
+
+	    template<unsigned int I>
+	    LMAT_ENSURE_INLINE simd_pack broadcast(pos_<I> p) const
+	    {
+	    	return internal::avx512_broadcast_f32(v, p);
+	    }
+
+
+	}; // AVX-512 f32 pack
+
+
+	template<>
+	class simd_pack<double, avx512_t>
+	{
+	private:
+		union
+		{
+			__m512d v;
+			LMAT_ALIGN_AVX512 double e[8];
+		};
+
+	public:
+		LMAT_DEFINE_FOR_SIMD_PACK( avx512_t, double, 8 )
+
+		LMAT_ENSURE_INLINE
+		unsigned int width() const
+		{
+			return pack_width;
+		}
+
+		// constructors
+
+		LMAT_ENSURE_INLINE simd_pack() { }
+
+		LMAT_ENSURE_INLINE simd_pack(const __m512d& v_) : v(v_) { }
+
+		LMAT_ENSURE_INLINE simd_pack(const double& ev)
+		{
+			v = _mm512_set1_pd(ev);
+		}
+
+		LMAT_ENSURE_INLINE simd_pack(
+				const double& e0, const double& e1, const double& e2, const double& e3,
+				const double& e4, const double& e5, const double& e6, const double& e7)
+		{
+			v = _mm512_setr_pd(e0, e1, e2, e3, e4, e5, e6, e7);
+		}
+
+		LMAT_ENSURE_INLINE
+		explicit simd_pack(const double *p)
+		{
+			load_u(p);
+		}
+
+	    LMAT_ENSURE_INLINE
+	    static simd_pack zeros()
+	    {
+	    	return _mm512_setzero_pd();
+	    }
+
+	    LMAT_ENSURE_INLINE
+	    static simd_pack ones()
+	    {
+	    	return _mm512_set1_pd(1.0);
+	    }
+
+	    LMAT_ENSURE_INLINE
+	    static simd_pack inf()
+	    {
+	    	return _mm512_castsi512_pd(
+	    			_mm512_set1_epi64((int64_t)0x7ff0000000000000LL));
+	    }
+
+	    LMAT_ENSURE_INLINE
+	    static simd_pack neg_inf()
+	    {
+	    	return _mm512_castsi512_pd(
+	    			_mm512_set1_epi64((int64_t)0xfff0000000000000LL));
+	    }
+
+	    LMAT_ENSURE_INLINE
+	    static simd_pack nan()
+	    {
+	    	return _mm512_set1_pd(std::numeric_limits<double>::quiet_NaN());
+	    }
+
+
+	    // converters
+
+	    LMAT_ENSURE_INLINE
+	    operator __m512d() const
+	    {
+	    	return v;
+	    }
+
+
+		// set
+
+		LMAT_ENSURE_INLINE void reset()
+		{
+			v = _mm512_setzero_pd();
+		}
+
+		LMAT_ENSURE_INLINE void set(const double& ev)
+		{
+			v = _mm512_set1_pd(ev);
+		}
+
+		LMAT_ENSURE_INLINE void set(
+				const double& e0, const double& e1, const double& e2, const double& e3,
+				const double& e4, const double& e5, const double& e6, const double& e7)
+		{
+			v = _mm512_setr_pd(e0, e1, e2, e3, e4, e5, e6, e7);
+		}
+
+
+		// load
+
+		LMAT_ENSURE_INLINE void load_u(const double *p)
+		{
+			v = _mm512_loadu_pd(p);
+		}
+
+		LMAT_ENSURE_INLINE void load_a(const double *p)
+		{
+			v = _mm512_load_pd(p);
+		}
+
+		template<unsigned int N>
+	    LMAT_ENSURE_INLINE void load_part(siz_<N> n, const double *p)
+	    {
+	    	v = _mm512_maskz_loadu_pd(internal::avx512_part_mask_64(n), p);
+	    }
+
+	    LMAT_ENSURE_INLINE void load_part(unsigned int n, const double *p)
+	    {
+	    	v = _mm512_maskz_loadu_pd(internal::avx512_part_mask_64(n), p);
+	    }
+
+	    // store
+
+	    LMAT_ENSURE_INLINE void store_u(double *p) const
+	    {
+	    	_mm512_storeu_pd(p, v);
+	    }
+
+	    LMAT_ENSURE_INLINE void store_a(double *p) const
+	    {
+	    	_mm512_store_pd(p, v);
+	    }
+
+	    template<unsigned int N>
+	    LMAT_ENSURE_INLINE void store_part(siz_<N> n, double *p) const
+	    {
+	    	_mm512_mask_storeu_pd(p, internal::avx512_part_mask_64(n), v);
+	    }
+
+	    LMAT_ENSURE_INLINE void store_part(unsigned int n, double *p) const
+	    {
+	    	_mm512_mask_storeu_pd(p, internal::avx512_part_mask_64(n), v);
+	    }
+
+	    // extract
+
+	    LMAT_ENSURE_INLINE __m256d get_low() const
+	    {
+	    	return internal::avx512_low_pd(v);
+	    }
+
+	    LMAT_ENSURE_INLINE __m256d get_high() const
+	    {
+	    	return internal::avx512_high_pd(v);
+	    }
+
+	    LMAT_ENSURE_INLINE double to_scalar() const
+	    {
+	    	return _mm512_cvtsd_f64(v);
+	    }
+
+	    template<unsigned int I>
+	    LMAT_ENSURE_INLINE double extract(pos_<I> p) const
+	    {
+	    	return internal::avx512_extract_f64(v, p);
+	    }
+
+	    LMAT_ENSURE_INLINE double operator[] (unsigned int i) const
+	    {
+	    	return e[i];
+	    }
+
+	    // broadcast
+
+	    template<unsigned int I>
+	    LMAT_ENSURE_INLINE simd_pack broadcast(pos_<I> p) const
+	    {
+	    	return internal::avx512_broadcast_f64(v, p);
+	    }
+
+	}; // AVX-512 f64 pack
+
+
+LMAT_END_NAMESPACE
+
+
+#endif
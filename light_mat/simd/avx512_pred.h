@@ -0,0 +1,299 @@
+/**
+ * @file avx512_pred.h
+ *
+ * @brief AVX-512 predicates
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_AVX512_PRED_H_
+#define LIGHTMAT_AVX512_PRED_H_
+
+#include <light_mat/simd/avx512_packs.h>
+#include <light_mat/simd/avx512_bpacks.h>
+#include "internal/numrepr_format.h"
+
+LMAT_BEGIN_NAMESPACE namespace meta {
+
+	// comparison
+
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( eq_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( ne_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( gt_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( ge_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( lt_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( le_ )
+
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( logical_not_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( logical_and_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( logical_or_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( logical_eq_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( logical_ne_ )
+
+	// numeric predicates
+
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( signbit_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( isfinite_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( isinf_ )
+	LMAT_DEFINE_HAS_AVX512_SUPPORT( isnan_ )
+
+} LMAT_END_NAMESPACE
+
+
+LMAT_BEGIN_NAMESPACE
+
+	/********************************************
+	 *
+	 *  comparison operator
+	 *
+	 ********************************************/
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32bpk operator == (const avx512_f32pk& a, const avx512_f32pk& b)
+	{
+		return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64bpk operator == (const avx512_f64pk& a, const avx512_f64pk& b)
+	{
+		return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32bpk operator != (const avx512_f32pk& a, const avx512_f32pk& b)
+	{
+		return _mm512_cmp_ps_mask(a, b, _CMP_NEQ_OQ);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64bpk operator != (const avx512_f64pk& a, const avx512_f64pk& b)
+	{
+		return _mm512_cmp_pd_mask(a, b, _CMP_NEQ_OQ);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32bpk operator > (const avx512_f32pk& a, const avx512_f32pk& b)
+	{
+		return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64bpk operator > (const avx512_f64pk& a, const avx512_f64pk& b)
+	{
+		return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32bpk operator >= (const avx512_f32pk& a, const avx512_f32pk& b)
+	{
+		return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64bpk operator >= (const avx512_f64pk& a, const avx512_f64pk& b)
+	{
+		return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32bpk operator < (const avx512_f32pk& a, const avx512_f32pk& b)
+	{
+		return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64bpk operator < (const avx512_f64pk& a, const avx512_f64pk& b)
+	{
+		return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ);
+	}
+
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32bpk operator <= (const avx512_f32pk& a, const avx512_f32pk& b)
+	{
+		return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64bpk operator <= (const avx512_f64pk& a, const avx512_f64pk& b)
+	{
+		return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ);
+	}
+
+
+	/********************************************
+	 *
+	 *  logical operations
+	 *
+	 ********************************************/
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32bpk operator ~ (const avx512_f32bpk& a)
+	{
+		return (__mmask16)(~(__mmask16)a & 0xffff);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64bpk operator ~ (const avx512_f64bpk& a)
+	{
+		return (__mmask8)(~(__mmask8)a & 0xff);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32bpk operator & (const avx512_f32bpk& a, const avx512_f32bpk& b)
+	{
+		return (__mmask16)((__mmask16)a & (__mmask16)b);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64bpk operator & (const avx512_f64bpk& a, const avx512_f64bpk& b)
+	{
+		return (__mmask8)((__mmask8)a & (__mmask8)b);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32bpk operator | (const avx512_f32bpk& a, const avx512_f32bpk& b)
+	{
+		return (__mmask16)((__mmask16)a | (__mmask16)b);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64bpk operator | (const avx512_f64bpk& a, const avx512_f64bpk& b)
+	{
+		return (__mmask8)((__mmask8)a | (__mmask8)b);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32bpk operator != (const avx512_f32bpk& a, const avx512_f32bpk& b)
+	{
+		return (__mmask16)((__mmask16)a ^ (__mmask16)b);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64bpk operator != (const avx512_f64bpk& a, const avx512_f64bpk& b)
+	{
+		return (__mmask8)((__mmask8)a ^ (__mmask8)b);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32bpk operator == (const avx512_f32bpk& a, const avx512_f32bpk& b)
+	{
+		return ~(a != b);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64bpk operator == (const avx512_f64bpk& a, const avx512_f64bpk& b)
+	{
+		return ~(a != b);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32bpk& operator &= (avx512_f32bpk& a, const avx512_f32bpk& b)
+	{
+		a = a & b;
+		return a;
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64bpk& operator &= (avx512_f64bpk& a, const avx512_f64bpk& b)
+	{
+		a = a & b;
+		return a;
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32bpk& operator |= (avx512_f32bpk& a, const avx512_f32bpk& b)
+	{
+		a = a | b;
+		return a;
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64bpk& operator |= (avx512_f64bpk& a, const avx512_f64bpk& b)
+	{
+		a = a | b;
+		return a;
+	}
+
+LMAT_END_NAMESPACE
+
+
+LMAT_BEGIN_NAMESPACE namespace math {
+
+	/********************************************
+	 *
+	 *  FP classification
+	 *
+	 ********************************************/
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32bpk signbit(const avx512_f32pk& a)
+	{
+		typedef lmat::internal::num_fmt<float> fmt;
+		return _mm512_test_epi32_mask(_mm512_castps_si512(a), _mm512_set1_epi32(fmt::sign_bit));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64bpk signbit(const avx512_f64pk& a)
+	{
+		typedef lmat::internal::num_fmt<double> fmt;
+		return _mm512_test_epi64_mask(_mm512_castpd_si512(a), _mm512_set1_epi64(fmt::sign_bit));
+	}
+
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32bpk isfinite(const avx512_f32pk& a)
+	{
+		typedef lmat::internal::num_fmt<float> fmt;
+		const __m512i e = _mm512_set1_epi32(fmt::exponent_bits);
+		return _mm512_cmpneq_epi32_mask(_mm512_and_si512(_mm512_castps_si512(a), e), e);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64bpk isfinite(const avx512_f64pk& a)
+	{
+		typedef lmat::internal::num_fmt<double> fmt;
+		const __m512i e = _mm512_set1_epi64(fmt::exponent_bits);
+		return _mm512_cmpneq_epi64_mask(_mm512_and_si512(_mm512_castpd_si512(a), e), e);
+	}
+
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32bpk isinf(const avx512_f32pk& a)
+	{
+		typedef lmat::internal::num_fmt<float> fmt;
+		return _mm512_cmpeq_epi32_mask(
+				_mm512_andnot_si512(_mm512_set1_epi32(fmt::sign_bit), _mm512_castps_si512(a)),
+				_mm512_set1_epi32(fmt::exponent_bits));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64bpk isinf(const avx512_f64pk& a)
+	{
+		typedef lmat::internal::num_fmt<double> fmt;
+		return _mm512_cmpeq_epi64_mask(
+				_mm512_andnot_si512(_mm512_set1_epi64(fmt::sign_bit), _mm512_castpd_si512(a)),
+				_mm512_set1_epi64(fmt::exponent_bits));
+	}
+
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f32bpk isnan(const avx512_f32pk& a)
+	{
+		return _mm512_cmp_ps_mask(a, a, _CMP_UNORD_Q);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline avx512_f64bpk isnan(const avx512_f64pk& a)
+	{
+		return _mm512_cmp_pd_mask(a, a, _CMP_UNORD_Q);
+	}
+
+} LMAT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,120 @@
+/**
+ * @file avx512_reduce.h
+ *
+ * Reduction on AVX-512 packs
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_AVX512_REDUCE_H_
+#define LIGHTMAT_AVX512_REDUCE_H_
+
+#include <light_mat/simd/avx512_packs.h>
+#include <light_mat/simd/avx512_bpacks.h>
+#include <light_mat/simd/avx_reduce.h>
+
+LMAT_BEGIN_NAMESPACE
+
+	// numeric reduction
+
+	LMAT_ENSURE_INLINE
+	inline float sum(const avx512_f32pk& a)
+	{
+		avx_f32pk t = _mm256_add_ps(a.get_low(), a.get_high());
+		return sum(t);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline double sum(const avx512_f64pk& a)
+	{
+		avx_f64pk t = _mm256_add_pd(a.get_low(), a.get_high());
+		return sum(t);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline float maximum(const avx512_f32pk& a)
+	{
+		avx_f32pk t = _mm256_max_ps(a.get_low(), a.get_high());
+		return maximum(t);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline double maximum(const avx512_f64pk& a)
+	{
+		avx_f64pk t = _mm256_max_pd(a.get_low(), a.get_high());
+		return maximum(t);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline float minimum(const avx512_f32pk& a)
+	{
+		avx_f32pk t = _mm256_min_ps(a.get_low(), a.get_high());
+		return minimum(t);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline double minimum(const avx512_f64pk& a)
+	{
+		avx_f64pk t = _mm256_min_pd(a.get_low(), a.get_high());
+		return minimum(t);
+	}
+
+
+	// all & any
+
+	LMAT_ENSURE_INLINE
+	inline bool all_true(const avx512_f32bpk& a)
+	{
+		return (__mmask16)a == (__mmask16)0xffff;
+	}
+
+	LMAT_ENSURE_INLINE
+	inline bool all_true(const avx512_f64bpk& a)
+	{
+		return (__mmask8)a == (__mmask8)0xff;
+	}
+
+	LMAT_ENSURE_INLINE
+	inline bool all_false(const avx512_f32bpk& a)
+	{
+		return (__mmask16)a == 0;
+	}
+
+	LMAT_ENSURE_INLINE
+	inline bool all_false(const avx512_f64bpk& a)
+	{
+		return (__mmask8)a == 0;
+	}
+
+
+	LMAT_ENSURE_INLINE
+	inline bool any_true(const avx512_f32bpk& a)
+	{
+		return !all_false(a);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline bool any_true(const avx512_f64bpk& a)
+	{
+		return !all_false(a);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline bool any_false(const avx512_f32bpk& a)
+	{
+		return !all_true(a);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline bool any_false(const avx512_f64bpk& a)
+	{
+		return !all_true(a);
+	}
+
+LMAT_END_NAMESPACE
+
+#endif
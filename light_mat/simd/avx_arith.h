@@ -15,8 +15,9 @@
 
 #include <light_mat/simd/avx_packs.h>
 #include <light_mat/simd/avx_bpacks.h>
+#include <light_mat/math/math_base.h>
 
-namespace lmat { namespace meta {
+LMAT_BEGIN_NAMESPACE namespace meta {
 
 	// arithmetics
 
@@ -49,11 +50,10 @@ namespace lmat { namespace meta {
 	LMAT_DEFINE_HAS_AVX_SUPPORT( round_ )
 	LMAT_DEFINE_HAS_AVX_SUPPORT( trunc_ )
 
-} }
+} LMAT_END_NAMESPACE
 
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	/********************************************
 	 *
@@ -179,21 +179,43 @@ namespace lmat
 		return a;
 	}
 
-}
+LMAT_END_NAMESPACE
 
 
-namespace lmat {  namespace math {
+LMAT_BEGIN_NAMESPACE  namespace math {
 
 	LMAT_ENSURE_INLINE
 	inline avx_f32pk fma(const avx_f32pk& x, const avx_f32pk& y, const avx_f32pk& z)
 	{
+#ifdef LMAT_HAS_FMA
+		return _mm256_fmadd_ps(x, y, z);
+#else
 		return _mm256_add_ps(_mm256_mul_ps(x, y), z);
+#endif
 	}
 
 	LMAT_ENSURE_INLINE
 	inline avx_f64pk fma(const avx_f64pk& x, const avx_f64pk& y, const avx_f64pk& z)
 	{
+#ifdef LMAT_HAS_FMA
+		return _mm256_fmadd_pd(x, y, z);
+#else
 		return _mm256_add_pd(_mm256_mul_pd(x, y), z);
+#endif
+	}
+
+	template<>
+	LMAT_ENSURE_INLINE
+	inline avx_f32pk fmadd(const avx_f32pk& x, const avx_f32pk& y, const avx_f32pk& z)
+	{
+		return fma(x, y, z);
+	}
+
+	template<>
+	LMAT_ENSURE_INLINE
+	inline avx_f64pk fmadd(const avx_f64pk& x, const avx_f64pk& y, const avx_f64pk& z)
+	{
+		return fma(x, y, z);
 	}
 
 
@@ -313,6 +335,13 @@ namespace lmat {  namespace math {
 		return _mm256_div_pd(_mm256_set1_pd(1.0), a);
 	}
 
+	LMAT_ENSURE_INLINE
+	inline avx_f64pk approx_rcp(const avx_f64pk& a)
+	{
+		// f32 estimate: valid within the f32 range
+		return _mm256_cvtps_pd(_mm_rcp_ps(_mm256_cvtpd_ps(a)));
+	}
+
 	LMAT_ENSURE_INLINE
 	inline avx_f32pk rsqrt(const avx_f32pk& a)
 	{
@@ -331,6 +360,13 @@ namespace lmat {  namespace math {
 		return _mm256_div_pd(_mm256_set1_pd(1.0), _mm256_sqrt_pd(a));
 	}
 
+	LMAT_ENSURE_INLINE
+	inline avx_f64pk approx_rsqrt(const avx_f64pk& a)
+	{
+		// f32 estimate: valid within the f32 range
+		return _mm256_cvtps_pd(_mm_rsqrt_ps(_mm256_cvtpd_ps(a)));
+	}
+
 
 	/********************************************
 	 *
@@ -405,6 +441,6 @@ namespace lmat {  namespace math {
 		return _mm256_round_pd(a, 3);
 	}
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif
@@ -15,9 +15,9 @@
 
 #include <light_mat/simd/simd_base.h>
 #include "internal/avx_helpers.h"
+#include <cstring>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	typedef simd_bpack<float, avx_t> avx_f32bpk;
 	typedef simd_bpack<double, avx_t> avx_f64bpk;
@@ -92,7 +92,13 @@ namespace lmat
 	    LMAT_ENSURE_INLINE
 	    void load(const bool *p)
 	    {
+#ifdef LMAT_HAS_AVX2
+	    	// widen the eight bytes (0 or 1) and negate them into lane masks
+	    	__m256i b = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)p));
+	    	v = _mm256_castsi256_ps(_mm256_sub_epi32(_mm256_setzero_si256(), b));
+#else
 	    	set(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]);
+#endif
 	    }
 
 	    LMAT_ENSURE_INLINE
@@ -233,7 +239,14 @@ namespace lmat
 	    LMAT_ENSURE_INLINE
 	    void load(const bool *p)
 	    {
+#ifdef LMAT_HAS_AVX2
+	    	int32_t w;
+	    	std::memcpy(&w, p, sizeof(w));
+	    	__m256i b = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(w));
+	    	v = _mm256_castsi256_pd(_mm256_sub_epi64(_mm256_setzero_si256(), b));
+#else
 	    	set(p[0], p[1], p[2], p[3]);
+#endif
 	    }
 
 	    LMAT_ENSURE_INLINE
@@ -299,7 +312,7 @@ namespace lmat
 
 	};
 
-}
+LMAT_END_NAMESPACE
 
 
 #endif 
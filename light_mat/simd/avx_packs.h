@@ -20,8 +20,7 @@
 #error Only include avx_packs.h when AVX is enabled.
 #endif
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 
 	/********************************************
@@ -401,7 +400,7 @@ namespace lmat
 	}; // AVX f64 pack
 
 
-}
+LMAT_END_NAMESPACE
 
 
 #endif
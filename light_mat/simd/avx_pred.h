@@ -16,8 +16,9 @@
 #include <light_mat/simd/avx_packs.h>
 #include <light_mat/simd/avx_bpacks.h>
 #include "internal/sse_fpclass_impl.h"
+#include "internal/avx2_fpclass_impl.h"
 
-namespace lmat { namespace meta {
+LMAT_BEGIN_NAMESPACE namespace meta {
 
 	// comparison
 
@@ -41,11 +42,10 @@ namespace lmat { namespace meta {
 	LMAT_DEFINE_HAS_AVX_SUPPORT( isinf_ )
 	LMAT_DEFINE_HAS_AVX_SUPPORT( isnan_ )
 
-} }
+} LMAT_END_NAMESPACE
 
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	/********************************************
 	 *
@@ -133,6 +133,11 @@ namespace lmat
 	 *
 	 ********************************************/
 
+	// These stay in the floating-point domain with AVX2 as well:
+	// each is a single 256-bit instruction already, and the masks
+	// come from (and go to) floating-point compares and blends,
+	// so the integer forms would only add bypass delays.
+
 	LMAT_ENSURE_INLINE
 	inline avx_f32bpk operator ~ (const avx_f32bpk& a)
 	{
@@ -221,10 +226,10 @@ namespace lmat
 		return a;
 	}
 
-}
+LMAT_END_NAMESPACE
 
 
-namespace lmat { namespace math {
+LMAT_BEGIN_NAMESPACE namespace math {
 
 	/********************************************
 	 *
@@ -235,70 +240,102 @@ namespace lmat { namespace math {
 	LMAT_ENSURE_INLINE
 	inline avx_f32bpk signbit(const avx_f32pk& a)
 	{
+#ifdef LMAT_HAS_AVX2
+		return lmat::internal::avx2_is_neg_ps(a);
+#else
 		return lmat::internal::combine_m128(
 				lmat::internal::sse_is_neg_ps(a.get_low()),
 				lmat::internal::sse_is_neg_ps(a.get_high()));
+#endif
 	}
 
 	LMAT_ENSURE_INLINE
 	inline avx_f64bpk signbit(const avx_f64pk& a)
 	{
+#ifdef LMAT_HAS_AVX2
+		return lmat::internal::avx2_is_neg_pd(a);
+#else
 		return lmat::internal::combine_m128d(
 				lmat::internal::sse_is_neg_pd(a.get_low()),
 				lmat::internal::sse_is_neg_pd(a.get_high()));
+#endif
 	}
 
 
 	LMAT_ENSURE_INLINE
 	inline avx_f32bpk isfinite(const avx_f32pk& a)
 	{
+#ifdef LMAT_HAS_AVX2
+		return lmat::internal::avx2_is_finite_ps(a);
+#else
 		return lmat::internal::combine_m128(
 				lmat::internal::sse_is_finite_ps(a.get_low()),
 				lmat::internal::sse_is_finite_ps(a.get_high()));
+#endif
 	}
 
 	LMAT_ENSURE_INLINE
 	inline avx_f64bpk isfinite(const avx_f64pk& a)
 	{
+#ifdef LMAT_HAS_AVX2
+		return lmat::internal::avx2_is_finite_pd(a);
+#else
 		return lmat::internal::combine_m128d(
 				lmat::internal::sse_is_finite_pd(a.get_low()),
 				lmat::internal::sse_is_finite_pd(a.get_high()));
+#endif
 	}
 
 
 	LMAT_ENSURE_INLINE
 	inline avx_f32bpk isinf(const avx_f32pk& a)
 	{
+#ifdef LMAT_HAS_AVX2
+		return lmat::internal::avx2_is_inf_ps(a);
+#else
 		return lmat::internal::combine_m128(
 				lmat::internal::sse_is_inf_ps(a.get_low()),
 				lmat::internal::sse_is_inf_ps(a.get_high()));
+#endif
 	}
 
 	LMAT_ENSURE_INLINE
 	inline avx_f64bpk isinf(const avx_f64pk& a)
 	{
+#ifdef LMAT_HAS_AVX2
+		return lmat::internal::avx2_is_inf_pd(a);
+#else
 		return lmat::internal::combine_m128d(
 				lmat::internal::sse_is_inf_pd(a.get_low()),
 				lmat::internal::sse_is_inf_pd(a.get_high()));
+#endif
 	}
 
 
 	LMAT_ENSURE_INLINE
 	inline avx_f32bpk isnan(const avx_f32pk& a)
 	{
+#ifdef LMAT_HAS_AVX2
+		return lmat::internal::avx2_is_nan_ps(a);
+#else
 		return lmat::internal::combine_m128(
 				lmat::internal::sse_is_nan_ps(a.get_low()),
 				lmat::internal::sse_is_nan_ps(a.get_high()));
+#endif
 	}
 
 	LMAT_ENSURE_INLINE
 	inline avx_f64bpk isnan(const avx_f64pk& a)
 	{
+#ifdef LMAT_HAS_AVX2
+		return lmat::internal::avx2_is_nan_pd(a);
+#else
 		return lmat::internal::combine_m128d(
 				lmat::internal::sse_is_nan_pd(a.get_low()),
 				lmat::internal::sse_is_nan_pd(a.get_high()));
+#endif
 	}
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif
@@ -17,8 +17,7 @@
 #include <light_mat/simd/avx_bpacks.h>
 #include <light_mat/simd/sse_reduce.h>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	// numeric reduction
 
@@ -116,6 +115,6 @@ namespace lmat
 		return !all_true(a);
 	}
 
-}
+LMAT_END_NAMESPACE
 
 #endif 
@@ -0,0 +1,71 @@
+/**
+ * @file avx_transpose.h
+ *
+ * @brief In-register transposition of AVX packs
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_AVX_TRANSPOSE_H_
+#define LIGHTMAT_AVX_TRANSPOSE_H_
+
+#include <light_mat/simd/avx_packs.h>
+
+LMAT_BEGIN_NAMESPACE
+
+	// transpose 2 x 2 blocks within lanes, then swap the
+	// off-diagonal 128-bit halves across registers
+
+	LMAT_ENSURE_INLINE
+	inline void transpose(avx_f32pk& a0, avx_f32pk& a1, avx_f32pk& a2, avx_f32pk& a3,
+			avx_f32pk& a4, avx_f32pk& a5, avx_f32pk& a6, avx_f32pk& a7)
+	{
+		__m256 t0 = _mm256_unpacklo_ps(a0, a1);
+		__m256 t1 = _mm256_unpackhi_ps(a0, a1);
+		__m256 t2 = _mm256_unpacklo_ps(a2, a3);
+		__m256 t3 = _mm256_unpackhi_ps(a2, a3);
+		__m256 t4 = _mm256_unpacklo_ps(a4, a5);
+		__m256 t5 = _mm256_unpackhi_ps(a4, a5);
+		__m256 t6 = _mm256_unpacklo_ps(a6, a7);
+		__m256 t7 = _mm256_unpackhi_ps(a6, a7);
+
+		__m256 u0 = _mm256_shuffle_ps(t0, t2, 0x44);
+		__m256 u1 = _mm256_shuffle_ps(t0, t2, 0xee);
+		__m256 u2 = _mm256_shuffle_ps(t1, t3, 0x44);
+		__m256 u3 = _mm256_shuffle_ps(t1, t3, 0xee);
+		__m256 u4 = _mm256_shuffle_ps(t4, t6, 0x44);
+		__m256 u5 = _mm256_shuffle_ps(t4, t6, 0xee);
+		__m256 u6 = _mm256_shuffle_ps(t5, t7, 0x44);
+		__m256 u7 = _mm256_shuffle_ps(t5, t7, 0xee);
+
+		a0 = _mm256_permute2f128_ps(u0, u4, 0x20);
+		a1 = _mm256_permute2f128_ps(u1, u5, 0x20);
+		a2 = _mm256_permute2f128_ps(u2, u6, 0x20);
+		a3 = _mm256_permute2f128_ps(u3, u7, 0x20);
+		a4 = _mm256_permute2f128_ps(u0, u4, 0x31);
+		a5 = _mm256_permute2f128_ps(u1, u5, 0x31);
+		a6 = _mm256_permute2f128_ps(u2, u6, 0x31);
+		a7 = _mm256_permute2f128_ps(u3, u7, 0x31);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline void transpose(avx_f64pk& a0, avx_f64pk& a1, avx_f64pk& a2, avx_f64pk& a3)
+	{
+		__m256d t0 = _mm256_unpacklo_pd(a0, a1);
+		__m256d t1 = _mm256_unpackhi_pd(a0, a1);
+		__m256d t2 = _mm256_unpacklo_pd(a2, a3);
+		__m256d t3 = _mm256_unpackhi_pd(a2, a3);
+
+		a0 = _mm256_permute2f128_pd(t0, t2, 0x20);
+		a1 = _mm256_permute2f128_pd(t1, t3, 0x20);
+		a2 = _mm256_permute2f128_pd(t0, t2, 0x31);
+		a3 = _mm256_permute2f128_pd(t1, t3, 0x31);
+	}
+
+LMAT_END_NAMESPACE
+
+#endif /* AVX_TRANSPOSE_H_ */
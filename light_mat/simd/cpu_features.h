@@ -0,0 +1,176 @@
+/**
+ * @file cpu_features.h
+ *
+ * @brief Run-time detection of CPU SIMD features
+ *
+ * Unlike simd_arch.h, which reflects the instruction sets
+ * that the compiler is allowed to use, the functions here
+ * query the processor that the program is running on.
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_CPU_FEATURES_H_
+#define LIGHTMAT_CPU_FEATURES_H_
+
+#include <light_mat/common/basic_defs.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+LMAT_BEGIN_NAMESPACE
+	/********************************************
+	 *
+	 *  feature set
+	 *
+	 ********************************************/
+
+	struct cpu_features
+	{
+		bool sse2;
+		bool sse3;
+		bool ssse3;
+		bool sse4_1;
+		bool sse4_2;
+		bool avx;
+		bool avx2;
+		bool fma;
+		bool avx512f;
+
+		/**
+		 * The highest SIMD level supported by both the processor
+		 * and the operating system, on the scale of LMAT_SIMD_LEVEL.
+		 *
+		 * Level 8 (AVX2) also requires FMA3, as AVX2 code is compiled
+		 * with FMA enabled (see simd_dispatch.h).
+		 */
+		int simd_level() const
+		{
+			if (avx512f) return 9;
+			if (avx2 && fma) return 8;
+			if (avx) return 7;
+			if (sse4_2) return 6;
+			if (sse4_1) return 5;
+			if (ssse3) return 4;
+			if (sse3) return 3;
+			if (sse2) return 2;
+			return 0;
+		}
+	};
+
+
+	/********************************************
+	 *
+	 *  detection
+	 *
+	 ********************************************/
+
+	namespace internal
+	{
+		inline void _cpuid(unsigned int leaf, unsigned int subleaf, unsigned int *r)
+		{
+#ifdef _MSC_VER
+			int regs[4];
+			__cpuidex(regs, (int)leaf, (int)subleaf);
+			for (int i = 0; i < 4; ++i) r[i] = (unsigned int)regs[i];
+#else
+			__cpuid_count(leaf, subleaf, r[0], r[1], r[2], r[3]);
+#endif
+		}
+
+		inline unsigned int _cpuid_max_leaf()
+		{
+			unsigned int r[4];
+			_cpuid(0, 0, r);
+			return r[0];
+		}
+
+		// the low 32 bits of XCR0, which tell which register states the OS saves
+
+		inline unsigned int _xgetbv0()
+		{
+#ifdef _MSC_VER
+			return (unsigned int)_xgetbv(0);
+#else
+			unsigned int eax, edx;
+			__asm__ __volatile__ ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+			return eax;
+#endif
+		}
+
+		inline bool _bit(unsigned int x, int i)
+		{
+			return ((x >> i) & 1u) != 0;
+		}
+
+		inline cpu_features detect_cpu_features()
+		{
+			cpu_features f;
+			f.sse2 = f.sse3 = f.ssse3 = f.sse4_1 = f.sse4_2 = false;
+			f.avx = f.avx2 = f.fma = f.avx512f = false;
+
+			const unsigned int max_leaf = _cpuid_max_leaf();
+			if (max_leaf < 1) return f;
+
+			unsigned int r1[4];
+			_cpuid(1, 0, r1);
+			const unsigned int ecx1 = r1[2];
+			const unsigned int edx1 = r1[3];
+
+			f.sse2   = _bit(edx1, 26);
+			f.sse3   = _bit(ecx1, 0);
+			f.ssse3  = _bit(ecx1, 9);
+			f.sse4_1 = _bit(ecx1, 19);
+			f.sse4_2 = _bit(ecx1, 20);
+
+			// AVX requires the OS to save YMM states (XCR0 bits 1 and 2)
+
+			const bool osxsave = _bit(ecx1, 27);
+			const unsigned int xcr0 = osxsave ? _xgetbv0() : 0u;
+			const bool os_ymm = (xcr0 & 0x6u) == 0x6u;
+
+			// AVX-512 additionally requires the opmask and ZMM states (XCR0 bits 5 - 7)
+
+			const bool os_zmm = os_ymm && ((xcr0 & 0xe0u) == 0xe0u);
+
+			f.avx = _bit(ecx1, 28) && os_ymm;
+			f.fma = _bit(ecx1, 12) && f.avx;
+
+			if (max_leaf >= 7)
+			{
+				unsigned int r7[4];
+				_cpuid(7, 0, r7);
+				f.avx2 = _bit(r7[1], 5) && f.avx;
+				f.avx512f = _bit(r7[1], 16) && f.avx2 && f.fma && os_zmm;
+			}
+
+			return f;
+		}
+	}
+
+
+	/**
+	 * Returns the features of the current processor,
+	 * which are detected once upon the first call.
+	 */
+	inline const cpu_features& get_cpu_features()
+	{
+		static const cpu_features features = internal::detect_cpu_features();
+		return features;
+	}
+
+	inline int cpu_simd_level()
+	{
+		return get_cpu_features().simd_level();
+	}
+
+LMAT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,112 @@
+/**
+ * @file avx2_fpclass_impl.h
+ *
+ * @brief Floating-point classification with AVX2 integer instructions
+ *
+ * AVX (without AVX2) only has 128-bit integer instructions, so the
+ * generic implementation processes the two halves of a pack with SSE
+ * and recombines them. With AVX2, the whole pack is handled at once.
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_AVX2_FPCLASS_IMPL_H_
+#define LIGHTMAT_AVX2_FPCLASS_IMPL_H_
+
+#include <light_mat/simd/simd_base.h>
+#include "numrepr_format.h"
+
+#ifdef LMAT_HAS_AVX2
+
+LMAT_BEGIN_NAMESPACE namespace internal {
+
+	LMAT_ENSURE_INLINE
+	inline __m256i avx2_abs_bits_ps(const __m256& a)
+	{
+		typedef num_fmt<float> fmt;
+		return _mm256_andnot_si256(_mm256_set1_epi32(fmt::sign_bit), _mm256_castps_si256(a));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline __m256i avx2_abs_bits_pd(const __m256d& a)
+	{
+		typedef num_fmt<double> fmt;
+		return _mm256_andnot_si256(_mm256_set1_epi64x(fmt::sign_bit), _mm256_castpd_si256(a));
+	}
+
+
+	LMAT_ENSURE_INLINE
+	inline __m256 avx2_is_neg_ps(const __m256& a)
+	{
+		return _mm256_castsi256_ps(_mm256_srai_epi32(_mm256_castps_si256(a), 31));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline __m256d avx2_is_neg_pd(const __m256d& a)
+	{
+		return _mm256_castsi256_pd(
+				_mm256_cmpgt_epi64(_mm256_setzero_si256(), _mm256_castpd_si256(a)));
+	}
+
+
+	LMAT_ENSURE_INLINE
+	inline __m256 avx2_is_finite_ps(const __m256& a)
+	{
+		typedef num_fmt<float> fmt;
+		return _mm256_castsi256_ps(
+				_mm256_cmpgt_epi32(_mm256_set1_epi32(fmt::exponent_bits), avx2_abs_bits_ps(a)));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline __m256d avx2_is_finite_pd(const __m256d& a)
+	{
+		typedef num_fmt<double> fmt;
+		return _mm256_castsi256_pd(
+				_mm256_cmpgt_epi64(_mm256_set1_epi64x(fmt::exponent_bits), avx2_abs_bits_pd(a)));
+	}
+
+
+	LMAT_ENSURE_INLINE
+	inline __m256 avx2_is_inf_ps(const __m256& a)
+	{
+		typedef num_fmt<float> fmt;
+		return _mm256_castsi256_ps(
+				_mm256_cmpeq_epi32(avx2_abs_bits_ps(a), _mm256_set1_epi32(fmt::exponent_bits)));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline __m256d avx2_is_inf_pd(const __m256d& a)
+	{
+		typedef num_fmt<double> fmt;
+		return _mm256_castsi256_pd(
+				_mm256_cmpeq_epi64(avx2_abs_bits_pd(a), _mm256_set1_epi64x(fmt::exponent_bits)));
+	}
+
+
+	// NaN has all exponent bits set, and a non-zero mantissa
+
+	LMAT_ENSURE_INLINE
+	inline __m256 avx2_is_nan_ps(const __m256& a)
+	{
+		typedef num_fmt<float> fmt;
+		return _mm256_castsi256_ps(
+				_mm256_cmpgt_epi32(avx2_abs_bits_ps(a), _mm256_set1_epi32(fmt::exponent_bits)));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline __m256d avx2_is_nan_pd(const __m256d& a)
+	{
+		typedef num_fmt<double> fmt;
+		return _mm256_castsi256_pd(
+				_mm256_cmpgt_epi64(avx2_abs_bits_pd(a), _mm256_set1_epi64x(fmt::exponent_bits)));
+	}
+
+} LMAT_END_NAMESPACE
+
+#endif
+
+#endif
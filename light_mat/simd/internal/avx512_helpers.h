@@ -0,0 +1,143 @@
+/**
+ * @file avx512_helpers.h
+ *
+ * @brief Internal helpers for AVX-512 packs
+ *
+ * Only AVX512F is assumed. Bitwise operations on floating-point
+ * vectors (which need AVX512DQ) are done on the integer views.
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_AVX512_HELPERS_H_
+#define LIGHTMAT_AVX512_HELPERS_H_
+
+#include "avx_helpers.h"
+
+LMAT_BEGIN_NAMESPACE namespace internal {
+
+	// part mask
+
+	LMAT_ENSURE_INLINE
+	inline __mmask16 avx512_part_mask_32(unsigned int n)
+	{
+		return (__mmask16)((1u << n) - 1u);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline __mmask8 avx512_part_mask_64(unsigned int n)
+	{
+		return (__mmask8)((1u << n) - 1u);
+	}
+
+	template<unsigned int N>
+	LMAT_ENSURE_INLINE
+	inline __mmask16 avx512_part_mask_32(siz_<N> )
+	{
+		return (__mmask16)((1u << N) - 1u);
+	}
+
+	template<unsigned int N>
+	LMAT_ENSURE_INLINE
+	inline __mmask8 avx512_part_mask_64(siz_<N> )
+	{
+		return (__mmask8)((1u << N) - 1u);
+	}
+
+
+	// bitwise operations
+
+	LMAT_ENSURE_INLINE
+	inline __m512 avx512_xor_ps(const __m512& a, const __m512i& b)
+	{
+		return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), b));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline __m512d avx512_xor_pd(const __m512d& a, const __m512i& b)
+	{
+		return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(a), b));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline __m512 avx512_andnot_ps(const __m512i& a, const __m512& b)
+	{
+		return _mm512_castsi512_ps(_mm512_andnot_si512(a, _mm512_castps_si512(b)));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline __m512d avx512_andnot_pd(const __m512i& a, const __m512d& b)
+	{
+		return _mm512_castsi512_pd(_mm512_andnot_si512(a, _mm512_castpd_si512(b)));
+	}
+
+
+	// halves
+
+	// the zero-masked extraction with a full mask compiles to the same
+	// code as _mm512_extractf64x4_pd (on which GCC also builds the
+	// 512 -> 256 casts), but does not pass an undefined source vector,
+	// which GCC 12 reports under -Wmaybe-uninitialized
+
+	LMAT_ENSURE_INLINE
+	inline __m256 avx512_low_ps(const __m512& v)
+	{
+		return _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xFF, _mm512_castps_pd(v), 0));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline __m256d avx512_low_pd(const __m512d& v)
+	{
+		return _mm512_maskz_extractf64x4_pd(0xFF, v, 0);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline __m256 avx512_high_ps(const __m512& v)
+	{
+		return _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xFF, _mm512_castps_pd(v), 1));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline __m256d avx512_high_pd(const __m512d& v)
+	{
+		return _mm512_maskz_extractf64x4_pd(0xFF, v, 1);
+	}
+
+
+	// extract & broadcast
+
+	template<unsigned int I>
+	LMAT_ENSURE_INLINE
+	inline __m512 avx512_broadcast_f32(const __m512& v, pos_<I> )
+	{
+		return _mm512_permutexvar_ps(_mm512_set1_epi32((int)I), v);
+	}
+
+	template<unsigned int I>
+	LMAT_ENSURE_INLINE
+	inline __m512d avx512_broadcast_f64(const __m512d& v, pos_<I> )
+	{
+		return _mm512_permutexvar_pd(_mm512_set1_epi64((int64_t)I), v);
+	}
+
+	template<unsigned int I>
+	LMAT_ENSURE_INLINE
+	inline float avx512_extract_f32(const __m512& v, pos_<I> p)
+	{
+		return _mm512_cvtss_f32(avx512_broadcast_f32(v, p));
+	}
+
+	template<unsigned int I>
+	LMAT_ENSURE_INLINE
+	inline double avx512_extract_f64(const __m512d& v, pos_<I> p)
+	{
+		return _mm512_cvtsd_f64(avx512_broadcast_f64(v, p));
+	}
+
+} LMAT_END_NAMESPACE
+
+#endif
@@ -15,7 +15,7 @@
 
 #include "sse_helpers.h"
 
-namespace lmat { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace internal {
 
 	LMAT_ENSURE_INLINE
 	inline __m256 combine_m128(const __m128& lo, const __m128& hi)
@@ -283,6 +283,6 @@ namespace lmat { namespace internal {
 
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif /* AVX_HELPERS_H_ */
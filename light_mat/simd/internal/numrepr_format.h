@@ -15,7 +15,7 @@
 
 #include <light_mat/common/prim_types.h>
 
-namespace lmat { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace internal {
 
 	template<typename T> struct num_fmt;
 
@@ -55,6 +55,6 @@ namespace lmat { namespace internal {
 	};
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif /* NUMREPR_FORMAT_H_ */
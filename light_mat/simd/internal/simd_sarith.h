@@ -16,7 +16,7 @@
 #include <light_mat/simd/simd_packs.h>
 #include <light_mat/simd/sse_reduce.h>
 
-namespace lmat { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace internal {
 
 	// SSE
 
@@ -145,6 +145,6 @@ namespace lmat { namespace internal {
 	}
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif
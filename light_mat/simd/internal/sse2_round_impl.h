@@ -15,7 +15,52 @@
 
 #include <light_mat/simd/simd_base.h>
 
-namespace lmat {  namespace internal {
+LMAT_BEGIN_NAMESPACE  namespace internal {
+
+	// round: using magic-number method from Agner Fog.
+
+	LMAT_ENSURE_INLINE
+	inline sse_f32pk round_sse2(const sse_f32pk& a)
+	{
+		__m128 sign  = _mm_and_ps(a, _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000)));
+		__m128 magic = _mm_castsi128_ps(_mm_set1_epi32((int)0x4b000000));
+		__m128 smagic = _mm_or_ps(magic, sign);
+
+		return _mm_sub_ps(_mm_add_ps(a, smagic), smagic);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline sse_f64pk round_sse2(const sse_f64pk& a)
+	{
+		__m128d signmsk = _mm_castsi128_pd(_mm_setr_epi32(0, (int)0x80000000, 0, (int)0x80000000));
+		__m128d sign    = _mm_and_pd(a, signmsk);
+		__m128d magic   = _mm_castsi128_pd(_mm_setr_epi32(0, (int)0x43300000, 0, (int)0x43300000));
+		__m128d smagic  = _mm_or_pd(magic, sign);
+
+		return _mm_sub_pd(_mm_add_pd(a, smagic), smagic);
+	}
+
+
+	// Entries with |a| >= 2^23 (resp. 2^52), and NaNs, are kept as they are.
+	// They are integral already, and out of the range of the conversion to int32.
+
+	LMAT_ENSURE_INLINE
+	inline __m128 sse2_keep_large_ps(const __m128& a, const __m128& t)
+	{
+		__m128 big = _mm_cmpnlt_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), a), _mm_set1_ps(8388608.0f));
+		return _mm_or_ps(_mm_and_ps(big, a), _mm_andnot_ps(big, t));
+	}
+
+	LMAT_ENSURE_INLINE
+	inline __m128d sse2_keep_large_pd(const __m128d& a, const __m128d& t)
+	{
+		__m128d big = _mm_cmpnlt_pd(_mm_andnot_pd(_mm_set1_pd(-0.0), a), _mm_set1_pd(4503599627370496.0));
+		return _mm_or_pd(_mm_and_pd(big, a), _mm_andnot_pd(big, t));
+	}
+
+
+	// floor, ceil & trunc: f32 via int32 conversion, f64 via round
+	// (as int32 does not cover all non-integral doubles)
 
 	LMAT_ENSURE_INLINE
 	inline sse_f32pk floor_sse2(const sse_f32pk& a)
@@ -23,16 +68,16 @@ namespace lmat {  namespace internal {
 		__m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
 		__m128 b = _mm_and_ps(_mm_cmpgt_ps(t, a), _mm_set1_ps(1.0f));
 
-		return _mm_sub_ps(t, b);
+		return sse2_keep_large_ps(a, _mm_sub_ps(t, b));
 	}
 
 	LMAT_ENSURE_INLINE
 	inline sse_f64pk floor_sse2(const sse_f64pk& a)
 	{
-		__m128d t = _mm_cvtepi32_pd(_mm_cvttpd_epi32(a));
+		__m128d t = round_sse2(a);
 		__m128d b = _mm_and_pd(_mm_cmpgt_pd(t, a), _mm_set1_pd(1.0));
 
-		return _mm_sub_pd(t, b);
+		return sse2_keep_large_pd(a, _mm_sub_pd(t, b));
 	}
 
 	LMAT_ENSURE_INLINE
@@ -41,54 +86,35 @@ namespace lmat {  namespace internal {
 		__m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
 		__m128 b = _mm_and_ps(_mm_cmplt_ps(t, a), _mm_set1_ps(1.0f));
 
-		return _mm_add_ps(t, b);
+		return sse2_keep_large_ps(a, _mm_add_ps(t, b));
 	}
 
 	LMAT_ENSURE_INLINE
 	inline sse_f64pk ceil_sse2(const sse_f64pk& a)
 	{
-		__m128d t = _mm_cvtepi32_pd(_mm_cvttpd_epi32(a));
+		__m128d t = round_sse2(a);
 		__m128d b = _mm_and_pd(_mm_cmplt_pd(t, a), _mm_set1_pd(1.0));
 
-		return _mm_add_pd(t, b);
+		return sse2_keep_large_pd(a, _mm_add_pd(t, b));
 	}
 
 	LMAT_ENSURE_INLINE
 	inline sse_f32pk trunc_sse2(const sse_f32pk& a)
 	{
-		return _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+		return sse2_keep_large_ps(a, _mm_cvtepi32_ps(_mm_cvttps_epi32(a)));
 	}
 
 	LMAT_ENSURE_INLINE
 	inline sse_f64pk trunc_sse2(const sse_f64pk& a)
 	{
-		return _mm_cvtepi32_pd(_mm_cvttpd_epi32(a));
-	}
-
-
-	// round: using magic-number method from Agner Fog.
-
-	LMAT_ENSURE_INLINE
-	inline sse_f32pk round_sse2(const sse_f32pk& a)
-	{
-		__m128 sign  = _mm_and_ps(a, _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000)));
-		__m128 magic = _mm_castsi128_ps(_mm_set1_epi32((int)0x4b000000));
-		__m128 smagic = _mm_or_ps(magic, sign);
+		// trunc(a) = sign(a) * floor(|a|)
 
-		return _mm_sub_ps(_mm_add_ps(a, smagic), smagic);
-	}
-
-	LMAT_ENSURE_INLINE
-	inline sse_f64pk round_sse2(const sse_f64pk& a)
-	{
-		__m128d signmsk = _mm_castsi128_pd(_mm_setr_epi32(0, (int)0x80000000, 0, (int)0x80000000));
-		__m128d sign    = _mm_and_pd(a, signmsk);
-		__m128d magic   = _mm_castsi128_pd(_mm_setr_epi32(0, (int)0x43300000, 0, (int)0x43300000));
-		__m128d smagic  = _mm_or_pd(magic, sign);
+		__m128d sign = _mm_and_pd(a, _mm_set1_pd(-0.0));
+		__m128d t = floor_sse2(_mm_andnot_pd(_mm_set1_pd(-0.0), a));
 
-		return _mm_sub_pd(_mm_add_pd(a, smagic), smagic);
+		return _mm_or_pd(t, sign);
 	}
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif /* SSE_ROUND_IMPL_H_ */
@@ -16,7 +16,7 @@
 #include <light_mat/simd/simd_base.h>
 #include "numrepr_format.h"
 
-namespace lmat { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace internal {
 
 	// bitwise not
 
@@ -27,6 +27,20 @@ namespace lmat { namespace internal {
 	}
 
 
+	// 64-bit integer equality (emulated on SSE2 / SSE3 / SSSE3)
+
+	LMAT_ENSURE_INLINE
+	inline __m128i sse_cmpeq_epi64(const __m128i& a, const __m128i& b)
+	{
+#ifdef LMAT_HAS_SSE4_1
+		return _mm_cmpeq_epi64(a, b);
+#else
+		__m128i e32 = _mm_cmpeq_epi32(a, b);
+		return _mm_and_si128(e32, _mm_shuffle_epi32(e32, _MM_SHUFFLE(2, 3, 0, 1)));
+#endif
+	}
+
+
 	// partial load
 
 	LMAT_ENSURE_INLINE
@@ -220,7 +234,7 @@ namespace lmat { namespace internal {
 		typedef num_fmt<double> fmt;
 		return _mm_set1_epi64x(fmt::sign_bit);
 	}
-} }
+} LMAT_END_NAMESPACE
 
 
 #endif /* SSE_HELPERS_H_ */
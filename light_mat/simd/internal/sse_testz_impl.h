@@ -15,7 +15,7 @@
 
 #include <light_mat/simd/simd_base.h>
 
-namespace lmat { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace internal {
 
 	LMAT_ENSURE_INLINE
 	inline bool testz_sse2(const __m128i& a) // returns true when all bits in a are 0s
@@ -69,6 +69,6 @@ namespace lmat { namespace internal {
 	}
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif /* SSE2_ALLANY_IMPL_H_ */
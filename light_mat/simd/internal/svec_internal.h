@@ -16,7 +16,7 @@
 #include <light_mat/simd/simd.h>
 #include "simd_sarith.h"
 
-namespace lmat { namespace internal {
+LMAT_BEGIN_NAMESPACE namespace internal {
 
 	template<typename T, typename Kind, unsigned int PW, index_t Len>
 	class svec_impl;
@@ -1056,6 +1056,6 @@ namespace lmat { namespace internal {
 	};
 
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif 
@@ -21,4 +21,8 @@
 #include <light_mat/simd/avx.h>
 #endif
 
+#ifdef LMAT_HAS_AVX512
+#include <light_mat/simd/avx512.h>
+#endif
+
 #endif /* SIMD_H_ */
@@ -16,7 +16,9 @@
 #include <light_mat/config/config.h>
 
 #ifndef LMAT_SIMD_LEVEL
-#if defined ( __AVX2__ )
+#if defined ( __AVX512F__ )
+#define LMAT_SIMD_LEVEL 9
+#elif defined ( __AVX2__ )
 #define LMAT_SIMD_LEVEL 8
 #elif defined ( __AVX__ )
 #define LMAT_SIMD_LEVEL 7
@@ -71,6 +73,16 @@
 #define LMAT_HAS_AVX2
 #endif
 
+#if LMAT_SIMD_LEVEL >= 9
+#define LMAT_HAS_AVX512
+#endif
+
+// FMA3 is a separate extension (though shipped with every AVX2 processor)
+
+#if defined ( __FMA__ ) || ( defined ( _MSC_VER ) && defined ( __AVX2__ ) )
+#define LMAT_HAS_FMA
+#endif
+
 
 #if (!defined(LMAT_HAS_SSE2))
 #error LightMatrix requires at least SSE2 support.
@@ -20,7 +20,7 @@
 
 // system headers for SIMD intrinsics
 
-#if (defined(LMAT_HAS_AVX2))
+#if (defined(LMAT_HAS_AVX2) || defined(LMAT_HAS_AVX512))
 #ifdef __GNUC__
 #include <x86intrin.h>
 #else
@@ -46,10 +46,11 @@
 #define LMAT_SIMD_PACK_(T, K) simd_pack<T, K>
 #define LMAT_SIMD_BPACK_(T, K) simd_bpack<T, K>
 
-namespace lmat {
+LMAT_BEGIN_NAMESPACE
 
 	struct sse_t { };
 	struct avx_t { };
+	struct avx512_t { };
 
 	namespace meta
 	{
@@ -60,12 +61,24 @@ namespace lmat {
 
 		template<> struct is_simd_kind<avx_t> : public true_ { };
 
+		template<> struct is_simd_kind<avx512_t> : public true_ { };
+
 		template<typename FTag, typename T, typename Kind>
 		struct has_simd_support : public false_ { };
+
+		// whether the packs of a kind can load/store the first n entries
+		// with n given at run-time (through native mask registers)
+
+		template<typename Kind>
+		struct has_masked_part : public false_ { };
+
+		template<> struct has_masked_part<avx512_t> : public true_ { };
 	}
 
 
-#if (defined(LMAT_HAS_AVX))
+#if (defined(LMAT_HAS_AVX512))
+	typedef avx512_t default_simd_kind;
+#elif (defined(LMAT_HAS_AVX))
 	typedef avx_t default_simd_kind;
 #else
 	typedef sse_t default_simd_kind;
@@ -83,13 +96,14 @@ namespace lmat {
 	template<unsigned int N> struct siz_ { };
 	template<unsigned int I> struct pos_ { };
 
-}
+LMAT_END_NAMESPACE
 
 
 // Useful macros
 
 #define LMAT_ALIGN_SSE LMAT_ALIGN(16)
 #define LMAT_ALIGN_AVX LMAT_ALIGN(32)
+#define LMAT_ALIGN_AVX512 LMAT_ALIGN(64)
 
 #define LMAT_DEFINE_SIMD_TRAITS( Kind, ScalarT, Wid, Bytes ) \
 	template<> struct simd_traits<ScalarT, Kind> { \
@@ -115,6 +129,10 @@ namespace lmat {
 	template<> struct has_simd_support<ftags::FTag, float, avx_t> : public true_ { }; \
 	template<> struct has_simd_support<ftags::FTag, double, avx_t> : public true_ { };
 
+#define LMAT_DEFINE_HAS_AVX512_SUPPORT( FTag ) \
+	template<> struct has_simd_support<ftags::FTag, float, avx512_t> : public true_ { }; \
+	template<> struct has_simd_support<ftags::FTag, double, avx512_t> : public true_ { };
+
 #endif /* SIMD_BASE_H_ */
 
 
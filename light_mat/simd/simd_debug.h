@@ -16,8 +16,7 @@
 #include <light_mat/simd/simd_base.h>
 #include <cstdio>
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	template<typename T, typename Kind>
 	inline void print_pack(const char *fmt, const simd_pack<T, Kind>& pk)
@@ -108,6 +107,6 @@ namespace lmat
 		return true;
 	}
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* SIMD_DEBUG_H_ */
@@ -0,0 +1,210 @@
+/**
+ * @file simd_dispatch.h
+ *
+ * @brief Run-time dispatch among SIMD variants of a function
+ *
+ * A function to be dispatched is written once, in a source file
+ * that defines LMAT_SIMD_DISPATCH_VARIANT before including any
+ * LightMatrix header, and names it with LMAT_SIMD_VARIANT_NAME.
+ * That file is compiled several times, e.g. with -msse2, -mavx
+ * and -mavx2, yielding the variants name_sse2, name_avx and
+ * name_avx2. A simd_dispatcher then picks the best variant that
+ * the processor supports, once, when it is constructed:
+ *
+ * @code
+ * // kernels.cpp (compiled for each instruction set)
+ * #define LMAT_SIMD_DISPATCH_VARIANT
+ * #include <light_mat/simd/simd_dispatch.h>
+ * #include <light_mat/mateval/mat_reduce.h>
+ *
+ * double LMAT_SIMD_VARIANT_NAME(my_sum)(const double *x, lmat::index_t n)
+ * {
+ *     return lmat::sum(lmat::cref_col<double>(x, n));
+ * }
+ *
+ * // main.cpp
+ * LMAT_DECLARE_SIMD_VARIANTS( double, my_sum, (const double*, lmat::index_t) )
+ *
+ * static const lmat::simd_dispatcher<double(const double*, lmat::index_t)>
+ *     my_sum( LMAT_SIMD_VARIANTS(my_sum) );
+ * @endcode
+ *
+ * An AVX-512 variant (name_avx512, compiled with -mavx512f) is also
+ * taken into account when LMAT_SIMD_DISPATCH_AVX512 is defined where
+ * the dispatcher is declared.
+ *
+ * Within a variant translation unit, the whole library lives in an
+ * inline namespace of that instruction set (e.g. lmat::simd_avx2, see
+ * config/config.h), so the inline functions of different variants are
+ * never merged by the linker. Consequently, library types are distinct
+ * across variants, and the signatures of the variants should only
+ * involve plain pointers and scalars.
+ *
+ * Scope: the library is header-only, and provides the mechanism only.
+ * It ships no prebuilt per-instruction-set entry points, and none of its
+ * own functions is dispatched at run time. In particular, element-wise
+ * evaluation, folds and reductions, copy/fill, transposition and random
+ * number filling are always compiled for the instruction set of the
+ * translation unit that includes them. To dispatch any of these, call
+ * it from a variant function as above, and compile that source file
+ * once per instruction set.
+ *
+ * The levels follow cpu_features::simd_level(), with which the
+ * variants are expected to be compiled as follows:
+ *
+ *  - sse2:   -msse2
+ *  - avx:    -mavx
+ *  - avx2:   -mavx2 -mfma  (level 8 requires both AVX2 and FMA3)
+ *  - avx512: -mavx512f -mavx2 -mfma
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_SIMD_DISPATCH_H_
+#define LIGHTMAT_SIMD_DISPATCH_H_
+
+#include <light_mat/simd/cpu_features.h>
+#include <initializer_list>
+
+
+/********************************************
+ *
+ *  variant naming
+ *
+ ********************************************/
+
+#define LMAT_SIMD_LEVEL_SSE2 2
+#define LMAT_SIMD_LEVEL_AVX 7
+#define LMAT_SIMD_LEVEL_AVX2 8
+#define LMAT_SIMD_LEVEL_AVX512 9
+
+#define LMAT_SIMD_VARIANT_NAME_(name, sfx) name##_##sfx
+#define LMAT_SIMD_VARIANT_NAME_X(name, sfx) LMAT_SIMD_VARIANT_NAME_(name, sfx)
+
+#ifdef LMAT_SIMD_VARIANT_SUFFIX
+#define LMAT_SIMD_VARIANT_NAME(name) LMAT_SIMD_VARIANT_NAME_X(name, LMAT_SIMD_VARIANT_SUFFIX)
+#else
+#define LMAT_SIMD_VARIANT_NAME(name) name
+#endif
+
+// the AVX-512 variant is only declared when the build provides it,
+// as not every compiler in use supports -mavx512f
+
+#ifdef LMAT_SIMD_DISPATCH_AVX512
+#define LMAT_DECLARE_SIMD_VARIANT_AVX512_( R, name, Params ) R name##_avx512 Params;
+#define LMAT_SIMD_VARIANT_AVX512_( name ) , { LMAT_SIMD_LEVEL_AVX512, &name##_avx512 }
+#else
+#define LMAT_DECLARE_SIMD_VARIANT_AVX512_( R, name, Params )
+#define LMAT_SIMD_VARIANT_AVX512_( name )
+#endif
+
+#define LMAT_DECLARE_SIMD_VARIANTS( R, name, Params ) \
+	R name##_sse2 Params; \
+	R name##_avx Params; \
+	R name##_avx2 Params; \
+	LMAT_DECLARE_SIMD_VARIANT_AVX512_( R, name, Params )
+
+#define LMAT_SIMD_VARIANTS( name ) \
+	{ { LMAT_SIMD_LEVEL_SSE2, &name##_sse2 }, \
+	  { LMAT_SIMD_LEVEL_AVX,  &name##_avx }, \
+	  { LMAT_SIMD_LEVEL_AVX2, &name##_avx2 } \
+	  LMAT_SIMD_VARIANT_AVX512_( name ) }
+
+
+LMAT_BEGIN_NAMESPACE
+	/********************************************
+	 *
+	 *  dispatcher
+	 *
+	 ********************************************/
+
+	template<typename F>
+	struct simd_variant
+	{
+		int level;
+		F *fun;
+	};
+
+	template<typename F> class simd_dispatcher;
+
+	template<typename R, typename... Args>
+	class simd_dispatcher<R(Args...)>
+	{
+	public:
+		typedef R function_type(Args...);
+		typedef simd_variant<function_type> variant_type;
+
+		static const int max_variants = 8;
+
+		simd_dispatcher(std::initializer_list<variant_type> variants)
+		: m_nvars(0), m_fun(0), m_level(0)
+		{
+			check_arg(variants.size() <= (size_t)max_variants,
+					"simd_dispatcher: too many variants.");
+
+			for (const variant_type *v = variants.begin(); v != variants.end(); ++v)
+			{
+				m_vars[m_nvars++] = *v;
+			}
+
+			resolve(cpu_simd_level());
+		}
+
+		/**
+		 * Re-selects the variant, considering only those whose levels
+		 * do not exceed max_level (e.g. to cap the instruction set in use).
+		 */
+		void resolve(int max_level)
+		{
+			const variant_type *best = select(max_level);
+			check_arg(best != 0, "simd_dispatcher: no variant is supported by the processor.");
+
+			m_fun = best->fun;
+			m_level = best->level;
+		}
+
+		int level() const
+		{
+			return m_level;
+		}
+
+		function_type* get() const
+		{
+			return m_fun;
+		}
+
+		LMAT_ENSURE_INLINE
+		R operator() (Args... args) const
+		{
+			return m_fun(args...);
+		}
+
+	private:
+		const variant_type* select(int max_level) const
+		{
+			const variant_type *best = 0;
+			for (int i = 0; i < m_nvars; ++i)
+			{
+				const variant_type& v = m_vars[i];
+				if (v.fun && v.level <= max_level && (!best || v.level > best->level))
+				{
+					best = &v;
+				}
+			}
+			return best;
+		}
+
+	private:
+		variant_type m_vars[max_variants];
+		int m_nvars;
+		function_type *m_fun;
+		int m_level;
+	};
+
+LMAT_END_NAMESPACE
+
+#endif
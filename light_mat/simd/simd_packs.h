@@ -25,4 +25,10 @@
 #include <light_mat/simd/avx_reduce.h>
 #endif
 
+#ifdef LMAT_HAS_AVX512
+#include <light_mat/simd/avx512_packs.h>
+#include <light_mat/simd/avx512_bpacks.h>
+#include <light_mat/simd/avx512_reduce.h>
+#endif
+
 #endif /* SIMD_PACKS_H_ */
@@ -15,8 +15,7 @@
 
 #include "internal/svec_internal.h"
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 	template<typename T, typename Kind, index_t Len>
 	class simd_vec
 	: public internal::svec_impl<T, Kind, simd_traits<T, Kind>::pack_width, Len>
@@ -68,6 +67,6 @@ namespace lmat
 		return vx._dot(vy);
 	}
 
-}
+LMAT_END_NAMESPACE
 
 #endif
@@ -15,9 +15,10 @@
 
 #include <light_mat/simd/sse_packs.h>
 #include <light_mat/simd/sse_bpacks.h>
+#include <light_mat/math/math_base.h>
 #include "internal/sse2_round_impl.h"
 
-namespace lmat { namespace meta {
+LMAT_BEGIN_NAMESPACE namespace meta {
 
 	LMAT_DEFINE_HAS_SSE_SUPPORT( add_ )
 	LMAT_DEFINE_HAS_SSE_SUPPORT( sub_ )
@@ -44,11 +45,10 @@ namespace lmat { namespace meta {
 	LMAT_DEFINE_HAS_SSE_SUPPORT( round_ )
 	LMAT_DEFINE_HAS_SSE_SUPPORT( trunc_ )
 
-} }
+} LMAT_END_NAMESPACE
 
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	/********************************************
 	 *
@@ -174,10 +174,10 @@ namespace lmat
 		return a;
 	}
 
-}
+LMAT_END_NAMESPACE
 
 
-namespace lmat { namespace math {
+LMAT_BEGIN_NAMESPACE namespace math {
 
 	/********************************************
 	 *
@@ -188,13 +188,35 @@ namespace lmat { namespace math {
 	LMAT_ENSURE_INLINE
 	inline sse_f32pk fma(const sse_f32pk& x, const sse_f32pk& y, const sse_f32pk& z)
 	{
+#ifdef LMAT_HAS_FMA
+		return _mm_fmadd_ps(x, y, z);
+#else
 		return _mm_add_ps(_mm_mul_ps(x, y), z);
+#endif
 	}
 
 	LMAT_ENSURE_INLINE
 	inline sse_f64pk fma(const sse_f64pk& x, const sse_f64pk& y, const sse_f64pk& z)
 	{
+#ifdef LMAT_HAS_FMA
+		return _mm_fmadd_pd(x, y, z);
+#else
 		return _mm_add_pd(_mm_mul_pd(x, y), z);
+#endif
+	}
+
+	template<>
+	LMAT_ENSURE_INLINE
+	inline sse_f32pk fmadd(const sse_f32pk& x, const sse_f32pk& y, const sse_f32pk& z)
+	{
+		return fma(x, y, z);
+	}
+
+	template<>
+	LMAT_ENSURE_INLINE
+	inline sse_f64pk fmadd(const sse_f64pk& x, const sse_f64pk& y, const sse_f64pk& z)
+	{
+		return fma(x, y, z);
 	}
 
 	LMAT_ENSURE_INLINE
@@ -307,6 +329,13 @@ namespace lmat { namespace math {
 		return _mm_div_pd(_mm_set1_pd(1.0), a);
 	}
 
+	LMAT_ENSURE_INLINE
+	inline sse_f64pk approx_rcp(const sse_f64pk& a)
+	{
+		// f32 estimate: valid within the f32 range
+		return _mm_cvtps_pd(_mm_rcp_ps(_mm_cvtpd_ps(a)));
+	}
+
 	LMAT_ENSURE_INLINE
 	inline sse_f32pk rsqrt(const sse_f32pk& a)
 	{
@@ -325,6 +354,13 @@ namespace lmat { namespace math {
 		return _mm_div_pd(_mm_set1_pd(1.0), _mm_sqrt_pd(a));
 	}
 
+	LMAT_ENSURE_INLINE
+	inline sse_f64pk approx_rsqrt(const sse_f64pk& a)
+	{
+		// f32 estimate: valid within the f32 range
+		return _mm_cvtps_pd(_mm_rsqrt_ps(_mm_cvtpd_ps(a)));
+	}
+
 	/********************************************
 	 *
 	 *  blending
@@ -337,7 +373,7 @@ namespace lmat { namespace math {
 #ifdef LMAT_HAS_SSE4_1
 		return _mm_blendv_ps(y, x, b);
 #else
-		return internal::cond_sse2(b, x, y);
+		return lmat::internal::cond_sse2(b, x, y);
 #endif
 	}
 
@@ -347,7 +383,7 @@ namespace lmat { namespace math {
 #ifdef LMAT_HAS_SSE4_1
 		return _mm_blendv_pd(y, x, b);
 #else
-		return internal::cond_sse2(b, x, y);
+		return lmat::internal::cond_sse2(b, x, y);
 #endif
 	}
 
@@ -364,7 +400,7 @@ namespace lmat { namespace math {
 #ifdef LMAT_HAS_SSE4_1
 		return _mm_round_ps(a, 0);
 #else
-		return internal::round_sse2(a);
+		return lmat::internal::round_sse2(a);
 #endif
 	}
 
@@ -374,7 +410,7 @@ namespace lmat { namespace math {
 #ifdef LMAT_HAS_SSE4_1
 		return _mm_round_pd(a, 0);
 #else
-		return internal::round_sse2(a);
+		return lmat::internal::round_sse2(a);
 #endif
 	}
 
@@ -384,7 +420,7 @@ namespace lmat { namespace math {
 #ifdef LMAT_HAS_SSE4_1
 		return _mm_round_ps(a, 1);
 #else
-		return internal::floor_sse2(a);
+		return lmat::internal::floor_sse2(a);
 #endif
 	}
 
@@ -394,7 +430,7 @@ namespace lmat { namespace math {
 #ifdef LMAT_HAS_SSE4_1
 		return _mm_round_pd(a, 1);
 #else
-		return internal::floor_sse2(a);
+		return lmat::internal::floor_sse2(a);
 #endif
 	}
 
@@ -404,7 +440,7 @@ namespace lmat { namespace math {
 #ifdef LMAT_HAS_SSE4_1
 		return _mm_round_ps(a, 2);
 #else
-		return internal::ceil_sse2(a);
+		return lmat::internal::ceil_sse2(a);
 #endif
 	}
 
@@ -414,7 +450,7 @@ namespace lmat { namespace math {
 #ifdef LMAT_HAS_SSE4_1
 		return _mm_round_pd(a, 2);
 #else
-		return internal::ceil_sse2(a);
+		return lmat::internal::ceil_sse2(a);
 #endif
 	}
 
@@ -424,7 +460,7 @@ namespace lmat { namespace math {
 #ifdef LMAT_HAS_SSE4_1
 		return _mm_round_ps(a, 3);
 #else
-		return internal::trunc_sse2(a);
+		return lmat::internal::trunc_sse2(a);
 #endif
 	}
 
@@ -434,11 +470,11 @@ namespace lmat { namespace math {
 #ifdef LMAT_HAS_SSE4_1
 		return _mm_round_pd(a, 3);
 #else
-		return internal::trunc_sse2(a);
+		return lmat::internal::trunc_sse2(a);
 #endif
 	}
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif
 
@@ -16,7 +16,7 @@
 #include <light_mat/simd/simd_base.h>
 #include "internal/sse_helpers.h"
 
-namespace lmat {
+LMAT_BEGIN_NAMESPACE
 
 	typedef simd_bpack<float, sse_t> sse_f32bpk;
 	typedef simd_bpack<double, sse_t> sse_f64bpk;
@@ -266,6 +266,6 @@ namespace lmat {
 	};
 
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* SSE_BPACKS_H_ */
@@ -16,7 +16,7 @@
 #include <light_mat/simd/simd_base.h>
 #include "internal/sse_helpers.h"
 
-namespace lmat {
+LMAT_BEGIN_NAMESPACE
 
 
 	/********************************************
@@ -373,6 +373,6 @@ namespace lmat {
 	}; // SSE f64 pack
 
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* SSE_PACKS_H_ */
@@ -17,7 +17,7 @@
 #include <light_mat/simd/sse_bpacks.h>
 #include "internal/sse_fpclass_impl.h"
 
-namespace lmat { namespace meta {
+LMAT_BEGIN_NAMESPACE namespace meta {
 
 	LMAT_DEFINE_HAS_SSE_SUPPORT( eq_ )
 	LMAT_DEFINE_HAS_SSE_SUPPORT( ne_ )
@@ -37,11 +37,10 @@ namespace lmat { namespace meta {
 	LMAT_DEFINE_HAS_SSE_SUPPORT( isinf_ )
 	LMAT_DEFINE_HAS_SSE_SUPPORT( isnan_ )
 
-} }
+} LMAT_END_NAMESPACE
 
 
-namespace lmat
-{
+LMAT_BEGIN_NAMESPACE
 
 	/********************************************
 	 *
@@ -140,7 +139,7 @@ namespace lmat
 	inline sse_f64bpk operator ~ (const sse_f64bpk& a)
 	{
 		return _mm_castsi128_pd(
-				_mm_cmpeq_epi64(_mm_castpd_si128(a), _mm_setzero_si128()));
+				internal::sse_cmpeq_epi64(_mm_castpd_si128(a), _mm_setzero_si128()));
 	}
 
 	LMAT_ENSURE_INLINE
@@ -178,7 +177,7 @@ namespace lmat
 	inline sse_f64bpk operator == (const sse_f64bpk& a, const sse_f64bpk& b)
 	{
 		return _mm_castsi128_pd(
-				_mm_cmpeq_epi64(_mm_castpd_si128(a), _mm_castpd_si128(b)));
+				internal::sse_cmpeq_epi64(_mm_castpd_si128(a), _mm_castpd_si128(b)));
 	}
 
 	LMAT_ENSURE_INLINE
@@ -221,10 +220,10 @@ namespace lmat
 		a = a | b;
 		return a;
 	}
-}
+LMAT_END_NAMESPACE
 
 
-namespace lmat { namespace math {
+LMAT_BEGIN_NAMESPACE namespace math {
 
 	/********************************************
 	 *
@@ -283,6 +282,6 @@ namespace lmat { namespace math {
 		return lmat::internal::sse_is_nan_pd(a);
 	}
 
-} }
+} LMAT_END_NAMESPACE
 
 #endif
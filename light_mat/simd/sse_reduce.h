@@ -17,7 +17,7 @@
 #include <light_mat/simd/sse_bpacks.h>
 #include "internal/sse_testz_impl.h"
 
-namespace lmat {
+LMAT_BEGIN_NAMESPACE
 
 	// sum
 
@@ -124,6 +124,6 @@ namespace lmat {
 		return !all_true(a);
 	}
 
-}
+LMAT_END_NAMESPACE
 
 #endif /* SSE_REDUCE_H_ */
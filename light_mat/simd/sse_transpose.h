@@ -0,0 +1,49 @@
+/**
+ * @file sse_transpose.h
+ *
+ * @brief In-register transposition of SSE packs
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_SSE_TRANSPOSE_H_
+#define LIGHTMAT_SSE_TRANSPOSE_H_
+
+#include <light_mat/simd/sse_packs.h>
+
+LMAT_BEGIN_NAMESPACE
+
+	// Given the rows of a w x w block (w = pack_width),
+	// these turn them into the columns, in place
+
+	LMAT_ENSURE_INLINE
+	inline void transpose(sse_f32pk& a0, sse_f32pk& a1, sse_f32pk& a2, sse_f32pk& a3)
+	{
+		__m128 t0 = _mm_unpacklo_ps(a0, a1);
+		__m128 t1 = _mm_unpacklo_ps(a2, a3);
+		__m128 t2 = _mm_unpackhi_ps(a0, a1);
+		__m128 t3 = _mm_unpackhi_ps(a2, a3);
+
+		a0 = _mm_movelh_ps(t0, t1);
+		a1 = _mm_movehl_ps(t1, t0);
+		a2 = _mm_movelh_ps(t2, t3);
+		a3 = _mm_movehl_ps(t3, t2);
+	}
+
+	LMAT_ENSURE_INLINE
+	inline void transpose(sse_f64pk& a0, sse_f64pk& a1)
+	{
+		__m128d t0 = _mm_unpacklo_pd(a0, a1);
+		__m128d t1 = _mm_unpackhi_pd(a0, a1);
+
+		a0 = t0;
+		a1 = t1;
+	}
+
+LMAT_END_NAMESPACE
+
+#endif /* SSE_TRANSPOSE_H_ */
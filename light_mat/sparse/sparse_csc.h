@@ -0,0 +1,306 @@
+/**
+ * @file sparse_csc.h
+ *
+ * @brief Sparse matrices in compressed sparse column (CSC) format
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_SPARSE_CSC_H_
+#define LIGHTMAT_SPARSE_CSC_H_
+
+#include <light_mat/matrix/matrix_concepts.h>
+#include <light_mat/matrix/matrix_fill.h>
+#include <light_mat/matrix/matrix_properties.h>
+#include <light_mat/common/block.h>
+#include <light_mat/common/parallel.h>
+#include <algorithm>
+
+LMAT_BEGIN_NAMESPACE
+
+	/********************************************
+	 *
+	 *  sparse_csc
+	 *
+	 *  The non-zeros of column j are stored at
+	 *  positions [colptr[j], colptr[j+1]) of
+	 *  rowidx and values, with row indices in
+	 *  ascending order.
+	 *
+	 ********************************************/
+
+	template<typename T, typename TI=index_t>
+	class sparse_csc
+	{
+	public:
+		typedef T value_type;
+		typedef TI index_type;
+
+	public:
+		LMAT_ENSURE_INLINE
+		sparse_csc()
+		: m_nrows(0), m_ncols(0)
+		, m_colptr(1, zero()), m_rowidx(), m_values()
+		{
+		}
+
+		// the structure is to be filled by the caller
+		LMAT_ENSURE_INLINE
+		sparse_csc(index_t m, index_t n, index_t nnz)
+		: m_nrows(m), m_ncols(n)
+		, m_colptr(n + 1, zero()), m_rowidx(nnz), m_values(nnz)
+		{
+		}
+
+		sparse_csc(index_t m, index_t n, index_t nnz,
+				const TI *colptr, const TI *rowidx, const T *values)
+		: m_nrows(m), m_ncols(n)
+		, m_colptr(n + 1), m_rowidx(nnz), m_values(nnz)
+		{
+			LMAT_CHECK_DIMS( index_t(colptr[n]) == nnz )
+
+			copy_vec(n + 1, colptr, m_colptr.ptr_data());
+			copy_vec(nnz, rowidx, m_rowidx.ptr_data());
+			copy_vec(nnz, values, m_values.ptr_data());
+		}
+
+		// keeps the non-zero entries of a dense matrix
+		template<class Mat>
+		explicit sparse_csc(const IRegularMatrix<Mat, T>& a)
+		: m_nrows(a.nrows()), m_ncols(a.ncolumns())
+		, m_colptr(a.ncolumns() + 1)
+		{
+			const index_t m = m_nrows;
+			const index_t n = m_ncols;
+
+			index_t nnz = 0;
+			for (index_t j = 0; j < n; ++j)
+			{
+				for (index_t i = 0; i < m; ++i)
+				{
+					if (a.elem(i, j) != T(0)) ++ nnz;
+				}
+			}
+
+			dblock<TI>(nnz).swap(m_rowidx);
+			dblock<T>(nnz).swap(m_values);
+
+			TI *cp = m_colptr.ptr_data();
+			TI *ri = m_rowidx.ptr_data();
+			T *va = m_values.ptr_data();
+
+			index_t k = 0;
+			cp[0] = TI(0);
+			for (index_t j = 0; j < n; ++j)
+			{
+				for (index_t i = 0; i < m; ++i)
+				{
+					const T v = a.elem(i, j);
+					if (v != T(0))
+					{
+						ri[k] = TI(i);
+						va[k] = v;
+						++ k;
+					}
+				}
+				cp[j + 1] = TI(k);
+			}
+		}
+
+	public:
+		LMAT_ENSURE_INLINE index_t nrows() const
+		{
+			return m_nrows;
+		}
+
+		LMAT_ENSURE_INLINE index_t ncolumns() const
+		{
+			return m_ncols;
+		}
+
+		LMAT_ENSURE_INLINE index_t nelems() const
+		{
+			return m_nrows * m_ncols;
+		}
+
+		LMAT_ENSURE_INLINE index_t nnz() const
+		{
+			return index_t(m_colptr[m_ncols]);
+		}
+
+		LMAT_ENSURE_INLINE index_t col_begin(index_t j) const
+		{
+			return index_t(m_colptr[j]);
+		}
+
+		LMAT_ENSURE_INLINE index_t col_end(index_t j) const
+		{
+			return index_t(m_colptr[j + 1]);
+		}
+
+		LMAT_ENSURE_INLINE index_t col_nnz(index_t j) const
+		{
+			return index_t(m_colptr[j + 1] - m_colptr[j]);
+		}
+
+		LMAT_ENSURE_INLINE const TI* ptr_colptr() const
+		{
+			return m_colptr.ptr_data();
+		}
+
+		LMAT_ENSURE_INLINE TI* ptr_colptr()
+		{
+			return m_colptr.ptr_data();
+		}
+
+		LMAT_ENSURE_INLINE const TI* ptr_rowidx() const
+		{
+			return m_rowidx.ptr_data();
+		}
+
+		LMAT_ENSURE_INLINE TI* ptr_rowidx()
+		{
+			return m_rowidx.ptr_data();
+		}
+
+		LMAT_ENSURE_INLINE const T* ptr_values() const
+		{
+			return m_values.ptr_data();
+		}
+
+		LMAT_ENSURE_INLINE T* ptr_values()
+		{
+			return m_values.ptr_data();
+		}
+
+		// the value at (i, j), found by binary search within column j
+		T elem(index_t i, index_t j) const
+		{
+			const TI *ri = m_rowidx.ptr_data();
+			index_t l = col_begin(j);
+			index_t u = col_end(j);
+
+			while (l < u)
+			{
+				index_t k = l + (u - l) / 2;
+				index_t r = index_t(ri[k]);
+
+				if (r < i) l = k + 1;
+				else if (r > i) u = k;
+				else return m_values[k];
+			}
+			return T(0);
+		}
+
+		LMAT_ENSURE_INLINE T operator() (index_t i, index_t j) const
+		{
+			return elem(i, j);
+		}
+
+		LMAT_ENSURE_INLINE void swap(sparse_csc& r)
+		{
+			using std::swap;
+
+			swap(m_nrows, r.m_nrows);
+			swap(m_ncols, r.m_ncols);
+			m_colptr.swap(r.m_colptr);
+			m_rowidx.swap(r.m_rowidx);
+			m_values.swap(r.m_values);
+		}
+
+	private:
+		index_t m_nrows;
+		index_t m_ncols;
+		dblock<TI> m_colptr;
+		dblock<TI> m_rowidx;
+		dblock<T> m_values;
+	};
+
+
+	template<typename T, typename TI>
+	LMAT_ENSURE_INLINE
+	inline void swap(sparse_csc<T, TI>& a, sparse_csc<T, TI>& b)
+	{
+		a.swap(b);
+	}
+
+
+	/********************************************
+	 *
+	 *  conversion
+	 *
+	 ********************************************/
+
+	template<typename T, typename TI, class DMat>
+	inline void to_dense(const sparse_csc<T, TI>& a, IRegularMatrix<DMat, T>& dmat)
+	{
+		LMAT_CHECK_DIMS( a.nrows() == dmat.nrows() && a.ncolumns() == dmat.ncolumns() )
+
+		zero(dmat);
+
+		const TI *ri = a.ptr_rowidx();
+		const T *va = a.ptr_values();
+		DMat& d_ = dmat.derived();
+
+		for (index_t j = 0; j < a.ncolumns(); ++j)
+		{
+			const index_t pe = a.col_end(j);
+			for (index_t p = a.col_begin(j); p < pe; ++p)
+			{
+				d_(index_t(ri[p]), j) = va[p];
+			}
+		}
+	}
+
+
+	/********************************************
+	 *
+	 *  auxiliary
+	 *
+	 ********************************************/
+
+	namespace internal
+	{
+		// the element interval of a regular vector
+
+		template<typename T, class Mat>
+		inline index_t sparse_vec_intv(const IRegularMatrix<Mat, T>& vec)
+		{
+			if (meta::is_contiguous<Mat>::value || vec.nelems() <= 1)
+				return 1;
+			else if (is_column(vec))
+				return vec.row_stride();
+			else if (is_row(vec))
+				return vec.col_stride();
+			else
+				throw invalid_argument("The input is not a proper vector.");
+		}
+
+		// splits the columns into nc chunks with (roughly) the same
+		// number of non-zeros, chunk k being [bounds[k], bounds[k+1])
+
+		template<typename T, typename TI>
+		void sparse_col_partition(const sparse_csc<T, TI>& a, index_t nc, index_t *bounds)
+		{
+			const index_t n = a.ncolumns();
+			const index_t nz = a.nnz();
+			const TI *cp = a.ptr_colptr();
+
+			bounds[0] = 0;
+			for (index_t k = 1; k < nc; ++k)
+			{
+				TI t = TI(nz / nc * k + nz % nc * k / nc);
+				index_t j = index_t(std::lower_bound(cp, cp + n, t) - cp);
+				bounds[k] = j > bounds[k-1] ? j : bounds[k-1];
+			}
+			bounds[nc] = n;
+		}
+	}
+
+LMAT_END_NAMESPACE
+
+#endif
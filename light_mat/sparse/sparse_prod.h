@@ -0,0 +1,304 @@
+/**
+ * @file sparse_prod.h
+ *
+ * @brief Products between sparse and dense matrices
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_SPARSE_PROD_H_
+#define LIGHTMAT_SPARSE_PROD_H_
+
+#include <light_mat/sparse/sparse_csc.h>
+#include <light_mat/mateval/ewise_eval.h>
+
+LMAT_BEGIN_NAMESPACE
+
+	/********************************************
+	 *
+	 *  kernels
+	 *
+	 ********************************************/
+
+	namespace internal
+	{
+		template<typename T>
+		inline void sparse_scale_vec(index_t n, T beta, T *y, index_t incy)
+		{
+			if (beta == T(0))
+			{
+				for (index_t i = 0; i < n; ++i) y[i * incy] = T(0);
+			}
+			else if (beta != T(1))
+			{
+				for (index_t i = 0; i < n; ++i) y[i * incy] *= beta;
+			}
+		}
+
+		// y += alpha * a(:, j0:j1-1) * x(j0:j1-1)
+
+		template<typename T, typename TI>
+		inline void spmv_n_cols(const sparse_csc<T, TI>& a, index_t j0, index_t j1,
+				T alpha, const T *x, index_t incx, T *y, index_t incy)
+		{
+			const TI *ri = a.ptr_rowidx();
+			const T *va = a.ptr_values();
+
+			for (index_t j = j0; j < j1; ++j)
+			{
+				const T s = alpha * x[j * incx];
+				if (s != T(0))
+				{
+					const index_t pe = a.col_end(j);
+					for (index_t p = a.col_begin(j); p < pe; ++p)
+					{
+						y[index_t(ri[p]) * incy] += va[p] * s;
+					}
+				}
+			}
+		}
+
+		// the dot product between a(:,j) and x, with independent
+		// accumulators to break the dependency chain of the gather
+
+		template<typename T, typename TI>
+		LMAT_ENSURE_INLINE
+		inline T sparse_coldot(const TI *ri, const T *va, index_t pb, index_t pe,
+				const T *x, index_t incx)
+		{
+			T s0(0), s1(0), s2(0), s3(0);
+
+			index_t p = pb;
+			for (; p + 4 <= pe; p += 4)
+			{
+				s0 += va[p]     * x[index_t(ri[p])     * incx];
+				s1 += va[p + 1] * x[index_t(ri[p + 1]) * incx];
+				s2 += va[p + 2] * x[index_t(ri[p + 2]) * incx];
+				s3 += va[p + 3] * x[index_t(ri[p + 3]) * incx];
+			}
+			for (; p < pe; ++p)
+			{
+				s0 += va[p] * x[index_t(ri[p]) * incx];
+			}
+
+			return (s0 + s1) + (s2 + s3);
+		}
+
+		// y(j0:j1-1) = alpha * a(:, j0:j1-1)' * x + beta * y(j0:j1-1)
+
+		template<typename T, typename TI>
+		inline void spmv_t_cols(const sparse_csc<T, TI>& a, index_t j0, index_t j1,
+				T alpha, const T *x, index_t incx, T beta, T *y, index_t incy)
+		{
+			const TI *ri = a.ptr_rowidx();
+			const T *va = a.ptr_values();
+
+			for (index_t j = j0; j < j1; ++j)
+			{
+				const T s = alpha * sparse_coldot(ri, va, a.col_begin(j), a.col_end(j), x, incx);
+				T& yj = y[j * incy];
+				yj = beta == T(0) ? s : s + beta * yj;
+			}
+		}
+
+		template<typename T, typename TI>
+		inline void spmv_(T alpha, const sparse_csc<T, TI>& a, const T *x, index_t incx,
+				T beta, T *y, index_t incy, bool trans)
+		{
+			if (!trans)
+			{
+				sparse_scale_vec(a.nrows(), beta, y, incy);
+				spmv_n_cols(a, 0, a.ncolumns(), alpha, x, incx, y, incy);
+			}
+			else
+			{
+				spmv_t_cols(a, 0, a.ncolumns(), alpha, x, incx, beta, y, incy);
+			}
+		}
+
+		template<typename T, typename TI>
+		inline void spmv_(T alpha, const sparse_csc<T, TI>& a, const T *x, index_t incx,
+				T beta, T *y, index_t incy, bool trans, par_)
+		{
+			const index_t m = a.nrows();
+			const index_t n = a.ncolumns();
+
+			if (!par_worthy(a.nnz(), LMAT_PAR_MIN_ELEMS) || n < 2)
+			{
+				spmv_(alpha, a, x, incx, beta, y, incy, trans);
+				return;
+			}
+
+			const index_t nc = par_max_threads() < n ? par_max_threads() : n;
+			dblock<index_t> bounds(nc + 1);
+			index_t *b = bounds.ptr_data();
+			sparse_col_partition(a, nc, b);
+
+			if (trans)
+			{
+				// each chunk writes a disjoint part of y
+
+#ifdef LMAT_HAS_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+				for (index_t k = 0; k < nc; ++k)
+				{
+					spmv_t_cols(a, b[k], b[k+1], alpha, x, incx, beta, y, incy);
+				}
+			}
+			else
+			{
+				// the scattered updates of different chunks may collide,
+				// hence each chunk accumulates to a private buffer
+
+				dblock<T> buf(m * nc, lmat::zero());
+				T *pb = buf.ptr_data();
+
+#ifdef LMAT_HAS_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+				for (index_t k = 0; k < nc; ++k)
+				{
+					spmv_n_cols(a, b[k], b[k+1], alpha, x, incx, pb + k * m, 1);
+				}
+
+				par_partition rp = par_even_partition(m, nc, 1);
+				const index_t nrc = rp.nchunks();
+
+#ifdef LMAT_HAS_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+				for (index_t c = 0; c < nrc; ++c)
+				{
+					const index_t i0 = rp.chunk_begin(c);
+					const index_t i1 = i0 + rp.chunk_length(c);
+
+					for (index_t i = i0; i < i1; ++i)
+					{
+						T s = pb[i];
+						for (index_t k = 1; k < nc; ++k) s += pb[k * m + i];
+
+						T& yi = y[i * incy];
+						yi = beta == T(0) ? s : s + beta * yi;
+					}
+				}
+			}
+		}
+
+		template<typename T, typename TI, class B, class C>
+		inline void spmm_(T alpha, const sparse_csc<T, TI>& a, const B& b,
+				T beta, C& c, bool trans, index_t l0, index_t l1)
+		{
+			const index_t bs = b.row_stride();
+			const index_t cs = c.row_stride();
+
+			for (index_t l = l0; l < l1; ++l)
+			{
+				spmv_(alpha, a, b.ptr_col(l), bs, beta, c.ptr_col(l), cs, trans);
+			}
+		}
+	}
+
+
+	/********************************************
+	 *
+	 *  sparse matrix x dense vector
+	 *
+	 *  y <- alpha * op(a) * x + beta * y
+	 *
+	 ********************************************/
+
+	template<typename T, typename TI, class X, class Y>
+	inline void spmv(T alpha, const sparse_csc<T, TI>& a, const IRegularMatrix<X, T>& x,
+			T beta, IRegularMatrix<Y, T>& y, char trans='N')
+	{
+		const bool tr = trans != 'N' && trans != 'n';
+		LMAT_CHECK_DIMS( x.nelems() == (tr ? a.nrows() : a.ncolumns()) &&
+				y.nelems() == (tr ? a.ncolumns() : a.nrows()) )
+
+		internal::spmv_(alpha, a,
+				x.ptr_data(), internal::sparse_vec_intv(x), beta,
+				y.ptr_data(), internal::sparse_vec_intv(y), tr);
+	}
+
+	template<typename T, typename TI, class X, class Y>
+	inline void spmv(T alpha, const sparse_csc<T, TI>& a, const IRegularMatrix<X, T>& x,
+			T beta, IRegularMatrix<Y, T>& y, char trans, par_)
+	{
+		const bool tr = trans != 'N' && trans != 'n';
+		LMAT_CHECK_DIMS( x.nelems() == (tr ? a.nrows() : a.ncolumns()) &&
+				y.nelems() == (tr ? a.ncolumns() : a.nrows()) )
+
+		internal::spmv_(alpha, a,
+				x.ptr_data(), internal::sparse_vec_intv(x), beta,
+				y.ptr_data(), internal::sparse_vec_intv(y), tr, par_());
+	}
+
+
+	/********************************************
+	 *
+	 *  sparse matrix x dense matrix
+	 *
+	 *  c <- alpha * op(a) * b + beta * c
+	 *
+	 ********************************************/
+
+	template<typename T, typename TI, class B, class C>
+	inline void spmm(T alpha, const sparse_csc<T, TI>& a, const IRegularMatrix<B, T>& b,
+			T beta, IRegularMatrix<C, T>& c, char trans='N')
+	{
+		const bool tr = trans != 'N' && trans != 'n';
+		LMAT_CHECK_DIMS( b.nrows() == (tr ? a.nrows() : a.ncolumns()) &&
+				c.nrows() == (tr ? a.ncolumns() : a.nrows()) &&
+				b.ncolumns() == c.ncolumns() )
+
+		internal::spmm_(alpha, a, b.derived(), beta, c.derived(), tr, 0, c.ncolumns());
+	}
+
+	template<typename T, typename TI, class B, class C>
+	inline void spmm(T alpha, const sparse_csc<T, TI>& a, const IRegularMatrix<B, T>& b,
+			T beta, IRegularMatrix<C, T>& c, char trans, par_)
+	{
+		const bool tr = trans != 'N' && trans != 'n';
+		LMAT_CHECK_DIMS( b.nrows() == (tr ? a.nrows() : a.ncolumns()) &&
+				c.nrows() == (tr ? a.ncolumns() : a.nrows()) &&
+				b.ncolumns() == c.ncolumns() )
+
+		const index_t k = c.ncolumns();
+		const B& b_ = b.derived();
+		C& c_ = c.derived();
+
+		if (k == 1)
+		{
+			internal::spmv_(alpha, a, b_.ptr_col(0), b_.row_stride(), beta,
+					c_.ptr_col(0), c_.row_stride(), tr, par_());
+		}
+		else if (!par_worthy(a.nnz() * k, LMAT_PAR_MIN_ELEMS))
+		{
+			internal::spmm_(alpha, a, b_, beta, c_, tr, 0, k);
+		}
+		else
+		{
+			// the columns of c are independent
+
+			par_partition part = par_even_partition(k, par_max_threads(), 1);
+			const index_t nc = part.nchunks();
+
+#ifdef LMAT_HAS_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+			for (index_t t = 0; t < nc; ++t)
+			{
+				const index_t l0 = part.chunk_begin(t);
+				internal::spmm_(alpha, a, b_, beta, c_, tr, l0, l0 + part.chunk_length(t));
+			}
+		}
+	}
+
+LMAT_END_NAMESPACE
+
+#endif
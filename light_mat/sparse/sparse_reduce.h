@@ -0,0 +1,174 @@
+/**
+ * @file sparse_reduce.h
+ *
+ * @brief Column-wise reduction of sparse matrices
+ *
+ * Only the stored non-zeros are visited. The values of each
+ * column are contiguous, and thus are reduced with the
+ * vectorized kernels of dense reduction.
+ *
+ * @author Dahua Lin
+ */
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef LIGHTMAT_SPARSE_REDUCE_H_
+#define LIGHTMAT_SPARSE_REDUCE_H_
+
+#include <light_mat/sparse/sparse_csc.h>
+#include <light_mat/matrix/ref_matrix.h>
+#include <light_mat/mateval/mat_enorms.h>
+
+LMAT_BEGIN_NAMESPACE
+
+	namespace internal
+	{
+		// reductions of a column of non-zeros (none is empty)
+
+		struct sparse_sum_
+		{
+			template<typename T>
+			LMAT_ENSURE_INLINE T operator() (const cref_col<T>& v) const { return sum(v); }
+		};
+
+		struct sparse_asum_
+		{
+			template<typename T>
+			LMAT_ENSURE_INLINE T operator() (const cref_col<T>& v) const { return asum(v); }
+		};
+
+		struct sparse_amax_
+		{
+			template<typename T>
+			LMAT_ENSURE_INLINE T operator() (const cref_col<T>& v) const { return amax(v); }
+		};
+
+		struct sparse_sqsum_
+		{
+			template<typename T>
+			LMAT_ENSURE_INLINE T operator() (const cref_col<T>& v) const { return sqsum(v); }
+		};
+
+		struct sparse_norm2_
+		{
+			template<typename T>
+			LMAT_ENSURE_INLINE T operator() (const cref_col<T>& v) const { return math::sqrt(sqsum(v)); }
+		};
+
+		template<typename T, typename TI, class DMat, class Fun>
+		inline void sparse_colwise_(const sparse_csc<T, TI>& a, DMat& dmat,
+				index_t j0, index_t j1, Fun fun)
+		{
+			const T *va = a.ptr_values();
+
+			for (index_t j = j0; j < j1; ++j)
+			{
+				const index_t pb = a.col_begin(j);
+				const index_t len = a.col_end(j) - pb;
+				dmat[j] = len > 0 ? fun(cref_col<T>(va + pb, len)) : T(0);
+			}
+		}
+
+		template<typename T, typename TI, class DMat, class Fun>
+		inline void sparse_colwise(const sparse_csc<T, TI>& a, IRegularMatrix<DMat, T>& dmat, Fun fun)
+		{
+			LMAT_CHECK_DIMS( a.ncolumns() == dmat.nelems() )
+
+			sparse_colwise_(a, dmat.derived(), 0, a.ncolumns(), fun);
+		}
+
+		template<typename T, typename TI, class DMat, class Fun>
+		inline void sparse_colwise(const sparse_csc<T, TI>& a, IRegularMatrix<DMat, T>& dmat, Fun fun, par_)
+		{
+			const index_t n = a.ncolumns();
+			LMAT_CHECK_DIMS( n == dmat.nelems() )
+
+			if (!par_worthy(a.nnz(), LMAT_PAR_MIN_ELEMS) || n < 2)
+			{
+				sparse_colwise_(a, dmat.derived(), 0, n, fun);
+				return;
+			}
+
+			const index_t nc = par_max_threads() < n ? par_max_threads() : n;
+			dblock<index_t> bounds(nc + 1);
+			index_t *b = bounds.ptr_data();
+			sparse_col_partition(a, nc, b);
+
+			DMat& d_ = dmat.derived();
+
+#ifdef LMAT_HAS_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+			for (index_t k = 0; k < nc; ++k)
+			{
+				sparse_colwise_(a, d_, b[k], b[k+1], fun);
+			}
+		}
+	}
+
+
+#define LMAT_DEFINE_SPARSE_COLWISE_REDUCTION( Name ) \
+	template<typename T, typename TI, class DMat> \
+	LMAT_ENSURE_INLINE \
+	inline void colwise_##Name(const sparse_csc<T, TI>& a, IRegularMatrix<DMat, T>& dmat) { \
+		internal::sparse_colwise(a, dmat, internal::sparse_##Name##_()); } \
+	template<typename T, typename TI, class DMat> \
+	LMAT_ENSURE_INLINE \
+	inline void colwise_##Name(const sparse_csc<T, TI>& a, IRegularMatrix<DMat, T>& dmat, par_) { \
+		internal::sparse_colwise(a, dmat, internal::sparse_##Name##_(), par_()); }
+
+	LMAT_DEFINE_SPARSE_COLWISE_REDUCTION( sum )
+	LMAT_DEFINE_SPARSE_COLWISE_REDUCTION( asum )
+	LMAT_DEFINE_SPARSE_COLWISE_REDUCTION( amax )
+	LMAT_DEFINE_SPARSE_COLWISE_REDUCTION( sqsum )
+
+
+	// colwise norms
+
+	template<typename T, typename TI, class DMat>
+	LMAT_ENSURE_INLINE
+	inline void colwise_norm(const sparse_csc<T, TI>& a, IRegularMatrix<DMat, T>& dmat, norms::L1_)
+	{
+		colwise_asum(a, dmat);
+	}
+
+	template<typename T, typename TI, class DMat>
+	LMAT_ENSURE_INLINE
+	inline void colwise_norm(const sparse_csc<T, TI>& a, IRegularMatrix<DMat, T>& dmat, norms::L1_, par_)
+	{
+		colwise_asum(a, dmat, par_());
+	}
+
+	template<typename T, typename TI, class DMat>
+	LMAT_ENSURE_INLINE
+	inline void colwise_norm(const sparse_csc<T, TI>& a, IRegularMatrix<DMat, T>& dmat, norms::L2_)
+	{
+		internal::sparse_colwise(a, dmat, internal::sparse_norm2_());
+	}
+
+	template<typename T, typename TI, class DMat>
+	LMAT_ENSURE_INLINE
+	inline void colwise_norm(const sparse_csc<T, TI>& a, IRegularMatrix<DMat, T>& dmat, norms::L2_, par_)
+	{
+		internal::sparse_colwise(a, dmat, internal::sparse_norm2_(), par_());
+	}
+
+	template<typename T, typename TI, class DMat>
+	LMAT_ENSURE_INLINE
+	inline void colwise_norm(const sparse_csc<T, TI>& a, IRegularMatrix<DMat, T>& dmat, norms::Linf_)
+	{
+		colwise_amax(a, dmat);
+	}
+
+	template<typename T, typename TI, class DMat>
+	LMAT_ENSURE_INLINE
+	inline void colwise_norm(const sparse_csc<T, TI>& a, IRegularMatrix<DMat, T>& dmat, norms::Linf_, par_)
+	{
+		colwise_amax(a, dmat, par_());
+	}
+
+LMAT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,325 @@
+/**
+ * @file test_blas_batched.cpp
+ *
+ * @brief Unit testing of batched GEMM and GEMV
+ *
+ * The sizes cover both the interleaved path and the path that
+ * multiplies the matrices one by one, and batch sizes that are
+ * not multiples of the SIMD pack width.
+ *
+ * @author Dahua Lin
+ */
+
+#ifndef LMAT_USE_NATIVE_BLAS
+#define LMAT_USE_NATIVE_BLAS
+#endif
+
+#include "linalg_test_base.h"
+#include <light_mat/linalg/blas_l2.h>
+#include <light_mat/linalg/blas_l3.h>
+#include <vector>
+
+using namespace lmat;
+using namespace lmat::test;
+
+template<typename T>
+inline T batched_tol(index_t k)
+{
+	return blas_default_tol<T>::get() * T(k + 1);
+}
+
+
+/************************************************
+ *
+ *  gemm
+ *
+ ************************************************/
+
+template<typename T>
+void test_gemm_batched_strided(index_t m, index_t n, index_t k, index_t nb, char ta, char tb)
+{
+	index_t am = ta == 'N' ? m : k;
+	index_t an = ta == 'N' ? k : m;
+	index_t bm = tb == 'N' ? k : n;
+	index_t bn = tb == 'N' ? n : k;
+
+	// a has a leading dimension larger than its number of rows
+
+	index_t lda = am + 3;
+	dense_matrix<T> abuf(lda, an * nb);
+	dense_matrix<T> b(bm, bn * nb);
+	dense_matrix<T> c0(m, n * nb);
+
+	do_fill_rand(abuf.ptr_data(), abuf.nelems(), T(-1), T(1));
+	do_fill_rand(b.ptr_data(), b.nelems(), T(-1), T(1));
+	do_fill_rand(c0.ptr_data(), c0.nelems(), T(-1), T(1));
+
+	cref_block<T> a(abuf.ptr_data(), am, an * nb, lda);
+
+	dense_matrix<T> r(m, n * nb);
+	dense_matrix<T> c(c0);
+	T tol = batched_tol<T>(k);
+
+	for (index_t l = 0; l < nb; ++l)
+	{
+		cref_block<T> al(abuf.ptr_data() + l * an * lda, am, an, lda);
+		cref_block<T> bl(b.ptr_data() + l * bn * bm, bm, bn, bm);
+		cref_block<T> cl(c0.ptr_data() + l * n * m, m, n, m);
+		ref_block<T> rl(r.ptr_data() + l * n * m, m, n, m);
+		safe_mm(T(1), al, ta, bl, tb, T(0), cl, rl);
+	}
+
+	blas::gemm_batched(a, b, c, nb, ta, tb);
+	ASSERT_MAT_APPROX(m, n * nb, c, r, tol);
+
+	for (index_t l = 0; l < nb; ++l)
+	{
+		cref_block<T> al(abuf.ptr_data() + l * an * lda, am, an, lda);
+		cref_block<T> bl(b.ptr_data() + l * bn * bm, bm, bn, bm);
+		cref_block<T> cl(c0.ptr_data() + l * n * m, m, n, m);
+		ref_block<T> rl(r.ptr_data() + l * n * m, m, n, m);
+		safe_mm(T(1.5), al, ta, bl, tb, T(-0.5), cl, rl);
+	}
+
+	c = c0;
+	blas::gemm_batched(T(1.5), a, b, T(-0.5), c, nb, ta, tb);
+	ASSERT_MAT_APPROX(m, n * nb, c, r, tol);
+}
+
+T_CASE( gemm_batched_applicable )
+{
+	typedef lmat::internal::batched_gemm_engine<T> engine_t;
+
+	ASSERT_TRUE( engine_t::applicable(1, 1, 1) );
+	ASSERT_TRUE( engine_t::applicable(26, 26, 26) );
+	ASSERT_TRUE( engine_t::applicable(64, 64, 64) );
+	ASSERT_TRUE( engine_t::applicable(64, 1000, 64) );
+	ASSERT_FALSE( engine_t::applicable(100, 100, 100) );
+	ASSERT_FALSE( engine_t::applicable(4, 4, 1000) );
+}
+
+T_CASE( gemm_batched_strided )
+{
+	const int nc = 6;
+	const index_t ms[nc] = {1, 3, 16, 7, 40, 100};
+	const index_t ns[nc] = {1, 5, 16, 1, 40, 100};
+	const index_t ks[nc] = {1, 4, 16, 9, 40, 100};
+
+	const index_t nbs[2] = {1, 13};
+	const char ts[2] = {'N', 'T'};
+
+	for (int c = 0; c < nc; ++c)
+		for (int q = 0; q < 2; ++q)
+			for (int u = 0; u < 2; ++u)
+				for (int v = 0; v < 2; ++v)
+					test_gemm_batched_strided<T>(ms[c], ns[c], ks[c], nbs[q], ts[u], ts[v]);
+}
+
+AUTO_TPACK( gemm_batched_applicable )
+{
+	ADD_T_CASE( gemm_batched_applicable, float )
+	ADD_T_CASE( gemm_batched_applicable, double )
+}
+
+AUTO_TPACK( gemm_batched_strided )
+{
+	ADD_T_CASE( gemm_batched_strided, float )
+	ADD_T_CASE( gemm_batched_strided, double )
+}
+
+
+template<typename T>
+void test_gemm_batched_ptrs(index_t m, index_t n, index_t k, index_t nb, char ta, char tb)
+{
+	index_t am = ta == 'N' ? m : k;
+	index_t an = ta == 'N' ? k : m;
+	index_t bm = tb == 'N' ? k : n;
+	index_t bn = tb == 'N' ? n : k;
+
+	std::vector<dense_matrix<T> > as, bs, cs, rs;
+	std::vector<const T*> pa, pb;
+	std::vector<T*> pc;
+
+	for (index_t l = 0; l < nb; ++l)
+	{
+		as.push_back(dense_matrix<T>(am, an));
+		bs.push_back(dense_matrix<T>(bm, bn));
+		cs.push_back(dense_matrix<T>(m, n));
+		rs.push_back(dense_matrix<T>(m, n));
+
+		do_fill_rand(as[l].ptr_data(), as[l].nelems(), T(-1), T(1));
+		do_fill_rand(bs[l].ptr_data(), bs[l].nelems(), T(-1), T(1));
+		do_fill_rand(cs[l].ptr_data(), cs[l].nelems(), T(-1), T(1));
+
+		safe_mm(T(2), as[l], ta, bs[l], tb, T(0.5), cs[l], rs[l]);
+	}
+
+	// in reversed order, to make sure that nothing depends on the addresses
+
+	for (index_t l = nb - 1; l >= 0; --l)
+	{
+		pa.push_back(as[l].ptr_data());
+		pb.push_back(bs[l].ptr_data());
+		pc.push_back(cs[l].ptr_data());
+	}
+
+	blas::gemm_batched(nb, m, n, k, T(2), pa.data(), am, pb.data(), bm,
+			T(0.5), pc.data(), m, ta, tb);
+
+	for (index_t l = 0; l < nb; ++l)
+	{
+		ASSERT_MAT_APPROX(m, n, cs[l], rs[l], batched_tol<T>(k));
+	}
+}
+
+T_CASE( gemm_batched_ptrs )
+{
+	const char ts[2] = {'N', 'T'};
+
+	for (int u = 0; u < 2; ++u)
+	{
+		for (int v = 0; v < 2; ++v)
+		{
+			test_gemm_batched_ptrs<T>(5, 6, 7, 11, ts[u], ts[v]);
+			test_gemm_batched_ptrs<T>(33, 20, 50, 5, ts[u], ts[v]);
+		}
+	}
+}
+
+AUTO_TPACK( gemm_batched_ptrs )
+{
+	ADD_T_CASE( gemm_batched_ptrs, float )
+	ADD_T_CASE( gemm_batched_ptrs, double )
+}
+
+
+/************************************************
+ *
+ *  gemv
+ *
+ ************************************************/
+
+template<typename T>
+void test_gemv_batched_strided(index_t m, index_t n, index_t nb, char trans)
+{
+	index_t xn = trans == 'N' ? n : m;
+	index_t yn = trans == 'N' ? m : n;
+
+	dense_matrix<T> a(m, n * nb);
+	dense_matrix<T> x(xn, nb);
+	dense_matrix<T> y0(yn, nb);
+
+	do_fill_rand(a.ptr_data(), a.nelems(), T(-1), T(1));
+	do_fill_rand(x.ptr_data(), x.nelems(), T(-1), T(1));
+	do_fill_rand(y0.ptr_data(), y0.nelems(), T(-1), T(1));
+
+	dense_matrix<T> r(yn, nb);
+	T tol = batched_tol<T>(m + n);
+
+	for (index_t l = 0; l < nb; ++l)
+	{
+		cref_block<T> al(a.ptr_data() + l * n * m, m, n, m);
+		T *rl = r.ptr_data() + l * yn;
+		safe_mv(T(1), al, trans, x.ptr_data() + l * xn, T(0), y0.ptr_data() + l * yn, rl);
+	}
+
+	dense_matrix<T> y(y0);
+	blas::gemv_batched(a, x, y, trans);
+	ASSERT_MAT_APPROX(yn, nb, y, r, tol);
+
+	for (index_t l = 0; l < nb; ++l)
+	{
+		cref_block<T> al(a.ptr_data() + l * n * m, m, n, m);
+		T *rl = r.ptr_data() + l * yn;
+		safe_mv(T(2.5), al, trans, x.ptr_data() + l * xn, T(1.6), y0.ptr_data() + l * yn, rl);
+	}
+
+	y = y0;
+	blas::gemv_batched(T(2.5), a, x, T(1.6), y, trans);
+	ASSERT_MAT_APPROX(yn, nb, y, r, tol);
+}
+
+T_CASE( gemv_batched_strided )
+{
+	const int nc = 4;
+	const index_t ms[nc] = {1, 5, 16, 67};
+	const index_t ns[nc] = {1, 7, 16, 3};
+
+	for (int c = 0; c < nc; ++c)
+	{
+		test_gemv_batched_strided<T>(ms[c], ns[c], 13, 'N');
+		test_gemv_batched_strided<T>(ms[c], ns[c], 13, 'T');
+	}
+}
+
+AUTO_TPACK( gemv_batched_strided )
+{
+	ADD_T_CASE( gemv_batched_strided, float )
+	ADD_T_CASE( gemv_batched_strided, double )
+}
+
+
+template<typename T>
+void test_gemv_batched_ptrs(index_t m, index_t n, index_t nb, char trans)
+{
+	index_t xn = trans == 'N' ? n : m;
+	index_t yn = trans == 'N' ? m : n;
+
+	const index_t incx = 2;
+	const index_t incy = 3;
+
+	std::vector<dense_matrix<T> > as;
+	std::vector<dense_col<T> > xs, ys, rs, xcs, ycs;
+	std::vector<const T*> pa, px;
+	std::vector<T*> py;
+
+	for (index_t l = 0; l < nb; ++l)
+	{
+		as.push_back(dense_matrix<T>(m, n));
+		xs.push_back(dense_col<T>(xn * incx));
+		ys.push_back(dense_col<T>(yn * incy));
+		xcs.push_back(dense_col<T>(xn));
+		ycs.push_back(dense_col<T>(yn));
+		rs.push_back(dense_col<T>(yn));
+
+		do_fill_rand(as[l].ptr_data(), as[l].nelems(), T(-1), T(1));
+		do_fill_rand(xs[l].ptr_data(), xs[l].nelems(), T(-1), T(1));
+		do_fill_rand(ys[l].ptr_data(), ys[l].nelems(), T(-1), T(1));
+
+		for (index_t i = 0; i < xn; ++i) xcs[l][i] = xs[l][i * incx];
+		for (index_t i = 0; i < yn; ++i) ycs[l][i] = ys[l][i * incy];
+
+		safe_mv(T(2.5), as[l], trans, xcs[l], T(1.6), ycs[l], rs[l]);
+	}
+
+	for (index_t l = 0; l < nb; ++l)
+	{
+		pa.push_back(as[l].ptr_data());
+		px.push_back(xs[l].ptr_data());
+		py.push_back(ys[l].ptr_data());
+	}
+
+	blas::gemv_batched(nb, m, n, T(2.5), pa.data(), m, px.data(), incx,
+			T(1.6), py.data(), incy, trans);
+
+	for (index_t l = 0; l < nb; ++l)
+	{
+		for (index_t i = 0; i < yn; ++i) ycs[l][i] = ys[l][i * incy];
+		ASSERT_VEC_APPROX(yn, ycs[l], rs[l], batched_tol<T>(m + n));
+	}
+}
+
+T_CASE( gemv_batched_ptrs )
+{
+	test_gemv_batched_ptrs<T>(5, 7, 9, 'N');
+	test_gemv_batched_ptrs<T>(5, 7, 9, 'T');
+	test_gemv_batched_ptrs<T>(21, 18, 4, 'N');
+	test_gemv_batched_ptrs<T>(21, 18, 4, 'T');
+}
+
+AUTO_TPACK( gemv_batched_ptrs )
+{
+	ADD_T_CASE( gemv_batched_ptrs, float )
+	ADD_T_CASE( gemv_batched_ptrs, double )
+}
+
@@ -13,7 +13,7 @@ using namespace lmat;
 using namespace lmat::test;
 
 
-template<typename S, typename T, int M, int N>
+template<typename S, typename T, index_t M, index_t N>
 void test_asum()
 {
 	index_t m = M == 0 ? DM : M;
@@ -36,7 +36,7 @@ void test_asum()
 }
 
 
-template<typename S, typename T, int M, int N>
+template<typename S, typename T, index_t M, index_t N>
 void test_axpy()
 {
 	index_t m = M == 0 ? DM : M;
@@ -68,7 +68,7 @@ void test_axpy()
 }
 
 
-template<typename S, typename T, int M, int N>
+template<typename S, typename T, index_t M, index_t N>
 void test_nrm2()
 {
 	index_t m = M == 0 ? DM : M;
@@ -91,7 +91,7 @@ void test_nrm2()
 }
 
 
-template<typename S, typename T, int M, int N>
+template<typename S, typename T, index_t M, index_t N>
 void test_dot()
 {
 	index_t m = M == 0 ? DM : M;
@@ -118,7 +118,7 @@ void test_dot()
 }
 
 
-template<typename S, typename T, int M, int N>
+template<typename S, typename T, index_t M, index_t N>
 void test_rot()
 {
 	index_t m = M == 0 ? DM : M;
@@ -152,7 +152,7 @@ void test_rot()
 }
 
 
-template<typename S, typename T, int M, int N>
+template<typename S, typename T, index_t M, index_t N>
 void test_scal()
 {
 	index_t m = M == 0 ? DM : M;
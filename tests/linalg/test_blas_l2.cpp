@@ -13,7 +13,7 @@ using namespace lmat;
 using namespace lmat::test;
 
 
-template<class SA, class SX, class SY, typename T, int M, int N>
+template<class SA, class SX, class SY, typename T, index_t M, index_t N>
 void test_gemv_n()
 {
 	index_t m = M == 0 ? DM : M;
@@ -52,7 +52,7 @@ void test_gemv_n()
 	ASSERT_VEC_APPROX(m, y, r, tol);
 }
 
-template<class SA, class SX, class SY, typename T, int M, int N>
+template<class SA, class SX, class SY, typename T, index_t M, index_t N>
 void test_gemv_t()
 {
 	index_t m = M == 0 ? DM : M;
@@ -92,7 +92,7 @@ void test_gemv_t()
 }
 
 
-template<class SA, class SX, class SY, typename T, int N>
+template<class SA, class SX, class SY, typename T, index_t N>
 void test_symv_n()
 {
 	index_t n = N == 0 ? DN : N;
@@ -132,7 +132,7 @@ void test_symv_n()
 	ASSERT_VEC_APPROX(n, y, r, tol);
 }
 
-template<class SA, class SX, class SY, typename T, int N>
+template<class SA, class SX, class SY, typename T, index_t N>
 void test_symv_t()
 {
 	index_t n = N == 0 ? DN : N;
@@ -173,7 +173,7 @@ void test_symv_t()
 }
 
 
-template<class SA, class SY, typename T, int N>
+template<class SA, class SY, typename T, index_t N>
 void test_trmv_n(char uplo)
 {
 	index_t n = N == 0 ? DN : N;
@@ -209,7 +209,7 @@ void test_trmv_n(char uplo)
 	ASSERT_VEC_APPROX(n, y, r, tol);
 }
 
-template<class SA, class SY, typename T, int N>
+template<class SA, class SY, typename T, index_t N>
 void test_trmv_t(char uplo)
 {
 	index_t n = N == 0 ? DN : N;
@@ -246,7 +246,7 @@ void test_trmv_t(char uplo)
 }
 
 
-template<class SA, class SY, typename T, int N>
+template<class SA, class SY, typename T, index_t N>
 void test_trsv_n(char uplo)
 {
 	index_t n = N == 0 ? DN : N;
@@ -288,7 +288,7 @@ void test_trsv_n(char uplo)
 }
 
 
-template<class SA, class SY, typename T, int N>
+template<class SA, class SY, typename T, index_t N>
 void test_trsv_t(char uplo)
 {
 	index_t n = N == 0 ? DN : N;
@@ -330,7 +330,7 @@ void test_trsv_t(char uplo)
 }
 
 
-template<class SA, class SX, class SY, typename T, int M, int N>
+template<class SA, class SX, class SY, typename T, index_t M, index_t N>
 void test_ger()
 {
 	index_t m = M == 0 ? DM : M;
@@ -14,7 +14,7 @@ using namespace lmat::test;
 
 const index_t DK = 5;
 
-template<class SA, class SB, class SC, typename T, int M, int N>
+template<class SA, class SB, class SC, typename T, index_t M, index_t N>
 void test_gemm_nn()
 {
 	index_t m = M == 0 ? DM : M;
@@ -54,7 +54,7 @@ void test_gemm_nn()
 	ASSERT_MAT_APPROX(m, n, c, r, tol);
 }
 
-template<class SA, class SB, class SC, typename T, int M, int N>
+template<class SA, class SB, class SC, typename T, index_t M, index_t N>
 void test_gemm_nt()
 {
 	index_t m = M == 0 ? DM : M;
@@ -94,7 +94,7 @@ void test_gemm_nt()
 }
 
 
-template<class SA, class SB, class SC, typename T, int M, int N>
+template<class SA, class SB, class SC, typename T, index_t M, index_t N>
 void test_gemm_tn()
 {
 	index_t m = M == 0 ? DM : M;
@@ -135,7 +135,7 @@ void test_gemm_tn()
 }
 
 
-template<class SA, class SB, class SC, typename T, int M, int N>
+template<class SA, class SB, class SC, typename T, index_t M, index_t N>
 void test_gemm_tt()
 {
 	index_t m = M == 0 ? DM : M;
@@ -175,7 +175,7 @@ void test_gemm_tt()
 }
 
 
-template<class SA, class SB, class SC, typename T, int M, int N>
+template<class SA, class SB, class SC, typename T, index_t M, index_t N>
 void test_symm_l()
 {
 	index_t m = M == 0 ? DM : M;
@@ -214,7 +214,7 @@ void test_symm_l()
 	ASSERT_MAT_APPROX(m, n, c, r, tol);
 }
 
-template<class SA, class SB, class SC, typename T, int M, int N>
+template<class SA, class SB, class SC, typename T, index_t M, index_t N>
 void test_symm_r()
 {
 	index_t m = M == 0 ? DM : M;
@@ -254,7 +254,7 @@ void test_symm_r()
 }
 
 
-template<class SA, class SB, class SC, typename T, int M, int N>
+template<class SA, class SB, class SC, typename T, index_t M, index_t N>
 void test_trmm_ln(char uplo)
 {
 	index_t m = M == 0 ? DM : M;
@@ -282,7 +282,7 @@ void test_trmm_ln(char uplo)
 	ASSERT_MAT_APPROX(m, n, b, r, tol);
 }
 
-template<class SA, class SB, class SC, typename T, int M, int N>
+template<class SA, class SB, class SC, typename T, index_t M, index_t N>
 void test_trmm_lt(char uplo)
 {
 	index_t m = M == 0 ? DM : M;
@@ -310,7 +310,7 @@ void test_trmm_lt(char uplo)
 	ASSERT_MAT_APPROX(m, n, b, r, tol);
 }
 
-template<class SA, class SB, class SC, typename T, int M, int N>
+template<class SA, class SB, class SC, typename T, index_t M, index_t N>
 void test_trmm_rn(char uplo)
 {
 	index_t m = M == 0 ? DM : M;
@@ -339,7 +339,7 @@ void test_trmm_rn(char uplo)
 }
 
 
-template<class SA, class SB, class SC, typename T, int M, int N>
+template<class SA, class SB, class SC, typename T, index_t M, index_t N>
 void test_trmm_rt(char uplo)
 {
 	index_t m = M == 0 ? DM : M;
@@ -368,7 +368,7 @@ void test_trmm_rt(char uplo)
 }
 
 
-template<class SA, class SB, class SC, typename T, int M, int N>
+template<class SA, class SB, class SC, typename T, index_t M, index_t N>
 void test_trsm_ln(char uplo)
 {
 	index_t m = M == 0 ? DM : M;
@@ -399,7 +399,7 @@ void test_trsm_ln(char uplo)
 }
 
 
-template<class SA, class SB, class SC, typename T, int M, int N>
+template<class SA, class SB, class SC, typename T, index_t M, index_t N>
 void test_trsm_lt(char uplo)
 {
 	index_t m = M == 0 ? DM : M;
@@ -429,7 +429,7 @@ void test_trsm_lt(char uplo)
 	ASSERT_MAT_APPROX(m, n, p, r, tol);
 }
 
-template<class SA, class SB, class SC, typename T, int M, int N>
+template<class SA, class SB, class SC, typename T, index_t M, index_t N>
 void test_trsm_rn(char uplo)
 {
 	index_t m = M == 0 ? DM : M;
@@ -459,7 +459,7 @@ void test_trsm_rn(char uplo)
 	ASSERT_MAT_APPROX(m, n, p, r, tol);
 }
 
-template<class SA, class SB, class SC, typename T, int M, int N>
+template<class SA, class SB, class SC, typename T, index_t M, index_t N>
 void test_trsm_rt(char uplo)
 {
 	index_t m = M == 0 ? DM : M;
@@ -0,0 +1,571 @@
+/**
+ * @file test_lapack_batched.cpp
+ *
+ * @brief Unit testing of batched LU, Cholesky and triangular solves
+ *
+ * The batched routines have a native implementation, so that the test
+ * needs neither BLAS nor LAPACK at link time.
+ *
+ * @author Dahua Lin
+ */
+
+#ifndef LMAT_USE_NATIVE_BLAS
+#define LMAT_USE_NATIVE_BLAS
+#endif
+
+#include "linalg_test_base.h"
+#include <light_mat/linalg/blas_l2.h>
+#include <light_mat/linalg/lapack_lu.h>
+#include <light_mat/linalg/lapack_chol.h>
+#include <vector>
+
+using namespace lmat;
+using namespace lmat::test;
+
+template<typename T>
+inline T batched_tol()
+{
+	return (T)(sizeof(T) == 4 ? 2.0e-5 : 1.0e-10);
+}
+
+// the l-th block of w consecutive columns
+
+template<typename T>
+inline ref_block<T> col_block(dense_matrix<T>& a, index_t l, index_t w)
+{
+	return ref_block<T>(a.ptr_data() + l * w * a.col_stride(), a.nrows(), w, a.col_stride());
+}
+
+// a well-conditioned matrix, whose LU factorization must
+// interchange rows: a diagonally dominant one upside down
+
+template<typename T, class Mat>
+void fill_pivoting(IRegularMatrix<Mat, T>& a)
+{
+	const index_t n = a.nrows();
+
+	for (index_t j = 0; j < n; ++j)
+	{
+		for (index_t i = 0; i < n; ++i)
+		{
+			a(n - 1 - i, j) = i == j ?
+					randunif<T>(T(1), T(3)) :
+					randunif<T>(T(-1), T(1)) / T(n);
+		}
+	}
+}
+
+// r = a * x or a' * x, blockwise
+
+template<typename T>
+void batched_mm(dense_matrix<T>& a, char trans, dense_matrix<T>& x, index_t nb, dense_matrix<T>& r)
+{
+	const index_t n = a.nrows();
+	const index_t k = x.ncolumns() / nb;
+
+	for (index_t l = 0; l < nb; ++l)
+	{
+		ref_block<T> al = col_block(a, l, n);
+		ref_block<T> xl = col_block(x, l, k);
+		ref_block<T> rl = col_block(r, l, k);
+		safe_mm(T(1), al, trans, xl, 'N', T(0), xl, rl);
+	}
+}
+
+
+/************************************************
+ *
+ *  Cholesky
+ *
+ ************************************************/
+
+template<typename T>
+void test_posv_batched(index_t n, index_t nb, char uplo)
+{
+	const index_t nrhs = 2;
+	const bool lower = uplo == 'L';
+
+	dense_matrix<T> a0(n, n * nb);
+	for (index_t l = 0; l < nb; ++l)
+	{
+		ref_block<T> al = col_block(a0, l, n);
+		fill_rand_pdm(al);
+	}
+
+	dense_matrix<T> b0(n, nrhs * nb);
+	do_fill_rand(b0.ptr_data(), b0.nelems(), T(-1), T(1));
+
+	T tol = batched_tol<T>();
+	dense_matrix<T> r(n, nrhs * nb);
+
+	// posv
+
+	dense_matrix<T> a(a0);
+	dense_matrix<T> x(b0);
+	lapack::posv_batched(a, x, uplo);
+
+	batched_mm(a0, 'N', x, nb, r);
+	ASSERT_MAT_APPROX(n, nrhs * nb, r, b0, tol);
+
+	// potrf: the referenced triangle is the factor, the other one is untouched
+
+	dense_matrix<T> f(a0);
+	lapack::potrf_batched(f, uplo);
+
+	dense_matrix<T> ff(n, n * nb);
+	for (index_t l = 0; l < nb; ++l)
+	{
+		for (index_t j = 0; j < n; ++j)
+		{
+			for (index_t i = 0; i < n; ++i)
+			{
+				if (i != j && (i > j) != lower)
+				{
+					ASSERT_EQ( f(i, l * n + j), a0(i, l * n + j) );
+					f(i, l * n + j) = T(0);
+				}
+			}
+		}
+
+		ref_block<T> fl = col_block(f, l, n);
+		ref_block<T> pl = col_block(ff, l, n);
+		if (lower)
+			safe_mm(T(1), fl, 'N', fl, 'T', T(0), fl, pl);
+		else
+			safe_mm(T(1), fl, 'T', fl, 'N', T(0), fl, pl);
+	}
+	ASSERT_MAT_APPROX(n, n * nb, ff, a0, tol);
+
+	// potrs, with the factors from posv
+
+	dense_matrix<T> x2(b0);
+	lapack::potrs_batched(a, x2, uplo);
+	ASSERT_MAT_APPROX(n, nrhs * nb, x2, x, tol);
+}
+
+T_CASE( posv_batched )
+{
+	const index_t ns[4] = {1, 3, 6, 9};
+	const index_t nbs[2] = {1, 13};
+	const char uplos[2] = {'L', 'U'};
+
+	for (int i = 0; i < 4; ++i)
+		for (int q = 0; q < 2; ++q)
+			for (int u = 0; u < 2; ++u)
+				test_posv_batched<T>(ns[i], nbs[q], uplos[u]);
+}
+
+AUTO_TPACK( posv_batched )
+{
+	ADD_T_CASE( posv_batched, float )
+	ADD_T_CASE( posv_batched, double )
+}
+
+
+T_CASE( posv_batched_ptrs )
+{
+	const index_t n = 6;
+	const index_t nrhs = 3;
+	const index_t nb = 11;
+	const index_t lda = n + 2;
+
+	std::vector<dense_matrix<T> > as, bs, a0s, b0s;
+	std::vector<T*> pa, pb;
+
+	for (index_t l = 0; l < nb; ++l)
+	{
+		as.push_back(dense_matrix<T>(lda, n));
+		bs.push_back(dense_matrix<T>(n, nrhs));
+
+		ref_block<T> al(as[l].ptr_data(), n, n, lda);
+		fill_rand_pdm(al);
+		do_fill_rand(bs[l].ptr_data(), bs[l].nelems(), T(-1), T(1));
+
+		a0s.push_back(dense_matrix<T>(al));
+		b0s.push_back(bs[l]);
+	}
+
+	for (index_t l = 0; l < nb; ++l)
+	{
+		pa.push_back(as[l].ptr_data());
+		pb.push_back(bs[l].ptr_data());
+	}
+
+	std::vector<lapack_int> info(nb, -1);
+	lapack::posv_batched(nb, n, nrhs, pa.data(), lda, pb.data(), n, 'L', info.data());
+
+	dense_matrix<T> r(n, nrhs);
+	for (index_t l = 0; l < nb; ++l)
+	{
+		ASSERT_EQ( info[l], 0 );
+		safe_mm(T(1), a0s[l], 'N', bs[l], 'N', T(0), bs[l], r);
+		ASSERT_MAT_APPROX(n, nrhs, r, b0s[l], batched_tol<T>());
+	}
+}
+
+AUTO_TPACK( posv_batched_ptrs )
+{
+	ADD_T_CASE( posv_batched_ptrs, float )
+	ADD_T_CASE( posv_batched_ptrs, double )
+}
+
+
+T_CASE( potrf_batched_nonpd )
+{
+	const index_t n = 4;
+	const index_t nb = 7;
+
+	dense_matrix<T> a(n, n * nb);
+	for (index_t l = 0; l < nb; ++l)
+	{
+		ref_block<T> al = col_block(a, l, n);
+		fill_eye(al);
+	}
+	a(2, 3 * n + 2) = T(-1);
+
+	// with an info array, every system gets its code
+
+	dense_matrix<T> f(a);
+	std::vector<lapack_int> info(nb, -1);
+	lapack::potrf_batched(f, 'L', info.data());
+
+	for (index_t l = 0; l < nb; ++l)
+	{
+		ASSERT_EQ( info[l], (l == 3 ? 3 : 0) );
+	}
+
+	// without, the failure throws
+
+	bool caught = false;
+	try
+	{
+		dense_matrix<T> f2(a);
+		lapack::potrf_batched(f2);
+	}
+	catch (lapack::lapack_failure&)
+	{
+		caught = true;
+	}
+
+	ASSERT_TRUE( caught );
+}
+
+AUTO_TPACK( potrf_batched_nonpd )
+{
+	ADD_T_CASE( potrf_batched_nonpd, float )
+	ADD_T_CASE( potrf_batched_nonpd, double )
+}
+
+
+/************************************************
+ *
+ *  LU
+ *
+ ************************************************/
+
+template<typename T>
+void test_gesv_batched(index_t n, index_t nb)
+{
+	const index_t nrhs = 2;
+
+	dense_matrix<T> a0(n, n * nb);
+	for (index_t l = 0; l < nb; ++l)
+	{
+		ref_block<T> al = col_block(a0, l, n);
+		fill_pivoting(al);
+	}
+
+	dense_matrix<T> b0(n, nrhs * nb);
+	do_fill_rand(b0.ptr_data(), b0.nelems(), T(-1), T(1));
+
+	T tol = batched_tol<T>();
+	dense_matrix<T> r(n, nrhs * nb);
+
+	// gesv
+
+	dense_matrix<T> a(a0);
+	dense_matrix<T> x(b0);
+	lapack::gesv_batched(a, x);
+
+	batched_mm(a0, 'N', x, nb, r);
+	ASSERT_MAT_APPROX(n, nrhs * nb, r, b0, tol);
+
+	// getrf and getrs
+
+	dense_matrix<T> f(a0);
+	std::vector<lapack_int> ipiv(n * nb);
+	lapack::getrf_batched(f, ipiv.data());
+
+	for (index_t l = 0; l < nb; ++l)
+	{
+		for (index_t i = 0; i < n; ++i)
+		{
+			lapack_int p = ipiv[l * n + i];
+			ASSERT_TRUE( p >= i + 1 && p <= n );
+		}
+	}
+
+	ASSERT_MAT_APPROX(n, n * nb, f, a, tol);
+
+	x = b0;
+	lapack::getrs_batched(f, ipiv.data(), x);
+	batched_mm(a0, 'N', x, nb, r);
+	ASSERT_MAT_APPROX(n, nrhs * nb, r, b0, tol);
+
+	x = b0;
+	lapack::getrs_batched(f, ipiv.data(), x, 'T');
+	batched_mm(a0, 'T', x, nb, r);
+	ASSERT_MAT_APPROX(n, nrhs * nb, r, b0, tol);
+}
+
+T_CASE( gesv_batched )
+{
+	const index_t ns[4] = {1, 3, 6, 9};
+	const index_t nbs[2] = {1, 13};
+
+	for (int i = 0; i < 4; ++i)
+		for (int q = 0; q < 2; ++q)
+			test_gesv_batched<T>(ns[i], nbs[q]);
+}
+
+AUTO_TPACK( gesv_batched )
+{
+	ADD_T_CASE( gesv_batched, float )
+	ADD_T_CASE( gesv_batched, double )
+}
+
+
+T_CASE( gesv_batched_ptrs )
+{
+	const index_t n = 5;
+	const index_t nrhs = 2;
+	const index_t nb = 9;
+	const index_t lda = n + 1;
+	const index_t ldb = n + 3;
+
+	std::vector<dense_matrix<T> > as, bs, a0s, b0s;
+	std::vector<T*> pa, pb;
+	std::vector<const T*> pca;
+
+	for (index_t l = 0; l < nb; ++l)
+	{
+		as.push_back(dense_matrix<T>(lda, n));
+		bs.push_back(dense_matrix<T>(ldb, nrhs));
+
+		ref_block<T> al(as[l].ptr_data(), n, n, lda);
+		ref_block<T> bl(bs[l].ptr_data(), n, nrhs, ldb);
+		fill_pivoting(al);
+		do_fill_rand(bs[l].ptr_data(), bs[l].nelems(), T(-1), T(1));
+
+		a0s.push_back(dense_matrix<T>(al));
+		b0s.push_back(dense_matrix<T>(bl));
+	}
+
+	// in reversed order, to make sure that nothing depends on the addresses
+
+	for (index_t l = nb - 1; l >= 0; --l)
+	{
+		pa.push_back(as[l].ptr_data());
+		pca.push_back(as[l].ptr_data());
+		pb.push_back(bs[l].ptr_data());
+	}
+
+	std::vector<lapack_int> ipiv(n * nb);
+	lapack::getrf_batched(nb, n, pa.data(), lda, ipiv.data());
+	lapack::getrs_batched(nb, n, nrhs, pca.data(), lda, ipiv.data(), pb.data(), ldb, 'T');
+
+	dense_matrix<T> r(n, nrhs);
+	for (index_t l = 0; l < nb; ++l)
+	{
+		cref_block<T> xl(bs[l].ptr_data(), n, nrhs, ldb);
+		safe_mm(T(1), a0s[l], 'T', xl, 'N', T(0), xl, r);
+		ASSERT_MAT_APPROX(n, nrhs, r, b0s[l], batched_tol<T>());
+	}
+
+	for (index_t l = 0; l < nb; ++l)
+	{
+		ref_block<T> al(as[l].ptr_data(), n, n, lda);
+		ref_block<T> bl(bs[l].ptr_data(), n, nrhs, ldb);
+		al = a0s[l];
+		bl = b0s[l];
+	}
+
+	lapack::gesv_batched(nb, n, nrhs, pa.data(), lda, pb.data(), ldb);
+
+	for (index_t l = 0; l < nb; ++l)
+	{
+		cref_block<T> xl(bs[l].ptr_data(), n, nrhs, ldb);
+		safe_mm(T(1), a0s[l], 'N', xl, 'N', T(0), xl, r);
+		ASSERT_MAT_APPROX(n, nrhs, r, b0s[l], batched_tol<T>());
+	}
+}
+
+AUTO_TPACK( gesv_batched_ptrs )
+{
+	ADD_T_CASE( gesv_batched_ptrs, float )
+	ADD_T_CASE( gesv_batched_ptrs, double )
+}
+
+
+T_CASE( getrf_batched_singular )
+{
+	const index_t n = 3;
+	const index_t nb = 5;
+
+	dense_matrix<T> a(n, n * nb);
+	for (index_t l = 0; l < nb; ++l)
+	{
+		ref_block<T> al = col_block(a, l, n);
+		fill_pivoting(al);
+	}
+
+	for (index_t i = 0; i < n; ++i) a(i, 4 * n + 1) = T(0);
+
+	dense_matrix<T> f(a);
+	std::vector<lapack_int> ipiv(n * nb);
+	std::vector<lapack_int> info(nb, -1);
+	lapack::getrf_batched(f, ipiv.data(), info.data());
+
+	for (index_t l = 0; l < nb; ++l)
+	{
+		ASSERT_EQ( info[l], (l == 4 ? 2 : 0) );
+	}
+
+	bool caught = false;
+	try
+	{
+		dense_matrix<T> b(n, nb, zero());
+		lapack::gesv_batched(a, b);
+	}
+	catch (lapack::lapack_failure&)
+	{
+		caught = true;
+	}
+
+	ASSERT_TRUE( caught );
+}
+
+AUTO_TPACK( getrf_batched_singular )
+{
+	ADD_T_CASE( getrf_batched_singular, float )
+	ADD_T_CASE( getrf_batched_singular, double )
+}
+
+
+/************************************************
+ *
+ *  triangular solve
+ *
+ ************************************************/
+
+template<typename T>
+void test_trsv_batched(index_t n, index_t nb, char uplo, char trans, char diag)
+{
+	dense_matrix<T> a(n, n * nb);
+	for (index_t l = 0; l < nb; ++l)
+	{
+		ref_block<T> al = col_block(a, l, n);
+		for (index_t j = 0; j < n; ++j)
+			for (index_t i = 0; i < n; ++i) al(i, j) = T(100);
+		fill_rand_tri(al, uplo);
+	}
+
+	// the effective triangular matrices
+
+	dense_matrix<T> ea(n, n * nb);
+	for (index_t l = 0; l < nb; ++l)
+	{
+		for (index_t j = 0; j < n; ++j)
+		{
+			for (index_t i = 0; i < n; ++i)
+			{
+				T v = a(i, l * n + j);
+				if (i == j)
+					v = diag == 'U' ? T(1) : v;
+				else if ((i > j) != (uplo == 'L'))
+					v = T(0);
+				ea(i, l * n + j) = v;
+			}
+		}
+	}
+
+	dense_matrix<T> b0(n, nb);
+	do_fill_rand(b0.ptr_data(), b0.nelems(), T(-1), T(1));
+
+	dense_matrix<T> x(b0);
+	blas::trsv_batched(a, x, blas::trs(uplo, trans, diag));
+
+	dense_matrix<T> r(n, nb);
+	batched_mm(ea, trans, x, nb, r);
+	ASSERT_MAT_APPROX(n, nb, r, b0, batched_tol<T>());
+}
+
+T_CASE( trsv_batched )
+{
+	const char uplos[2] = {'L', 'U'};
+	const char ts[2] = {'N', 'T'};
+	const char diags[2] = {'N', 'U'};
+
+	for (int u = 0; u < 2; ++u)
+	for (int v = 0; v < 2; ++v)
+	for (int d = 0; d < 2; ++d)
+	{
+		test_trsv_batched<T>(1, 13, uplos[u], ts[v], diags[d]);
+		test_trsv_batched<T>(7, 13, uplos[u], ts[v], diags[d]);
+		test_trsv_batched<T>(12, 3, uplos[u], ts[v], diags[d]);
+	}
+}
+
+AUTO_TPACK( trsv_batched )
+{
+	ADD_T_CASE( trsv_batched, float )
+	ADD_T_CASE( trsv_batched, double )
+}
+
+
+T_CASE( trsv_batched_ptrs )
+{
+	const index_t n = 6;
+	const index_t nb = 10;
+	const index_t incx = 2;
+
+	std::vector<dense_matrix<T> > as;
+	std::vector<dense_col<T> > xs, b0s;
+	std::vector<const T*> pa;
+	std::vector<T*> px;
+
+	for (index_t l = 0; l < nb; ++l)
+	{
+		as.push_back(dense_matrix<T>(n, n, zero()));
+		xs.push_back(dense_col<T>(n * incx));
+		b0s.push_back(dense_col<T>(n));
+
+		fill_rand_tri(as[l], 'U');
+		do_fill_rand(xs[l].ptr_data(), xs[l].nelems(), T(-1), T(1));
+		for (index_t i = 0; i < n; ++i) b0s[l][i] = xs[l][i * incx];
+	}
+
+	for (index_t l = 0; l < nb; ++l)
+	{
+		pa.push_back(as[l].ptr_data());
+		px.push_back(xs[l].ptr_data());
+	}
+
+	blas::trsv_batched(nb, n, pa.data(), n, px.data(), incx, blas::trs('U', 'N', 'N'));
+
+	dense_col<T> x(n);
+	dense_col<T> r(n);
+	for (index_t l = 0; l < nb; ++l)
+	{
+		for (index_t i = 0; i < n; ++i) x[i] = xs[l][i * incx];
+		safe_mv(T(1), as[l], 'N', x, T(0), x, r);
+		ASSERT_VEC_APPROX(n, r, b0s[l], batched_tol<T>());
+	}
+}
+
+AUTO_TPACK( trsv_batched_ptrs )
+{
+	ADD_T_CASE( trsv_batched_ptrs, float )
+	ADD_T_CASE( trsv_batched_ptrs, double )
+}
+
@@ -16,6 +16,7 @@ using namespace lmat::test;
 
 using lmat::lapack::gesvd;
 using lmat::lapack::gesdd;
+using lmat::lapack::workspace;
 
 
 #define DISP(a) std::printf("\n" #a "=\n"); printf_mat("%10.4g ", a); std::printf("\n")
@@ -319,6 +320,40 @@ T_CASE( mat_sdd_lt )
 }
 
 
+T_CASE( mat_svd_ws )
+{
+	index_t m = 8;
+	index_t n = 5;
+
+	dense_matrix<T> a(m, n);
+	do_fill_rand(a.ptr_data(), m * n);
+
+	T tol = (T)(sizeof(T) == 4 ? 2.0e-5 : 1.0e-10);
+
+	dense_col<T> s0;
+	gesvd(a, s0);
+
+	workspace ws;
+
+	for (int t = 0; t < 2; ++t)
+	{
+		dense_col<T> s;
+		dense_matrix<T> u;
+		dense_matrix<T> vt;
+
+		gesvd(a, s, u, vt, ws);
+		ASSERT_VEC_APPROX(n, s, s0, tol);
+		ASSERT_TRUE( check_svd(a, s, u, vt, tol) );
+
+		gesdd(a, s, u, vt, ws, 'S');
+		ASSERT_VEC_APPROX(n, s, s0, tol);
+		ASSERT_TRUE( check_svd(a, s, u, vt, tol) );
+
+		ASSERT_EQ( ws.num_cached(), 2 );
+	}
+}
+
+
 AUTO_TPACK( mat_svd )
 {
 	ADD_T_CASE( mat_svd_eq, float )
@@ -342,3 +377,9 @@ AUTO_TPACK( mat_sdd )
 
 
 
+
+AUTO_TPACK( mat_svd_ws )
+{
+	ADD_T_CASE( mat_svd_ws, float )
+	ADD_T_CASE( mat_svd_ws, double )
+}
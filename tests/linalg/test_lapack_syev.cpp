@@ -19,6 +19,7 @@ using lmat::lapack::syevr;
 
 using lmat::lapack::evr_I;
 using lmat::lapack::evr_V;
+using lmat::lapack::workspace;
 
 
 template<typename W>
@@ -218,6 +219,47 @@ T_CASE( mat_syevr )
 }
 
 
+T_CASE( mat_syev_ws )
+{
+	typedef mat_host<bloc, T, 0, 0> host_t;
+	typedef typename host_t::mat_t mat_t;
+
+	index_t m = DM;
+	host_t a_host(m, m);
+	mat_t a = a_host.get_mat();
+	fill_rand_pdm(a);
+
+	T tol0 = (T)(sizeof(T) == 4 ? 1.0e-4 : 1.0e-12);
+	T tol = (T)(sizeof(T) == 4 ? 1.0e-4 : 1.0e-10);
+
+	dense_col<T> w0(m);
+	syev(a, w0);
+
+	workspace ws;
+
+	for (int t = 0; t < 2; ++t)
+	{
+		dense_col<T> w(m);
+		dense_matrix<T> V(m, m);
+
+		syev(a, w, V, ws);
+		test_syev(a, w0, w, V, tol0, tol);
+
+		syevd(a, w, V, ws);
+		test_syev(a, w0, w, V, tol0, tol);
+
+		dense_col<T> wr;
+		dense_matrix<T> Vr;
+		index_t ret = syevr(a, wr, Vr, ws);
+		ASSERT_EQ( ret, m );
+		test_syev(a, w0, wr, Vr, tol0, tol);
+
+		// queries are only issued on the first round
+		ASSERT_EQ( ws.num_cached(), 3 );
+	}
+}
+
+
 AUTO_TPACK( mat_syev )
 {
 	ADD_T_CASE( mat_syev, float )
@@ -236,5 +278,11 @@ AUTO_TPACK( mat_syevr )
 	ADD_T_CASE( mat_syevr, double )
 }
 
+AUTO_TPACK( mat_syev_ws )
+{
+	ADD_T_CASE( mat_syev_ws, float )
+	ADD_T_CASE( mat_syev_ws, double )
+}
+
 
 
@@ -0,0 +1,248 @@
+/**
+ * @file test_mat_prod.cpp
+ *
+ * @brief Unit testing of matrix product expressions
+ *
+ * @author Dahua Lin
+ */
+
+#include "linalg_test_base.h"
+#include <light_mat/linalg/mat_prod.h>
+
+using namespace lmat;
+using namespace lmat::test;
+
+const index_t DK = 5;
+
+
+template<typename T>
+void fill_rand_mat(dense_matrix<T>& a, index_t m, index_t n)
+{
+	a.require_size(m, n);
+	for (index_t i = 0; i < m * n; ++i) a[i] = randunif(T(-1), T(1));
+}
+
+
+T_CASE( mat_mm )
+{
+	index_t m = DM;
+	index_t n = DN;
+	index_t k = DK;
+
+	dense_matrix<T> a, b, at, bt;
+	fill_rand_mat(a, m, k);
+	fill_rand_mat(b, k, n);
+	fill_rand_mat(at, k, m);
+	fill_rand_mat(bt, n, k);
+
+	dense_matrix<T> z(m, n, zero());
+	dense_matrix<T> r(m, n);
+	T tol = blas_default_tol<T>::get();
+
+	dense_matrix<T> c = mm(a, b);
+	safe_mm(T(1), a, 'n', b, 'n', T(0), z, r);
+	ASSERT_MAT_APPROX(m, n, c, r, tol);
+
+	c = mm(a, transpose(bt));
+	safe_mm(T(1), a, 'n', bt, 't', T(0), z, r);
+	ASSERT_MAT_APPROX(m, n, c, r, tol);
+
+	c = mm(transpose(at), b);
+	safe_mm(T(1), at, 't', b, 'n', T(0), z, r);
+	ASSERT_MAT_APPROX(m, n, c, r, tol);
+
+	c = T(2) * mm(transpose(at), transpose(bt));
+	safe_mm(T(2), at, 't', bt, 't', T(0), z, r);
+	ASSERT_MAT_APPROX(m, n, c, r, tol);
+
+	c = -mm(a, b) * T(3);
+	safe_mm(T(-3), a, 'n', b, 'n', T(0), z, r);
+	ASSERT_MAT_APPROX(m, n, c, r, tol);
+}
+
+
+T_CASE( mat_mm_fused )
+{
+	index_t m = DM;
+	index_t n = DN;
+	index_t k = DK;
+
+	dense_matrix<T> a, b, d;
+	fill_rand_mat(a, m, k);
+	fill_rand_mat(b, k, n);
+	fill_rand_mat(d, m, n);
+
+	dense_matrix<T> r(m, n);
+	T tol = blas_default_tol<T>::get();
+
+	T alpha = T(2.5);
+	T beta = T(1.5);
+
+	// into a separate destination
+
+	dense_matrix<T> c = alpha * mm(a, b) + beta * d;
+	safe_mm(alpha, a, 'n', b, 'n', beta, d, r);
+	ASSERT_MAT_APPROX(m, n, c, r, tol);
+
+	c = d * beta + mm(a, b);
+	safe_mm(T(1), a, 'n', b, 'n', beta, d, r);
+	ASSERT_MAT_APPROX(m, n, c, r, tol);
+
+	c = mm(a, b) - d;
+	safe_mm(T(1), a, 'n', b, 'n', T(-1), d, r);
+	ASSERT_MAT_APPROX(m, n, c, r, tol);
+
+	c = d - mm(a, b);
+	safe_mm(T(-1), a, 'n', b, 'n', T(1), d, r);
+	ASSERT_MAT_APPROX(m, n, c, r, tol);
+
+	c = beta * d - alpha * mm(a, b);
+	safe_mm(-alpha, a, 'n', b, 'n', beta, d, r);
+	ASSERT_MAT_APPROX(m, n, c, r, tol);
+
+	// in place
+
+	dense_matrix<T> c0(d);
+	c = d;
+
+	c = alpha * mm(a, b) + beta * c;
+	safe_mm(alpha, a, 'n', b, 'n', beta, c0, r);
+	ASSERT_MAT_APPROX(m, n, c, r, tol);
+
+	c0 = c;
+	c += mm(a, b);
+	safe_mm(T(1), a, 'n', b, 'n', T(1), c0, r);
+	ASSERT_MAT_APPROX(m, n, c, r, tol);
+
+	c0 = c;
+	c -= alpha * mm(a, b);
+	safe_mm(-alpha, a, 'n', b, 'n', T(1), c0, r);
+	ASSERT_MAT_APPROX(m, n, c, r, tol);
+
+	c0 = c;
+	c = c - mm(a, b);
+	safe_mm(T(-1), a, 'n', b, 'n', T(1), c0, r);
+	ASSERT_MAT_APPROX(m, n, c, r, tol);
+}
+
+
+T_CASE( mat_mm_alias )
+{
+	index_t n = DN;
+
+	dense_matrix<T> a, b;
+	fill_rand_mat(a, n, n);
+	fill_rand_mat(b, n, n);
+
+	dense_matrix<T> z(n, n, zero());
+	dense_matrix<T> r(n, n);
+	T tol = blas_default_tol<T>::get();
+
+	dense_matrix<T> a0(a);
+	a = mm(a, b);
+	safe_mm(T(1), a0, 'n', b, 'n', T(0), z, r);
+	ASSERT_MAT_APPROX(n, n, a, r, tol);
+
+	dense_matrix<T> b0(b);
+	b = mm(transpose(b), b) + b;
+	safe_mm(T(1), b0, 't', b0, 'n', T(1), b0, r);
+	ASSERT_MAT_APPROX(n, n, b, r, tol);
+}
+
+
+T_CASE( mat_mm_small )
+{
+	dense_matrix<T, 3, 4> a;
+	dense_matrix<T, 4, 3> b;
+	dense_matrix<T, 3, 3> d;
+
+	for (index_t i = 0; i < 12; ++i) a[i] = randunif(T(-1), T(1));
+	for (index_t i = 0; i < 12; ++i) b[i] = randunif(T(-1), T(1));
+	for (index_t i = 0; i < 9; ++i) d[i] = randunif(T(-1), T(1));
+
+	dense_matrix<T> r(3, 3);
+	T tol = blas_default_tol<T>::get();
+
+	dense_matrix<T, 3, 3> c = T(2) * mm(a, b) + d;
+	safe_mm(T(2), a, 'n', b, 'n', T(1), d, r);
+	ASSERT_MAT_APPROX(3, 3, c, r, tol);
+}
+
+
+T_CASE( mat_mv )
+{
+	index_t m = DM;
+	index_t n = DN;
+
+	dense_matrix<T> a;
+	fill_rand_mat(a, m, n);
+
+	dense_col<T> x(n), xt(m), y0(m), y0t(n);
+	for (index_t i = 0; i < n; ++i) x[i] = randunif(T(-1), T(1));
+	for (index_t i = 0; i < m; ++i) xt[i] = randunif(T(-1), T(1));
+	for (index_t i = 0; i < m; ++i) y0[i] = randunif(T(-1), T(1));
+	for (index_t i = 0; i < n; ++i) y0t[i] = randunif(T(-1), T(1));
+
+	dense_col<T> r(m), rt(n);
+	T tol = blas_default_tol<T>::get();
+
+	T alpha = T(2.5);
+	T beta = T(1.5);
+
+	dense_col<T> y = mv(a, x);
+	safe_mv(T(1), a, 'n', x, T(0), y0, r);
+	ASSERT_VEC_APPROX(m, y, r, tol);
+
+	dense_col<T> yt = alpha * mv(transpose(a), xt);
+	safe_mv(alpha, a, 't', xt, T(0), y0t, rt);
+	ASSERT_VEC_APPROX(n, yt, rt, tol);
+
+	y = y0;
+	y = alpha * mv(a, x) + beta * y;
+	safe_mv(alpha, a, 'n', x, beta, y0, r);
+	ASSERT_VEC_APPROX(m, y, r, tol);
+
+	dense_col<T> y1(y);
+	y -= mv(a, x);
+	safe_mv(T(-1), a, 'n', x, T(1), y1, r);
+	ASSERT_VEC_APPROX(m, y, r, tol);
+
+	y = y0 - mv(a, x);
+	safe_mv(T(-1), a, 'n', x, T(1), y0, r);
+	ASSERT_VEC_APPROX(m, y, r, tol);
+
+	y = y0 * beta - alpha * mv(a, x);
+	safe_mv(-alpha, a, 'n', x, beta, y0, r);
+	ASSERT_VEC_APPROX(m, y, r, tol);
+}
+
+
+AUTO_TPACK( mat_mm )
+{
+	ADD_T_CASE( mat_mm, float )
+	ADD_T_CASE( mat_mm, double )
+}
+
+AUTO_TPACK( mat_mm_fused )
+{
+	ADD_T_CASE( mat_mm_fused, float )
+	ADD_T_CASE( mat_mm_fused, double )
+}
+
+AUTO_TPACK( mat_mm_alias )
+{
+	ADD_T_CASE( mat_mm_alias, float )
+	ADD_T_CASE( mat_mm_alias, double )
+}
+
+AUTO_TPACK( mat_mm_small )
+{
+	ADD_T_CASE( mat_mm_small, float )
+	ADD_T_CASE( mat_mm_small, double )
+}
+
+AUTO_TPACK( mat_mv )
+{
+	ADD_T_CASE( mat_mv, float )
+	ADD_T_CASE( mat_mv, double )
+}
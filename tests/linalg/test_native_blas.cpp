@@ -0,0 +1,280 @@
+/**
+ * @file test_native_blas.cpp
+ *
+ * @brief Unit testing of the native BLAS Level 3 backend
+ *
+ * The sizes are chosen to cross the register tile, the packed
+ * panels and the triangular blocks of the native implementation.
+ *
+ * @author Dahua Lin
+ */
+
+#ifndef LMAT_USE_NATIVE_BLAS
+#define LMAT_USE_NATIVE_BLAS
+#endif
+
+#include "linalg_test_base.h"
+#include <light_mat/linalg/blas_l3.h>
+
+using namespace lmat;
+using namespace lmat::test;
+
+template<typename T>
+inline T native_tol(index_t k)
+{
+	return blas_default_tol<T>::get() * T(k);
+}
+
+// a well-conditioned triangular matrix, with junk in the part
+// that must not be referenced, and its effective dense form
+
+template<typename T>
+void make_tri(index_t n, char uplo, char diag, dense_matrix<T>& a, dense_matrix<T>& r)
+{
+	bool lower = (uplo == 'L' || uplo == 'l');
+	bool unit = (diag == 'U' || diag == 'u');
+
+	for (index_t j = 0; j < n; ++j)
+	{
+		for (index_t i = 0; i < n; ++i)
+		{
+			if (i == j)
+			{
+				a(i, j) = unit ? T(7) : randunif<T>(T(1), T(3));
+				r(i, j) = unit ? T(1) : a(i, j);
+			}
+			else if ((i > j) == lower)
+			{
+				a(i, j) = randunif<T>(T(-2), T(2)) / T(n);
+				r(i, j) = a(i, j);
+			}
+			else
+			{
+				a(i, j) = T(100);
+				r(i, j) = T(0);
+			}
+		}
+	}
+}
+
+
+T_CASE( native_gemm )
+{
+	const int nc = 5;
+	const index_t ms[nc] = {1, 7, 37, 150, 301};
+	const index_t ns[nc] = {1, 13, 29, 70, 97};
+	const index_t ks[nc] = {1, 5, 300, 41, 533};
+
+	const char ts[2] = {'N', 'T'};
+
+	for (int c = 0; c < nc; ++c)
+	{
+		index_t m = ms[c];
+		index_t n = ns[c];
+		index_t k = ks[c];
+		T tol = native_tol<T>(k);
+
+		for (int u = 0; u < 2; ++u)
+		{
+			for (int v = 0; v < 2; ++v)
+			{
+				char ta = ts[u];
+				char tb = ts[v];
+
+				dense_matrix<T> a = ta == 'N' ? dense_matrix<T>(m, k) : dense_matrix<T>(k, m);
+				dense_matrix<T> b = tb == 'N' ? dense_matrix<T>(k, n) : dense_matrix<T>(n, k);
+				dense_matrix<T> c0(m, n);
+
+				do_fill_rand(a.ptr_data(), a.nelems(), T(-1), T(1));
+				do_fill_rand(b.ptr_data(), b.nelems(), T(-1), T(1));
+				do_fill_rand(c0.ptr_data(), c0.nelems(), T(-1), T(1));
+
+				dense_matrix<T> r(m, n);
+				dense_matrix<T> c(c0);
+
+				safe_mm(T(1), a, ta, b, tb, T(0), c0, r);
+				blas::gemm(a, b, c, ta, tb);
+				ASSERT_MAT_APPROX(m, n, c, r, tol);
+
+				c = c0;
+				safe_mm(T(1.5), a, ta, b, tb, T(-0.5), c0, r);
+				blas::gemm(T(1.5), a, b, T(-0.5), c, ta, tb);
+				ASSERT_MAT_APPROX(m, n, c, r, tol);
+			}
+		}
+	}
+}
+
+AUTO_TPACK( native_gemm )
+{
+	ADD_T_CASE( native_gemm, float )
+	ADD_T_CASE( native_gemm, double )
+}
+
+
+T_CASE( native_symm )
+{
+	const index_t m = 150;
+	const index_t n = 70;
+	const char uplos[2] = {'L', 'U'};
+
+	for (int u = 0; u < 2; ++u)
+	{
+		char uplo = uplos[u];
+
+		// left: C = alpha * S * B + beta * C
+
+		dense_matrix<T> sl(m, m);
+		fill_rand_sym(sl);
+		dense_matrix<T> al(sl);
+		for (index_t j = 0; j < m; ++j)
+			for (index_t i = 0; i < m; ++i)
+				if ((i > j) != (uplo == 'L') && i != j) al(i, j) = T(100);
+
+		dense_matrix<T> b(m, n);
+		dense_matrix<T> c0(m, n);
+		do_fill_rand(b.ptr_data(), b.nelems(), T(-1), T(1));
+		do_fill_rand(c0.ptr_data(), c0.nelems(), T(-1), T(1));
+
+		dense_matrix<T> r(m, n);
+		dense_matrix<T> c(c0);
+
+		safe_mm(T(2), sl, 'N', b, 'N', T(0.5), c0, r);
+		blas::symm(T(2), al, b, T(0.5), c, 'L', uplo);
+		ASSERT_MAT_APPROX(m, n, c, r, native_tol<T>(m));
+
+		// right: C = alpha * B * S + beta * C
+
+		dense_matrix<T> sr(n, n);
+		fill_rand_sym(sr);
+		dense_matrix<T> ar(sr);
+		for (index_t j = 0; j < n; ++j)
+			for (index_t i = 0; i < n; ++i)
+				if ((i > j) != (uplo == 'L') && i != j) ar(i, j) = T(100);
+
+		c = c0;
+		safe_mm(T(2), b, 'N', sr, 'N', T(0.5), c0, r);
+		blas::symm(T(2), ar, b, T(0.5), c, 'R', uplo);
+		ASSERT_MAT_APPROX(m, n, c, r, native_tol<T>(n));
+	}
+}
+
+AUTO_TPACK( native_symm )
+{
+	ADD_T_CASE( native_symm, float )
+	ADD_T_CASE( native_symm, double )
+}
+
+
+T_CASE( native_syrk )
+{
+	const index_t n = 300;
+	const index_t k = 37;
+	const char uplos[2] = {'L', 'U'};
+	const char ts[2] = {'N', 'T'};
+
+	for (int u = 0; u < 2; ++u)
+	{
+		for (int v = 0; v < 2; ++v)
+		{
+			char uplo = uplos[u];
+			char trans = ts[v];
+			bool lower = uplo == 'L';
+
+			dense_matrix<T> a = trans == 'N' ? dense_matrix<T>(n, k) : dense_matrix<T>(k, n);
+			dense_matrix<T> c0(n, n);
+			do_fill_rand(a.ptr_data(), a.nelems(), T(-1), T(1));
+			do_fill_rand(c0.ptr_data(), c0.nelems(), T(-1), T(1));
+
+			dense_matrix<T> r(n, n);
+			safe_mm(T(1.5), a, trans, a, trans == 'N' ? 'T' : 'N', T(-2), c0, r);
+
+			dense_matrix<T> c(c0);
+			blas::native::internal::syrk(uplo, trans, n, k,
+					T(1.5), a.ptr_data(), a.col_stride(), T(-2), c.ptr_data(), c.col_stride());
+
+			// only the referenced triangle is updated
+			for (index_t j = 0; j < n; ++j)
+			{
+				for (index_t i = 0; i < n; ++i)
+				{
+					if (i == j || (i > j) == lower)
+					{
+						ASSERT_APPROX(c(i, j), r(i, j), native_tol<T>(k));
+					}
+					else
+					{
+						ASSERT_EQ(c(i, j), c0(i, j));
+					}
+				}
+			}
+		}
+	}
+}
+
+AUTO_TPACK( native_syrk )
+{
+	ADD_T_CASE( native_syrk, float )
+	ADD_T_CASE( native_syrk, double )
+}
+
+
+T_CASE( native_trmm_trsm )
+{
+	const index_t m = 150;
+	const index_t n = 70;
+	const char sides[2] = {'L', 'R'};
+	const char uplos[2] = {'L', 'U'};
+	const char ts[2] = {'N', 'T'};
+	const char diags[2] = {'N', 'U'};
+
+	for (int s = 0; s < 2; ++s)
+	for (int u = 0; u < 2; ++u)
+	for (int v = 0; v < 2; ++v)
+	for (int d = 0; d < 2; ++d)
+	{
+		char side = sides[s];
+		blas::trs tr(uplos[u], ts[v], diags[d]);
+
+		index_t na = side == 'L' ? m : n;
+		dense_matrix<T> a(na, na);
+		dense_matrix<T> ra(na, na);
+		make_tri(na, tr.uplo, tr.diag, a, ra);
+
+		dense_matrix<T> b0(m, n);
+		do_fill_rand(b0.ptr_data(), b0.nelems(), T(-1), T(1));
+
+		T tol = native_tol<T>(na);
+		dense_matrix<T> r(m, n);
+
+		// trmm
+
+		dense_matrix<T> b(b0);
+		if (side == 'L')
+			safe_mm(T(2), ra, tr.trans, b0, 'N', T(0), b0, r);
+		else
+			safe_mm(T(2), b0, 'N', ra, tr.trans, T(0), b0, r);
+
+		blas::trmm(T(2), a, b, tr, side);
+		ASSERT_MAT_APPROX(m, n, b, r, tol);
+
+		// trsm: op(A) * X = alpha * B, or X * op(A) = alpha * B
+
+		b = b0;
+		blas::trsm(T(2), a, b, tr, side);
+
+		if (side == 'L')
+			safe_mm(T(0.5), ra, tr.trans, b, 'N', T(0), b0, r);
+		else
+			safe_mm(T(0.5), b, 'N', ra, tr.trans, T(0), b0, r);
+
+		ASSERT_MAT_APPROX(m, n, r, b0, tol);
+	}
+}
+
+AUTO_TPACK( native_trmm_trsm )
+{
+	ADD_T_CASE( native_trmm_trsm, float )
+	ADD_T_CASE( native_trmm_trsm, double )
+}
+
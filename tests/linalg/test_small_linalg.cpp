@@ -0,0 +1,378 @@
+/**
+ * @file test_small_linalg.cpp
+ *
+ * @brief Unit testing of the fixed-size small-matrix kernels
+ *
+ * All matrices here have compile-time dimensions, so that every
+ * call is routed to the kernels in internal/small_linalg.h and
+ * the test needs neither BLAS nor LAPACK at link time.
+ *
+ * @author Dahua Lin
+ */
+
+#include "linalg_test_base.h"
+#include <light_mat/linalg/blas_l2.h>
+#include <light_mat/linalg/blas_l3.h>
+#include <light_mat/linalg/lapack_lu.h>
+#include <light_mat/linalg/lapack_chol.h>
+
+using namespace lmat;
+using namespace lmat::test;
+
+using lmat::lapack::lu_fac;
+using lmat::lapack::chol_fac;
+
+template<typename T>
+inline T small_tol()
+{
+	return (T)(sizeof(T) == 4 ? 2.0e-5 : 1.0e-10);
+}
+
+
+/************************************************
+ *
+ *  gemm & gemv
+ *
+ ************************************************/
+
+template<typename T, index_t M, index_t N, index_t K, index_t AM, index_t AN, index_t BM, index_t BN>
+void test_small_gemm(char ta, char tb)
+{
+	dense_matrix<T, AM, AN> a;
+	dense_matrix<T, BM, BN> b;
+	dense_matrix<T, M, N> c0;
+
+	do_fill_rand(a.ptr_data(), a.nelems(), T(-1), T(1));
+	do_fill_rand(b.ptr_data(), b.nelems(), T(-1), T(1));
+	do_fill_rand(c0.ptr_data(), c0.nelems(), T(-1), T(1));
+
+	dense_matrix<T, M, N> r;
+	dense_matrix<T, M, N> c(c0);
+	T tol = blas_default_tol<T>::get() * T(K);
+
+	safe_mm(T(1), a, ta, b, tb, T(0), c0, r);
+	blas::gemm(a, b, c, ta, tb);
+	ASSERT_MAT_APPROX(M, N, c, r, tol);
+
+	c = c0;
+	safe_mm(T(1.5), a, ta, b, tb, T(-0.5), c0, r);
+	blas::gemm(T(1.5), a, b, T(-0.5), c, ta, tb);
+	ASSERT_MAT_APPROX(M, N, c, r, tol);
+}
+
+template<typename T, index_t M, index_t N, index_t K>
+void test_small_gemm_all()
+{
+	test_small_gemm<T, M, N, K, M, K, K, N>('N', 'N');
+	test_small_gemm<T, M, N, K, M, K, N, K>('N', 'T');
+	test_small_gemm<T, M, N, K, K, M, K, N>('T', 'N');
+	test_small_gemm<T, M, N, K, K, M, N, K>('T', 'T');
+}
+
+T_CASE( small_gemm )
+{
+	test_small_gemm_all<T, 1, 1, 1>();
+	test_small_gemm_all<T, 2, 2, 2>();
+	test_small_gemm_all<T, 3, 3, 3>();
+	test_small_gemm_all<T, 4, 4, 4>();
+	test_small_gemm_all<T, 8, 8, 8>();
+	test_small_gemm_all<T, 3, 5, 2>();
+	test_small_gemm_all<T, 8, 3, 6>();
+	test_small_gemm_all<T, 8, 1, 7>();
+}
+
+AUTO_TPACK( small_gemm )
+{
+	ADD_T_CASE( small_gemm, float )
+	ADD_T_CASE( small_gemm, double )
+}
+
+
+template<class SX, class SY, typename T, index_t M, index_t N>
+void test_small_gemv()
+{
+	dense_matrix<T, M, N> a;
+	do_fill_rand(a.ptr_data(), a.nelems(), T(-1), T(1));
+
+	T tol = blas_default_tol<T>::get() * T(M + N);
+
+	// y = alpha * a * x + beta * y
+
+	{
+		mat_host<SX, T, N, 1> x_host(N, 1);
+		mat_host<SY, T, M, 1> y_host(M, 1);
+		x_host.fill_rand();
+		y_host.fill_rand();
+
+		typename mat_host<SX, T, N, 1>::cmat_t x = x_host.get_cmat();
+		typename mat_host<SY, T, M, 1>::mat_t y = y_host.get_mat();
+
+		dense_col<T, M> r;
+		dense_col<T, M> y0(y);
+
+		safe_mv(T(1), a, 'n', x, T(0), y0, r);
+		blas::gemv(a, x, y);
+		ASSERT_VEC_APPROX(M, y, r, tol);
+
+		y0 = y;
+		safe_mv(T(2.5), a, 'n', x, T(1.6), y0, r);
+		blas::gemv(T(2.5), a, x, T(1.6), y);
+		ASSERT_VEC_APPROX(M, y, r, tol);
+	}
+
+	// y = alpha * a' * x + beta * y
+
+	{
+		mat_host<SX, T, M, 1> x_host(M, 1);
+		mat_host<SY, T, N, 1> y_host(N, 1);
+		x_host.fill_rand();
+		y_host.fill_rand();
+
+		typename mat_host<SX, T, M, 1>::cmat_t x = x_host.get_cmat();
+		typename mat_host<SY, T, N, 1>::mat_t y = y_host.get_mat();
+
+		dense_col<T, N> r;
+		dense_col<T, N> y0(y);
+
+		safe_mv(T(1), a, 't', x, T(0), y0, r);
+		blas::gemv(a, x, y, 't');
+		ASSERT_VEC_APPROX(N, y, r, tol);
+
+		y0 = y;
+		safe_mv(T(2.5), a, 't', x, T(1.6), y0, r);
+		blas::gemv(T(2.5), a, x, T(1.6), y, 't');
+		ASSERT_VEC_APPROX(N, y, r, tol);
+	}
+}
+
+template<class SX, class SY, typename T>
+void test_small_gemv_sizes()
+{
+	test_small_gemv<SX, SY, T, 1, 1>();
+	test_small_gemv<SX, SY, T, 2, 3>();
+	test_small_gemv<SX, SY, T, 4, 4>();
+	test_small_gemv<SX, SY, T, 5, 7>();
+	test_small_gemv<SX, SY, T, 8, 8>();
+	test_small_gemv<SX, SY, T, 8, 2>();
+}
+
+T_CASE( small_gemv )
+{
+	test_small_gemv_sizes<cont, cont, T>();
+	test_small_gemv_sizes<grid, cont, T>();
+	test_small_gemv_sizes<cont, grid, T>();
+	test_small_gemv_sizes<grid, grid, T>();
+}
+
+AUTO_TPACK( small_gemv )
+{
+	ADD_T_CASE( small_gemv, float )
+	ADD_T_CASE( small_gemv, double )
+}
+
+
+/************************************************
+ *
+ *  LU
+ *
+ ************************************************/
+
+template<typename T, index_t N>
+void test_small_lu()
+{
+	const int K = 3;
+
+	dense_matrix<T, N, N> a;
+	fill_prand(a, T(0.5));
+
+	dense_matrix<T, N, K> b;
+	do_fill_rand(b.ptr_data(), b.nelems(), T(-1), T(1));
+
+	T tol = small_tol<T>();
+
+	lu_fac<T> lu(a);
+	ASSERT_EQ( lu.dim(), N );
+
+	for (index_t i = 0; i < N; ++i)
+	{
+		ASSERT_TRUE( lu.ipiv()[i] >= i + 1 && lu.ipiv()[i] <= N );
+	}
+
+	dense_matrix<T, N, K> x;
+	dense_matrix<T, N, K> r;
+
+	lu.solve(b, x);
+	safe_mm(T(1), a, 'n', x, 'n', T(0), x, r);
+	ASSERT_MAT_APPROX(N, K, r, b, tol);
+
+	lu.solve(b, x, 't');
+	safe_mm(T(1), a, 't', x, 'n', T(0), x, r);
+	ASSERT_MAT_APPROX(N, K, r, b, tol);
+
+	dense_matrix<T, N, N> ainv;
+	lu_fac<T>::inv(a, ainv);
+
+	dense_matrix<T, N, N> eye;
+	fill_eye(eye);
+
+	dense_matrix<T, N, N> p;
+	safe_mm(T(1), a, 'n', ainv, 'n', T(0), ainv, p);
+	ASSERT_MAT_APPROX(N, N, p, eye, tol);
+
+	dense_matrix<T, N, N> a2(a);
+	dense_matrix<T, N, K> x2(b);
+	lapack::gesv(a2, x2);
+	safe_mm(T(1), a, 'n', x2, 'n', T(0), x2, r);
+	ASSERT_MAT_APPROX(N, K, r, b, tol);
+}
+
+T_CASE( small_lu )
+{
+	test_small_lu<T, 1>();
+	test_small_lu<T, 2>();
+	test_small_lu<T, 3>();
+	test_small_lu<T, 4>();
+	test_small_lu<T, 5>();
+	test_small_lu<T, 8>();
+}
+
+AUTO_TPACK( small_lu )
+{
+	ADD_T_CASE( small_lu, float )
+	ADD_T_CASE( small_lu, double )
+}
+
+
+T_CASE( small_lu_singular )
+{
+	dense_matrix<T, 3, 3> a;
+	zero(a);
+	a(0, 0) = T(1);
+	a(1, 1) = T(2);
+
+	bool caught = false;
+	try
+	{
+		lu_fac<T> lu(a);
+	}
+	catch (lapack::lapack_failure&)
+	{
+		caught = true;
+	}
+
+	ASSERT_TRUE( caught );
+}
+
+AUTO_TPACK( small_lu_singular )
+{
+	ADD_T_CASE( small_lu_singular, float )
+	ADD_T_CASE( small_lu_singular, double )
+}
+
+
+/************************************************
+ *
+ *  Cholesky
+ *
+ ************************************************/
+
+template<typename T, index_t N>
+void test_small_chol(char uplo)
+{
+	const int K = 3;
+
+	dense_matrix<T, N, N> a;
+	fill_rand_pdm(a);
+
+	dense_matrix<T, N, K> b;
+	do_fill_rand(b.ptr_data(), b.nelems(), T(-1), T(1));
+
+	T tol = small_tol<T>();
+
+	chol_fac<T> chol(a, uplo);
+	ASSERT_EQ( chol.dim(), N );
+
+	dense_matrix<T, N, N> f;
+	chol.get(f);
+
+	dense_matrix<T, N, N> p;
+	if (uplo == 'L')
+	{
+		safe_mm(T(1), f, 'n', f, 't', T(0), f, p);
+	}
+	else
+	{
+		safe_mm(T(1), f, 't', f, 'n', T(0), f, p);
+	}
+	ASSERT_MAT_APPROX(N, N, p, a, tol);
+
+	dense_matrix<T, N, K> x;
+	dense_matrix<T, N, K> r;
+
+	chol.solve(b, x);
+	safe_mm(T(1), a, 'n', x, 'n', T(0), x, r);
+	ASSERT_MAT_APPROX(N, K, r, b, tol);
+
+	dense_matrix<T, N, N> ainv;
+	chol_fac<T>::inv(a, ainv, uplo);
+
+	dense_matrix<T, N, N> eye;
+	fill_eye(eye);
+
+	safe_mm(T(1), a, 'n', ainv, 'n', T(0), ainv, p);
+	ASSERT_MAT_APPROX(N, N, p, eye, tol);
+
+	dense_matrix<T, N, N> a2(a);
+	dense_matrix<T, N, K> x2(b);
+	lapack::posv(a2, x2, uplo);
+	safe_mm(T(1), a, 'n', x2, 'n', T(0), x2, r);
+	ASSERT_MAT_APPROX(N, K, r, b, tol);
+}
+
+T_CASE( small_chol )
+{
+	const char uplos[2] = {'L', 'U'};
+
+	for (int u = 0; u < 2; ++u)
+	{
+		test_small_chol<T, 1>(uplos[u]);
+		test_small_chol<T, 2>(uplos[u]);
+		test_small_chol<T, 3>(uplos[u]);
+		test_small_chol<T, 4>(uplos[u]);
+		test_small_chol<T, 6>(uplos[u]);
+		test_small_chol<T, 8>(uplos[u]);
+	}
+}
+
+AUTO_TPACK( small_chol )
+{
+	ADD_T_CASE( small_chol, float )
+	ADD_T_CASE( small_chol, double )
+}
+
+
+T_CASE( small_chol_nonpd )
+{
+	dense_matrix<T, 3, 3> a;
+	fill_eye(a);
+	a(2, 2) = T(-1);
+
+	bool caught = false;
+	try
+	{
+		chol_fac<T> chol(a);
+	}
+	catch (lapack::lapack_failure&)
+	{
+		caught = true;
+	}
+
+	ASSERT_TRUE( caught );
+}
+
+AUTO_TPACK( small_chol_nonpd )
+{
+	ADD_T_CASE( small_chol_nonpd, float )
+	ADD_T_CASE( small_chol_nonpd, double )
+}
+
@@ -0,0 +1,265 @@
+/**
+ * @file test_aligned_eval.cpp
+ *
+ * @brief Unit testing of aligned storage and aligned/peeled evaluation
+ *
+ * @author Dahua Lin
+ */
+
+// use small thresholds, such that the parallel code path
+// is exercised with matrices of moderate sizes
+
+#define LMAT_PAR_MIN_ELEMS 64
+
+#include "../test_base.h"
+
+#include <light_mat/matrix/matrix_classes.h>
+#include <light_mat/matexpr/mat_arith.h>
+#include <light_mat/math/basic_functors.h>
+#include <light_mat/mateval/ewise_eval.h>
+#include <light_mat/common/block.h>
+
+using namespace lmat;
+using namespace lmat::test;
+
+const int NUM_TEST_THREADS = 4;
+
+const index_t DM = 13;
+const index_t DN = 10;
+
+typedef simd_<default_simd_kind> dsimd;
+
+
+// dynamic storage is aligned, while static storage and views are not known to be
+
+static_assert(meta::is_aligned<dense_matrix<double> >::value, "Alignment verification failed.");
+static_assert(meta::is_aligned<dense_matrix<float, 0, 1> >::value, "Alignment verification failed.");
+static_assert(meta::is_aligned<dense_matrix<double, 0, 4> >::value, "Alignment verification failed.");
+static_assert(!meta::is_aligned<dense_matrix<double, 3, 4> >::value, "Alignment verification failed.");
+static_assert(!meta::is_aligned<ref_matrix<double> >::value, "Alignment verification failed.");
+static_assert(!meta::is_aligned<cref_block<double> >::value, "Alignment verification failed.");
+
+static_assert(meta::alignment<dense_matrix<double> >::value == LMAT_DEFAULT_ALIGNMENT, "Alignment verification failed.");
+static_assert(meta::alignment<dense_matrix<float, 0, 1> >::value == LMAT_DEFAULT_ALIGNMENT, "Alignment verification failed.");
+static_assert(meta::alignment<dense_matrix<double, 3, 4> >::value == 0, "Alignment verification failed.");
+
+// aligned packs are used for aligned storage only
+
+static_assert(std::is_same<
+		internal::vec_reader_map<dense_matrix<double>, dsimd>::type,
+		contvec_reader<double, dsimd, true> >::value, "Accessor verification failed.");
+
+static_assert(std::is_same<
+		internal::vec_writer_map<dense_matrix<float>, dsimd>::type,
+		contvec_writer<float, dsimd, true> >::value, "Accessor verification failed.");
+
+static_assert(std::is_same<
+		internal::vec_reader_map<cref_matrix<double>, dsimd>::type,
+		contvec_reader<double, dsimd, false> >::value, "Accessor verification failed.");
+
+static_assert(std::is_same<
+		internal::vec_writer_map<dense_matrix<double, 3, 4>, dsimd>::type,
+		contvec_writer<double, dsimd, false> >::value, "Accessor verification failed.");
+
+static_assert(supports_pack_peel<contvec_updater<double, dsimd> >::value, "Accessor verification failed.");
+static_assert(!supports_pack_peel<contvec_updater<double, dsimd, true> >::value, "Accessor verification failed.");
+static_assert(!supports_pack_peel<contvec_reader<double, scalar_> >::value, "Accessor verification failed.");
+
+
+template<typename T>
+inline bool is_aligned_addr(const T *p)
+{
+	return reinterpret_cast<size_t>(p) % LMAT_DEFAULT_ALIGNMENT == 0;
+}
+
+template<typename T>
+inline void fill_lin(dblock<T>& s)
+{
+	for (index_t i = 0; i < s.nelems(); ++i) s[i] = T(i + 1);
+}
+
+
+SIMPLE_CASE( aligned_allocation )
+{
+	dense_matrix<double> a(DM, DN);
+	dense_matrix<float> b(DM, DN);
+	dense_col<float> c(DM);
+	dblock<int> d(DN);
+
+	ASSERT_TRUE( is_aligned_addr(a.ptr_data()) );
+	ASSERT_TRUE( is_aligned_addr(b.ptr_data()) );
+	ASSERT_TRUE( is_aligned_addr(c.ptr_data()) );
+	ASSERT_TRUE( is_aligned_addr(d.ptr_data()) );
+
+	a.require_size(DM + 1, DN);
+	ASSERT_TRUE( is_aligned_addr(a.ptr_data()) );
+
+	dense_matrix<double> a2(a);
+	ASSERT_TRUE( is_aligned_addr(a2.ptr_data()) );
+}
+
+
+T_CASE( aligned_ewise )
+{
+	set_par_max_threads(NUM_TEST_THREADS);
+
+	const index_t m = DM;
+	const index_t n = DN;
+
+	dense_matrix<T> a(m, n), b(m, n), r(m, n);
+	for (index_t i = 0; i < m * n; ++i)
+	{
+		a[i] = T(i + 1);
+		b[i] = T(2 * i + 3);
+		r[i] = a[i] * T(2) + b[i];
+	}
+
+	dense_matrix<T> c = a * T(2) + b;
+	ASSERT_MAT_EQ( m, n, c, r );
+
+	dense_matrix<T> c2(m, n);
+	macc_evaluate(a * T(2) + b, c2, par_());
+	ASSERT_MAT_EQ( m, n, c2, r );
+
+	accum_kernel<T> upd_kernel;
+	for (index_t i = 0; i < m * n; ++i) r[i] += a[i];
+
+	ewise(upd_kernel).eval(macc_<linear_, dsimd>(), c.shape(), in_out_(c), in_(a));
+	ASSERT_MAT_EQ( m, n, c, r );
+
+	ewise(upd_kernel).eval(macc_<linear_, dsimd, par_>(), c2.shape(), in_out_(c2), in_(a));
+	ASSERT_MAT_EQ( m, n, c2, r );
+}
+
+
+T_CASE( peeled_ewise )
+{
+	set_par_max_threads(NUM_TEST_THREADS);
+
+	const index_t W = (index_t)simd_traits<T, default_simd_kind>::pack_width;
+	const index_t lens[4] = { W - 1, 2 * W + 3, 37, DM * DN };
+
+	copy_kernel<T> cpy_kernel;
+	accum_kernel<T> upd_kernel;
+
+	for (index_t k = 0; k < 4; ++k)
+	{
+		const index_t len = lens[k];
+
+		// the offsets of source and destination differ, such
+		// that the peeling is driven by the destination
+
+		for (index_t off = 0; off <= W; ++off)
+		{
+			const index_t soff = (off + 1) % W;
+
+			dblock<T> sa(len + 2 * W);
+			dblock<T> sb(len + 2 * W);
+			fill_lin(sa);
+			fill_lin(sb);
+
+			cref_matrix<T> a(sa.ptr_data() + soff, len, 1);
+			cref_matrix<T> b(sb.ptr_data() + off, len, 1);
+
+			dense_matrix<T> r(len, 1);
+			for (index_t i = 0; i < len; ++i) r[i] = a[i] * T(2) + b[i];
+
+			// sequential
+
+			dblock<T> sd(len + 2 * W, zero());
+			ref_matrix<T> d(sd.ptr_data() + off, len, 1);
+
+			d = a * T(2) + b;
+			ASSERT_VEC_EQ( len, d, r );
+
+			for (index_t i = 0; i < off; ++i) ASSERT_EQ( sd[i], T(0) );
+			for (index_t i = off + len; i < sd.nelems(); ++i) ASSERT_EQ( sd[i], T(0) );
+
+			// parallel
+
+			dblock<T> sd2(len + 2 * W, zero());
+			ref_matrix<T> d2(sd2.ptr_data() + off, len, 1);
+
+			macc_evaluate(a * T(2) + b, d2, par_());
+			ASSERT_VEC_EQ( len, d2, r );
+
+			for (index_t i = 0; i < off; ++i) ASSERT_EQ( sd2[i], T(0) );
+			for (index_t i = off + len; i < sd2.nelems(); ++i) ASSERT_EQ( sd2[i], T(0) );
+
+			// update
+
+			for (index_t i = 0; i < len; ++i) r[i] += a[i];
+
+			ewise(upd_kernel).eval(macc_<linear_, dsimd>(), d.shape(), in_out_(d), in_(a));
+			ASSERT_VEC_EQ( len, d, r );
+
+			ewise(upd_kernel).eval(macc_<linear_, dsimd, par_>(), d2.shape(), in_out_(d2), in_(a));
+			ASSERT_VEC_EQ( len, d2, r );
+
+			ASSERT_EQ( sd[off + len], T(0) );
+			ASSERT_EQ( sd2[off + len], T(0) );
+
+			// copy into an aligned destination from a misaligned source
+
+			dense_matrix<T> c(len, 1);
+			ewise(cpy_kernel).eval(macc_<linear_, dsimd>(), c.shape(), in_(a), out_(c));
+			ASSERT_VEC_EQ( len, c, a );
+		}
+	}
+}
+
+
+T_CASE( peeled_percol )
+{
+	const index_t m = DM;
+	const index_t n = DN;
+	const index_t ldim = m + 3;
+
+	dblock<T> sa(ldim * n);
+	fill_lin(sa);
+	cref_block<T> a(sa.ptr_data() + 1, m, n, ldim);
+
+	dense_matrix<T> r(m, n);
+	for (index_t j = 0; j < n; ++j)
+	{
+		for (index_t i = 0; i < m; ++i) r(i, j) = a(i, j) * T(3);
+	}
+
+	// each column of the destination starts at a different alignment
+
+	dblock<T> sd(ldim * n, zero());
+	ref_block<T> d(sd.ptr_data() + 2, m, n, ldim);
+
+	d = a * T(3);
+	ASSERT_MAT_EQ( m, n, d, r );
+
+	for (index_t j = 0; j < n; ++j)
+	{
+		ASSERT_EQ( sd[j * ldim + 1], T(0) );
+		ASSERT_EQ( sd[j * ldim + m + 2], T(0) );
+	}
+}
+
+
+AUTO_TPACK( aligned_allocation )
+{
+	ADD_SIMPLE_CASE( aligned_allocation )
+}
+
+AUTO_TPACK( aligned_ewise )
+{
+	ADD_T_CASE( aligned_ewise, float )
+	ADD_T_CASE( aligned_ewise, double )
+}
+
+AUTO_TPACK( peeled_ewise )
+{
+	ADD_T_CASE( peeled_ewise, float )
+	ADD_T_CASE( peeled_ewise, double )
+}
+
+AUTO_TPACK( peeled_percol )
+{
+	ADD_T_CASE( peeled_percol, float )
+	ADD_T_CASE( peeled_percol, double )
+}
@@ -96,6 +96,45 @@ DEFINE_COLWISE_REDUCE_CASE_2( diff_sqsum )
 DEFINE_COLWISE_REDUCE_CASE_2( dot )
 
 
+// the fused reductions fold each column with the same kernel
+// as the full reduction, hence give the same values exactly
+
+SIMPLE_CASE( tcolwise_fma_kernels )
+{
+	const index_t n = 6;
+	dense_matrix<double> src1(max_nrows, n);
+	dense_matrix<double> src2(max_nrows, n);
+	fill_rand(src1);
+	fill_rand(src2);
+
+	dense_row<double> r_sqsum(n), r_dot(n), r_diff(n);
+	dense_row<double> d(n);
+
+	for (unsigned k = 0; k < ntest_nrows; ++k)
+	{
+		index_t cl = test_nrows[k];
+		ref_block<double> s1 = src1(range(0, cl), whole());
+		ref_block<double> s2 = src2(range(0, cl), whole());
+
+		for (index_t j = 0; j < n; ++j)
+		{
+			r_sqsum[j] = sqsum(s1.column(j));
+			r_dot[j] = dot(s1.column(j), s2.column(j));
+			r_diff[j] = diff_sqsum(s1.column(j), s2.column(j));
+		}
+
+		colwise_sqsum(s1, d);
+		ASSERT_VEC_EQ( n, d, r_sqsum );
+
+		colwise_dot(s1, s2, d);
+		ASSERT_VEC_EQ( n, d, r_dot );
+
+		colwise_diff_sqsum(s1, s2, d);
+		ASSERT_VEC_EQ( n, d, r_diff );
+	}
+}
+
+
 AUTO_TPACK( colwise_reduce )
 {
 	ADD_SIMPLE_CASE( tcolwise_sum )
@@ -114,6 +153,7 @@ AUTO_TPACK( colwise_reduce )
 	ADD_SIMPLE_CASE( tcolwise_diff_sqsum )
 
 	ADD_SIMPLE_CASE( tcolwise_dot )
+	ADD_SIMPLE_CASE( tcolwise_fma_kernels )
 }
 
 
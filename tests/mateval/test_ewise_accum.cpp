@@ -72,7 +72,7 @@ namespace lmat {
 
 
 
-template<typename U, int M, int N>
+template<typename U, index_t M, index_t N>
 void test_linear_accum()
 {
 	const index_t m = M == 0 ? DM : M;
@@ -118,7 +118,7 @@ void test_linear_accum()
 }
 
 
-template<typename U, int M, int N>
+template<typename U, index_t M, index_t N>
 void test_percol_accum()
 {
 	const index_t m = M == 0 ? DM : M;
@@ -167,7 +167,7 @@ void test_percol_accum()
 }
 
 
-template<typename U, typename DTag, int M, int N>
+template<typename U, typename DTag, index_t M, index_t N>
 void test_accum_colwise()
 {
 	const index_t m = M == 0 ? DM : M;
@@ -255,7 +255,7 @@ void test_accum_colwise()
 }
 
 
-template<typename U, typename DTag, int M, int N>
+template<typename U, typename DTag, index_t M, index_t N>
 void test_accum_rowwise()
 {
 	const index_t m = M == 0 ? DM : M;
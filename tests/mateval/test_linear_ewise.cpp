@@ -25,7 +25,7 @@ using namespace lmat::test;
 // core functions
 
 
-template<typename U, int M, int N>
+template<typename U, index_t M, index_t N>
 void test_linear_ewise_cont_cont()
 {
 	const index_t m = M == 0 ? DM : M;
@@ -57,7 +57,7 @@ void test_linear_ewise_cont_cont()
 	ASSERT_MAT_EQ(m, n, dmat, rmat);
 }
 
-template<typename U, typename STag, typename DTag, int M>
+template<typename U, typename STag, typename DTag, index_t M>
 void test_linear_ewise_col()
 {
 	const index_t m = M == 0 ? DM : M;
@@ -88,7 +88,7 @@ void test_linear_ewise_col()
 	ASSERT_MAT_EQ(m, 1, dmat, rmat);
 }
 
-template<typename U, typename STag, typename DTag, int N>
+template<typename U, typename STag, typename DTag, index_t N>
 void test_linear_ewise_row()
 {
 	const index_t n = N == 0 ? DN : N;
@@ -119,7 +119,7 @@ void test_linear_ewise_row()
 }
 
 
-template<typename U, int M, int N>
+template<typename U, index_t M, index_t N>
 void test_linear_ewise_single_cont()
 {
 	const index_t m = M == 0 ? DM : M;
@@ -171,7 +171,9 @@ void test_linear_ewise_varysize()
 			r[i] = math::sqr(s[i]);
 
 		ewise(kernel).eval(macc_<linear_, U>(), len, 1, out_(d), in_(s));
-		ASSERT_VEC_EQ( len, d, r );
+
+		// entries beyond len must be left untouched
+		ASSERT_VEC_EQ( max_len, d, r );
 	}
 }
 
@@ -228,6 +230,15 @@ MN_CASE( linear_ewise_avx_cont_cont  )
 
 #endif
 
+#ifdef LMAT_HAS_AVX512
+
+MN_CASE( linear_ewise_avx512_cont_cont  )
+{
+	test_linear_ewise_cont_cont<simd_<avx512_t>, M, N>();
+}
+
+#endif
+
 
 MN_CASE( linear_ewise_scalar_single_cont )
 {
@@ -248,6 +259,15 @@ MN_CASE( linear_ewise_avx_single_cont )
 
 #endif
 
+#ifdef LMAT_HAS_AVX512
+
+MN_CASE( linear_ewise_avx512_single_cont )
+{
+	test_linear_ewise_single_cont<simd_<avx512_t>, M, N>();
+}
+
+#endif
+
 
 SIMPLE_CASE( linear_ewise_varysize_scalar )
 {
@@ -266,6 +286,13 @@ SIMPLE_CASE( linear_ewise_varysize_avx )
 }
 #endif
 
+#ifdef LMAT_HAS_AVX512
+SIMPLE_CASE( linear_ewise_varysize_avx512 )
+{
+	test_linear_ewise_varysize<simd_<avx512_t> >();
+}
+#endif
+
 
 // Test packs
 
@@ -320,6 +347,15 @@ AUTO_TPACK( linear_ewise_avx_cont_cont )
 
 #endif
 
+#ifdef LMAT_HAS_AVX512
+
+AUTO_TPACK( linear_ewise_avx512_cont_cont )
+{
+	ADD_MN_CASE_3X3( linear_ewise_avx512_cont_cont, DM, DN )
+}
+
+#endif
+
 AUTO_TPACK( linear_ewise_scalar_single_cont )
 {
 	ADD_MN_CASE_3X3( linear_ewise_scalar_single_cont, DM, DN )
@@ -339,6 +375,15 @@ AUTO_TPACK( linear_ewise_avx_single_cont )
 
 #endif
 
+#ifdef LMAT_HAS_AVX512
+
+AUTO_TPACK( linear_ewise_avx512_single_cont )
+{
+	ADD_MN_CASE_3X3( linear_ewise_avx512_single_cont, DM, DN )
+}
+
+#endif
+
 
 
 AUTO_TPACK( linear_ewise_varysize )
@@ -348,6 +393,9 @@ AUTO_TPACK( linear_ewise_varysize )
 #ifdef LMAT_HAS_AVX
 	ADD_SIMPLE_CASE( linear_ewise_varysize_avx )
 #endif
+#ifdef LMAT_HAS_AVX512
+	ADD_SIMPLE_CASE( linear_ewise_varysize_avx512 )
+#endif
 }
 
 
@@ -22,7 +22,7 @@ using namespace lmat;
 using namespace lmat::test;
 
 
-template<int M, int N>
+template<index_t M, index_t N>
 void test_ewise_map()
 {
 	const index_t m = M == 0 ? DM : M;
@@ -25,9 +25,9 @@ const index_t LDim = 12;
 
 // Auxiliary classes
 
-template<template<typename T1, int R1, int C1> class SClassT, int M, int N> struct mat_maker;
+template<template<typename T1, index_t R1, index_t C1> class SClassT, index_t M, index_t N> struct mat_maker;
 
-template<int M, int N>
+template<index_t M, index_t N>
 struct mat_maker<ref_matrix, M, N>
 {
 	static ref_matrix<double, M, N> get_a(double *p, index_t m, index_t n)
@@ -41,7 +41,7 @@ struct mat_maker<ref_matrix, M, N>
 	}
 };
 
-template<int M, int N>
+template<index_t M, index_t N>
 struct mat_maker<ref_block, M, N>
 {
 	static ref_block<double, M, N> get_a(double *p, index_t m, index_t n)
@@ -55,7 +55,7 @@ struct mat_maker<ref_block, M, N>
 	}
 };
 
-template<int M, int N>
+template<index_t M, index_t N>
 struct mat_maker<ref_grid, M, N>
 {
 	static ref_grid<double, M, N> get_a(double *p, index_t m, index_t n)
@@ -72,8 +72,8 @@ struct mat_maker<ref_grid, M, N>
 
 
 template<
-	template<typename T1, int R1, int C1> class AClassT,
-	template<typename T2, int R2, int C2> class BClassT,
+	template<typename T1, index_t R1, index_t C1> class AClassT,
+	template<typename T2, index_t R2, index_t C2> class BClassT,
 	int M, int N>
 void test_matrix_equal()
 {
@@ -103,8 +103,8 @@ void test_matrix_equal()
 
 
 template<
-	template<typename T1, int R1, int C1> class AClassT,
-	template<typename T2, int R2, int C2> class BClassT,
+	template<typename T1, index_t R1, index_t C1> class AClassT,
+	template<typename T2, index_t R2, index_t C2> class BClassT,
 	int M, int N>
 void test_matrix_approx()
 {
@@ -20,7 +20,7 @@ const index_t DM = 9;
 const index_t DN = 8;
 const index_t LDim = 12;
 
-template<int M, int N>
+template<index_t M, index_t N>
 void fill_ran(dense_matrix<double, M, N>& a)
 {
 	for (index_t i = 0; i < a.nelems(); ++i)
@@ -90,6 +90,29 @@ struct min_tt
 	}
 };
 
+struct sqsum_tt
+{
+	typedef sqsum_kernel<double> kernel_type;
+
+	static double tol()
+	{
+		return 1.0e-12;
+	}
+
+	template<class A>
+	static double eval(const IRegularMatrix<A, double>& a)
+	{
+		double r(0);
+		for (index_t j = 0; j < a.ncolumns(); ++j)
+		{
+			for (index_t i = 0; i < a.nrows(); ++i)
+				r += a(i, j) * a(i, j);
+		}
+
+		return r;
+	}
+};
+
 
 template<index_t CM, index_t CN>
 inline bool my_use_linear(cont, matrix_shape<CM, CN>)
@@ -192,6 +215,46 @@ void test_folder()
 }
 
 
+template<typename Acc, typename U, class MTag, index_t CM, index_t CN>
+void test_dot_folder_x()
+{
+	typedef typename mat_host<MTag, double, CM, CN>::cmat_t smat_t;
+
+	const index_t m = CM == 0 ? DM : CM;
+	const index_t n = CN == 0 ? DN : CN;
+
+	mat_host<MTag, double, CM, CN> s1(m, n);
+	mat_host<MTag, double, CM, CN> s2(m, n);
+	s1.fill_rand();
+	s2.fill_rand();
+	smat_t smat1 = s1.get_cmat();
+	smat_t smat2 = s2.get_cmat();
+
+	double r0(0);
+	double rd(0);
+	for (index_t j = 0; j < n; ++j)
+	{
+		for (index_t i = 0; i < m; ++i)
+		{
+			r0 += smat1(i, j) * smat2(i, j);
+			rd += math::sqr(smat1(i, j) - smat2(i, j));
+		}
+	}
+
+	const double tol = 1.0e-12;
+
+	matrix_shape<CM, CN> shape(m, n);
+
+	double r1 = fold(dot_kernel<double>()).eval(macc_<Acc, U>(), shape, in_(smat1), in_(smat2));
+	ASSERT_APPROX(r1, r0, tol);
+
+	double r2 = fold(dot_kernel<double>())(shape, in_(smat1), in_(smat2));
+	ASSERT_APPROX(r2, r0, tol);
+
+	double r3 = fold(diff_sqsum_kernel<double>()).eval(macc_<Acc, U>(), shape, in_(smat1), in_(smat2));
+	ASSERT_APPROX(r3, rd, tol);
+}
+
 
 
 // specific cases
@@ -547,6 +610,94 @@ MN_CASE( min_auto_grid )
 }
 
 
+// dot (two inputs per step)
+
+MN_CASE( dot_linear_scalar_cont )
+{
+	test_dot_folder_x<linear_, scalar_, cont, M, N>();
+}
+
+MN_CASE( dot_linear_sse_cont )
+{
+	test_dot_folder_x<linear_, simd_<sse_t>, cont, M, N>();
+}
+
+MN_CASE( dot_percol_sse_bloc )
+{
+	test_dot_folder_x<percol_, simd_<sse_t>, bloc, M, N>();
+}
+
+#ifdef LMAT_HAS_AVX
+
+MN_CASE( dot_linear_avx_cont )
+{
+	test_dot_folder_x<linear_, simd_<avx_t>, cont, M, N>();
+}
+
+MN_CASE( dot_percol_avx_bloc )
+{
+	test_dot_folder_x<percol_, simd_<avx_t>, bloc, M, N>();
+}
+
+#endif
+
+MN_CASE( dot_percol_scalar_grid )
+{
+	test_dot_folder_x<percol_, scalar_, grid, M, N>();
+}
+
+
+// sqsum (one input per step, partial results are added)
+
+MN_CASE( sqsum_linear_scalar_cont )
+{
+	test_folder_x<sqsum_tt, linear_, scalar_, cont, M, N>();
+}
+
+MN_CASE( sqsum_linear_sse_cont )
+{
+	test_folder_x<sqsum_tt, linear_, simd_<sse_t>, cont, M, N>();
+}
+
+MN_CASE( sqsum_percol_sse_bloc )
+{
+	test_folder_x<sqsum_tt, percol_, simd_<sse_t>, bloc, M, N>();
+}
+
+#ifdef LMAT_HAS_AVX
+
+MN_CASE( sqsum_linear_avx_cont )
+{
+	test_folder_x<sqsum_tt, linear_, simd_<avx_t>, cont, M, N>();
+}
+
+MN_CASE( sqsum_percol_avx_bloc )
+{
+	test_folder_x<sqsum_tt, percol_, simd_<avx_t>, bloc, M, N>();
+}
+
+#endif
+
+MN_CASE( sqsum_percol_scalar_grid )
+{
+	test_folder_x<sqsum_tt, percol_, scalar_, grid, M, N>();
+}
+
+MN_CASE( sqsum_auto_cont )
+{
+	test_folder<sqsum_tt, cont, M, N>();
+}
+
+MN_CASE( sqsum_auto_bloc )
+{
+	test_folder<sqsum_tt, bloc, M, N>();
+}
+
+MN_CASE( sqsum_auto_grid )
+{
+	test_folder<sqsum_tt, grid, M, N>();
+}
+
 
 // Packs
 
@@ -730,3 +881,50 @@ AUTO_TPACK( min_auto )
 }
 
 
+// dot
+
+AUTO_TPACK( dot_linear )
+{
+	ADD_MN_CASE_3X3( dot_linear_scalar_cont, DM, DN )
+	ADD_MN_CASE_3X3( dot_linear_sse_cont, DM, DN )
+#ifdef LMAT_HAS_AVX
+	ADD_MN_CASE_3X3( dot_linear_avx_cont, DM, DN )
+#endif
+}
+
+AUTO_TPACK( dot_percol )
+{
+	ADD_MN_CASE_3X3( dot_percol_scalar_grid, DM, DN )
+	ADD_MN_CASE_3X3( dot_percol_sse_bloc, DM, DN )
+#ifdef LMAT_HAS_AVX
+	ADD_MN_CASE_3X3( dot_percol_avx_bloc, DM, DN )
+#endif
+}
+
+
+// sqsum
+
+AUTO_TPACK( sqsum_linear )
+{
+	ADD_MN_CASE_3X3( sqsum_linear_scalar_cont, DM, DN )
+	ADD_MN_CASE_3X3( sqsum_linear_sse_cont, DM, DN )
+#ifdef LMAT_HAS_AVX
+	ADD_MN_CASE_3X3( sqsum_linear_avx_cont, DM, DN )
+#endif
+}
+
+AUTO_TPACK( sqsum_percol )
+{
+	ADD_MN_CASE_3X3( sqsum_percol_scalar_grid, DM, DN )
+	ADD_MN_CASE_3X3( sqsum_percol_sse_bloc, DM, DN )
+#ifdef LMAT_HAS_AVX
+	ADD_MN_CASE_3X3( sqsum_percol_avx_bloc, DM, DN )
+#endif
+}
+
+AUTO_TPACK( sqsum_auto )
+{
+	ADD_MN_CASE_3X3( sqsum_auto_cont, DM, DN )
+	ADD_MN_CASE_3X3( sqsum_auto_bloc, DM, DN )
+	ADD_MN_CASE_3X3( sqsum_auto_grid, DM, DN )
+}
@@ -20,7 +20,7 @@ const index_t DM = 15;
 const index_t DM2 = 12;
 const index_t DN = 16;
 
-template<int M, int N>
+template<index_t M, index_t N>
 void fill_ran(dense_matrix<double, M, N>& a)
 {
 	for (index_t i = 0; i < a.nelems(); ++i)
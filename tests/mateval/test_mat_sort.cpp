@@ -18,7 +18,7 @@ using namespace lmat::test;
 const index_t DM = 15;
 const index_t DN = 8;
 
-template<int M, int N>
+template<index_t M, index_t N>
 void fill_ran(dense_matrix<double, M, N>& a)
 {
 	for (index_t i = 0; i < a.nelems(); ++i)
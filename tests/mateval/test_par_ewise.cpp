@@ -0,0 +1,210 @@
+/**
+ * @file test_par_ewise.cpp
+ *
+ * @brief Unit testing of parallel ewise evaluation
+ *
+ * @author Dahua Lin
+ */
+
+// use small thresholds, such that the parallel code path
+// is exercised with matrices of moderate sizes
+
+#define LMAT_PAR_MIN_ELEMS 64
+#define LMAT_PAR_CHUNK_BYTES 64
+
+#include "../test_base.h"
+
+#define DEFAULT_M_VALUE 29
+#define DEFAULT_N_VALUE 11
+
+#include "../multimat_supp.h"
+
+#include <light_mat/matrix/matrix_classes.h>
+#include <light_mat/math/basic_functors.h>
+#include <light_mat/mateval/ewise_eval.h>
+#include <light_mat/matexpr/mat_arith.h>
+
+#include <light_mat/simd/simd.h>
+
+
+using namespace lmat;
+using namespace lmat::test;
+
+const int NUM_TEST_THREADS = 4;
+
+
+// test cases
+
+template<typename STag, typename DTag, typename Acc, typename U, index_t M, index_t N>
+void test_par_ewise()
+{
+	set_par_max_threads(NUM_TEST_THREADS);
+
+	const index_t m = M == 0 ? DM : M;
+	const index_t n = N == 0 ? DN : N;
+
+	typedef typename mat_host<STag, double, M, N>::cmat_t smat_t;
+	typedef typename mat_host<DTag, double, M, N>::mat_t dmat_t;
+
+	mat_host<STag, double, M, N> src(m, n);
+	src.fill_lin();
+	mat_host<DTag, double, M, N> dst(m, n);
+
+	smat_t smat = src.get_cmat();
+	dmat_t dmat = dst.get_mat();
+
+	matrix_shape<M, N> shape(m, n);
+
+	copy_kernel<double> cpy_kernel;
+	accum_kernel<double> upd_kernel;
+
+	ewise(cpy_kernel).eval(macc_<Acc, U, par_>(), shape, in_(smat), out_(dmat));
+
+	ASSERT_MAT_EQ(m, n, smat, dmat);
+
+	dense_matrix<double, M, N> rmat(m, n);
+	for (index_t j = 0; j < n; ++j)
+	{
+		for (index_t i = 0; i < m; ++i) rmat(i, j) = smat(i, j) + dmat(i, j);
+	}
+
+	ewise(upd_kernel).eval(macc_<Acc, U, par_>(), shape, in_out_(dmat), in_(smat));
+
+	ASSERT_MAT_EQ(m, n, dmat, rmat);
+}
+
+
+template<typename DTag, typename U, index_t M, index_t N>
+void test_par_ewise_repcol()
+{
+	set_par_max_threads(NUM_TEST_THREADS);
+
+	const index_t m = M == 0 ? DM : M;
+	const index_t n = N == 0 ? DN : N;
+
+	typedef typename mat_host<cont, double, M, 1>::cmat_t col_t;
+	typedef typename mat_host<DTag, double, M, N>::mat_t dmat_t;
+
+	mat_host<cont, double, M, 1> src(m, 1);
+	src.fill_lin();
+	mat_host<DTag, double, M, N> dst(m, n);
+
+	col_t col = src.get_cmat();
+	dmat_t dmat = dst.get_mat();
+
+	dense_matrix<double, M, N> rmat(m, n);
+	for (index_t j = 0; j < n; ++j)
+	{
+		for (index_t i = 0; i < m; ++i) rmat(i, j) = col[i];
+	}
+
+	matrix_shape<M, N> shape(m, n);
+
+	ewise(copy_kernel<double>()).eval(macc_<percol_, U, par_>(), shape, repcol_(col), out_(dmat));
+
+	ASSERT_MAT_EQ(m, n, dmat, rmat);
+}
+
+
+template<typename STag, typename DTag, index_t M, index_t N>
+void test_par_macc_evaluate()
+{
+	set_par_max_threads(NUM_TEST_THREADS);
+
+	const index_t m = M == 0 ? DM : M;
+	const index_t n = N == 0 ? DN : N;
+
+	typedef typename mat_host<STag, double, M, N>::cmat_t smat_t;
+	typedef typename mat_host<DTag, double, M, N>::mat_t dmat_t;
+
+	mat_host<STag, double, M, N> src1(m, n);
+	mat_host<STag, double, M, N> src2(m, n);
+	src1.fill_lin();
+	src2.fill_rand();
+	mat_host<DTag, double, M, N> dst(m, n);
+
+	smat_t a = src1.get_cmat();
+	smat_t b = src2.get_cmat();
+	dmat_t dmat = dst.get_mat();
+
+	dense_matrix<double, M, N> rmat(m, n);
+	for (index_t j = 0; j < n; ++j)
+	{
+		for (index_t i = 0; i < m; ++i) rmat(i, j) = a(i, j) * 2.0 + b(i, j);
+	}
+
+	macc_evaluate(a * 2.0 + b, dmat, par_());
+
+	ASSERT_MAT_EQ(m, n, dmat, rmat);
+}
+
+
+// TEST SUITES
+
+#define DEFINE_PAR_EWISE_TEST( AccName, UName, U, STag, DTag ) \
+		MN_CASE( par_ewise_##AccName##_##UName##_##STag##_##DTag  ) { \
+			test_par_ewise<STag, DTag, AccName##_, U, M, N>(); } \
+		AUTO_TPACK( par_ewise_##AccName##_##UName##_##STag##_##DTag ) {\
+			ADD_MN_CASE_3X3( par_ewise_##AccName##_##UName##_##STag##_##DTag, DM, DN ) \
+		}
+
+DEFINE_PAR_EWISE_TEST( linear, scalar, scalar_, cont, cont )
+DEFINE_PAR_EWISE_TEST( linear, sse, simd_<sse_t>, cont, cont )
+
+#ifdef LMAT_HAS_AVX
+DEFINE_PAR_EWISE_TEST( linear, avx, simd_<avx_t>, cont, cont )
+#endif
+
+DEFINE_PAR_EWISE_TEST( percol, scalar, scalar_, cont, cont )
+DEFINE_PAR_EWISE_TEST( percol, scalar, scalar_, bloc, grid )
+DEFINE_PAR_EWISE_TEST( percol, scalar, scalar_, grid, bloc )
+DEFINE_PAR_EWISE_TEST( percol, sse, simd_<sse_t>, cont, bloc )
+DEFINE_PAR_EWISE_TEST( percol, sse, simd_<sse_t>, bloc, bloc )
+
+#ifdef LMAT_HAS_AVX
+DEFINE_PAR_EWISE_TEST( percol, avx, simd_<avx_t>, cont, bloc )
+DEFINE_PAR_EWISE_TEST( percol, avx, simd_<avx_t>, bloc, bloc )
+#endif
+
+
+MN_CASE( par_ewise_scalar_repcol_bloc )
+{
+	test_par_ewise_repcol<bloc, scalar_, M, N>();
+}
+
+MN_CASE( par_ewise_sse_repcol_bloc )
+{
+	test_par_ewise_repcol<bloc, simd_<sse_t>, M, N>();
+}
+
+AUTO_TPACK( par_ewise_scalar_repcol_bloc )
+{
+	ADD_MN_CASE_3X3( par_ewise_scalar_repcol_bloc, DM, DN )
+}
+
+AUTO_TPACK( par_ewise_sse_repcol_bloc )
+{
+	ADD_MN_CASE_3X3( par_ewise_sse_repcol_bloc, DM, DN )
+}
+
+
+MN_CASE( par_macc_evaluate_cont_cont )
+{
+	test_par_macc_evaluate<cont, cont, M, N>();
+}
+
+MN_CASE( par_macc_evaluate_bloc_grid )
+{
+	test_par_macc_evaluate<bloc, grid, M, N>();
+}
+
+AUTO_TPACK( par_macc_evaluate_cont_cont )
+{
+	ADD_MN_CASE_3X3( par_macc_evaluate_cont_cont, DM, DN )
+}
+
+AUTO_TPACK( par_macc_evaluate_bloc_grid )
+{
+	ADD_MN_CASE_3X3( par_macc_evaluate_bloc_grid, DM, DN )
+}
+
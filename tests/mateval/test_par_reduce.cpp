@@ -0,0 +1,231 @@
+/**
+ * @file test_par_reduce.cpp
+ *
+ * @brief Unit testing of parallel reduction
+ *
+ * @author Dahua Lin
+ */
+
+// use small thresholds, such that the parallel code path
+// is exercised with matrices of moderate sizes
+
+#define LMAT_PAR_MIN_ELEMS 64
+
+#include "../test_base.h"
+#include <light_mat/matrix/matrix_classes.h>
+#include <light_mat/mateval/mat_reduce.h>
+#include <light_mat/mateval/mat_enorms.h>
+#include <cstdlib>
+
+using namespace lmat;
+using namespace lmat::test;
+
+const int NUM_TEST_THREADS = 4;
+
+inline double randunif()
+{
+	double u = (double)std::rand() / double(RAND_MAX);
+	return u * 2.0 - 1.0;
+}
+
+template<class Mat, typename T>
+void fill_rand(IRegularMatrix<Mat, T>& mat)
+{
+	for (index_t j = 0; j < mat.ncolumns(); ++j)
+	{
+		for (index_t i = 0; i < mat.nrows(); ++i)
+		{
+			mat(i, j) = randunif();
+		}
+	}
+}
+
+index_t test_lens[] = { 1, 7, 63, 64, 65, 100, 257, 1000, 1023 };
+const unsigned int ntest_lens = sizeof(test_lens) / sizeof(index_t);
+
+index_t test_ncols[] = { 1, 2, 3, 5, 8, 13 };
+const unsigned int ntest_ncols = sizeof(test_ncols) / sizeof(index_t);
+
+const index_t max_len = 1023;
+const index_t test_nrows = 37;
+const index_t max_ncols = 13;
+
+
+#define DEF_PAR_FULL_REDUC_CASE( Name, tol ) \
+	SIMPLE_CASE( par_full_##Name ) { \
+		set_par_max_threads(NUM_TEST_THREADS); \
+		dense_col<double> s(max_len); \
+		fill_rand(s); \
+		for (unsigned int t = 0; t < ntest_lens; ++t) { \
+			index_t k = test_lens[t]; \
+			auto sk = s(range(0, k)); \
+			double r0 = Name(sk); \
+			double r = Name(sk, par_()); \
+			ASSERT_APPROX(r, r0, tol); \
+			ASSERT_EQ(Name(sk, par_()), r); } }
+
+#define DEF_PAR_FULL_REDUC_CASE_2( Name, tol ) \
+	SIMPLE_CASE( par_full_##Name ) { \
+		set_par_max_threads(NUM_TEST_THREADS); \
+		dense_col<double> s1(max_len); \
+		dense_col<double> s2(max_len); \
+		fill_rand(s1); \
+		fill_rand(s2); \
+		for (unsigned int t = 0; t < ntest_lens; ++t) { \
+			index_t k = test_lens[t]; \
+			auto sk1 = s1(range(0, k)); \
+			auto sk2 = s2(range(0, k)); \
+			double r0 = Name(sk1, sk2); \
+			double r = Name(sk1, sk2, par_()); \
+			ASSERT_APPROX(r, r0, tol); \
+			ASSERT_EQ(Name(sk1, sk2, par_()), r); } }
+
+DEF_PAR_FULL_REDUC_CASE( sum, 1.0e-12 )
+DEF_PAR_FULL_REDUC_CASE( maximum, 0.0 )
+DEF_PAR_FULL_REDUC_CASE( minimum, 0.0 )
+DEF_PAR_FULL_REDUC_CASE( mean, 1.0e-12 )
+DEF_PAR_FULL_REDUC_CASE( asum, 1.0e-12 )
+DEF_PAR_FULL_REDUC_CASE( amax, 0.0 )
+DEF_PAR_FULL_REDUC_CASE( sqsum, 1.0e-12 )
+
+DEF_PAR_FULL_REDUC_CASE_2( dot, 1.0e-12 )
+DEF_PAR_FULL_REDUC_CASE_2( diff_sqsum, 1.0e-12 )
+
+
+SIMPLE_CASE( par_full_norm )
+{
+	set_par_max_threads(NUM_TEST_THREADS);
+
+	dense_col<double> s(max_len);
+	fill_rand(s);
+
+	ASSERT_APPROX(norm(s, norms::L1_(), par_()), norm(s, norms::L1_()), 1.0e-12);
+	ASSERT_APPROX(norm(s, norms::L2_(), par_()), norm(s, norms::L2_()), 1.0e-12);
+	ASSERT_EQ(norm(s, norms::Linf_(), par_()), norm(s, norms::Linf_()));
+}
+
+
+SIMPLE_CASE( par_full_sum_percol )
+{
+	set_par_max_threads(NUM_TEST_THREADS);
+
+	dense_matrix<double> a(test_nrows + 3, max_ncols);
+	fill_rand(a);
+
+	for (unsigned int t = 0; t < ntest_ncols; ++t)
+	{
+		index_t n = test_ncols[t];
+		auto ak = a(range(0, test_nrows), range(0, n));
+
+		double r0 = sum(ak);
+		double r = sum(ak, par_());
+
+		ASSERT_APPROX(r, r0, 1.0e-12);
+		ASSERT_EQ(sum(ak, par_()), r);
+		ASSERT_EQ(maximum(ak, par_()), maximum(ak));
+	}
+}
+
+
+SIMPLE_CASE( par_colwise_reduce )
+{
+	set_par_max_threads(NUM_TEST_THREADS);
+
+	dense_matrix<double> a(max_len, max_ncols);
+	fill_rand(a);
+
+	for (unsigned int t = 0; t < ntest_ncols; ++t)
+	{
+		index_t n = test_ncols[t];
+		auto ak = a(range(0, max_len), range(0, n));
+
+		dense_row<double> r0(n);
+		dense_row<double> r(n);
+
+		colwise_sum(ak, r0);
+		colwise_sum(ak, r, par_());
+		ASSERT_VEC_APPROX(n, r, r0, 1.0e-12);
+
+		colwise_maximum(ak, r0);
+		colwise_maximum(ak, r, par_());
+		ASSERT_VEC_EQ(n, r, r0);
+
+		colwise_norm(ak, r0, norms::L2_());
+		colwise_norm(ak, r, norms::L2_(), par_());
+		ASSERT_VEC_APPROX(n, r, r0, 1.0e-12);
+
+		auto bk = a(range(0, max_len), range(max_ncols - n, n));
+
+		colwise_dot(ak, bk, r0);
+		colwise_dot(ak, bk, r, par_());
+		ASSERT_VEC_APPROX(n, r, r0, 1.0e-12);
+
+		colwise_diff_sqsum(ak, bk, r0);
+		colwise_diff_sqsum(ak, bk, r, par_());
+		ASSERT_VEC_APPROX(n, r, r0, 1.0e-12);
+	}
+}
+
+
+SIMPLE_CASE( par_rowwise_reduce )
+{
+	set_par_max_threads(NUM_TEST_THREADS);
+
+	dense_matrix<double> a(test_nrows, max_ncols * 8);
+	fill_rand(a);
+
+	const index_t m = test_nrows;
+	for (unsigned int t = 0; t < ntest_ncols; ++t)
+	{
+		index_t n = test_ncols[t] * 8;
+		auto ak = a(range(0, m), range(0, n));
+
+		dense_col<double> r0(m);
+		dense_col<double> r(m);
+
+		// row-wise reduction keeps the sequential order for each row
+
+		rowwise_sum(ak, r0);
+		rowwise_sum(ak, r, par_());
+		ASSERT_VEC_EQ(m, r, r0);
+
+		rowwise_minimum(ak, r0);
+		rowwise_minimum(ak, r, par_());
+		ASSERT_VEC_EQ(m, r, r0);
+
+		rowwise_sqsum(ak, r0);
+		rowwise_sqsum(ak, r, par_());
+		ASSERT_VEC_EQ(m, r, r0);
+
+		auto bk = a(range(0, m), range(max_ncols * 8 - n, n));
+
+		rowwise_dot(ak, bk, r0);
+		rowwise_dot(ak, bk, r, par_());
+		ASSERT_VEC_EQ(m, r, r0);
+
+		rowwise_diff_sqsum(ak, bk, r0);
+		rowwise_diff_sqsum(ak, bk, r, par_());
+		ASSERT_VEC_EQ(m, r, r0);
+	}
+}
+
+
+AUTO_TPACK( par_reduce ) {
+	ADD_SIMPLE_CASE( par_full_sum )
+	ADD_SIMPLE_CASE( par_full_maximum )
+	ADD_SIMPLE_CASE( par_full_minimum )
+	ADD_SIMPLE_CASE( par_full_mean )
+
+	ADD_SIMPLE_CASE( par_full_asum )
+	ADD_SIMPLE_CASE( par_full_amax )
+	ADD_SIMPLE_CASE( par_full_sqsum )
+
+	ADD_SIMPLE_CASE( par_full_dot )
+	ADD_SIMPLE_CASE( par_full_diff_sqsum )
+
+	ADD_SIMPLE_CASE( par_full_norm )
+	ADD_SIMPLE_CASE( par_full_sum_percol )
+
+	ADD_SIMPLE_CASE( par_colwise_reduce )
+	ADD_SIMPLE_CASE( par_rowwise_reduce )
+}
@@ -26,7 +26,7 @@ using namespace lmat::test;
 
 // test cases
 
-template<typename STag, typename DTag, typename U, int M, int N>
+template<typename STag, typename DTag, typename U, index_t M, index_t N>
 void test_percol_ewise()
 {
 	const index_t m = M == 0 ? DM : M;
@@ -63,7 +63,7 @@ void test_percol_ewise()
 }
 
 
-template<typename DTag, typename U, int M, int N>
+template<typename DTag, typename U, index_t M, index_t N>
 void test_percol_ewise_single()
 {
 	const index_t m = M == 0 ? DM : M;
@@ -87,7 +87,7 @@ void test_percol_ewise_single()
 }
 
 
-template<typename DTag, typename U, int M, int N>
+template<typename DTag, typename U, index_t M, index_t N>
 void test_percol_ewise_repcol()
 {
 	const index_t m = M == 0 ? DM : M;
@@ -120,7 +120,7 @@ void test_percol_ewise_repcol()
 }
 
 
-template<typename DTag, typename U, int M, int N>
+template<typename DTag, typename U, index_t M, index_t N>
 void test_percol_ewise_reprow()
 {
 	const index_t m = M == 0 ? DM : M;
@@ -0,0 +1,234 @@
+/**
+ * @file test_rowmajor_eval.cpp
+ *
+ * @brief Unit testing of row-major matrices and their evaluation
+ *
+ * @author Dahua Lin
+ */
+
+// use small thresholds, such that the parallel code path
+// is exercised with matrices of moderate sizes
+
+#define LMAT_PAR_MIN_ELEMS 64
+
+#include "../test_base.h"
+
+#include <light_mat/matrix/matrix_classes.h>
+#include <light_mat/matexpr/mat_arith.h>
+#include <light_mat/mateval/mat_reduce.h>
+#include <light_mat/common/block.h>
+
+using namespace lmat;
+using namespace lmat::test;
+
+const int NUM_TEST_THREADS = 4;
+
+const index_t DM = 13;
+const index_t DN = 10;
+const index_t LDIM_EXTRA = 3;
+
+
+// explicit instantiation
+
+template class lmat::cref_matrix_rm<double, 0, 0>;
+template class lmat::cref_matrix_rm<double, 3, 4>;
+template class lmat::ref_matrix_rm<double, 0, 0>;
+template class lmat::ref_matrix_rm<double, 3, 4>;
+
+template class lmat::cref_block_rm<double, 0, 0>;
+template class lmat::cref_block_rm<double, 3, 4>;
+template class lmat::ref_block_rm<double, 0, 0>;
+template class lmat::ref_block_rm<double, 3, 4>;
+
+
+static_assert(lmat::meta::is_regular_mat<lmat::cref_matrix_rm<double> >::value, "Interface verification failed.");
+static_assert(lmat::meta::is_regular_mat<lmat::ref_block_rm<double> >::value, "Interface verification failed.");
+
+static_assert(lmat::meta::is_perrow_contiguous<lmat::ref_block_rm<double> >::value, "Layout verification failed.");
+static_assert(!lmat::meta::is_percol_contiguous<lmat::ref_block_rm<double> >::value, "Layout verification failed.");
+static_assert(lmat::meta::is_contiguous<lmat::ref_matrix_rm<double, 1, 0> >::value, "Layout verification failed.");
+
+// row-major arguments are evaluated row by row, and vectorized
+
+static_assert(std::is_same<
+		preferred_macc_policy<matrix_shape<0, 0>, copy_kernel<double>,
+			arg_wrap<cref_block_rm<double>, atags::in>,
+			arg_wrap<ref_matrix_rm<double>, atags::out> >::access,
+		perrow_>::value, "Policy verification failed.");
+
+static_assert(std::is_same<
+		preferred_macc_policy<matrix_shape<0, 0>, copy_kernel<double>,
+			arg_wrap<cref_block_rm<double>, atags::in>,
+			arg_wrap<ref_matrix_rm<double>, atags::out> >::unit,
+		simd_<default_simd_kind> >::value, "Policy verification failed.");
+
+static_assert(std::is_same<
+		preferred_macc_policy<matrix_shape<0, 0>, copy_kernel<double>,
+			arg_wrap<cref_block_rm<double>, atags::in>,
+			arg_wrap<dense_matrix<double>, atags::out> >::access,
+		percol_>::value, "Policy verification failed.");
+
+
+inline void fill_lin(dblock<double>& s)
+{
+	for (index_t i = 0; i < s.nelems(); ++i) s[i] = double(i + 1);
+}
+
+
+MN_CASE( rowmajor_layout )
+{
+	const index_t m = M == 0 ? DM : M;
+	const index_t n = N == 0 ? DN : N;
+	const index_t ldim = n + LDIM_EXTRA;
+
+	dblock<double> s(m * ldim);
+	fill_lin(s);
+	double *ps = s.ptr_data();
+
+	cref_matrix_rm<double, M, N> a(ps, m, n);
+	ref_block_rm<double, M, N> b(ps, m, n, ldim);
+
+	ASSERT_EQ( a.nrows(), m );
+	ASSERT_EQ( a.ncolumns(), n );
+	ASSERT_EQ( a.row_stride(), n );
+	ASSERT_EQ( a.col_stride(), 1 );
+
+	ASSERT_EQ( b.nrows(), m );
+	ASSERT_EQ( b.ncolumns(), n );
+	ASSERT_EQ( b.row_stride(), ldim );
+	ASSERT_EQ( b.col_stride(), 1 );
+
+	for (index_t i = 0; i < m; ++i)
+	{
+		for (index_t j = 0; j < n; ++j)
+		{
+			ASSERT_EQ( a(i, j), ps[i * n + j] );
+			ASSERT_EQ( b(i, j), ps[i * ldim + j] );
+		}
+	}
+
+	// rows are contiguous
+
+	for (index_t i = 0; i < m; ++i)
+	{
+		ref_matrix<double, 1, N> r = b.row(i);
+		ASSERT_EQ( r.ptr_data(), ps + i * ldim );
+		ASSERT_VEC_EQ( n, r, ps + i * ldim );
+	}
+
+	// copy from and to column-major matrices
+
+	dense_matrix<double, M, N> c(m, n);
+	copy(b, c);
+	ASSERT_MAT_EQ( m, n, c, b );
+
+	dblock<double> s2(m * ldim, zero());
+	ref_block_rm<double, M, N> b2(s2.ptr_data(), m, n, ldim);
+	b2 = c;
+	ASSERT_MAT_EQ( m, n, b2, c );
+
+	dblock<double> s3(m * ldim, zero());
+	ref_block_rm<double, M, N> b3(s3.ptr_data(), m, n, ldim);
+	b3 = b2;
+	ASSERT_MAT_EQ( m, n, b3, c );
+
+	fill(b3, 2.0);
+	for (index_t i = 0; i < m; ++i)
+	{
+		for (index_t j = 0; j < n; ++j) ASSERT_EQ( b3(i, j), 2.0 );
+		for (index_t j = n; j < ldim; ++j) ASSERT_EQ( s3[i * ldim + j], 0.0 );
+	}
+}
+
+
+MN_CASE( rowmajor_ewise )
+{
+	set_par_max_threads(NUM_TEST_THREADS);
+
+	const index_t m = M == 0 ? DM : M;
+	const index_t n = N == 0 ? DN : N;
+	const index_t ldim = n + LDIM_EXTRA;
+
+	dblock<double> sa(m * n);
+	dblock<double> sb(m * ldim);
+	fill_lin(sa);
+	fill_lin(sb);
+
+	cref_matrix_rm<double, M, N> a(sa.ptr_data(), m, n);
+	cref_block_rm<double, M, N> b(sb.ptr_data(), m, n, ldim);
+
+	dense_matrix<double, M, N> r(m, n);
+	for (index_t j = 0; j < n; ++j)
+	{
+		for (index_t i = 0; i < m; ++i) r(i, j) = a(i, j) * 2.0 + b(i, j);
+	}
+
+	dblock<double> sd(m * ldim, zero());
+	ref_block_rm<double, M, N> d(sd.ptr_data(), m, n, ldim);
+
+	d = a * 2.0 + b;
+	ASSERT_MAT_EQ( m, n, d, r );
+
+	// the padding between rows is not touched
+	for (index_t i = 0; i < m; ++i)
+	{
+		for (index_t j = n; j < ldim; ++j) ASSERT_EQ( sd[i * ldim + j], 0.0 );
+	}
+
+	dblock<double> sd2(m * ldim, zero());
+	ref_block_rm<double, M, N> d2(sd2.ptr_data(), m, n, ldim);
+
+	macc_evaluate(a * 2.0 + b, d2, par_());
+	ASSERT_MAT_EQ( m, n, d2, r );
+
+	// mixed with column-major matrices
+
+	dense_matrix<double, M, N> c(m, n);
+	c = a * 2.0 + b;
+	ASSERT_MAT_EQ( m, n, c, r );
+}
+
+
+MN_CASE( rowmajor_fold )
+{
+	set_par_max_threads(NUM_TEST_THREADS);
+
+	const index_t m = M == 0 ? DM : M;
+	const index_t n = N == 0 ? DN : N;
+	const index_t ldim = n + LDIM_EXTRA;
+
+	dblock<double> sa(m * n);
+	dblock<double> sb(m * ldim);
+	fill_lin(sa);
+	fill_lin(sb);
+
+	cref_matrix_rm<double, M, N> a(sa.ptr_data(), m, n);
+	cref_block_rm<double, M, N> b(sb.ptr_data(), m, n, ldim);
+
+	dense_matrix<double, M, N> ca(a);
+	dense_matrix<double, M, N> cb(b);
+
+	const double tol = 1.0e-12;
+
+	ASSERT_APPROX( sum(b), sum(cb), tol );
+	ASSERT_APPROX( sum(b, par_()), sum(cb), tol );
+	ASSERT_APPROX( maximum(b), maximum(cb), tol );
+	ASSERT_APPROX( dot(a, b), dot(ca, cb), tol );
+	ASSERT_APPROX( dot(a, b, par_()), dot(ca, cb), tol );
+}
+
+
+AUTO_TPACK( rowmajor_layout )
+{
+	ADD_MN_CASE_3X3( rowmajor_layout, DM, DN )
+}
+
+AUTO_TPACK( rowmajor_ewise )
+{
+	ADD_MN_CASE_3X3( rowmajor_ewise, DM, DN )
+}
+
+AUTO_TPACK( rowmajor_fold )
+{
+	ADD_MN_CASE_3X3( rowmajor_fold, DM, DN )
+}
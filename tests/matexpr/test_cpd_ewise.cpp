@@ -22,7 +22,7 @@ using namespace lmat::test;
 
 // auxiliary functions
 
-template<int M, int N>
+template<index_t M, index_t N>
 void fill_ran(dense_matrix<double, M, N>& X, double a, double b)
 {
 	for (index_t i = 0; i < X.nelems(); ++i)
@@ -112,7 +112,7 @@ bool my_use_simd(const map_expr<FTag, A, B>& expr, const Dst& dmat)
 
 
 
-template<typename STag1, typename DTag, int M, int N>
+template<typename STag1, typename DTag, index_t M, index_t N>
 void test_mapexpr_1()
 {
 	index_t m = M == 0 ? DM : M;
@@ -162,7 +162,7 @@ void test_mapexpr_1()
 }
 
 
-template<typename STag1, typename STag2, typename DTag, int M, int N>
+template<typename STag1, typename STag2, typename DTag, index_t M, index_t N>
 void test_mapexpr_2()
 {
 	index_t m = M == 0 ? DM : M;
@@ -237,7 +237,7 @@ void test_mapexpr_2()
 }
 
 
-template<typename STag1, typename STag2, typename STag3, typename DTag, int M, int N>
+template<typename STag1, typename STag2, typename STag3, typename DTag, index_t M, index_t N>
 void test_mapexpr_3()
 {
 	index_t m = M == 0 ? DM : M;
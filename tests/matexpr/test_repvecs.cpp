@@ -18,7 +18,7 @@ using namespace lmat::test;
 
 // Auxiliary facilities
 
-template<class Tag1, class Tag2, int M, int N>
+template<class Tag1, class Tag2, index_t M, index_t N>
 void test_repcols()
 {
 	const index_t m = M == 0 ? DM : M;
@@ -63,7 +63,7 @@ void test_repcols()
 	ASSERT_MAT_EQ( m, n, dmat, rmat );
 }
 
-template<class Tag1, class Tag2, int M, int N>
+template<class Tag1, class Tag2, index_t M, index_t N>
 void test_reprows()
 {
 	const index_t m = M == 0 ? DM : M;
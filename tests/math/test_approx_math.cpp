@@ -0,0 +1,296 @@
+/**
+ * @file test_approx_math.cpp
+ *
+ * @brief Unit testing for the fast approximate math functions
+ *
+ * @author Dahua Lin
+ */
+
+
+#include "test_simd_math_base.h"
+#include <light_mat/math/approx_math.h>
+#include <light_mat/matexpr/mat_arith.h>
+#include <light_mat/matexpr/mat_emath.h>
+#include <light_mat/matexpr/mat_approx.h>
+#include <light_mat/matrix/matrix_classes.h>
+#include <light_mat/matrix/ref_block.h>
+#include <light_mat/matrix/ref_block_rm.h>
+#include <limits>
+
+using namespace lmat;
+using namespace lmat::test;
+
+const int TTimes = 50;
+
+
+/************************************************
+ *
+ *  Reference functions
+ *
+ ************************************************/
+
+template<typename T> inline T ref_exp(T x) { return std::exp(x); }
+template<typename T> inline T ref_log(T x) { return std::log(x); }
+template<typename T> inline T ref_tanh(T x) { return std::tanh(x); }
+template<typename T> inline T ref_sigmoid(T x) { return T(1) / (T(1) + std::exp(-x)); }
+template<typename T> inline T ref_rcp(T x) { return T(1) / x; }
+template<typename T> inline T ref_rsqrt(T x) { return T(1) / std::sqrt(x); }
+
+template<typename T>
+inline bool rel_near(T a, T b, double tol)
+{
+	return std::fabs(double(a) - double(b)) <= tol * std::fabs(double(b));
+}
+
+template<typename T>
+inline bool special_match(T a, T b)
+{
+	if (b != b) return a != a;
+	if (b == a) return true;
+	return rel_near(a, b, 1.0e-5);
+}
+
+
+/************************************************
+ *
+ *  Accuracy
+ *
+ ************************************************/
+
+#define DEFINE_APPROX_CASE( Name, SIMD, tol, LB, UB ) \
+	T_CASE( approx_##Name##_##SIMD ) { \
+		typedef simd_pack<T, SIMD##_t> pack_t; \
+		const unsigned int width = pack_t::pack_width; \
+		T a[width]; \
+		T r[width]; \
+		for (int t = 0; t < TTimes; ++t) { \
+			for (unsigned i = 0; i < width; ++i) a[i] = T(randunif(LB, UB)); \
+			pack_t x; x.load_u(a); \
+			math::approx_##Name(x).store_u(r); \
+			for (unsigned i = 0; i < width; ++i) \
+				ASSERT_TRUE( rel_near(r[i], ref_##Name(a[i]), tol) ); \
+		} \
+	}
+
+#define DEFINE_APPROX_SPECIAL_CASE( Name, SIMD ) \
+	T_CASE( approx_##Name##_special_##SIMD ) { \
+		typedef simd_pack<T, SIMD##_t> pack_t; \
+		typedef std::numeric_limits<T> lim; \
+		const unsigned int width = pack_t::pack_width; \
+		const int n = 10; \
+		const T vs[n] = { T(0), -T(0), T(1), T(-1), T(0.5), T(-3), \
+				lim::infinity(), -lim::infinity(), lim::quiet_NaN(), T(-1.0e7) }; \
+		T r[width]; \
+		for (int i = 0; i < n; ++i) { \
+			math::approx_##Name(pack_t(vs[i])).store_u(r); \
+			ASSERT_TRUE( special_match(r[0], math::approx_##Name(vs[i])) ); \
+			ASSERT_TRUE( special_match(r[width-1], math::approx_##Name(vs[i])) ); \
+		} \
+	}
+
+#if defined(LMAT_HAS_AVX512)
+
+#define DEFINE_APPROX_TPACK( Name, tol, LB, UB ) \
+	DEFINE_APPROX_CASE( Name, sse, tol, LB, UB ) \
+	DEFINE_APPROX_CASE( Name, avx, tol, LB, UB ) \
+	DEFINE_APPROX_CASE( Name, avx512, tol, LB, UB ) \
+	AUTO_TPACK( approx_##Name ) { \
+		ADD_T_CASE( approx_##Name##_sse, float ) \
+		ADD_T_CASE( approx_##Name##_sse, double ) \
+		ADD_T_CASE( approx_##Name##_avx, float ) \
+		ADD_T_CASE( approx_##Name##_avx, double ) \
+		ADD_T_CASE( approx_##Name##_avx512, float ) \
+		ADD_T_CASE( approx_##Name##_avx512, double ) \
+	}
+
+#define DEFINE_APPROX_SPECIAL_TPACK( Name ) \
+	DEFINE_APPROX_SPECIAL_CASE( Name, sse ) \
+	DEFINE_APPROX_SPECIAL_CASE( Name, avx ) \
+	DEFINE_APPROX_SPECIAL_CASE( Name, avx512 ) \
+	AUTO_TPACK( approx_##Name##_special ) { \
+		ADD_T_CASE( approx_##Name##_special_sse, float ) \
+		ADD_T_CASE( approx_##Name##_special_sse, double ) \
+		ADD_T_CASE( approx_##Name##_special_avx, float ) \
+		ADD_T_CASE( approx_##Name##_special_avx, double ) \
+		ADD_T_CASE( approx_##Name##_special_avx512, float ) \
+		ADD_T_CASE( approx_##Name##_special_avx512, double ) \
+	}
+
+#elif defined(LMAT_HAS_AVX)
+
+#define DEFINE_APPROX_TPACK( Name, tol, LB, UB ) \
+	DEFINE_APPROX_CASE( Name, sse, tol, LB, UB ) \
+	DEFINE_APPROX_CASE( Name, avx, tol, LB, UB ) \
+	AUTO_TPACK( approx_##Name ) { \
+		ADD_T_CASE( approx_##Name##_sse, float ) \
+		ADD_T_CASE( approx_##Name##_sse, double ) \
+		ADD_T_CASE( approx_##Name##_avx, float ) \
+		ADD_T_CASE( approx_##Name##_avx, double ) \
+	}
+
+#define DEFINE_APPROX_SPECIAL_TPACK( Name ) \
+	DEFINE_APPROX_SPECIAL_CASE( Name, sse ) \
+	DEFINE_APPROX_SPECIAL_CASE( Name, avx ) \
+	AUTO_TPACK( approx_##Name##_special ) { \
+		ADD_T_CASE( approx_##Name##_special_sse, float ) \
+		ADD_T_CASE( approx_##Name##_special_sse, double ) \
+		ADD_T_CASE( approx_##Name##_special_avx, float ) \
+		ADD_T_CASE( approx_##Name##_special_avx, double ) \
+	}
+
+#else
+
+#define DEFINE_APPROX_TPACK( Name, tol, LB, UB ) \
+	DEFINE_APPROX_CASE( Name, sse, tol, LB, UB ) \
+	AUTO_TPACK( approx_##Name ) { \
+		ADD_T_CASE( approx_##Name##_sse, float ) \
+		ADD_T_CASE( approx_##Name##_sse, double ) \
+	}
+
+#define DEFINE_APPROX_SPECIAL_TPACK( Name ) \
+	DEFINE_APPROX_SPECIAL_CASE( Name, sse ) \
+	AUTO_TPACK( approx_##Name##_special ) { \
+		ADD_T_CASE( approx_##Name##_special_sse, float ) \
+		ADD_T_CASE( approx_##Name##_special_sse, double ) \
+	}
+
+#endif
+
+// tolerances are the documented bounds
+
+DEFINE_APPROX_TPACK( exp,     4.0e-6, -80.0, 80.0 )
+DEFINE_APPROX_TPACK( log,     8.0e-6, 1.0e-6, 1.0e6 )
+DEFINE_APPROX_TPACK( tanh,    4.0e-6, -5.0, 5.0 )
+DEFINE_APPROX_TPACK( sigmoid, 4.0e-6, -20.0, 20.0 )
+DEFINE_APPROX_TPACK( rcp,     4.0e-4, -100.0, 100.0 )
+DEFINE_APPROX_TPACK( rsqrt,   4.0e-4, 1.0e-3, 1.0e3 )
+
+DEFINE_APPROX_SPECIAL_TPACK( exp )
+DEFINE_APPROX_SPECIAL_TPACK( log )
+DEFINE_APPROX_SPECIAL_TPACK( tanh )
+DEFINE_APPROX_SPECIAL_TPACK( sigmoid )
+
+
+/************************************************
+ *
+ *  Matrix expressions
+ *
+ ************************************************/
+
+T_CASE( approx_mat_expr )
+{
+	const index_t m = 13;
+	const index_t n = 7;
+
+	dense_matrix<T> a(m, n);
+	for (index_t i = 0; i < m * n; ++i) a[i] = T(randunif(-6.0, 6.0));
+
+	ASSERT_TRUE( (meta::has_simd_support<ftags::approx_sigmoid_, T, default_simd_kind>::value) );
+
+	dense_matrix<T> r = approx_sigmoid(a);
+	for (index_t i = 0; i < m * n; ++i)
+		ASSERT_TRUE( rel_near(r[i], ref_sigmoid(a[i]), 4.0e-6) );
+
+	dense_matrix<T> s = approx_exp(a) * approx_tanh(a);
+	for (index_t i = 0; i < m * n; ++i)
+		ASSERT_TRUE( rel_near(s[i], ref_exp(a[i]) * ref_tanh(a[i]), 1.0e-5) );
+}
+
+AUTO_TPACK( approx_mat_expr )
+{
+	ADD_T_CASE( approx_mat_expr, float )
+	ADD_T_CASE( approx_mat_expr, double )
+}
+
+
+
+T_CASE( approx_policy )
+{
+	const index_t m = 13;
+	const index_t n = 7;
+
+	dense_matrix<T> a(m, n);
+	dense_matrix<T> b(m, n);
+	for (index_t i = 0; i < m * n; ++i) a[i] = T(randunif(-6.0, 6.0));
+	for (index_t i = 0; i < m * n; ++i) b[i] = T(randunif(1.0e-3, 1.0e3));
+
+	ASSERT_TRUE( (supports_simd<approx_expr<dense_matrix<T> >, default_simd_kind>::value) );
+
+	// same kernels as the explicit approx functions
+
+	dense_matrix<T> r = approx_(exp(a) + log(b) * tanh(a));
+	dense_matrix<T> r0 = approx_exp(a) + approx_log(b) * approx_tanh(a);
+	ASSERT_MAT_EQ( m, n, r, r0 );
+
+	dense_matrix<T> s = approx_(rcp(T(1) + exp(-a)));
+	dense_matrix<T> s0 = rcp(T(1) + approx_exp(-a));
+	ASSERT_MAT_EQ( m, n, s, s0 );
+
+	dense_matrix<T> t = approx_(exp(a)) * a + approx_(log(b));
+	dense_matrix<T> t0 = approx_exp(a) * a + approx_log(b);
+	ASSERT_MAT_EQ( m, n, t, t0 );
+
+	// close to the exact path
+
+	dense_matrix<T> e = approx_(exp(a));
+	dense_matrix<T> l = approx_(log(b));
+	dense_matrix<T> h = approx_(tanh(a));
+	for (index_t i = 0; i < m * n; ++i)
+	{
+		ASSERT_TRUE( rel_near(e[i], ref_exp(a[i]), 4.0e-6) );
+		ASSERT_TRUE( rel_near(l[i], ref_log(b[i]), 8.0e-6) );
+		ASSERT_TRUE( rel_near(h[i], ref_tanh(a[i]), 4.0e-6) );
+		ASSERT_TRUE( rel_near(s[i], ref_sigmoid(a[i]), 1.0e-5) );
+	}
+
+	// functions without an approximate version are kept
+
+	dense_matrix<T> q = approx_(sqrt(b) + exp(a));
+	dense_matrix<T> q0 = sqrt(b) + approx_exp(a);
+	ASSERT_MAT_EQ( m, n, q, q0 );
+}
+
+T_CASE( approx_policy_blocks )
+{
+	const index_t m = 13;
+	const index_t n = 7;
+	const index_t ldim = 16;
+
+	dense_matrix<T> sa(ldim, ldim);
+	dense_matrix<T> sb(ldim, ldim);
+	for (index_t i = 0; i < ldim * ldim; ++i) sa[i] = T(randunif(-6.0, 6.0));
+	for (index_t i = 0; i < ldim * ldim; ++i) sb[i] = T(randunif(1.0e-3, 1.0e3));
+
+	dense_matrix<T> sr(ldim, ldim, zero());
+	dense_matrix<T> sr0(ldim, ldim, zero());
+
+	// column-major blocks
+
+	ref_block<T> a(sa.ptr_data(), m, n, ldim);
+	ref_block<T> b(sb.ptr_data(), m, n, ldim);
+	ref_block<T> r(sr.ptr_data(), m, n, ldim);
+	ref_block<T> r0(sr0.ptr_data(), m, n, ldim);
+
+	r = approx_(exp(a) - tanh(b) * log(b));
+	r0 = approx_exp(a) - approx_tanh(b) * approx_log(b);
+	ASSERT_MAT_EQ( m, n, r, r0 );
+
+	// row-major blocks
+
+	ref_block_rm<T> ra(sa.ptr_data(), m, n, ldim);
+	ref_block_rm<T> rb(sb.ptr_data(), m, n, ldim);
+	ref_block_rm<T> rr(sr.ptr_data(), m, n, ldim);
+	ref_block_rm<T> rr0(sr0.ptr_data(), m, n, ldim);
+
+	rr = approx_(exp(ra) - tanh(rb) * log(rb));
+	rr0 = approx_exp(ra) - approx_tanh(rb) * approx_log(rb);
+	ASSERT_MAT_EQ( m, n, rr, rr0 );
+}
+
+AUTO_TPACK( approx_policy )
+{
+	ADD_T_CASE( approx_policy, float )
+	ADD_T_CASE( approx_policy, double )
+	ADD_T_CASE( approx_policy_blocks, float )
+	ADD_T_CASE( approx_policy_blocks, double )
+}
@@ -0,0 +1,350 @@
+/**
+ * @file test_native_simd_math.cpp
+ *
+ * @brief Unit testing for the built-in SIMD elementary functions
+ *
+ * @author Dahua Lin
+ */
+
+
+#include "test_simd_math_base.h"
+#include <light_mat/math/simd_math.h>
+#include <light_mat/math/math_functors.h>
+#include <limits>
+
+using namespace lmat;
+using namespace lmat::test;
+
+const int TTimes = 50;
+
+
+/************************************************
+ *
+ *  Special values
+ *
+ ************************************************/
+
+template<typename T>
+inline bool special_match(T a, T b)
+{
+	if (b != b) return a != a;
+	if (b == T(0)) return a == T(0) && std::signbit(a) == std::signbit(b);
+	if (b == a) return true;
+	return ltest::ulp_distance(a, b) <= 4;
+}
+
+template<typename T>
+struct special_inputs
+{
+	static const int n = 20;
+	T v[n];
+
+	special_inputs()
+	{
+		typedef std::numeric_limits<T> lim;
+		const T vs[n] = {
+				T(0), -T(0), T(1), T(-1), T(0.5), T(-0.5), T(2), T(-3),
+				lim::infinity(), -lim::infinity(), lim::quiet_NaN(),
+				lim::denorm_min(), lim::min(), T(0.75) * lim::min(),
+				lim::max(), -lim::max(),
+				T(1.0e-20), T(-1.0e-20), T(1000), T(-1.0e7) };
+
+		for (int i = 0; i < n; ++i) v[i] = vs[i];
+	}
+};
+
+#define DEFINE_SPECIAL_CASE1( Name, SIMD ) \
+	T_CASE( Name##_special_##SIMD ) { \
+		typedef simd_pack<T, SIMD##_t> pack_t; \
+		const unsigned int width = pack_t::pack_width; \
+		special_inputs<T> sv; \
+		T r[width]; \
+		for (int i = 0; i < sv.n; ++i) { \
+			math::Name(pack_t(sv.v[i])).store_u(r); \
+			ASSERT_TRUE( special_match(r[0], math::Name(sv.v[i])) ); \
+			ASSERT_TRUE( special_match(r[width-1], math::Name(sv.v[i])) ); \
+		} \
+	}
+
+#define DEFINE_SPECIAL_CASE2( Name, SIMD ) \
+	T_CASE( Name##_special_##SIMD ) { \
+		typedef simd_pack<T, SIMD##_t> pack_t; \
+		const unsigned int width = pack_t::pack_width; \
+		special_inputs<T> sv; \
+		T r[width]; \
+		for (int i = 0; i < sv.n; ++i) { \
+			for (int j = 0; j < sv.n; ++j) { \
+				math::Name(pack_t(sv.v[i]), pack_t(sv.v[j])).store_u(r); \
+				ASSERT_TRUE( special_match(r[0], math::Name(sv.v[i], sv.v[j])) ); \
+			} \
+		} \
+	}
+
+#if defined(LMAT_HAS_AVX512)
+
+#define DEFINE_SPECIAL_TPACK( Name, K ) \
+	DEFINE_SPECIAL_CASE##K( Name, sse ) \
+	DEFINE_SPECIAL_CASE##K( Name, avx ) \
+	DEFINE_SPECIAL_CASE##K( Name, avx512 ) \
+	AUTO_TPACK( Name##_special ) { \
+		ADD_T_CASE( Name##_special_sse, float ) \
+		ADD_T_CASE( Name##_special_sse, double ) \
+		ADD_T_CASE( Name##_special_avx, float ) \
+		ADD_T_CASE( Name##_special_avx, double ) \
+		ADD_T_CASE( Name##_special_avx512, float ) \
+		ADD_T_CASE( Name##_special_avx512, double ) \
+	}
+
+#elif defined(LMAT_HAS_AVX)
+
+#define DEFINE_SPECIAL_TPACK( Name, K ) \
+	DEFINE_SPECIAL_CASE##K( Name, sse ) \
+	DEFINE_SPECIAL_CASE##K( Name, avx ) \
+	AUTO_TPACK( Name##_special ) { \
+		ADD_T_CASE( Name##_special_sse, float ) \
+		ADD_T_CASE( Name##_special_sse, double ) \
+		ADD_T_CASE( Name##_special_avx, float ) \
+		ADD_T_CASE( Name##_special_avx, double ) \
+	}
+
+#else
+
+#define DEFINE_SPECIAL_TPACK( Name, K ) \
+	DEFINE_SPECIAL_CASE##K( Name, sse ) \
+	AUTO_TPACK( Name##_special ) { \
+		ADD_T_CASE( Name##_special_sse, float ) \
+		ADD_T_CASE( Name##_special_sse, double ) \
+	}
+
+#endif
+
+
+/************************************************
+ *
+ *  Accuracy (within the documented bounds)
+ *
+ ************************************************/
+
+// power
+
+DEFINE_MATH_TPACK2( pow,   4,  0.0, 10.0, -20.0, 20.0 )
+
+// exp & log
+
+DEFINE_MATH_TPACK1( exp,   1, -80.0, 80.0 )
+DEFINE_MATH_TPACK1( log,   1, 1.0e-6, 1.0e6 )
+DEFINE_MATH_TPACK1( log10, 2, 1.0e-6, 1.0e6 )
+
+DEFINE_MATH_TPACK1( exp2,  1, -120.0, 120.0 )
+DEFINE_MATH_TPACK1( log2,  2, 1.0e-6, 1.0e6 )
+DEFINE_MATH_TPACK1( expm1, 2, -2.0, 2.0 )
+DEFINE_MATH_TPACK1( log1p, 1, -0.9, 10.0 )
+
+DEFINE_MATH_TPACK2( xlogy, 2, -1.0, 1.0, 0.0, 1.0 )
+
+// trigonometry
+
+DEFINE_MATH_TPACK1( sin,  2, -1000.0, 1000.0 )
+DEFINE_MATH_TPACK1( cos,  2, -1000.0, 1000.0 )
+DEFINE_MATH_TPACK1( tan,  3, -10.0, 10.0 )
+DEFINE_MATH_TPACK1( atan, 3, -20.0, 20.0 )
+
+// hyperbolic
+
+DEFINE_MATH_TPACK1( sinh, 3, -20.0, 20.0 )
+DEFINE_MATH_TPACK1( cosh, 3, -20.0, 20.0 )
+DEFINE_MATH_TPACK1( tanh, 3, -5.0, 5.0 )
+
+// special functions
+
+DEFINE_MATH_TPACK1( erf,     2, -6.0, 6.0 )
+DEFINE_MATH_TPACK1( erfc,    4, -6.0, 10.0 )
+DEFINE_MATH_TPACK1( norminv, 4, 0.0, 1.0 )
+DEFINE_MATH_TPACK1( tgamma,  8, 0.0, 20.0 )
+DEFINE_MATH_TPACK1( lgamma,  4, 0.0, 100.0 )
+
+// special values
+
+DEFINE_SPECIAL_TPACK( pow, 2 )
+
+DEFINE_SPECIAL_TPACK( exp, 1 )
+DEFINE_SPECIAL_TPACK( log, 1 )
+DEFINE_SPECIAL_TPACK( log10, 1 )
+DEFINE_SPECIAL_TPACK( exp2, 1 )
+DEFINE_SPECIAL_TPACK( log2, 1 )
+DEFINE_SPECIAL_TPACK( expm1, 1 )
+DEFINE_SPECIAL_TPACK( log1p, 1 )
+
+DEFINE_SPECIAL_TPACK( sin, 1 )
+DEFINE_SPECIAL_TPACK( cos, 1 )
+DEFINE_SPECIAL_TPACK( tan, 1 )
+DEFINE_SPECIAL_TPACK( atan, 1 )
+
+DEFINE_SPECIAL_TPACK( sinh, 1 )
+DEFINE_SPECIAL_TPACK( cosh, 1 )
+DEFINE_SPECIAL_TPACK( tanh, 1 )
+
+DEFINE_SPECIAL_TPACK( erf, 1 )
+DEFINE_SPECIAL_TPACK( erfc, 1 )
+DEFINE_SPECIAL_TPACK( norminv, 1 )
+DEFINE_SPECIAL_TPACK( tgamma, 1 )
+DEFINE_SPECIAL_TPACK( lgamma, 1 )
+
+
+/************************************************
+ *
+ *  Gamma functions beyond the main range
+ *
+ ************************************************/
+
+inline double rand_neg_nonint(double lb)
+{
+	double x;
+	do { x = randunif(lb, 0.0); } while (x == std::floor(x));
+	return x;
+}
+
+// near the roots of lgamma on the negative axis, the reflection
+// loses relative (but not absolute) accuracy
+
+template<typename T>
+inline bool lgamma_match(T a, T b)
+{
+	return ltest::ulp_distance(a, b) <= 8 ||
+			std::fabs(a - b) <= T(256) * std::numeric_limits<T>::epsilon();
+}
+
+#define DEFINE_GAMMA_CASES( SIMD ) \
+	T_CASE( gamma_neg_##SIMD ) { \
+		typedef simd_pack<T, SIMD##_t> pack_t; \
+		const unsigned int width = pack_t::pack_width; \
+		T a[width]; \
+		T rt0[width]; \
+		T r[width]; \
+		for (int t = 0; t < TTimes; ++t) { \
+			for (unsigned i = 0; i < width; ++i) { \
+				a[i] = T(rand_neg_nonint(-20.0)); \
+				rt0[i] = math::tgamma(a[i]); \
+			} \
+			pack_t x; x.load_u(a); \
+			ASSERT_SIMD_ULP( math::tgamma(x), rt0, 8 ); \
+			math::lgamma(x).store_u(r); \
+			for (unsigned i = 0; i < width; ++i) \
+				ASSERT_TRUE( lgamma_match(r[i], math::lgamma(a[i])) ); \
+		} \
+	} \
+	T_CASE( gamma_poles_##SIMD ) { \
+		typedef simd_pack<T, SIMD##_t> pack_t; \
+		const T inf = std::numeric_limits<T>::infinity(); \
+		for (int k = 1; k <= 20; ++k) { \
+			pack_t x(-T(k)); \
+			T g = math::tgamma(x)[0]; \
+			ASSERT_TRUE( g != g ); \
+			ASSERT_EQ( math::lgamma(x)[0], inf ); \
+		} \
+		ASSERT_EQ( math::tgamma(pack_t(T(0)))[0], inf ); \
+		ASSERT_EQ( math::tgamma(pack_t(-T(0)))[0], -inf ); \
+		ASSERT_EQ( math::lgamma(pack_t(T(0)))[0], inf ); \
+		ASSERT_EQ( math::lgamma(pack_t(-T(0)))[0], inf ); \
+	} \
+	T_CASE( tgamma_overflow_##SIMD ) { \
+		typedef simd_pack<T, SIMD##_t> pack_t; \
+		const unsigned int width = pack_t::pack_width; \
+		const double ub = sizeof(T) == 4 ? 35.0 : 171.6; \
+		T a[width]; \
+		T r0[width]; \
+		for (int t = 0; t < TTimes; ++t) { \
+			for (unsigned i = 0; i < width; ++i) { \
+				a[i] = T(randunif(ub - 10.0, ub)); \
+				r0[i] = math::tgamma(a[i]); \
+			} \
+			pack_t x; x.load_u(a); \
+			ASSERT_SIMD_ULP( math::tgamma(x), r0, 8 ); \
+		} \
+		const T beyond = T(sizeof(T) == 4 ? 35.1 : 171.7); \
+		ASSERT_EQ( math::tgamma(pack_t(beyond))[0], std::numeric_limits<T>::infinity() ); \
+	}
+
+DEFINE_GAMMA_CASES( sse )
+
+#ifdef LMAT_HAS_AVX
+DEFINE_GAMMA_CASES( avx )
+#endif
+
+#if defined(LMAT_HAS_AVX512)
+DEFINE_GAMMA_CASES( avx512 )
+#endif
+
+AUTO_TPACK( gamma_ext )
+{
+	ADD_T_CASE_FP( gamma_neg_sse )
+	ADD_T_CASE_FP( gamma_poles_sse )
+	ADD_T_CASE_FP( tgamma_overflow_sse )
+#ifdef LMAT_HAS_AVX
+	ADD_T_CASE_FP( gamma_neg_avx )
+	ADD_T_CASE_FP( gamma_poles_avx )
+	ADD_T_CASE_FP( tgamma_overflow_avx )
+#endif
+#if defined(LMAT_HAS_AVX512)
+	ADD_T_CASE_FP( gamma_neg_avx512 )
+	ADD_T_CASE_FP( gamma_poles_avx512 )
+	ADD_T_CASE_FP( tgamma_overflow_avx512 )
+#endif
+}
+
+
+/************************************************
+ *
+ *  Mixed & large arguments
+ *
+ ************************************************/
+
+// packs with some entries beyond the range of the native reduction
+
+T_CASE( sin_large_sse )
+{
+	typedef simd_pack<T, sse_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	T a[width];
+	T r0[width];
+	for (int t = 0; t < TTimes; ++t)
+	{
+		for (unsigned i = 0; i < width; ++i)
+		{
+			a[i] = T(i % 2 == 0 ? randunif(-1.0e7, 1.0e7) : randunif(-3.0, 3.0));
+			r0[i] = math::sin(a[i]);
+		}
+
+		pack_t x; x.load_u(a);
+		ASSERT_SIMD_ULP( math::sin(x), r0, 2 );
+	}
+}
+
+AUTO_TPACK( sin_large )
+{
+	ADD_T_CASE( sin_large_sse, float )
+	ADD_T_CASE( sin_large_sse, double )
+}
+
+
+// element-wise expressions on the default kind are vectorized
+
+SIMPLE_CASE( native_simd_support )
+{
+	typedef default_simd_kind skind;
+
+	ASSERT_TRUE( (meta::has_simd_support<ftags::exp_, double, skind>::value) );
+	ASSERT_TRUE( (meta::has_simd_support<ftags::log_, double, skind>::value) );
+	ASSERT_TRUE( (meta::has_simd_support<ftags::pow_, float, skind>::value) );
+	ASSERT_TRUE( (meta::has_simd_support<ftags::sin_, float, skind>::value) );
+	ASSERT_TRUE( (meta::has_simd_support<ftags::tanh_, double, skind>::value) );
+	ASSERT_TRUE( (meta::has_simd_support<ftags::erf_, float, skind>::value) );
+	ASSERT_TRUE( (meta::has_simd_support<ftags::norminv_, double, skind>::value) );
+	ASSERT_TRUE( (meta::has_simd_support<ftags::lgamma_, double, skind>::value) );
+}
+
+AUTO_TPACK( default_kind )
+{
+	ADD_SIMPLE_CASE( native_simd_support )
+}
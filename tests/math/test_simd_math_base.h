@@ -66,7 +66,37 @@ inline double randunif(double LB, double UB)
 	}
 
 
-#ifdef LMAT_HAS_AVX
+// the vendor libraries provide no AVX-512 versions
+
+#if defined(LMAT_HAS_AVX512) && !defined(LMAT_USE_INTEL_SVML) && !defined(LMAT_USE_AMD_LIBM)
+
+#define DEFINE_MATH_TPACK1( Name, ulp, LB, UB ) \
+	DEFINE_MATH_CASE1( Name,  sse, ulp, LB, UB ) \
+	DEFINE_MATH_CASE1( Name,  avx, ulp, LB, UB ) \
+	DEFINE_MATH_CASE1( Name,  avx512, ulp, LB, UB ) \
+	AUTO_TPACK ( Name##_simd ) { \
+		ADD_T_CASE( Name##_sse, float ) \
+		ADD_T_CASE( Name##_sse, double ) \
+		ADD_T_CASE( Name##_avx, float ) \
+		ADD_T_CASE( Name##_avx, double ) \
+		ADD_T_CASE( Name##_avx512, float ) \
+		ADD_T_CASE( Name##_avx512, double ) \
+	}
+
+#define DEFINE_MATH_TPACK2( Name, ulp, LBa, UBa, LBb, UBb ) \
+	DEFINE_MATH_CASE2( Name,  sse, ulp, LBa, UBa, LBb, UBb ) \
+	DEFINE_MATH_CASE2( Name,  avx, ulp, LBa, UBa, LBb, UBb ) \
+	DEFINE_MATH_CASE2( Name,  avx512, ulp, LBa, UBa, LBb, UBb ) \
+	AUTO_TPACK( Name##_simd ) { \
+		ADD_T_CASE( Name##_sse, float ) \
+		ADD_T_CASE( Name##_sse, double ) \
+		ADD_T_CASE( Name##_avx, float ) \
+		ADD_T_CASE( Name##_avx, double ) \
+		ADD_T_CASE( Name##_avx512, float ) \
+		ADD_T_CASE( Name##_avx512, double ) \
+	}
+
+#elif defined(LMAT_HAS_AVX)
 
 #define DEFINE_MATH_TPACK1( Name, ulp, LB, UB ) \
 	DEFINE_MATH_CASE1( Name,  sse, ulp, LB, UB ) \
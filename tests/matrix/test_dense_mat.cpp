@@ -24,7 +24,7 @@ static_assert(lmat::meta::is_mat_xpr<lmat::dense_matrix<double> >::value, "Inter
 static_assert(lmat::meta::is_regular_mat<lmat::dense_matrix<double> >::value, "Interface verification failed.");
 
 
-template<int M, int N>
+template<index_t M, index_t N>
 inline void verify_layout(const dense_matrix<double, M, N>& a, index_t m, index_t n)
 {
 	ASSERT_EQ(a.nrows(), m);
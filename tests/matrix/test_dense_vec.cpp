@@ -38,7 +38,7 @@ static_assert(std::is_base_of<
 		lmat::dense_row<double, 4> >::value, "Base verification failed.");
 
 
-template<int M, int N>
+template<index_t M, index_t N>
 inline void verify_layout(const dense_matrix<double, M, N>& a, index_t m, index_t n)
 {
 	ASSERT_EQ(a.nrows(), m);
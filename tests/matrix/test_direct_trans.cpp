@@ -12,7 +12,7 @@
 #include <light_mat/matrix/matrix_transpose.h>
 
 
-template<class Tag1, class Tag2, int M, int N>
+template<class Tag1, class Tag2, index_t M, index_t N>
 void test_direct_trans()
 {
 	const index_t m = M == 0 ? DM : M;
@@ -88,3 +88,112 @@ TEST_DIRECT_TRANS( grid, grid, grid_to_grid )
 
 
 
+
+
+// sizes spanning several tiles of the blocked transposition,
+// with partial register blocks on both dimensions
+
+template<typename T, class SMat, class DMat>
+bool verify_trans(index_t m, index_t n, const SMat& smat, const DMat& dmat)
+{
+	for (index_t i = 0; i < m; ++i)
+	{
+		for (index_t j = 0; j < n; ++j)
+		{
+			if (dmat(j, i) != smat(i, j)) return false;
+		}
+	}
+	return true;
+}
+
+T_CASE( direct_trans_large )
+{
+	const index_t ms[3] = {37, 300, 259};
+	const index_t ns[3] = {300, 37, 261};
+
+	for (int k = 0; k < 3; ++k)
+	{
+		const index_t m = ms[k];
+		const index_t n = ns[k];
+
+		dense_matrix<T> a(m, n);
+		for (index_t i = 0; i < m * n; ++i) a[i] = T(i + 1);
+
+		dense_matrix<T> b(n, m, zero());
+		transpose(a, b);
+		ASSERT_TRUE( (verify_trans<T>(m, n, a, b)) );
+
+		// percol-contiguous
+
+		dense_matrix<T> sa(m + 3, n);
+		dense_matrix<T> sb(n + 5, m, zero());
+		for (index_t i = 0; i < (m + 3) * n; ++i) sa[i] = T(i + 1);
+
+		cref_block<T> ra(sa.ptr_data() + 1, m, n, m + 3);
+		ref_block<T> rb(sb.ptr_data() + 2, n, m, n + 5);
+
+		transpose(ra, rb);
+		ASSERT_TRUE( (verify_trans<T>(m, n, ra, rb)) );
+	}
+}
+
+AUTO_TPACK( direct_trans_large )
+{
+	ADD_T_CASE( direct_trans_large, float )
+	ADD_T_CASE( direct_trans_large, double )
+	ADD_T_CASE( direct_trans_large, int )
+}
+
+
+// in-place transposition
+
+T_CASE( inplace_trans )
+{
+	const int nc = 9;
+	const index_t ms[nc] = {1, 7, 16, 37, 259, 3, 37, 300, 1};
+	const index_t ns[nc] = {1, 7, 16, 37, 259, 5, 300, 37, 9};
+
+	for (int k = 0; k < nc; ++k)
+	{
+		const index_t m = ms[k];
+		const index_t n = ns[k];
+
+		dense_matrix<T> a0(m, n);
+		for (index_t i = 0; i < m * n; ++i) a0[i] = T(i + 1);
+
+		dense_matrix<T> a(a0);
+		const T *p = a.ptr_data();
+
+		transpose_inplace(a);
+
+		ASSERT_EQ( a.nrows(), n );
+		ASSERT_EQ( a.ncolumns(), m );
+		ASSERT_TRUE( a.ptr_data() == p );
+		ASSERT_TRUE( (verify_trans<T>(m, n, a0, a)) );
+
+		dense_matrix<T> b(a0);
+		ref_matrix<T> rb(b.ptr_data(), m, n);
+
+		transpose_inplace(rb);
+
+		ASSERT_EQ( rb.nrows(), n );
+		ASSERT_EQ( rb.ncolumns(), m );
+		ASSERT_TRUE( (verify_trans<T>(m, n, a0, rb)) );
+	}
+
+	// fixed size
+
+	dense_matrix<T, 5, 5> f0;
+	for (index_t i = 0; i < 25; ++i) f0[i] = T(i + 1);
+
+	dense_matrix<T, 5, 5> f(f0);
+	transpose_inplace(f);
+	ASSERT_TRUE( (verify_trans<T>(5, 5, f0, f)) );
+}
+
+AUTO_TPACK( inplace_trans )
+{
+	ADD_T_CASE( inplace_trans, float )
+	ADD_T_CASE( inplace_trans, double )
+	ADD_T_CASE( inplace_trans, int )
+}
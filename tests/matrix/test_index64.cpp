@@ -0,0 +1,205 @@
+/**
+ * @file test_index64.cpp
+ *
+ * @brief Unit testing of the 64-bit index configuration
+ *
+ * This test is always compiled with a 64-bit index_t, whatever
+ * the configuration of the other tests.
+ *
+ * @author Dahua Lin
+ */
+
+#ifndef LMAT_USE_NATIVE_BLAS
+#define LMAT_USE_NATIVE_BLAS
+#endif
+
+#include "../test_base.h"
+
+#include <light_mat/matrix/matrix_classes.h>
+#include <light_mat/matexpr/mat_arith.h>
+#include <light_mat/mateval/mat_reduce.h>
+#include <light_mat/linalg/blas_l3.h>
+#include <light_mat/random/rand_expr.h>
+#include <light_mat/common/parallel.h>
+
+using namespace lmat;
+using namespace lmat::test;
+
+static_assert(sizeof(index_t) == 8, "index_t must be 64-bit in this test.");
+static_assert(sizeof(blas_int) == 8, "blas_int must be 64-bit in this test.");
+
+// a matrix of 50000 x 50000 has more than 2^31 elements
+
+const index_t BM = 50000;
+const index_t BN = 50000;
+const index_t BL = BM * BN;
+
+const index_t DM = 13;
+const index_t DN = 10;
+
+
+// dense matrices are evaluated with linear access
+
+static_assert(std::is_same<
+		preferred_macc_policy<matrix_shape<0, 0>, copy_kernel<double>,
+			arg_wrap<dense_matrix<double>, atags::in>,
+			arg_wrap<dense_matrix<double>, atags::out> >::access,
+		linear_>::value, "Policy verification failed.");
+
+
+SIMPLE_CASE( index64_shape )
+{
+	ASSERT_EQ( BL, index_t(2500000000LL) );
+
+	matrix_shape<0, 0> s(BM, BN);
+	ASSERT_EQ( s.nrows(), BM );
+	ASSERT_EQ( s.ncolumns(), BN );
+	ASSERT_EQ( s.nelems(), BL );
+
+	matrix_shape<0, BN> s1(BM, BN);
+	ASSERT_EQ( s1.nelems(), BL );
+
+	// the length of linear evaluation
+	dimension<0> dim(s.nrows() * s.ncolumns());
+	ASSERT_EQ( dim.value(), BL );
+}
+
+
+SIMPLE_CASE( index64_layout )
+{
+	const index_t i = BM - 1;
+	const index_t j = BN - 1;
+	const index_t ldim = BM + 7;
+
+	cont_layout_cm<0, 0> a(BM, BN);
+	ASSERT_EQ( a.nelems(), BL );
+	ASSERT_EQ( a.offset(i, j), i + j * BM );
+	ASSERT_EQ( a.col_offset(j), j * BM );
+	ASSERT_EQ( a.lin_offset(BL - 1), BL - 1 );
+
+	block_layout_cm<0, 0> b(BM, BN, ldim);
+	ASSERT_EQ( b.nelems(), BL );
+	ASSERT_EQ( b.offset(i, j), i + j * ldim );
+	ASSERT_EQ( b.col_offset(j), j * ldim );
+
+	grid_layout<0, 0> g(BM, BN, 2, 2 * ldim);
+	ASSERT_EQ( g.offset(i, j), 2 * i + j * (2 * ldim) );
+
+	cont_layout_rm<0, 0> ar(BM, BN);
+	ASSERT_EQ( ar.offset(i, j), i * BN + j );
+	ASSERT_EQ( ar.row_offset(i), i * BN );
+
+	block_layout_rm<0, 0> br(BM, BN, ldim);
+	ASSERT_EQ( br.offset(i, j), i * ldim + j );
+	ASSERT_EQ( br.row_offset(i), i * ldim );
+}
+
+
+SIMPLE_CASE( index64_partition )
+{
+	const index_t nc = 7;
+	par_partition p = par_even_partition(BL, nc, 8);
+
+	ASSERT_EQ( p.length(), BL );
+	ASSERT_EQ( p.nchunks(), nc );
+
+	index_t e = 0;
+	for (index_t k = 0; k < p.nchunks(); ++k)
+	{
+		ASSERT_EQ( p.chunk_begin(k), e );
+		ASSERT_EQ( p.chunk_begin(k) % 8, 0 );
+		e += p.chunk_length(k);
+	}
+	ASSERT_EQ( e, BL );
+}
+
+
+SIMPLE_CASE( index64_eval )
+{
+	const index_t m = DM;
+	const index_t n = DN;
+
+	dense_matrix<double> a(m, n), b(m, n);
+	for (index_t i = 0; i < m * n; ++i)
+	{
+		a[i] = double(i + 1);
+		b[i] = double(2 * i + 3);
+	}
+
+	dense_matrix<double> r(m, n);
+	for (index_t i = 0; i < m * n; ++i) r[i] = a[i] * 2.0 + b[i];
+
+	dense_matrix<double> c = a * 2.0 + b;
+	ASSERT_MAT_EQ( m, n, c, r );
+
+	double s = 0.0;
+	for (index_t i = 0; i < m * n; ++i) s += r[i];
+	ASSERT_APPROX( sum(c), s, 1.0e-12 );
+
+	dense_matrix<double> d(m, n, zero());
+	ref_block<double> db(d.ptr_data(), m - 2, n, m);
+	db = cref_block<double>(a.ptr_data(), m - 2, n, m);
+	ASSERT_EQ( d(m - 3, n - 1), a(m - 3, n - 1) );
+	ASSERT_EQ( d(m - 1, n - 1), 0.0 );
+}
+
+
+SIMPLE_CASE( index64_gemm )
+{
+	const index_t m = DM;
+	const index_t n = DN;
+	const index_t k = 9;
+
+	dense_matrix<double> a(m, k), b(k, n);
+	for (index_t i = 0; i < m * k; ++i) a[i] = double(i % 5) - 2.0;
+	for (index_t i = 0; i < k * n; ++i) b[i] = double(i % 7) - 3.0;
+
+	dense_matrix<double> r(m, n);
+	for (index_t j = 0; j < n; ++j)
+	{
+		for (index_t i = 0; i < m; ++i)
+		{
+			double s = 0.0;
+			for (index_t l = 0; l < k; ++l) s += a(i, l) * b(l, j);
+			r(i, j) = s;
+		}
+	}
+
+	dense_matrix<double> c(m, n, zero());
+	blas::gemm(a, b, c);
+	ASSERT_MAT_APPROX( m, n, c, r, 1.0e-12 );
+}
+
+
+SIMPLE_CASE( index64_rand )
+{
+	const index_t m = DM;
+	const index_t n = DN;
+	const unsigned int seed = 4321;
+
+	random::default_rand_stream rs;
+	random::std_uniform_real_distr<double> distr;
+
+	rs.set_seed(seed);
+	dense_matrix<double> r(m, n);
+	for (index_t i = 0; i < m * n; ++i) r[i] = distr(rs);
+
+	rs.set_seed(seed);
+	dense_matrix<double> x = randu(rs, m, n);
+	ASSERT_MAT_EQ( m, n, x, r );
+}
+
+
+AUTO_TPACK( index64_basics )
+{
+	ADD_SIMPLE_CASE( index64_shape )
+	ADD_SIMPLE_CASE( index64_layout )
+	ADD_SIMPLE_CASE( index64_partition )
+}
+
+AUTO_TPACK( index64_eval )
+{
+	ADD_SIMPLE_CASE( index64_eval )
+	ADD_SIMPLE_CASE( index64_gemm )
+	ADD_SIMPLE_CASE( index64_rand )
+}
@@ -15,7 +15,7 @@ using namespace lmat;
 using namespace lmat::test;
 
 
-template<class STag, int M, int N>
+template<class STag, index_t M, index_t N>
 void test_ascol_view()
 {
 	const index_t m = M == 0 ? DM : M;
@@ -66,7 +66,7 @@ void test_ascol_view()
 }
 
 
-template<class STag, int M, int N>
+template<class STag, index_t M, index_t N>
 void test_asrow_view()
 {
 	const index_t m = M == 0 ? DM : M;
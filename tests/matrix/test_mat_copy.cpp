@@ -21,7 +21,7 @@ using namespace lmat::test;
 // Auxiliary classes
 
 
-template<typename STag, typename DTag, int M, int N>
+template<typename STag, typename DTag, index_t M, index_t N>
 void test_matrix_copy()
 {
 	const index_t m = M == 0 ? 3 : M;
@@ -43,7 +43,7 @@ void test_matrix_copy()
 }
 
 
-template<typename DTag, int M, int N>
+template<typename DTag, index_t M, index_t N>
 void test_matrix_import()
 {
 	const index_t m = M == 0 ? 3 : M;
@@ -65,7 +65,7 @@ void test_matrix_import()
 }
 
 
-template<typename STag, int M, int N>
+template<typename STag, index_t M, index_t N>
 void test_matrix_export()
 {
 	const index_t m = M == 0 ? 3 : M;
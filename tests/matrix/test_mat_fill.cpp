@@ -38,7 +38,7 @@ bool verify_all_equal(const Mat& mat, const T& v)
 }
 
 
-template<typename DTag, int M, int N>
+template<typename DTag, index_t M, index_t N>
 void test_matrix_zero()
 {
 	const index_t m = M == 0 ? 3 : M;
@@ -55,7 +55,7 @@ void test_matrix_zero()
 }
 
 
-template<typename DTag, int M, int N>
+template<typename DTag, index_t M, index_t N>
 void test_matrix_fill()
 {
 	const index_t m = M == 0 ? 3 : M;
@@ -16,7 +16,7 @@ using namespace lmat;
 using namespace lmat::test;
 
 
-template<class MTag, int M, int N>
+template<class MTag, index_t M, index_t N>
 void test_matrix_matiter()
 {
 	typedef mat_host<MTag, double, M, N> host_t;
@@ -48,7 +48,7 @@ void test_matrix_matiter()
 }
 
 
-template<class MTag, int M, int N>
+template<class MTag, index_t M, index_t N>
 void test_matrix_coliter()
 {
 	typedef mat_host<MTag, double, M, N> host_t;
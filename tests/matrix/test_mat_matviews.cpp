@@ -30,10 +30,10 @@ const index_t rs = 2;
 const index_t cs = 15;
 const index_t LDim = 15;
 
-template<template<typename T, int R, int C> class ClassT, int M, int N>
+template<template<typename T, index_t R, index_t C> class ClassT, index_t M, index_t N>
 struct mat_maker;
 
-template<int M, int N>
+template<index_t M, index_t N>
 struct mat_maker<ref_matrix, M, N>
 {
 	typedef cref_matrix<double, M, N> cmat_t;
@@ -55,7 +55,7 @@ struct mat_maker<ref_matrix, M, N>
 	}
 };
 
-template<int M, int N>
+template<index_t M, index_t N>
 struct mat_maker<ref_block, M, N>
 {
 	typedef cref_block<double, M, N> cmat_t;
@@ -77,7 +77,7 @@ struct mat_maker<ref_block, M, N>
 	}
 };
 
-template<int M, int N>
+template<index_t M, index_t N>
 struct mat_maker<ref_grid, M, N>
 {
 	typedef cref_grid<double, M, N> cmat_t;
@@ -163,7 +163,7 @@ mat_f64 extract_submat(const Mat& mat, const RowRgn& r, const ColRgn& c)
 }
 
 
-template<template<typename T, int R, int C> class ClassT,
+template<template<typename T, index_t R, index_t C> class ClassT,
 	class RowRgn, class ColRgn, int M, int N>
 void test_mat_range()
 {
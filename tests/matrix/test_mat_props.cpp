@@ -57,7 +57,7 @@ MN_CASE( mat_ct_layout )
 
 // compatible rows
 
-template<int M, int N>
+template<index_t M, index_t N>
 struct binary_compatible_nrows
 {
 	typedef dense_matrix<double, M, 1> A1;
@@ -66,7 +66,7 @@ struct binary_compatible_nrows
 	static const bool value = meta::have_compatible_nrows<A1, A2>::value;
 };
 
-template<int M, int N, int K>
+template<index_t M, index_t N, index_t K>
 struct ternary_compatible_nrows
 {
 	typedef dense_matrix<double, M, 1> A1;
@@ -77,7 +77,7 @@ struct ternary_compatible_nrows
 };
 
 
-template<int M>
+template<index_t M>
 struct unary_common_nrows
 {
 	typedef dense_matrix<double, M, 1> A1;
@@ -85,7 +85,7 @@ struct unary_common_nrows
 	static const int value = meta::common_nrows<A1>::value;
 };
 
-template<int M, int N>
+template<index_t M, index_t N>
 struct binary_common_nrows
 {
 	typedef dense_matrix<double, M, 1> A1;
@@ -94,7 +94,7 @@ struct binary_common_nrows
 	static const int value = meta::common_nrows<A1, A2>::value;
 };
 
-template<int M, int N, int K>
+template<index_t M, index_t N, index_t K>
 struct ternary_common_nrows
 {
 	typedef dense_matrix<double, M, 1> A1;
@@ -205,7 +205,7 @@ SIMPLE_CASE( mat_ct_common_nrows )
 
 // compatible cols
 
-template<int M, int N>
+template<index_t M, index_t N>
 struct binary_compatible_ncols
 {
 	typedef dense_matrix<double, 1, M> A1;
@@ -214,7 +214,7 @@ struct binary_compatible_ncols
 	static const bool value = meta::have_compatible_ncols<A1, A2>::value;
 };
 
-template<int M, int N, int K>
+template<index_t M, index_t N, index_t K>
 struct ternary_compatible_ncols
 {
 	typedef dense_matrix<double, 1, M> A1;
@@ -225,7 +225,7 @@ struct ternary_compatible_ncols
 };
 
 
-template<int M>
+template<index_t M>
 struct unary_common_ncols
 {
 	typedef dense_matrix<double, 1, M> A1;
@@ -233,7 +233,7 @@ struct unary_common_ncols
 	static const int value = meta::common_ncols<A1>::value;
 };
 
-template<int M, int N>
+template<index_t M, index_t N>
 struct binary_common_ncols
 {
 	typedef dense_matrix<double, 1, M> A1;
@@ -242,7 +242,7 @@ struct binary_common_ncols
 	static const int value = meta::common_ncols<A1, A2>::value;
 };
 
-template<int M, int N, int K>
+template<index_t M, index_t N, index_t K>
 struct ternary_common_ncols
 {
 	typedef dense_matrix<double, 1, M> A1;
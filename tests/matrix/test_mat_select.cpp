@@ -21,7 +21,7 @@ const index_t DN = 8;
 const index_t LDim = 12;
 
 
-template<int M, int N>
+template<index_t M, index_t N>
 void fill_ran(dense_matrix<double, M, N>& X)
 {
 	for (index_t i = 0; i < X.nelems(); ++i)
@@ -30,7 +30,7 @@ void fill_ran(dense_matrix<double, M, N>& X)
 	}
 }
 
-template<int M, int N>
+template<index_t M, index_t N>
 void fill_randi(dense_matrix<index_t, M, N>& X, index_t U)
 {
 	for (index_t i = 0; i < X.nelems(); ++i)
@@ -30,10 +30,10 @@ const index_t rs = 2;
 const index_t cs = 15;
 const index_t LDim = 15;
 
-template<template<typename T, int R, int C> class ClassT, int M, int N>
+template<template<typename T, index_t R, index_t C> class ClassT, index_t M, index_t N>
 struct mat_maker;
 
-template<int M, int N>
+template<index_t M, index_t N>
 struct mat_maker<ref_matrix, M, N>
 {
 	typedef cref_matrix<double, M, N> cmat_t;
@@ -55,7 +55,7 @@ struct mat_maker<ref_matrix, M, N>
 	}
 };
 
-template<int M, int N>
+template<index_t M, index_t N>
 struct mat_maker<ref_block, M, N>
 {
 	typedef cref_block<double, M, N> cmat_t;
@@ -77,7 +77,7 @@ struct mat_maker<ref_block, M, N>
 	}
 };
 
-template<int M, int N>
+template<index_t M, index_t N>
 struct mat_maker<ref_grid, M, N>
 {
 	typedef cref_grid<double, M, N> cmat_t;
@@ -194,7 +194,7 @@ col_f64 extract_diag(const Mat& mat)
 
 
 
-template<template<typename T, int R, int C> class ClassT, int M, int N>
+template<template<typename T, index_t R, index_t C> class ClassT, index_t M, index_t N>
 void test_col_view()
 {
 	const index_t m = M == 0 ? DM : M;
@@ -233,7 +233,7 @@ void test_col_view()
 }
 
 
-template<template<typename T, int R, int C> class ClassT, class Rgn, int M, int N>
+template<template<typename T, index_t R, index_t C> class ClassT, class Rgn, index_t M, index_t N>
 void test_col_range()
 {
 	const index_t m = M == 0 ? DM : M;
@@ -275,7 +275,7 @@ void test_col_range()
 }
 
 
-template<template<typename T, int R, int C> class ClassT, int M, int N>
+template<template<typename T, index_t R, index_t C> class ClassT, index_t M, index_t N>
 void test_row_view()
 {
 	const index_t m = M == 0 ? DM : M;
@@ -314,7 +314,7 @@ void test_row_view()
 }
 
 
-template<template<typename T, int R, int C> class ClassT, class Rgn, int M, int N>
+template<template<typename T, index_t R, index_t C> class ClassT, class Rgn, index_t M, index_t N>
 void test_row_range()
 {
 	const index_t m = M == 0 ? DM : M;
@@ -356,7 +356,7 @@ void test_row_range()
 }
 
 
-template<template<typename T, int R, int C> class ClassT, class Rgn, int M>
+template<template<typename T, index_t R, index_t C> class ClassT, class Rgn, index_t M>
 void test_col_vrange()
 {
 	const index_t m = M == 0 ? DM : M;
@@ -394,7 +394,7 @@ void test_col_vrange()
 }
 
 
-template<template<typename T, int R, int C> class ClassT, class Rgn, int N>
+template<template<typename T, index_t R, index_t C> class ClassT, class Rgn, index_t N>
 void test_row_vrange()
 {
 	const index_t n = N == 0 ? DN : N;
@@ -432,7 +432,7 @@ void test_row_vrange()
 }
 
 
-template<template<typename T, int R, int C> class ClassT, int M, int N>
+template<template<typename T, index_t R, index_t C> class ClassT, index_t M, index_t N>
 void test_diag_view()
 {
 	const index_t m = M == 0 ? DM : M;
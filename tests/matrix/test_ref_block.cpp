@@ -37,7 +37,7 @@ static_assert(lmat::meta::is_regular_mat<lmat::ref_block<double> >::value, "Inte
 
 
 
-template<int M, int N>
+template<index_t M, index_t N>
 inline void verify_layout(const cref_block<double, M, N>& mat,
 		index_t m, index_t n, index_t ldim)
 {
@@ -48,7 +48,7 @@ inline void verify_layout(const cref_block<double, M, N>& mat,
 	ASSERT_EQ( mat.col_stride(), ldim );
 }
 
-template<int M, int N>
+template<index_t M, index_t N>
 inline void verify_layout(const ref_block<double, M, N>& mat,
 		index_t m, index_t n, index_t ldim)
 {
@@ -34,7 +34,7 @@ static_assert(lmat::meta::is_mat_xpr<lmat::ref_grid<double> >::value, "Interface
 static_assert(lmat::meta::is_regular_mat<lmat::ref_grid<double> >::value, "Interface verification failed.");
 
 
-template<int M, int N>
+template<index_t M, index_t N>
 inline void verify_layout(const cref_grid<double, M, N>& mat,
 		index_t m, index_t n, index_t rs, index_t cs)
 {
@@ -45,7 +45,7 @@ inline void verify_layout(const cref_grid<double, M, N>& mat,
 	ASSERT_EQ( mat.col_stride(), cs );
 }
 
-template<int M, int N>
+template<index_t M, index_t N>
 inline void verify_layout(const ref_grid<double, M, N>& mat,
 		index_t m, index_t n, index_t rs, index_t cs)
 {
@@ -34,7 +34,7 @@ static_assert(lmat::meta::is_mat_xpr<lmat::ref_matrix<double> >::value, "Interfa
 static_assert(lmat::meta::is_regular_mat<lmat::ref_matrix<double> >::value, "Interface verification failed.");
 
 
-template<int M, int N>
+template<index_t M, index_t N>
 inline void verify_layout(const cref_matrix<double, M, N>& a, index_t m, index_t n)
 {
 	ASSERT_EQ(a.nrows(), m);
@@ -44,7 +44,7 @@ inline void verify_layout(const cref_matrix<double, M, N>& a, index_t m, index_t
 	ASSERT_EQ(a.col_stride(), m);
 }
 
-template<int M, int N>
+template<index_t M, index_t N>
 inline void verify_layout(const ref_matrix<double, M, N>& a, index_t m, index_t n)
 {
 	ASSERT_EQ(a.nrows(), m);
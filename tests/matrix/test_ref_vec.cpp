@@ -45,7 +45,7 @@ static_assert(std::is_base_of<
 		lmat::ref_row<double, 4> >::value, "Base verification failed.");
 
 
-template<int M, int N>
+template<index_t M, index_t N>
 inline void verify_layout(const cref_matrix<double, M, N>& a, index_t m, index_t n)
 {
 	ASSERT_EQ(a.nrows(), m);
@@ -55,7 +55,7 @@ inline void verify_layout(const cref_matrix<double, M, N>& a, index_t m, index_t
 	ASSERT_EQ(a.col_stride(), m);
 }
 
-template<int M, int N>
+template<index_t M, index_t N>
 inline void verify_layout(const ref_matrix<double, M, N>& a, index_t m, index_t n)
 {
 	ASSERT_EQ(a.nrows(), m);
@@ -32,7 +32,7 @@ void fill_lin(Mat& A)
 }
 
 
-template<class Tag1, class Tag2, int M, int N>
+template<class Tag1, class Tag2, index_t M, index_t N>
 void test_mat_transpose()
 {
 	const index_t m = M == 0 ? DM : M;
@@ -118,10 +118,10 @@ struct cont {};
 struct bloc {};
 struct grid {};
 
-template<typename Tag, typename VT, int M, int N>
+template<typename Tag, typename VT, index_t M, index_t N>
 class mat_host;
 
-template<typename VT, int M, int N>
+template<typename VT, index_t M, index_t N>
 class mat_host<cont, VT, M, N> : public mat_host_base<VT>
 {
 public:
@@ -146,7 +146,7 @@ private:
 	dblock<VT> m_blk;
 };
 
-template<typename VT, int M, int N>
+template<typename VT, index_t M, index_t N>
 class mat_host<bloc, VT, M, N> : public mat_host_base<VT>
 {
 public:
@@ -172,7 +172,7 @@ private:
 };
 
 
-template<typename VT, int M, int N>
+template<typename VT, index_t M, index_t N>
 class mat_host<grid, VT, M, N> : public mat_host_base<VT>
 {
 public:
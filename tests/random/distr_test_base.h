@@ -142,6 +142,46 @@ void test_real_rng_simd(const Distr& distr, RStream& rs, Kind,
 }
 
 
+// draws n values (a multiple of the pack width) with the SIMD generator
+
+template<class Distr, class RStream, typename Kind>
+void draw_rng_simd(const Distr& distr, RStream& rs, Kind, index_t n, typename Distr::result_type *dst)
+{
+	typedef typename Distr::result_type T;
+	const index_t W = (index_t)simd_traits<T, Kind>::pack_width;
+
+	auto distr_ = simdize_map<Distr, Kind>::get(distr);
+
+	for (index_t i = 0; i < n; i += W)
+	{
+		distr_(rs).store_u(dst + i);
+	}
+}
+
+// compares the empirical CDF at the given points with the expected values
+
+template<typename T>
+void test_real_cdf(index_t n, const T *x, index_t np, const double *pts, const double *expect_cdf, double ptol)
+{
+	dense_col<double> actual_p(np);
+	dense_col<double> expect_p(np);
+
+	for (index_t k = 0; k < np; ++k)
+	{
+		index_t c = 0;
+		for (index_t i = 0; i < n; ++i)
+		{
+			if (double(x[i]) <= pts[k]) ++c;
+		}
+
+		actual_p[k] = double(c) / double(n);
+		expect_p[k] = expect_cdf[k];
+	}
+
+	ASSERT_VEC_APPROX(np, actual_p, expect_p, ptol);
+}
+
+
 inline double get_p_tol(index_t n)
 {
 	return 5.0 / std::sqrt(double(n));
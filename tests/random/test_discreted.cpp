@@ -8,6 +8,8 @@
 
 #include "distr_test_base.h"
 #include <light_mat/random/discrete_distr.h>
+#include <light_mat/random/philox.h>
+#include <light_mat/common/block.h>
 
 default_rand_stream rstream;
 const index_t N = 200000;
@@ -29,9 +31,201 @@ SIMPLE_CASE( test_discrete_naive )
 	test_discrete_rng(distr, rstream, N, 6, ptol );
 }
 
+
+template<class Distr>
+void verify_discrete_p(const Distr& distr)
+{
+	ASSERT_EQ( distr.n(), 5 );
+	ASSERT_APPROX( distr.p(0), 0.15, 1.0e-15 );
+	ASSERT_APPROX( distr.p(1), 0.30, 1.0e-15 );
+	ASSERT_APPROX( distr.p(2), 0.05, 1.0e-15 );
+	ASSERT_APPROX( distr.p(3), 0.35, 1.0e-15 );
+	ASSERT_APPROX( distr.p(4), 0.15, 1.0e-15 );
+	ASSERT_EQ( distr.p(5), 0.00 );
+}
+
+// the frequencies of the indices filled to a matrix
+
+template<class Distr, class Mat>
+void verify_discrete_freqs(const Distr& distr, const Mat& X, index_t K, double ptol)
+{
+	dense_col<uint32_t> counts(K, zero());
+
+	const index_t m = X.nrows();
+	const index_t n = X.ncolumns();
+
+	for (index_t j = 0; j < n; ++j)
+	{
+		for (index_t i = 0; i < m; ++i)
+		{
+			index_t x = (index_t)X(i, j);
+			ASSERT_TRUE( x >= 0 && x < (index_t)distr.n() );
+			++counts[x];
+		}
+	}
+
+	dense_col<double> actual_p(K), expect_p(K);
+	for (index_t k = 0; k < K; ++k)
+	{
+		actual_p[k] = double(counts[k]) / double(m * n);
+		expect_p[k] = distr.p((typename Distr::result_type)k);
+	}
+
+	ASSERT_VEC_APPROX( K, actual_p, expect_p, ptol );
+}
+
+
+SIMPLE_CASE( test_discrete_alias )
+{
+	discrete_distr<uint32_t, alias_> distr { 0.3, 0.6, 0.1, 0.7, 0.3 };
+	verify_discrete_p(distr);
+
+	double ptol = get_p_tol(N);
+	test_discrete_rng(distr, rstream, N, 6, ptol );
+
+	// zero weights are never drawn
+
+	discrete_distr<uint32_t, alias_> distr0 { 0.0, 2.0, 0.0, 1.0, 1.0, 0.0 };
+	test_discrete_rng(distr0, rstream, N, 7, ptol );
+
+	// a single category
+
+	discrete_distr<uint32_t, alias_> distr1 { 2.5 };
+	for (index_t i = 0; i < 100; ++i) ASSERT_EQ( distr1(rstream), 0 );
+}
+
+SIMPLE_CASE( test_discrete_guide )
+{
+	discrete_distr<uint32_t, guide_table_> distr { 0.3, 0.6, 0.1, 0.7, 0.3 };
+	verify_discrete_p(distr);
+
+	double ptol = get_p_tol(N);
+	test_discrete_rng(distr, rstream, N, 6, ptol );
+}
+
+SIMPLE_CASE( test_discrete_guide_eq_naive )
+{
+	// the guide table only accelerates the search of the naive method
+
+	const index_t K = 1000;
+	dense_col<double> w(K);
+	for (index_t k = 0; k < K; ++k) w[k] = double((k * 37) % 11) * 0.25;
+
+	discrete_distr<uint32_t, naive_> d0(w.ptr_data(), w.ptr_data() + K);
+	discrete_distr<uint32_t, guide_table_> d1(w.ptr_data(), w.ptr_data() + K);
+
+	for (index_t k = 0; k < K; ++k) ASSERT_APPROX( d1.p((uint32_t)k), d0.p((uint32_t)k), 1.0e-12 );
+
+	default_rand_stream rs0(1234);
+	default_rand_stream rs1(1234);
+
+	for (index_t i = 0; i < 10000; ++i)
+	{
+		ASSERT_EQ( d1(rs1), d0(rs0) );
+	}
+}
+
+SIMPLE_CASE( test_discrete_fill )
+{
+	const index_t m = 237;
+	const index_t n = 300;
+	double ptol = get_p_tol(m * n);
+
+	discrete_distr<uint32_t, alias_> distr { 0.3, 0.6, 0.1, 0.7, 0.3 };
+
+	// contiguous
+
+	dense_matrix<uint32_t> X(m, n);
+	rand_fill(distr, rstream, X);
+	verify_discrete_freqs(distr, X, 6, ptol);
+
+	philox_rand_stream prs(5678);
+	rand_fill(distr, prs, X);
+	verify_discrete_freqs(distr, X, 6, ptol);
+
+	// per-column, where the gaps are left untouched
+
+	const index_t ldim = m + 3;
+	const uint32_t c = 99;
+	dblock<uint32_t> s(ldim * n, fill(c));
+	ref_block<uint32_t> Y(s.ptr_data(), m, n, ldim);
+
+	rand_fill(distr, rstream, Y);
+	verify_discrete_freqs(distr, Y, 6, ptol);
+
+	for (index_t j = 0; j < n; ++j)
+	{
+		for (index_t i = m; i < ldim; ++i) ASSERT_EQ( s[i + j * ldim], c );
+	}
+
+	// scalar paths
+
+	dense_matrix<uint64_t> Z(m, n);
+	discrete_distr<uint64_t, alias_> distr_u64 { 0.3, 0.6, 0.1, 0.7, 0.3 };
+	rand_fill(distr_u64, rstream, Z);
+	verify_discrete_freqs(distr_u64, Z, 6, ptol);
+
+	discrete_distr<uint32_t, guide_table_> distr_g { 0.3, 0.6, 0.1, 0.7, 0.3 };
+	rand_fill(distr_g, rstream, X);
+	verify_discrete_freqs(distr_g, X, 6, ptol);
+}
+
+SIMPLE_CASE( test_discrete_fill_large )
+{
+	// many categories, with a few heavy ones
+
+	const index_t K = 100000;
+	dense_col<double> w(K);
+	for (index_t k = 0; k < K; ++k) w[k] = 1.0;
+	w[0] = 20000.0;
+	w[K / 2] = 50000.0;
+	w[K - 1] = 30000.0;
+
+	discrete_distr<uint32_t, alias_> da(w.ptr_data(), w.ptr_data() + K);
+	discrete_distr<uint32_t, guide_table_> dg(w.ptr_data(), w.ptr_data() + K);
+
+	const index_t len = 200003;
+	dense_col<uint32_t> xa(len), xg(len);
+	da.fill(rstream, len, xa.ptr_data());
+	dg.fill(rstream, len, xg.ptr_data());
+
+	index_t ca[3] = {0, 0, 0};
+	index_t cg[3] = {0, 0, 0};
+	const uint32_t hs[3] = { 0, (uint32_t)(K / 2), (uint32_t)(K - 1) };
+
+	for (index_t i = 0; i < len; ++i)
+	{
+		ASSERT_TRUE( xa[i] < (uint32_t)K );
+		ASSERT_TRUE( xg[i] < (uint32_t)K );
+
+		for (int t = 0; t < 3; ++t)
+		{
+			if (xa[i] == hs[t]) ++ca[t];
+			if (xg[i] == hs[t]) ++cg[t];
+		}
+	}
+
+	double ptol = get_p_tol(len);
+	for (int t = 0; t < 3; ++t)
+	{
+		ASSERT_APPROX( double(ca[t]) / double(len), da.p(hs[t]), ptol );
+		ASSERT_APPROX( double(cg[t]) / double(len), dg.p(hs[t]), ptol );
+	}
+}
+
+
 AUTO_TPACK( test_discreted )
 {
 	ADD_SIMPLE_CASE( test_discrete_naive )
+	ADD_SIMPLE_CASE( test_discrete_alias )
+	ADD_SIMPLE_CASE( test_discrete_guide )
+	ADD_SIMPLE_CASE( test_discrete_guide_eq_naive )
+}
+
+AUTO_TPACK( test_discrete_fill )
+{
+	ADD_SIMPLE_CASE( test_discrete_fill )
+	ADD_SIMPLE_CASE( test_discrete_fill_large )
 }
 
 
@@ -132,3 +132,107 @@ AUTO_TPACK( test_exponential )
 }
 
 
+// the empirical CDF and the tail frequency of standard exponential samples
+
+template<typename T>
+void verify_std_exponential_samples(index_t n, const T *x)
+{
+	const index_t np = 7;
+	const double pts[np] = { 0.05, 0.2, 0.5, 1.0, 2.0, 3.0, 5.0 };
+	double expect_cdf[np];
+	for (index_t k = 0; k < np; ++k) expect_cdf[k] = 1.0 - std::exp(-pts[k]);
+
+	test_real_cdf(n, x, np, pts, expect_cdf, get_p_tol(n));
+
+	// beyond the base layer of the ziggurat
+
+	const double r = 7.69711747013104972;
+	index_t c = 0;
+	for (index_t i = 0; i < n; ++i)
+	{
+		ASSERT_TRUE( x[i] >= T(0) );
+		if (double(x[i]) > r) ++c;
+	}
+
+	const double ec = double(n) * std::exp(-r);
+	ASSERT_TRUE( c > 0 );
+	ASSERT_APPROX( double(c), ec, 6.0 * std::sqrt(ec) );
+}
+
+
+T_CASE( test_std_exponential_zig )
+{
+	std_exponential_distr<T, ziggurat_> distr;
+
+	double tol_mean = get_mean_tol(distr, N);
+	double kappa = 6.0;
+	double tol_var = get_var_tol(distr, N, kappa);
+
+	test_real_rng(distr, rstream, N, tol_mean, tol_var);
+
+	dense_col<T> x(N);
+	for (index_t i = 0; i < N; ++i) x[i] = distr(rstream);
+	verify_std_exponential_samples(N, x.ptr_data());
+}
+
+template<typename T, typename Kind>
+void verify_std_exponential_zig_simd(Kind)
+{
+	std_exponential_distr<T, ziggurat_> distr;
+
+	static_assert(is_simdizable<std_exponential_distr<T, ziggurat_>, Kind>::value,
+			"std_exponential_distr (ziggurat_) should be simdizable");
+
+	double tol_mean = get_mean_tol(distr, N);
+	double kappa = 6.0;
+	double tol_var = get_var_tol(distr, N, kappa);
+
+	test_real_rng_simd(distr, rstream, Kind(), N, tol_mean, tol_var);
+
+	dense_col<T> x(N);
+	draw_rng_simd(distr, rstream, Kind(), N, x.ptr_data());
+	verify_std_exponential_samples(N, x.ptr_data());
+}
+
+T_CASE( test_std_exponential_zig_simd )
+{
+	verify_std_exponential_zig_simd<T>(sse_t());
+#ifdef LMAT_HAS_AVX
+	verify_std_exponential_zig_simd<T>(avx_t());
+#endif
+#ifdef LMAT_HAS_AVX512
+	verify_std_exponential_zig_simd<T>(avx512_t());
+#endif
+}
+
+T_CASE( test_exponential_zig )
+{
+	T lambda = T(2);
+	exponential_distr<T, ziggurat_> distr(lambda);
+
+	ASSERT_EQ( distr.lambda(), T(2) );
+	ASSERT_EQ( distr.beta(), T(0.5) );
+
+	double tol_mean = get_mean_tol(distr, N);
+	double kappa = 6.0;
+	double tol_var = get_var_tol(distr, N, kappa);
+
+	test_real_rng(distr, rstream, N, tol_mean, tol_var);
+	test_real_rng_simd(distr, rstream, default_simd_kind(), N, tol_mean, tol_var);
+
+	// with a length that is not a multiple of the pack width
+
+	const index_t n = N + 3;
+	dense_col<T> x(n);
+	distr.fill(rstream, n, x.ptr_data());
+	for (index_t i = 0; i < n; ++i) x[i] *= lambda;
+	verify_std_exponential_samples(n, x.ptr_data());
+}
+
+
+AUTO_TPACK( test_exponential_zig )
+{
+	ADD_T_CASE_FP( test_std_exponential_zig )
+	ADD_T_CASE_FP( test_std_exponential_zig_simd )
+	ADD_T_CASE_FP( test_exponential_zig )
+}
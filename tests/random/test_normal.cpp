@@ -129,3 +129,135 @@ AUTO_TPACK( test_normal_icdf )
 #endif
 }
 
+
+// the empirical CDF and the tail frequency of standard normal samples
+
+template<typename T>
+void verify_std_normal_samples(index_t n, const T *x)
+{
+	const index_t np = 9;
+	const double pts[np] = { -3.0, -2.0, -1.0, -0.3, 0.0, 0.3, 1.0, 2.0, 3.0 };
+	double expect_cdf[np];
+	for (index_t k = 0; k < np; ++k) expect_cdf[k] = 0.5 * std::erfc(-pts[k] / std::sqrt(2.0));
+
+	test_real_cdf(n, x, np, pts, expect_cdf, get_p_tol(n));
+
+	// beyond the base layer of the ziggurat
+
+	const double r = 3.6541528853610088;
+	index_t c = 0;
+	for (index_t i = 0; i < n; ++i)
+	{
+		if (std::fabs(double(x[i])) > r) ++c;
+	}
+
+	const double ec = double(n) * std::erfc(r / std::sqrt(2.0));
+	ASSERT_TRUE( c > 0 );
+	ASSERT_APPROX( double(c), ec, 6.0 * std::sqrt(ec) );
+}
+
+
+T_CASE( test_std_normal_zig )
+{
+	std_normal_distr<T, ziggurat_> distr;
+
+	ASSERT_EQ( distr.mean(), T(0) );
+	ASSERT_EQ( distr.stddev(), T(1) );
+	ASSERT_EQ( distr.var(), T(1) );
+
+	double tol_mean = get_mean_tol(distr, N);
+	double kappa = 0.0;
+	double tol_var = get_var_tol(distr, N, kappa);
+
+	test_real_rng(distr, rstream, N, tol_mean, tol_var);
+
+	dense_col<T> x(N);
+	for (index_t i = 0; i < N; ++i) x[i] = distr(rstream);
+	verify_std_normal_samples(N, x.ptr_data());
+}
+
+template<typename T, typename Kind>
+void verify_std_normal_zig_simd(Kind)
+{
+	std_normal_distr<T, ziggurat_> distr;
+
+	static_assert(is_simdizable<std_normal_distr<T, ziggurat_>, Kind>::value,
+			"std_normal_distr (ziggurat_) should be simdizable");
+
+	double tol_mean = get_mean_tol(distr, N);
+	double kappa = 0.0;
+	double tol_var = get_var_tol(distr, N, kappa);
+
+	test_real_rng_simd(distr, rstream, Kind(), N, tol_mean, tol_var);
+
+	dense_col<T> x(N);
+	draw_rng_simd(distr, rstream, Kind(), N, x.ptr_data());
+	verify_std_normal_samples(N, x.ptr_data());
+}
+
+T_CASE( test_std_normal_zig_simd )
+{
+	verify_std_normal_zig_simd<T>(sse_t());
+#ifdef LMAT_HAS_AVX
+	verify_std_normal_zig_simd<T>(avx_t());
+#endif
+#ifdef LMAT_HAS_AVX512
+	verify_std_normal_zig_simd<T>(avx512_t());
+#endif
+}
+
+T_CASE( test_std_normal_zig_fill )
+{
+	std_normal_distr<T, ziggurat_> distr;
+
+	// with a length that is not a multiple of the pack width
+
+	const index_t n = N + 3;
+	dense_col<T> x(n + 1, fill(T(-100)));
+	distr.fill(rstream, n, x.ptr_data());
+
+	ASSERT_EQ( x[n], T(-100) );
+	verify_std_normal_samples(n, x.ptr_data());
+
+	double s = 0.0, s2 = 0.0;
+	for (index_t i = 0; i < n; ++i)
+	{
+		s += x[i];
+		s2 += math::sqr(double(x[i]));
+	}
+	ASSERT_APPROX( s / n, 0.0, get_mean_tol(distr, n) );
+	ASSERT_APPROX( s2 / n, 1.0, get_var_tol(distr, n, 0.0) );
+}
+
+T_CASE( test_normal_zig )
+{
+	T mu = T(2.5);
+	T sigma = T(2.0);
+	normal_distr<T, ziggurat_> distr(mu, sigma);
+
+	ASSERT_EQ( distr.mean(), mu );
+	ASSERT_EQ( distr.stddev(), sigma );
+
+	double tol_mean = get_mean_tol(distr, N);
+	double kappa = 0.0;
+	double tol_var = get_var_tol(distr, N, kappa);
+
+	test_real_rng(distr, rstream, N, tol_mean, tol_var);
+	test_real_rng_simd(distr, rstream, default_simd_kind(), N, tol_mean, tol_var);
+
+	// standardized fill
+
+	dense_col<T> x(N);
+	distr.fill(rstream, N, x.ptr_data());
+	for (index_t i = 0; i < N; ++i) x[i] = (x[i] - mu) / sigma;
+	verify_std_normal_samples(N, x.ptr_data());
+}
+
+
+AUTO_TPACK( test_normal_zig )
+{
+	ADD_T_CASE_FP( test_std_normal_zig )
+	ADD_T_CASE_FP( test_std_normal_zig_simd )
+	ADD_T_CASE_FP( test_std_normal_zig_fill )
+	ADD_T_CASE_FP( test_normal_zig )
+}
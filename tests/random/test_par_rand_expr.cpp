@@ -0,0 +1,272 @@
+/**
+ * @file test_par_rand_expr.cpp
+ *
+ * @brief Unit testing of the parallel evaluation of random matrix expressions
+ *
+ * @author Dahua Lin
+ */
+
+// use small thresholds and chunks, such that the parallel and
+// chunked code paths are exercised with matrices of moderate sizes
+
+#define LMAT_PAR_MIN_ELEMS 64
+#define LMAT_RAND_CHUNK_ELEMS 200
+
+#include "../test_base.h"
+
+#include <light_mat/random/rand_expr.h>
+#include <light_mat/random/philox.h>
+#include <light_mat/random/sfmt.h>
+#include <light_mat/common/block.h>
+
+using namespace lmat;
+using namespace lmat::random;
+using namespace lmat::test;
+
+const int NUM_TEST_THREADS = 4;
+
+const index_t DM = 37;
+const index_t DN = 23;
+const index_t LDIM_EXTRA = 3;
+
+const unsigned int seed = 4321;
+
+
+// the number of whole columns (or rows) of length len in a chunk
+
+inline index_t rand_chunk_vecs(index_t len)
+{
+	return LMAT_RAND_CHUNK_ELEMS / len;
+}
+
+template<class RStream>
+inline void long_jumps(RStream& rs, index_t k)
+{
+	for (index_t i = 0; i < k; ++i) rs.long_jump();
+}
+
+
+template<typename T, class Distr, class RStream>
+void verify_par_rand_linear(const Distr& distr)
+{
+	set_par_max_threads(NUM_TEST_THREADS);
+
+	const index_t m = DM;
+	const index_t n = DN;
+	const index_t len = m * n;
+
+	RStream rs(seed);
+	dense_matrix<T> R(m, n);
+	macc_evaluate(rand_mat(distr, rs, m, n), R, par_());
+
+	// each chunk is the sequential evaluation from the k-th long jump
+
+	const index_t W = (index_t)simd_traits<T, default_simd_kind>::pack_width;
+	par_partition part(len, LMAT_RAND_CHUNK_ELEMS, is_simdizable<Distr, default_simd_kind>::value ? W : 1);
+	const index_t nc = part.nchunks();
+	ASSERT_TRUE( nc > 1 );
+
+	dense_matrix<T> R_r(m, n);
+	for (index_t k = 0; k < nc; ++k)
+	{
+		RStream rk(seed);
+		long_jumps(rk, k);
+
+		ref_matrix<T> rc(R_r.ptr_data() + part.chunk_begin(k), part.chunk_length(k), 1);
+		rc = rand_mat(distr, rk, part.chunk_length(k), 1);
+	}
+
+	ASSERT_MAT_EQ( m, n, R, R_r );
+
+	// the stream has been moved past all chunks
+
+	RStream r0(seed);
+	long_jumps(r0, nc);
+
+	ASSERT_EQ( rs.rand_u32(), r0.rand_u32() );
+
+	// the chunks draw from different parts of the stream
+
+	ASSERT_NE( R[part.chunk_begin(1)], R[0] );
+}
+
+
+template<typename T, class Distr, class RStream>
+void verify_par_rand_percol(const Distr& distr)
+{
+	set_par_max_threads(NUM_TEST_THREADS);
+
+	const index_t m = DM;
+	const index_t n = DN;
+	const index_t ldim = m + LDIM_EXTRA;
+
+	dblock<T> s(ldim * n, zero());
+	ref_block<T> R(s.ptr_data(), m, n, ldim);
+
+	RStream rs(seed);
+	macc_evaluate(rand_mat(distr, rs, m, n), R, par_());
+
+	par_partition part(n, rand_chunk_vecs(m), 1);
+	ASSERT_TRUE( part.nchunks() > 1 );
+
+	dblock<T> s_r(ldim * n, zero());
+	for (index_t k = 0; k < part.nchunks(); ++k)
+	{
+		RStream rk(seed);
+		long_jumps(rk, k);
+
+		ref_block<T> rc(s_r.ptr_data() + part.chunk_begin(k) * ldim, m, part.chunk_length(k), ldim);
+		rc = rand_mat(distr, rk, m, part.chunk_length(k));
+	}
+
+	ASSERT_VEC_EQ( ldim * n, s, s_r );
+}
+
+
+template<typename T, class Distr, class RStream>
+void verify_par_rand_perrow(const Distr& distr)
+{
+	set_par_max_threads(NUM_TEST_THREADS);
+
+	const index_t m = DM;
+	const index_t n = DN;
+	const index_t ldim = n + LDIM_EXTRA;
+
+	dblock<T> s(ldim * m, zero());
+	ref_block_rm<T> R(s.ptr_data(), m, n, ldim);
+
+	RStream rs(seed);
+	macc_evaluate(rand_mat(distr, rs, m, n), R, par_());
+
+	par_partition part(m, rand_chunk_vecs(n), 1);
+	ASSERT_TRUE( part.nchunks() > 1 );
+
+	dblock<T> s_r(ldim * m, zero());
+	for (index_t k = 0; k < part.nchunks(); ++k)
+	{
+		RStream rk(seed);
+		long_jumps(rk, k);
+
+		ref_block_rm<T> rc(s_r.ptr_data() + part.chunk_begin(k) * ldim, part.chunk_length(k), n, ldim);
+		rc = rand_mat(distr, rk, part.chunk_length(k), n);
+	}
+
+	ASSERT_VEC_EQ( ldim * m, s, s_r );
+}
+
+
+// the same seed gives the same matrix and the same final stream,
+// whatever the number of threads, and in sequential evaluation
+
+template<typename T, class Distr, class RStream, class DMat>
+void verify_rand_thread_invariance(const Distr& distr, DMat& R, DMat& R_r)
+{
+	const index_t m = R.nrows();
+	const index_t n = R.ncolumns();
+
+	RStream rs_r(seed);
+	R_r = rand_mat(distr, rs_r, m, n);
+	const uint32_t u_r = rs_r.rand_u32();
+
+	const int nts[4] = {1, 2, 3, NUM_TEST_THREADS};
+
+	for (int i = 0; i < 4; ++i)
+	{
+		set_par_max_threads(nts[i]);
+
+		RStream rs(seed);
+		macc_evaluate(rand_mat(distr, rs, m, n), R, par_());
+
+		ASSERT_MAT_EQ( m, n, R, R_r );
+		ASSERT_EQ( rs.rand_u32(), u_r );
+	}
+}
+
+template<typename T, class Distr, class RStream>
+void verify_rand_thread_invariance(const Distr& distr)
+{
+	const index_t m = DM;
+	const index_t n = DN;
+
+	// linear, one chunk or several
+
+	dense_matrix<T> A(m, n), A_r(m, n);
+	verify_rand_thread_invariance<T, Distr, RStream>(distr, A, A_r);
+
+	dense_matrix<T> A1(8, 16), A1_r(8, 16);
+	verify_rand_thread_invariance<T, Distr, RStream>(distr, A1, A1_r);
+
+	// per column and per row
+
+	const index_t ldim = m + LDIM_EXTRA;
+	dblock<T> s(ldim * n, zero()), s_r(ldim * n, zero());
+	ref_block<T> B(s.ptr_data(), m, n, ldim), B_r(s_r.ptr_data(), m, n, ldim);
+	verify_rand_thread_invariance<T, Distr, RStream>(distr, B, B_r);
+
+	ref_block_rm<T> C(s.ptr_data(), n, m, ldim), C_r(s_r.ptr_data(), n, m, ldim);
+	verify_rand_thread_invariance<T, Distr, RStream>(distr, C, C_r);
+}
+
+
+T_CASE( par_randu )
+{
+	verify_par_rand_linear<T, std_uniform_real_distr<T>, philox_rand_stream>(std_uniform_real_distr<T>());
+	verify_par_rand_linear<T, std_uniform_real_distr<T>, default_rand_stream>(std_uniform_real_distr<T>());
+}
+
+T_CASE( par_randn )
+{
+	verify_par_rand_linear<T, std_normal_distr<T>, philox_rand_stream>(std_normal_distr<T>());
+	verify_par_rand_linear<T, normal_distr<T>, default_rand_stream>(normal_distr<T>(T(2), T(3)));
+}
+
+T_CASE( par_rande )
+{
+	verify_par_rand_linear<T, exponential_distr<T>, philox_rand_stream>(exponential_distr<T>(T(2)));
+}
+
+T_CASE( par_randg )
+{
+	// not vectorized, and with a varying number of draws per element
+
+	verify_par_rand_linear<T, gamma_distr<T>, philox_rand_stream>(gamma_distr<T>(T(2.5), T(1.5)));
+}
+
+T_CASE( par_rand_percol )
+{
+	verify_par_rand_percol<T, std_normal_distr<T>, philox_rand_stream>(std_normal_distr<T>());
+	verify_par_rand_percol<T, std_uniform_real_distr<T>, default_rand_stream>(std_uniform_real_distr<T>());
+}
+
+T_CASE( par_rand_perrow )
+{
+	verify_par_rand_perrow<T, std_normal_distr<T>, philox_rand_stream>(std_normal_distr<T>());
+}
+
+
+T_CASE( par_rand_threads )
+{
+	verify_rand_thread_invariance<T, std_normal_distr<T>, philox_rand_stream>(std_normal_distr<T>());
+	verify_rand_thread_invariance<T, std_uniform_real_distr<T>, default_rand_stream>(std_uniform_real_distr<T>());
+	verify_rand_thread_invariance<T, gamma_distr<T>, philox_rand_stream>(gamma_distr<T>(T(2.5), T(1.5)));
+}
+
+
+AUTO_TPACK( par_rand_linear )
+{
+	ADD_T_CASE_FP( par_randu )
+	ADD_T_CASE_FP( par_randn )
+	ADD_T_CASE_FP( par_rande )
+	ADD_T_CASE_FP( par_randg )
+}
+
+AUTO_TPACK( par_rand_multicol )
+{
+	ADD_T_CASE_FP( par_rand_percol )
+	ADD_T_CASE_FP( par_rand_perrow )
+}
+
+AUTO_TPACK( par_rand_threads )
+{
+	ADD_T_CASE_FP( par_rand_threads )
+}
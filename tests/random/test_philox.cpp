@@ -0,0 +1,347 @@
+/**
+ * @file test_philox.cpp
+ *
+ * @brief Test of Philox stream
+ *
+ * @author Dahua Lin
+ */
+
+#include "../test_base.h"
+
+#include <light_mat/matrix/matrix_classes.h>
+#include <light_mat/random/philox.h>
+
+using namespace lmat;
+using namespace lmat::random;
+using namespace lmat::test;
+
+
+const index_t vlen = 1000;
+const uint64_t seed0 = 1234;
+
+
+// the i-th unit of the stream, computed directly from the counter
+
+inline uint32_t philox_unit(uint64_t key, uint64_t sid, uint64_t i)
+{
+	const uint64_t b = i / 4;
+	uint32_t x[4] = { (uint32_t)b, (uint32_t)(b >> 32), (uint32_t)sid, (uint32_t)(sid >> 32) };
+	random::internal::philox4x32_10(x, (uint32_t)key, (uint32_t)(key >> 32));
+	return x[i % 4];
+}
+
+
+SIMPLE_CASE( philox_kat )
+{
+	// known-answer tests from the Random123 distribution
+
+	uint32_t x1[4] = { 0, 0, 0, 0 };
+	random::internal::philox4x32_10(x1, 0, 0);
+
+	const uint32_t r1[4] = { 0x6627e8d5U, 0xe169c58dU, 0xbc57ac4cU, 0x9b00dbd8U };
+	ASSERT_VEC_EQ( 4, x1, r1 );
+
+	uint32_t x2[4] = { 0xffffffffU, 0xffffffffU, 0xffffffffU, 0xffffffffU };
+	random::internal::philox4x32_10(x2, 0xffffffffU, 0xffffffffU);
+
+	const uint32_t r2[4] = { 0x408f276dU, 0x41c83b0eU, 0xa20bc7c6U, 0x6d5451fdU };
+	ASSERT_VEC_EQ( 4, x2, r2 );
+
+	uint32_t x3[4] = { 0x243f6a88U, 0x85a308d3U, 0x13198a2eU, 0x03707344U };
+	random::internal::philox4x32_10(x3, 0xa4093822U, 0x299f31d0U);
+
+	const uint32_t r3[4] = { 0xd16cfe09U, 0x94fdccebU, 0x5001e420U, 0x24126ea1U };
+	ASSERT_VEC_EQ( 4, x3, r3 );
+}
+
+
+SIMPLE_CASE( philox_blocks )
+{
+	// the SIMD kernel against the scalar one, with a carry in the counter
+
+	philox_state s(0xa4093822299f31d0ULL, 0x0370734413198a2eULL);
+	const uint64_t c0 = 0xfffffffaULL;
+	s.set_counter(c0);
+	s.next();
+
+	ASSERT_EQ( s.counter(), c0 + philox_state::nblocks );
+
+	for (unsigned int i = 0; i < philox_state::N32; ++i)
+	{
+		ASSERT_EQ( s.u32(i), philox_unit(s.key(), s.substream(), c0 * 4 + i) );
+	}
+}
+
+
+SIMPLE_CASE( philox_u32 )
+{
+	philox_rand_stream rs;
+
+	dense_col<uint32_t> v(vlen), r(vlen);
+	for (index_t i = 0; i < vlen; ++i)
+	{
+		v[i] = rs.rand_u32();
+		r[i] = philox_unit(seed0, 0, (uint64_t)i);
+	}
+	ASSERT_VEC_EQ( vlen, v, r );
+	ASSERT_EQ( rs.position(), (uint64_t)vlen );
+
+	// a different seed or substream gives a different sequence
+
+	philox_rand_stream rs2(seed0, 1);
+	ASSERT_NE( rs2.rand_u32(), r[0] );
+	ASSERT_EQ( rs2.substream(), uint64_t(1) );
+
+	rs2.set_seed(seed0 + 1);
+	ASSERT_NE( rs2.rand_u32(), r[0] );
+	ASSERT_EQ( rs2.position(), uint64_t(1) );
+
+	rs2.set_substream(0);
+	rs2.set_seed(seed0);
+	ASSERT_EQ( rs2.rand_u32(), r[0] );
+}
+
+
+SIMPLE_CASE( philox_u64 )
+{
+	philox_rand_stream rs;
+
+	const index_t n = vlen / 2;
+	for (index_t i = 0; i < n; ++i)
+	{
+		uint64_t x = rs.rand_u64();
+		uint64_t x0 = (uint64_t)philox_unit(seed0, 0, 2 * i) |
+				((uint64_t)philox_unit(seed0, 0, 2 * i + 1) << 32);
+		ASSERT_EQ( x, x0 );
+	}
+
+	rs.set_seed(seed0);
+	rs.rand_u32(); // ignore one unit
+
+	for (index_t i = 1; i < n; ++i)
+	{
+		uint64_t x = rs.rand_u64();
+		uint64_t x0 = (uint64_t)philox_unit(seed0, 0, 2 * i) |
+				((uint64_t)philox_unit(seed0, 0, 2 * i + 1) << 32);
+		ASSERT_EQ( x, x0 );
+	}
+}
+
+
+SIMPLE_CASE( philox_m128 )
+{
+	philox_rand_stream rs;
+
+	LMAT_ALIGN(16) uint32_t x[4];
+	uint32_t x0[4];
+
+	for (index_t o = 0; o < 4; ++o)
+	{
+		rs.set_seed(seed0);
+		for (index_t j = 0; j < o; ++j) rs.rand_u32(); // ignore o units
+
+		const index_t i0 = o > 0 ? 1 : 0;
+		for (index_t i = i0; i < vlen / 4; ++i)
+		{
+			_mm_store_si128(reinterpret_cast<__m128i*>(x), rs.rand_pack(sse_t()));
+			for (index_t k = 0; k < 4; ++k) x0[k] = philox_unit(seed0, 0, (uint64_t)(i * 4 + k));
+
+			ASSERT_VEC_EQ( 4, x, x0 );
+		}
+	}
+}
+
+
+#ifdef LMAT_HAS_AVX
+
+SIMPLE_CASE( philox_m256 )
+{
+	philox_rand_stream rs;
+
+	LMAT_ALIGN(32) uint32_t x[8];
+	uint32_t x0[8];
+
+	for (index_t o = 0; o < 8; ++o)
+	{
+		rs.set_seed(seed0);
+		for (index_t j = 0; j < o; ++j) rs.rand_u32(); // ignore o units
+
+		const index_t i0 = o > 0 ? 1 : 0;
+		for (index_t i = i0; i < vlen / 8; ++i)
+		{
+			_mm256_store_si256(reinterpret_cast<__m256i*>(x), rs.rand_pack(avx_t()));
+			for (index_t k = 0; k < 8; ++k) x0[k] = philox_unit(seed0, 0, (uint64_t)(i * 8 + k));
+
+			ASSERT_VEC_EQ( 8, x, x0 );
+		}
+	}
+}
+
+#endif
+
+#ifdef LMAT_HAS_AVX512
+
+SIMPLE_CASE( philox_m512 )
+{
+	philox_rand_stream rs;
+
+	LMAT_ALIGN(64) uint32_t x[16];
+	uint32_t x0[16];
+
+	for (index_t o = 0; o < 8; ++o)
+	{
+		rs.set_seed(seed0);
+		for (index_t j = 0; j < o; ++j) rs.rand_u32(); // ignore o units
+
+		const index_t s0 = o > 0 ? 8 : 0;
+		for (index_t i = 0; i < vlen / 16 - 1; ++i)
+		{
+			_mm512_store_si512(reinterpret_cast<void*>(x), rs.rand_pack(avx512_t()));
+			for (index_t k = 0; k < 16; ++k) x0[k] = philox_unit(seed0, 0, (uint64_t)(s0 + i * 16 + k));
+
+			ASSERT_VEC_EQ( 16, x, x0 );
+		}
+	}
+}
+
+#endif
+
+
+SIMPLE_CASE( philox_seq )
+{
+	philox_rand_stream rs;
+	const index_t nu = (index_t)philox_state::N32;
+
+	const index_t starts[4] = {0, 3, nu / 4, nu / 2};
+	const index_t lens[6] = {3, nu / 4, nu / 2, nu, (nu * 2 + nu / 2), (nu * 3 + nu / 4) };
+
+	for (int i = 0; i < 4; ++i)
+	{
+		for (int j = 0; j < 6; ++j)
+		{
+			const index_t start = starts[i];
+			const index_t n = lens[j];
+
+			dense_row<uint32_t> x(n, zero());
+			dense_row<uint32_t> x2(n, zero());
+
+			rs.set_seed(seed0);
+			for (index_t k = 0; k < start; ++k) rs.rand_u32();
+			rs.rand_seq((size_t)n * sizeof(uint32_t), x.ptr_data());
+			rs.rand_seq((size_t)n * sizeof(uint32_t), x2.ptr_data());
+
+			for (index_t k = 0; k < n; ++k)
+			{
+				ASSERT_EQ( x[k], philox_unit(seed0, 0, (uint64_t)(start + k)) );
+				ASSERT_EQ( x2[k], philox_unit(seed0, 0, (uint64_t)(start + n + k)) );
+			}
+			ASSERT_EQ( rs.position(), (uint64_t)(start + 2 * n) );
+		}
+	}
+}
+
+
+SIMPLE_CASE( philox_skip )
+{
+	philox_rand_stream rs;
+	const uint64_t nu = philox_state::N32;
+
+	const uint64_t steps[7] = { 0, 1, 5, nu - 1, nu, 3 * nu + 7, 1000003 };
+
+	for (int t = 0; t < 7; ++t)
+	{
+		// skip from the beginning and from the middle of a refresh
+
+		rs.set_seed(seed0);
+		rs.skip(steps[t]);
+		ASSERT_EQ( rs.position(), steps[t] );
+		ASSERT_EQ( rs.rand_u32(), philox_unit(seed0, 0, steps[t]) );
+
+		rs.skip(steps[t]);
+		ASSERT_EQ( rs.position(), 2 * steps[t] + 1 );
+		ASSERT_EQ( rs.rand_u32(), philox_unit(seed0, 0, 2 * steps[t] + 1) );
+	}
+
+	// jump far ahead, across the 32-bit boundary of the block counter
+
+	const uint64_t far = (uint64_t(1) << 34) + 13;
+	rs.seek(far);
+	ASSERT_EQ( rs.position(), far );
+
+	for (uint64_t i = 0; i < 2 * nu; ++i)
+	{
+		ASSERT_EQ( rs.rand_u32(), philox_unit(seed0, 0, far + i) );
+	}
+
+	// a copy continues from the same position
+
+	philox_rand_stream rs2(rs);
+	ASSERT_EQ( rs2.position(), rs.position() );
+	ASSERT_EQ( rs2.rand_u32(), rs.rand_u32() );
+
+	philox_rand_stream rs3;
+	rs3 = rs;
+	ASSERT_EQ( rs3.rand_u64(), rs.rand_u64() );
+}
+
+
+SIMPLE_CASE( philox_partition )
+{
+	// the units drawn by several workers from disjoint parts of
+	// the stream are the same as those drawn sequentially
+
+	const index_t n = 3 * vlen + 17;
+
+	dense_col<uint32_t> r(n);
+	philox_rand_stream rs;
+	rs.rand_seq((size_t)n * sizeof(uint32_t), r.ptr_data());
+
+	const index_t nws[3] = { 2, 3, 7 };
+
+	for (int t = 0; t < 3; ++t)
+	{
+		const index_t nw = nws[t];
+		const index_t clen = (n + nw - 1) / nw;
+
+		dense_col<uint32_t> x(n, zero());
+
+		for (index_t w = 0; w < nw; ++w)
+		{
+			const index_t i0 = w * clen;
+			const index_t i1 = i0 + clen < n ? i0 + clen : n;
+
+			philox_rand_stream rw(seed0);
+			rw.skip((uint64_t)i0);
+			for (index_t i = i0; i < i1; ++i) x[i] = rw.rand_u32();
+		}
+
+		ASSERT_VEC_EQ( n, x, r );
+	}
+}
+
+
+AUTO_TPACK( philox_gen )
+{
+	ADD_SIMPLE_CASE( philox_kat )
+	ADD_SIMPLE_CASE( philox_blocks )
+}
+
+AUTO_TPACK( philox_stream )
+{
+	ADD_SIMPLE_CASE( philox_u32 )
+	ADD_SIMPLE_CASE( philox_u64 )
+	ADD_SIMPLE_CASE( philox_m128 )
+#ifdef LMAT_HAS_AVX
+	ADD_SIMPLE_CASE( philox_m256 )
+#endif
+#ifdef LMAT_HAS_AVX512
+	ADD_SIMPLE_CASE( philox_m512 )
+#endif
+	ADD_SIMPLE_CASE( philox_seq )
+}
+
+AUTO_TPACK( philox_skip )
+{
+	ADD_SIMPLE_CASE( philox_skip )
+	ADD_SIMPLE_CASE( philox_partition )
+}
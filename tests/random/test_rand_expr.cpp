@@ -21,7 +21,7 @@ const unsigned int seed = 4321;
 const index_t DM = 6;
 const index_t DN = 8;
 
-template<class Distr, class RStream, int M, int N>
+template<class Distr, class RStream, index_t M, index_t N>
 inline void check_policy(const rand_expr<Distr, RStream, M, N>& expr)
 {
 	typedef rand_expr<Distr, RStream, M, N> expr_t;
@@ -37,7 +37,7 @@ inline void check_policy(const rand_expr<Distr, RStream, M, N>& expr)
 	ASSERT_EQ( use_simd(policy), expect_usimd );
 }
 
-template<class Distr, class RStream, int M, int N>
+template<class Distr, class RStream, index_t M, index_t N>
 void test_rand_expr(const rand_expr<Distr, RStream, M, N>& expr, Distr& distr0)
 {
 	const index_t m = M == 0 ? DM : M;
@@ -200,6 +200,54 @@ void verify_sfmt_m256()
 
 #endif
 
+#ifdef LMAT_HAS_AVX512
+
+template<unsigned int MEXP>
+void verify_sfmt_m512()
+{
+	sfmt_rand_stream<MEXP> rs;
+
+	dense_col<uint32_t> v32(vlen);
+	for (index_t i = 0; i < vlen; ++i)
+	{
+		v32[i] = rs.rand_u32();
+	}
+
+	rs.set_seed(seed0);
+
+	index_t n = vlen / 16;
+
+	LMAT_ALIGN(64) uint32_t x[16];
+
+	for (index_t i = 0; i < n; ++i)
+	{
+		__m512i p = rs.rand_pack(avx512_t());
+		_mm512_store_si512(reinterpret_cast<void*>(x), p);
+
+		const uint32_t *x0 = &v32[i * 16];
+
+		ASSERT_VEC_EQ( 16, x, x0 );
+	}
+
+	for (index_t o = 1; o < 8; ++o)
+	{
+		rs.set_seed(seed0);
+		for (index_t j = 0; j < o; ++j) rs.rand_u32(); // ignore o units, then start from the 8th
+
+		for (index_t i = 0; i < n-1; ++i)
+		{
+			__m512i p = rs.rand_pack(avx512_t());
+			_mm512_store_si512(reinterpret_cast<void*>(x), p);
+
+			const uint32_t *x0 = &v32[8 + i * 16];
+
+			ASSERT_VEC_EQ(16, x, x0);
+		}
+	}
+}
+
+#endif
+
 
 template<unsigned int MEXP>
 void test_sfmt_randseq(sfmt_rand_stream<MEXP>& rs, index_t ignore, index_t n)  // n units
@@ -284,6 +332,10 @@ DEF_SFMT_TESTS( sfmt_verify_m128, verify_sfmt_m128 )
 DEF_SFMT_TESTS( sfmt_verify_m256, verify_sfmt_m256 )
 #endif
 
+#ifdef LMAT_HAS_AVX512
+DEF_SFMT_TESTS( sfmt_verify_m512, verify_sfmt_m512 )
+#endif
+
 DEF_SFMT_TESTS( sfmt_verify_seq, verify_sfmt_seq )
 
 
@@ -0,0 +1,204 @@
+/**
+ * @file test_sfmt_jump.cpp
+ *
+ * @brief Test of SFMT jump-ahead and substreams
+ *
+ * @author Dahua Lin
+ */
+
+#include "../test_base.h"
+
+#include <light_mat/matrix/matrix_classes.h>
+#include <light_mat/random/sfmt.h>
+
+using namespace lmat;
+using namespace lmat::random;
+using namespace lmat::test;
+
+
+const uint32_t seed0 = 1234;
+
+
+// skips n 32-bit units by drawing them
+
+template<unsigned int MEXP>
+inline void skip_units(sfmt_rand_stream<MEXP>& rs, size_t n)
+{
+	for (size_t i = 0; i < n; ++i) rs.rand_u32();
+}
+
+
+template<unsigned int MEXP>
+void verify_sfmt_minpoly()
+{
+	typedef random::internal::sfmt_params<MEXP> param_t;
+	const random::internal::gf2_poly& phi = sfmt_jump_poly<MEXP>::minpoly();
+
+	// the period 2^MEXP - 1 requires an irreducible factor of degree MEXP
+
+	const size_t d = random::internal::gf2_degree(phi);
+	ASSERT_TRUE( d >= (size_t)MEXP );
+	ASSERT_TRUE( d <= (size_t)(param_t::N * 128) );
+	ASSERT_TRUE( random::internal::gf2_bit(phi, 0) );
+}
+
+
+template<unsigned int MEXP>
+void verify_sfmt_jump()
+{
+	typedef random::internal::sfmt_params<MEXP> param_t;
+	const unsigned int ks[5] = { 0, 1, 5, 8, 12 };
+	const size_t offsets[3] = { 0, 5, param_t::N32 - 3 };
+
+	for (int t = 0; t < 5; ++t)
+	{
+		const unsigned int k = ks[t];
+		const sfmt_jump_poly<MEXP> jp(k);
+		ASSERT_EQ( jp.log2_steps(), k );
+
+		// jump from the seeded state, and from the middle of the buffer
+
+		for (int u = 0; u < 3; ++u)
+		{
+			sfmt_rand_stream<MEXP> rs(seed0);
+			sfmt_rand_stream<MEXP> rs0(seed0);
+
+			skip_units(rs, offsets[u]);
+			skip_units(rs0, offsets[u]);
+
+			rs.jump(jp);
+			skip_units(rs0, size_t(4) << k);
+
+			for (size_t i = 0; i < 2 * param_t::N32; ++i)
+			{
+				ASSERT_EQ( rs.rand_u32(), rs0.rand_u32() );
+			}
+		}
+	}
+}
+
+
+template<unsigned int MEXP>
+void verify_sfmt_jump_far()
+{
+	// two jumps by 2^k steps are the same as one jump by 2^(k+1) steps
+
+	const unsigned int k = 40;
+	const sfmt_jump_poly<MEXP> jp(k);
+	const sfmt_jump_poly<MEXP> jp2(k + 1);
+
+	sfmt_rand_stream<MEXP> rs(seed0);
+	sfmt_rand_stream<MEXP> rs2(seed0);
+	sfmt_rand_stream<MEXP> rs0(seed0);
+
+	rs.rand_u32();
+	rs2.rand_u32();
+	rs0.rand_u32();
+
+	rs.jump(jp);
+	rs.jump(jp);
+	rs2.jump(jp2);
+
+	bool diff = false;
+	for (index_t i = 0; i < 1000; ++i)
+	{
+		uint32_t x = rs.rand_u32();
+		ASSERT_EQ( x, rs2.rand_u32() );
+		if (x != rs0.rand_u32()) diff = true;
+	}
+	ASSERT_TRUE( diff );
+}
+
+
+template<unsigned int MEXP>
+void verify_sfmt_substreams()
+{
+	typedef random::internal::sfmt_params<MEXP> param_t;
+	const size_t ns = 4;
+	const unsigned int k = 10;
+
+	sfmt_rand_stream<MEXP> streams[ns];
+	init_substreams(seed0, k, ns, streams);
+
+	for (size_t i = 0; i < ns; ++i)
+	{
+		sfmt_rand_stream<MEXP> rs0(seed0);
+		skip_units(rs0, (size_t(4) << k) * i);
+
+		for (size_t j = 0; j < 3 * param_t::N32; ++j)
+		{
+			ASSERT_EQ( streams[i].rand_u32(), rs0.rand_u32() );
+		}
+	}
+
+	// copies continue from the same position
+
+	sfmt_rand_stream<MEXP> rs1(streams[1]);
+	sfmt_rand_stream<MEXP> rs2;
+	rs2 = streams[2];
+
+	for (size_t j = 0; j < param_t::N32 + 7; ++j)
+	{
+		ASSERT_EQ( rs1.rand_u32(), streams[1].rand_u32() );
+		ASSERT_EQ( rs2.rand_u32(), streams[2].rand_u32() );
+	}
+
+	// far apart substreams
+
+	sfmt_rand_stream<MEXP> fs[3];
+	init_substreams(seed0, 64, 3, fs);
+
+	const sfmt_jump_poly<MEXP> jp(64);
+	sfmt_rand_stream<MEXP> rs0(seed0);
+	rs0.jump(jp);
+	rs0.jump(jp);
+
+	for (size_t j = 0; j < 2 * param_t::N32; ++j)
+	{
+		ASSERT_EQ( fs[2].rand_u32(), rs0.rand_u32() );
+	}
+}
+
+
+#define DEF_SFMT_TESTS( packname, tfunname ) \
+		SIMPLE_CASE( packname##_1279 ) { tfunname<1279>(); } \
+		SIMPLE_CASE( packname##_2281 ) { tfunname<2281>(); } \
+		SIMPLE_CASE( packname##_4253 ) { tfunname<4253>(); } \
+		SIMPLE_CASE( packname##_11213 ) { tfunname<11213>(); } \
+		SIMPLE_CASE( packname##_19937 ) { tfunname<19937>(); } \
+		SIMPLE_CASE( packname##_44497 ) { tfunname<44497>(); } \
+		SIMPLE_CASE( packname##_86243 ) { tfunname<86243>(); } \
+		SIMPLE_CASE( packname##_132049 ) { tfunname<132049>(); } \
+		AUTO_TPACK( packname ) { \
+			ADD_SIMPLE_CASE( packname##_1279 ) \
+			ADD_SIMPLE_CASE( packname##_2281 ) \
+			ADD_SIMPLE_CASE( packname##_4253 ) \
+			ADD_SIMPLE_CASE( packname##_11213 ) \
+			ADD_SIMPLE_CASE( packname##_19937 ) \
+			ADD_SIMPLE_CASE( packname##_44497 ) \
+			ADD_SIMPLE_CASE( packname##_86243 ) \
+			ADD_SIMPLE_CASE( packname##_132049 ) \
+		}
+
+DEF_SFMT_TESTS( sfmt_minpoly, verify_sfmt_minpoly )
+DEF_SFMT_TESTS( sfmt_jump, verify_sfmt_jump )
+
+// the far jumps are costly to derive for large MEXP
+
+SIMPLE_CASE( sfmt_jump_far_1279 ) { verify_sfmt_jump_far<1279>(); }
+SIMPLE_CASE( sfmt_jump_far_19937 ) { verify_sfmt_jump_far<19937>(); }
+
+SIMPLE_CASE( sfmt_substreams_1279 ) { verify_sfmt_substreams<1279>(); }
+SIMPLE_CASE( sfmt_substreams_19937 ) { verify_sfmt_substreams<19937>(); }
+
+AUTO_TPACK( sfmt_jump_far )
+{
+	ADD_SIMPLE_CASE( sfmt_jump_far_1279 )
+	ADD_SIMPLE_CASE( sfmt_jump_far_19937 )
+}
+
+AUTO_TPACK( sfmt_substreams )
+{
+	ADD_SIMPLE_CASE( sfmt_substreams_1279 )
+	ADD_SIMPLE_CASE( sfmt_substreams_19937 )
+}
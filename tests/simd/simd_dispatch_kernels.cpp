@@ -0,0 +1,33 @@
+/**
+ * @file simd_dispatch_kernels.cpp
+ *
+ * @brief Kernels compiled once per instruction set, for testing
+ *        run-time SIMD dispatch (see test_simd_dispatch.cpp)
+ *
+ * @author Dahua Lin
+ */
+
+#define LMAT_SIMD_DISPATCH_VARIANT
+
+#include <light_mat/simd/simd_dispatch.h>
+#include <light_mat/matrix/matrix_classes.h>
+#include <light_mat/mateval/mat_reduce.h>
+
+using namespace lmat;
+
+int LMAT_SIMD_VARIANT_NAME(dispatch_test_level)()
+{
+	return LMAT_SIMD_LEVEL;
+}
+
+double LMAT_SIMD_VARIANT_NAME(dispatch_test_sum)(const double *x, index_t n)
+{
+	return sum(cref_col<double>(x, n));
+}
+
+void LMAT_SIMD_VARIANT_NAME(dispatch_test_axpy)(double a, const double *x, double *y, index_t n)
+{
+	ref_col<double> ycol(y, n);
+	accum_to(ycol, a, cref_col<double>(x, n));
+}
+
@@ -0,0 +1,511 @@
+/**
+ * @file test_avx512_arith.cpp
+ *
+ * Test of arithmetics on AVX-512 packs
+ * 
+ * @author Dahua Lin 
+ */
+
+#include "simd_test_base.h"
+#include <light_mat/simd/avx512_arith.h>
+#include <light_mat/math/math_base.h>
+#include <limits>
+
+using namespace lmat;
+using namespace lmat::test;
+
+
+T_CASE( avx512_add )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	T a_src[width];
+	T b_src[width];
+
+	T r1[width];
+	T r2[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		a_src[i] = T(i + 1);
+		b_src[i] = T(2 * i + 3);
+
+		r1[i] = a_src[i] + b_src[i];
+		r2[i] = r1[i] + b_src[i];
+	}
+
+	pack_t a; a.load_u(a_src);
+	pack_t b; b.load_u(b_src);
+
+	pack_t r = a + b;
+	ASSERT_SIMD_EQ(r, r1);
+
+	r += b;
+	ASSERT_SIMD_EQ(r, r2);
+}
+
+
+T_CASE( avx512_sub )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	T a_src[width];
+	T b_src[width];
+
+	T r1[width];
+	T r2[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		a_src[i] = T(i + 1);
+		b_src[i] = T(2 * i + 3);
+
+		r1[i] = a_src[i] - b_src[i];
+		r2[i] = r1[i] - b_src[i];
+	}
+
+	pack_t a; a.load_u(a_src);
+	pack_t b; b.load_u(b_src);
+
+	pack_t r = a - b;
+	ASSERT_SIMD_EQ(r, r1);
+
+	r -= b;
+	ASSERT_SIMD_EQ(r, r2);
+}
+
+
+T_CASE( avx512_mul )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	T a_src[width];
+	T b_src[width];
+
+	T r1[width];
+	T r2[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		a_src[i] = T(i + 1);
+		b_src[i] = T(2 * i + 3);
+
+		r1[i] = a_src[i] * b_src[i];
+		r2[i] = r1[i] * b_src[i];
+	}
+
+	pack_t a; a.load_u(a_src);
+	pack_t b; b.load_u(b_src);
+
+	pack_t r = a * b;
+	ASSERT_SIMD_EQ(r, r1);
+
+	r *= b;
+	ASSERT_SIMD_EQ(r, r2);
+}
+
+T_CASE( avx512_div )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	T a_src[width];
+	T b_src[width];
+
+	T r1[width];
+	T r2[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		a_src[i] = T(i + 1);
+		b_src[i] = T(2 * i + 3);
+
+		r1[i] = a_src[i] / b_src[i];
+		r2[i] = r1[i] / b_src[i];
+	}
+
+	pack_t a; a.load_u(a_src);
+	pack_t b; b.load_u(b_src);
+
+	pack_t r = a / b;
+	ASSERT_SIMD_ULP(r, r1, 1);
+
+	r /= b;
+	ASSERT_SIMD_ULP(r, r2, 3);
+}
+
+
+T_CASE( avx512_neg )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	T a_src[width];
+
+	T r1[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		a_src[i] = T(i + 1);
+		if (i % 2 == 0) a_src[i] = - a_src[i];
+
+		r1[i] = - a_src[i];
+	}
+
+	pack_t a; a.load_u(a_src);
+
+	pack_t r = -a;
+	ASSERT_SIMD_EQ(r, r1);
+}
+
+
+T_CASE( avx512_fma )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	T a_src[width];
+	T b_src[width];
+	T c_src[width];
+
+	T r1[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		a_src[i] = T(i + 1);
+		b_src[i] = T(2 * i + 3);
+		c_src[i] = T(5) - T(i);
+
+		r1[i] = math::fma(a_src[i], b_src[i], c_src[i]);
+	}
+
+	pack_t a; a.load_u(a_src);
+	pack_t b; b.load_u(b_src);
+	pack_t c; c.load_u(c_src);
+
+	pack_t r = math::fma(a, b, c);
+	ASSERT_SIMD_EQ(r, r1);
+}
+
+T_CASE( avx512_fma_rounding )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	// x * y is not exactly representable, so fused and unfused
+	// evaluation round differently
+
+	const T eps = std::numeric_limits<T>::epsilon();
+
+	T a_src[width];
+	T b_src[width];
+	T c_src[width];
+
+	T r1[width];
+	T r2[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		a_src[i] = T(1) + eps * T(i + 1);
+		b_src[i] = T(1) - eps * T(i + 1);
+		c_src[i] = T(-1);
+
+		// AVX-512 always has fused multiply-add
+
+		r1[i] = std::fma(a_src[i], b_src[i], c_src[i]);
+		r2[i] = math::horner(a_src[i], b_src[i], c_src[i]);
+	}
+
+	pack_t a; a.load_u(a_src);
+	pack_t b; b.load_u(b_src);
+	pack_t c; c.load_u(c_src);
+
+	pack_t r = math::fma(a, b, c);
+	ASSERT_SIMD_EQ(r, r1);
+
+	// horner on a linear polynomial is a single fmadd
+
+#ifdef LMAT_HAS_FMA
+	ASSERT_VEC_EQ(width, r2, r1);
+#endif
+	pack_t rh = math::horner(a, b, c);
+	ASSERT_SIMD_EQ(rh, r1);
+}
+
+
+T_CASE( avx512_abs )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	T a_src[width];
+
+	T r1[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		a_src[i] = T(i + 1);
+		if (i % 2 == 0) a_src[i] = - a_src[i];
+
+		r1[i] = math::abs(a_src[i]);
+	}
+
+	pack_t a; a.load_u(a_src);
+
+	pack_t r = math::abs(a);
+	ASSERT_SIMD_EQ(r, r1);
+}
+
+
+T_CASE( avx512_sqr )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	T a_src[width];
+
+	T r1[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		a_src[i] = T(i + 2);
+		if (i % 2 == 0) a_src[i] = - a_src[i];
+
+		r1[i] = math::sqr(a_src[i]);
+	}
+
+	pack_t a; a.load_u(a_src);
+
+	pack_t r = math::sqr(a);
+	ASSERT_SIMD_EQ(r, r1);
+}
+
+
+T_CASE( avx512_cube )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	T a_src[width];
+
+	T r1[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		a_src[i] = T(i + 2);
+		if (i % 2 == 0) a_src[i] = - a_src[i];
+
+		r1[i] = math::cube(a_src[i]);
+	}
+
+	pack_t a; a.load_u(a_src);
+
+	pack_t r = math::cube(a);
+	ASSERT_SIMD_EQ(r, r1);
+}
+
+T_CASE( avx512_sqrt )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	T a_src[width];
+
+	T r1[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		a_src[i] = T(i + 2);
+		r1[i] = math::sqrt(a_src[i]);
+	}
+
+	pack_t a; a.load_u(a_src);
+
+	pack_t r = math::sqrt(a);
+	ASSERT_SIMD_ULP(r, r1, 1);
+}
+
+
+T_CASE( avx512_rcp )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	T a_src[width];
+
+	T r1[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		a_src[i] = T(i + 2);
+		if (i % 2 == 0) a_src[i] = - a_src[i];
+
+		r1[i] = math::rcp(a_src[i]);
+	}
+
+	pack_t a; a.load_u(a_src);
+
+	pack_t r = math::rcp(a);
+	ASSERT_SIMD_ULP(r, r1, 1);
+}
+
+T_CASE( avx512_rsqrt )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	T a_src[width];
+
+	T r1[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		a_src[i] = T(i + 2);
+		r1[i] = math::rsqrt(a_src[i]);
+	}
+
+	pack_t a; a.load_u(a_src);
+
+	pack_t r = math::rsqrt(a);
+	ASSERT_SIMD_ULP(r, r1, 1);
+}
+
+
+T_CASE( avx512_max )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	T a_src[width];
+	T b_src[width];
+
+	T r1[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		a_src[i] = T(i + 2);
+		b_src[i] = T(3 * i + 1);
+
+		r1[i] = math::max(a_src[i], b_src[i]);
+	}
+
+	pack_t a; a.load_u(a_src);
+	pack_t b; b.load_u(b_src);
+
+	pack_t r = math::max(a, b);
+	ASSERT_SIMD_EQ(r, r1);
+}
+
+
+T_CASE( avx512_min )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	T a_src[width];
+	T b_src[width];
+
+	T r1[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		a_src[i] = T(i + 2);
+		b_src[i] = T(3 * i + 1);
+
+		r1[i] = math::min(a_src[i], b_src[i]);
+	}
+
+	pack_t a; a.load_u(a_src);
+	pack_t b; b.load_u(b_src);
+
+	pack_t r = math::min(a, b);
+	ASSERT_SIMD_EQ(r, r1);
+}
+
+
+template<typename T> struct avx512_cond_tbody;
+
+template<> struct avx512_cond_tbody<float>
+{
+	static void run()
+	{
+		typedef simd_pack<float, avx512_t> pack_t;
+		typedef simd_bpack<float, avx512_t> bpack_t;
+
+		bpack_t b(true, false, true, false, true, true, false, false,
+				false, true, true, false, false, false, true, true);
+		pack_t x( 1.f,  2.f,  3.f,  4.f,  5.f,  6.f,  7.f,  8.f,
+				  9.f,  10.f,  11.f,  12.f,  13.f,  14.f,  15.f,  16.f);
+		pack_t y(-1.f, -2.f, -3.f, -4.f, -5.f, -6.f, -7.f, -8.f,
+				-9.f, -10.f, -11.f, -12.f, -13.f, -14.f, -15.f, -16.f);
+
+		float r0[16] = {1.f, -2.f, 3.f, -4.f, 5.f, 6.f, -7.f, -8.f,
+				-9.f, 10.f, 11.f, -12.f, -13.f, -14.f, 15.f, 16.f};
+
+		ASSERT_SIMD_EQ( math::cond(b, x, y), r0 );
+	}
+};
+
+template<> struct avx512_cond_tbody<double>
+{
+	static void run()
+	{
+		typedef simd_pack<double, avx512_t> pack_t;
+		typedef simd_bpack<double, avx512_t> bpack_t;
+
+		bpack_t b(true, false, true, false, false, true, true, false);
+		pack_t x( 1.0,  2.0,  3.0,  4.0,  5.0,  6.0,  7.0,  8.0);
+		pack_t y(-1.0, -2.0, -3.0, -4.0, -5.0, -6.0, -7.0, -8.0);
+
+		double r0[8] = {1.0, -2.0, 3.0, -4.0, -5.0, 6.0, 7.0, -8.0};
+		ASSERT_SIMD_EQ( math::cond(b, x, y), r0 );
+	}
+};
+
+
+T_CASE( avx512_cond )
+{
+	avx512_cond_tbody<T>::run();
+}
+
+
+AUTO_TPACK( avx512_arith )
+{
+	ADD_T_CASE_FP( avx512_add )
+	ADD_T_CASE_FP( avx512_sub )
+	ADD_T_CASE_FP( avx512_mul )
+	ADD_T_CASE_FP( avx512_div )
+	ADD_T_CASE_FP( avx512_neg )
+	ADD_T_CASE_FP( avx512_fma )
+	ADD_T_CASE_FP( avx512_fma_rounding )
+}
+
+AUTO_TPACK( avx512_spower )
+{
+	ADD_T_CASE_FP( avx512_abs )
+	ADD_T_CASE_FP( avx512_sqr )
+	ADD_T_CASE_FP( avx512_cube )
+
+	ADD_T_CASE_FP( avx512_rcp )
+	ADD_T_CASE_FP( avx512_sqrt )
+	ADD_T_CASE_FP( avx512_rsqrt )
+}
+
+AUTO_TPACK( avx512_minmax )
+{
+	ADD_T_CASE_FP( avx512_max )
+	ADD_T_CASE_FP( avx512_min )
+}
+
+AUTO_TPACK( avx512_cond )
+{
+	ADD_T_CASE_FP( avx512_cond )
+}
+
+
+
+
+
@@ -0,0 +1,429 @@
+/**
+ * @file test_avx512_packs.cpp
+ *
+ * @brief Unit tests of AVX-512 packs
+ *
+ * @author Dahua Lin
+ */
+
+#include "simd_test_base.h"
+#include <light_mat/simd/avx512_packs.h>
+#include <cmath>
+
+using namespace lmat;
+using namespace lmat::test;
+
+static_assert(simd_pack<float,  avx512_t>::pack_width == 16, "Unexpected pack width");
+static_assert(simd_pack<double, avx512_t>::pack_width == 8, "Unexpected pack width");
+
+template<typename T> struct elemwise_construct;
+
+template<> struct elemwise_construct<float>
+{
+	static simd_pack<float, avx512_t> get(const float* s)
+	{
+		return simd_pack<float, avx512_t>(s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7],
+				s[8], s[9], s[10], s[11], s[12], s[13], s[14], s[15]);
+	}
+
+	static void set(simd_pack<float, avx512_t>& pk, const float *s)
+	{
+		pk.set(s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7],
+				s[8], s[9], s[10], s[11], s[12], s[13], s[14], s[15]);
+	}
+};
+
+template<> struct elemwise_construct<double>
+{
+	static simd_pack<double, avx512_t> get(const double* s)
+	{
+		return simd_pack<double, avx512_t>(s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7]);
+	}
+
+	static void set(simd_pack<double, avx512_t>& pk, const double *s)
+	{
+		pk.set(s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7]);
+	}
+};
+
+
+T_CASE( avx512_pack_constructs )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	pack_t pk0 = pack_t::zeros();
+	ASSERT_EQ( pk0.width(), width );
+	T v0 = T(0);
+	ASSERT_SIMD_EQ( pk0, v0 );
+
+	T v1 = T(2.5);
+	pack_t pk1( v1 );
+	ASSERT_SIMD_EQ( pk1, v1 );
+
+	T r2[width];
+	for (unsigned i = 0; i < width; ++i) r2[i] = T(1.5 + i);
+
+	pack_t pk2 = elemwise_construct<T>::get(r2);
+	ASSERT_SIMD_EQ( pk2, r2 );
+
+	pack_t pk3(r2);
+	ASSERT_SIMD_EQ( pk3, r2 );
+
+	pack_t pv1 = pack_t::ones();
+	ASSERT_SIMD_EQ( pv1, T(1) );
+
+	pack_t pv_inf = pack_t::inf();
+	for (unsigned i = 0; i < width; ++i)
+	{
+		bool is_inf_i = std::isinf(pv_inf[i]) && pv_inf[i] > T(0);
+		ASSERT_TRUE( is_inf_i );
+	}
+
+	pack_t pv_neginf = pack_t::neg_inf();
+	for (unsigned i = 0; i < width; ++i)
+	{
+		bool is_neginf_i = std::isinf(pv_neginf[i]) && pv_neginf[i] < T(0);
+		ASSERT_TRUE( is_neginf_i );
+	}
+
+	pack_t pv_nan = pack_t::nan();
+	for (unsigned i = 0; i < width; ++i)
+	{
+		bool is_nan_i = std::isnan(pv_nan[i]);
+		ASSERT_TRUE( is_nan_i );
+	}
+}
+
+
+
+T_CASE( avx512_pack_sets )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	pack_t pk;
+
+	T v1 = T(3.2);
+	pk.set(v1);
+	ASSERT_SIMD_EQ( pk, v1 );
+
+	T r2[width];
+	for (unsigned i = 0; i < width; ++i) r2[i] = T(2.5 + i);
+	elemwise_construct<T>::set(pk, r2);
+	ASSERT_SIMD_EQ(pk, r2);
+
+	T v0 = T(0);
+	pk.reset();
+	ASSERT_SIMD_EQ(pk, v0);
+}
+
+
+T_CASE( avx512_pack_loads )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	const unsigned int len = 2 * width + 1;
+	LMAT_ALIGN_AVX512 T src[len];
+	for (unsigned i = 0; i < len; ++i) src[i] = T(1.8 + i);
+
+	pack_t pk = pack_t::zeros();
+
+	pk.load_a(src);
+	ASSERT_SIMD_EQ(pk, src);
+
+	pk.load_u(src + 1);
+	ASSERT_SIMD_EQ(pk, src + 1);
+}
+
+T_CASE( avx512_pack_stores )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	LMAT_ALIGN_AVX512 T src[width];
+	for (unsigned i = 0; i < width; ++i) src[i] = T(1.8 + i);
+
+	const unsigned int len = 2 * width + 1;
+	LMAT_ALIGN_AVX512 T dst[len];
+
+	pack_t pk;
+	pk.load_a(src);
+
+	for (unsigned i = 0; i < len; ++i) dst[i] = T(0);
+	pk.store_a(dst);
+	ASSERT_VEC_EQ(width, dst, src);
+
+	for (unsigned i = 0; i < len; ++i) dst[i] = T(0);
+	pk.store_u(dst + 1);
+	ASSERT_VEC_EQ(width, dst + 1, src);
+}
+
+
+TI_CASE( avx512_pack_load_parts )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	LMAT_ALIGN_AVX512 T src_base[width + 1];
+	T *src = src_base + 1;
+	for (unsigned i = 0; i < width; ++i) src[i] = T(2.4 + i);
+
+	pack_t pk;
+	pk.load_part(siz_<I>(), src);
+
+	T r[width];
+	for (unsigned i = 0; i < width; ++i) r[i] = T(0);
+	for (int i = 0; i < I; ++i) r[i] = src[i];
+
+	ASSERT_SIMD_EQ( pk, r );
+}
+
+TI_CASE( avx512_pack_store_parts )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	LMAT_ALIGN_AVX512 T src[width];
+	for (unsigned i = 0; i < width; ++i) src[i] = T(2.4 + i);
+
+	pack_t pk;
+	pk.load_a(src);
+
+	T v = T(2.3);
+	T r[width];
+	for (unsigned i = 0; i < width; ++i) r[i] = v;
+	for (int i = 0; i < I; ++i) r[i] = src[i];
+
+	LMAT_ALIGN_AVX512 T dst_base[width + 1];
+	T *dst = dst_base + 1;
+	for (unsigned i = 0; i < width; ++i) dst[i] = v;
+
+	pk.store_part(siz_<I>(), dst);
+	ASSERT_VEC_EQ( width, dst, r );
+}
+
+T_CASE( avx512_pack_load_rparts )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	LMAT_ALIGN_AVX512 T src_base[width + 1];
+	T *src = src_base + 1;
+	for (unsigned i = 0; i < width; ++i) src[i] = T(2.4 + i);
+
+	for (unsigned int n = 0; n <= width; ++n)
+	{
+		pack_t pk = pack_t::ones();
+		pk.load_part(n, src);
+
+		T r[width];
+		for (unsigned i = 0; i < width; ++i) r[i] = T(0);
+		for (unsigned i = 0; i < n; ++i) r[i] = src[i];
+
+		ASSERT_SIMD_EQ( pk, r );
+	}
+}
+
+T_CASE( avx512_pack_store_rparts )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	LMAT_ALIGN_AVX512 T src[width];
+	for (unsigned i = 0; i < width; ++i) src[i] = T(2.4 + i);
+
+	pack_t pk;
+	pk.load_a(src);
+
+	T v = T(2.3);
+	LMAT_ALIGN_AVX512 T dst_base[width + 1];
+	T *dst = dst_base + 1;
+
+	for (unsigned int n = 0; n <= width; ++n)
+	{
+		T r[width];
+		for (unsigned i = 0; i < width; ++i) r[i] = v;
+		for (unsigned i = 0; i < n; ++i) r[i] = src[i];
+
+		for (unsigned i = 0; i < width; ++i) dst[i] = v;
+		pk.store_part(n, dst);
+		ASSERT_VEC_EQ( width, dst, r );
+	}
+}
+
+T_CASE( avx512_pack_to_scalar )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	LMAT_ALIGN_AVX512 T src[width];
+	for (unsigned i = 0; i < width; ++i) src[i] = T(2.4 + i);
+
+	pack_t pk;
+	pk.load_a(src);
+
+	T v = pk.to_scalar();
+
+	ASSERT_EQ(v, src[0]);
+}
+
+TI_CASE( avx512_pack_extracts )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	LMAT_ALIGN_AVX512 T src[width];
+	for (unsigned i = 0; i < width; ++i) src[i] = T(2.4 + i);
+
+	pack_t pk;
+	pk.load_a(src);
+
+	T v = pk.extract(pos_<I>());
+	ASSERT_EQ(v, src[I]);
+}
+
+TI_CASE( avx512_pack_broadcasts )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	LMAT_ALIGN_AVX512 T src[width];
+	for (unsigned i = 0; i < width; ++i) src[i] = T(2.4 + i);
+
+	pack_t pk0;
+	pk0.load_a(src);
+
+	pack_t pk = pk0.broadcast(pos_<I>());
+
+	ASSERT_SIMD_EQ(pk, src[I]);
+}
+
+
+AUTO_TPACK( avx512_basics )
+{
+	ADD_T_CASE_FP( avx512_pack_constructs )
+	ADD_T_CASE_FP( avx512_pack_sets )
+	ADD_T_CASE_FP( avx512_pack_loads )
+	ADD_T_CASE_FP( avx512_pack_stores )
+}
+
+AUTO_TPACK( avx512_parts )
+{
+	ADD_TI_CASE( avx512_pack_load_parts, float, 1 )
+	ADD_TI_CASE( avx512_pack_load_parts, float, 2 )
+	ADD_TI_CASE( avx512_pack_load_parts, float, 3 )
+	ADD_TI_CASE( avx512_pack_load_parts, float, 4 )
+	ADD_TI_CASE( avx512_pack_load_parts, float, 5 )
+	ADD_TI_CASE( avx512_pack_load_parts, float, 6 )
+	ADD_TI_CASE( avx512_pack_load_parts, float, 7 )
+	ADD_TI_CASE( avx512_pack_load_parts, float, 8 )
+	ADD_TI_CASE( avx512_pack_load_parts, float, 9 )
+	ADD_TI_CASE( avx512_pack_load_parts, float, 10 )
+	ADD_TI_CASE( avx512_pack_load_parts, float, 11 )
+	ADD_TI_CASE( avx512_pack_load_parts, float, 12 )
+	ADD_TI_CASE( avx512_pack_load_parts, float, 13 )
+	ADD_TI_CASE( avx512_pack_load_parts, float, 14 )
+	ADD_TI_CASE( avx512_pack_load_parts, float, 15 )
+	ADD_TI_CASE( avx512_pack_load_parts, float, 16 )
+
+	ADD_TI_CASE( avx512_pack_load_parts, double, 1 )
+	ADD_TI_CASE( avx512_pack_load_parts, double, 2 )
+	ADD_TI_CASE( avx512_pack_load_parts, double, 3 )
+	ADD_TI_CASE( avx512_pack_load_parts, double, 4 )
+	ADD_TI_CASE( avx512_pack_load_parts, double, 5 )
+	ADD_TI_CASE( avx512_pack_load_parts, double, 6 )
+	ADD_TI_CASE( avx512_pack_load_parts, double, 7 )
+	ADD_TI_CASE( avx512_pack_load_parts, double, 8 )
+
+	ADD_TI_CASE( avx512_pack_store_parts, float, 1 )
+	ADD_TI_CASE( avx512_pack_store_parts, float, 2 )
+	ADD_TI_CASE( avx512_pack_store_parts, float, 3 )
+	ADD_TI_CASE( avx512_pack_store_parts, float, 4 )
+	ADD_TI_CASE( avx512_pack_store_parts, float, 5 )
+	ADD_TI_CASE( avx512_pack_store_parts, float, 6 )
+	ADD_TI_CASE( avx512_pack_store_parts, float, 7 )
+	ADD_TI_CASE( avx512_pack_store_parts, float, 8 )
+	ADD_TI_CASE( avx512_pack_store_parts, float, 9 )
+	ADD_TI_CASE( avx512_pack_store_parts, float, 10 )
+	ADD_TI_CASE( avx512_pack_store_parts, float, 11 )
+	ADD_TI_CASE( avx512_pack_store_parts, float, 12 )
+	ADD_TI_CASE( avx512_pack_store_parts, float, 13 )
+	ADD_TI_CASE( avx512_pack_store_parts, float, 14 )
+	ADD_TI_CASE( avx512_pack_store_parts, float, 15 )
+	ADD_TI_CASE( avx512_pack_store_parts, float, 16 )
+
+	ADD_TI_CASE( avx512_pack_store_parts, double, 1 )
+	ADD_TI_CASE( avx512_pack_store_parts, double, 2 )
+	ADD_TI_CASE( avx512_pack_store_parts, double, 3 )
+	ADD_TI_CASE( avx512_pack_store_parts, double, 4 )
+	ADD_TI_CASE( avx512_pack_store_parts, double, 5 )
+	ADD_TI_CASE( avx512_pack_store_parts, double, 6 )
+	ADD_TI_CASE( avx512_pack_store_parts, double, 7 )
+	ADD_TI_CASE( avx512_pack_store_parts, double, 8 )
+
+	ADD_T_CASE_FP( avx512_pack_load_rparts )
+	ADD_T_CASE_FP( avx512_pack_store_rparts )
+}
+
+AUTO_TPACK( avx512_elems )
+{
+	ADD_T_CASE_FP( avx512_pack_to_scalar )
+
+	ADD_TI_CASE( avx512_pack_extracts, float, 0 )
+	ADD_TI_CASE( avx512_pack_extracts, float, 1 )
+	ADD_TI_CASE( avx512_pack_extracts, float, 2 )
+	ADD_TI_CASE( avx512_pack_extracts, float, 3 )
+	ADD_TI_CASE( avx512_pack_extracts, float, 4 )
+	ADD_TI_CASE( avx512_pack_extracts, float, 5 )
+	ADD_TI_CASE( avx512_pack_extracts, float, 6 )
+	ADD_TI_CASE( avx512_pack_extracts, float, 7 )
+	ADD_TI_CASE( avx512_pack_extracts, float, 8 )
+	ADD_TI_CASE( avx512_pack_extracts, float, 9 )
+	ADD_TI_CASE( avx512_pack_extracts, float, 10 )
+	ADD_TI_CASE( avx512_pack_extracts, float, 11 )
+	ADD_TI_CASE( avx512_pack_extracts, float, 12 )
+	ADD_TI_CASE( avx512_pack_extracts, float, 13 )
+	ADD_TI_CASE( avx512_pack_extracts, float, 14 )
+	ADD_TI_CASE( avx512_pack_extracts, float, 15 )
+
+	ADD_TI_CASE( avx512_pack_extracts, double, 0 )
+	ADD_TI_CASE( avx512_pack_extracts, double, 1 )
+	ADD_TI_CASE( avx512_pack_extracts, double, 2 )
+	ADD_TI_CASE( avx512_pack_extracts, double, 3 )
+	ADD_TI_CASE( avx512_pack_extracts, double, 4 )
+	ADD_TI_CASE( avx512_pack_extracts, double, 5 )
+	ADD_TI_CASE( avx512_pack_extracts, double, 6 )
+	ADD_TI_CASE( avx512_pack_extracts, double, 7 )
+}
+
+AUTO_TPACK( avx512_broadcast )
+{
+	ADD_TI_CASE( avx512_pack_broadcasts, float, 0 )
+	ADD_TI_CASE( avx512_pack_broadcasts, float, 1 )
+	ADD_TI_CASE( avx512_pack_broadcasts, float, 2 )
+	ADD_TI_CASE( avx512_pack_broadcasts, float, 3 )
+	ADD_TI_CASE( avx512_pack_broadcasts, float, 4 )
+	ADD_TI_CASE( avx512_pack_broadcasts, float, 5 )
+	ADD_TI_CASE( avx512_pack_broadcasts, float, 6 )
+	ADD_TI_CASE( avx512_pack_broadcasts, float, 7 )
+	ADD_TI_CASE( avx512_pack_broadcasts, float, 8 )
+	ADD_TI_CASE( avx512_pack_broadcasts, float, 9 )
+	ADD_TI_CASE( avx512_pack_broadcasts, float, 10 )
+	ADD_TI_CASE( avx512_pack_broadcasts, float, 11 )
+	ADD_TI_CASE( avx512_pack_broadcasts, float, 12 )
+	ADD_TI_CASE( avx512_pack_broadcasts, float, 13 )
+	ADD_TI_CASE( avx512_pack_broadcasts, float, 14 )
+	ADD_TI_CASE( avx512_pack_broadcasts, float, 15 )
+
+	ADD_TI_CASE( avx512_pack_broadcasts, double, 0 )
+	ADD_TI_CASE( avx512_pack_broadcasts, double, 1 )
+	ADD_TI_CASE( avx512_pack_broadcasts, double, 2 )
+	ADD_TI_CASE( avx512_pack_broadcasts, double, 3 )
+	ADD_TI_CASE( avx512_pack_broadcasts, double, 4 )
+	ADD_TI_CASE( avx512_pack_broadcasts, double, 5 )
+	ADD_TI_CASE( avx512_pack_broadcasts, double, 6 )
+	ADD_TI_CASE( avx512_pack_broadcasts, double, 7 )
+}
+
@@ -0,0 +1,324 @@
+/**
+ * @file test_avx512_pred.cpp
+ *
+ * Unit testing of predicates on AVX-512 packs
+ * 
+ * @author Dahua Lin 
+ */
+
+#include "simd_test_base.h"
+#include <light_mat/simd/avx512_pred.h>
+#include <light_mat/math/math_base.h>
+#include <limits>
+
+using namespace lmat;
+using namespace lmat::test;
+
+
+T_CASE( avx512_eq )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	typedef simd_bpack<T, avx512_t> bpack_t;
+	typedef typename bpack_t::bint_type bint;
+
+	T a_src[width];
+	T b_src[width];
+
+	bint r1[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		int dv = (int)(i % 3) - 1;
+
+		a_src[i] = T(i + 1);
+		b_src[i] = a_src[i] + T(dv);
+
+		r1[i] = -bint(a_src[i] == b_src[i]);
+	}
+
+	pack_t a; a.load_u(a_src);
+	pack_t b; b.load_u(b_src);
+
+	bpack_t r = (a == b);
+	ASSERT_SIMD_EQ(r, r1);
+}
+
+
+T_CASE( avx512_ne )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	typedef simd_bpack<T, avx512_t> bpack_t;
+	typedef typename bpack_t::bint_type bint;
+
+	T a_src[width];
+	T b_src[width];
+
+	bint r1[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		int dv = (int)(i % 3) - 1;
+
+		a_src[i] = T(i + 1);
+		b_src[i] = a_src[i] + T(dv);
+
+		r1[i] = -bint(a_src[i] != b_src[i]);
+	}
+
+	pack_t a; a.load_u(a_src);
+	pack_t b; b.load_u(b_src);
+
+	bpack_t r = (a != b);
+	ASSERT_SIMD_EQ(r, r1);
+}
+
+
+T_CASE( avx512_gt )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	typedef simd_bpack<T, avx512_t> bpack_t;
+	typedef typename bpack_t::bint_type bint;
+
+	T a_src[width];
+	T b_src[width];
+
+	bint r1[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		int dv = (int)(i % 3) - 1;
+
+		a_src[i] = T(i + 1);
+		b_src[i] = a_src[i] + T(dv);
+
+		r1[i] = -bint(a_src[i] > b_src[i]);
+	}
+
+	pack_t a; a.load_u(a_src);
+	pack_t b; b.load_u(b_src);
+
+	bpack_t r = (a > b);
+	ASSERT_SIMD_EQ(r, r1);
+}
+
+
+T_CASE( avx512_ge )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	typedef simd_bpack<T, avx512_t> bpack_t;
+	typedef typename bpack_t::bint_type bint;
+
+	T a_src[width];
+	T b_src[width];
+
+	bint r1[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		int dv = (int)(i % 3) - 1;
+
+		a_src[i] = T(i + 1);
+		b_src[i] = a_src[i] + T(dv);
+
+		r1[i] = -bint(a_src[i] >= b_src[i]);
+	}
+
+	pack_t a; a.load_u(a_src);
+	pack_t b; b.load_u(b_src);
+
+	bpack_t r = (a >= b);
+	ASSERT_SIMD_EQ(r, r1);
+}
+
+
+T_CASE( avx512_lt )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	typedef simd_bpack<T, avx512_t> bpack_t;
+	typedef typename bpack_t::bint_type bint;
+
+	T a_src[width];
+	T b_src[width];
+
+	bint r1[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		int dv = (int)(i % 3) - 1;
+
+		a_src[i] = T(i + 1);
+		b_src[i] = a_src[i] + T(dv);
+
+		r1[i] = -bint(a_src[i] < b_src[i]);
+	}
+
+	pack_t a; a.load_u(a_src);
+	pack_t b; b.load_u(b_src);
+
+	bpack_t r = (a < b);
+	ASSERT_SIMD_EQ(r, r1);
+}
+
+
+T_CASE( avx512_le )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	typedef simd_bpack<T, avx512_t> bpack_t;
+	typedef typename bpack_t::bint_type bint;
+
+	T a_src[width];
+	T b_src[width];
+
+	bint r1[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		int dv = (int)(i % 3) - 1;
+
+		a_src[i] = T(i + 1);
+		b_src[i] = a_src[i] + T(dv);
+
+		r1[i] = -bint(a_src[i] <= b_src[i]);
+	}
+
+	pack_t a; a.load_u(a_src);
+	pack_t b; b.load_u(b_src);
+
+	bpack_t r = (a <= b);
+	ASSERT_SIMD_EQ(r, r1);
+}
+
+
+// the opmask-based boolean packs are exercised over
+// patterns of width bits
+
+inline bool bpat(unsigned int k, unsigned int i)
+{
+	return ((k * 0x9e3779b9u) >> (i + 3)) & 1u;
+}
+
+T_CASE( avx512_logical )
+{
+	typedef simd_bpack<T, avx512_t> bpack_t;
+	typedef typename bpack_t::bint_type bint;
+	const unsigned int width = bpack_t::pack_width;
+
+	for (unsigned int k = 0; k < 32; ++k)
+	{
+		bool a_src[width];
+		bool b_src[width];
+
+		bint r_not[width];
+		bint r_and[width];
+		bint r_or[width];
+		bint r_eq[width];
+		bint r_ne[width];
+
+		for (unsigned i = 0; i < width; ++i)
+		{
+			a_src[i] = bpat(k, i);
+			b_src[i] = bpat(k + 7, i);
+
+			r_not[i] = -bint(!a_src[i]);
+			r_and[i] = -bint(a_src[i] && b_src[i]);
+			r_or[i]  = -bint(a_src[i] || b_src[i]);
+			r_eq[i]  = -bint(a_src[i] == b_src[i]);
+			r_ne[i]  = -bint(a_src[i] != b_src[i]);
+		}
+
+		bpack_t a(a_src);
+		bpack_t b(b_src);
+
+		ASSERT_SIMD_EQ( ~a, r_not );
+		ASSERT_SIMD_EQ( a & b, r_and );
+		ASSERT_SIMD_EQ( a | b, r_or );
+		ASSERT_SIMD_EQ( a == b, r_eq );
+		ASSERT_SIMD_EQ( a != b, r_ne );
+
+		bpack_t c = a;
+		c &= b;
+		ASSERT_SIMD_EQ( c, r_and );
+
+		c = a;
+		c |= b;
+		ASSERT_SIMD_EQ( c, r_or );
+	}
+}
+
+
+T_CASE( avx512_fpclassify )
+{
+	typedef std::numeric_limits<T> lim_t;
+
+	typedef simd_pack<T, avx512_t> pack_t;
+	typedef simd_bpack<T, avx512_t> bpack_t;
+	typedef typename bpack_t::bint_type bint;
+	const unsigned int width = pack_t::pack_width;
+
+	const T vals[8] = {
+			T(0), -T(0), T(1), T(-1),
+			lim_t::infinity(), -lim_t::infinity(),
+			lim_t::quiet_NaN(), -lim_t::quiet_NaN() };
+
+	const bint is_neg_r   [8] = { 0, -1, 0, -1, 0, -1, 0, -1 };
+	const bint is_finite_r[8] = { -1, -1, -1, -1, 0, 0, 0, 0 };
+	const bint is_inf_r   [8] = { 0, 0, 0, 0, -1, -1, 0, 0 };
+	const bint is_nan_r   [8] = { 0, 0, 0, 0, 0, 0, -1, -1 };
+
+	T a_src[width];
+	bint is_neg_r1[width];
+	bint is_finite_r1[width];
+	bint is_inf_r1[width];
+	bint is_nan_r1[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		unsigned j = (i * 3) % 8;
+		a_src[i] = vals[j];
+		is_neg_r1[i] = is_neg_r[j];
+		is_finite_r1[i] = is_finite_r[j];
+		is_inf_r1[i] = is_inf_r[j];
+		is_nan_r1[i] = is_nan_r[j];
+	}
+
+	pack_t a1; a1.load_u(a_src);
+
+	ASSERT_SIMD_EQ( math::signbit(a1), is_neg_r1  );
+	ASSERT_SIMD_EQ( math::isfinite(a1), is_finite_r1  );
+	ASSERT_SIMD_EQ( math::isinf(a1), is_inf_r1  );
+	ASSERT_SIMD_EQ( math::isnan(a1), is_nan_r1  );
+}
+
+
+AUTO_TPACK( avx512_comp )
+{
+	ADD_T_CASE_FP( avx512_eq )
+	ADD_T_CASE_FP( avx512_ne )
+	ADD_T_CASE_FP( avx512_gt )
+	ADD_T_CASE_FP( avx512_ge )
+	ADD_T_CASE_FP( avx512_lt )
+	ADD_T_CASE_FP( avx512_le )
+}
+
+AUTO_TPACK( avx512_logical )
+{
+	ADD_T_CASE_FP( avx512_logical )
+}
+
+AUTO_TPACK( avx512_fpclassify )
+{
+	ADD_T_CASE_FP( avx512_fpclassify )
+}
+
@@ -0,0 +1,141 @@
+/**
+ * @file test_avx512_reduce.cpp
+ *
+ * Unit testing of AVX-512 reduction
+ * 
+ * @author Dahua Lin 
+ */
+
+
+#include "simd_test_base.h"
+#include <light_mat/simd/avx512_reduce.h>
+
+using namespace lmat;
+using namespace lmat::test;
+
+T_CASE( avx512_sum )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	T a_src[width];
+	T s0 = T(0);
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		a_src[i] = T(i + 1);
+		s0 += a_src[i];
+	}
+
+	pack_t a; a.load_u(a_src);
+
+	ASSERT_EQ( sum(a), s0 );
+}
+
+
+T_CASE( avx512_max )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	T a_src[width];
+	T s0 = T(-1000);
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		a_src[i] = T(i + 1);
+		if (a_src[i] > s0) s0 = a_src[i];
+	}
+
+	pack_t a; a.load_u(a_src);
+
+	ASSERT_EQ( maximum(a), s0 );
+}
+
+
+T_CASE( avx512_min )
+{
+	typedef simd_pack<T, avx512_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	T a_src[width];
+	T s0 = T(1000);
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		a_src[i] = T(-3 - (int)i);
+		if (a_src[i] < s0) s0 = a_src[i];
+	}
+
+	pack_t a; a.load_u(a_src);
+
+	ASSERT_EQ( minimum(a), s0 );
+}
+
+
+SIMPLE_CASE( avx512_booltest_f32 )
+{
+	const unsigned int M = 65535;
+	for (unsigned i = 0; i <= M; ++i)
+	{
+		bool b[16];
+		for (unsigned k = 0; k < 16; ++k) b[k] = (i >> k) & 1;
+
+		avx512_f32bpk pk(b[0], b[1], b[2], b[3], b[4], b[5], b[6], b[7],
+				b[8], b[9], b[10], b[11], b[12], b[13], b[14], b[15]);
+
+		bool all_t = (i == M);
+		bool all_f = (i == 0);
+		bool any_t = !all_f;
+		bool any_f = !all_t;
+
+		ASSERT_EQ( all_true (pk), all_t );
+		ASSERT_EQ( all_false(pk), all_f );
+		ASSERT_EQ( any_true (pk), any_t );
+		ASSERT_EQ( any_false(pk), any_f );
+	}
+}
+
+SIMPLE_CASE( avx512_booltest_f64 )
+{
+	const unsigned int M = 255;
+	for (unsigned i = 0; i <= M; ++i)
+	{
+		bool b0 = i & 1;
+		bool b1 = i & 2;
+		bool b2 = i & 4;
+		bool b3 = i & 8;
+		bool b4 = i & 16;
+		bool b5 = i & 32;
+		bool b6 = i & 64;
+		bool b7 = i & 128;
+
+		avx512_f64bpk pk(b0, b1, b2, b3, b4, b5, b6, b7);
+
+		bool all_t = (i == M);
+		bool all_f = (i == 0);
+		bool any_t = !all_f;
+		bool any_f = !all_t;
+
+		ASSERT_EQ( all_true (pk), all_t );
+		ASSERT_EQ( all_false(pk), all_f );
+		ASSERT_EQ( any_true (pk), any_t );
+		ASSERT_EQ( any_false(pk), any_f );
+	}
+}
+
+
+AUTO_TPACK( avx512_stats )
+{
+	ADD_T_CASE_FP( avx512_sum )
+	ADD_T_CASE_FP( avx512_max )
+	ADD_T_CASE_FP( avx512_min )
+}
+
+AUTO_TPACK( avx512_booltest )
+{
+	ADD_SIMPLE_CASE( avx512_booltest_f32 )
+	ADD_SIMPLE_CASE( avx512_booltest_f64 )
+}
+
+
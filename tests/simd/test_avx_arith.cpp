@@ -9,6 +9,7 @@
 #include "simd_test_base.h"
 #include <light_mat/simd/avx_arith.h>
 #include <light_mat/math/math_base.h>
+#include <limits>
 
 using namespace lmat;
 using namespace lmat::test;
@@ -189,6 +190,51 @@ T_CASE( avx_fma )
 	ASSERT_SIMD_EQ(r, r1);
 }
 
+T_CASE( avx_fma_rounding )
+{
+	typedef simd_pack<T, avx_t> pack_t;
+	const unsigned int width = pack_t::pack_width;
+
+	// x * y is not exactly representable, so fused and unfused
+	// evaluation round differently
+
+	const T eps = std::numeric_limits<T>::epsilon();
+
+	T a_src[width];
+	T b_src[width];
+	T c_src[width];
+
+	T r1[width];
+	T r2[width];
+
+	for (unsigned i = 0; i < width; ++i)
+	{
+		a_src[i] = T(1) + eps * T(i + 1);
+		b_src[i] = T(1) - eps * T(i + 1);
+		c_src[i] = T(-1);
+
+#ifdef LMAT_HAS_FMA
+		r1[i] = std::fma(a_src[i], b_src[i], c_src[i]);
+#else
+		r1[i] = a_src[i] * b_src[i] + c_src[i];
+#endif
+		r2[i] = math::horner(a_src[i], b_src[i], c_src[i]);
+	}
+
+	pack_t a; a.load_u(a_src);
+	pack_t b; b.load_u(b_src);
+	pack_t c; c.load_u(c_src);
+
+	pack_t r = math::fma(a, b, c);
+	ASSERT_SIMD_EQ(r, r1);
+
+	// horner on a linear polynomial is a single fmadd
+
+	ASSERT_VEC_EQ(width, r2, r1);
+	pack_t rh = math::horner(a, b, c);
+	ASSERT_SIMD_EQ(rh, r1);
+}
+
 
 T_CASE( avx_abs )
 {
@@ -430,6 +476,7 @@ AUTO_TPACK( avx_arith )
 	ADD_T_CASE_FP( avx_div )
 	ADD_T_CASE_FP( avx_neg )
 	ADD_T_CASE_FP( avx_fma )
+	ADD_T_CASE_FP( avx_fma_rounding )
 }
 
 AUTO_TPACK( avx_spower )
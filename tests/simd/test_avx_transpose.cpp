@@ -0,0 +1,66 @@
+/**
+ * @file test_avx_transpose.cpp
+ *
+ * @brief Unit testing of in-register transposition of AVX packs
+ *
+ * @author Dahua Lin
+ */
+
+#include "simd_test_base.h"
+#include <light_mat/simd/avx_transpose.h>
+
+using namespace lmat;
+using namespace lmat::test;
+
+
+SIMPLE_CASE( avx_transpose_f32 )
+{
+	float src[64];
+	for (int i = 0; i < 64; ++i) src[i] = float(i + 1);
+
+	avx_f32pk a0(src), a1(src + 8), a2(src + 16), a3(src + 24),
+			a4(src + 32), a5(src + 40), a6(src + 48), a7(src + 56);
+	transpose(a0, a1, a2, a3, a4, a5, a6, a7);
+
+	float r[64];
+	a0.store_u(r);
+	a1.store_u(r + 8);
+	a2.store_u(r + 16);
+	a3.store_u(r + 24);
+	a4.store_u(r + 32);
+	a5.store_u(r + 40);
+	a6.store_u(r + 48);
+	a7.store_u(r + 56);
+
+	for (int i = 0; i < 8; ++i)
+	{
+		for (int j = 0; j < 8; ++j) ASSERT_EQ( r[i * 8 + j], src[j * 8 + i] );
+	}
+}
+
+SIMPLE_CASE( avx_transpose_f64 )
+{
+	double src[16];
+	for (int i = 0; i < 16; ++i) src[i] = double(i + 1);
+
+	avx_f64pk a0(src), a1(src + 4), a2(src + 8), a3(src + 12);
+	transpose(a0, a1, a2, a3);
+
+	double r[16];
+	a0.store_u(r);
+	a1.store_u(r + 4);
+	a2.store_u(r + 8);
+	a3.store_u(r + 12);
+
+	for (int i = 0; i < 4; ++i)
+	{
+		for (int j = 0; j < 4; ++j) ASSERT_EQ( r[i * 4 + j], src[j * 4 + i] );
+	}
+}
+
+
+AUTO_TPACK( avx_transpose )
+{
+	ADD_SIMPLE_CASE( avx_transpose_f32 )
+	ADD_SIMPLE_CASE( avx_transpose_f64 )
+}
@@ -0,0 +1,152 @@
+/**
+ * @file test_simd_dispatch.cpp
+ *
+ * @brief Unit testing of run-time SIMD dispatch
+ *
+ * @author Dahua Lin
+ */
+
+#include "../test_base.h"
+#include <light_mat/simd/simd_arch.h>
+#include <light_mat/simd/simd_dispatch.h>
+
+using namespace lmat;
+using namespace lmat::test;
+
+LMAT_DECLARE_SIMD_VARIANTS( int, dispatch_test_level, () )
+LMAT_DECLARE_SIMD_VARIANTS( double, dispatch_test_sum, (const double*, index_t) )
+LMAT_DECLARE_SIMD_VARIANTS( void, dispatch_test_axpy, (double, const double*, double*, index_t) )
+
+typedef int level_fun_t();
+typedef double sum_fun_t(const double*, index_t);
+typedef void axpy_fun_t(double, const double*, double*, index_t);
+
+const index_t test_len = 37;
+
+#ifdef LMAT_SIMD_DISPATCH_AVX512
+const int max_dispatch_level = LMAT_SIMD_LEVEL_AVX512;
+#else
+const int max_dispatch_level = LMAT_SIMD_LEVEL_AVX2;
+#endif
+
+inline int expected_dispatch_level(int cpu_level)
+{
+	return cpu_level >= max_dispatch_level   ? max_dispatch_level :
+		  (cpu_level >= LMAT_SIMD_LEVEL_AVX2 ? LMAT_SIMD_LEVEL_AVX2 :
+		  (cpu_level >= LMAT_SIMD_LEVEL_AVX  ? LMAT_SIMD_LEVEL_AVX  : LMAT_SIMD_LEVEL_SSE2));
+}
+
+
+SIMPLE_CASE( cpu_features_consistency )
+{
+	const cpu_features& f = get_cpu_features();
+
+	// the running processor must support what this test is compiled for
+
+	ASSERT_TRUE( f.sse2 );
+	ASSERT_TRUE( cpu_simd_level() >= LMAT_SIMD_LEVEL );
+
+	if (f.avx2) ASSERT_TRUE( f.avx );
+	if (f.avx) ASSERT_TRUE( f.sse4_2 );
+	if (f.fma) ASSERT_TRUE( f.avx );
+	if (f.avx512f) ASSERT_TRUE( f.avx2 && f.fma );
+
+	if (cpu_simd_level() >= LMAT_SIMD_LEVEL_AVX2) ASSERT_TRUE( f.fma );
+
+	// AVX2 without FMA must not select the avx2 variant
+
+	cpu_features g = f;
+	g.avx512f = false;
+	g.fma = false;
+	if (g.avx) ASSERT_EQ( g.simd_level(), LMAT_SIMD_LEVEL_AVX );
+
+	ASSERT_EQ( &get_cpu_features(), &f );
+}
+
+
+SIMPLE_CASE( simd_dispatch_select )
+{
+	simd_dispatcher<level_fun_t> d( LMAT_SIMD_VARIANTS(dispatch_test_level) );
+
+	const int lv = expected_dispatch_level(cpu_simd_level());
+	ASSERT_EQ( d.level(), lv );
+	ASSERT_EQ( d(), lv );
+
+	d.resolve(LMAT_SIMD_LEVEL_SSE2);
+	ASSERT_EQ( d.level(), LMAT_SIMD_LEVEL_SSE2 );
+	ASSERT_EQ( d(), LMAT_SIMD_LEVEL_SSE2 );
+
+	d.resolve(6);
+	ASSERT_EQ( d.level(), LMAT_SIMD_LEVEL_SSE2 );
+
+	if (cpu_simd_level() >= LMAT_SIMD_LEVEL_AVX)
+	{
+		d.resolve(LMAT_SIMD_LEVEL_AVX);
+		ASSERT_EQ( d.level(), LMAT_SIMD_LEVEL_AVX );
+		ASSERT_EQ( d(), LMAT_SIMD_LEVEL_AVX );
+	}
+
+	if (cpu_simd_level() >= LMAT_SIMD_LEVEL_AVX2)
+	{
+		d.resolve(LMAT_SIMD_LEVEL_AVX2);
+		ASSERT_EQ( d.level(), LMAT_SIMD_LEVEL_AVX2 );
+		ASSERT_EQ( d(), LMAT_SIMD_LEVEL_AVX2 );
+	}
+
+	bool caught = false;
+	try
+	{
+		d.resolve(1);
+	}
+	catch (invalid_argument&)
+	{
+		caught = true;
+	}
+	ASSERT_TRUE( caught );
+}
+
+
+SIMPLE_CASE( simd_dispatch_kernels )
+{
+	static const simd_dispatcher<sum_fun_t> dsum( LMAT_SIMD_VARIANTS(dispatch_test_sum) );
+	static const simd_dispatcher<axpy_fun_t> daxpy( LMAT_SIMD_VARIANTS(dispatch_test_axpy) );
+
+	double x[test_len];
+	double y[test_len];
+	double y0[test_len];
+
+	double s0 = 0;
+	for (index_t i = 0; i < test_len; ++i)
+	{
+		x[i] = double(i + 1);
+		y[i] = y0[i] = double(2 * i - 3);
+		s0 += x[i];
+	}
+
+	ASSERT_EQ( dsum(x, test_len), s0 );
+
+	daxpy(2.0, x, y, test_len);
+	for (index_t i = 0; i < test_len; ++i) y0[i] += 2.0 * x[i];
+
+	ASSERT_VEC_EQ( test_len, y, y0 );
+
+	// every variant supported by the processor computes the same results
+
+	simd_variant<sum_fun_t> svars[] = LMAT_SIMD_VARIANTS(dispatch_test_sum);
+	const int nvars = int(sizeof(svars) / sizeof(svars[0]));
+	for (int k = 0; k < nvars; ++k)
+	{
+		if (svars[k].level <= cpu_simd_level())
+		{
+			ASSERT_EQ( svars[k].fun(x, test_len), s0 );
+		}
+	}
+}
+
+
+AUTO_TPACK( simd_dispatch )
+{
+	ADD_SIMPLE_CASE( cpu_features_consistency )
+	ADD_SIMPLE_CASE( simd_dispatch_select )
+	ADD_SIMPLE_CASE( simd_dispatch_kernels )
+}
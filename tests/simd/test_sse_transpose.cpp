@@ -0,0 +1,58 @@
+/**
+ * @file test_sse_transpose.cpp
+ *
+ * @brief Unit testing of in-register transposition of SSE packs
+ *
+ * @author Dahua Lin
+ */
+
+#include "simd_test_base.h"
+#include <light_mat/simd/sse_transpose.h>
+
+using namespace lmat;
+using namespace lmat::test;
+
+
+SIMPLE_CASE( sse_transpose_f32 )
+{
+	float src[16];
+	for (int i = 0; i < 16; ++i) src[i] = float(i + 1);
+
+	sse_f32pk a0(src), a1(src + 4), a2(src + 8), a3(src + 12);
+	transpose(a0, a1, a2, a3);
+
+	float r[16];
+	a0.store_u(r);
+	a1.store_u(r + 4);
+	a2.store_u(r + 8);
+	a3.store_u(r + 12);
+
+	for (int i = 0; i < 4; ++i)
+	{
+		for (int j = 0; j < 4; ++j) ASSERT_EQ( r[i * 4 + j], src[j * 4 + i] );
+	}
+}
+
+SIMPLE_CASE( sse_transpose_f64 )
+{
+	double src[4] = {1.0, 2.0, 3.0, 4.0};
+
+	sse_f64pk a0(src), a1(src + 2);
+	transpose(a0, a1);
+
+	double r[4];
+	a0.store_u(r);
+	a1.store_u(r + 2);
+
+	for (int i = 0; i < 2; ++i)
+	{
+		for (int j = 0; j < 2; ++j) ASSERT_EQ( r[i * 2 + j], src[j * 2 + i] );
+	}
+}
+
+
+AUTO_TPACK( sse_transpose )
+{
+	ADD_SIMPLE_CASE( sse_transpose_f32 )
+	ADD_SIMPLE_CASE( sse_transpose_f64 )
+}
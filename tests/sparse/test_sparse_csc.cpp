@@ -0,0 +1,340 @@
+/**
+ * @file test_sparse_csc.cpp
+ *
+ * @brief Unit testing of CSC sparse matrices
+ *
+ * @author Dahua Lin
+ */
+
+// use small thresholds, such that the parallel code path
+// is exercised with matrices of moderate sizes
+
+#define LMAT_PAR_MIN_ELEMS 64
+
+#include "../test_base.h"
+#include <light_mat/matrix/matrix_classes.h>
+#include <light_mat/sparse/sparse_prod.h>
+#include <light_mat/sparse/sparse_reduce.h>
+#include <cstdlib>
+
+using namespace lmat;
+using namespace lmat::test;
+
+const int NUM_TEST_THREADS = 4;
+
+const index_t DM = 37;
+const index_t DN = 29;
+const index_t DK = 5;
+
+template<typename T>
+inline T randunif()
+{
+	double u = (double)std::rand() / double(RAND_MAX);
+	return T(u * 2.0 - 1.0);
+}
+
+// about a quarter of the entries are non-zeros,
+// and column 1 is entirely zero
+template<typename T>
+void fill_sparse(dense_matrix<T>& a, index_t m, index_t n)
+{
+	a.require_size(m, n);
+	for (index_t j = 0; j < n; ++j)
+	{
+		for (index_t i = 0; i < m; ++i)
+		{
+			a(i, j) = (j != 1 && std::rand() % 4 == 0) ? randunif<T>() : T(0);
+		}
+	}
+}
+
+template<typename T>
+void fill_rand(dense_matrix<T>& a, index_t m, index_t n)
+{
+	a.require_size(m, n);
+	for (index_t i = 0; i < m * n; ++i) a[i] = randunif<T>();
+}
+
+// c = alpha * op(a) * b + beta * c
+template<typename T>
+void dense_mm(T alpha, const dense_matrix<T>& a, const dense_matrix<T>& b, T beta, dense_matrix<T>& c, bool tr)
+{
+	const index_t k = tr ? a.nrows() : a.ncolumns();
+	for (index_t l = 0; l < c.ncolumns(); ++l)
+	{
+		for (index_t i = 0; i < c.nrows(); ++i)
+		{
+			T s(0);
+			for (index_t j = 0; j < k; ++j) s += (tr ? a(j, i) : a(i, j)) * b(j, l);
+			c(i, l) = alpha * s + beta * c(i, l);
+		}
+	}
+}
+
+
+T_CASE( sparse_construct )
+{
+	const index_t m = DM;
+	const index_t n = DN;
+
+	dense_matrix<T> a;
+	fill_sparse(a, m, n);
+
+	index_t nz = 0;
+	for (index_t i = 0; i < m * n; ++i) if (a[i] != T(0)) ++nz;
+
+	sparse_csc<T> s(a);
+
+	ASSERT_EQ( s.nrows(), m );
+	ASSERT_EQ( s.ncolumns(), n );
+	ASSERT_EQ( s.nelems(), m * n );
+	ASSERT_EQ( s.nnz(), nz );
+	ASSERT_EQ( s.col_nnz(1), 0 );
+
+	for (index_t j = 0; j < n; ++j)
+	{
+		for (index_t i = 0; i < m; ++i)
+		{
+			ASSERT_EQ( s(i, j), a(i, j) );
+		}
+	}
+
+	dense_matrix<T> d(m, n);
+	to_dense(s, d);
+	ASSERT_MAT_EQ( m, n, d, a );
+
+	// from raw arrays, with 32-bit indices
+
+	dblock<int32_t> cp(n + 1);
+	dblock<int32_t> ri(nz);
+	for (index_t j = 0; j <= n; ++j) cp[j] = (int32_t)s.ptr_colptr()[j];
+	for (index_t k = 0; k < nz; ++k) ri[k] = (int32_t)s.ptr_rowidx()[k];
+
+	sparse_csc<T, int32_t> s2(m, n, nz, cp.ptr_data(), ri.ptr_data(), s.ptr_values());
+	ASSERT_EQ( s2.nnz(), nz );
+
+	dense_matrix<T> d2(m, n);
+	to_dense(s2, d2);
+	ASSERT_MAT_EQ( m, n, d2, a );
+}
+
+
+T_CASE( sparse_spmv )
+{
+	const index_t m = DM;
+	const index_t n = DN;
+
+	dense_matrix<T> a;
+	fill_sparse(a, m, n);
+	sparse_csc<T> s(a);
+
+	dense_matrix<T> x, xt, y0, y0t;
+	fill_rand(x, n, 1);
+	fill_rand(xt, m, 1);
+	fill_rand(y0, m, 1);
+	fill_rand(y0t, n, 1);
+
+	const T alpha = T(2.5);
+	const T beta = T(1.5);
+	const T tol = T(1.0e-5);
+
+	dense_matrix<T> r(y0);
+	dense_mm(alpha, a, x, beta, r, false);
+
+	dense_col<T> y(y0);
+	spmv(alpha, s, x, beta, y);
+	ASSERT_VEC_APPROX( m, y, r, tol );
+
+	r = y0;
+	dense_mm(alpha, a, x, T(0), r, false);
+
+	y = y0;
+	spmv(alpha, s, x, T(0), y);
+	ASSERT_VEC_APPROX( m, y, r, tol );
+
+	dense_matrix<T> rt(y0t);
+	dense_mm(alpha, a, xt, beta, rt, true);
+
+	dense_col<T> yt(y0t);
+	spmv(alpha, s, xt, beta, yt, 'T');
+	ASSERT_VEC_APPROX( n, yt, rt, tol );
+
+	// strided vectors
+
+	dense_matrix<T> xs(2, n, zero());
+	dense_matrix<T> ys(3, m, zero());
+	for (index_t j = 0; j < n; ++j) xs(1, j) = x[j];
+	for (index_t i = 0; i < m; ++i) ys(2, i) = y0[i];
+
+	r = y0;
+	dense_mm(alpha, a, x, beta, r, false);
+
+	auto ys_row = ys.row(2);
+	spmv(alpha, s, xs.row(1), beta, ys_row);
+	for (index_t i = 0; i < m; ++i) y[i] = ys(2, i);
+	ASSERT_VEC_APPROX( m, y, r, tol );
+}
+
+
+T_CASE( sparse_spmm )
+{
+	const index_t m = DM;
+	const index_t n = DN;
+	const index_t k = DK;
+
+	dense_matrix<T> a;
+	fill_sparse(a, m, n);
+	sparse_csc<T> s(a);
+
+	dense_matrix<T> b, bt, c0, c0t;
+	fill_rand(b, n, k);
+	fill_rand(bt, m, k);
+	fill_rand(c0, m, k);
+	fill_rand(c0t, n, k);
+
+	const T alpha = T(2.5);
+	const T beta = T(1.5);
+	const T tol = T(1.0e-5);
+
+	dense_matrix<T> r(c0);
+	dense_mm(alpha, a, b, beta, r, false);
+
+	dense_matrix<T> c(c0);
+	spmm(alpha, s, b, beta, c);
+	ASSERT_MAT_APPROX( m, k, c, r, tol );
+
+	dense_matrix<T> rt(c0t);
+	dense_mm(alpha, a, bt, beta, rt, true);
+
+	dense_matrix<T> ct(c0t);
+	spmm(alpha, s, bt, beta, ct, 't');
+	ASSERT_MAT_APPROX( n, k, ct, rt, tol );
+}
+
+
+T_CASE( sparse_par_prod )
+{
+	set_par_max_threads(NUM_TEST_THREADS);
+
+	const index_t m = DM;
+	const index_t n = DN;
+	const index_t k = DK;
+
+	dense_matrix<T> a;
+	fill_sparse(a, m, n);
+	sparse_csc<T> s(a);
+
+	dense_matrix<T> b, bt, c0, c0t;
+	fill_rand(b, n, k);
+	fill_rand(bt, m, k);
+	fill_rand(c0, m, k);
+	fill_rand(c0t, n, k);
+
+	const T alpha = T(2.5);
+	const T beta = T(1.5);
+	const T tol = T(1.0e-5);
+
+	// spmv
+
+	dense_col<T> x(b.column(0));
+	dense_col<T> xt(bt.column(0));
+
+	dense_col<T> y(c0.column(0)), y_p(c0.column(0));
+	spmv(alpha, s, x, beta, y);
+	spmv(alpha, s, x, beta, y_p, 'N', par_());
+	ASSERT_VEC_APPROX( m, y_p, y, tol );
+
+	dense_col<T> yt(c0t.column(0)), yt_p(c0t.column(0));
+	spmv(alpha, s, xt, beta, yt, 'T');
+	spmv(alpha, s, xt, beta, yt_p, 'T', par_());
+	ASSERT_VEC_APPROX( n, yt_p, yt, tol );
+
+	// spmm
+
+	dense_matrix<T> c(c0), c_p(c0);
+	spmm(alpha, s, b, beta, c);
+	spmm(alpha, s, b, beta, c_p, 'N', par_());
+	ASSERT_MAT_APPROX( m, k, c_p, c, tol );
+
+	dense_matrix<T> ct(c0t), ct_p(c0t);
+	spmm(alpha, s, bt, beta, ct, 'T');
+	spmm(alpha, s, bt, beta, ct_p, 'T', par_());
+	ASSERT_MAT_APPROX( n, k, ct_p, ct, tol );
+}
+
+
+T_CASE( sparse_colwise_reduce )
+{
+	set_par_max_threads(NUM_TEST_THREADS);
+
+	const index_t m = DM;
+	const index_t n = DN;
+
+	dense_matrix<T> a;
+	fill_sparse(a, m, n);
+	sparse_csc<T> s(a);
+
+	const T tol = T(1.0e-5);
+
+	dense_row<T> r(n), v(n), vp(n);
+
+#define CHECK_SPARSE_COLWISE( Name ) \
+	colwise_##Name(a, r); \
+	colwise_##Name(s, v); \
+	colwise_##Name(s, vp, par_()); \
+	ASSERT_VEC_APPROX( n, v, r, tol ); \
+	ASSERT_VEC_APPROX( n, vp, r, tol );
+
+	CHECK_SPARSE_COLWISE( sum )
+	CHECK_SPARSE_COLWISE( asum )
+	CHECK_SPARSE_COLWISE( amax )
+	CHECK_SPARSE_COLWISE( sqsum )
+
+#undef CHECK_SPARSE_COLWISE
+
+	ASSERT_EQ( v[1], T(0) );
+
+#define CHECK_SPARSE_COLWISE_NORM( Tag ) \
+	colwise_norm(a, r, norms::Tag()); \
+	colwise_norm(s, v, norms::Tag()); \
+	colwise_norm(s, vp, norms::Tag(), par_()); \
+	ASSERT_VEC_APPROX( n, v, r, tol ); \
+	ASSERT_VEC_APPROX( n, vp, r, tol );
+
+	CHECK_SPARSE_COLWISE_NORM( L1_ )
+	CHECK_SPARSE_COLWISE_NORM( L2_ )
+	CHECK_SPARSE_COLWISE_NORM( Linf_ )
+
+#undef CHECK_SPARSE_COLWISE_NORM
+}
+
+
+AUTO_TPACK( sparse_construct )
+{
+	ADD_T_CASE( sparse_construct, float )
+	ADD_T_CASE( sparse_construct, double )
+}
+
+AUTO_TPACK( sparse_spmv )
+{
+	ADD_T_CASE( sparse_spmv, float )
+	ADD_T_CASE( sparse_spmv, double )
+}
+
+AUTO_TPACK( sparse_spmm )
+{
+	ADD_T_CASE( sparse_spmm, float )
+	ADD_T_CASE( sparse_spmm, double )
+}
+
+AUTO_TPACK( sparse_par_prod )
+{
+	ADD_T_CASE( sparse_par_prod, float )
+	ADD_T_CASE( sparse_par_prod, double )
+}
+
+AUTO_TPACK( sparse_colwise_reduce )
+{
+	ADD_T_CASE( sparse_colwise_reduce, float )
+	ADD_T_CASE( sparse_colwise_reduce, double )
+}
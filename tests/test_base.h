@@ -14,6 +14,7 @@
 #define TEST_BASE_H_
 
 #include <light_test/tests.h>
+#include <light_mat/common/prim_types.h>
 #include <string>
 #include <sstream>
 
@@ -106,7 +107,7 @@ namespace lmat { namespace test {
 	};
 
 
-	template<int N>
+	template<index_t N>
 	class N_case : public ltest::test_case
 	{
 		std::string m_name;
@@ -128,7 +129,7 @@ namespace lmat { namespace test {
 	};
 
 
-	template<typename T, int N>
+	template<typename T, index_t N>
 	class TN_case : public ltest::test_case
 	{
 		std::string m_name;
@@ -150,7 +151,7 @@ namespace lmat { namespace test {
 	};
 
 
-	template<int M, int N>
+	template<index_t M, index_t N>
 	class MN_case : public ltest::test_case
 	{
 		std::string m_name;
@@ -172,7 +173,7 @@ namespace lmat { namespace test {
 	};
 
 
-	template<typename T, int M, int N>
+	template<typename T, index_t M, index_t N>
 	class TMN_case : public ltest::test_case
 	{
 		std::string m_name;
@@ -237,14 +238,14 @@ namespace lmat { namespace test {
 // N cases
 
 #define N_CASE( Name ) \
-	template<int N> \
+	template<index_t N> \
 	class Name : public lmat::test::N_case<N> { \
 	public: \
 		Name() : lmat::test::N_case<N>( #Name ) { } \
 		virtual ~Name() { } \
 		virtual void run(); \
 	}; \
-	template<int N> \
+	template<index_t N> \
 	void Name<N>::run()
 
 #define ADD_N_CASE( Name, n ) this->add( new Name<n>() );
@@ -258,14 +259,14 @@ namespace lmat { namespace test {
 // TN cases
 
 #define TN_CASE( Name ) \
-	template<typename T, int N> \
+	template<typename T, index_t N> \
 	class Name : public lmat::test::TN_case<T, N> { \
 	public: \
 		Name() : lmat::test::TN_case<T, N>( #Name ) { } \
 		virtual ~Name() { } \
 		virtual void run(); \
 	}; \
-	template<typename T, int N> \
+	template<typename T, index_t N> \
 	void Name<T, N>::run()
 
 #define ADD_TN_CASE( Name, ty, n ) this->add( new Name<ty, n>() );
@@ -279,14 +280,14 @@ namespace lmat { namespace test {
 // MN cases
 
 #define MN_CASE( Name ) \
-	template<int M, int N> \
+	template<index_t M, index_t N> \
 	class Name : public lmat::test::MN_case<M, N> { \
 	public: \
 		Name() : lmat::test::MN_case<M, N>( #Name ) { } \
 		virtual ~Name() { } \
 		virtual void run(); \
 	}; \
-	template<int M, int N> \
+	template<index_t M, index_t N> \
 	void Name<M, N>::run()
 
 #define ADD_MN_CASE( Name, m, n ) this->add( new Name<m,n>()  );
@@ -306,14 +307,14 @@ namespace lmat { namespace test {
 // TMN cases
 
 #define TMN_CASE( Name ) \
-	template<typename T, int M, int N> \
+	template<typename T, index_t M, index_t N> \
 	class Name : public lmat::test::TMN_case<T, M, N> { \
 	public: \
 		Name() : lmat::test::TMN_case<T, M, N>( #Name ) { } \
 		virtual ~Name() { } \
 		virtual void run(); \
 	}; \
-	template<typename T, int M, int N> \
+	template<typename T, index_t M, index_t N> \
 	void Name<T, M, N>::run()
 
 #define ADD_TMN_CASE( Name, ty, m, n ) this->add( new Name<ty, m, n>() );